@@ -412,6 +412,59 @@ test('AudioDecoder: roundtrip with Opus', async (t) => {
   t.pass()
 })
 
+test('AudioEncoder/AudioDecoder: getStats() counts inputs, outputs and codec stages', async (t) => {
+  const { encoder, chunks: encodedChunks, errors: encodeErrors } = createTestEncoder()
+  encoder.configure({
+    codec: 'opus',
+    sampleRate: 48000,
+    numberOfChannels: 2,
+    bitrate: 64000,
+  })
+  t.is(encoder.getStats().inputs, 0)
+
+  for (let i = 0; i < 10; i++) {
+    const audio = generateSineTone(440, 960, 2, 48000, 'f32', i * 20000)
+    encoder.encode(audio)
+    audio.close()
+  }
+  await encoder.flush()
+
+  const encoderStats = encoder.getStats()
+  t.is(encodeErrors.length, 0)
+  t.is(encoderStats.inputs, 10)
+  t.is(encoderStats.outputs, encodedChunks.length)
+  t.is(encoderStats.dropped, 0)
+  t.is(encoderStats.queueWait.count, 10)
+  t.true(encoderStats.send.count > 0)
+  t.true(encoderStats.receive.count > 0)
+  t.true(encoderStats.callback.count > 0, 'Output callbacks are timed')
+  encoder.close()
+
+  const { decoder, audioOutputs, errors: decodeErrors } = createTestDecoder()
+  decoder.configure({
+    codec: 'opus',
+    sampleRate: 48000,
+    numberOfChannels: 2,
+  })
+  for (const chunk of encodedChunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  const decoderStats = decoder.getStats()
+  t.is(decodeErrors.length, 0)
+  t.is(decoderStats.inputs, encodedChunks.length)
+  t.is(decoderStats.outputs, audioOutputs.length)
+  t.is(decoderStats.queueWait.count, encodedChunks.length)
+  t.true(decoderStats.send.count >= encodedChunks.length)
+  t.true(decoderStats.callback.count > 0, 'Output callbacks are timed')
+  t.true(decoderStats.callback.maxMs >= decoderStats.callback.meanMs)
+  for (const audio of audioOutputs) {
+    audio.close()
+  }
+  decoder.close()
+})
+
 // ============================================================================
 // Codec Support Tests
 // ============================================================================
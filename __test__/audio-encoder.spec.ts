@@ -206,6 +206,36 @@ test('AudioEncoder: encode() multiple frames', async (t) => {
   encoder.close()
 })
 
+test('AudioEncoder: inputs of any size are re-framed into codec-sized frames', async (t) => {
+  const { encoder, chunks, errors } = createTestEncoder()
+
+  encoder.configure({
+    codec: 'opus',
+    sampleRate: 48000,
+    numberOfChannels: 2,
+    bitrate: 64000,
+  })
+
+  // Whole frames (passed through) mixed with inputs that straddle frame boundaries
+  let timestamp = 0
+  for (const size of [960, 500, 1420, 960, 2880]) {
+    const audio = generateSineTone(440, size, 2, 48000, 'f32', timestamp)
+    encoder.encode(audio)
+    audio.close()
+    timestamp += (size / 48000) * 1_000_000
+  }
+
+  await encoder.flush()
+
+  t.is(errors.length, 0)
+  t.true(chunks.length >= 7, `expected at least 7 chunks, got ${chunks.length}`)
+  for (let i = 0; i < 7; i++) {
+    t.is(chunks[i].timestamp, i * 20000)
+  }
+
+  encoder.close()
+})
+
 test('AudioEncoder: encode() with AAC', async (t) => {
   const { encoder, chunks } = createTestEncoder()
 
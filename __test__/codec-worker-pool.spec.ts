@@ -0,0 +1,82 @@
+/**
+ * Shared Codec Worker Pool Tests
+ *
+ * setCodecWorkerThreads() is process-wide and the pool can't be resized once
+ * started, so these tests live in their own file (ava runs each file in its
+ * own process) and share a single-thread pool.
+ */
+
+import test from 'ava'
+
+import { setCodecWorkerThreads, VideoDecoder, VideoEncoder } from '../index.js'
+import type { EncodedVideoChunk, EncodedVideoChunkMetadata, VideoDecoderConfig } from '../index.js'
+import { generateFrameSequence } from './helpers/index.js'
+import { createEncoderConfig, createDecoderConfig } from './helpers/codec-matrix.js'
+
+// One thread: a codec that waited on the pool instead of deferring would hang
+setCodecWorkerThreads(1)
+
+async function encodeH264(width: number, height: number, frameCount: number) {
+  const chunks: EncodedVideoChunk[] = []
+  let decoderConfig: VideoDecoderConfig | undefined
+  const encoder = new VideoEncoder({
+    output: (chunk, metadata?: EncodedVideoChunkMetadata) => {
+      chunks.push(chunk)
+      decoderConfig ??= metadata?.decoderConfig as VideoDecoderConfig | undefined
+    },
+    error: () => {},
+  })
+  encoder.configure(createEncoderConfig('h264', width, height))
+
+  const frames = generateFrameSequence(width, height, frameCount)
+  frames.forEach((frame, i) => encoder.encode(frame, { keyFrame: i === 0 }))
+  for (const frame of frames) {
+    frame.close()
+  }
+  await encoder.flush()
+  encoder.close()
+  return { chunks, decoderConfig }
+}
+
+test('pipeTo() with block backpressure completes on a single pool thread', async (t) => {
+  t.timeout(60_000)
+  const { chunks, decoderConfig } = await encodeH264(320, 240, 30)
+
+  const decoder = new VideoDecoder({
+    output: (frame) => frame.close(),
+    error: (e) => t.fail(e.message),
+  })
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: 320, codedHeight: 240 }),
+    description: decoderConfig?.description,
+  })
+
+  // Two encoders and the decoder share the one thread
+  const renditions = [320, 160].map((width) => {
+    const encoded: EncodedVideoChunk[] = []
+    const encoder = new VideoEncoder({
+      output: (chunk) => encoded.push(chunk),
+      error: (e) => t.fail(e.message),
+    })
+    encoder.configure({
+      ...createEncoderConfig('h264', width, (width * 3) / 4),
+      maxQueueSize: 1,
+      queueOverflow: 'throw',
+    })
+    return { encoder, encoded }
+  })
+
+  decoder.pipeTo(renditions.map((r) => r.encoder))
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+  await Promise.all(renditions.map((r) => r.encoder.flush()))
+
+  for (const { encoder, encoded } of renditions) {
+    t.is(encoder.droppedFrames, 0)
+    t.is(encoded.length, chunks.length)
+    encoder.close()
+  }
+  decoder.close()
+})
@@ -18,7 +18,9 @@ import {
   WebMDemuxer,
   MkvDemuxer,
   VideoEncoder,
+  VideoDecoder,
   AudioEncoder,
+  Mp4Muxer,
   WebMMuxer,
   MkvMuxer,
   resetHardwareFallbackState,
@@ -91,6 +93,52 @@ runTest('Mp4Demuxer: load buffer and get tracks', async (t) => {
   demuxer.close()
 })
 
+runTest('Mp4Demuxer: load memory-mapped file', async (t) => {
+  const file = path.join(FIXTURES_DIR, 'small_buck_bunny.mp4')
+
+  const viaFile = new Mp4Demuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await viaFile.load(file)
+
+  // Two demuxers mapping the same file can read it independently
+  const mapped = [0, 1].map(
+    () =>
+      new Mp4Demuxer({
+        error: (e: Error) => t.fail(`Error: ${e.message}`),
+      }),
+  )
+  await Promise.all(mapped.map((demuxer) => demuxer.load(file, { mmap: true })))
+
+  for (const demuxer of mapped) {
+    t.is(demuxer.state, 'ready')
+    t.deepEqual(demuxer.tracks, viaFile.tracks)
+    t.is(demuxer.duration, viaFile.duration)
+
+    let count = 0
+    for await (const _chunk of demuxer) {
+      count++
+      if (count >= 10) break
+    }
+    t.is(count, 10)
+    demuxer.close()
+  }
+
+  viaFile.close()
+})
+
+runTest('Mp4Demuxer: load memory-mapped missing file rejects', async (t) => {
+  const demuxer = new Mp4Demuxer({
+    error: (_e: Error) => {},
+  })
+
+  await t.throwsAsync(() => demuxer.load(path.join(FIXTURES_DIR, 'does-not-exist.mp4'), { mmap: true }), {
+    message: /Failed to map file/,
+  })
+
+  demuxer.close()
+})
+
 runTest('Mp4Demuxer: get duration', async (t) => {
   const demuxer = new Mp4Demuxer({
     error: (e: Error) => t.fail(`Error: ${e.message}`),
@@ -715,6 +763,223 @@ runTest('WebMDemuxer: error on loading twice without close', async (t) => {
   demuxer.close()
 })
 
+// Helper: Serve a buffer as a ReadableStream in fixed-size chunks. After
+// `stallAfter` bytes the stream waits until `resume()` is called.
+function chunkedStream(data: Uint8Array, chunkSize: number, stallAfter = data.byteLength) {
+  let offset = 0
+  let resume = () => {}
+  const stalled = new Promise<void>((resolve) => {
+    resume = resolve
+  })
+  const stream = new ReadableStream<Uint8Array>({
+    async pull(controller) {
+      if (offset >= data.byteLength) {
+        controller.close()
+        return
+      }
+      if (offset >= stallAfter) {
+        await stalled
+      }
+      controller.enqueue(data.slice(offset, offset + chunkSize))
+      offset += chunkSize
+    },
+  })
+  return { stream, resume }
+}
+
+runTest('WebMDemuxer: load stream and demux while streaming', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  const expected = new WebMDemuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await expected.loadBuffer(webmData)
+  let expectedCount = 0
+  for await (const _chunk of expected) {
+    expectedCount++
+  }
+  expected.close()
+
+  const demuxer = new WebMDemuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+
+  // Buffer far less than the file so the feeder has to wait on the demuxer
+  await demuxer.loadStream(chunkedStream(webmData, 256).stream, { bufferSize: 1024 })
+  t.is(demuxer.state, 'ready')
+  t.is(demuxer.videoDecoderConfig?.codedWidth, 320)
+
+  let count = 0
+  for await (const chunk of demuxer) {
+    t.true(chunk.chunkType === 'video' || chunk.chunkType === 'audio')
+    count++
+  }
+  t.is(count, expectedCount, 'Should yield the same chunks as loadBuffer')
+
+  demuxer.close()
+})
+
+runTest('WebMDemuxer: loadStream rejects zero bufferSize', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  const demuxer = new WebMDemuxer({
+    error: (_e: Error) => {},
+  })
+
+  t.throws(() => demuxer.loadStream(chunkedStream(webmData, 256).stream, { bufferSize: 0 }), {
+    message: /bufferSize/,
+  })
+
+  demuxer.close()
+})
+
+runTest('WebMDemuxer: close unblocks a read waiting for stream data', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  const demuxer = new WebMDemuxer({
+    error: (_e: Error) => {},
+  })
+
+  // Enough for the headers, then the source stops delivering
+  const { stream, resume } = chunkedStream(webmData, 256, Math.floor(webmData.byteLength / 2))
+  await demuxer.loadStream(stream)
+
+  const drained = (async () => {
+    for await (const _chunk of demuxer) {
+      // consume until the stall
+    }
+  })()
+
+  await new Promise((resolve) => setTimeout(resolve, 50))
+  demuxer.close()
+
+  // Either ends or rejects, but must not hang
+  await drained.catch(() => {})
+  t.is(demuxer.state, 'closed')
+  resume()
+})
+
+runTest('WebMDemuxer: stream reads do not block the JS thread', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  let videoChunks = 0
+  const demuxer = new WebMDemuxer({
+    videoOutput: () => {
+      videoChunks++
+    },
+    error: (_e: Error) => {},
+  })
+
+  const { stream, resume } = chunkedStream(webmData, 256, Math.floor(webmData.byteLength / 2))
+  await demuxer.loadStream(stream)
+  const tracks = demuxer.tracks
+
+  // Demuxes up to the stall, then waits for data only this thread can deliver
+  const demuxed = demuxer.demuxAsync()
+  while (demuxer.state !== 'demuxing') {
+    await new Promise((resolve) => setImmediate(resolve))
+  }
+
+  // Getters answer from the metadata copy; mutators refuse to wait
+  t.deepEqual(demuxer.tracks, tracks)
+  t.is(demuxer.videoDecoderConfig?.codedWidth, 320)
+  t.throws(() => demuxer.selectVideoTrack(tracks[0].index), { message: /InvalidStateError/ })
+
+  resume()
+  await demuxed
+  t.is(demuxer.state, 'ended')
+  t.true(videoChunks > 0)
+  // A stream can't be rewound
+  t.throws(() => demuxer.seek(0), { message: /NotSupportedError/ })
+  demuxer.close()
+})
+
+runTest('WebMDemuxer: build, export and import keyframe index', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  const indexed = new WebMDemuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await indexed.loadBuffer(webmData)
+  await indexed.buildIndex()
+  t.is(indexed.state, 'ready')
+
+  const index = indexed.exportIndex()
+  t.true(index.byteLength > 5, 'Index should contain entries')
+
+  // buildIndex rewinds, so a full pass still yields every chunk
+  let count = 0
+  for await (const _chunk of indexed) {
+    count++
+  }
+  t.true(count > 0)
+  indexed.close()
+
+  const demuxer = new WebMDemuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.loadBuffer(webmData)
+  demuxer.importIndex(index)
+  demuxer.seek(200_000)
+
+  for await (const chunk of demuxer) {
+    if (chunk.chunkType === 'video') {
+      t.is(chunk.videoChunk!.type, 'key', 'Seek should land on a keyframe')
+      break
+    }
+  }
+
+  demuxer.close()
+})
+
+runTest('WebMDemuxer: buildIndex rejects stream sources', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  const demuxer = new WebMDemuxer({
+    error: (_e: Error) => {},
+  })
+  await demuxer.loadStream(chunkedStream(webmData, 4096).stream)
+  await t.throwsAsync(() => demuxer.buildIndex(), { message: /NotSupportedError/ })
+  demuxer.close()
+})
+
+runTest('WebMDemuxer: importIndex rejects invalid or mismatched indexes', async (t) => {
+  const webmData = await generateWebMWithVP9()
+
+  const webm = new WebMDemuxer({
+    error: (_e: Error) => {},
+  })
+  await webm.loadBuffer(webmData)
+  await webm.buildIndex()
+  const index = webm.exportIndex()
+
+  t.throws(() => webm.importIndex(new Uint8Array([1, 2, 3])), {
+    message: /Invalid seek index/,
+  })
+  webm.close()
+
+  // Same tracks, different file: the size no longer matches
+  const padded = new Uint8Array(webmData.byteLength + 1024)
+  padded.set(webmData)
+  const other = new WebMDemuxer({
+    error: (_e: Error) => {},
+  })
+  await other.loadBuffer(padded)
+  t.throws(() => other.importIndex(index), {
+    message: /does not match/,
+  })
+  other.close()
+
+  const mp4 = new Mp4Demuxer({
+    error: (_e: Error) => {},
+  })
+  await mp4.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+  t.throws(() => mp4.importIndex(index), {
+    message: /does not match/,
+  })
+  mp4.close()
+})
+
 // ============================================================================
 // MkvDemuxer Tests
 // ============================================================================
@@ -1275,3 +1540,194 @@ runTest('MkvDemuxer: demuxAsync completes', async (t) => {
 
   demuxer.close()
 })
+
+// ============================================================================
+// Native Decode Pipeline Tests
+// ============================================================================
+
+runTest('Mp4Demuxer: decodeTo feeds the decoder without JS chunk callbacks', async (t) => {
+  let chunkCallbacks = 0
+  let frameCount = 0
+
+  const demuxer = new Mp4Demuxer({
+    videoOutput: () => chunkCallbacks++,
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+
+  const decoder = new VideoDecoder({
+    output: (frame) => {
+      frameCount++
+      frame.close()
+    },
+    error: (e) => t.fail(`Decoder error: ${e.message}`),
+  })
+  decoder.configure(demuxer.videoDecoderConfig!)
+
+  await demuxer.decodeTo({ videoDecoder: decoder, maxQueueSize: 4 })
+  await decoder.flush()
+
+  t.is(chunkCallbacks, 0, 'Chunks should not be delivered to JS')
+  t.true(frameCount > 0, 'Should have decoded frames')
+  t.is(demuxer.state, 'ended', 'State should be ended after decodeTo')
+
+  decoder.close()
+  demuxer.close()
+})
+
+runTest('Mp4Demuxer: decodeTo rejects with an unconfigured decoder', async (t) => {
+  const demuxer = new Mp4Demuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+
+  const decoder = new VideoDecoder({
+    output: (frame) => frame.close(),
+    error: () => {},
+  })
+
+  await t.throwsAsync(() => demuxer.decodeTo({ videoDecoder: decoder }), { message: /unconfigured/ })
+
+  decoder.close()
+  demuxer.close()
+})
+
+runTest('Mp4Demuxer: close() during decodeTo returns promptly', async (t) => {
+  const demuxer = new Mp4Demuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+
+  let firstFrame!: () => void
+  const decodeStarted = new Promise<void>((resolve) => (firstFrame = resolve))
+  const decoder = new VideoDecoder({
+    output: (frame) => {
+      frame.close()
+      firstFrame()
+    },
+    error: (e) => t.fail(`Decoder error: ${e.message}`),
+  })
+  decoder.configure(demuxer.videoDecoderConfig!)
+
+  // A queue of one keeps the pipeline waiting on the decoder most of the time
+  const decoding = demuxer.decodeTo({ videoDecoder: decoder, maxQueueSize: 1 })
+  await decodeStarted
+
+  const start = Date.now()
+  demuxer.close()
+  const elapsed = Date.now() - start
+
+  t.true(elapsed < 50, `close() should not wait for decodeTo (took ${elapsed}ms)`)
+  t.is(demuxer.state, 'closed')
+  await t.notThrowsAsync(decoding, 'decodeTo should resolve once the demuxer is closed')
+
+  decoder.close()
+})
+
+runTest('Mp4Demuxer: decodeTo requires a decoder', async (t) => {
+  const demuxer = new Mp4Demuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+
+  t.throws(() => demuxer.decodeTo({}), { instanceOf: TypeError })
+
+  demuxer.close()
+})
+
+// ============================================================================
+// Native Remux Pipeline Tests
+// ============================================================================
+
+runTest('Mp4Demuxer: remuxTo copies packets into an MKV muxer', async (t) => {
+  let sourceChunks = 0
+  const source = new Mp4Demuxer({
+    videoOutput: () => sourceChunks++,
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await source.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+  await source.demuxAsync()
+  source.close()
+
+  const demuxer = new Mp4Demuxer({
+    videoOutput: () => t.fail('Chunks should not be delivered to JS'),
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+
+  const muxer = new MkvMuxer()
+  await demuxer.remuxTo(muxer)
+  const mkvData = muxer.finalize()
+  t.is(demuxer.state, 'ended', 'State should be ended after remuxTo')
+  demuxer.close()
+  muxer.close()
+
+  const remuxedChunks: EncodedVideoChunk[] = []
+  const remuxed = new MkvDemuxer({
+    videoOutput: (chunk: EncodedVideoChunk) => remuxedChunks.push(chunk),
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await remuxed.loadBuffer(mkvData)
+  await remuxed.demuxAsync()
+
+  t.is(remuxedChunks.length, sourceChunks, 'Every video packet should be remuxed')
+  t.is(remuxedChunks[0].type, 'key', 'First remuxed chunk should be a keyframe')
+
+  remuxed.close()
+})
+
+runTest('Mp4Demuxer: remuxTo preserves B-frame timestamps', async (t) => {
+  // small_buck_bunny.mp4 is H.264 High profile with B-frames (ctts box)
+  const sourceTimestamps: number[] = []
+  const source = new Mp4Demuxer({
+    videoOutput: (chunk: EncodedVideoChunk) => sourceTimestamps.push(chunk.timestamp),
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await source.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+  await source.demuxAsync()
+  source.close()
+
+  // Decode order with B-frames: presentation timestamps go backwards somewhere
+  t.true(
+    sourceTimestamps.some((ts, i) => i > 0 && ts < sourceTimestamps[i - 1]),
+    'Fixture should contain B-frames',
+  )
+
+  const demuxer = new Mp4Demuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+  const muxer = new Mp4Muxer()
+  await demuxer.remuxTo(muxer)
+  const mp4Data = muxer.finalize()
+  demuxer.close()
+  muxer.close()
+
+  const remuxedTimestamps: number[] = []
+  const remuxed = new Mp4Demuxer({
+    videoOutput: (chunk: EncodedVideoChunk) => remuxedTimestamps.push(chunk.timestamp),
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await remuxed.loadBuffer(mp4Data)
+  await remuxed.demuxAsync()
+  remuxed.close()
+
+  // Same packets in the same decode order with the same pts; the muxer's
+  // edit list may shift the whole timeline, so compare relative to the start
+  t.is(remuxedTimestamps.length, sourceTimestamps.length)
+  t.deepEqual(
+    remuxedTimestamps.map((ts) => ts - remuxedTimestamps[0]),
+    sourceTimestamps.map((ts) => ts - sourceTimestamps[0]),
+  )
+})
+
+runTest('Mp4Demuxer: remuxTo rejects a non-muxer target', async (t) => {
+  const demuxer = new Mp4Demuxer({
+    error: (e: Error) => t.fail(`Error: ${e.message}`),
+  })
+  await demuxer.load(path.join(FIXTURES_DIR, 'small_buck_bunny.mp4'))
+
+  t.throws(() => demuxer.remuxTo({} as MkvMuxer), { instanceOf: TypeError })
+
+  demuxer.close()
+})
@@ -10,10 +10,14 @@ import test from 'ava'
 import {
   getHardwareAccelerators,
   getAvailableHardwareAccelerators,
+  getHardwareSessionStats,
   getPreferredHardwareAccelerator,
   isHardwareAcceleratorAvailable,
+  releaseUnusedHardwareDevices,
   resetHardwareFallbackState,
+  setHardwareSessionLimits,
   VideoEncoder,
+  warmUpHardware,
 } from '../index.js'
 import { generateSolidColorI420Frame, TestColors, hasHardwareAcceleration, type EncodedVideoChunk } from './helpers/index.js'
 import { createEncoderConfig } from './helpers/codec-matrix.js'
@@ -191,6 +195,28 @@ test('getPreferredHardwareAccelerator: returns null when none available', (t) =>
   }
 })
 
+// ============================================================================
+// warmUpHardware() / releaseUnusedHardwareDevices() Tests
+// ============================================================================
+
+test('warmUpHardware: returns only available accelerators', async (t) => {
+  const available = getAvailableHardwareAccelerators()
+  const ready = await warmUpHardware(['vaapi', 'cuda', 'videotoolbox', 'not-an-accelerator'])
+
+  t.false(ready.includes('not-an-accelerator'))
+  for (const name of ready) {
+    t.true(available.includes(name), `${name} should be in available list`)
+  }
+})
+
+test('releaseUnusedHardwareDevices: releases warmed-up devices and allows reopening', async (t) => {
+  const ready = await warmUpHardware()
+
+  // Devices held by codecs in concurrently running tests stay cached
+  t.true(releaseUnusedHardwareDevices() <= ready.length)
+  t.deepEqual(await warmUpHardware(), ready)
+})
+
 // ============================================================================
 // Platform-Specific Tests
 // ============================================================================
@@ -320,3 +346,46 @@ test('hardware encoding: no-preference fallback', async (t) => {
 
   encoder.close()
 })
+
+// ============================================================================
+// Hardware Session Limits Tests
+// ============================================================================
+
+test('getHardwareSessionStats: reports encoder and decoder counters', (t) => {
+  const stats = getHardwareSessionStats()
+
+  for (const counters of [stats.encoders, stats.decoders]) {
+    t.is(typeof counters.active, 'number')
+    t.true(counters.max > 0)
+    t.true(counters.denied >= 0)
+    t.true(counters.softwareFallbacks >= 0)
+  }
+})
+
+test.serial('setHardwareSessionLimits: exhausted slots fall back to software', async (t) => {
+  const previous = getHardwareSessionStats()
+  setHardwareSessionLimits({ maxEncoders: 0 })
+  t.is(getHardwareSessionStats().encoders.max, 0)
+  // Omitted members are left alone
+  t.is(getHardwareSessionStats().decoders.max, previous.decoders.max)
+
+  const { encoder, chunks } = createTestEncoder()
+  try {
+    encoder.configure(createEncoderConfig('h264', 320, 240, { hardwareAcceleration: 'no-preference' }))
+
+    const frame = generateSolidColorI420Frame(320, 240, TestColors.blue, 0)
+    encoder.encode(frame, { keyFrame: true })
+    frame.close()
+    await encoder.flush()
+    t.true(chunks.length > 0)
+
+    const stats = getHardwareSessionStats()
+    t.true(stats.encoders.denied > previous.encoders.denied)
+    t.true(stats.encoders.softwareFallbacks > previous.encoders.softwareFallbacks)
+  } finally {
+    encoder.close()
+    setHardwareSessionLimits({ maxEncoders: previous.encoders.max })
+  }
+
+  t.is(getHardwareSessionStats().encoders.max, previous.encoders.max)
+})
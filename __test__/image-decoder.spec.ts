@@ -122,11 +122,9 @@ test('ImageDecoder GIF can decode specific frames by index', async (t) => {
   t.true(result0.complete)
   t.truthy(result0.image)
 
-  // Get frame count
-  // Note: FFmpeg's single-packet image decoder may not extract all animation frames.
-  // For full animation support, use a video decoder approach instead.
+  // fixtures/animated.gif has three 8x8 frames
   const frameCount = decoder.tracks.selectedTrack!.frameCount
-  t.true(frameCount >= 1, `Expected at least 1 frame, got ${frameCount}`)
+  t.is(frameCount, 3)
 
   // Decode subsequent frames if available
   for (let i = 1; i < frameCount; i++) {
@@ -258,6 +256,40 @@ test('ImageDecoder caches frames after first decode', async (t) => {
   decoder.close()
 })
 
+test('ImageDecoder re-decodes evicted frames with a tiny frameCacheBytes', async (t) => {
+  const data = readFileSync(join(__dirname, 'fixtures/animated.gif'))
+  // A zero budget keeps only the most recently decoded frame
+  const decoder = new ImageDecoder({ data, type: 'image/gif', frameCacheBytes: 0 })
+
+  await decoder.tracks.ready
+  const frameCount = decoder.tracks.selectedTrack!.frameCount
+  t.is(frameCount, 3)
+
+  // Going backwards restarts decoding from the first frame
+  const indices = [frameCount - 1, 0, frameCount - 1]
+  const pixels: Uint8Array[] = []
+  for (const frameIndex of indices) {
+    const result = await decoder.decode({ frameIndex })
+    t.true(result.complete)
+    const buffer = new Uint8Array(result.image.allocationSize())
+    await result.image.copyTo(buffer)
+    pixels.push(buffer)
+    result.image.close()
+  }
+  // The re-decoded frame matches the first decode, and differs from frame 0
+  t.deepEqual(pixels[2], pixels[0])
+  t.notDeepEqual(pixels[1], pixels[0])
+
+  decoder.close()
+})
+
+test('ImageDecoder rejects negative frameCacheBytes', (t) => {
+  const data = readFileSync(join(__dirname, 'fixtures/animated.gif'))
+  t.throws(() => new ImageDecoder({ data, type: 'image/gif', frameCacheBytes: -1 }), {
+    message: /frameCacheBytes must be a non-negative number/,
+  })
+})
+
 test('ImageDecoder completed getter resolves immediately for buffered data', async (t) => {
   const data = readFileSync(join(__dirname, 'fixtures/test.png'))
   const decoder = new ImageDecoder({ data, type: 'image/png' })
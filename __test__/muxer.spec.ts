@@ -17,6 +17,7 @@ import {
   type EncodedAudioChunk,
   type EncodedVideoChunkMetadata,
   type EncodedAudioChunkMetadata,
+  type MuxerSegment,
 } from '../index.js'
 import { generateSolidColorI420Frame, generateSilence, TestColors } from './helpers/index.js'
 
@@ -131,6 +132,204 @@ test('Mp4Muxer: muxes video chunks and produces valid MP4', async (t) => {
   t.true(ftypOffset >= 0, 'Should have ftyp box')
 })
 
+/** Encode a short H.264 clip for the fastStart tests */
+async function encodeH264Clip(frameCount = 30, keyFrameInterval = frameCount) {
+  return encodeVideoClip('avc1.42001E', frameCount, keyFrameInterval)
+}
+
+async function encodeVideoClip(codec: string, frameCount: number, keyFrameInterval: number) {
+  const chunks: EncodedVideoChunk[] = []
+  const metadatas: (EncodedVideoChunkMetadata | undefined)[] = []
+  const encoder = new VideoEncoder({
+    output: (chunk, metadata) => {
+      chunks.push(chunk)
+      metadatas.push(metadata)
+    },
+    error: () => {},
+  })
+  encoder.configure({ codec, width: 320, height: 240, bitrate: 1_000_000 })
+  for (let i = 0; i < frameCount; i++) {
+    const frame = generateSolidColorI420Frame(320, 240, TestColors.green, i * 33333)
+    encoder.encode(frame, { keyFrame: i % keyFrameInterval === 0 })
+    frame.close()
+  }
+  await encoder.flush()
+  encoder.close()
+  return { chunks, metadatas }
+}
+
+/** Resolve with the first `count` segments, which arrive through a threadsafe callback */
+function collectSegments(muxer: Mp4Muxer | WebMMuxer, count: number): Promise<MuxerSegment[]> {
+  const segments: MuxerSegment[] = []
+  return new Promise((resolve) => {
+    muxer.onsegment = (segment) => {
+      segments.push(segment)
+      if (segments.length === count) {
+        resolve(segments)
+      }
+    }
+  })
+}
+
+/** List the top-level box types of an MP4 file */
+function topLevelBoxes(data: Uint8Array): string[] {
+  const view = new DataView(data.buffer, data.byteOffset, data.byteLength)
+  const boxes: string[] = []
+  let offset = 0
+  while (offset + 8 <= data.length) {
+    let size = view.getUint32(offset)
+    const type = String.fromCharCode(...data.subarray(offset + 4, offset + 8))
+    if (size === 1) {
+      size = Number(view.getBigUint64(offset + 8))
+    } else if (size === 0) {
+      size = data.length - offset
+    }
+    if (size < 8) break
+    boxes.push(type)
+    offset += size
+  }
+  return boxes
+}
+
+test('Mp4Muxer: fastStart puts moov before mdat', async (t) => {
+  const { chunks, metadatas } = await encodeH264Clip()
+  t.true(chunks.length > 0)
+
+  const muxer = new Mp4Muxer({ fastStart: true })
+  muxer.addVideoTrack({
+    codec: 'avc1.42001E',
+    width: 320,
+    height: 240,
+    description: metadatas[0]?.decoderConfig?.description,
+  })
+  for (let i = 0; i < chunks.length; i++) {
+    muxer.addVideoChunk(chunks[i], metadatas[i])
+  }
+  const mp4Data = muxer.finalize()
+  muxer.close()
+
+  const boxes = topLevelBoxes(mp4Data)
+  t.is(boxes[0], 'ftyp')
+  t.true(boxes.indexOf('moov') >= 0)
+  t.true(boxes.indexOf('moov') < boxes.indexOf('mdat'), `unexpected box order: ${boxes.join(',')}`)
+})
+
+test('Mp4Muxer: fastStart in streaming mode leads with moov', async (t) => {
+  const { chunks, metadatas } = await encodeH264Clip()
+  t.true(chunks.length > 0)
+
+  const muxer = new Mp4Muxer({ fastStart: true, streaming: { bufferCapacity: 64 * 1024 } })
+  t.true(muxer.isStreaming)
+  muxer.addVideoTrack({
+    codec: 'avc1.42001E',
+    width: 320,
+    height: 240,
+    description: metadatas[0]?.decoderConfig?.description,
+  })
+
+  const parts: Uint8Array[] = []
+  const drain = () => {
+    for (let part = muxer.read(); part && part.length > 0; part = muxer.read()) {
+      parts.push(part)
+    }
+  }
+  for (let i = 0; i < chunks.length; i++) {
+    muxer.addVideoChunk(chunks[i], metadatas[i])
+    drain()
+  }
+  muxer.finalize()
+  drain()
+  t.true(muxer.isFinished)
+  muxer.close()
+
+  const mp4Data = Buffer.concat(parts)
+  const boxes = topLevelBoxes(mp4Data)
+  t.is(boxes[0], 'ftyp')
+  t.is(boxes[1], 'moov')
+  t.true(boxes.includes('moof'))
+})
+
+test('Mp4Muxer: read() returns everything ready, readPage() one page at a time', async (t) => {
+  const { chunks, metadatas } = await encodeH264Clip(90, 30)
+
+  const mux = (drain: (muxer: Mp4Muxer) => Uint8Array[]) => {
+    const muxer = new Mp4Muxer({ fragmented: true, streaming: { bufferCapacity: 4 * 1024 * 1024 } })
+    muxer.addVideoTrack({
+      codec: 'avc1.42001E',
+      width: 320,
+      height: 240,
+      description: metadatas[0]?.decoderConfig?.description,
+    })
+    for (let i = 0; i < chunks.length; i++) {
+      muxer.addVideoChunk(chunks[i], metadatas[i])
+    }
+    muxer.finalize()
+    const parts = drain(muxer)
+    t.true(muxer.isFinished)
+    muxer.close()
+    return parts
+  }
+
+  const [whole] = mux((muxer) => {
+    const data = muxer.read()
+    t.is(muxer.read()?.length, 0)
+    return [data!]
+  })
+  const pages = mux((muxer) => {
+    const parts: Uint8Array[] = []
+    for (let page = muxer.readPage(); page && page.length > 0; page = muxer.readPage()) {
+      parts.push(page)
+    }
+    return parts
+  })
+
+  t.true(pages.length > 0)
+  t.true(pages.every((page) => page.length <= 32 * 1024))
+  t.deepEqual(Buffer.concat(pages), Buffer.from(whole))
+})
+
+test('Mp4Muxer: segmented mode emits init and CMAF segments', async (t) => {
+  // 3 seconds at 30fps with a keyframe every second
+  const { chunks, metadatas } = await encodeH264Clip(90, 30)
+
+  const muxer = new Mp4Muxer({ segmented: { targetDuration: 1_000_000 } })
+  const delivered = collectSegments(muxer, 4)
+  muxer.addVideoTrack({
+    codec: 'avc1.42001E',
+    width: 320,
+    height: 240,
+    description: metadatas[0]?.decoderConfig?.description,
+  })
+  for (let i = 0; i < chunks.length; i++) {
+    muxer.addVideoChunk(chunks[i], metadatas[i])
+  }
+  t.is(muxer.finalize().length, 0)
+  const playlist = muxer.getHlsPlaylist()
+  muxer.close()
+
+  const [init, ...media] = await delivered
+  t.is(init.segmentType, 'init')
+  t.is(init.uri, 'init.mp4')
+  t.deepEqual(topLevelBoxes(init.data).slice(0, 2), ['ftyp', 'moov'])
+
+  for (const [i, segment] of media.entries()) {
+    t.is(segment.segmentType, 'media')
+    t.is(segment.sequence, i + 1)
+    t.is(segment.uri, `segment-${i + 1}.m4s`)
+    t.true(topLevelBoxes(segment.data).includes('moof'))
+    t.true(Math.abs(segment.timestamp - i * 999_990) < 1000)
+    t.true(Math.abs(segment.duration - 1_000_000) < 40_000)
+  }
+
+  t.true(playlist.includes('#EXT-X-MAP:URI="init.mp4"'))
+  t.true(playlist.includes('segment-3.m4s'))
+  t.true(playlist.endsWith('#EXT-X-ENDLIST\n'))
+})
+
+test('Mp4Muxer: segmented and streaming modes are exclusive', (t) => {
+  t.throws(() => new Mp4Muxer({ segmented: {}, streaming: {} }))
+})
+
 // ============================================================================
 // WebMMuxer Tests
 // ============================================================================
@@ -210,6 +409,35 @@ test('WebMMuxer: muxes VP9 video chunks', async (t) => {
   t.is(webmData[3], 0xa3, 'WebM should start with EBML header')
 })
 
+test('WebMMuxer: segmented mode emits init and cluster segments', async (t) => {
+  // 3 seconds at 30fps; keyframes every 1/3s, segments cut every second
+  const { chunks, metadatas } = await encodeVideoClip('vp09.00.10.08', 90, 10)
+
+  const muxer = new WebMMuxer({ segmented: { targetDuration: 1_000_000 } })
+  const delivered = collectSegments(muxer, 4)
+  muxer.addVideoTrack({ codec: 'vp09.00.10.08', width: 320, height: 240 })
+  for (let i = 0; i < chunks.length; i++) {
+    muxer.addVideoChunk(chunks[i], metadatas[i])
+  }
+  t.is(muxer.finalize().length, 0)
+  muxer.close()
+
+  const [init, ...media] = await delivered
+  t.is(init.segmentType, 'init')
+  t.is(init.uri, 'init.webm')
+  t.deepEqual([...init.data.subarray(0, 4)], [0x1a, 0x45, 0xdf, 0xa3], 'EBML header')
+
+  for (const [i, segment] of media.entries()) {
+    t.is(segment.segmentType, 'media')
+    t.is(segment.sequence, i + 1)
+    t.is(segment.uri, `segment-${i + 1}.webm`)
+    // Every segment starts a cluster; keyframes inside it may start more
+    t.deepEqual([...segment.data.subarray(0, 4)], [0x1f, 0x43, 0xb6, 0x75], 'Cluster ID')
+    t.true(Math.abs(segment.timestamp - i * 999_990) < 1000)
+    t.true(Math.abs(segment.duration - 1_000_000) < 40_000)
+  }
+})
+
 test('WebMMuxer: can add Opus audio track', (t) => {
   const muxer = new WebMMuxer()
 
@@ -271,6 +271,208 @@ test('VideoDecoder: decode() preserves frame properties', async (t) => {
   decoder.close()
 })
 
+test('VideoDecoder: keepHardwareFrames frames still support copyTo()', async (t) => {
+  const width = 320
+  const height = 240
+
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(width, height, 1)
+  const { decoder, frames, errors } = createTestDecoder()
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: width, codedHeight: height }),
+    description: decoderConfig?.description,
+    keepHardwareFrames: true,
+  })
+
+  decoder.decode(chunks[0])
+  await decoder.flush()
+
+  t.is(errors.length, 0)
+  t.true(frames.length > 0)
+  const frame = frames[0]
+  const buffer = new Uint8Array(frame.allocationSize())
+  const layout = await frame.copyTo(buffer)
+  t.true(layout.length > 0)
+  t.is(frame.codedWidth, width)
+
+  for (const f of frames) {
+    f.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: keepHardwareFrames keeps decoding while frames stay open', async (t) => {
+  const width = 320
+  const height = 240
+
+  // More frames than stay GPU-resident at once; none are closed until the end
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(width, height, 20)
+  const { decoder, frames, errors } = createTestDecoder()
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: width, codedHeight: height }),
+    description: decoderConfig?.description,
+    keepHardwareFrames: true,
+  })
+
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  t.is(errors.length, 0)
+  t.is(frames.length, chunks.length)
+  const last = frames[frames.length - 1]
+  const layout = await last.copyTo(new Uint8Array(last.allocationSize()))
+  t.true(layout.length > 0)
+
+  for (const frame of frames) {
+    frame.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: desiredWidth/desiredHeight scale decoded frames', async (t) => {
+  const width = 320
+  const height = 240
+
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(width, height, 2)
+  const { decoder, frames, errors } = createTestDecoder()
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: width, codedHeight: height }),
+    description: decoderConfig?.description,
+    desiredWidth: 80,
+    desiredHeight: 60,
+  })
+
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  t.is(errors.length, 0)
+  t.true(frames.length > 0)
+  for (const frame of frames) {
+    t.is(frame.codedWidth, 80)
+    t.is(frame.codedHeight, 60)
+    frame.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: scalerThreads splits output scaling across threads', async (t) => {
+  const width = 640
+  const height = 480
+
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(width, height, 3)
+  const { decoder, frames, errors } = createTestDecoder()
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: width, codedHeight: height }),
+    description: decoderConfig?.description,
+    desiredWidth: 320,
+    desiredHeight: 240,
+    scalerThreads: 4,
+  })
+
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  t.is(errors.length, 0)
+  t.is(frames.length, chunks.length)
+  for (const frame of frames) {
+    t.is(frame.codedWidth, 320)
+    t.is(frame.codedHeight, 240)
+    frame.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: getStats() counts inputs, outputs and codec stages', async (t) => {
+  const width = 320
+  const height = 240
+
+  const { encoder, chunks, getDecoderConfig } = createTestEncoder()
+  encoder.configure(createEncoderConfig('h264', width, height))
+  const input = generateFrameSequence(width, height, 10)
+  for (let i = 0; i < input.length; i++) {
+    encoder.encode(input[i], { keyFrame: i === 0 })
+    input[i].close()
+  }
+  await encoder.flush()
+  encoder.close()
+
+  const { decoder, frames, errors } = createTestDecoder()
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: width, codedHeight: height }),
+    description: getDecoderConfig()?.description,
+  })
+  t.is(decoder.getStats().inputs, 0)
+
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  const stats = decoder.getStats()
+  t.is(errors.length, 0)
+  t.is(stats.inputs, chunks.length)
+  t.is(stats.outputs, frames.length)
+  t.is(stats.dropped, 0)
+  t.is(stats.queueWait.count, chunks.length)
+  t.true(stats.send.count >= chunks.length, 'Every chunk and the flush go through avcodec_send_packet')
+  t.true(stats.receive.count >= frames.length)
+  t.true(stats.callback.count > 0, 'Output callbacks are timed')
+  t.true(stats.callback.maxMs >= stats.callback.meanMs)
+  for (const frame of frames) {
+    frame.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: decodeMode keyframes outputs only keyframes', async (t) => {
+  const width = 320
+  const height = 240
+
+  const { encoder, chunks, getDecoderConfig } = createTestEncoder()
+  encoder.configure(createEncoderConfig('h264', width, height))
+  const input = generateFrameSequence(width, height, 30)
+  for (let i = 0; i < input.length; i++) {
+    encoder.encode(input[i], { keyFrame: i % 10 === 0 })
+    input[i].close()
+  }
+  await encoder.flush()
+  encoder.close()
+
+  const { decoder, frames, errors } = createTestDecoder()
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: width, codedHeight: height }),
+    description: getDecoderConfig()?.description,
+    decodeMode: 'keyframes',
+  })
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  const keyTimestamps = chunks.filter((chunk) => chunk.type === 'key').map((chunk) => chunk.timestamp)
+  t.is(errors.length, 0)
+  t.deepEqual(frames.map((frame) => frame.timestamp), keyTimestamps)
+  t.is(decoder.decodeQueueSize, 0)
+  t.is(decoder.getStats().dropped, chunks.length - keyTimestamps.length)
+  for (const frame of frames) {
+    frame.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: desiredWidth without desiredHeight throws TypeError', (t) => {
+  const { decoder } = createTestDecoder()
+  t.throws(() => decoder.configure({ codec: 'vp8', desiredWidth: 80 }), {
+    instanceOf: TypeError,
+  })
+  decoder.close()
+})
+
 // ============================================================================
 // flush() Tests
 // ============================================================================
@@ -325,6 +527,150 @@ test('VideoDecoder: flush() returns a Promise', async (t) => {
   decoder.close()
 })
 
+// ============================================================================
+// Batched Output Tests
+// ============================================================================
+
+test('VideoDecoder: outputBatch delivers frames in arrays', async (t) => {
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(320, 240, 30)
+
+  const batches: VideoFrame[][] = []
+  let singleOutputs = 0
+  const decoder = new VideoDecoder({
+    output: () => singleOutputs++,
+    error: (e) => t.fail(e.message),
+    outputBatch: (frames) => batches.push(frames),
+    maxBatchSize: 8,
+    maxBatchLatency: 50,
+  })
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: 320, codedHeight: 240 }),
+    description: decoderConfig?.description,
+  })
+
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+
+  const frames = batches.flat()
+  t.is(singleOutputs, 0, 'per-frame output should not be used in batched mode')
+  t.is(frames.length, chunks.length)
+  t.true(batches.every((batch) => batch.length > 0))
+  t.true(batches.length < frames.length, 'frames should be coalesced')
+
+  for (const frame of frames) {
+    frame.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: maxBatchSize must be greater than 0', (t) => {
+  t.throws(
+    () =>
+      new VideoDecoder({
+        output: () => {},
+        error: () => {},
+        outputBatch: () => {},
+        maxBatchSize: 0,
+      }),
+    { instanceOf: TypeError },
+  )
+})
+
+// ============================================================================
+// pipeTo() Tests
+// ============================================================================
+
+test('VideoDecoder: pipeTo() fans decoded frames out to encoders', async (t) => {
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(320, 240, 10)
+
+  let decoderOutputs = 0
+  const decoder = new VideoDecoder({
+    output: (frame) => {
+      decoderOutputs++
+      frame.close()
+    },
+    error: (e) => t.fail(e.message),
+  })
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: 320, codedHeight: 240 }),
+    description: decoderConfig?.description,
+  })
+
+  const renditions = [
+    { width: 320, height: 240 },
+    { width: 160, height: 120 },
+  ].map(({ width, height }) => {
+    const encoded: EncodedVideoChunk[] = []
+    const encoder = new VideoEncoder({
+      output: (chunk) => encoded.push(chunk),
+      error: (e) => t.fail(e.message),
+    })
+    encoder.configure(createEncoderConfig('h264', width, height))
+    return { encoder, encoded }
+  })
+
+  decoder.pipeTo(renditions.map((r) => r.encoder))
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+  await Promise.all(renditions.map((r) => r.encoder.flush()))
+
+  t.is(decoderOutputs, 0, 'output callback should not be used while piped')
+  for (const { encoder, encoded } of renditions) {
+    t.true(encoded.length > 0, 'each encoder should produce chunks')
+    encoder.close()
+  }
+  decoder.close()
+})
+
+test('VideoDecoder: pipeTo() holds back instead of overfilling a slow encoder', async (t) => {
+  const { chunks, decoderConfig } = await createEncodedH264Chunks(320, 240, 30)
+
+  const decoder = new VideoDecoder({
+    output: (frame) => frame.close(),
+    error: (e) => t.fail(e.message),
+  })
+  decoder.configure({
+    ...createDecoderConfig('h264', { codedWidth: 320, codedHeight: 240 }),
+    description: decoderConfig?.description,
+  })
+
+  const encoded: EncodedVideoChunk[] = []
+  const encoder = new VideoEncoder({
+    output: (chunk) => encoded.push(chunk),
+    error: (e) => t.fail(e.message),
+  })
+  encoder.configure({ ...createEncoderConfig('h264', 320, 240), maxQueueSize: 2, queueOverflow: 'throw' })
+
+  decoder.pipeTo([encoder])
+  for (const chunk of chunks) {
+    decoder.decode(chunk)
+  }
+  await decoder.flush()
+  await encoder.flush()
+
+  // Backpressure, not dropping: every decoded frame reaches the encoder
+  t.is(encoder.droppedFrames, 0)
+  t.is(encoded.length, chunks.length)
+
+  encoder.close()
+  decoder.close()
+})
+
+test('VideoDecoder: pipeTo() rejects unconfigured encoders', (t) => {
+  const decoder = new VideoDecoder({ output: () => {}, error: () => {} })
+  const encoder = new VideoEncoder({ output: () => {}, error: () => {} })
+
+  const error = t.throws(() => decoder.pipeTo([encoder]))
+  t.is(error?.name, 'InvalidStateError')
+
+  encoder.close()
+  decoder.close()
+})
+
 // ============================================================================
 // reset() Tests
 // ============================================================================
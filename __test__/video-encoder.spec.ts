@@ -7,10 +7,22 @@
 
 import test from 'ava'
 
-import { resetHardwareFallbackState, VideoEncoder, type EncodedVideoChunkMetadata } from '../index.js'
+import {
+  getCodecThreadBudget,
+  getCodecWorkerThreads,
+  getScalerThreads,
+  resetHardwareFallbackState,
+  setCodecThreadBudget,
+  setCodecWorkerThreads,
+  setScalerThreads,
+  VideoEncoder,
+  type EncodedVideoChunkMetadata,
+} from '../index.js'
 import {
   generateSolidColorI420Frame,
   generateSolidColorI420AFrame,
+  generateSolidColorRGBAFrame,
+  generateCheckerboardI420Frame,
   generateFrameSequence,
   TestColors,
   hasHardwareAcceleration,
@@ -229,6 +241,203 @@ test('VideoEncoder: encode() preserves timestamp', async (t) => {
   encoder.close()
 })
 
+test('VideoEncoder: RGBA conversion reuses pooled frames', async (t) => {
+  const { encoder, chunks, errors } = createTestEncoder()
+  encoder.configure(
+    createEncoderConfig('h264', 320, 240, { hardwareAcceleration: 'prefer-software', latencyMode: 'realtime' }),
+  )
+
+  t.is(encoder.getFramePoolStats().hits, 0)
+
+  const encodeBatch = async (start: number) => {
+    for (let i = start; i < start + 10; i++) {
+      const frame = generateSolidColorRGBAFrame(320, 240, TestColors.red, i * 33333)
+      encoder.encode(frame, { keyFrame: i === 0 })
+      frame.close()
+    }
+    await encoder.flush()
+    return encoder.getFramePoolStats()
+  }
+
+  const warm = await encodeBatch(0)
+  t.is(warm.hits + warm.misses, 10, 'Every RGBA frame goes through the pool')
+  t.true(warm.hits > 0, 'Converted frames should be recycled')
+
+  // Once warm, the conversion loop should not allocate at all
+  const steady = await encodeBatch(10)
+  t.is(errors.length, 0)
+  t.true(chunks.length > 0)
+  t.is(steady.hits - warm.hits, 10, 'Steady-state conversions should all reuse pooled frames')
+  t.is(steady.misses, warm.misses)
+  t.true(steady.size <= steady.capacity)
+  t.true(steady.hitRate > 0 && steady.hitRate <= 1)
+
+  encoder.close()
+})
+
+test('VideoEncoder: getStats() counts inputs, outputs and codec stages', async (t) => {
+  const { encoder, chunks } = createTestEncoder()
+  encoder.configure(createEncoderConfig('h264', 320, 240))
+
+  t.is(encoder.getStats().inputs, 0)
+
+  for (let i = 0; i < 5; i++) {
+    const frame = generateSolidColorI420Frame(320, 240, TestColors.blue, i * 33333)
+    encoder.encode(frame, { keyFrame: i === 0 })
+    frame.close()
+  }
+  await encoder.flush()
+
+  const stats = encoder.getStats()
+  t.is(stats.inputs, 5)
+  t.is(stats.outputs, chunks.length)
+  t.is(stats.dropped, 0)
+  t.is(stats.queueWait.count, 5)
+  t.true(stats.send.count >= 5, 'Every frame and the flush go through avcodec_send_frame')
+  t.true(stats.receive.count > 0)
+  t.true(stats.send.maxMs >= stats.send.meanMs)
+
+  encoder.close()
+})
+
+test('VideoEncoder: outputBatch delivers chunks and metadata in arrays', async (t) => {
+  const batches: Array<{ chunks: EncodedVideoChunk[]; metadata: EncodedVideoChunkMetadata[] }> = []
+  let singleOutputs = 0
+  const encoder = new VideoEncoder({
+    output: () => singleOutputs++,
+    error: (e) => t.fail(e.message),
+    outputBatch: (chunks, metadata) => batches.push({ chunks, metadata }),
+    maxBatchSize: 4,
+  })
+  encoder.configure(createEncoderConfig('h264', 320, 240, { latencyMode: 'realtime' }))
+
+  const frames = generateFrameSequence(320, 240, 20)
+  encoder.encode(frames[0], { keyFrame: true })
+  for (let i = 1; i < frames.length; i++) {
+    encoder.encode(frames[i])
+  }
+  for (const frame of frames) {
+    frame.close()
+  }
+  await encoder.flush()
+
+  const chunks = batches.flatMap((batch) => batch.chunks)
+  t.is(singleOutputs, 0, 'per-chunk output should not be used in batched mode')
+  t.is(chunks.length, frames.length)
+  t.true(batches.every((batch) => batch.chunks.length === batch.metadata.length))
+  t.is(chunks[0].type, 'key')
+  t.truthy(batches[0].metadata[0].decoderConfig)
+
+  encoder.close()
+})
+
+test.serial('VideoEncoder: scalerThreads splits input scaling across threads', async (t) => {
+  // A single codec thread keeps libx264 output deterministic, so only the scaler differs
+  const previousBudget = getCodecThreadBudget()
+  setCodecThreadBudget(1)
+  t.teardown(() => setCodecThreadBudget(previousBudget))
+
+  const encode = async (scalerThreads: number) => {
+    const { encoder, chunks, errors } = createTestEncoder()
+    const config = createEncoderConfig('h264', 320, 240, {
+      hardwareAcceleration: 'prefer-software',
+      latencyMode: 'realtime',
+    })
+    encoder.configure({ ...config, scalerThreads })
+
+    // Downscaling detailed frames goes through swscale, not a same-size fast path
+    for (let i = 0; i < 5; i++) {
+      const frame = generateCheckerboardI420Frame(640, 480, i * 33333, 8 + i)
+      encoder.encode(frame, { keyFrame: i === 0 })
+      frame.close()
+    }
+    await encoder.flush()
+
+    const reported = encoder.getFramePoolStats().scalerThreads
+    encoder.close()
+    t.is(errors.length, 0)
+    const data = chunks.map((chunk) => {
+      const bytes = new Uint8Array(chunk.byteLength)
+      chunk.copyTo(bytes)
+      return bytes
+    })
+    return { reported, data }
+  }
+
+  const threaded = await encode(4)
+  const single = await encode(1)
+
+  t.is(threaded.reported, 4)
+  t.is(single.reported, 1)
+  t.is(threaded.data.length, 5)
+  t.deepEqual(threaded.data, single.data, 'Threaded scaling should match single-threaded output')
+})
+
+test('setScalerThreads() sets the default scaler thread count', (t) => {
+  const previous = getScalerThreads()
+  t.is(previous, 1)
+  setScalerThreads(0)
+  t.is(getScalerThreads(), 0)
+  setScalerThreads(previous)
+  t.is(getScalerThreads(), previous)
+})
+
+test('setCodecThreadBudget() limits codec threads without affecting output', async (t) => {
+  const previous = getCodecThreadBudget()
+  t.true(previous >= 1)
+  setCodecThreadBudget(1)
+  t.is(getCodecThreadBudget(), 1)
+
+  const { encoder, chunks, errors } = createTestEncoder()
+  encoder.configure(createEncoderConfig('h264', 320, 240))
+  setCodecThreadBudget(previous)
+
+  const frames = generateFrameSequence(320, 240, 5)
+  frames.forEach((frame, i) => encoder.encode(frame, { keyFrame: i === 0 }))
+  for (const frame of frames) {
+    frame.close()
+  }
+  await encoder.flush()
+
+  t.is(errors.length, 0)
+  t.is(chunks.length, 5)
+  encoder.close()
+})
+
+test('setCodecWorkerThreads() runs encoders on a shared pool in order', async (t) => {
+  const previous = getCodecWorkerThreads()
+  t.is(previous, 0)
+  setCodecWorkerThreads(2)
+  t.is(getCodecWorkerThreads(), 2)
+
+  // More encoders than pool threads; each must still see its frames in order
+  const encoders = Array.from({ length: 3 }, () => createTestEncoder())
+
+  // The running pool can't be resized; going back to dedicated threads can
+  t.throws(() => setCodecWorkerThreads(4), { message: /InvalidStateError/ })
+  t.notThrows(() => setCodecWorkerThreads(2))
+  setCodecWorkerThreads(previous)
+  t.is(getCodecWorkerThreads(), 0)
+
+  const frames = generateFrameSequence(320, 240, 5)
+  for (const { encoder } of encoders) {
+    encoder.configure(createEncoderConfig('h264', 320, 240))
+    frames.forEach((frame, i) => encoder.encode(frame, { keyFrame: i === 0 }))
+  }
+  for (const frame of frames) {
+    frame.close()
+  }
+
+  await Promise.all(encoders.map(({ encoder }) => encoder.flush()))
+
+  for (const { encoder, chunks, errors } of encoders) {
+    t.is(errors.length, 0)
+    t.is(chunks.length, 5)
+    t.is(chunks[0].type, 'key')
+    encoder.close()
+  }
+})
+
 // ============================================================================
 // flush() Tests
 // ============================================================================
@@ -327,6 +536,28 @@ test('VideoEncoder: reset() then reconfigure allows new encoding', async (t) =>
   encoder.close()
 })
 
+test('VideoEncoder: bitrate-only reconfigure keeps the running encoder', async (t) => {
+  const { encoder, chunks, errors } = createTestEncoder()
+  const config = createEncoderConfig('h264', 320, 240, { hardwareAcceleration: 'prefer-software' })
+  encoder.configure(config)
+
+  const frames = generateFrameSequence(320, 240, 8)
+  frames.slice(0, 4).forEach((frame, i) => encoder.encode(frame, { keyFrame: i === 0 }))
+  encoder.configure({ ...config, bitrate: config.bitrate! / 2 })
+  t.is(encoder.state, 'configured')
+  frames.slice(4).forEach((frame) => encoder.encode(frame))
+  for (const frame of frames) {
+    frame.close()
+  }
+  await encoder.flush()
+
+  t.is(errors.length, 0)
+  t.is(chunks.length, 8)
+  // A rebuilt encoder would have to start over with a keyframe
+  t.is(chunks.filter((chunk) => chunk.type === 'key').length, 1)
+  encoder.close()
+})
+
 // ============================================================================
 // isConfigSupported() Tests
 // ============================================================================
@@ -467,6 +698,95 @@ test('VideoEncoder: ondequeue can be set to null', (t) => {
   encoder.close()
 })
 
+// ============================================================================
+// Queue Policy Tests (non-standard maxQueueSize / queueOverflow)
+// ============================================================================
+
+test('VideoEncoder: drop-newest-delta drops delta frames over maxQueueSize', async (t) => {
+  const { encoder, chunks, errors } = createTestEncoder()
+  let frameDrops = 0
+  encoder.addEventListener('framedrop', () => {
+    frameDrops++
+  })
+
+  encoder.configure({
+    ...createEncoderConfig('h264', 320, 240),
+    maxQueueSize: 2,
+    queueOverflow: 'drop-newest-delta',
+  })
+
+  // The whole burst is queued before the worker sees any of it
+  const frames = generateFrameSequence(320, 240, 6)
+  frames.forEach((frame, i) => encoder.encode(frame, { keyFrame: i === 0 || i === 5 }))
+  for (const frame of frames) {
+    frame.close()
+  }
+  t.is(encoder.encodeQueueSize, 3)
+  await encoder.flush()
+  await new Promise((resolve) => setImmediate(resolve))
+
+  t.is(errors.length, 0)
+  t.is(encoder.droppedFrames, 3)
+  t.is(frameDrops, 3)
+  t.is(chunks.length, 3)
+  t.is(chunks[2].type, 'key')
+  encoder.close()
+})
+
+test('VideoEncoder: throw policy throws QuotaExceededError until a dequeue', async (t) => {
+  const { encoder, chunks, errors } = createTestEncoder()
+  encoder.configure({ ...createEncoderConfig('h264', 320, 240), maxQueueSize: 2, queueOverflow: 'throw' })
+
+  const frames = generateFrameSequence(320, 240, 6)
+  encoder.encode(frames[0], { keyFrame: true })
+  encoder.encode(frames[1])
+  // encode() never waits on the JS thread; the caller waits for 'dequeue'
+  const error = t.throws(() => encoder.encode(frames[2]))
+  t.is(error?.name, 'QuotaExceededError')
+
+  for (const frame of frames.slice(2)) {
+    while (encoder.encodeQueueSize >= 2) {
+      await new Promise((resolve) => encoder.addEventListener('dequeue', resolve, { once: true }))
+    }
+    encoder.encode(frame)
+  }
+  for (const frame of frames) {
+    frame.close()
+  }
+  await encoder.flush()
+
+  t.is(errors.length, 0)
+  t.is(encoder.droppedFrames, 0)
+  t.is(chunks.length, 6)
+  encoder.close()
+})
+
+test('VideoEncoder: drop-oldest keeps keyframe requests of dropped frames', async (t) => {
+  const { encoder, chunks, errors } = createTestEncoder()
+  encoder.configure({ ...createEncoderConfig('h264', 320, 240), maxQueueSize: 1 })
+
+  const frames = generateFrameSequence(320, 240, 8)
+  frames.forEach((frame, i) => encoder.encode(frame, { keyFrame: i === 0 }))
+  for (const frame of frames) {
+    frame.close()
+  }
+  await encoder.flush()
+
+  t.is(errors.length, 0)
+  t.is(chunks.length + encoder.droppedFrames, 8)
+  t.true(chunks.length >= 1)
+  t.is(chunks[0].type, 'key')
+  encoder.close()
+})
+
+test('VideoEncoder: configure() rejects maxQueueSize of 0', (t) => {
+  const { encoder } = createTestEncoder()
+  t.throws(() => encoder.configure({ ...createEncoderConfig('h264', 320, 240), maxQueueSize: 0 }), {
+    instanceOf: TypeError,
+  })
+  encoder.close()
+})
+
 // ============================================================================
 // Alpha Channel Encoding Tests
 // ============================================================================
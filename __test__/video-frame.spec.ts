@@ -6,7 +6,7 @@
 
 import test from 'ava'
 
-import { VideoFrame } from '../index.js'
+import { getFrameMemoryStats, setFrameMemoryBudget, setFrameMemoryPressureListener, VideoFrame } from '../index.js'
 import {
   generateSolidColorI420Frame,
   generateSolidColorRGBAFrame,
@@ -237,6 +237,109 @@ test('VideoFrame: copyTo() preserves data round-trip', async (t) => {
   frame.close()
 })
 
+test('VideoFrame: repeated RGBA copyTo() on a frame and its clone match', async (t) => {
+  const frame = generateGradientI420Frame(128, 96, 0)
+  const cloned = frame.clone()
+  const size = frame.allocationSize({ format: 'RGBA' })
+
+  const first = new Uint8Array(size)
+  const second = new Uint8Array(size)
+  const fromClone = new Uint8Array(size)
+  await frame.copyTo(first, { format: 'RGBA' })
+  await frame.copyTo(second, { format: 'RGBA' })
+  // Cropped copy of the cached conversion
+  const cropped = new Uint8Array(64 * 48 * 4)
+  await frame.copyTo(cropped, { format: 'RGBA', rect: { x: 32, y: 24, width: 64, height: 48 } })
+  frame.close()
+  await cloned.copyTo(fromClone, { format: 'RGBA' })
+
+  t.deepEqual(second, first)
+  t.deepEqual(fromClone, first)
+  for (let row = 0; row < 48; row++) {
+    const start = ((24 + row) * 128 + 32) * 4
+    t.deepEqual(cropped.subarray(row * 64 * 4, (row + 1) * 64 * 4), first.subarray(start, start + 64 * 4))
+  }
+
+  cloned.close()
+})
+
+test('VideoFrame: copyTo() of a 4K frame preserves data', async (t) => {
+  const width = 3840
+  const height = 2160
+  const size = calculateI420Size(width, height)
+  const data = new Uint8Array(size)
+  for (let i = 0; i < size; i++) {
+    data[i] = (i * 7) % 251
+  }
+
+  const frame = new VideoFrame(data, { format: 'I420', codedWidth: width, codedHeight: height, timestamp: 0 })
+  const out = new Uint8Array(size)
+  await frame.copyTo(out)
+  t.true(Buffer.from(out).equals(Buffer.from(data)))
+
+  frame.close()
+})
+
+test('VideoFrame: transfer detaches the source buffer', async (t) => {
+  const width = 64
+  const height = 48
+  const size = calculateI420Size(width, height)
+
+  const copied = new Uint8Array(size).fill(16)
+  const transferred = new Uint8Array(size).fill(16)
+
+  const copiedFrame = new VideoFrame(copied, { format: 'I420', codedWidth: width, codedHeight: height, timestamp: 0 })
+  const transferredFrame = new VideoFrame(transferred, {
+    format: 'I420',
+    codedWidth: width,
+    codedHeight: height,
+    timestamp: 0,
+    transfer: [transferred.buffer],
+  })
+
+  // Without transfer the source stays usable and independent of the frame
+  t.is(copied.byteLength, size)
+  copied[0] = 200
+  // The transferred buffer is detached, so user code can't change the frame
+  t.is(transferred.buffer.byteLength, 0)
+
+  const out = new Uint8Array(size)
+  await copiedFrame.copyTo(out)
+  t.is(out[0], 16)
+  await transferredFrame.copyTo(out)
+  t.is(out[0], 16)
+  t.is(out[size - 1], 16)
+
+  copiedFrame.close()
+  transferredFrame.close()
+})
+
+test('VideoFrame: transfer with padded layout copies and still detaches', async (t) => {
+  const width = 64
+  const height = 48
+  const stride = 80
+  const data = new Uint8Array(stride * height * 2).fill(32)
+
+  const frame = new VideoFrame(data, {
+    format: 'NV12',
+    codedWidth: width,
+    codedHeight: height,
+    timestamp: 0,
+    layout: [
+      { offset: 0, stride },
+      { offset: stride * height, stride },
+    ],
+    transfer: [data.buffer],
+  })
+
+  t.is(data.buffer.byteLength, 0)
+  const out = new Uint8Array(frame.allocationSize())
+  await frame.copyTo(out)
+  t.is(out[0], 32)
+
+  frame.close()
+})
+
 test('VideoFrame: clone() creates independent copy', async (t) => {
   const frame = generateSolidColorI420Frame(128, 96, TestColors.yellow, 12345, 33333)
 
@@ -328,3 +431,61 @@ test('VideoFrame: gradient pattern creates varied data', async (t) => {
 
   frame.close()
 })
+
+// ============================================================================
+// Frame Memory Accounting Tests (non-standard)
+// ============================================================================
+
+// Budgets are process-wide, so these run serially (before the concurrent tests)
+test.serial('frame memory: close() releases pixel buffers', (t) => {
+  const before = getFrameMemoryStats().liveBytes
+  const frame = generateSolidColorI420Frame(640, 480, TestColors.red, 0)
+
+  t.is(getFrameMemoryStats().liveBytes - before, calculateI420Size(640, 480))
+  frame.close()
+  t.is(getFrameMemoryStats().liveBytes, before)
+})
+
+test.serial('frame memory: cached copyTo() conversions are charged until close()', async (t) => {
+  const frame = generateSolidColorI420Frame(640, 480, TestColors.red, 0)
+  const rgba = new Uint8Array(calculateRGBASize(640, 480))
+  const before = getFrameMemoryStats().liveBytes
+
+  // A one-off conversion is freed once copied
+  await frame.copyTo(rgba, { format: 'RGBA', cacheConversion: false })
+  t.is(getFrameMemoryStats().liveBytes, before)
+
+  await frame.copyTo(rgba, { format: 'RGBA' })
+  t.is(getFrameMemoryStats().liveBytes - before, calculateRGBASize(640, 480))
+  frame.close()
+  t.is(getFrameMemoryStats().liveBytes, before - calculateI420Size(640, 480))
+})
+
+test.serial('frame memory: hard budget refuses allocations and fires pressure events', async (t) => {
+  // Listener calls are delivered asynchronously
+  const levels: string[] = []
+  const delivered = new Promise<void>((resolve) => {
+    setFrameMemoryPressureListener((event) => {
+      levels.push(event.level)
+      if (event.level === 'normal') {
+        resolve()
+      }
+    })
+  })
+  setFrameMemoryBudget({ hardLimit: getFrameMemoryStats().liveBytes + calculateI420Size(640, 480) })
+
+  try {
+    const frame = generateSolidColorI420Frame(640, 480, TestColors.red, 0)
+    t.throws(() => generateSolidColorI420Frame(640, 480, TestColors.blue, 0))
+    t.is(getFrameMemoryStats().pressure, 'hard')
+    t.true(getFrameMemoryStats().refusedAllocations >= 1)
+    frame.close()
+    t.is(getFrameMemoryStats().pressure, 'normal')
+  } finally {
+    setFrameMemoryBudget({ softLimit: 0, hardLimit: 0 })
+  }
+
+  await delivered
+  setFrameMemoryPressureListener(null)
+  t.deepEqual(levels, ['hard', 'normal'])
+})
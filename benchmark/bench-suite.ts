@@ -0,0 +1,118 @@
+/**
+ * Native benchmark and regression suite for @napi-rs/webcodecs
+ *
+ * Covers encode/decode per codec and resolution (software and, where
+ * available, hardware), VideoFrame construction and copyTo conversions,
+ * audio encoding with and without resampling, demux/mux/remux throughput
+ * and concurrency scaling. Each scenario runs in its own process so peak
+ * RSS and GC counters aren't shared between scenarios.
+ *
+ * Run with:
+ *   node --import @oxc-node/core/register benchmark/bench-suite.ts [--quick] [--filter <substring>] [--output <file>]
+ *
+ * Compare two reports with:
+ *   node --import @oxc-node/core/register benchmark/compare.ts --baseline <file> --current <file>
+ */
+
+import { execFileSync } from 'node:child_process'
+import * as fs from 'node:fs'
+import * as os from 'node:os'
+import { parseArgs } from 'node:util'
+
+import chalk from 'chalk'
+
+import type { ScenarioResult, SuiteReport } from './suite/harness.js'
+import { buildScenarios } from './suite/scenarios.js'
+
+const { values } = parseArgs({
+  options: {
+    scenario: { type: 'string' },
+    filter: { type: 'string' },
+    output: { type: 'string', default: 'benchmark/results.json' },
+    quick: { type: 'boolean', default: false },
+  },
+})
+
+const options = { quick: values.quick }
+const scenarios = buildScenarios(options)
+
+if (values.scenario) {
+  // Child mode: run one scenario and print its result as JSON on stdout
+  const scenario = scenarios.find((s) => s.name === values.scenario)
+  if (!scenario) {
+    console.error(`Unknown scenario: ${values.scenario}`)
+    process.exit(1)
+  }
+  const result = await scenario.run(options)
+  process.stdout.write(JSON.stringify(result))
+  process.exit(0)
+}
+
+const selected = values.filter ? scenarios.filter((s) => s.name.includes(values.filter!)) : scenarios
+
+console.log(chalk.bold.white('\n' + '='.repeat(70)))
+console.log(chalk.bold.white(' @napi-rs/webcodecs benchmark suite'))
+console.log(chalk.bold.white('='.repeat(70)))
+console.log(chalk.gray(`  Node.js: ${process.version}`))
+console.log(chalk.gray(`  Platform: ${process.platform} ${process.arch}, ${os.cpus().length} CPUs`))
+console.log(chalk.gray(`  Scenarios: ${selected.length}${values.quick ? ' (quick)' : ''}`))
+console.log()
+
+const results: ScenarioResult[] = []
+for (const scenario of selected) {
+  const args = ['--import', '@oxc-node/core/register', 'benchmark/bench-suite.ts', '--scenario', scenario.name]
+  if (values.quick) {
+    args.push('--quick')
+  }
+  let result: ScenarioResult
+  try {
+    const output = execFileSync(process.execPath, args, {
+      encoding: 'utf-8',
+      stdio: ['ignore', 'pipe', 'inherit'], // inherit stderr for error visibility
+      cwd: process.cwd(),
+    })
+    result = JSON.parse(output.trim())
+  } catch (e) {
+    result = {
+      name: scenario.name,
+      group: scenario.group,
+      items: 0,
+      totalMs: 0,
+      throughput: 0,
+      peakRssBytes: 0,
+      heapPeakBytes: 0,
+      externalPeakBytes: 0,
+      gcCount: 0,
+      gcPauseMs: 0,
+      skipped: `failed: ${(e as Error).message.split('\n')[0]}`,
+    }
+  }
+  results.push(result)
+
+  if (result.skipped) {
+    console.log(`  ${scenario.name.padEnd(42)} ${chalk.gray(result.skipped)}`)
+  } else {
+    const latency = result.latencyMs
+      ? ` p50 ${result.latencyMs.p50.toFixed(2)}ms p99 ${result.latencyMs.p99.toFixed(2)}ms`
+      : ''
+    console.log(
+      `  ${scenario.name.padEnd(42)} ${chalk.green(`${result.throughput.toFixed(1)}/s`)}${latency} ` +
+        chalk.gray(`rss ${(result.peakRssBytes / 1024 / 1024).toFixed(0)}MB gc ${result.gcCount}`),
+    )
+  }
+}
+
+const report: SuiteReport = {
+  version: 1,
+  meta: {
+    node: process.version,
+    platform: process.platform,
+    arch: process.arch,
+    cpus: os.cpus().length,
+    date: new Date().toISOString(),
+    quick: values.quick,
+  },
+  results,
+}
+fs.writeFileSync(values.output, JSON.stringify(report, null, 2) + '\n')
+console.log(chalk.cyan(`\n  Report written to ${values.output}\n`))
@@ -5,12 +5,20 @@
  * Runs each implementation in a separate process to avoid FFmpeg global state conflicts.
  *
  * Run with: node --import @oxc-node/core/register benchmark/compare.ts
+ *
+ * With `--baseline <file> --current <file>`, diffs two benchmark suite
+ * reports (see bench-suite.ts) instead. `--threshold <percent>` sets the
+ * regression threshold (default 10) and `--fail-on-regression` exits
+ * non-zero when any metric regressed.
  */
 
 import { execSync } from 'node:child_process'
+import { parseArgs } from 'node:util'
 
 import chalk from 'chalk'
 
+import { diffReports } from './suite/diff.js'
+
 interface Results {
   decodeFps: number
   encodeFps: number
@@ -37,6 +45,28 @@ console.log(chalk.gray(`  Node.js: ${process.version}`))
 console.log(chalk.gray(`  Platform: ${process.platform} ${process.arch}`))
 console.log(chalk.gray(`  Video: small_buck_bunny.mp4`))
 
+const { values: args } = parseArgs({
+  options: {
+    baseline: { type: 'string' },
+    current: { type: 'string' },
+    threshold: { type: 'string', default: '10' },
+    'fail-on-regression': { type: 'boolean', default: false },
+  },
+})
+
+if (args.baseline || args.current) {
+  if (!args.baseline || !args.current) {
+    console.error('--baseline and --current must be given together')
+    process.exit(1)
+  }
+  const regressions = diffReports({
+    baseline: args.baseline,
+    current: args.current,
+    thresholdPercent: Number(args.threshold),
+  })
+  process.exit(regressions > 0 && args['fail-on-regression'] ? 1 : 0)
+}
+
 // Run napi-rs benchmark
 console.log(chalk.cyan('\nRunning @napi-rs/webcodecs benchmark...'))
 const napiStart = performance.now()
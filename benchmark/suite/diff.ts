@@ -0,0 +1,136 @@
+/**
+ * Baseline comparison for benchmark suite reports
+ *
+ * Throughput is higher-is-better; latency percentiles and peak RSS are
+ * lower-is-better. A metric regresses when it moves the wrong way by more
+ * than the threshold.
+ */
+
+import * as fs from 'node:fs'
+
+import chalk from 'chalk'
+
+import type { ScenarioResult, SuiteReport } from './harness.js'
+
+interface Metric {
+  label: string
+  higherIsBetter: boolean
+  get: (result: ScenarioResult) => number | undefined
+  format: (value: number) => string
+}
+
+const METRICS: Metric[] = [
+  {
+    label: 'throughput',
+    higherIsBetter: true,
+    get: (r) => r.throughput,
+    format: (v) => `${v.toFixed(1)}/s`,
+  },
+  {
+    label: 'p50',
+    higherIsBetter: false,
+    get: (r) => r.latencyMs?.p50,
+    format: (v) => `${v.toFixed(2)}ms`,
+  },
+  {
+    label: 'p99',
+    higherIsBetter: false,
+    get: (r) => r.latencyMs?.p99,
+    format: (v) => `${v.toFixed(2)}ms`,
+  },
+  {
+    label: 'peak RSS',
+    higherIsBetter: false,
+    get: (r) => r.peakRssBytes,
+    format: (v) => `${(v / 1024 / 1024).toFixed(1)}MB`,
+  },
+]
+
+export interface DiffOptions {
+  baseline: string
+  current: string
+  /** Relative change treated as a regression, in percent */
+  thresholdPercent: number
+}
+
+function loadReport(file: string): SuiteReport {
+  const report = JSON.parse(fs.readFileSync(file, 'utf-8')) as SuiteReport
+  if (report.version !== 1 || !Array.isArray(report.results)) {
+    throw new Error(`${file} is not a benchmark suite report`)
+  }
+  return report
+}
+
+/** Print a per-scenario diff; returns the number of regressed metrics */
+export function diffReports(options: DiffOptions): number {
+  const baseline = loadReport(options.baseline)
+  const current = loadReport(options.current)
+  const baselineByName = new Map(baseline.results.map((r) => [r.name, r]))
+
+  console.log(chalk.bold.white('\n' + '='.repeat(70)))
+  console.log(chalk.bold.white(' Benchmark suite: current vs baseline'))
+  console.log(chalk.bold.white('='.repeat(70)))
+  console.log(chalk.gray(`  Baseline: ${options.baseline} (${baseline.meta.date})`))
+  console.log(chalk.gray(`  Current:  ${options.current} (${current.meta.date})`))
+  console.log(chalk.gray(`  Threshold: ${options.thresholdPercent}%`))
+  if (baseline.meta.platform !== current.meta.platform || baseline.meta.arch !== current.meta.arch) {
+    console.log(chalk.yellow('  Warning: reports come from different platforms'))
+  }
+  if (baseline.meta.quick !== current.meta.quick) {
+    console.log(chalk.yellow('  Warning: comparing a --quick run with a full run'))
+  }
+
+  let regressions = 0
+  let improvements = 0
+  for (const result of current.results) {
+    const before = baselineByName.get(result.name)
+    console.log()
+    if (result.skipped) {
+      console.log(`  ${chalk.white(result.name)} ${chalk.gray(`skipped: ${result.skipped}`)}`)
+      continue
+    }
+    if (!before || before.skipped) {
+      console.log(`  ${chalk.white(result.name)} ${chalk.gray('new (no baseline)')}`)
+      continue
+    }
+    console.log(`  ${chalk.white(result.name)}`)
+
+    for (const metric of METRICS) {
+      const a = metric.get(before)
+      const b = metric.get(result)
+      if (a === undefined || b === undefined || a === 0) {
+        continue
+      }
+      const change = ((b - a) / a) * 100
+      const worse = metric.higherIsBetter ? change < -options.thresholdPercent : change > options.thresholdPercent
+      const better = metric.higherIsBetter ? change > options.thresholdPercent : change < -options.thresholdPercent
+      const sign = change >= 0 ? '+' : ''
+      const delta = `${sign}${change.toFixed(1)}%`
+      const status = worse ? chalk.red(`${delta} regression`) : better ? chalk.green(delta) : chalk.gray(delta)
+      if (worse) {
+        regressions++
+      } else if (better) {
+        improvements++
+      }
+      console.log(
+        `    ${metric.label.padEnd(11)} ${metric.format(a).padStart(12)} → ${metric.format(b).padStart(12)}  ${status}`,
+      )
+    }
+  }
+
+  const currentNames = new Set(current.results.map((r) => r.name))
+  const missing = baseline.results.filter((r) => !currentNames.has(r.name))
+  if (missing.length > 0) {
+    console.log()
+    console.log(chalk.yellow(`  Missing from current run: ${missing.map((r) => r.name).join(', ')}`))
+  }
+
+  console.log()
+  console.log(
+    regressions > 0
+      ? chalk.red(`  ${regressions} regressed metric(s), ${improvements} improved`)
+      : chalk.green(`  No regressions, ${improvements} improved metric(s)`),
+  )
+  console.log()
+  return regressions
+}
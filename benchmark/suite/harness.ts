@@ -0,0 +1,199 @@
+/**
+ * Measurement helpers for the benchmark suite
+ *
+ * Every scenario runs in its own process (see bench-suite.ts), so peak RSS
+ * and GC counters describe that scenario alone.
+ */
+
+import { PerformanceObserver } from 'node:perf_hooks'
+
+/** Latency distribution in milliseconds */
+export interface LatencyStats {
+  p50: number
+  p99: number
+  mean: number
+  max: number
+}
+
+/** One scenario result, as written to the suite JSON */
+export interface ScenarioResult {
+  name: string
+  group: string
+  /** Items processed (frames, chunks, packets or audio buffers) */
+  items: number
+  totalMs: number
+  /** Items per second over the whole run */
+  throughput: number
+  /** Per-item latency, when the scenario can attribute it */
+  latencyMs?: LatencyStats
+  /** Peak resident set size of the scenario process */
+  peakRssBytes: number
+  /** Peak V8 heap usage sampled during the run */
+  heapPeakBytes: number
+  /** Peak memory held by ArrayBuffers and native objects tracked by V8 */
+  externalPeakBytes: number
+  /** Garbage collections during the run, a proxy for allocation pressure */
+  gcCount: number
+  gcPauseMs: number
+  /** Scenario-specific numbers (e.g. bytes per frame, instance count) */
+  extra?: Record<string, number>
+  /** Reason the scenario could not run on this machine */
+  skipped?: string
+}
+
+/** Suite output consumed by compare.ts */
+export interface SuiteReport {
+  version: 1
+  meta: {
+    node: string
+    platform: string
+    arch: string
+    cpus: number
+    date: string
+    quick: boolean
+  }
+  results: ScenarioResult[]
+}
+
+export function percentile(sorted: number[], p: number): number {
+  if (sorted.length === 0) {
+    return 0
+  }
+  const index = Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1)
+  return sorted[Math.max(0, index)]!
+}
+
+export function latencyStats(samples: number[]): LatencyStats | undefined {
+  if (samples.length === 0) {
+    return undefined
+  }
+  const sorted = [...samples].sort((a, b) => a - b)
+  const sum = sorted.reduce((acc, v) => acc + v, 0)
+  return {
+    p50: percentile(sorted, 50),
+    p99: percentile(sorted, 99),
+    mean: sum / sorted.length,
+    max: sorted[sorted.length - 1]!,
+  }
+}
+
+/**
+ * Tracks per-item latency by key (usually the frame timestamp)
+ *
+ * `start(key)` when an item is submitted, `end(key)` when its output
+ * arrives. Outputs without a matching start are ignored.
+ */
+export class LatencyTracker {
+  private pending = new Map<number, number>()
+  readonly samples: number[] = []
+
+  start(key: number) {
+    this.pending.set(key, performance.now())
+  }
+
+  end(key: number) {
+    const start = this.pending.get(key)
+    if (start !== undefined) {
+      this.pending.delete(key)
+      this.samples.push(performance.now() - start)
+    }
+  }
+}
+
+/** Context handed to a scenario body */
+export interface MeasureContext {
+  /** Record one processed item without latency */
+  count: (items?: number) => void
+  latency: LatencyTracker
+  extra: Record<string, number>
+}
+
+/**
+ * Run `body`, measuring wall time, memory peaks and GC activity
+ *
+ * Memory is sampled every 5 ms (and once at the end) because RSS alone
+ * can't distinguish JS heap growth from native buffers.
+ */
+export async function measure(
+  name: string,
+  group: string,
+  body: (ctx: MeasureContext) => Promise<void>,
+): Promise<ScenarioResult> {
+  let items = 0
+  const ctx: MeasureContext = {
+    count: (n = 1) => {
+      items += n
+    },
+    latency: new LatencyTracker(),
+    extra: {},
+  }
+
+  let gcCount = 0
+  let gcPauseMs = 0
+  const observer = new PerformanceObserver((list) => {
+    for (const entry of list.getEntries()) {
+      gcCount++
+      gcPauseMs += entry.duration
+    }
+  })
+  observer.observe({ entryTypes: ['gc'] })
+
+  let heapPeakBytes = 0
+  let externalPeakBytes = 0
+  const sample = () => {
+    const usage = process.memoryUsage()
+    heapPeakBytes = Math.max(heapPeakBytes, usage.heapUsed)
+    externalPeakBytes = Math.max(externalPeakBytes, usage.external + usage.arrayBuffers)
+  }
+  sample()
+  const sampler = setInterval(sample, 5)
+
+  const start = performance.now()
+  try {
+    await body(ctx)
+  } finally {
+    clearInterval(sampler)
+  }
+  const totalMs = performance.now() - start
+  sample()
+
+  // Let pending GC entries be delivered before disconnecting
+  await new Promise((resolve) => setImmediate(resolve))
+  observer.disconnect()
+
+  if (items === 0) {
+    items = ctx.latency.samples.length
+  }
+
+  return {
+    name,
+    group,
+    items,
+    totalMs,
+    throughput: totalMs > 0 ? (items / totalMs) * 1000 : 0,
+    latencyMs: latencyStats(ctx.latency.samples),
+    peakRssBytes: process.resourceUsage().maxRSS * 1024,
+    heapPeakBytes,
+    externalPeakBytes,
+    gcCount,
+    gcPauseMs,
+    extra: Object.keys(ctx.extra).length > 0 ? ctx.extra : undefined,
+  }
+}
+
+/** Result for a scenario that can't run here (e.g. no hardware encoder) */
+export function skipped(name: string, group: string, reason: string): ScenarioResult {
+  return {
+    name,
+    group,
+    items: 0,
+    totalMs: 0,
+    throughput: 0,
+    peakRssBytes: process.resourceUsage().maxRSS * 1024,
+    heapPeakBytes: 0,
+    externalPeakBytes: 0,
+    gcCount: 0,
+    gcPauseMs: 0,
+    skipped: reason,
+  }
+}
@@ -0,0 +1,647 @@
+/**
+ * Benchmark suite scenarios
+ *
+ * Each scenario builds its own inputs outside the measured section and
+ * returns one ScenarioResult. Names are stable identifiers: compare.ts
+ * matches results across runs by name.
+ */
+
+import * as fs from 'node:fs'
+import * as path from 'node:path'
+
+import {
+  AudioData,
+  AudioEncoder,
+  EncodedVideoChunk,
+  MkvMuxer,
+  Mp4Demuxer,
+  Mp4Muxer,
+  VideoDecoder,
+  VideoEncoder,
+  VideoFrame,
+  getPreferredHardwareAccelerator,
+  type EncodedVideoChunkMetadata,
+  type VideoDecoderConfig,
+  type VideoEncoderConfig,
+} from '../../index.js'
+import { measure, skipped, type ScenarioResult } from './harness.js'
+
+const FIXTURE = path.join(import.meta.dirname, '../../__test__/fixtures/small_buck_bunny.mp4')
+
+export interface SuiteOptions {
+  /** Fewer frames and a smaller matrix for smoke runs */
+  quick: boolean
+}
+
+export interface Scenario {
+  name: string
+  group: string
+  run: (options: SuiteOptions) => Promise<ScenarioResult>
+}
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+const CODECS = {
+  h264: 'avc1.42001f',
+  h265: 'hev1.1.6.L93.B0',
+  vp8: 'vp8',
+  vp9: 'vp09.00.10.08',
+  av1: 'av01.0.04M.08',
+} as const
+
+type CodecName = keyof typeof CODECS
+
+const RESOLUTIONS = {
+  '360p': { width: 640, height: 360 },
+  '720p': { width: 1280, height: 720 },
+  '1080p': { width: 1920, height: 1080 },
+} as const
+
+type ResolutionName = keyof typeof RESOLUTIONS
+
+const FRAME_DURATION_US = 33_333
+
+function frameCount(options: SuiteOptions, height: number): number {
+  const full = height >= 1080 ? 90 : 150
+  return options.quick ? Math.max(10, Math.round(full / 6)) : full
+}
+
+/** I420 buffers with a moving diagonal pattern, so encoders see motion */
+function movingI420Buffers(width: number, height: number, count = 8): Uint8Array[] {
+  const ySize = width * height
+  const uvSize = (width / 2) * (height / 2)
+  return Array.from({ length: count }, (_, t) => {
+    const buffer = new Uint8Array(ySize + uvSize * 2)
+    for (let y = 0; y < height; y++) {
+      for (let x = 0; x < width; x++) {
+        buffer[y * width + x] = 16 + ((x + y + t * 8) % 220)
+      }
+    }
+    for (let i = 0; i < uvSize; i++) {
+      buffer[ySize + i] = 96 + ((i + t * 4) % 64)
+      buffer[ySize + uvSize + i] = 160 - ((i + t * 4) % 64)
+    }
+    return buffer
+  })
+}
+
+function rgbaBuffer(width: number, height: number): Uint8Array {
+  const buffer = new Uint8Array(width * height * 4)
+  for (let i = 0; i < width * height; i++) {
+    buffer[i * 4] = i & 0xff
+    buffer[i * 4 + 1] = (i >> 8) & 0xff
+    buffer[i * 4 + 2] = (i >> 16) & 0xff
+    buffer[i * 4 + 3] = 0xff
+  }
+  return buffer
+}
+
+function i420Frame(buffer: Uint8Array, width: number, height: number, index: number): VideoFrame {
+  return new VideoFrame(buffer, {
+    format: 'I420',
+    codedWidth: width,
+    codedHeight: height,
+    timestamp: index * FRAME_DURATION_US,
+    duration: FRAME_DURATION_US,
+  })
+}
+
+/** Resolves waiters whenever a codec's queue shrinks */
+class QueueGate {
+  private waiter: (() => void) | undefined
+
+  constructor(codec: { ondequeue: (() => unknown) | null }) {
+    codec.ondequeue = () => {
+      const waiter = this.waiter
+      this.waiter = undefined
+      waiter?.()
+    }
+  }
+
+  /** Wait until `size()` is at most `depth` */
+  async wait(size: () => number, depth: number) {
+    while (size() > depth) {
+      await new Promise<void>((resolve) => {
+        this.waiter = resolve
+      })
+    }
+  }
+}
+
+/** Queue depth kept in front of a codec during per-frame latency runs */
+const QUEUE_DEPTH = 4
+
+function encoderConfig(
+  codec: CodecName,
+  width: number,
+  height: number,
+  hardwareAcceleration: 'prefer-software' | 'prefer-hardware',
+): VideoEncoderConfig {
+  return {
+    codec: CODECS[codec],
+    width,
+    height,
+    bitrate: Math.round(width * height * 30 * 0.1),
+    framerate: 30,
+    latencyMode: 'realtime',
+    hardwareAcceleration,
+  }
+}
+
+interface EncodedClip {
+  chunks: EncodedVideoChunk[]
+  metadata: EncodedVideoChunkMetadata | undefined
+  decoderConfig: VideoDecoderConfig
+}
+
+/** Encode a clip outside of any measurement (input for decode/mux) */
+async function encodeClip(config: VideoEncoderConfig, frames: number): Promise<EncodedClip> {
+  const chunks: EncodedVideoChunk[] = []
+  let metadata: EncodedVideoChunkMetadata | undefined
+  let error: Error | undefined
+  const encoder = new VideoEncoder({
+    output: (chunk, meta) => {
+      chunks.push(chunk)
+      if (meta?.decoderConfig && !metadata) {
+        metadata = meta
+      }
+    },
+    error: (e) => {
+      error = e
+    },
+  })
+  encoder.configure(config)
+  const buffers = movingI420Buffers(config.width, config.height)
+  for (let i = 0; i < frames; i++) {
+    const frame = i420Frame(buffers[i % buffers.length]!, config.width, config.height, i)
+    encoder.encode(frame, { keyFrame: i % 60 === 0 })
+    frame.close()
+  }
+  await encoder.flush()
+  encoder.close()
+  if (error || !metadata?.decoderConfig) {
+    throw error ?? new Error(`No decoder config from ${config.codec}`)
+  }
+  return {
+    chunks,
+    metadata,
+    decoderConfig: {
+      codec: metadata.decoderConfig.codec,
+      codedWidth: config.width,
+      codedHeight: config.height,
+      description: metadata.decoderConfig.description,
+    },
+  }
+}
+
+async function isEncoderSupported(config: VideoEncoderConfig): Promise<boolean> {
+  const support = await VideoEncoder.isConfigSupported(config)
+  return support.supported === true
+}
+
+// ============================================================================
+// Encode / decode
+// ============================================================================
+
+function encodeScenario(
+  codec: CodecName,
+  resolution: ResolutionName,
+  hardwareAcceleration: 'prefer-software' | 'prefer-hardware',
+): Scenario {
+  const accel = hardwareAcceleration === 'prefer-hardware' ? 'hardware' : 'software'
+  const name = `encode/${codec}/${resolution}/${accel}`
+  return {
+    name,
+    group: 'encode',
+    run: async (options) => {
+      const { width, height } = RESOLUTIONS[resolution]
+      const config = encoderConfig(codec, width, height, hardwareAcceleration)
+      if (accel === 'hardware' && getPreferredHardwareAccelerator() === null) {
+        return skipped(name, 'encode', 'no hardware accelerator')
+      }
+      if (!(await isEncoderSupported(config))) {
+        return skipped(name, 'encode', 'config not supported')
+      }
+
+      const frames = frameCount(options, height)
+      const buffers = movingI420Buffers(width, height)
+      return measure(name, 'encode', async (ctx) => {
+        let bytes = 0
+        const encoder = new VideoEncoder({
+          output: (chunk) => {
+            bytes += chunk.byteLength
+            ctx.latency.end(chunk.timestamp)
+          },
+          error: (e) => console.error(`${name}: ${e.message}`),
+        })
+        encoder.configure(config)
+        const gate = new QueueGate(encoder)
+
+        for (let i = 0; i < frames; i++) {
+          await gate.wait(() => encoder.encodeQueueSize, QUEUE_DEPTH)
+          const frame = i420Frame(buffers[i % buffers.length]!, width, height, i)
+          ctx.latency.start(frame.timestamp)
+          encoder.encode(frame, { keyFrame: i % 60 === 0 })
+          frame.close()
+        }
+        await encoder.flush()
+        encoder.close()
+        ctx.count(frames)
+        ctx.extra.bytesPerFrame = bytes / frames
+      })
+    },
+  }
+}
+
+function decodeScenario(
+  codec: CodecName,
+  resolution: ResolutionName,
+  hardwareAcceleration: 'prefer-software' | 'prefer-hardware',
+): Scenario {
+  const accel = hardwareAcceleration === 'prefer-hardware' ? 'hardware' : 'software'
+  const name = `decode/${codec}/${resolution}/${accel}`
+  return {
+    name,
+    group: 'decode',
+    run: async (options) => {
+      const { width, height } = RESOLUTIONS[resolution]
+      if (accel === 'hardware' && getPreferredHardwareAccelerator() === null) {
+        return skipped(name, 'decode', 'no hardware accelerator')
+      }
+      const encoderCfg = encoderConfig(codec, width, height, 'prefer-software')
+      if (!(await isEncoderSupported(encoderCfg))) {
+        return skipped(name, 'decode', 'no encoder to produce input')
+      }
+      const clip = await encodeClip(encoderCfg, frameCount(options, height))
+      const config = { ...clip.decoderConfig, hardwareAcceleration }
+      const support = await VideoDecoder.isConfigSupported(config)
+      if (!support.supported) {
+        return skipped(name, 'decode', 'config not supported')
+      }
+
+      return measure(name, 'decode', async (ctx) => {
+        const decoder = new VideoDecoder({
+          output: (frame) => {
+            ctx.latency.end(frame.timestamp)
+            frame.close()
+          },
+          error: (e) => console.error(`${name}: ${e.message}`),
+        })
+        decoder.configure(config)
+        const gate = new QueueGate(decoder)
+
+        for (const chunk of clip.chunks) {
+          await gate.wait(() => decoder.decodeQueueSize, QUEUE_DEPTH)
+          ctx.latency.start(chunk.timestamp)
+          decoder.decode(chunk)
+        }
+        await decoder.flush()
+        decoder.close()
+        ctx.count(clip.chunks.length)
+      })
+    },
+  }
+}
+
+// ============================================================================
+// VideoFrame construction and copyTo conversions (Scaler)
+// ============================================================================
+
+function frameConstructScenario(format: 'I420' | 'RGBA', resolution: ResolutionName): Scenario {
+  const name = `frame/construct/${format}/${resolution}`
+  return {
+    name,
+    group: 'frame',
+    run: async (options) => {
+      const { width, height } = RESOLUTIONS[resolution]
+      const buffer = format === 'I420' ? movingI420Buffers(width, height, 1)[0]! : rgbaBuffer(width, height)
+      const iterations = options.quick ? 50 : 300
+
+      return measure(name, 'frame', async (ctx) => {
+        for (let i = 0; i < iterations; i++) {
+          ctx.latency.start(i)
+          const frame = new VideoFrame(buffer, {
+            format,
+            codedWidth: width,
+            codedHeight: height,
+            timestamp: i * FRAME_DURATION_US,
+          })
+          ctx.latency.end(i)
+          frame.close()
+        }
+      })
+    },
+  }
+}
+
+function copyToScenario(from: 'I420' | 'RGBA', to: 'I420' | 'RGBA', resolution: ResolutionName): Scenario {
+  const name = `frame/copyTo/${from}-to-${to}/${resolution}`
+  return {
+    name,
+    group: from === to ? 'frame' : 'scaler',
+    run: async (options) => {
+      const { width, height } = RESOLUTIONS[resolution]
+      const buffer = from === 'I420' ? movingI420Buffers(width, height, 1)[0]! : rgbaBuffer(width, height)
+      const frame = new VideoFrame(buffer, { format: from, codedWidth: width, codedHeight: height, timestamp: 0 })
+      const destination = new Uint8Array(frame.allocationSize({ format: to }))
+      const iterations = options.quick ? 30 : 200
+
+      const result = await measure(name, from === to ? 'frame' : 'scaler', async (ctx) => {
+        for (let i = 0; i < iterations; i++) {
+          ctx.latency.start(i)
+          await frame.copyTo(destination, { format: to })
+          ctx.latency.end(i)
+        }
+      })
+      frame.close()
+      return result
+    },
+  }
+}
+
+/**
+ * Encoder input at a different size than configured, so every frame goes
+ * through the encoder's Scaler before encoding
+ */
+function scaledEncodeScenario(): Scenario {
+  const name = 'scaler/encode-input/1080p-to-360p'
+  return {
+    name,
+    group: 'scaler',
+    run: async (options) => {
+      const source = RESOLUTIONS['1080p']
+      const target = RESOLUTIONS['360p']
+      const config = encoderConfig('h264', target.width, target.height, 'prefer-software')
+      if (!(await isEncoderSupported(config))) {
+        return skipped(name, 'scaler', 'config not supported')
+      }
+      const frames = frameCount(options, target.height)
+      const buffers = movingI420Buffers(source.width, source.height)
+
+      return measure(name, 'scaler', async (ctx) => {
+        const encoder = new VideoEncoder({
+          output: (chunk) => ctx.latency.end(chunk.timestamp),
+          error: (e) => console.error(`${name}: ${e.message}`),
+        })
+        encoder.configure(config)
+        const gate = new QueueGate(encoder)
+        for (let i = 0; i < frames; i++) {
+          await gate.wait(() => encoder.encodeQueueSize, QUEUE_DEPTH)
+          const frame = i420Frame(buffers[i % buffers.length]!, source.width, source.height, i)
+          ctx.latency.start(frame.timestamp)
+          encoder.encode(frame)
+          frame.close()
+        }
+        await encoder.flush()
+        encoder.close()
+        ctx.count(frames)
+      })
+    },
+  }
+}
+
+// ============================================================================
+// Audio encode with and without resampling (Resampler)
+// ============================================================================
+
+function audioEncodeScenario(codec: 'opus' | 'mp4a.40.2', inputRate: number, targetRate: number): Scenario {
+  const label = codec === 'opus' ? 'opus' : 'aac'
+  const resampled = inputRate !== targetRate
+  const group = resampled ? 'resampler' : 'audio'
+  const name = resampled
+    ? `resample/${label}/${inputRate}-to-${targetRate}`
+    : `audio-encode/${label}/${targetRate}`
+  return {
+    name,
+    group,
+    run: async (options) => {
+      const config = { codec, sampleRate: targetRate, numberOfChannels: 2, bitrate: 128_000 }
+      const support = await AudioEncoder.isConfigSupported(config)
+      if (!support.supported) {
+        return skipped(name, group, 'config not supported')
+      }
+
+      // 20 ms buffers of a 440 Hz tone, interleaved f32
+      const framesPerBuffer = Math.round(inputRate / 50)
+      const samples = new Float32Array(framesPerBuffer * 2)
+      for (let i = 0; i < framesPerBuffer; i++) {
+        const value = Math.sin((2 * Math.PI * 440 * i) / inputRate) * 0.5
+        samples[i * 2] = value
+        samples[i * 2 + 1] = value
+      }
+      const data = new Uint8Array(samples.buffer)
+      const buffers = options.quick ? 100 : 1000
+
+      return measure(name, group, async (ctx) => {
+        const encoder = new AudioEncoder({
+          output: () => {},
+          error: (e) => console.error(`${name}: ${e.message}`),
+        })
+        encoder.configure(config)
+        for (let i = 0; i < buffers; i++) {
+          const audio = new AudioData({
+            format: 'f32',
+            sampleRate: inputRate,
+            numberOfFrames: framesPerBuffer,
+            numberOfChannels: 2,
+            timestamp: i * 20_000,
+            data,
+          })
+          encoder.encode(audio)
+          audio.close()
+        }
+        await encoder.flush()
+        encoder.close()
+        ctx.count(buffers)
+      })
+    },
+  }
+}
+
+// ============================================================================
+// Demux / mux throughput
+// ============================================================================
+
+function demuxScenario(): Scenario {
+  const name = 'demux/mp4'
+  return {
+    name,
+    group: 'container',
+    run: async (options) => {
+      const data = fs.readFileSync(FIXTURE)
+      const passes = options.quick ? 2 : 10
+
+      return measure(name, 'container', async (ctx) => {
+        for (let pass = 0; pass < passes; pass++) {
+          const demuxer = new Mp4Demuxer({
+            videoOutput: () => ctx.count(),
+            audioOutput: () => ctx.count(),
+            error: (e) => console.error(`${name}: ${e.message}`),
+          })
+          await demuxer.loadBuffer(data)
+          await demuxer.demuxAsync()
+          demuxer.close()
+        }
+        ctx.extra.bytesPerPass = data.byteLength
+      })
+    },
+  }
+}
+
+function muxScenario(container: 'mp4' | 'mp4-faststart' | 'mkv'): Scenario {
+  const name = `mux/${container}`
+  return {
+    name,
+    group: 'container',
+    run: async (options) => {
+      const { width, height } = RESOLUTIONS['720p']
+      const config = encoderConfig('h264', width, height, 'prefer-software')
+      if (!(await isEncoderSupported(config))) {
+        return skipped(name, 'container', 'no encoder to produce input')
+      }
+      const clip = await encodeClip(config, frameCount(options, height))
+      const passes = options.quick ? 3 : 20
+      const track = {
+        codec: clip.decoderConfig.codec,
+        width,
+        height,
+        description: clip.decoderConfig.description as Uint8Array | undefined,
+      }
+
+      return measure(name, 'container', async (ctx) => {
+        let bytes = 0
+        for (let pass = 0; pass < passes; pass++) {
+          const muxer =
+            container === 'mkv' ? new MkvMuxer() : new Mp4Muxer({ fastStart: container === 'mp4-faststart' })
+          muxer.addVideoTrack(track)
+          for (const [i, chunk] of clip.chunks.entries()) {
+            ctx.latency.start(i)
+            muxer.addVideoChunk(chunk, i === 0 ? clip.metadata : undefined)
+            ctx.latency.end(i)
+          }
+          bytes = muxer.finalize().byteLength
+          muxer.close()
+        }
+        ctx.count(passes * clip.chunks.length)
+        ctx.extra.outputBytes = bytes
+      })
+    },
+  }
+}
+
+function remuxScenario(): Scenario {
+  const name = 'remux/mp4-to-mkv'
+  return {
+    name,
+    group: 'container',
+    run: async (options) => {
+      const data = fs.readFileSync(FIXTURE)
+      const passes = options.quick ? 2 : 10
+
+      return measure(name, 'container', async (ctx) => {
+        for (let pass = 0; pass < passes; pass++) {
+          const demuxer = new Mp4Demuxer({ error: (e) => console.error(`${name}: ${e.message}`) })
+          await demuxer.loadBuffer(data)
+          const muxer = new MkvMuxer()
+          await demuxer.remuxTo(muxer)
+          muxer.finalize()
+          muxer.close()
+          demuxer.close()
+        }
+        ctx.count(passes)
+      })
+    },
+  }
+}
+
+// ============================================================================
+// Concurrency scaling
+// ============================================================================
+
+function concurrencyScenario(instances: number): Scenario {
+  const name = `concurrency/h264-720p/x${instances}`
+  return {
+    name,
+    group: 'concurrency',
+    run: async (options) => {
+      const { width, height } = RESOLUTIONS['720p']
+      const config = encoderConfig('h264', width, height, 'prefer-software')
+      if (!(await isEncoderSupported(config))) {
+        return skipped(name, 'concurrency', 'config not supported')
+      }
+      const frames = frameCount(options, height)
+      const buffers = movingI420Buffers(width, height)
+
+      return measure(name, 'concurrency', async (ctx) => {
+        const runOne = async (instance: number) => {
+          const encoder = new VideoEncoder({
+            output: (chunk) => ctx.latency.end(instance * 1e12 + chunk.timestamp),
+            error: (e) => console.error(`${name}: ${e.message}`),
+          })
+          encoder.configure(config)
+          const gate = new QueueGate(encoder)
+          for (let i = 0; i < frames; i++) {
+            await gate.wait(() => encoder.encodeQueueSize, QUEUE_DEPTH)
+            const frame = i420Frame(buffers[i % buffers.length]!, width, height, i)
+            ctx.latency.start(instance * 1e12 + frame.timestamp)
+            encoder.encode(frame, { keyFrame: i % 60 === 0 })
+            frame.close()
+          }
+          await encoder.flush()
+          encoder.close()
+        }
+        await Promise.all(Array.from({ length: instances }, (_, i) => runOne(i)))
+        ctx.count(frames * instances)
+        ctx.extra.instances = instances
+      })
+    },
+  }
+}
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+export function buildScenarios(options: SuiteOptions): Scenario[] {
+  const resolutions: ResolutionName[] = options.quick ? ['360p'] : ['360p', '720p', '1080p']
+  const codecs: CodecName[] = ['h264', 'h265', 'vp8', 'vp9', 'av1']
+  const scenarios: Scenario[] = []
+
+  for (const codec of codecs) {
+    for (const resolution of resolutions) {
+      scenarios.push(encodeScenario(codec, resolution, 'prefer-software'))
+      scenarios.push(decodeScenario(codec, resolution, 'prefer-software'))
+    }
+  }
+  for (const codec of ['h264', 'h265'] as const) {
+    scenarios.push(encodeScenario(codec, '1080p', 'prefer-hardware'))
+    scenarios.push(decodeScenario(codec, '1080p', 'prefer-hardware'))
+  }
+
+  for (const format of ['I420', 'RGBA'] as const) {
+    scenarios.push(frameConstructScenario(format, '1080p'))
+  }
+  scenarios.push(copyToScenario('I420', 'I420', '1080p'))
+  scenarios.push(copyToScenario('I420', 'RGBA', '1080p'))
+  scenarios.push(copyToScenario('RGBA', 'I420', '1080p'))
+  scenarios.push(scaledEncodeScenario())
+
+  scenarios.push(audioEncodeScenario('opus', 48_000, 48_000))
+  scenarios.push(audioEncodeScenario('opus', 44_100, 48_000))
+  scenarios.push(audioEncodeScenario('mp4a.40.2', 48_000, 48_000))
+  scenarios.push(audioEncodeScenario('mp4a.40.2', 44_100, 48_000))
+
+  scenarios.push(demuxScenario())
+  scenarios.push(muxScenario('mp4'))
+  scenarios.push(muxScenario('mp4-faststart'))
+  scenarios.push(muxScenario('mkv'))
+  scenarios.push(remuxScenario())
+
+  for (const instances of options.quick ? [1, 4] : [1, 2, 4, 8]) {
+    scenarios.push(concurrencyScenario(instances))
+  }
+
+  return scenarios
+}
@@ -87,6 +87,16 @@ export interface MkvDemuxerInit {
   error: (error: Error) => void
 }
 
+/** Options for Mp4Demuxer/WebMDemuxer/MkvDemuxer decodeTo() */
+export interface DemuxerDecodeToOptions {
+  /** Decoder for the selected video track (must be configured) */
+  videoDecoder?: VideoDecoder
+  /** Decoder for the selected audio track (must be configured) */
+  audioDecoder?: AudioDecoder
+  /** Maximum number of packets queued ahead of each decoder (default: 32) */
+  maxQueueSize?: number
+}
+
 /** Video track config for muxer */
 export interface MuxerVideoTrackConfig {
   /** Codec string */
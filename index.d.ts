@@ -87,6 +87,31 @@ export interface MkvDemuxerInit {
   error: (error: Error) => void
 }
 
+/** Options for Mp4Demuxer/WebMDemuxer/MkvDemuxer decodeTo() */
+export interface DemuxerDecodeToOptions {
+  /** Decoder for the selected video track (must be configured) */
+  videoDecoder?: VideoDecoder
+  /** Decoder for the selected audio track (must be configured) */
+  audioDecoder?: AudioDecoder
+  /** Maximum number of packets queued ahead of each decoder (default: 32) */
+  maxQueueSize?: number
+}
+
+/** Options for Mp4Demuxer/WebMDemuxer/MkvDemuxer load() */
+export interface DemuxerLoadOptions {
+  /**
+   * Memory-map the file and demux it as a buffer instead of using file I/O
+   * (default: false)
+   */
+  mmap?: boolean
+}
+
+/** Options for Mp4Demuxer/WebMDemuxer/MkvDemuxer loadStream() */
+export interface DemuxerLoadStreamOptions {
+  /** Maximum bytes buffered ahead of the demuxer (default: 1 MiB) */
+  bufferSize?: number
+}
+
 /** Video track config for muxer */
 export interface MuxerVideoTrackConfig {
   /** Codec string */
@@ -113,7 +138,7 @@ export interface MuxerAudioTrackConfig {
 
 /** Init options for Mp4Muxer */
 export interface Mp4MuxerInit {
-  /** Move moov atom to beginning (not compatible with streaming) */
+  /** Move moov atom to beginning (fragmented MP4 with a leading moov in streaming mode) */
   fastStart?: boolean
   /** Use fragmented MP4 for streaming */
   fragmented?: boolean
@@ -301,6 +326,13 @@ export declare class AudioDecoder {
   get state(): CodecState
   /** Get number of pending decode operations (per WebCodecs spec) */
   get decodeQueueSize(): number
+  /**
+   * Get per-stage performance counters (non-standard extension)
+   *
+   * Reads atomic counters without waiting for the worker, so it is cheap
+   * enough to poll for metrics export.
+   */
+  getStats(): CodecPerformanceStats
   /**
    * Set the dequeue event handler (per WebCodecs spec)
    *
@@ -389,6 +421,13 @@ export declare class AudioEncoder {
   get state(): CodecState
   /** Get number of pending encode operations (per WebCodecs spec) */
   get encodeQueueSize(): number
+  /**
+   * Get per-stage performance counters (non-standard extension)
+   *
+   * Reads atomic counters without waiting for the worker, so it is cheap
+   * enough to poll for metrics export.
+   */
+  getStats(): CodecPerformanceStats
   /**
    * Set the dequeue event handler (per WebCodecs spec)
    *
@@ -623,7 +662,14 @@ export declare class ImageTrackList {
  */
 export declare class MkvDemuxer {
   constructor(init: MkvDemuxerInit)
-  load(path: string): Promise<void>
+  /**
+   * Load an MKV file from a path
+   *
+   * With `{ mmap: true }` the file is memory-mapped and demuxed like a
+   * buffer: pages load on demand and are shared through the OS page cache
+   * with every other demuxer mapping the same file.
+   */
+  load(path: string, options?: DemuxerLoadOptions | undefined | null): Promise<void>
   /**
    * Load an MKV from a buffer
    *
@@ -631,6 +677,20 @@ export declare class MkvDemuxer {
    * directly to the demuxer without an intermediate copy.
    */
   loadBuffer(data: Uint8Array): Promise<void>
+  /**
+   * Load an MKV from a ReadableStream
+   *
+   * Resolves once the container headers have arrived; packets can then be
+   * demuxed while the rest of the stream is still being received. At most
+   * `bufferSize` bytes (default 1 MiB) are buffered ahead of the demuxer.
+   *
+   * The stream is read forward only, so `seek()` is not supported.
+   *
+   * While a read is waiting for stream data, `selectVideoTrack()`,
+   * `selectAudioTrack()`, `exportIndex()` and `importIndex()` throw
+   * InvalidStateError rather than block; the getters always answer.
+   */
+  loadStream(stream: ReadableStream<Uint8Array>, options?: DemuxerLoadStreamOptions): Promise<void>
   get tracks(): Array<DemuxerTrackInfo>
   get duration(): number | null
   get videoDecoderConfig(): DemuxerVideoDecoderConfig | null
@@ -640,7 +700,36 @@ export declare class MkvDemuxer {
   demux(count?: number | undefined | null): void
   /** Demux packets asynchronously (awaitable version of demux) */
   demuxAsync(count?: number | undefined | null): Promise<void>
+  /** Decode the selected tracks natively (see Mp4Demuxer.decodeTo) */
+  decodeTo(options: DemuxerDecodeToOptions): Promise<void>
+  /** Remux the selected tracks natively (see Mp4Demuxer.remuxTo) */
+  remuxTo(muxer: Mp4Muxer | WebMMuxer | MkvMuxer): Promise<void>
   seek(timestampUs: number): void
+  /**
+   * Index every keyframe by reading the whole file once
+   *
+   * Containers without an up-front index (MKV/WebM without cues) otherwise
+   * learn keyframe positions only as they are demuxed, so seeks past that
+   * point scan the file. Resolves with the demuxer rewound to the start.
+   *
+   * Rejects with NotSupportedError on a demuxer loaded from a stream.
+   */
+  buildIndex(): Promise<void>
+  /**
+   * Export the keyframe index as a compact binary blob
+   *
+   * Call after `buildIndex()` or a full demux pass, and cache the result
+   * next to the file to pass to `importIndex()` on later loads.
+   */
+  exportIndex(): Uint8Array
+  /**
+   * Import a keyframe index previously returned by `exportIndex()`
+   *
+   * Seeks within the imported range jump straight to the indexed keyframe.
+   * Throws if the index was built for a different file: one with other
+   * tracks, or another size or duration.
+   */
+  importIndex(data: Uint8Array): void
   close(): void
   get state(): string
 }
@@ -691,10 +780,18 @@ export declare class MkvMuxer {
   /**
    * Read available data from streaming buffer (streaming mode only)
    *
-   * Returns available data, or null if no data is ready yet.
+   * Returns all available data, or null if no data is ready yet.
    * Returns empty Uint8Array when streaming is finished.
    */
   read(): Uint8Array | null
+  /**
+   * Read the next page of output (streaming mode only, non-standard)
+   *
+   * Like read(), but returns at most one page (up to 32 KiB) and hands it
+   * over without copying. Call it until it returns null to drain
+   * everything that is ready.
+   */
+  readPage(): Uint8Array | null
   /** Check if muxer is in streaming mode */
   get isStreaming(): boolean
   /** Check if streaming is finished (streaming mode only) */
@@ -743,8 +840,14 @@ export declare class MkvMuxer {
 export declare class Mp4Demuxer {
   /** Create a new MP4 demuxer */
   constructor(init: Mp4DemuxerInit)
-  /** Load an MP4 file from a path */
-  load(path: string): Promise<void>
+  /**
+   * Load an MP4 file from a path
+   *
+   * With `{ mmap: true }` the file is memory-mapped and demuxed like a
+   * buffer: pages load on demand and are shared through the OS page cache
+   * with every other demuxer mapping the same file.
+   */
+  load(path: string, options?: DemuxerLoadOptions | undefined | null): Promise<void>
   /**
    * Load an MP4 from a buffer
    *
@@ -752,6 +855,21 @@ export declare class Mp4Demuxer {
    * directly to the demuxer without an intermediate copy.
    */
   loadBuffer(data: Uint8Array): Promise<void>
+  /**
+   * Load an MP4 from a ReadableStream
+   *
+   * Resolves once the container headers have arrived; packets can then be
+   * demuxed while the rest of the stream is still being received. At most
+   * `bufferSize` bytes (default 1 MiB) are buffered ahead of the demuxer.
+   *
+   * The stream is read forward only, so `seek()` is not supported and the
+   * MP4 must be fragmented or faststart (moov before mdat).
+   *
+   * While a read is waiting for stream data, `selectVideoTrack()`,
+   * `selectAudioTrack()`, `exportIndex()` and `importIndex()` throw
+   * InvalidStateError rather than block; the getters always answer.
+   */
+  loadStream(stream: ReadableStream<Uint8Array>, options?: DemuxerLoadStreamOptions): Promise<void>
   /** Get all tracks */
   get tracks(): Array<DemuxerTrackInfo>
   /** Get container duration in microseconds */
@@ -785,8 +903,56 @@ export declare class Mp4Demuxer {
    * `for await (const chunk of demuxer) { ... }`
    */
   demuxAsync(count?: number | undefined | null): Promise<void>
+  /**
+   * Decode the selected tracks natively
+   *
+   * Demuxes on a background thread and queues packets directly on the
+   * decoders' worker threads, so encoded chunks never pass through JS; only
+   * the decoders' output callbacks run. Demuxing stays at most `maxQueueSize`
+   * packets (default 32) ahead of each decoder.
+   *
+   * Resolves once every packet has been queued, or early if the demuxer is
+   * closed. Call `flush()` on the decoders to wait for the remaining output.
+   */
+  decodeTo(options: DemuxerDecodeToOptions): Promise<void>
+  /**
+   * Remux the selected tracks into a muxer natively
+   *
+   * Adds a track to `muxer` for each selected track and writes the remaining
+   * packets without decoding or passing them through JS. Packet timestamps
+   * are rescaled between time bases, so B-frame order is preserved.
+   *
+   * Resolves once every packet has been written. Call `finalize()` on the
+   * muxer afterwards.
+   */
+  remuxTo(muxer: Mp4Muxer | WebMMuxer | MkvMuxer): Promise<void>
   /** Seek to a timestamp in microseconds */
   seek(timestampUs: number): void
+  /**
+   * Index every keyframe by reading the whole file once
+   *
+   * Containers without an up-front index (MKV/WebM without cues) otherwise
+   * learn keyframe positions only as they are demuxed, so seeks past that
+   * point scan the file. Resolves with the demuxer rewound to the start.
+   *
+   * Rejects with NotSupportedError on a demuxer loaded from a stream.
+   */
+  buildIndex(): Promise<void>
+  /**
+   * Export the keyframe index as a compact binary blob
+   *
+   * Call after `buildIndex()` or a full demux pass, and cache the result
+   * next to the file to pass to `importIndex()` on later loads.
+   */
+  exportIndex(): Uint8Array
+  /**
+   * Import a keyframe index previously returned by `exportIndex()`
+   *
+   * Seeks within the imported range jump straight to the indexed keyframe.
+   * Throws if the index was built for a different file: one with other
+   * tracks, or another size or duration.
+   */
+  importIndex(data: Uint8Array): void
   /** Close the demuxer and release resources */
   close(): void
   /** Get the current state of the demuxer */
@@ -852,14 +1018,39 @@ export declare class Mp4Muxer {
   /**
    * Read available data from streaming buffer (streaming mode only)
    *
-   * Returns available data, or null if no data is ready yet.
+   * Returns all available data, or null if no data is ready yet.
    * Returns empty Uint8Array when streaming is finished.
    */
   read(): Uint8Array | null
+  /**
+   * Read the next page of output (streaming mode only, non-standard)
+   *
+   * Like read(), but returns at most one page (up to 32 KiB) and hands it
+   * over without copying. Call it until it returns null to drain
+   * everything that is ready.
+   */
+  readPage(): Uint8Array | null
   /** Check if muxer is in streaming mode */
   get isStreaming(): boolean
   /** Check if streaming is finished (streaming mode only) */
   get isFinished(): boolean
+  /**
+   * Set the segment handler (segmenting mode only)
+   *
+   * Receives the init segment (ftyp+moov) and then one CMAF
+   * fragment per media segment, in order. Segments cut before a
+   * handler is set are delivered when it is set.
+   */
+  set onsegment(callback: ((arg: MuxerSegment) => unknown) | undefined | null)
+  /** Get the segment handler */
+  get onsegment(): ((arg: MuxerSegment) => unknown) | null
+  /**
+   * Get an HLS media playlist for the segments cut so far (segmenting mode only)
+   *
+   * Lists the init segment as EXT-X-MAP and each media segment by its URI;
+   * EXT-X-ENDLIST is added once the muxer is finalized.
+   */
+  getHlsPlaylist(): string
   /**
    * Close the muxer and release resources
    *
@@ -919,11 +1110,24 @@ export declare class VideoDecoder {
    *
    * @param init - Init dictionary containing output and error callbacks
    */
-  constructor(init: { output: (frame: VideoFrame) => void; error: (error: Error) => void })
+  constructor(init: {
+    output: (frame: VideoFrame) => void
+    error: (error: Error) => void
+    outputBatch?: (frames: VideoFrame[]) => void
+    maxBatchSize?: number
+    maxBatchLatency?: number
+  })
   /** Get decoder state */
   get state(): CodecState
   /** Get number of pending decode operations (per WebCodecs spec) */
   get decodeQueueSize(): number
+  /**
+   * Get per-stage performance counters (non-standard extension)
+   *
+   * Reads atomic counters without waiting for the worker, so it is cheap
+   * enough to poll for metrics export.
+   */
+  getStats(): CodecPerformanceStats
   /**
    * Set the dequeue event handler (per WebCodecs spec)
    *
@@ -955,6 +1159,24 @@ export declare class VideoDecoder {
   flush(): Promise<void>
   /** Reset the decoder */
   reset(): void
+  /**
+   * Feed decoded frames directly to encoders (native transcode graph)
+   *
+   * Every decoded frame is shared with all `encoders` without passing through
+   * JS; each encoder scales it to its own configured size, so one decoder can
+   * drive a whole rendition ladder. While piped, the output callback is not
+   * called. Replaces any previous pipe; an encoder that is later reset or
+   * closed silently drops out.
+   *
+   * The decoder holds back while an encoder's queue is full: `maxQueueSize`
+   * frames with `queueOverflow: 'throw'`, otherwise 8 (the drop policies drop
+   * frames instead), so a slow rendition paces the whole graph.
+   *
+   * Flush the decoder first, then the encoders, to drain the graph.
+   */
+  pipeTo(encoders: Array<VideoEncoder>): void
+  /** Stop feeding encoders; decoded frames go to the output callback again */
+  unpipe(): void
   /** Close the decoder */
   close(): void
   /**
@@ -1018,11 +1240,35 @@ export declare class VideoEncoder {
   constructor(init: {
     output: (chunk: EncodedVideoChunk, metadata?: EncodedVideoChunkMetadata) => void
     error: (error: Error) => void
+    outputBatch?: (chunks: EncodedVideoChunk[], metadata: EncodedVideoChunkMetadata[]) => void
+    maxBatchSize?: number
+    maxBatchLatency?: number
   })
   /** Get encoder state */
   get state(): CodecState
   /** Get number of pending encode operations (per WebCodecs spec) */
   get encodeQueueSize(): number
+  /**
+   * Frames dropped by the `queueOverflow` policy (non-standard extension)
+   *
+   * Each drop also fires a "framedrop" event.
+   */
+  get droppedFrames(): number
+  /**
+   * Get statistics for the conversion frame pool (non-standard extension)
+   *
+   * Frames converted to the encoder's size/format (e.g. RGBA→I420) are
+   * recycled through a per-encoder pool; a hit rate near 1.0 means the
+   * conversion path is not allocating per frame.
+   */
+  getFramePoolStats(): VideoEncoderFramePoolStats
+  /**
+   * Get per-stage performance counters (non-standard extension)
+   *
+   * Reads atomic counters without waiting for the worker, so it is cheap
+   * enough to poll for metrics export.
+   */
+  getStats(): CodecPerformanceStats
   /**
    * Set the dequeue event handler (per WebCodecs spec)
    *
@@ -1188,7 +1434,14 @@ export declare class VideoFrame {
  */
 export declare class WebMDemuxer {
   constructor(init: WebMDemuxerInit)
-  load(path: string): Promise<void>
+  /**
+   * Load a WebM file from a path
+   *
+   * With `{ mmap: true }` the file is memory-mapped and demuxed like a
+   * buffer: pages load on demand and are shared through the OS page cache
+   * with every other demuxer mapping the same file.
+   */
+  load(path: string, options?: DemuxerLoadOptions | undefined | null): Promise<void>
   /**
    * Load a WebM from a buffer
    *
@@ -1196,6 +1449,20 @@ export declare class WebMDemuxer {
    * directly to the demuxer without an intermediate copy.
    */
   loadBuffer(data: Uint8Array): Promise<void>
+  /**
+   * Load a WebM from a ReadableStream
+   *
+   * Resolves once the container headers have arrived; packets can then be
+   * demuxed while the rest of the stream is still being received. At most
+   * `bufferSize` bytes (default 1 MiB) are buffered ahead of the demuxer.
+   *
+   * The stream is read forward only, so `seek()` is not supported.
+   *
+   * While a read is waiting for stream data, `selectVideoTrack()`,
+   * `selectAudioTrack()`, `exportIndex()` and `importIndex()` throw
+   * InvalidStateError rather than block; the getters always answer.
+   */
+  loadStream(stream: ReadableStream<Uint8Array>, options?: DemuxerLoadStreamOptions): Promise<void>
   get tracks(): Array<DemuxerTrackInfo>
   get duration(): number | null
   get videoDecoderConfig(): DemuxerVideoDecoderConfig | null
@@ -1205,7 +1472,36 @@ export declare class WebMDemuxer {
   demux(count?: number | undefined | null): void
   /** Demux packets asynchronously (awaitable version of demux) */
   demuxAsync(count?: number | undefined | null): Promise<void>
+  /** Decode the selected tracks natively (see Mp4Demuxer.decodeTo) */
+  decodeTo(options: DemuxerDecodeToOptions): Promise<void>
+  /** Remux the selected tracks natively (see Mp4Demuxer.remuxTo) */
+  remuxTo(muxer: Mp4Muxer | WebMMuxer | MkvMuxer): Promise<void>
   seek(timestampUs: number): void
+  /**
+   * Index every keyframe by reading the whole file once
+   *
+   * Containers without an up-front index (MKV/WebM without cues) otherwise
+   * learn keyframe positions only as they are demuxed, so seeks past that
+   * point scan the file. Resolves with the demuxer rewound to the start.
+   *
+   * Rejects with NotSupportedError on a demuxer loaded from a stream.
+   */
+  buildIndex(): Promise<void>
+  /**
+   * Export the keyframe index as a compact binary blob
+   *
+   * Call after `buildIndex()` or a full demux pass, and cache the result
+   * next to the file to pass to `importIndex()` on later loads.
+   */
+  exportIndex(): Uint8Array
+  /**
+   * Import a keyframe index previously returned by `exportIndex()`
+   *
+   * Seeks within the imported range jump straight to the indexed keyframe.
+   * Throws if the index was built for a different file: one with other
+   * tracks, or another size or duration.
+   */
+  importIndex(data: Uint8Array): void
   close(): void
   get state(): string
 }
@@ -1256,14 +1552,33 @@ export declare class WebMMuxer {
   /**
    * Read available data from streaming buffer (streaming mode only)
    *
-   * Returns available data, or null if no data is ready yet.
+   * Returns all available data, or null if no data is ready yet.
    * Returns empty Uint8Array when streaming is finished.
    */
   read(): Uint8Array | null
+  /**
+   * Read the next page of output (streaming mode only, non-standard)
+   *
+   * Like read(), but returns at most one page (up to 32 KiB) and hands it
+   * over without copying. Call it until it returns null to drain
+   * everything that is ready.
+   */
+  readPage(): Uint8Array | null
   /** Check if muxer is in streaming mode */
   get isStreaming(): boolean
   /** Check if streaming is finished (streaming mode only) */
   get isFinished(): boolean
+  /**
+   * Set the segment handler (segmenting mode only)
+   *
+   * Receives the init segment (EBML header and Tracks) and then the media
+   * segments in order. A media segment holds one or more whole clusters
+   * and starts with a keyframe. Segments cut before a handler is set are
+   * delivered when it is set.
+   */
+  set onsegment(callback: ((arg: MuxerSegment) => unknown) | undefined | null)
+  /** Get the segment handler */
+  get onsegment(): ((arg: MuxerSegment) => unknown) | null
   /** Close the muxer and release resources */
   close(): void
   /** Get the current state of the muxer */
@@ -1427,6 +1742,52 @@ export type ColorSpaceConversion = /** Apply default color space conversion (spe
   /** No color space conversion */
   | 'none'
 
+/** Timings of one codec pipeline stage (non-standard extension) */
+export interface CodecStageStats {
+  /** Number of timed operations */
+  count: number
+  /** Total time spent in the stage */
+  totalMs: number
+  /** Mean time per operation (0 when count is 0) */
+  meanMs: number
+  /** Longest single operation */
+  maxMs: number
+}
+
+/**
+ * Per-instance performance counters (non-standard extension)
+ *
+ * Counters accumulate from construction and are read without taking the
+ * codec lock, so polling `getStats()` does not slow the codec down.
+ */
+export interface CodecPerformanceStats {
+  /** Time inputs waited in the queue before the worker picked them up */
+  queueWait: CodecStageStats
+  /** Pixel format conversion/scaling (video) or resampling (audio) */
+  convert: CodecStageStats
+  /** `avcodec_send_frame` / `avcodec_send_packet` calls */
+  send: CodecStageStats
+  /** `avcodec_receive_packet` / `avcodec_receive_frame` calls */
+  receive: CodecStageStats
+  /** CPU → GPU frame uploads (hardware encoders) */
+  hardwareUpload: CodecStageStats
+  /** GPU → CPU frame downloads (hardware decoders) */
+  hardwareDownload: CodecStageStats
+  /**
+   * From an output being queued by the worker until the JS output
+   * callback returned (includes the time spent in the callback)
+   */
+  callback: CodecStageStats
+  /** Inputs taken off the queue for processing */
+  inputs: number
+  /** Outputs produced */
+  outputs: number
+  /** Inputs discarded without being processed (queue policy or reset) */
+  dropped: number
+  /** Switches from a hardware to a software codec */
+  hardwareFallbacks: number
+}
+
 /** Audio decoder configuration exposed to JavaScript */
 export interface DemuxerAudioDecoderConfig {
   /** Codec string */
@@ -1527,6 +1888,14 @@ export type EncodedVideoChunkType = /** Keyframe - can be decoded independently
   /** Delta frame - depends on previous frames */
   | 'delta'
 
+/** What a VideoEncoder does when `maxQueueSize` frames are already pending (non-standard) */
+export type EncodeQueueOverflow = /** Skip the oldest pending frames so only the newest `maxQueueSize` are encoded (default) */
+  | 'drop-oldest'
+  /** Refuse new frames unless they request a keyframe */
+  | 'drop-newest-delta'
+  /** Refuse new frames with QuotaExceededError; piped decoders wait for room */
+  | 'throw'
+
 /** Options for removeEventListener (W3C DOM spec) */
 export interface EventListenerOptions {
   capture?: boolean
@@ -1540,15 +1909,73 @@ export interface FlacEncoderConfig {
   compressLevel?: number
 }
 
+/** Budgets accepted by `setFrameMemoryBudget()` (non-standard) */
+export interface FrameMemoryBudget {
+  /** Bytes above which decoders apply backpressure and a pressure event fires (0 = none) */
+  softLimit?: number
+  /** Bytes above which frame allocations fail (0 = none) */
+  hardLimit?: number
+}
+
+/** Frame memory pressure level (non-standard) */
+export type FrameMemoryPressure = /** Below the soft budget */
+  | 'normal'
+  /** Above the soft budget: decoders slow down and caches shrink */
+  | 'soft'
+  /** An allocation was refused by the hard budget */
+  | 'hard'
+
+/** Event passed to the `setFrameMemoryPressureListener()` callback (non-standard) */
+export interface FrameMemoryPressureEvent {
+  /** New pressure level */
+  level: FrameMemoryPressure
+  /** Live frame bytes when the level changed */
+  liveBytes: number
+}
+
+/** Frame memory usage reported by `getFrameMemoryStats()` (non-standard) */
+export interface FrameMemoryStats {
+  /** Bytes held by live VideoFrame/AudioData buffers and internal frames */
+  liveBytes: number
+  /** Highest `liveBytes` since process start */
+  peakBytes: number
+  /** Soft budget in bytes (0 = none) */
+  softLimit: number
+  /** Hard budget in bytes (0 = none) */
+  hardLimit: number
+  /** Allocations refused by the hard budget */
+  refusedAllocations: number
+  /** Current pressure level */
+  pressure: FrameMemoryPressure
+}
+
 /** Get available hardware accelerators (only those that can be used) */
 export declare function getAvailableHardwareAccelerators(): Array<string>
 
+/** Get the total number of libavcodec threads shared by software codecs. */
+export declare function getCodecThreadBudget(): number
+
+/** Get the shared codec worker pool size (0 = one thread per codec). */
+export declare function getCodecWorkerThreads(): number
+
+/** Get live and peak frame memory, the budgets and the current pressure level. */
+export declare function getFrameMemoryStats(): FrameMemoryStats
+
 /** Get list of all known hardware accelerators and their availability */
 export declare function getHardwareAccelerators(): Array<HardwareAccelerator>
 
+/**
+ * Get current hardware session usage, limits, denied acquisitions and
+ * software fallbacks since process start.
+ */
+export declare function getHardwareSessionStats(): HardwareSessionStats
+
 /** Get the preferred hardware accelerator for the current platform */
 export declare function getPreferredHardwareAccelerator(): string | null
 
+/** Get the number of threads new scalers split a conversion across. */
+export declare function getScalerThreads(): number
+
 /** Hardware acceleration preference (W3C WebCodecs spec) */
 export type HardwareAcceleration = /** No preference - may use hardware or software */
   | 'no-preference'
@@ -1567,6 +1994,34 @@ export interface HardwareAccelerator {
   available: boolean
 }
 
+/** Usage counters for one kind of hardware session (non-standard) */
+export interface HardwareSessionCounters {
+  /** Sessions currently holding a hardware slot */
+  active: number
+  /** Maximum concurrent hardware sessions */
+  max: number
+  /** Slot acquisitions refused because all slots were in use */
+  denied: number
+  /** Sessions that wanted hardware but ended up on a software codec */
+  softwareFallbacks: number
+}
+
+/** Limits accepted by `setHardwareSessionLimits()` (non-standard) */
+export interface HardwareSessionLimits {
+  /** Maximum concurrent hardware VideoEncoder sessions */
+  maxEncoders?: number
+  /** Maximum concurrent hardware VideoDecoder sessions */
+  maxDecoders?: number
+}
+
+/** Hardware session usage reported by `getHardwareSessionStats()` (non-standard) */
+export interface HardwareSessionStats {
+  /** VideoEncoder hardware sessions */
+  encoders: HardwareSessionCounters
+  /** VideoDecoder hardware sessions */
+  decoders: HardwareSessionCounters
+}
+
 /** HEVC (H.265) bitstream format (W3C WebCodecs HEVC Registration) */
 export type HevcBitstreamFormat = /** HEVC format with parameter sets in description (ISO 14496-15) */
   | 'hevc'
@@ -1646,7 +2101,7 @@ export interface Mp4AudioTrackConfig {
 export interface Mp4MuxerOptions {
   /**
    * Move moov atom to beginning for better streaming (default: false)
-   * Note: Not compatible with streaming output mode
+   * In streaming output mode this writes fragmented MP4 with a leading moov
    */
   fastStart?: boolean
   /**
@@ -1656,6 +2111,11 @@ export interface Mp4MuxerOptions {
   fragmented?: boolean
   /** Enable streaming output mode */
   streaming?: StreamingMuxerOptions
+  /**
+   * Enable segmenting output mode (segments go to `onsegment`)
+   * Cannot be combined with `streaming`
+   */
+  segmented?: SegmentedMuxerOptions
 }
 
 /** Video track configuration for MP4 muxer */
@@ -1672,6 +2132,31 @@ export interface Mp4VideoTrackConfig {
   description?: Uint8Array
 }
 
+/** Segment handed to `onsegment` in segmenting mode */
+export interface MuxerSegment {
+  /** Init or media segment */
+  segmentType: MuxerSegmentType
+  /** Segment bytes */
+  data: Uint8Array
+  /** Media segment sequence number, starting at 1 (0 for the init segment) */
+  sequence: number
+  /** Timestamp of the first chunk in the segment in microseconds */
+  timestamp: number
+  /** Segment duration in microseconds (0 for the init segment) */
+  duration: number
+  /** Segment URI (the init URI, or the segment URI template filled in) */
+  uri: string
+}
+
+/** Kind of segment produced in segmenting mode */
+export type MuxerSegmentType = /**
+ * Container header (ftyp+moov / EBML header+Tracks); needed to play any
+ * media segment
+ */
+  | 'init'
+  /** Media segment starting with a keyframe */
+  | 'media'
+
 /** Opus application mode (W3C WebCodecs Opus Registration) */
 export type OpusApplication = /** Optimize for VoIP (speech intelligibility) */
   | 'voip'
@@ -1725,6 +2210,13 @@ export interface PlaneLayout {
   stride: number
 }
 
+/**
+ * Release cached hardware devices that no codec is using (non-standard)
+ *
+ * Returns the number of devices released. They are reopened on demand.
+ */
+export declare function releaseUnusedHardwareDevices(): number
+
 /**
  * Reset all hardware fallback state.
  *
@@ -1736,6 +2228,105 @@ export interface PlaneLayout {
  */
 export declare function resetHardwareFallbackState(): void
 
+/**
+ * Set the total number of libavcodec threads shared by software codecs.
+ *
+ * Each VideoDecoder, VideoEncoder and ImageDecoder configured afterwards, and
+ * each scaler created with `setScalerThreads(0)` or `scalerThreads: 0`, gets
+ * a share weighted by codec cost and resolution, and at most half the budget;
+ * realtime encoders use slice threads. Threads return to the budget when a
+ * codec is closed, reset or reconfigured, and when an ImageDecoder has
+ * decoded its last frame. Defaults to one thread per CPU core; 0 lets libavcodec pick
+ * a thread count per codec.
+ */
+export declare function setCodecThreadBudget(threads: number): void
+
+/**
+ * Run codec commands on a shared pool of `threads` worker threads.
+ *
+ * 0 (the default) gives every VideoDecoder, VideoEncoder, AudioDecoder and
+ * AudioEncoder its own worker thread. Applies to codecs constructed,
+ * configured or reset afterwards. The pool is started with the size in
+ * effect when the first pooled codec starts and keeps it for the life of the
+ * process: once it runs, asking for a different non-zero size throws
+ * InvalidStateError. Codecs with `outputBatch` keep a dedicated thread.
+ */
+export declare function setCodecWorkerThreads(threads: number): void
+
+/**
+ * Set the process-wide frame memory budgets.
+ *
+ * Omitted members keep their current value; 0 removes a budget. Above the
+ * soft budget decoders pause briefly before each chunk until frames are
+ * closed, ImageDecoder keeps only its newest decoded frame, copyTo() stops
+ * caching conversions, and the pressure listener is notified. Cached
+ * conversions count against both budgets. Frame allocations that would
+ * exceed the hard budget fail; decoded frames are always delivered.
+ */
+export declare function setFrameMemoryBudget(budget: FrameMemoryBudget): void
+
+/**
+ * Call `callback` whenever the frame memory pressure level changes.
+ *
+ * It fires when live frame memory crosses the soft budget, when an
+ * allocation is refused by the hard budget, and when memory is back under
+ * the soft budget. Pass null to remove it. The listener doesn't keep the
+ * process alive.
+ */
+export declare function setFrameMemoryPressureListener(callback?: ((arg: FrameMemoryPressureEvent) => unknown) | undefined | null): void
+
+/**
+ * Set the maximum number of concurrent hardware encoder/decoder sessions.
+ *
+ * Omitted members keep their current value. Once the limit is reached,
+ * `no-preference` encoders use a software codec and `prefer-hardware`
+ * codecs try hardware anyway. Lowering a limit doesn't affect sessions
+ * that already hold a slot.
+ */
+export declare function setHardwareSessionLimits(limits: HardwareSessionLimits): void
+
+/**
+ * Set the number of threads each new scaler splits a conversion across.
+ *
+ * 1 (the default) converts on the codec's own worker thread. Each scaler
+ * with more than one thread starts its own slice threads; 0 takes their
+ * count from the codec thread budget (`setCodecThreadBudget()`), so many
+ * concurrent scalers share the cores instead of each starting one thread
+ * per core. Scalers that already exist keep their thread count.
+ */
+export declare function setScalerThreads(threads: number): void
+
+/**
+ * Segmenting mode options for muxers (non-standard extension)
+ *
+ * Output is cut into an init segment plus media segments (CMAF for MP4,
+ * one or more whole clusters per segment for WebM) that are handed to
+ * `onsegment` as they complete, so encoding and packaging for HLS/DASH
+ * happen in one pass.
+ */
+export interface SegmentedMuxerOptions {
+  /**
+   * Target segment duration in microseconds (default: 2 seconds)
+   *
+   * A segment is cut at the first video keyframe (any audio chunk for
+   * audio-only output) at or after the target, so segments can run longer
+   * when keyframes are sparse.
+   */
+  targetDuration?: number
+  /** Init segment URI used in playlists (default: "init.mp4" / "init.webm") */
+  initUri?: string
+  /**
+   * Media segment URI template; "$Number$" is replaced by the segment's
+   * sequence number (default: "segment-$Number$.m4s" / "segment-$Number$.webm")
+   */
+  segmentUri?: string
+  /**
+   * Number of most recent segments listed in the playlist
+   * (default: 0 = all segments, an EVENT playlist)
+   */
+  playlistSize?: number
+}
+
 /** Streaming mode options for muxers */
 export interface StreamingMuxerOptions {
   /** Buffer capacity for streaming output (default: 256KB) */
@@ -1766,6 +2357,16 @@ export type VideoColorPrimaries = /** BT.709 / sRGB primaries */
   /** SMPTE 432 (DCI-P3) */
   | 'smpte432'
 
+/** Which frames a VideoDecoder decodes (non-standard) */
+export type VideoDecodeMode = /** Decode every frame (default) */
+  | 'all'
+  /** Skip frames no other frame predicts from (typically B-frames) */
+  | 'non-reference'
+  /** Decode keyframes only; delta chunks are dropped without being decoded */
+  | 'keyframes'
+  /** Decode every frame, trading quality for speed (no deblocking filter) */
+  | 'fast'
+
 /** Options for addEventListener (W3C DOM spec) */
 export interface VideoDecoderAddEventListenerOptions {
   capture?: boolean
@@ -1866,6 +2467,22 @@ export interface VideoEncoderEncodeOptionsForVp9 {
   quantizer?: number
 }
 
+/** Conversion frame pool statistics (non-standard extension) */
+export interface VideoEncoderFramePoolStats {
+  /** Number of converted frames currently retained for reuse */
+  size: number
+  /** Maximum number of frames the pool retains */
+  capacity: number
+  /** Conversions that reused a pooled frame */
+  hits: number
+  /** Conversions that had to allocate a new frame */
+  misses: number
+  /** hits / (hits + misses), 0 when no conversion has happened yet */
+  hitRate: number
+  /** Slice threads the input conversion runs on, 0 before the first conversion */
+  scalerThreads: number
+}
+
 /** Result of isConfigSupported per WebCodecs spec */
 export interface VideoEncoderSupport {
   /** Whether the configuration is supported */
@@ -1882,6 +2499,13 @@ export interface VideoFrameCopyToOptions {
   rect?: DOMRectInit
   /** Layout for output planes */
   layout?: Array<PlaneLayout>
+  /**
+   * Keep a converted or downloaded copy for later copyTo() calls on this
+   * frame and its clones (non-standard, default: true)
+   *
+   * Pass false for one-off copies so the conversion is freed right away.
+   */
+  cacheConversion?: boolean
 }
 
 /** Options for creating a VideoFrame from an image source (VideoFrameInit per spec) */
@@ -2010,6 +2634,11 @@ export interface WebMMuxerOptions {
   live?: boolean
   /** Enable streaming output mode */
   streaming?: StreamingMuxerOptions
+  /**
+   * Enable segmenting output mode (segments go to `onsegment`)
+   * Cannot be combined with `streaming`
+   */
+  segmented?: SegmentedMuxerOptions
 }
 
 /** Video track configuration for WebM muxer */
@@ -2027,3 +2656,14 @@ export interface WebMVideoTrackConfig {
   /** Whether the video has alpha channel (VP9 alpha support) */
   alpha?: boolean
 }
+
+/**
+ * Open hardware devices and probe codec support ahead of the first configure() (non-standard)
+ *
+ * Creates the shared device for each named accelerator (default: the
+ * preferred one) and caches `isConfigSupported()` answers for the common
+ * codecs, so later configure() calls skip driver initialization. Driver
+ * initialization runs on a background thread. Resolves with the
+ * accelerators whose device is ready.
+ */
+export declare function warmUpHardware(accelerators?: Array<string> | undefined | null): Promise<Array<string>>
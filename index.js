@@ -764,9 +764,16 @@ module.exports.CodecState = nativeBinding.CodecState
 module.exports.ColorSpaceConversion = nativeBinding.ColorSpaceConversion
 module.exports.EncodedAudioChunkType = nativeBinding.EncodedAudioChunkType
 module.exports.EncodedVideoChunkType = nativeBinding.EncodedVideoChunkType
+module.exports.EncodeQueueOverflow = nativeBinding.EncodeQueueOverflow
+module.exports.FrameMemoryPressure = nativeBinding.FrameMemoryPressure
 module.exports.getAvailableHardwareAccelerators = nativeBinding.getAvailableHardwareAccelerators
+module.exports.getCodecThreadBudget = nativeBinding.getCodecThreadBudget
+module.exports.getCodecWorkerThreads = nativeBinding.getCodecWorkerThreads
+module.exports.getFrameMemoryStats = nativeBinding.getFrameMemoryStats
 module.exports.getHardwareAccelerators = nativeBinding.getHardwareAccelerators
+module.exports.getHardwareSessionStats = nativeBinding.getHardwareSessionStats
 module.exports.getPreferredHardwareAccelerator = nativeBinding.getPreferredHardwareAccelerator
+module.exports.getScalerThreads = nativeBinding.getScalerThreads
 module.exports.HardwareAcceleration = nativeBinding.HardwareAcceleration
 module.exports.HevcBitstreamFormat = nativeBinding.HevcBitstreamFormat
 module.exports.isHardwareAcceleratorAvailable = nativeBinding.isHardwareAcceleratorAvailable
@@ -774,9 +781,17 @@ module.exports.LatencyMode = nativeBinding.LatencyMode
 module.exports.OpusApplication = nativeBinding.OpusApplication
 module.exports.OpusBitstreamFormat = nativeBinding.OpusBitstreamFormat
 module.exports.OpusSignal = nativeBinding.OpusSignal
+module.exports.releaseUnusedHardwareDevices = nativeBinding.releaseUnusedHardwareDevices
 module.exports.resetHardwareFallbackState = nativeBinding.resetHardwareFallbackState
+module.exports.setCodecThreadBudget = nativeBinding.setCodecThreadBudget
+module.exports.setCodecWorkerThreads = nativeBinding.setCodecWorkerThreads
+module.exports.setFrameMemoryBudget = nativeBinding.setFrameMemoryBudget
+module.exports.setFrameMemoryPressureListener = nativeBinding.setFrameMemoryPressureListener
+module.exports.setHardwareSessionLimits = nativeBinding.setHardwareSessionLimits
+module.exports.setScalerThreads = nativeBinding.setScalerThreads
 module.exports.VideoColorPrimaries = nativeBinding.VideoColorPrimaries
 module.exports.VideoEncoderBitrateMode = nativeBinding.VideoEncoderBitrateMode
 module.exports.VideoMatrixCoefficients = nativeBinding.VideoMatrixCoefficients
 module.exports.VideoPixelFormat = nativeBinding.VideoPixelFormat
 module.exports.VideoTransferCharacteristics = nativeBinding.VideoTransferCharacteristics
+module.exports.warmUpHardware = nativeBinding.warmUpHardware
@@ -7,17 +7,131 @@
 //! - FLAC/Vorbis: variable
 //!
 //! This buffer accumulates input samples and produces frames of the required size.
+//!
+//! Samples are kept in a ring in the codec's own layout (one ring per channel
+//! for planar formats), so taking a frame is one or two plain copies per
+//! plane and nothing is ever shifted. The ring starts at two frames and only
+//! grows when a single input is larger than the free space, so it settles at
+//! a fixed size after the first few inputs. Output frames are recycled once
+//! the encoder has released them, and an input that already is exactly one
+//! frame in the codec's format (the common case for 20ms Opus voice) is
+//! handed to the encoder as-is without touching the ring.
+
+use std::collections::VecDeque;
 
-use crate::ffi::AVSampleFormat;
+use crate::ffi::{AVSampleFormat, avutil::av_frame_is_writable};
 
 use super::{CodecError, CodecResult, Frame};
 
+/// Number of encoded frames kept for reuse
+///
+/// Audio encoders release their input as soon as `avcodec_send_frame`
+/// returns, so a couple of frames are enough to never allocate in steady state.
+const FRAME_POOL_CAPACITY: usize = 4;
+
+/// Fixed-capacity ring of samples for `planes` planes of `stride` bytes per sample
+struct SampleRing {
+  planes: Vec<Vec<u8>>,
+  /// Bytes per sample in one plane (all channels for interleaved formats)
+  stride: usize,
+  /// Capacity in samples
+  capacity: usize,
+  /// Index of the oldest sample
+  head: usize,
+  /// Number of samples buffered
+  len: usize,
+}
+
+impl SampleRing {
+  fn new(planes: usize, stride: usize, capacity: usize) -> Self {
+    Self {
+      planes: vec![vec![0u8; capacity * stride]; planes],
+      stride,
+      capacity,
+      head: 0,
+      len: 0,
+    }
+  }
+
+  /// Free space in samples
+  fn free(&self) -> usize {
+    self.capacity - self.len
+  }
+
+  /// Grow to hold at least `capacity` samples, unwrapping the buffered data
+  fn grow(&mut self, capacity: usize) {
+    let capacity = capacity.max(self.capacity * 2);
+    for plane in &mut self.planes {
+      let mut grown = vec![0u8; capacity * self.stride];
+      let first = self.len.min(self.capacity - self.head);
+      grown[..first * self.stride]
+        .copy_from_slice(&plane[self.head * self.stride..(self.head + first) * self.stride]);
+      grown[first * self.stride..self.len * self.stride]
+        .copy_from_slice(&plane[..(self.len - first) * self.stride]);
+      *plane = grown;
+    }
+    self.capacity = capacity;
+    self.head = 0;
+  }
+
+  /// Append `samples` samples; `data(plane)` yields each plane's bytes
+  fn push<'a>(&mut self, samples: usize, data: impl Fn(usize) -> &'a [u8]) {
+    if samples > self.free() {
+      self.grow(self.len + samples);
+    }
+    let tail = (self.head + self.len) % self.capacity;
+    let first = samples.min(self.capacity - tail);
+    for (index, plane) in self.planes.iter_mut().enumerate() {
+      let src = &data(index)[..samples * self.stride];
+      let (a, b) = src.split_at(first * self.stride);
+      plane[tail * self.stride..(tail + first) * self.stride].copy_from_slice(a);
+      plane[..b.len()].copy_from_slice(b);
+    }
+    self.len += samples;
+  }
+
+  /// Remove the oldest `samples` samples
+  ///
+  /// `read(plane, first, second)` receives each plane's samples as up to two
+  /// contiguous runs (the second is empty unless the data wraps around).
+  fn pop(&mut self, samples: usize, mut read: impl FnMut(usize, &[u8], &[u8])) {
+    let samples = samples.min(self.len);
+    let first = samples.min(self.capacity - self.head);
+    for (index, plane) in self.planes.iter().enumerate() {
+      read(
+        index,
+        &plane[self.head * self.stride..(self.head + first) * self.stride],
+        &plane[..(samples - first) * self.stride],
+      );
+    }
+    self.head = (self.head + samples) % self.capacity;
+    self.len -= samples;
+  }
+
+  fn clear(&mut self) {
+    self.head = 0;
+    self.len = 0;
+  }
+}
+
+/// Write two runs of samples to the start of one of a frame's planes
+fn copy_to_plane(frame: &mut Frame, plane: usize, first: &[u8], second: &[u8]) {
+  if let Some(out) = frame.audio_channel_data_mut(plane) {
+    out[..first.len()].copy_from_slice(first);
+    out[first.len()..first.len() + second.len()].copy_from_slice(second);
+  }
+}
+
 /// Buffer for accumulating audio samples
 pub struct AudioSampleBuffer {
-  /// Sample buffer (interleaved format)
-  buffer: Vec<u8>,
-  /// Number of samples currently in buffer
-  samples_in_buffer: usize,
+  /// Buffered samples in the codec's layout
+  ring: SampleRing,
+  /// A full input frame passed through without copying
+  direct: Option<Frame>,
+  /// Encoded frames waiting to be reused
+  pool: VecDeque<Frame>,
+  /// Interleave/deinterleave scratch for inputs in the other layout
+  scratch: Vec<u8>,
   /// Target frame size (samples per channel)
   frame_size: usize,
   /// Number of channels
@@ -37,15 +151,21 @@ impl AudioSampleBuffer {
   /// * `frame_size` - Number of samples per channel required per frame
   /// * `channels` - Number of audio channels
   /// * `sample_rate` - Sample rate in Hz
-  /// * `format` - Sample format (should be interleaved for simplicity)
+  /// * `format` - Sample format of the frames produced (planar or interleaved)
   pub fn new(frame_size: usize, channels: u32, sample_rate: u32, format: AVSampleFormat) -> Self {
     let bytes_per_sample = format.bytes_per_sample();
-    // Allocate buffer for 2x frame size to handle overflow
-    let buffer_size = frame_size * channels as usize * bytes_per_sample * 2;
+    let (planes, stride) = if format.is_planar() {
+      (channels as usize, bytes_per_sample)
+    } else {
+      (1, bytes_per_sample * channels as usize)
+    };
 
     Self {
-      buffer: vec![0u8; buffer_size],
-      samples_in_buffer: 0,
+      // Room for 2x frame size to handle overflow
+      ring: SampleRing::new(planes, stride, frame_size.max(1) * 2),
+      direct: None,
+      pool: VecDeque::with_capacity(FRAME_POOL_CAPACITY),
+      scratch: Vec::new(),
       frame_size,
       channels,
       sample_rate,
@@ -76,7 +196,8 @@ impl AudioSampleBuffer {
   /// * `samples` - Interleaved sample data
   /// * `num_samples` - Number of samples per channel
   pub fn add_samples(&mut self, samples: &[u8], num_samples: usize) -> CodecResult<()> {
-    let sample_bytes = num_samples * self.channels as usize * self.bytes_per_sample;
+    let channels = self.channels as usize;
+    let sample_bytes = num_samples * channels * self.bytes_per_sample;
 
     if samples.len() < sample_bytes {
       return Err(CodecError::InvalidConfig(
@@ -84,24 +205,35 @@ impl AudioSampleBuffer {
       ));
     }
 
-    let current_bytes = self.samples_in_buffer * self.channels as usize * self.bytes_per_sample;
-    let new_total = current_bytes + sample_bytes;
-
-    // Grow buffer if needed
-    if new_total > self.buffer.len() {
-      self.buffer.resize(new_total * 2, 0);
+    self.spill_direct();
+    if self.format.is_planar() {
+      // Deinterleave into one contiguous run per channel
+      let bps = self.bytes_per_sample;
+      let plane_bytes = num_samples * bps;
+      self.scratch.resize(plane_bytes * channels, 0);
+      for sample in 0..num_samples {
+        for ch in 0..channels {
+          let src = (sample * channels + ch) * bps;
+          let dst = ch * plane_bytes + sample * bps;
+          self.scratch[dst..dst + bps].copy_from_slice(&samples[src..src + bps]);
+        }
+      }
+      let scratch = &self.scratch;
+      self.ring.push(num_samples, |ch| {
+        &scratch[ch * plane_bytes..(ch + 1) * plane_bytes]
+      });
+    } else {
+      self.ring.push(num_samples, |_| samples);
     }
 
-    // Copy samples to buffer
-    self.buffer[current_bytes..current_bytes + sample_bytes]
-      .copy_from_slice(&samples[..sample_bytes]);
-    self.samples_in_buffer += num_samples;
-
     Ok(())
   }
 
   /// Add samples from a Frame
-  pub fn add_frame(&mut self, frame: &Frame) -> CodecResult<()> {
+  ///
+  /// A frame of exactly `frame_size` samples in the buffer's format arriving
+  /// while the buffer is empty is kept as-is and returned by `take_frame()`.
+  pub fn add_frame(&mut self, frame: Frame) -> CodecResult<()> {
     if !frame.is_audio() {
       return Err(CodecError::InvalidConfig("Frame is not audio".into()));
     }
@@ -117,164 +249,179 @@ impl AudioSampleBuffer {
     }
 
     let nb_samples = frame.nb_samples() as usize;
-    let sample_bytes = nb_samples * self.channels as usize * self.bytes_per_sample;
-
-    // Handle format conversion if needed
-    if frame_format.is_planar() && !self.format.is_planar() {
-      // Need to interleave the data
-      let mut interleaved = vec![0u8; sample_bytes];
-      for sample in 0..nb_samples {
-        for ch in 0..self.channels as usize {
-          let src_offset = sample * self.bytes_per_sample;
-          let dst_offset = (sample * self.channels as usize + ch) * self.bytes_per_sample;
-
-          if let Some(ch_data) = frame.audio_channel_data(ch) {
-            interleaved[dst_offset..dst_offset + self.bytes_per_sample]
-              .copy_from_slice(&ch_data[src_offset..src_offset + self.bytes_per_sample]);
-          }
+
+    if self.direct.is_none()
+      && self.ring.len == 0
+      && nb_samples == self.frame_size
+      && frame_format == self.format
+      && frame.sample_rate() == self.sample_rate
+    {
+      // Same default channel layout as the frames this buffer allocates,
+      // which is what the encoder was opened with
+      let mut frame = frame;
+      frame.set_channels(self.channels);
+      self.direct = Some(frame);
+      return Ok(());
+    }
+
+    self.spill_direct();
+    self.push_frame(&frame)
+  }
+
+  /// Copy a frame's samples into the ring
+  fn push_frame(&mut self, frame: &Frame) -> CodecResult<()> {
+    let nb_samples = frame.nb_samples() as usize;
+    let frame_format = frame.sample_format();
+
+    if frame_format.is_planar() == self.format.is_planar() {
+      // Same layout: plane-by-plane copy
+      let planes = self.ring.planes.len();
+      for plane in 0..planes {
+        if frame.audio_channel_data(plane).is_none() {
+          return Err(CodecError::InvalidState("No audio data in frame".into()));
         }
       }
-      self.add_samples(&interleaved, nb_samples)
-    } else if !frame_format.is_planar() {
-      // Already interleaved
-      if let Some(data) = frame.audio_channel_data(0) {
-        self.add_samples(data, nb_samples)
-      } else {
-        Err(CodecError::InvalidState("No audio data in frame".into()))
-      }
-    } else {
-      // Source is planar, target is planar - still need to interleave for buffer storage
-      // (buffer always stores interleaved, deinterleaves when creating output frame)
-      let mut interleaved = vec![0u8; sample_bytes];
-      for sample in 0..nb_samples {
-        for ch in 0..self.channels as usize {
-          let src_offset = sample * self.bytes_per_sample;
-          let dst_offset = (sample * self.channels as usize + ch) * self.bytes_per_sample;
-
-          if let Some(ch_data) = frame.audio_channel_data(ch)
-            && src_offset + self.bytes_per_sample <= ch_data.len()
-          {
-            interleaved[dst_offset..dst_offset + self.bytes_per_sample]
-              .copy_from_slice(&ch_data[src_offset..src_offset + self.bytes_per_sample]);
+      self.ring.push(nb_samples, |plane| {
+        frame.audio_channel_data(plane).unwrap_or_default()
+      });
+      Ok(())
+    } else if frame_format.is_planar() {
+      // Planar input, interleaved buffer: interleave the channels
+      let channels = self.channels as usize;
+      let bps = self.bytes_per_sample;
+      self.scratch.resize(nb_samples * channels * bps, 0);
+      for ch in 0..channels {
+        if let Some(ch_data) = frame.audio_channel_data(ch) {
+          for sample in 0..nb_samples.min(ch_data.len() / bps) {
+            let dst = (sample * channels + ch) * bps;
+            self.scratch[dst..dst + bps]
+              .copy_from_slice(&ch_data[sample * bps..(sample + 1) * bps]);
           }
         }
       }
-      self.add_samples(&interleaved, nb_samples)
+      let scratch = &self.scratch;
+      self.ring.push(nb_samples, |_| scratch);
+      Ok(())
+    } else {
+      // Interleaved input, planar buffer
+      let data = frame
+        .audio_channel_data(0)
+        .ok_or_else(|| CodecError::InvalidState("No audio data in frame".into()))?;
+      self.add_samples(data, nb_samples)
+    }
+  }
+
+  /// Move a passed-through frame into the ring before more samples arrive
+  fn spill_direct(&mut self) {
+    if let Some(frame) = self.direct.take() {
+      let planes = self.ring.planes.len();
+      if (0..planes).all(|plane| frame.audio_channel_data(plane).is_some()) {
+        self.ring.push(frame.nb_samples() as usize, |plane| {
+          frame.audio_channel_data(plane).unwrap_or_default()
+        });
+      }
     }
   }
 
   /// Check if there are enough samples for a full frame
   pub fn has_full_frame(&self) -> bool {
-    self.samples_in_buffer >= self.frame_size
+    self.direct.is_some() || self.ring.len >= self.frame_size
   }
 
   /// Get number of samples currently in buffer
   pub fn samples_available(&self) -> usize {
-    self.samples_in_buffer
+    self.ring.len + self.direct.as_ref().map_or(0, |f| f.nb_samples() as usize)
   }
 
   /// Get number of complete frames available
   pub fn frames_available(&self) -> usize {
-    self.samples_in_buffer / self.frame_size
+    self.samples_available() / self.frame_size.max(1)
   }
 
   /// Take a full frame of samples from the buffer
   ///
-  /// Returns None if there aren't enough samples for a full frame
+  /// Returns None if there aren't enough samples for a full frame. Hand the
+  /// frame back with `recycle()` once it has been sent to the encoder.
   pub fn take_frame(&mut self) -> CodecResult<Option<Frame>> {
+    if let Some(frame) = self.direct.take() {
+      return Ok(Some(frame));
+    }
     if !self.has_full_frame() {
       return Ok(None);
     }
 
-    // Create output frame
-    let mut frame = Frame::new_audio(
+    let mut frame = self.acquire_frame()?;
+    // Copy data to frame (per plane: the ring stores the codec's layout)
+    self.ring.pop(self.frame_size, |plane, first, second| {
+      copy_to_plane(&mut frame, plane, first, second)
+    });
+
+    Ok(Some(frame))
+  }
+
+  /// Get a writable frame of `frame_size` samples, reusing a released one
+  fn acquire_frame(&mut self) -> CodecResult<Frame> {
+    let reusable = self
+      .pool
+      .iter_mut()
+      .position(|frame| unsafe { av_frame_is_writable(frame.as_mut_ptr()) } > 0);
+    if let Some(index) = reusable
+      && let Some(frame) = self.pool.remove(index)
+    {
+      return Ok(frame);
+    }
+    Frame::new_audio(
       self.frame_size as u32,
       self.channels,
       self.sample_rate,
       self.format,
-    )?;
-
-    let frame_bytes = self.frame_size * self.channels as usize * self.bytes_per_sample;
+    )
+  }
 
-    // Copy data to frame
-    if self.format.is_planar() {
-      // Need to deinterleave
-      for ch in 0..self.channels as usize {
-        if let Some(ch_data) = frame.audio_channel_data_mut(ch) {
-          for sample in 0..self.frame_size {
-            let src_offset = (sample * self.channels as usize + ch) * self.bytes_per_sample;
-            let dst_offset = sample * self.bytes_per_sample;
-            ch_data[dst_offset..dst_offset + self.bytes_per_sample]
-              .copy_from_slice(&self.buffer[src_offset..src_offset + self.bytes_per_sample]);
-          }
-        }
-      }
-    } else {
-      // Direct copy for interleaved
-      if let Some(data) = frame.audio_channel_data_mut(0) {
-        data[..frame_bytes].copy_from_slice(&self.buffer[..frame_bytes]);
-      }
+  /// Return a frame produced by `take_frame()` for reuse
+  ///
+  /// The frame's buffers are only written again once nothing else references
+  /// them (the encoder, or the AudioData a passed-through frame came from).
+  pub fn recycle(&mut self, frame: Frame) {
+    if frame.nb_samples() as usize != self.frame_size || frame.sample_format() != self.format {
+      return;
     }
-
-    // Shift remaining samples to front of buffer
-    let remaining_bytes =
-      (self.samples_in_buffer - self.frame_size) * self.channels as usize * self.bytes_per_sample;
-
-    if remaining_bytes > 0 {
-      self
-        .buffer
-        .copy_within(frame_bytes..frame_bytes + remaining_bytes, 0);
+    if self.pool.len() >= FRAME_POOL_CAPACITY {
+      self.pool.pop_front();
     }
-    self.samples_in_buffer -= self.frame_size;
-
-    Ok(Some(frame))
+    self.pool.push_back(frame);
   }
 
   /// Flush remaining samples as a partial frame
   ///
   /// Returns None if buffer is empty
   pub fn flush(&mut self) -> CodecResult<Option<Frame>> {
-    if self.samples_in_buffer == 0 {
+    if let Some(frame) = self.direct.take() {
+      return Ok(Some(frame));
+    }
+    if self.ring.len == 0 {
       return Ok(None);
     }
 
     // Create frame with remaining samples
     let mut frame = Frame::new_audio(
-      self.samples_in_buffer as u32,
+      self.ring.len as u32,
       self.channels,
       self.sample_rate,
       self.format,
     )?;
 
-    let remaining_bytes = self.samples_in_buffer * self.channels as usize * self.bytes_per_sample;
-
-    // Copy data to frame
-    if self.format.is_planar() {
-      for ch in 0..self.channels as usize {
-        if let Some(ch_data) = frame.audio_channel_data_mut(ch) {
-          for sample in 0..self.samples_in_buffer {
-            let src_offset = (sample * self.channels as usize + ch) * self.bytes_per_sample;
-            let dst_offset = sample * self.bytes_per_sample;
-            if dst_offset + self.bytes_per_sample <= ch_data.len()
-              && src_offset + self.bytes_per_sample <= self.buffer.len()
-            {
-              ch_data[dst_offset..dst_offset + self.bytes_per_sample]
-                .copy_from_slice(&self.buffer[src_offset..src_offset + self.bytes_per_sample]);
-            }
-          }
-        }
-      }
-    } else if let Some(data) = frame.audio_channel_data_mut(0) {
-      data[..remaining_bytes].copy_from_slice(&self.buffer[..remaining_bytes]);
-    }
+    self.ring.pop(self.ring.len, |plane, first, second| {
+      copy_to_plane(&mut frame, plane, first, second)
+    });
 
-    self.samples_in_buffer = 0;
     Ok(Some(frame))
   }
 
   /// Clear the buffer
   pub fn clear(&mut self) {
-    self.samples_in_buffer = 0;
+    self.ring.clear();
+    self.direct = None;
   }
 
   // ========================================================================
@@ -309,7 +456,7 @@ impl std::fmt::Debug for AudioSampleBuffer {
       .field("channels", &self.channels)
       .field("sample_rate", &self.sample_rate)
       .field("format", &self.format)
-      .field("samples_in_buffer", &self.samples_in_buffer)
+      .field("samples_in_buffer", &self.samples_available())
       .field("frames_available", &self.frames_available())
       .finish()
   }
@@ -328,6 +475,50 @@ mod tests {
     assert!(!buffer.has_full_frame());
   }
 
+  #[test]
+  fn test_ring_wraps_without_shifting() {
+    let mut ring = SampleRing::new(2, 1, 4);
+    ring.push(3, |plane| {
+      if plane == 0 {
+        &[1, 2, 3]
+      } else {
+        &[11, 12, 13]
+      }
+    });
+
+    let mut out = Vec::new();
+    ring.pop(2, |_, first, second| out.push([first, second].concat()));
+    assert_eq!(out, vec![vec![1, 2], vec![11, 12]]);
+
+    // Tail wraps around the end of the ring
+    ring.push(3, |plane| {
+      if plane == 0 {
+        &[4, 5, 6]
+      } else {
+        &[14, 15, 16]
+      }
+    });
+    assert_eq!(ring.capacity, 4);
+    let mut out = Vec::new();
+    ring.pop(4, |_, first, second| out.push([first, second].concat()));
+    assert_eq!(out, vec![vec![3, 4, 5, 6], vec![13, 14, 15, 16]]);
+    assert_eq!(ring.len, 0);
+  }
+
+  #[test]
+  fn test_ring_grows_for_large_input() {
+    let mut ring = SampleRing::new(1, 2, 2);
+    ring.push(1, |_| &[1, 1]);
+    ring.pop(1, |_, _, _| {});
+    ring.push(1, |_| &[2, 2]);
+    ring.push(3, |_| &[3, 3, 4, 4, 5, 5]);
+    assert!(ring.capacity >= 4);
+
+    let mut out = Vec::new();
+    ring.pop(4, |_, first, second| out.extend([first, second].concat()));
+    assert_eq!(out, vec![2, 2, 3, 3, 4, 4, 5, 5]);
+  }
+
   #[test]
   fn test_frame_size_detection() {
     assert_eq!(AudioSampleBuffer::frame_size_for_codec("aac"), 1024);
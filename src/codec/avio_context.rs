@@ -2,7 +2,9 @@
 //!
 //! Provides safe wrappers for custom I/O operations (memory/streaming buffers).
 
-use super::io_buffer::{BufferSource, MemoryBuffer, ReadOnlyBuffer, StreamingBuffer};
+use super::io_buffer::{
+  BufferSource, MemoryBuffer, ReadOnlyBuffer, StreamingBuffer, StreamingReadBuffer,
+};
 use crate::ffi::avformat::{
   AVIOContext, avio_alloc_context, avio_context_free, avio_flush, seek_whence,
 };
@@ -22,6 +24,8 @@ pub enum IoMode {
   BufferRead(Box<ReadOnlyBuffer>),
   /// Streaming output (muxer writes to streaming buffer)
   StreamingWrite(Box<StreamingBuffer>),
+  /// Streaming input (demuxer reads from a forward-only chunk queue)
+  StreamingRead(Box<StreamingReadBuffer>),
 }
 
 /// Custom I/O context wrapper
@@ -58,6 +62,14 @@ impl CustomIOContext {
     Self::create_read_context(IoMode::BufferRead(Box::new(buffer)))
   }
 
+  /// Create a new custom I/O context for reading from a streaming source
+  ///
+  /// The context is not seekable; keep a `StreamingReadFeeder` from the
+  /// buffer before handing it over to push data in.
+  pub fn new_streaming_read(buffer: StreamingReadBuffer) -> Result<Self, String> {
+    Self::create_read_context(IoMode::StreamingRead(Box::new(buffer)))
+  }
+
   /// Create a new custom I/O context for streaming output
   pub fn new_streaming_write(capacity: usize) -> Result<Self, String> {
     let buffer = StreamingBuffer::new(capacity);
@@ -132,6 +144,15 @@ impl CustomIOContext {
       return Err("Failed to allocate AVIO buffer".to_string());
     }
 
+    // Streaming input has no seek callback, which leaves the context
+    // non-seekable; FFmpeg then skips forward by reading instead
+    let seek_cb: Option<crate::ffi::avformat::SeekFn> = if matches!(mode, IoMode::StreamingRead(_))
+    {
+      None
+    } else {
+      Some(seek_callback_read)
+    };
+
     // Box the mode to get a stable pointer
     let mut boxed_mode = Box::new(mode);
     let opaque = boxed_mode.as_mut() as *mut IoMode as *mut c_void;
@@ -143,9 +164,9 @@ impl CustomIOContext {
         buffer_size as c_int,
         0, // write_flag = 0 for reading
         opaque,
-        Some(read_callback),      // read_packet
-        None,                     // write_packet - not needed for reading
-        Some(seek_callback_read), // seek
+        Some(read_callback), // read_packet
+        None,                // write_packet - not needed for reading
+        seek_cb,             // seek
       )
     };
 
@@ -244,7 +265,7 @@ impl CustomIOContext {
         match mode {
           IoMode::BufferWrite(buf) => Some(buf.len()),
           IoMode::BufferRead(buf) => Some(buf.len()),
-          IoMode::StreamingWrite(_) => None,
+          IoMode::StreamingWrite(_) | IoMode::StreamingRead(_) => None,
         }
       } else {
         None
@@ -321,7 +342,7 @@ unsafe extern "C" fn write_callback(opaque: *mut c_void, buf: *const u8, buf_siz
   let result = match mode {
     IoMode::BufferWrite(buffer) => buffer.write(data),
     IoMode::StreamingWrite(buffer) => buffer.write_blocking(data),
-    IoMode::BufferRead(_) => return -1, // Can't write to read buffer
+    IoMode::BufferRead(_) | IoMode::StreamingRead(_) => return -1, // Can't write to read buffer
   };
 
   match result {
@@ -334,6 +355,7 @@ unsafe extern "C" fn write_callback(opaque: *mut c_void, buf: *const u8, buf_siz
 ///
 /// This callback supports reading from:
 /// - BufferRead: normal read mode for demuxing
+/// - StreamingRead: blocks until the feeder pushes more data
 /// - BufferWrite: allows reading back written data for faststart support
 unsafe extern "C" fn read_callback(opaque: *mut c_void, buf: *mut u8, buf_size: c_int) -> c_int {
   if opaque.is_null() || buf.is_null() || buf_size <= 0 {
@@ -349,6 +371,7 @@ unsafe extern "C" fn read_callback(opaque: *mut c_void, buf: *mut u8, buf_size:
     IoMode::BufferRead(buffer) => buffer.read(data),
     // BufferWrite also supports reading for faststart (FFmpeg needs to read back written data)
     IoMode::BufferWrite(buffer) => buffer.read(data),
+    IoMode::StreamingRead(buffer) => buffer.read(data),
     IoMode::StreamingWrite(_) => return -1, // Streaming doesn't support read-back
   };
 
@@ -372,7 +395,7 @@ unsafe extern "C" fn seek_callback_write(opaque: *mut c_void, offset: i64, whenc
     return match mode {
       IoMode::BufferWrite(buffer) => buffer.len() as i64,
       IoMode::StreamingWrite(_) => -1, // Streaming doesn't support size query
-      IoMode::BufferRead(_) => -1,
+      IoMode::BufferRead(_) | IoMode::StreamingRead(_) => -1,
     };
   }
 
@@ -392,7 +415,7 @@ unsafe extern "C" fn seek_callback_write(opaque: *mut c_void, offset: i64, whenc
       Err(_) => -1,
     },
     IoMode::StreamingWrite(_) => -1, // Streaming doesn't support seeking
-    IoMode::BufferRead(_) => -1,
+    IoMode::BufferRead(_) | IoMode::StreamingRead(_) => -1,
   }
 }
 
@@ -447,4 +470,11 @@ mod tests {
     let ctx = CustomIOContext::new_buffer_read(data);
     assert!(ctx.is_ok());
   }
+
+  #[test]
+  fn test_streaming_read_creation() {
+    let buffer = StreamingReadBuffer::new(1024);
+    let ctx = CustomIOContext::new_streaming_read(buffer);
+    assert!(ctx.is_ok());
+  }
 }
@@ -0,0 +1,303 @@
+//! H.264/H.265 bitstream framing helpers
+//!
+//! Containers store NAL units with 4-byte big-endian length prefixes
+//! (AVCC/HVCC) while software decoders and most encoders use Annex B start
+//! codes. A 4-byte length prefix and a 4-byte start code are the same size,
+//! so the conversion can usually rewrite the prefixes in place:
+//!
+//! - AVCC → Annex B is always in place.
+//! - Annex B → AVCC is in place when every start code is 4 bytes (x264 and
+//!   FFmpeg's encoders emit these for single-slice frames). Otherwise it
+//!   appends into a caller-provided buffer that can be reused.
+//!
+//! The NAL iterators borrow from the input, so callers can pick out
+//! parameter sets without copying each NAL.
+
+/// Length of the AVCC/HVCC NAL length prefix this crate reads and writes
+const LENGTH_SIZE: usize = 4;
+
+/// 4-byte Annex B start code
+const START_CODE: [u8; 4] = [0, 0, 0, 1];
+
+/// Find the next Annex B start code at or after `from`
+///
+/// Returns the position and length (3 or 4) of the start code. A zero byte
+/// ending the previous NAL is treated as part of a 4-byte start code.
+fn next_start_code(data: &[u8], from: usize) -> Option<(usize, usize)> {
+  let mut i = from;
+  while i + 3 <= data.len() {
+    if data[i] == 0 && data[i + 1] == 0 {
+      if data[i + 2] == 1 {
+        return Some((i, 3));
+      } else if i + 4 <= data.len() && data[i + 2] == 0 && data[i + 3] == 1 {
+        return Some((i, 4));
+      }
+    }
+    i += 1;
+  }
+  None
+}
+
+/// One NAL unit of an Annex B stream
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AnnexBNal<'a> {
+  /// Offset of the start code in the input
+  pub offset: usize,
+  /// Start code length (3 or 4)
+  pub start_code_len: usize,
+  /// NAL unit without its start code
+  pub data: &'a [u8],
+}
+
+/// Iterator over the NAL units of Annex B data
+///
+/// Bytes before the first start code are skipped.
+pub struct AnnexBNals<'a> {
+  data: &'a [u8],
+  next: Option<(usize, usize)>,
+}
+
+impl<'a> AnnexBNals<'a> {
+  pub fn new(data: &'a [u8]) -> Self {
+    Self {
+      data,
+      next: next_start_code(data, 0),
+    }
+  }
+}
+
+impl<'a> Iterator for AnnexBNals<'a> {
+  type Item = AnnexBNal<'a>;
+
+  fn next(&mut self) -> Option<Self::Item> {
+    let (offset, start_code_len) = self.next?;
+    let start = offset + start_code_len;
+    self.next = next_start_code(self.data, start);
+    let end = self.next.map_or(self.data.len(), |(next, _)| next);
+    Some(AnnexBNal {
+      offset,
+      start_code_len,
+      data: &self.data[start..end],
+    })
+  }
+}
+
+/// Iterator over the NAL units of AVCC/HVCC data (4-byte length prefixes)
+///
+/// Stops at the first zero or out-of-range length; `remaining()` tells
+/// whether the input was consumed completely.
+pub struct AvccNals<'a> {
+  data: &'a [u8],
+  pos: usize,
+}
+
+impl<'a> AvccNals<'a> {
+  pub fn new(data: &'a [u8]) -> Self {
+    Self { data, pos: 0 }
+  }
+
+  /// Bytes not yet parsed as length-prefixed NAL units
+  pub fn remaining(&self) -> &'a [u8] {
+    &self.data[self.pos..]
+  }
+}
+
+impl<'a> Iterator for AvccNals<'a> {
+  type Item = &'a [u8];
+
+  fn next(&mut self) -> Option<Self::Item> {
+    let header = self.data.get(self.pos..self.pos + LENGTH_SIZE)?;
+    let len = u32::from_be_bytes([header[0], header[1], header[2], header[3]]) as usize;
+    let start = self.pos + LENGTH_SIZE;
+    if len == 0 || len > self.data.len() - start {
+      return None;
+    }
+    self.pos = start + len;
+    Some(&self.data[start..start + len])
+  }
+}
+
+/// Check that `data` is a sequence of length-prefixed NAL units
+///
+/// Up to 3 trailing bytes (too short for another prefix) are tolerated;
+/// `avcc_to_annexb_in_place` reports the length without them.
+fn avcc_layout_len(data: &[u8]) -> Option<usize> {
+  let mut nals = AvccNals::new(data);
+  let count = nals.by_ref().count();
+  if count == 0 || nals.remaining().len() >= LENGTH_SIZE {
+    return None;
+  }
+  Some(data.len() - nals.remaining().len())
+}
+
+/// Rewrite AVCC/HVCC data as Annex B in place
+///
+/// Returns the length of the converted data (trailing bytes too short for a
+/// length prefix are dropped), or None when `data` isn't valid AVCC, in which
+/// case it is left untouched.
+pub fn avcc_to_annexb_in_place(data: &mut [u8]) -> Option<usize> {
+  let len = avcc_layout_len(data)?;
+  let mut pos = 0;
+  while pos < len {
+    let header = &mut data[pos..pos + LENGTH_SIZE];
+    let nal_len = u32::from_be_bytes([header[0], header[1], header[2], header[3]]) as usize;
+    header.copy_from_slice(&START_CODE);
+    pos += LENGTH_SIZE + nal_len;
+  }
+  Some(len)
+}
+
+/// Append AVCC/HVCC data to `out` as Annex B
+///
+/// Data that isn't valid AVCC is appended as-is; returns whether it was
+/// converted.
+pub fn append_avcc_as_annexb(data: &[u8], out: &mut Vec<u8>) -> bool {
+  let start = out.len();
+  out.extend_from_slice(data);
+  match avcc_to_annexb_in_place(&mut out[start..]) {
+    Some(len) => {
+      out.truncate(start + len);
+      true
+    }
+    None => false,
+  }
+}
+
+/// Rewrite Annex B data as AVCC/HVCC in place
+///
+/// Only possible when the data starts with a start code and every start
+/// code is 4 bytes long; returns false (leaving `data` untouched) otherwise.
+pub fn annexb_to_avcc_in_place(data: &mut [u8]) -> bool {
+  let mut nals = AnnexBNals::new(data).peekable();
+  match nals.peek() {
+    Some(nal) if nal.offset == 0 => {}
+    _ => return false,
+  }
+  if !nals.all(|nal| nal.start_code_len == START_CODE.len()) {
+    return false;
+  }
+
+  // Every start code is replaced by a prefix of the same size, so NAL
+  // boundaries found before a prefix is written stay valid afterwards
+  let mut offset = 0;
+  loop {
+    let start = offset + START_CODE.len();
+    let next = next_start_code(data, start);
+    let end = next.map_or(data.len(), |(next, _)| next);
+    data[offset..start].copy_from_slice(&((end - start) as u32).to_be_bytes());
+    match next {
+      Some((next, _)) => offset = next,
+      None => return true,
+    }
+  }
+}
+
+/// Append Annex B data to `out` as AVCC/HVCC (4-byte length prefixes)
+///
+/// Data without start codes is appended as-is; returns whether it was
+/// converted.
+pub fn append_annexb_as_avcc(data: &[u8], out: &mut Vec<u8>) -> bool {
+  let mut converted = false;
+  for nal in AnnexBNals::new(data) {
+    if !converted {
+      out.reserve(data.len() + LENGTH_SIZE);
+      converted = true;
+    }
+    out.extend_from_slice(&(nal.data.len() as u32).to_be_bytes());
+    out.extend_from_slice(nal.data);
+  }
+  if !converted {
+    out.extend_from_slice(data);
+  }
+  converted
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  const SPS: &[u8] = &[0x67, 0x42, 0x00, 0x1f];
+  const PPS: &[u8] = &[0x68, 0xce, 0x3c, 0x80];
+  const IDR: &[u8] = &[0x65, 0x88, 0x84, 0x00, 0x00, 0x03, 0x00];
+
+  fn annexb(nals: &[&[u8]], start_code: &[u8]) -> Vec<u8> {
+    nals
+      .iter()
+      .flat_map(|nal| start_code.iter().chain(nal.iter()).copied())
+      .collect()
+  }
+
+  fn avcc(nals: &[&[u8]]) -> Vec<u8> {
+    nals
+      .iter()
+      .flat_map(|nal| {
+        (nal.len() as u32)
+          .to_be_bytes()
+          .into_iter()
+          .chain(nal.iter().copied())
+      })
+      .collect()
+  }
+
+  #[test]
+  fn test_annexb_nals() {
+    let mut data = annexb(&[SPS, PPS], &START_CODE);
+    data.extend_from_slice(&[0, 0, 1]);
+    data.extend_from_slice(IDR);
+
+    let nals: Vec<_> = AnnexBNals::new(&data).collect();
+    assert_eq!(nals.len(), 3);
+    assert_eq!(nals[0].data, SPS);
+    assert_eq!(nals[1].data, PPS);
+    assert_eq!(nals[2].data, IDR);
+    assert_eq!(nals[2].start_code_len, 3);
+  }
+
+  #[test]
+  fn test_avcc_roundtrip_in_place() {
+    let expected = annexb(&[SPS, PPS, IDR], &START_CODE);
+
+    let mut data = avcc(&[SPS, PPS, IDR]);
+    assert_eq!(avcc_to_annexb_in_place(&mut data), Some(data.len()));
+    assert_eq!(data, expected);
+
+    assert!(annexb_to_avcc_in_place(&mut data));
+    assert_eq!(data, avcc(&[SPS, PPS, IDR]));
+  }
+
+  #[test]
+  fn test_short_start_codes_need_a_buffer() {
+    let mut data = annexb(&[SPS, IDR], &[0, 0, 1]);
+    let original = data.clone();
+    assert!(!annexb_to_avcc_in_place(&mut data));
+    assert_eq!(data, original);
+
+    let mut out = vec![0xaa];
+    assert!(append_annexb_as_avcc(&data, &mut out));
+    assert_eq!(out[0], 0xaa);
+    assert_eq!(&out[1..], avcc(&[SPS, IDR]));
+  }
+
+  #[test]
+  fn test_invalid_input_is_passed_through() {
+    let mut garbage = vec![0xff, 0xff, 0xff, 0xff, 0x01];
+    assert_eq!(avcc_to_annexb_in_place(&mut garbage), None);
+
+    let mut out = Vec::new();
+    assert!(!append_avcc_as_annexb(&garbage, &mut out));
+    assert_eq!(out, garbage);
+
+    out.clear();
+    assert!(!append_annexb_as_avcc(&[0x65, 0x88], &mut out));
+    assert_eq!(out, [0x65, 0x88]);
+  }
+
+  #[test]
+  fn test_avcc_trailing_bytes_are_dropped() {
+    let mut out = Vec::new();
+    let mut data = avcc(&[IDR]);
+    data.extend_from_slice(&[0, 0]);
+    assert!(append_avcc_as_annexb(&data, &mut out));
+    assert_eq!(out, annexb(&[IDR], &START_CODE));
+  }
+}
@@ -5,7 +5,7 @@
 use crate::ffi::{
   self, AVCodec, AVCodecContext, AVCodecID, AVHWDeviceType, AVPixelFormat, AVRational,
   accessors::{
-    codec_flag, ffctx_get_extradata, ffctx_get_extradata_size, ffctx_get_flags,
+    codec_flag, ff_codec_get_id, ffctx_get_extradata, ffctx_get_extradata_size, ffctx_get_flags,
     ffctx_get_frame_size, ffctx_get_height, ffctx_get_pix_fmt, ffctx_get_qmax, ffctx_get_qmin,
     ffctx_get_sample_rate, ffctx_get_time_base, ffctx_get_width, ffctx_set_bit_rate,
     ffctx_set_channels, ffctx_set_flags, ffctx_set_framerate, ffctx_set_gop_size,
@@ -25,10 +25,12 @@ use crate::ffi::{
 };
 use std::ffi::CString;
 use std::ptr::NonNull;
+use std::sync::Arc;
 
+use super::thread_budget::{self, ThreadLease, ThreadWorkload};
 use super::{
-  AudioDecoderConfig, AudioEncoderConfig, BitrateMode, CodecError, CodecResult, DecoderConfig,
-  EncoderConfig, Frame, HwDeviceContext, HwFrameContext, Packet,
+  AudioDecoderConfig, AudioEncoderConfig, BitrateMode, CodecError, CodecResult, CodecStats,
+  DecoderConfig, EncoderConfig, Frame, HwDeviceContext, HwFrameContext, Packet, Stage,
 };
 
 /// Result of encoder creation with metadata about hardware acceleration
@@ -77,6 +79,12 @@ pub struct CodecContext {
   codec_type: CodecType,
   hw_device: Option<HwDeviceContext>,
   hw_frames: Option<HwFrameContext>,
+  /// Threads leased from the process-wide budget (released on drop)
+  thread_lease: Option<ThreadLease>,
+  /// Counters of the owning WebCodecs codec; send/receive calls are timed
+  stats: Option<Arc<CodecStats>>,
+  /// VBV limits the encoder was configured with (`rc_max_rate`, `rc_buffer_size`)
+  rate_limits: (Option<u64>, Option<u32>),
 }
 
 impl CodecContext {
@@ -114,10 +122,10 @@ impl CodecContext {
       && let Some(name) = get_hw_encoder_name(codec_id, hw)
       && let Ok(mut ctx) = Self::new_encoder_by_name(name)
     {
-      // Try to create and attach hardware device context
+      // Attach the shared hardware device context
       // Some encoders (like VideoToolbox) don't need it, but VAAPI does
       if hw_encoder_needs_device_context(hw)
-        && let Ok(hw_device) = HwDeviceContext::new(hw)
+        && let Ok(hw_device) = HwDeviceContext::shared(hw)
       {
         ctx.set_hw_device(hw_device);
       }
@@ -150,9 +158,9 @@ impl CodecContext {
       && let Some(name) = get_hw_encoder_name(codec_id, hw)
       && let Ok(mut ctx) = Self::new_encoder_by_name(name)
     {
-      // Try to create and attach hardware device context
+      // Attach the shared hardware device context
       if hw_encoder_needs_device_context(hw)
-        && let Ok(hw_device) = HwDeviceContext::new(hw)
+        && let Ok(hw_device) = HwDeviceContext::shared(hw)
       {
         ctx.set_hw_device(hw_device);
       }
@@ -192,9 +200,9 @@ impl CodecContext {
     // with hw_device_ctx attached)
     let mut ctx = Self::new_decoder(codec_id)?;
 
-    // Attach hardware device context if requested
+    // Attach the shared hardware device context if requested
     if let Some(hw) = hw_type
-      && let Ok(hw_device) = HwDeviceContext::new(hw)
+      && let Ok(hw_device) = HwDeviceContext::shared(hw)
     {
       ctx.set_hw_device(hw_device);
     }
@@ -238,8 +246,9 @@ impl CodecContext {
 
       // AV_PIX_FMT_NONE is -1
       if pix_fmt_raw != -1 {
-        // Hardware is supported by this codec
-        if let Ok(hw_device) = HwDeviceContext::new(hw) {
+        // Hardware is supported by this codec. Use the shared device so GPU
+        // frames can be handed to encoders on the same device.
+        if let Ok(hw_device) = HwDeviceContext::shared(hw) {
           // Create context from codec
           let mut ctx = Self::from_codec(codec, CodecType::Decoder)?;
           ctx.set_hw_device(hw_device);
@@ -306,6 +315,9 @@ impl CodecContext {
         codec_type,
         hw_device: None,
         hw_frames: None,
+        thread_lease: None,
+        stats: None,
+        rate_limits: (None, None),
       })
       .ok_or(CodecError::AllocationFailed("AVCodecContext"))
   }
@@ -331,25 +343,15 @@ impl CodecContext {
       ffctx_set_pix_fmt(ctx, config.pixel_format.as_raw());
 
       // Rate control based on bitrate mode
+      self.rate_limits = (config.rc_max_rate, config.rc_buffer_size);
       match config.bitrate_mode {
-        BitrateMode::Constant => {
-          // CBR: Set bitrate, rc_max_rate, and rc_buffer_size equal to bitrate
-          // VBV buffer is required for x264/x265 to properly enforce bitrate
-          ffctx_set_bit_rate(ctx, config.bitrate as i64);
-          let rc_max = config.rc_max_rate.unwrap_or(config.bitrate);
-          ffctx_set_rc_max_rate(ctx, rc_max as i64);
-          // Default buffer size to bitrate (1 second of video) if not specified
-          let buf_size = config.rc_buffer_size.unwrap_or(config.bitrate as u32);
-          ffctx_set_rc_buffer_size(ctx, buf_size as i32);
-        }
-        BitrateMode::Variable => {
-          // VBR: Set bitrate with higher rc_max_rate
-          ffctx_set_bit_rate(ctx, config.bitrate as i64);
-          let rc_max = config.rc_max_rate.unwrap_or(config.bitrate * 2);
-          ffctx_set_rc_max_rate(ctx, rc_max as i64);
-          // Default buffer size to 2x bitrate for VBR (allows more variance)
-          let buf_size = config.rc_buffer_size.unwrap_or(config.bitrate as u32 * 2);
-          ffctx_set_rc_buffer_size(ctx, buf_size as i32);
+        BitrateMode::Constant | BitrateMode::Variable => {
+          self.set_bitrate(
+            config.bitrate_mode,
+            config.bitrate,
+            config.rc_max_rate,
+            config.rc_buffer_size,
+          );
         }
         BitrateMode::Quantizer => {
           // CRF/CQ mode: Set bitrate to 0 and use CRF option
@@ -419,9 +421,11 @@ impl CodecContext {
       ffctx_set_gop_size(ctx, gop_size);
       ffctx_set_max_b_frames(ctx, max_b_frames);
 
-      // Threading
+      // Threading: explicit count, else a share of the process-wide budget
       if config.thread_count > 0 {
         ffctx_set_thread_count(ctx, config.thread_count as i32);
+      } else {
+        self.lease_threads(config.width, config.height, false);
       }
 
       // Profile and level
@@ -440,6 +444,64 @@ impl CodecContext {
     Ok(())
   }
 
+  /// Set bitrate and VBV limits for CBR/VBR rate control
+  fn set_bitrate(
+    &mut self,
+    mode: BitrateMode,
+    bitrate: u64,
+    rc_max_rate: Option<u64>,
+    rc_buffer_size: Option<u32>,
+  ) {
+    let ctx = self.ptr.as_ptr();
+    unsafe {
+      if mode == BitrateMode::Constant {
+        // CBR: Set bitrate, rc_max_rate, and rc_buffer_size equal to bitrate
+        // VBV buffer is required for x264/x265 to properly enforce bitrate
+        ffctx_set_bit_rate(ctx, bitrate as i64);
+        let rc_max = rc_max_rate.unwrap_or(bitrate);
+        ffctx_set_rc_max_rate(ctx, rc_max as i64);
+        // Default buffer size to bitrate (1 second of video) if not specified
+        let buf_size = rc_buffer_size.unwrap_or(bitrate as u32);
+        ffctx_set_rc_buffer_size(ctx, buf_size as i32);
+      } else {
+        // VBR: Set bitrate with higher rc_max_rate
+        ffctx_set_bit_rate(ctx, bitrate as i64);
+        let rc_max = rc_max_rate.unwrap_or(bitrate * 2);
+        ffctx_set_rc_max_rate(ctx, rc_max as i64);
+        // Default buffer size to 2x bitrate for VBR (allows more variance)
+        let buf_size = rc_buffer_size.unwrap_or(bitrate as u32 * 2);
+        ffctx_set_rc_buffer_size(ctx, buf_size as i32);
+      }
+    }
+  }
+
+  /// Change the target bitrate of an open encoder without reopening it
+  ///
+  /// Most FFmpeg encoders read rate control once, at open. libx264 re-checks
+  /// it before every frame and retargets in place (`x264_encoder_reconfig`),
+  /// without a keyframe. The VBV limits the encoder was configured with are
+  /// kept, so the result matches reopening with the new bitrate.
+  ///
+  /// Returns false without touching the context for other encoders, which
+  /// have to be reopened instead. That includes NVENC: it only retargets on
+  /// GPUs with dynamic bitrate support, which libavcodec doesn't expose, and
+  /// otherwise keeps the old bitrate without reporting an error. Quantizer
+  /// mode ignores the bitrate, so there is nothing to change.
+  pub fn update_bitrate(&mut self, encoder_name: &str, mode: BitrateMode, bitrate: u64) -> bool {
+    if self.codec_type != CodecType::Encoder {
+      return false;
+    }
+    if mode == BitrateMode::Quantizer {
+      return true;
+    }
+    if encoder_name != "libx264" {
+      return false;
+    }
+    let (rc_max_rate, rc_buffer_size) = self.rate_limits;
+    self.set_bitrate(mode, bitrate, rc_max_rate, rc_buffer_size);
+    true
+  }
+
   /// Enable GLOBAL_HEADER flag for the encoder.
   /// This puts codec-specific global headers (e.g., SPS/PPS for H.264) into extradata
   /// instead of embedding them in every keyframe. Required for AVCC/HVCC format output.
@@ -512,6 +574,11 @@ impl CodecContext {
   /// - preset=medium (quality) / veryfast (realtime): Speed preset
   /// - look_ahead=1 (quality) / 0 (realtime): Enable look-ahead for better quality
   pub fn apply_hw_encoder_options(&mut self, encoder_name: &str, realtime: bool) {
+    // Hardware encoders don't run libavcodec threads; give the budget back
+    if self.thread_lease.take().is_some() {
+      unsafe { ffctx_set_thread_count(self.ptr.as_ptr(), 0) };
+    }
+
     unsafe {
       let ctx = self.ptr.as_ptr() as *mut std::ffi::c_void;
 
@@ -647,6 +714,13 @@ impl CodecContext {
   /// - usage=realtime for realtime mode
   /// - row-mt=1 (enable row-level multi-threading)
   pub fn apply_sw_encoder_options(&mut self, encoder_name: &str, realtime: bool) {
+    // Realtime encoders split frames across slice threads instead of adding
+    // a frame of delay per thread
+    if let Some(lease) = self.thread_lease.as_mut() {
+      lease.set_low_latency(realtime);
+      unsafe { ffctx_set_thread_type(self.ptr.as_ptr(), lease.thread_type()) };
+    }
+
     unsafe {
       let ctx = self.ptr.as_ptr() as *mut std::ffi::c_void;
 
@@ -826,9 +900,14 @@ impl CodecContext {
           ffctx_set_thread_type(ctx, 0);
         }
       } else {
-        // Auto-detect thread count for software decoders
-        tracing::debug!(target: "webcodecs", "configure_decoder: using auto-detect thread_count=0");
+        // Software decoders take their share of the process-wide budget,
+        // or auto-detect when the budget is disabled
         ffctx_set_thread_count(ctx, 0);
+        self.lease_threads(
+          config.width.unwrap_or(0),
+          config.height.unwrap_or(0),
+          config.low_latency,
+        );
       }
 
       // Set decoder flags
@@ -851,9 +930,20 @@ impl CodecContext {
 
       // Set flags2: SHOW_ALL ensures all frames are output including B-frames
       // that might otherwise be held back due to recovery state
-      let flags2 = ffi::accessors::codec_flag2::SHOW_ALL;
+      let mut flags2 = ffi::accessors::codec_flag2::SHOW_ALL;
+      if config.fast {
+        flags2 |= ffi::accessors::codec_flag2::FAST;
+      }
       ffi::accessors::ffctx_set_flags2(ctx, flags2);
 
+      // Discard levels for keyframe-only / non-reference-skipping decode
+      if config.skip_frame != ffi::accessors::discard::DEFAULT {
+        ffi::accessors::ffctx_set_skip_frame(ctx, config.skip_frame);
+      }
+      if config.skip_loop_filter != ffi::accessors::discard::DEFAULT {
+        ffi::accessors::ffctx_set_skip_loop_filter(ctx, config.skip_loop_filter);
+      }
+
       // For H.264 and HEVC, set has_b_frames BEFORE opening the codec
       // This tells the decoder to allocate a proper reorder buffer for B-frames.
       // Without this, the decoder may drop frames when reordering is needed.
@@ -872,6 +962,26 @@ impl CodecContext {
         ffctx_set_height(ctx, h as i32);
       }
 
+      // Reduced-resolution decode (e.g. JPEG DCT downscaling). Decoders without
+      // support report max_lowres = 0 and keep decoding at full size.
+      if config.lowres > 0 {
+        let lowres =
+          (config.lowres as i32).min(ffi::accessors::ff_codec_get_max_lowres(self.codec));
+        if lowres > 0 {
+          ffi::accessors::ffctx_set_lowres(ctx, lowres);
+        }
+      }
+
+      // Room in the hardware surface pool for frames kept GPU-resident
+      if config.extra_hw_frames > 0 {
+        av_opt_set_int(
+          ctx as *mut std::ffi::c_void,
+          c"extra_hw_frames".as_ptr(),
+          config.extra_hw_frames as i64,
+          0,
+        );
+      }
+
       // Set extradata if provided (e.g., SPS/PPS for H.264, VPS/SPS/PPS for HEVC)
       // This is critical for hardware decoding - without extradata, the decoder
       // cannot determine stream parameters and may fail to produce output.
@@ -892,6 +1002,19 @@ impl CodecContext {
     Ok(())
   }
 
+  /// Record send/receive timings in `stats` from now on
+  pub fn set_stats(&mut self, stats: Arc<CodecStats>) {
+    self.stats = Some(stats);
+  }
+
+  /// Run `f` as one `stage` operation when stats are attached
+  fn timed<R>(&self, stage: Stage, f: impl FnOnce() -> R) -> R {
+    match &self.stats {
+      Some(stats) => stats.time(stage, f),
+      None => f(),
+    }
+  }
+
   /// Set hardware device context for hardware-accelerated encoding/decoding
   pub fn set_hw_device(&mut self, hw_device: HwDeviceContext) {
     unsafe {
@@ -919,6 +1042,25 @@ impl CodecContext {
     self.hw_frames = Some(hw_frames);
   }
 
+  /// Take this context's thread count from the process-wide budget
+  ///
+  /// Leaves libavcodec's automatic thread count when the budget is disabled.
+  fn lease_threads(&mut self, width: u32, height: u32, low_latency: bool) {
+    let codec_id = AVCodecID::from_raw(unsafe { ff_codec_get_id(self.codec) });
+    self.thread_lease = thread_budget::lease(ThreadWorkload {
+      codec_id,
+      width,
+      height,
+      low_latency,
+    });
+    if let Some(lease) = &self.thread_lease {
+      unsafe {
+        ffctx_set_thread_count(self.ptr.as_ptr(), lease.thread_count());
+        ffctx_set_thread_type(self.ptr.as_ptr(), lease.thread_type());
+      }
+    }
+  }
+
   /// Open the codec (must be called after configuration)
   pub fn open(&mut self) -> CodecResult<()> {
     let ret = unsafe { avcodec_open2(self.ptr.as_ptr(), self.codec, std::ptr::null_mut()) };
@@ -935,7 +1077,9 @@ impl CodecContext {
   /// Returns Ok(true) if frame was accepted, Ok(false) if encoder needs output drained first
   pub fn send_frame(&mut self, frame: Option<&Frame>) -> CodecResult<bool> {
     let frame_ptr = frame.map(|f| f.as_ptr()).unwrap_or(std::ptr::null());
-    let ret = unsafe { avcodec_send_frame(self.ptr.as_ptr(), frame_ptr) };
+    let ret = self.timed(Stage::Send, || unsafe {
+      avcodec_send_frame(self.ptr.as_ptr(), frame_ptr)
+    });
 
     if ret == AVERROR_EAGAIN {
       return Ok(false);
@@ -949,7 +1093,9 @@ impl CodecContext {
   /// Returns Ok(Some(packet)) if a packet is available, Ok(None) if more input needed
   pub fn receive_packet(&mut self) -> CodecResult<Option<Packet>> {
     let mut pkt = Packet::new()?;
-    let ret = unsafe { avcodec_receive_packet(self.ptr.as_ptr(), pkt.as_mut_ptr()) };
+    let ret = self.timed(Stage::Receive, || unsafe {
+      avcodec_receive_packet(self.ptr.as_ptr(), pkt.as_mut_ptr())
+    });
 
     if ret == AVERROR_EAGAIN || ret == AVERROR_EOF {
       return Ok(None);
@@ -994,7 +1140,9 @@ impl CodecContext {
   /// Returns Ok(true) if packet was accepted, Ok(false) if decoder needs output drained first
   pub fn send_packet(&mut self, packet: Option<&Packet>) -> CodecResult<bool> {
     let pkt_ptr = packet.map(|p| p.as_ptr()).unwrap_or(std::ptr::null());
-    let ret = unsafe { avcodec_send_packet(self.ptr.as_ptr(), pkt_ptr) };
+    let ret = self.timed(Stage::Send, || unsafe {
+      avcodec_send_packet(self.ptr.as_ptr(), pkt_ptr)
+    });
 
     if ret == AVERROR_EAGAIN {
       tracing::debug!("send_packet: EAGAIN");
@@ -1013,7 +1161,9 @@ impl CodecContext {
   /// Returns ReceiveResult indicating success, need for more input, or end of stream
   pub fn receive_frame_with_status(&mut self) -> CodecResult<ReceiveResult<Frame>> {
     let mut frame = Frame::new()?;
-    let ret = unsafe { avcodec_receive_frame(self.ptr.as_ptr(), frame.as_mut_ptr()) };
+    let ret = self.timed(Stage::Receive, || unsafe {
+      avcodec_receive_frame(self.ptr.as_ptr(), frame.as_mut_ptr())
+    });
 
     if ret == AVERROR_EAGAIN {
       return Ok(ReceiveResult::NeedMoreInput);
@@ -1022,6 +1172,7 @@ impl CodecContext {
       return Ok(ReceiveResult::EndOfStream);
     }
     ffi::check_error(ret)?;
+    frame.track_memory();
     tracing::debug!(
       "receive_frame_with_status: got frame! pts={}, format={:?}",
       frame.pts(),
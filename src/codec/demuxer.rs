@@ -4,23 +4,29 @@
 
 use super::CodecError;
 use super::avio_context::CustomIOContext;
-use super::io_buffer::BufferSource;
+use super::io_buffer::{BufferSource, StreamingReadBuffer};
+use super::seek_index::{SeekIndex, SeekIndexEntry, SeekIndexFingerprint, StreamSeekIndex};
 use crate::ffi::accessors::{
   ffcodecpar_get_channels, ffcodecpar_get_codec_id, ffcodecpar_get_codec_type,
   ffcodecpar_get_extradata, ffcodecpar_get_extradata_size, ffcodecpar_get_format,
   ffcodecpar_get_height, ffcodecpar_get_sample_rate, ffcodecpar_get_width, fffmt_get_duration,
-  fffmt_get_nb_streams, fffmt_get_stream, fffmt_set_pb, ffstream_get_codecpar_const,
-  ffstream_get_duration, ffstream_get_index, ffstream_get_time_base,
+  fffmt_get_nb_streams, fffmt_get_pb, fffmt_get_stream, fffmt_set_pb, ffstream_add_index_entry,
+  ffstream_get_codecpar_const, ffstream_get_duration, ffstream_get_index,
+  ffstream_get_index_entries_count, ffstream_get_index_entry, ffstream_get_time_base,
 };
 use crate::ffi::avformat::{
   AVFormatContext, av_find_best_stream, av_read_frame, av_seek_frame, avformat_close_input,
-  avformat_find_stream_info, avformat_free_context, avformat_open_input, media_type, seek_flag,
+  avformat_find_stream_info, avformat_free_context, avformat_open_input, avio_size, media_type,
+  seek_flag,
 };
 use crate::ffi::{AVCodecID, AVPixelFormat, AVSampleFormat};
 use std::ffi::CString;
 use std::os::raw::c_int;
 use std::ptr::{self, NonNull};
 
+/// AVINDEX_KEYFRAME - index entry points at a keyframe
+const AVINDEX_KEYFRAME: c_int = 1;
+
 /// Media type for stream identification
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum MediaType {
@@ -131,7 +137,23 @@ impl DemuxerContext {
   pub fn open_buffer(source: impl BufferSource + 'static) -> Result<Self, CodecError> {
     // Create custom I/O context for reading
     let custom_io = CustomIOContext::new_buffer_read(source).map_err(CodecError::InvalidConfig)?;
+    Self::open_custom_io(custom_io)
+  }
+
+  /// Open a streaming source for demuxing
+  ///
+  /// Reads block until the buffer's feeder pushes more data, so this returns
+  /// as soon as enough of the stream has arrived to parse the headers. The
+  /// input is not seekable: containers must have their index up front
+  /// (fragmented or faststart MP4, WebM, MKV).
+  pub fn open_stream(source: StreamingReadBuffer) -> Result<Self, CodecError> {
+    let custom_io =
+      CustomIOContext::new_streaming_read(source).map_err(CodecError::InvalidConfig)?;
+    Self::open_custom_io(custom_io)
+  }
 
+  /// Open input through a custom I/O context
+  fn open_custom_io(custom_io: CustomIOContext) -> Result<Self, CodecError> {
     // Allocate format context
     let ctx_ptr = unsafe {
       let ptr = crate::ffi::avformat::avformat_alloc_context();
@@ -350,6 +372,123 @@ impl DemuxerContext {
     Ok(())
   }
 
+  /// Read the whole container once so FFmpeg indexes every keyframe, then
+  /// rewind to the first indexed keyframe
+  ///
+  /// Containers without an up-front index (MKV/WebM without cues) only learn
+  /// keyframe positions as they are read; afterwards `seek_index()` covers
+  /// the full file.
+  pub fn build_index(&mut self) -> Result<(), CodecError> {
+    while self.read_packet()?.is_some() {}
+
+    let first = self
+      .seek_index()
+      .streams
+      .into_iter()
+      .find_map(|s| s.entries.first().map(|e| (s.stream_index, e.timestamp)));
+    match first {
+      Some((stream_index, timestamp)) => self.seek(stream_index, timestamp, true),
+      None => self.seek(-1, 0, true),
+    }
+  }
+
+  /// Size, duration and stream count identifying this input
+  pub fn seek_index_fingerprint(&self) -> SeekIndexFingerprint {
+    let pb = unsafe { fffmt_get_pb(self.ptr.as_ptr()) };
+    let file_size = if pb.is_null() {
+      -1
+    } else {
+      unsafe { avio_size(pb) }.max(-1)
+    };
+    SeekIndexFingerprint {
+      file_size,
+      duration: self.duration_us().unwrap_or(0),
+      stream_count: self.streams.len() as u32,
+    }
+  }
+
+  /// Snapshot FFmpeg's keyframe index for every stream
+  pub fn seek_index(&self) -> SeekIndex {
+    let mut index = SeekIndex {
+      fingerprint: self.seek_index_fingerprint(),
+      ..Default::default()
+    };
+
+    for info in &self.streams {
+      let stream = unsafe { fffmt_get_stream(self.ptr.as_ptr(), info.index as u32) };
+      if stream.is_null() {
+        continue;
+      }
+
+      let count = unsafe { ffstream_get_index_entries_count(stream) };
+      let mut entries = Vec::with_capacity(count.max(0) as usize);
+      for i in 0..count {
+        let (mut pos, mut timestamp, mut flags) = (0i64, 0i64, 0 as c_int);
+        let ret =
+          unsafe { ffstream_get_index_entry(stream, i, &mut pos, &mut timestamp, &mut flags) };
+        if ret >= 0 && flags & AVINDEX_KEYFRAME != 0 {
+          entries.push(SeekIndexEntry { timestamp, pos });
+        }
+      }
+
+      index.streams.push(StreamSeekIndex {
+        stream_index: info.index,
+        codec_id: info.codec_id as i32,
+        time_base: info.time_base,
+        entries,
+      });
+    }
+
+    index
+  }
+
+  /// Extend FFmpeg's keyframe index with a previously exported one
+  ///
+  /// Only entries past the last one FFmpeg already knows are added, so an
+  /// index the container loaded itself (MP4 moov, MKV cues) is never
+  /// reshuffled. Returns the number of entries added.
+  pub fn import_seek_index(&mut self, index: &SeekIndex) -> Result<usize, CodecError> {
+    let mismatch = || CodecError::InvalidConfig("Seek index does not match this file".to_string());
+
+    // Validate everything before touching FFmpeg's index
+    if index.fingerprint != self.seek_index_fingerprint() {
+      return Err(mismatch());
+    }
+    for indexed in &index.streams {
+      let info = self.get_stream(indexed.stream_index).ok_or_else(mismatch)?;
+      if info.codec_id as i32 != indexed.codec_id || info.time_base != indexed.time_base {
+        return Err(mismatch());
+      }
+    }
+
+    let mut added = 0;
+    for indexed in &index.streams {
+      let stream = unsafe { fffmt_get_stream(self.ptr.as_ptr(), indexed.stream_index as u32) };
+      if stream.is_null() {
+        continue;
+      }
+
+      let count = unsafe { ffstream_get_index_entries_count(stream) };
+      let mut last_known = i64::MIN;
+      if count > 0 {
+        let (mut pos, mut flags) = (0i64, 0 as c_int);
+        unsafe {
+          ffstream_get_index_entry(stream, count - 1, &mut pos, &mut last_known, &mut flags)
+        };
+      }
+
+      for entry in indexed.entries.iter().filter(|e| e.timestamp > last_known) {
+        let ret =
+          unsafe { ffstream_add_index_entry(stream, entry.pos, entry.timestamp, AVINDEX_KEYFRAME) };
+        if ret >= 0 {
+          added += 1;
+        }
+      }
+    }
+
+    Ok(added)
+  }
+
   /// Get the container duration in AV_TIME_BASE units (microseconds)
   pub fn duration_us(&self) -> Option<i64> {
     let duration = unsafe { fffmt_get_duration(self.ptr.as_ptr()) };
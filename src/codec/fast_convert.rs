@@ -0,0 +1,554 @@
+//! Fast paths for same-size RGBA/BGRA ↔ I420/NV12 conversion
+//!
+//! These four conversions dominate `VideoFrame.copyTo({ format })` and the
+//! encoder input path, and swscale runs them through its generic scaler even
+//! when nothing is resized. The kernels here convert row by row with
+//! fixed-point BT.601 limited-range math, the matrix swscale applies to these
+//! formats by default, so `Scaler` can use them transparently.
+//!
+//! The row kernels are plain Rust written so LLVM can vectorize them. On
+//! x86_64 they are also compiled with AVX2 enabled and that variant is picked
+//! at runtime when the CPU supports it; on aarch64 NEON is part of the
+//! baseline, so the default build already vectorizes with it.
+
+use std::sync::OnceLock;
+
+use crate::ffi::AVPixelFormat;
+
+use super::Frame;
+
+/// Instruction set the conversion kernels run with
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum SimdLevel {
+  /// Baseline target features only
+  Scalar,
+  /// x86_64 AVX2 kernels
+  Avx2,
+  /// aarch64 NEON (baseline on that target)
+  Neon,
+}
+
+/// Get the instruction set detected for this CPU (cached after the first call)
+pub fn simd_level() -> SimdLevel {
+  static LEVEL: OnceLock<SimdLevel> = OnceLock::new();
+  *LEVEL.get_or_init(detect_simd_level)
+}
+
+fn detect_simd_level() -> SimdLevel {
+  #[cfg(target_arch = "x86_64")]
+  {
+    if std::arch::is_x86_feature_detected!("avx2") {
+      return SimdLevel::Avx2;
+    }
+  }
+  if cfg!(target_arch = "aarch64") {
+    SimdLevel::Neon
+  } else {
+    SimdLevel::Scalar
+  }
+}
+
+/// Byte order of a packed 32-bit RGB format
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum RgbOrder {
+  Rgba,
+  Bgra,
+}
+
+/// Chroma layout of a 4:2:0 YUV format
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum YuvLayout {
+  /// Separate U and V planes
+  I420,
+  /// Interleaved UV plane
+  Nv12,
+}
+
+/// Run a kernel with the best instruction set available
+///
+/// On x86_64 the kernel is instantiated a second time inside an
+/// `avx2`-enabled function so its inlined row loops are vectorized with AVX2.
+#[cfg(target_arch = "x86_64")]
+macro_rules! run_kernel {
+  ($kernel:ident::<$($arg:expr),*>, $planes:expr) => {{
+    #[target_feature(enable = "avx2")]
+    unsafe fn kernel_avx2(planes: &Planes) {
+      unsafe { $kernel::<$({ $arg }),*>(planes) }
+    }
+    if simd_level() == SimdLevel::Avx2 {
+      unsafe { kernel_avx2($planes) }
+    } else {
+      unsafe { $kernel::<$({ $arg }),*>($planes) }
+    }
+  }};
+}
+
+#[cfg(not(target_arch = "x86_64"))]
+macro_rules! run_kernel {
+  ($kernel:ident::<$($arg:expr),*>, $planes:expr) => {
+    unsafe { $kernel::<$({ $arg }),*>($planes) }
+  };
+}
+
+/// A same-size conversion with a dedicated kernel
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct FastConversion {
+  src_format: AVPixelFormat,
+  dst_format: AVPixelFormat,
+  direction: Direction,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Direction {
+  RgbToYuv(RgbOrder, YuvLayout),
+  YuvToRgb(YuvLayout, RgbOrder),
+}
+
+impl FastConversion {
+  /// Find a fast kernel for `src` → `dst` (same dimensions), if one exists
+  pub fn for_formats(src: AVPixelFormat, dst: AVPixelFormat) -> Option<Self> {
+    let rgb = |format| match format {
+      AVPixelFormat::Rgba => Some(RgbOrder::Rgba),
+      AVPixelFormat::Bgra => Some(RgbOrder::Bgra),
+      _ => None,
+    };
+    let yuv = |format| match format {
+      AVPixelFormat::Yuv420p => Some(YuvLayout::I420),
+      AVPixelFormat::Nv12 => Some(YuvLayout::Nv12),
+      _ => None,
+    };
+
+    let direction = if let (Some(order), Some(layout)) = (rgb(src), yuv(dst)) {
+      Direction::RgbToYuv(order, layout)
+    } else if let (Some(layout), Some(order)) = (yuv(src), rgb(dst)) {
+      Direction::YuvToRgb(layout, order)
+    } else {
+      return None;
+    };
+    Some(Self {
+      src_format: src,
+      dst_format: dst,
+      direction,
+    })
+  }
+
+  /// Convert `src` into the already-allocated `dst`
+  ///
+  /// Returns `false` without touching `dst` when the frames don't fit the
+  /// kernel (other formats, mismatched geometry, missing planes, negative
+  /// strides); the caller should fall back to swscale.
+  pub fn convert(&self, src: &Frame, dst: &mut Frame) -> bool {
+    if src.format() != self.src_format || dst.format() != self.dst_format {
+      return false;
+    }
+    let (src_planes, dst_planes) = match self.direction {
+      Direction::RgbToYuv(_, layout) => (1, layout.plane_count()),
+      Direction::YuvToRgb(layout, _) => (layout.plane_count(), 1),
+    };
+    let Some(planes) = Planes::new(src, src_planes, dst, dst_planes) else {
+      return false;
+    };
+
+    // SAFETY: `Planes::new` checked every plane pointer and stride against
+    // the frame geometry.
+    match self.direction {
+      Direction::RgbToYuv(RgbOrder::Rgba, YuvLayout::I420) => {
+        run_kernel!(rgb_to_yuv::<0, 2, false>, &planes)
+      }
+      Direction::RgbToYuv(RgbOrder::Rgba, YuvLayout::Nv12) => {
+        run_kernel!(rgb_to_yuv::<0, 2, true>, &planes)
+      }
+      Direction::RgbToYuv(RgbOrder::Bgra, YuvLayout::I420) => {
+        run_kernel!(rgb_to_yuv::<2, 0, false>, &planes)
+      }
+      Direction::RgbToYuv(RgbOrder::Bgra, YuvLayout::Nv12) => {
+        run_kernel!(rgb_to_yuv::<2, 0, true>, &planes)
+      }
+      Direction::YuvToRgb(YuvLayout::I420, RgbOrder::Rgba) => {
+        run_kernel!(yuv_to_rgb::<0, 2, false>, &planes)
+      }
+      Direction::YuvToRgb(YuvLayout::Nv12, RgbOrder::Rgba) => {
+        run_kernel!(yuv_to_rgb::<0, 2, true>, &planes)
+      }
+      Direction::YuvToRgb(YuvLayout::I420, RgbOrder::Bgra) => {
+        run_kernel!(yuv_to_rgb::<2, 0, false>, &planes)
+      }
+      Direction::YuvToRgb(YuvLayout::Nv12, RgbOrder::Bgra) => {
+        run_kernel!(yuv_to_rgb::<2, 0, true>, &planes)
+      }
+    }
+    true
+  }
+}
+
+impl YuvLayout {
+  fn plane_count(self) -> usize {
+    match self {
+      YuvLayout::I420 => 3,
+      YuvLayout::Nv12 => 2,
+    }
+  }
+}
+
+/// Validated plane pointers and strides for one conversion
+struct Planes {
+  src: [*const u8; 3],
+  src_stride: [usize; 3],
+  dst: [*mut u8; 3],
+  dst_stride: [usize; 3],
+  width: usize,
+  height: usize,
+}
+
+impl Planes {
+  fn new(src: &Frame, src_planes: usize, dst: &mut Frame, dst_planes: usize) -> Option<Self> {
+    if src.width() != dst.width() || src.height() != dst.height() {
+      return None;
+    }
+    let width = src.width() as usize;
+    let height = src.height() as usize;
+    if width == 0 || height == 0 {
+      return None;
+    }
+
+    let mut planes = Self {
+      src: [std::ptr::null(); 3],
+      src_stride: [0; 3],
+      dst: [std::ptr::null_mut(); 3],
+      dst_stride: [0; 3],
+      width,
+      height,
+    };
+    // The single plane of a packed RGB frame, or the Y plane, is full width;
+    // chroma planes are half width (NV12 interleaves two bytes per sample).
+    let row_bytes = |plane: usize, planes_in_frame: usize| match (planes_in_frame, plane) {
+      (1, _) => width * 4,
+      (_, 0) => width,
+      (2, _) => width.div_ceil(2) * 2,
+      _ => width.div_ceil(2),
+    };
+
+    for plane in 0..src_planes {
+      let stride = usize::try_from(src.linesize(plane)).ok()?;
+      if src.data(plane).is_null() || stride < row_bytes(plane, src_planes) {
+        return None;
+      }
+      planes.src[plane] = src.data(plane);
+      planes.src_stride[plane] = stride;
+    }
+    for plane in 0..dst_planes {
+      let stride = usize::try_from(dst.linesize(plane)).ok()?;
+      let data = dst.data_mut(plane);
+      if data.is_null() || stride < row_bytes(plane, dst_planes) {
+        return None;
+      }
+      planes.dst[plane] = data;
+      planes.dst_stride[plane] = stride;
+    }
+    Some(planes)
+  }
+}
+
+/// Borrow row `y` of a plane
+///
+/// # Safety
+/// The plane must hold at least `y + 1` rows of `stride` bytes and `len <= stride`.
+#[inline(always)]
+unsafe fn plane_row<'a>(data: *const u8, stride: usize, y: usize, len: usize) -> &'a [u8] {
+  unsafe { std::slice::from_raw_parts(data.add(y * stride), len) }
+}
+
+/// Mutably borrow row `y` of a plane (same requirements as `plane_row`)
+#[inline(always)]
+unsafe fn plane_row_mut<'a>(data: *mut u8, stride: usize, y: usize, len: usize) -> &'a mut [u8] {
+  unsafe { std::slice::from_raw_parts_mut(data.add(y * stride), len) }
+}
+
+// ============================================================================
+// RGB → YUV
+// ============================================================================
+
+#[inline(always)]
+fn rgb_pixel<const R: usize, const B: usize>(px: &[u8]) -> (i32, i32, i32) {
+  (px[R] as i32, px[1] as i32, px[B] as i32)
+}
+
+#[inline(always)]
+fn luma(r: i32, g: i32, b: i32) -> u8 {
+  (((66 * r + 129 * g + 25 * b + 128) >> 8) + 16) as u8
+}
+
+#[inline(always)]
+fn chroma(r: i32, g: i32, b: i32) -> (u8, u8) {
+  let u = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+  let v = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+  (u as u8, v as u8)
+}
+
+#[inline(always)]
+fn store_chroma<const NV12: bool>(u: &mut [u8], v: &mut [u8], x: usize, cu: u8, cv: u8) {
+  if NV12 {
+    u[2 * x] = cu;
+    u[2 * x + 1] = cv;
+  } else {
+    u[x] = cu;
+    v[x] = cv;
+  }
+}
+
+/// Convert two RGB rows into two luma rows and one (subsampled) chroma row
+#[inline(always)]
+#[allow(clippy::too_many_arguments)]
+fn rgb_to_yuv_rows<const R: usize, const B: usize, const NV12: bool>(
+  rgb0: &[u8],
+  rgb1: &[u8],
+  y0: &mut [u8],
+  y1: &mut [u8],
+  u: &mut [u8],
+  v: &mut [u8],
+  width: usize,
+) {
+  for x in 0..width / 2 {
+    let i = x * 8;
+    let (r00, g00, b00) = rgb_pixel::<R, B>(&rgb0[i..i + 4]);
+    let (r01, g01, b01) = rgb_pixel::<R, B>(&rgb0[i + 4..i + 8]);
+    let (r10, g10, b10) = rgb_pixel::<R, B>(&rgb1[i..i + 4]);
+    let (r11, g11, b11) = rgb_pixel::<R, B>(&rgb1[i + 4..i + 8]);
+
+    y0[2 * x] = luma(r00, g00, b00);
+    y0[2 * x + 1] = luma(r01, g01, b01);
+    y1[2 * x] = luma(r10, g10, b10);
+    y1[2 * x + 1] = luma(r11, g11, b11);
+
+    let (cu, cv) = chroma(
+      (r00 + r01 + r10 + r11 + 2) >> 2,
+      (g00 + g01 + g10 + g11 + 2) >> 2,
+      (b00 + b01 + b10 + b11 + 2) >> 2,
+    );
+    store_chroma::<NV12>(u, v, x, cu, cv);
+  }
+
+  if width % 2 == 1 {
+    let x = width / 2;
+    let i = x * 8;
+    let (r0, g0, b0) = rgb_pixel::<R, B>(&rgb0[i..i + 4]);
+    let (r1, g1, b1) = rgb_pixel::<R, B>(&rgb1[i..i + 4]);
+    y0[2 * x] = luma(r0, g0, b0);
+    y1[2 * x] = luma(r1, g1, b1);
+    let (cu, cv) = chroma((r0 + r1 + 1) >> 1, (g0 + g1 + 1) >> 1, (b0 + b1 + 1) >> 1);
+    store_chroma::<NV12>(u, v, x, cu, cv);
+  }
+}
+
+/// # Safety
+/// `planes` must describe a packed RGB source and an I420/NV12 destination.
+#[inline(always)]
+unsafe fn rgb_to_yuv<const R: usize, const B: usize, const NV12: bool>(planes: &Planes) {
+  let (width, height) = (planes.width, planes.height);
+  let chroma_width = width.div_ceil(2);
+  // The last luma row of an odd-height frame has no partner row; its
+  // chroma is taken from the row alone and the second luma row discarded.
+  let mut spare_row = if height % 2 == 1 {
+    vec![0u8; width]
+  } else {
+    Vec::new()
+  };
+
+  for y in (0..height).step_by(2) {
+    let has_pair = y + 1 < height;
+    unsafe {
+      let rgb0 = plane_row(planes.src[0], planes.src_stride[0], y, width * 4);
+      let rgb1 = if has_pair {
+        plane_row(planes.src[0], planes.src_stride[0], y + 1, width * 4)
+      } else {
+        rgb0
+      };
+      let y0 = plane_row_mut(planes.dst[0], planes.dst_stride[0], y, width);
+      let y1 = if has_pair {
+        plane_row_mut(planes.dst[0], planes.dst_stride[0], y + 1, width)
+      } else {
+        spare_row.as_mut_slice()
+      };
+      let (u, v): (&mut [u8], &mut [u8]) = if NV12 {
+        let uv = plane_row_mut(planes.dst[1], planes.dst_stride[1], y / 2, chroma_width * 2);
+        (uv, &mut [])
+      } else {
+        (
+          plane_row_mut(planes.dst[1], planes.dst_stride[1], y / 2, chroma_width),
+          plane_row_mut(planes.dst[2], planes.dst_stride[2], y / 2, chroma_width),
+        )
+      };
+      rgb_to_yuv_rows::<R, B, NV12>(rgb0, rgb1, y0, y1, u, v, width);
+    }
+  }
+}
+
+// ============================================================================
+// YUV → RGB
+// ============================================================================
+
+#[inline(always)]
+fn clamp_u8(value: i32) -> u8 {
+  value.clamp(0, 255) as u8
+}
+
+/// Convert one luma row and its chroma row into packed RGB (alpha = 255)
+#[inline(always)]
+fn yuv_to_rgb_row<const R: usize, const B: usize, const NV12: bool>(
+  luma: &[u8],
+  u: &[u8],
+  v: &[u8],
+  rgb: &mut [u8],
+  width: usize,
+) {
+  for x in 0..width {
+    let (cu, cv) = if NV12 {
+      (u[(x / 2) * 2], u[(x / 2) * 2 + 1])
+    } else {
+      (u[x / 2], v[x / 2])
+    };
+    let c = (luma[x] as i32 - 16) * 298;
+    let d = cu as i32 - 128;
+    let e = cv as i32 - 128;
+
+    let px = &mut rgb[x * 4..x * 4 + 4];
+    px[R] = clamp_u8((c + 409 * e + 128) >> 8);
+    px[1] = clamp_u8((c - 100 * d - 208 * e + 128) >> 8);
+    px[B] = clamp_u8((c + 516 * d + 128) >> 8);
+    px[3] = 255;
+  }
+}
+
+/// # Safety
+/// `planes` must describe an I420/NV12 source and a packed RGB destination.
+#[inline(always)]
+unsafe fn yuv_to_rgb<const R: usize, const B: usize, const NV12: bool>(planes: &Planes) {
+  let (width, height) = (planes.width, planes.height);
+  let chroma_width = width.div_ceil(2);
+
+  for y in 0..height {
+    unsafe {
+      let luma = plane_row(planes.src[0], planes.src_stride[0], y, width);
+      let (u, v): (&[u8], &[u8]) = if NV12 {
+        let uv = plane_row(planes.src[1], planes.src_stride[1], y / 2, chroma_width * 2);
+        (uv, &[])
+      } else {
+        (
+          plane_row(planes.src[1], planes.src_stride[1], y / 2, chroma_width),
+          plane_row(planes.src[2], planes.src_stride[2], y / 2, chroma_width),
+        )
+      };
+      let rgb = plane_row_mut(planes.dst[0], planes.dst_stride[0], y, width * 4);
+      yuv_to_rgb_row::<R, B, NV12>(luma, u, v, rgb, width);
+    }
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn fill_rgba(frame: &mut Frame, pixel: impl Fn(u32, u32) -> [u8; 4]) {
+    let stride = frame.linesize(0) as usize;
+    let data = frame.data_mut(0);
+    for y in 0..frame.height() {
+      for x in 0..frame.width() {
+        let px = pixel(x, y);
+        let offset = y as usize * stride + x as usize * 4;
+        unsafe { std::ptr::copy_nonoverlapping(px.as_ptr(), data.add(offset), 4) };
+      }
+    }
+  }
+
+  fn read(frame: &Frame, plane: usize, x: usize, y: usize) -> u8 {
+    let stride = frame.linesize(plane) as usize;
+    unsafe { *frame.data(plane).add(y * stride + x) }
+  }
+
+  fn convert(src: &Frame, format: AVPixelFormat) -> Frame {
+    let mut dst = Frame::new_video(src.width(), src.height(), format).unwrap();
+    let fast = FastConversion::for_formats(src.format(), format).unwrap();
+    assert!(fast.convert(src, &mut dst));
+    dst
+  }
+
+  #[test]
+  fn test_only_rgb_yuv_pairs_have_fast_paths() {
+    assert!(FastConversion::for_formats(AVPixelFormat::Rgba, AVPixelFormat::Yuv420p).is_some());
+    assert!(FastConversion::for_formats(AVPixelFormat::Nv12, AVPixelFormat::Bgra).is_some());
+    assert!(FastConversion::for_formats(AVPixelFormat::Rgba, AVPixelFormat::Bgra).is_none());
+    assert!(FastConversion::for_formats(AVPixelFormat::Yuv420p, AVPixelFormat::Nv12).is_none());
+  }
+
+  #[test]
+  fn test_rgba_to_i420_bt601_limited() {
+    let mut src = Frame::new_video(4, 2, AVPixelFormat::Rgba).unwrap();
+    fill_rgba(&mut src, |x, _| match x {
+      0 | 1 => [255, 255, 255, 255],
+      _ => [0, 0, 0, 255],
+    });
+    let dst = convert(&src, AVPixelFormat::Yuv420p);
+
+    assert_eq!(read(&dst, 0, 0, 0), 235);
+    assert_eq!(read(&dst, 0, 3, 1), 16);
+    assert_eq!(read(&dst, 1, 0, 0), 128);
+    assert_eq!(read(&dst, 2, 1, 0), 128);
+  }
+
+  #[test]
+  fn test_nv12_matches_i420_chroma() {
+    let mut src = Frame::new_video(7, 5, AVPixelFormat::Bgra).unwrap();
+    fill_rgba(&mut src, |x, y| [(x * 30) as u8, (y * 50) as u8, 200, 255]);
+    let i420 = convert(&src, AVPixelFormat::Yuv420p);
+    let nv12 = convert(&src, AVPixelFormat::Nv12);
+
+    for y in 0..5 {
+      for x in 0..7 {
+        assert_eq!(read(&i420, 0, x, y), read(&nv12, 0, x, y));
+      }
+    }
+    for y in 0..3 {
+      for x in 0..4 {
+        assert_eq!(read(&i420, 1, x, y), read(&nv12, 1, 2 * x, y));
+        assert_eq!(read(&i420, 2, x, y), read(&nv12, 1, 2 * x + 1, y));
+      }
+    }
+  }
+
+  #[test]
+  fn test_round_trip_within_tolerance() {
+    let mut src = Frame::new_video(16, 16, AVPixelFormat::Rgba).unwrap();
+    // Flat 2x2 blocks so chroma subsampling is lossless
+    fill_rgba(&mut src, |x, y| {
+      [
+        (x / 2 * 32) as u8,
+        (y / 2 * 32) as u8,
+        ((x / 2 + y / 2) * 16) as u8,
+        255,
+      ]
+    });
+    let yuv = convert(&src, AVPixelFormat::Nv12);
+    let back = convert(&yuv, AVPixelFormat::Rgba);
+
+    for y in 0..16 {
+      for x in 0..16 {
+        for c in 0..4 {
+          let a = read(&src, 0, x * 4 + c, y) as i32;
+          let b = read(&back, 0, x * 4 + c, y) as i32;
+          assert!(
+            (a - b).abs() <= 3,
+            "pixel ({x},{y}) channel {c}: {a} vs {b}"
+          );
+        }
+      }
+    }
+  }
+
+  #[test]
+  fn test_rejects_mismatched_frames() {
+    let src = Frame::new_video(8, 8, AVPixelFormat::Rgba).unwrap();
+    let mut dst = Frame::new_video(4, 4, AVPixelFormat::Yuv420p).unwrap();
+    let fast = FastConversion::for_formats(AVPixelFormat::Rgba, AVPixelFormat::Yuv420p).unwrap();
+    assert!(!fast.convert(&src, &mut dst));
+  }
+}
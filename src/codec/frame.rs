@@ -26,16 +26,20 @@ use crate::ffi::{
     ffframe_get_quality,
     ffframe_get_sample_rate,
     ffframe_get_width,
+    ffframe_has_buf,
     ffframe_linesize,
+    ffframe_set_buf,
     ffframe_set_channel_layout,
     ffframe_set_channels,
     ffframe_set_color_primaries,
     ffframe_set_color_range,
     ffframe_set_color_trc,
     ffframe_set_colorspace,
+    ffframe_set_data,
     ffframe_set_duration,
     ffframe_set_format,
     ffframe_set_height,
+    ffframe_set_linesize,
     ffframe_set_nb_samples,
     ffframe_set_pict_type,
     ffframe_set_pts,
@@ -44,19 +48,27 @@ use crate::ffi::{
     ffframe_set_width,
   },
   avutil::{
-    av_frame_alloc, av_frame_copy, av_frame_copy_props, av_frame_free, av_frame_get_buffer,
-    av_frame_ref, av_frame_unref,
+    av_buffer_create, av_frame_alloc, av_frame_copy, av_frame_copy_props, av_frame_free,
+    av_frame_get_buffer, av_frame_ref, av_frame_unref, av_image_fill_arrays, buffer_flag,
+    image_buffer_size,
   },
 };
 use parking_lot::RwLock;
+use std::os::raw::c_void;
 use std::ptr::NonNull;
 use std::sync::Arc;
 
 use super::CodecError;
+use super::frame_memory::MemoryCharge;
+use super::hwframes::SurfaceLease;
 
 /// Safe wrapper around AVFrame with RAII cleanup
 pub struct Frame {
   ptr: NonNull<AVFrame>,
+  /// Buffer memory counted in `frame_memory` while this frame is alive
+  memory: Option<MemoryCharge>,
+  /// Decoder surface lease held while this GPU frame is handed out
+  surface: Option<SurfaceLease>,
 }
 
 impl Frame {
@@ -64,12 +76,20 @@ impl Frame {
   pub fn new() -> Result<Self, CodecError> {
     let ptr = unsafe { av_frame_alloc() };
     NonNull::new(ptr)
-      .map(|ptr| Self { ptr })
+      .map(|ptr| Self {
+        ptr,
+        memory: None,
+        surface: None,
+      })
       .ok_or(CodecError::AllocationFailed("AVFrame"))
   }
 
   /// Allocate a frame with buffer for the given video format and dimensions
+  ///
+  /// Fails if the buffer would exceed the frame memory hard budget.
   pub fn new_video(width: u32, height: u32, format: AVPixelFormat) -> Result<Self, CodecError> {
+    let size = image_buffer_size(format, width as i32, height as i32).max(0) as usize;
+    let memory = MemoryCharge::try_new(size)?;
     let mut frame = Self::new()?;
 
     unsafe {
@@ -82,10 +102,13 @@ impl Frame {
     let ret = unsafe { av_frame_get_buffer(frame.as_mut_ptr(), 32) };
     ffi::check_error(ret)?;
 
+    frame.memory = Some(memory);
     Ok(frame)
   }
 
   /// Allocate a frame with buffer for audio samples
+  ///
+  /// Fails if the buffer would exceed the frame memory hard budget.
   pub fn new_audio(
     nb_samples: u32,
     channels: u32,
@@ -100,6 +123,7 @@ impl Frame {
       ffframe_set_sample_rate(frame.as_mut_ptr(), sample_rate as i32);
       ffframe_set_format(frame.as_mut_ptr(), format.as_raw());
     }
+    frame.memory = Some(MemoryCharge::try_new(frame.audio_buffer_size())?);
 
     // Allocate buffer with 32-byte alignment for SIMD
     let ret = unsafe { av_frame_get_buffer(frame.as_mut_ptr(), 32) };
@@ -108,12 +132,92 @@ impl Frame {
     Ok(frame)
   }
 
+  /// Wrap externally owned, tightly-packed pixel memory in a frame (zero copy)
+  ///
+  /// The planes are laid out as `av_image_fill_arrays` would with an alignment
+  /// of 1. The buffer is marked read-only, so FFmpeg copies before writing.
+  /// `owner` keeps the memory alive and is dropped when the last reference to
+  /// the frame's buffer goes away, which may happen on any thread.
+  ///
+  /// # Safety
+  /// `data` must point to at least `len` bytes that stay valid and unmodified
+  /// until `owner` is dropped.
+  pub unsafe fn wrap_external_video(
+    width: u32,
+    height: u32,
+    format: AVPixelFormat,
+    data: NonNull<u8>,
+    len: usize,
+    owner: Box<dyn Send>,
+  ) -> Result<Self, CodecError> {
+    let required = image_buffer_size(format, width as i32, height as i32);
+    ffi::check_error(required)?;
+    if len < required as usize {
+      return Err(CodecError::InvalidConfig(format!(
+        "External buffer too small: need {} bytes, got {}",
+        required, len
+      )));
+    }
+
+    let mut frame = Self::new()?;
+    unsafe {
+      ffframe_set_width(frame.as_mut_ptr(), width as i32);
+      ffframe_set_height(frame.as_mut_ptr(), height as i32);
+      ffframe_set_format(frame.as_mut_ptr(), format.as_raw());
+    }
+
+    let mut planes = [std::ptr::null_mut::<u8>(); 4];
+    let mut linesizes = [0i32; 4];
+    let ret = unsafe {
+      av_image_fill_arrays(
+        planes.as_mut_ptr(),
+        linesizes.as_mut_ptr(),
+        data.as_ptr(),
+        format.as_raw(),
+        width as i32,
+        height as i32,
+        1,
+      )
+    };
+    ffi::check_error(ret)?;
+
+    // Double-box so the opaque is a thin pointer
+    let opaque = Box::into_raw(Box::new(owner)) as *mut c_void;
+    let buf = unsafe {
+      av_buffer_create(
+        data.as_ptr(),
+        len,
+        Some(release_external_owner),
+        opaque,
+        buffer_flag::READONLY,
+      )
+    };
+    if buf.is_null() {
+      drop(unsafe { Box::from_raw(opaque as *mut Box<dyn Send>) });
+      return Err(CodecError::AllocationFailed("AVBufferRef"));
+    }
+
+    unsafe {
+      ffframe_set_buf(frame.as_mut_ptr(), 0, buf);
+      for (plane, (&ptr, &linesize)) in planes.iter().zip(linesizes.iter()).enumerate() {
+        ffframe_set_data(frame.as_mut_ptr(), plane as i32, ptr);
+        ffframe_set_linesize(frame.as_mut_ptr(), plane as i32, linesize);
+      }
+    }
+
+    Ok(frame)
+  }
+
   /// Create a Frame from a raw pointer (takes ownership)
   ///
   /// # Safety
   /// The pointer must be a valid AVFrame allocated by FFmpeg
   pub unsafe fn from_raw(ptr: *mut AVFrame) -> Option<Self> {
-    NonNull::new(ptr).map(|ptr| Self { ptr })
+    NonNull::new(ptr).map(|ptr| Self {
+      ptr,
+      memory: None,
+      surface: None,
+    })
   }
 
   /// Get the raw pointer (for FFmpeg API calls)
@@ -130,7 +234,9 @@ impl Frame {
 
   /// Consume the Frame and return the raw pointer
   /// The caller is responsible for freeing the frame
-  pub fn into_raw(self) -> *mut AVFrame {
+  pub fn into_raw(mut self) -> *mut AVFrame {
+    drop(self.memory.take());
+    drop(self.surface.take());
     let ptr = self.ptr.as_ptr();
     std::mem::forget(self);
     ptr
@@ -167,6 +273,11 @@ impl Frame {
     AVPixelFormat::from_raw(fmt)
   }
 
+  /// Check whether the frame data is reference counted (backed by `AVBufferRef`s)
+  pub fn is_refcounted(&self) -> bool {
+    unsafe { ffframe_has_buf(self.as_ptr()) != 0 }
+  }
+
   /// Set pixel format
   pub fn set_format(&mut self, format: AVPixelFormat) {
     unsafe { ffframe_set_format(self.as_mut_ptr(), format.as_raw()) }
@@ -753,6 +864,43 @@ impl Frame {
   /// Unreference the frame data (but keep the frame structure)
   pub fn unref(&mut self) {
     unsafe { av_frame_unref(self.as_mut_ptr()) }
+    self.memory = None;
+    self.surface = None;
+  }
+
+  /// Hold `lease` until this frame is dropped (see `SurfaceBudget`)
+  pub fn hold_surface(&mut self, lease: SurfaceLease) {
+    self.surface = Some(lease);
+  }
+
+  /// Count the frame's buffers in `frame_memory` (for frames filled by FFmpeg)
+  ///
+  /// Decoded frames are already allocated, so this never fails. Frames that
+  /// are already counted keep their charge.
+  pub fn track_memory(&mut self) {
+    if self.memory.is_some() {
+      return;
+    }
+    let size = if self.is_video() {
+      image_buffer_size(self.format(), self.width() as i32, self.height() as i32).max(0) as usize
+    } else {
+      self.audio_buffer_size()
+    };
+    self.memory = Some(MemoryCharge::new(size));
+  }
+
+  /// Bytes this frame counts in `frame_memory` (0 if untracked)
+  pub fn tracked_bytes(&self) -> usize {
+    self.memory.as_ref().map_or(0, MemoryCharge::bytes)
+  }
+
+  /// Copy properties (pts, duration, color info, etc.) from another frame
+  ///
+  /// Used after scaling, which allocates a fresh destination frame.
+  pub fn copy_props_from(&mut self, src: &Frame) -> Result<(), CodecError> {
+    let ret = unsafe { av_frame_copy_props(self.as_mut_ptr(), src.as_ptr()) };
+    ffi::check_error(ret)?;
+    Ok(())
   }
 
   /// Deep clone frame data (clones all pixel/audio data, not just reference).
@@ -823,6 +971,11 @@ impl Frame {
   }
 }
 
+/// AVBuffer free callback for `Frame::wrap_external_video`
+unsafe extern "C" fn release_external_owner(opaque: *mut c_void, _data: *mut u8) {
+  drop(unsafe { Box::from_raw(opaque as *mut Box<dyn Send>) });
+}
+
 impl Drop for Frame {
   fn drop(&mut self) {
     unsafe {
@@ -874,4 +1027,36 @@ mod tests {
     assert!(!frame.data(1).is_null());
     assert!(!frame.data(2).is_null());
   }
+
+  #[test]
+  fn test_wrap_external_video() {
+    use std::sync::atomic::{AtomicBool, Ordering};
+
+    struct Owner(Vec<u8>, Arc<AtomicBool>);
+    impl Drop for Owner {
+      fn drop(&mut self) {
+        self.1.store(true, Ordering::SeqCst);
+      }
+    }
+
+    let released = Arc::new(AtomicBool::new(false));
+    let mut pixels = vec![0u8; 64 * 48 * 3 / 2];
+    let ptr = NonNull::new(pixels.as_mut_ptr()).unwrap();
+    let len = pixels.len();
+    let owner = Box::new(Owner(pixels, released.clone()));
+
+    let frame =
+      unsafe { Frame::wrap_external_video(64, 48, AVPixelFormat::Yuv420p, ptr, len, owner) }
+        .unwrap();
+    assert_eq!(frame.data(0), ptr.as_ptr() as *const u8);
+    assert_eq!(frame.linesize(0), 64);
+    assert_eq!(frame.linesize(1), 32);
+    assert_eq!(unsafe { frame.data(1).offset_from(frame.data(0)) }, 64 * 48);
+
+    let clone = frame.shallow_clone().unwrap();
+    drop(frame);
+    assert!(!released.load(Ordering::SeqCst));
+    drop(clone);
+    assert!(released.load(Ordering::SeqCst));
+  }
 }
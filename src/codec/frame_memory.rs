@@ -0,0 +1,319 @@
+//! Process-wide accounting of decoded frame memory
+//!
+//! Pixel and sample buffers live outside the JS heap, so V8 doesn't see
+//! them: an application that forgets `close()`, or a decoder running far
+//! ahead of its consumer, can exhaust memory long before a GC would collect
+//! the `VideoFrame`/`AudioData` wrappers. Every frame buffer this crate
+//! allocates (`Frame::new_video`/`new_audio`, scaler and resampler output,
+//! deep clones) and every decoded frame carries a `MemoryCharge` that adds
+//! its size to a process-wide total while the frame is alive.
+//!
+//! Two optional budgets apply to that total:
+//!
+//! - Above the soft budget the process is under pressure: the pressure
+//!   listener is told, decoders hold back each chunk until frames are
+//!   released (bounded, see `HeadroomWait`) and caches shrink.
+//! - Allocations that would exceed the hard budget fail. Decoded frames are
+//!   already allocated by FFmpeg and are always charged.
+//!
+//! The listener hears about every level change: Normal -> Soft when the soft
+//! budget is crossed, Hard when an allocation is refused and Normal again
+//! once the total is back under the soft budget. Without a soft budget the
+//! hard budget is the pressure threshold.
+
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU8, AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+use parking_lot::Mutex;
+
+use super::{CodecError, CodecResult};
+
+/// Longest a decoder holds back each chunk waiting for headroom
+pub const MAX_DECODER_WAIT: Duration = Duration::from_millis(50);
+
+/// Bytes held by live charges
+static LIVE_BYTES: AtomicU64 = AtomicU64::new(0);
+
+/// High-water mark of `LIVE_BYTES`
+static PEAK_BYTES: AtomicU64 = AtomicU64::new(0);
+
+/// Soft budget in bytes; 0 = none
+static SOFT_LIMIT: AtomicU64 = AtomicU64::new(0);
+
+/// Hard budget in bytes; 0 = none
+static HARD_LIMIT: AtomicU64 = AtomicU64::new(0);
+
+/// Allocations refused by the hard budget
+static REFUSED: AtomicU64 = AtomicU64::new(0);
+
+/// Current `PressureLevel`
+static LEVEL: AtomicU8 = AtomicU8::new(PressureLevel::Normal as u8);
+
+/// Called with the new level and the live byte count
+pub type PressureListener = Arc<dyn Fn(PressureLevel, u64) + Send + Sync>;
+
+static LISTENER: Mutex<Option<PressureListener>> = Mutex::new(None);
+
+/// Memory pressure level
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(u8)]
+pub enum PressureLevel {
+  /// Below the soft budget
+  Normal = 0,
+  /// Above the soft budget
+  Soft = 1,
+  /// An allocation was refused by the hard budget
+  Hard = 2,
+}
+
+impl PressureLevel {
+  fn from_u8(level: u8) -> Self {
+    match level {
+      1 => Self::Soft,
+      2 => Self::Hard,
+      _ => Self::Normal,
+    }
+  }
+}
+
+/// Snapshot of the accounting counters
+#[derive(Debug, Clone, Copy, Default)]
+pub struct FrameMemoryStats {
+  pub live_bytes: u64,
+  pub peak_bytes: u64,
+  pub soft_limit: u64,
+  pub hard_limit: u64,
+  pub refused: u64,
+}
+
+/// Set the soft and hard budgets in bytes (0 = none)
+pub fn set_budget(soft_limit: u64, hard_limit: u64) {
+  SOFT_LIMIT.store(soft_limit, Ordering::Relaxed);
+  HARD_LIMIT.store(hard_limit, Ordering::Relaxed);
+  refresh_level(LIVE_BYTES.load(Ordering::Relaxed));
+}
+
+/// Set (or clear) the function called on every pressure level change
+///
+/// It runs on whichever thread caused the change, so it must not block.
+pub fn set_pressure_listener(listener: Option<PressureListener>) {
+  *LISTENER.lock() = listener;
+}
+
+/// Current counters and budgets
+pub fn stats() -> FrameMemoryStats {
+  FrameMemoryStats {
+    live_bytes: LIVE_BYTES.load(Ordering::Relaxed),
+    peak_bytes: PEAK_BYTES.load(Ordering::Relaxed),
+    soft_limit: SOFT_LIMIT.load(Ordering::Relaxed),
+    hard_limit: HARD_LIMIT.load(Ordering::Relaxed),
+    refused: REFUSED.load(Ordering::Relaxed),
+  }
+}
+
+/// Bytes currently held by live frames
+pub fn live_bytes() -> u64 {
+  LIVE_BYTES.load(Ordering::Relaxed)
+}
+
+/// Current pressure level
+pub fn pressure_level() -> PressureLevel {
+  PressureLevel::from_u8(LEVEL.load(Ordering::Acquire))
+}
+
+/// Whether live frame memory is above the soft budget
+pub fn under_pressure() -> bool {
+  pressure_level() != PressureLevel::Normal
+}
+
+/// A decoder's wait for headroom before its next chunk
+///
+/// Decoders check this before each chunk so they don't run ahead of a
+/// consumer that isn't releasing frames. Codec workers must never block, so
+/// instead of waiting the decoder defers the chunk (`Handled::Deferred`) and
+/// retries it. The wait is bounded by `MAX_DECODER_WAIT` per chunk because
+/// the consumer may only release frames after the decoder makes progress
+/// (e.g. when it closes them after flush()).
+#[derive(Debug, Default)]
+pub struct HeadroomWait {
+  /// When the current chunk was first held back
+  since: Option<Instant>,
+}
+
+impl HeadroomWait {
+  /// Whether to hold back the next chunk: while under pressure, for at most
+  /// `MAX_DECODER_WAIT` per chunk
+  pub fn should_defer(&mut self) -> bool {
+    if !under_pressure() {
+      self.since = None;
+      return false;
+    }
+    let since = *self.since.get_or_insert_with(Instant::now);
+    if since.elapsed() < MAX_DECODER_WAIT {
+      return true;
+    }
+    self.since = None;
+    false
+  }
+}
+
+/// Byte count above which the process is under pressure; 0 = never
+fn pressure_threshold() -> u64 {
+  match SOFT_LIMIT.load(Ordering::Relaxed) {
+    0 => HARD_LIMIT.load(Ordering::Relaxed),
+    soft => soft,
+  }
+}
+
+/// Move between Normal and Soft after the live total changed
+///
+/// Hard stays until the total is back under the threshold. Retries when
+/// another thread changed the level concurrently, re-reading the live total
+/// so the level ends up matching the latest one.
+fn refresh_level(mut live: u64) {
+  let mut current = LEVEL.load(Ordering::Acquire);
+  loop {
+    let threshold = pressure_threshold();
+    let over = threshold > 0 && live > threshold;
+    let next = match (PressureLevel::from_u8(current), over) {
+      (_, false) => PressureLevel::Normal,
+      (PressureLevel::Normal, true) => PressureLevel::Soft,
+      (level, true) => level,
+    };
+    if next as u8 == current {
+      return;
+    }
+    match LEVEL.compare_exchange_weak(current, next as u8, Ordering::AcqRel, Ordering::Acquire) {
+      Ok(_) => {
+        notify(next, live);
+        return;
+      }
+      Err(actual) => {
+        current = actual;
+        live = LIVE_BYTES.load(Ordering::Relaxed);
+      }
+    }
+  }
+}
+
+fn notify(level: PressureLevel, live: u64) {
+  tracing::debug!(
+    target: "webcodecs",
+    "Frame memory pressure {:?} ({} bytes live)",
+    level,
+    live
+  );
+  let listener = LISTENER.lock().clone();
+  if let Some(listener) = listener {
+    listener(level, live);
+  }
+}
+
+fn add(bytes: u64) {
+  let live = LIVE_BYTES.fetch_add(bytes, Ordering::Relaxed) + bytes;
+  PEAK_BYTES.fetch_max(live, Ordering::Relaxed);
+  refresh_level(live);
+}
+
+/// Frame memory counted against the process-wide total until dropped
+#[derive(Debug)]
+#[must_use]
+pub struct MemoryCharge {
+  bytes: u64,
+}
+
+impl MemoryCharge {
+  /// Charge memory that has already been allocated (e.g. a decoded frame)
+  pub fn new(bytes: usize) -> Self {
+    add(bytes as u64);
+    Self {
+      bytes: bytes as u64,
+    }
+  }
+
+  /// Charge memory about to be allocated, failing if it would exceed the hard budget
+  pub fn try_new(bytes: usize) -> CodecResult<Self> {
+    let hard_limit = HARD_LIMIT.load(Ordering::Relaxed);
+    let live = LIVE_BYTES.load(Ordering::Relaxed);
+    if hard_limit > 0 && live.saturating_add(bytes as u64) > hard_limit {
+      REFUSED.fetch_add(1, Ordering::Relaxed);
+      if LEVEL.swap(PressureLevel::Hard as u8, Ordering::AcqRel) != PressureLevel::Hard as u8 {
+        notify(PressureLevel::Hard, live);
+      }
+      return Err(CodecError::MemoryBudgetExceeded {
+        requested: bytes as u64,
+        live,
+        limit: hard_limit,
+      });
+    }
+    Ok(Self::new(bytes))
+  }
+
+  /// Number of bytes charged
+  pub fn bytes(&self) -> usize {
+    self.bytes as usize
+  }
+}
+
+impl Drop for MemoryCharge {
+  fn drop(&mut self) {
+    let live = LIVE_BYTES.fetch_sub(self.bytes, Ordering::Relaxed) - self.bytes;
+    refresh_level(live);
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  // Budgets are process-wide, so everything that sets them runs in one test
+  #[test]
+  fn test_budgets_and_pressure() {
+    let events = Arc::new(Mutex::new(Vec::new()));
+    let sink = events.clone();
+    set_pressure_listener(Some(Arc::new(move |level, _| sink.lock().push(level))));
+
+    // Budgets far above what concurrently running frame tests allocate
+    const MIB: usize = 1 << 20;
+    let base = live_bytes();
+    set_budget(base + 1024 * MIB as u64, base + 2048 * MIB as u64);
+
+    let first = MemoryCharge::try_new(800 * MIB).unwrap();
+    assert_eq!(pressure_level(), PressureLevel::Normal);
+    let second = MemoryCharge::try_new(800 * MIB).unwrap();
+    assert_eq!(pressure_level(), PressureLevel::Soft);
+    let mut wait = HeadroomWait::default();
+    assert!(wait.should_defer());
+    // The chunk goes ahead once it was held back for MAX_DECODER_WAIT
+    std::thread::sleep(MAX_DECODER_WAIT);
+    assert!(!wait.should_defer());
+    assert!(wait.should_defer());
+
+    // Would exceed the hard budget
+    assert!(MemoryCharge::try_new(800 * MIB).is_err());
+    assert_eq!(pressure_level(), PressureLevel::Hard);
+    // Already-allocated memory is always charged
+    let decoded = MemoryCharge::new(100 * MIB);
+    assert_eq!(decoded.bytes(), 100 * MIB);
+
+    drop(decoded);
+    drop(second);
+    assert_eq!(pressure_level(), PressureLevel::Normal);
+    assert!(!wait.should_defer());
+    drop(first);
+
+    set_budget(0, 0);
+    set_pressure_listener(None);
+    assert!(stats().refused >= 1);
+    assert!(stats().peak_bytes >= base + 1600 * MIB as u64);
+    assert_eq!(
+      *events.lock(),
+      vec![
+        PressureLevel::Soft,
+        PressureLevel::Hard,
+        PressureLevel::Normal
+      ]
+    );
+  }
+}
@@ -0,0 +1,304 @@
+//! Reusable video frame pool
+//!
+//! Keeps a small set of previously allocated `Frame`s keyed by
+//! (width, height, format) so hot conversion paths (e.g. RGBA→I420 in the
+//! encoder) can recycle destination buffers instead of allocating and
+//! freeing a full frame for every conversion.
+//!
+//! A pooled frame is only handed out again once FFmpeg no longer holds a
+//! reference to its buffers (`av_frame_is_writable`). Encoders keep their own
+//! `av_frame_ref` for lookahead/B-frame reordering, so a frame that was just
+//! sent to `avcodec_send_frame` stays in the pool untouched until the encoder
+//! releases it.
+//!
+//! When the pool is full, frames of the geometry acquired least recently are
+//! evicted first. Within one geometry the pool keeps its oldest frames and
+//! drops the one being released: the encoder lets go of frames in the order
+//! it received them, so the oldest are the next to become reusable. Evicting
+//! those instead would leave only frames the encoder still holds once its
+//! lookahead exceeds the capacity, and every acquisition would allocate.
+
+use std::collections::VecDeque;
+
+use crate::ffi::{AVPictureType, AVPixelFormat, avutil::av_frame_is_writable};
+
+use super::{CodecResult, Frame};
+
+/// Default number of frames retained per pool
+///
+/// Large enough to cover typical encoder lookahead (x264 realtime keeps a
+/// handful of frames), small enough to cap idle memory at a few frames.
+pub const DEFAULT_FRAME_POOL_CAPACITY: usize = 8;
+
+/// Snapshot of frame pool counters
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct FramePoolStats {
+  /// Number of frames currently retained by the pool
+  pub pooled: usize,
+  /// Maximum number of frames the pool retains
+  pub capacity: usize,
+  /// Number of acquisitions served by a recycled frame
+  pub hits: u64,
+  /// Number of acquisitions that had to allocate a new frame
+  pub misses: u64,
+}
+
+impl FramePoolStats {
+  /// Fraction of acquisitions served from the pool (0.0 when unused)
+  pub fn hit_rate(&self) -> f64 {
+    let total = self.hits + self.misses;
+    if total == 0 {
+      0.0
+    } else {
+      self.hits as f64 / total as f64
+    }
+  }
+}
+
+/// Pool of reusable video frames keyed by (width, height, format)
+pub struct FramePool {
+  /// Pooled frames, oldest release first
+  frames: VecDeque<(FrameKey, Frame)>,
+  /// Acquisition count at which each recent geometry was last acquired
+  last_acquired: Vec<(FrameKey, u64)>,
+  capacity: usize,
+  hits: u64,
+  misses: u64,
+}
+
+type FrameKey = (u32, u32, AVPixelFormat);
+
+impl FramePool {
+  /// Create a pool that retains at most `capacity` frames
+  pub fn new(capacity: usize) -> Self {
+    Self {
+      frames: VecDeque::with_capacity(capacity),
+      last_acquired: Vec::new(),
+      capacity,
+      hits: 0,
+      misses: 0,
+    }
+  }
+
+  /// Get a writable frame with the given geometry, recycling one if possible
+  ///
+  /// The returned frame has its buffers allocated but its pixel contents are
+  /// unspecified; callers are expected to overwrite every plane (e.g. via
+  /// `Scaler::scale`).
+  pub fn acquire(&mut self, width: u32, height: u32, format: AVPixelFormat) -> CodecResult<Frame> {
+    let key = (width, height, format);
+    self.touch(key);
+    let reusable = self
+      .frames
+      .iter_mut()
+      .position(|(k, frame)| *k == key && unsafe { av_frame_is_writable(frame.as_mut_ptr()) } > 0);
+
+    if let Some(index) = reusable
+      && let Some((_, mut frame)) = self.frames.remove(index)
+    {
+      self.hits += 1;
+      // Clear per-frame encode hints left over from the previous use
+      frame.set_pict_type(AVPictureType::None);
+      frame.set_quality(0);
+      return Ok(frame);
+    }
+
+    self.misses += 1;
+    Frame::new_video(width, height, format)
+  }
+
+  /// Return a frame to the pool for later reuse
+  ///
+  /// At capacity, a frame of the geometry acquired least recently makes
+  /// room; if that is the released frame's own geometry, the released frame
+  /// is dropped instead (see the module docs).
+  pub fn release(&mut self, frame: Frame) {
+    if self.capacity == 0 || !frame.is_video() {
+      return;
+    }
+    let key = (frame.width(), frame.height(), frame.format());
+    if self.frames.len() >= self.capacity {
+      let last_acquired = |k: &FrameKey| {
+        self
+          .last_acquired
+          .iter()
+          .find(|(used, _)| used == k)
+          .map_or(0, |(_, tick)| *tick)
+      };
+      let victim = self
+        .frames
+        .iter()
+        .enumerate()
+        .filter(|(_, (k, _))| *k != key)
+        .min_by_key(|(_, (k, _))| last_acquired(k))
+        .filter(|(_, (k, _))| last_acquired(k) < last_acquired(&key))
+        .map(|(index, _)| index);
+      match victim {
+        Some(index) => {
+          self.frames.remove(index);
+        }
+        None => return,
+      }
+    }
+    self.frames.push_back((key, frame));
+  }
+
+  /// Record an acquisition of `key`
+  fn touch(&mut self, key: FrameKey) {
+    let tick = self.hits + self.misses + 1;
+    match self.last_acquired.iter().position(|(k, _)| *k == key) {
+      Some(index) => self.last_acquired[index].1 = tick,
+      None => self.last_acquired.push((key, tick)),
+    }
+    // Forget geometries that are no longer pooled once they pile up
+    if self.last_acquired.len() > self.capacity + 1 {
+      let frames = &self.frames;
+      self
+        .last_acquired
+        .retain(|(k, _)| *k == key || frames.iter().any(|(pooled, _)| pooled == k));
+    }
+  }
+
+  /// Drop all retained frames (counters are kept)
+  pub fn clear(&mut self) {
+    self.frames.clear();
+    self.last_acquired.clear();
+  }
+
+  /// Get a snapshot of the pool counters
+  pub fn stats(&self) -> FramePoolStats {
+    FramePoolStats {
+      pooled: self.frames.len(),
+      capacity: self.capacity,
+      hits: self.hits,
+      misses: self.misses,
+    }
+  }
+}
+
+impl Default for FramePool {
+  fn default() -> Self {
+    Self::new(DEFAULT_FRAME_POOL_CAPACITY)
+  }
+}
+
+impl std::fmt::Debug for FramePool {
+  fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+    f.debug_struct("FramePool")
+      .field("pooled", &self.frames.len())
+      .field("capacity", &self.capacity)
+      .field("hits", &self.hits)
+      .field("misses", &self.misses)
+      .finish()
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[test]
+  fn test_pool_reuses_released_frame() {
+    let mut pool = FramePool::new(4);
+    let frame = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    let data_ptr = frame.data(0);
+    pool.release(frame);
+
+    let reused = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    assert_eq!(reused.data(0), data_ptr);
+
+    let stats = pool.stats();
+    assert_eq!(stats.hits, 1);
+    assert_eq!(stats.misses, 1);
+    assert_eq!(stats.hit_rate(), 0.5);
+  }
+
+  #[test]
+  fn test_pool_skips_referenced_frame() {
+    let mut pool = FramePool::new(4);
+    let frame = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    // Simulate an encoder holding a reference to the buffers
+    let held = frame.shallow_clone().unwrap();
+    pool.release(frame);
+
+    let fresh = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    assert_ne!(fresh.data(0), held.data(0));
+    assert_eq!(pool.stats().misses, 2);
+
+    drop(held);
+    let reused = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    assert!(!reused.data(0).is_null());
+    assert_eq!(pool.stats().hits, 1);
+  }
+
+  #[test]
+  fn test_pool_keys_by_geometry() {
+    let mut pool = FramePool::new(4);
+    let frame = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    pool.release(frame);
+
+    let other = pool.acquire(64, 48, AVPixelFormat::Nv12).unwrap();
+    assert_eq!(other.format(), AVPixelFormat::Nv12);
+    assert_eq!(pool.stats().hits, 0);
+    assert_eq!(pool.stats().pooled, 1);
+  }
+
+  #[test]
+  fn test_pool_capacity_bound() {
+    let mut pool = FramePool::new(2);
+    for _ in 0..4 {
+      let frame = Frame::new_video(16, 16, AVPixelFormat::Yuv420p).unwrap();
+      pool.release(frame);
+    }
+    assert_eq!(pool.stats().pooled, 2);
+  }
+
+  #[test]
+  fn test_pool_evicts_least_recently_acquired_geometry() {
+    let mut pool = FramePool::new(2);
+    let small = pool.acquire(16, 16, AVPixelFormat::Yuv420p).unwrap();
+    let large = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    let second_large = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    pool.release(small);
+    pool.release(large);
+
+    // The small frame makes room; a frame of the current geometry stays
+    pool.release(second_large);
+    assert_eq!(pool.stats().pooled, 2);
+    assert!(pool.frames.iter().all(|((w, _, _), _)| *w == 64));
+
+    // A late release of the stale geometry doesn't displace current frames
+    pool.release(Frame::new_video(16, 16, AVPixelFormat::Yuv420p).unwrap());
+    assert!(pool.frames.iter().all(|((w, _, _), _)| *w == 64));
+  }
+
+  #[test]
+  fn test_pool_hits_with_lookahead_beyond_capacity() {
+    // An encoder holding its last 5 input frames, against a pool of 4
+    let mut pool = FramePool::new(4);
+    let mut lookahead = VecDeque::new();
+    for _ in 0..40 {
+      let frame = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+      lookahead.push_back(frame.shallow_clone().unwrap());
+      if lookahead.len() > 5 {
+        lookahead.pop_front();
+      }
+      pool.release(frame);
+    }
+    let warm = pool.stats();
+
+    for _ in 0..20 {
+      let frame = pool.acquire(64, 48, AVPixelFormat::Yuv420p).unwrap();
+      lookahead.push_back(frame.shallow_clone().unwrap());
+      lookahead.pop_front();
+      pool.release(frame);
+    }
+    let steady = pool.stats();
+    // Keeping the oldest frames reuses each one as the encoder lets it go
+    assert!(
+      steady.hits - warm.hits >= 10,
+      "{} hits in 20 steady-state acquisitions",
+      steady.hits - warm.hits
+    );
+  }
+}
@@ -1,17 +1,40 @@
 //! Safe wrapper around FFmpeg hardware device context
 //!
 //! Provides hardware acceleration device management for VideoToolbox, CUDA, VAAPI, etc.
+//!
+//! Device creation loads and initializes the driver, which can take hundreds
+//! of milliseconds per device. Codecs therefore share devices through a
+//! process-wide cache with one device per type (`shared`); each codec holds a
+//! reference to the cached device, and devices no codec references any more
+//! can be released with `release_unused_shared`. Availability probes are
+//! memoized for the same reason; a failed probe is retried once
+//! `FAILED_PROBE_TTL` has passed, since drivers can fail transiently.
 
 use crate::ffi::{
   self, AVBufferRef, AVHWDeviceType,
-  avutil::av_buffer_unref,
+  avutil::{av_buffer_get_ref_count, av_buffer_ref, av_buffer_unref},
   hwaccel::{av_hwdevice_ctx_create, av_hwdevice_get_type_name, av_hwdevice_iterate_types},
 };
 use std::ffi::CStr;
 use std::ptr::NonNull;
+use std::sync::Mutex;
+use std::time::Instant;
 
+use super::probe::FAILED_PROBE_TTL;
 use super::{CodecError, CodecResult};
 
+/// Process-wide devices handed out by `HwDeviceContext::shared`, one per type
+static SHARED_DEVICES: Mutex<Vec<HwDeviceContext>> = Mutex::new(Vec::new());
+
+/// Memoized `HwDeviceContext::is_available` results and when they were probed
+static AVAILABILITY: Mutex<Vec<(AVHWDeviceType, bool, Instant)>> = Mutex::new(Vec::new());
+
+fn lock<T>(mutex: &Mutex<T>) -> std::sync::MutexGuard<'_, T> {
+  mutex
+    .lock()
+    .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
 /// Safe wrapper around FFmpeg hardware device context
 pub struct HwDeviceContext {
   ptr: NonNull<AVBufferRef>,
@@ -42,25 +65,62 @@ impl HwDeviceContext {
       ))
   }
 
-  /// Try to create the best available hardware device for the current platform
+  /// Get a reference to the process-wide device of the given type
+  ///
+  /// Decoders and encoders that use the same device can exchange GPU surfaces
+  /// without a round trip through system memory. The device is created on
+  /// first use and stays cached until `release_unused_shared` finds it unused.
+  pub fn shared(device_type: AVHWDeviceType) -> CodecResult<Self> {
+    let mut devices = lock(&SHARED_DEVICES);
+    if let Some(device) = devices.iter().find(|d| d.device_type == device_type) {
+      return Ok(device.clone());
+    }
+
+    let device = Self::new(device_type)?;
+    devices.push(device.clone());
+    let mut memo = lock(&AVAILABILITY);
+    memo.retain(|(t, _, _)| *t != device_type);
+    memo.push((device_type, true, Instant::now()));
+    Ok(device)
+  }
+
+  /// Whether a device of the given type is in the shared cache
+  pub fn is_shared(device_type: AVHWDeviceType) -> bool {
+    lock(&SHARED_DEVICES)
+      .iter()
+      .any(|d| d.device_type == device_type)
+  }
+
+  /// Release cached devices that no codec (or hardware frame pool) references
+  ///
+  /// Returns the number of devices released. Devices in use stay cached.
+  pub fn release_unused_shared() -> usize {
+    let mut devices = lock(&SHARED_DEVICES);
+    let before = devices.len();
+    // The cache's own reference is the only one left
+    devices.retain(|d| unsafe { av_buffer_get_ref_count(d.as_ptr()) } > 1);
+    before - devices.len()
+  }
+
+  /// Get the shared device of the best available type for the current platform
   pub fn new_best_available() -> Option<Self> {
     // Platform-specific priority
     #[cfg(target_os = "macos")]
     {
-      if let Ok(ctx) = Self::new(AVHWDeviceType::Videotoolbox) {
+      if let Ok(ctx) = Self::shared(AVHWDeviceType::Videotoolbox) {
         return Some(ctx);
       }
     }
 
     // NVIDIA CUDA
-    if let Ok(ctx) = Self::new(AVHWDeviceType::Cuda) {
+    if let Ok(ctx) = Self::shared(AVHWDeviceType::Cuda) {
       return Some(ctx);
     }
 
     // Linux VAAPI
     #[cfg(target_os = "linux")]
     {
-      if let Ok(ctx) = Self::new(AVHWDeviceType::Vaapi) {
+      if let Ok(ctx) = Self::shared(AVHWDeviceType::Vaapi) {
         return Some(ctx);
       }
     }
@@ -68,13 +128,13 @@ impl HwDeviceContext {
     // Windows D3D11VA
     #[cfg(target_os = "windows")]
     {
-      if let Ok(ctx) = Self::new(AVHWDeviceType::D3d11va) {
+      if let Ok(ctx) = Self::shared(AVHWDeviceType::D3d11va) {
         return Some(ctx);
       }
     }
 
     // Intel Quick Sync
-    if let Ok(ctx) = Self::new(AVHWDeviceType::Qsv) {
+    if let Ok(ctx) = Self::shared(AVHWDeviceType::Qsv) {
       return Some(ctx);
     }
 
@@ -106,9 +166,23 @@ impl HwDeviceContext {
   }
 
   /// Check if a hardware device type is available
+  ///
+  /// The result is memoized: only the first probe of a type creates (and
+  /// drops) a device, unless one is already in the shared cache. A negative
+  /// answer is probed again after `FAILED_PROBE_TTL`.
   pub fn is_available(device_type: AVHWDeviceType) -> bool {
-    // Try to create and immediately drop
-    Self::new(device_type).is_ok()
+    if let Some(&(_, available, _)) = lock(&AVAILABILITY).iter().find(|(t, available, at)| {
+      *t == device_type && (*available || at.elapsed() < FAILED_PROBE_TTL)
+    }) {
+      return available;
+    }
+
+    // Probe outside the lock: device creation can take a while
+    let available = Self::is_shared(device_type) || Self::new(device_type).is_ok();
+    let mut memo = lock(&AVAILABILITY);
+    memo.retain(|(t, _, _)| *t != device_type);
+    memo.push((device_type, available, Instant::now()));
+    available
   }
 
   /// Get all available hardware device types
@@ -146,6 +220,19 @@ impl HwDeviceContext {
   }
 }
 
+impl Clone for HwDeviceContext {
+  /// Clone by taking a new reference to the same underlying device
+  fn clone(&self) -> Self {
+    let new_ref = unsafe { av_buffer_ref(self.ptr.as_ptr()) };
+    Self {
+      ptr: NonNull::new(new_ref).expect(
+        "Failed to create reference to hardware device context: av_buffer_ref returned null",
+      ),
+      device_type: self.device_type,
+    }
+  }
+}
+
 impl Drop for HwDeviceContext {
   fn drop(&mut self) {
     unsafe {
@@ -7,8 +7,9 @@ use crate::ffi::{
   AVBufferRef, AVHWDeviceType, AVPixelFormat, FFmpegError,
   accessors::{
     ffframe_get_hw_frames_ctx, ffhwframes_get_format, ffhwframes_get_height,
-    ffhwframes_get_sw_format, ffhwframes_get_width, ffhwframes_set_format, ffhwframes_set_height,
-    ffhwframes_set_initial_pool_size, ffhwframes_set_sw_format, ffhwframes_set_width,
+    ffhwframes_get_sw_format, ffhwframes_get_width, ffhwframes_same_device, ffhwframes_set_format,
+    ffhwframes_set_height, ffhwframes_set_initial_pool_size, ffhwframes_set_sw_format,
+    ffhwframes_set_width,
   },
   avutil::{av_buffer_ref, av_buffer_unref},
   hwaccel::{
@@ -16,6 +17,8 @@ use crate::ffi::{
   },
 };
 use std::ptr::NonNull;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU32, Ordering};
 
 use super::{CodecError, CodecResult, frame::Frame, hwdevice::HwDeviceContext};
 
@@ -167,6 +170,24 @@ impl HwFrameContext {
     Ok(hw_frame)
   }
 
+  /// Check whether a GPU frame can be consumed by this context's encoder as-is
+  ///
+  /// True when the frame lives on the same device and has the same
+  /// dimensions and software format as this pool, so an encoder attached to
+  /// this context can encode it without a download/upload round trip.
+  pub fn accepts(&self, hw_frame: &Frame) -> bool {
+    let frames_ref = unsafe { ffframe_get_hw_frames_ctx(hw_frame.as_ptr()) };
+    if frames_ref.is_null() {
+      return false;
+    }
+
+    let same_device = unsafe { ffhwframes_same_device(frames_ref, self.ptr.as_ptr()) } != 0;
+    same_device
+      && hw_frame.width() == self.width
+      && hw_frame.height() == self.height
+      && hw_frame_sw_format(hw_frame) == Some(self.sw_format)
+  }
+
   /// Get the raw pointer for attaching to encoder context
   #[inline]
   pub fn as_ptr(&self) -> *mut AVBufferRef {
@@ -261,6 +282,20 @@ impl Drop for HwFrameContext {
   }
 }
 
+/// Get the software (CPU-side) pixel format of a hardware frame
+///
+/// This is the format `download_hw_frame` produces, e.g. NV12 for a VAAPI
+/// surface. Returns None for frames without a hardware frames context.
+pub fn hw_frame_sw_format(hw_frame: &Frame) -> Option<AVPixelFormat> {
+  let frames_ref = unsafe { ffframe_get_hw_frames_ctx(hw_frame.as_ptr()) };
+  if frames_ref.is_null() {
+    return None;
+  }
+  Some(AVPixelFormat::from_raw(unsafe {
+    ffhwframes_get_sw_format(frames_ref)
+  }))
+}
+
 /// Download a hardware frame to CPU memory.
 ///
 /// This function transfers pixel data from GPU memory to a software (CPU) frame.
@@ -292,6 +327,8 @@ pub fn download_hw_frame(hw_frame: &Frame) -> CodecResult<Frame> {
     )));
   }
 
+  sw_frame.track_memory();
+
   // Copy timestamp metadata from source frame
   sw_frame.set_pts(hw_frame.pts());
   sw_frame.set_duration(hw_frame.duration());
@@ -306,6 +343,43 @@ pub fn download_hw_frame(hw_frame: &Frame) -> CodecResult<Frame> {
   Ok(sw_frame)
 }
 
+/// Count of decoded surfaces a decoder has handed out undownloaded
+///
+/// A hardware decoder allocates its surfaces from a fixed-size pool (its
+/// references plus `extra_hw_frames`). Every surface the application holds
+/// comes out of that pool, so a decoder keeping frames GPU-resident leases
+/// at most as many as it asked for and downloads the rest.
+#[derive(Debug, Clone, Default)]
+pub struct SurfaceBudget(Arc<AtomicU32>);
+
+impl SurfaceBudget {
+  /// Take one of `limit` leases, or None if all are held
+  pub fn try_lease(&self, limit: u32) -> Option<SurfaceLease> {
+    self
+      .0
+      .fetch_update(Ordering::AcqRel, Ordering::Acquire, |held| {
+        (held < limit).then_some(held + 1)
+      })
+      .ok()
+      .map(|_| SurfaceLease(self.0.clone()))
+  }
+
+  /// Leases currently held
+  pub fn held(&self) -> u32 {
+    self.0.load(Ordering::Acquire)
+  }
+}
+
+/// One surface counted against a `SurfaceBudget` until dropped
+#[derive(Debug)]
+pub struct SurfaceLease(Arc<AtomicU32>);
+
+impl Drop for SurfaceLease {
+  fn drop(&mut self) {
+    self.0.fetch_sub(1, Ordering::AcqRel);
+  }
+}
+
 // Hardware frames contexts can be shared across threads
 unsafe impl Send for HwFrameContext {}
 unsafe impl Sync for HwFrameContext {}
@@ -394,4 +468,18 @@ mod tests {
       AVPixelFormat::Vaapi
     );
   }
+
+  #[test]
+  fn test_surface_budget_bounds_leases() {
+    let budget = SurfaceBudget::default();
+    let first = budget.try_lease(2).unwrap();
+    let second = budget.try_lease(2).unwrap();
+    assert!(budget.try_lease(2).is_none());
+    assert_eq!(budget.held(), 2);
+
+    drop(first);
+    assert!(budget.try_lease(2).is_some());
+    drop(second);
+    assert_eq!(budget.held(), 0);
+  }
 }
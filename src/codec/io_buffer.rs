@@ -2,9 +2,13 @@
 //!
 //! Provides memory and streaming buffers for FFmpeg's custom I/O system.
 
+use std::collections::VecDeque;
 use std::io::{self, Read, Seek, SeekFrom, Write};
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
 use std::sync::{Arc, Condvar, Mutex};
 
+use crossbeam::channel::{self, Receiver, Sender, TryRecvError};
+
 // ============================================================================
 // Buffer Source Trait (for zero-copy demuxing)
 // ============================================================================
@@ -33,6 +37,59 @@ impl BufferSource for Box<[u8]> {
   }
 }
 
+/// Read-only memory map of a file on disk.
+///
+/// Pages are faulted in on demand and live in the OS page cache, so several
+/// demuxers (in one process or many) reading the same file share one
+/// resident copy instead of each holding its own buffer.
+///
+/// The file must not be truncated while mapped; on most platforms that
+/// faults the process on the next access to the missing pages.
+pub struct MappedFile {
+  /// None for empty files, which can't be mapped
+  map: Option<memmap2::Mmap>,
+}
+
+impl MappedFile {
+  /// Map a file read-only
+  pub fn open(path: impl AsRef<std::path::Path>) -> io::Result<Self> {
+    let file = std::fs::File::open(path)?;
+    if file.metadata()?.len() == 0 {
+      return Ok(Self { map: None });
+    }
+    // SAFETY: the map is read-only; see the type docs for external truncation
+    let map = unsafe { memmap2::Mmap::map(&file)? };
+    Ok(Self { map: Some(map) })
+  }
+
+  /// Get the mapped length
+  pub fn len(&self) -> usize {
+    self.map.as_ref().map_or(0, |m| m.len())
+  }
+
+  /// Check if the mapped file is empty
+  pub fn is_empty(&self) -> bool {
+    self.len() == 0
+  }
+}
+
+impl BufferSource for MappedFile {
+  fn buffer_data(&self) -> (*const u8, usize) {
+    match &self.map {
+      Some(map) => (map.as_ptr(), map.len()),
+      None => ([].as_ptr(), 0),
+    }
+  }
+}
+
+impl std::fmt::Debug for MappedFile {
+  fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+    f.debug_struct("MappedFile")
+      .field("len", &self.len())
+      .finish()
+  }
+}
+
 // ============================================================================
 // Read-Only Buffer (for demuxing with zero-copy support)
 // ============================================================================
@@ -305,50 +362,80 @@ impl Seek for MemoryBuffer {
   }
 }
 
-/// Internal state for streaming buffer
-struct StreamingBufferState {
-  buffer: Vec<u8>,
-  write_pos: usize,
-  read_pos: usize,
+/// State shared by the producer and consumer ends of a streaming buffer
+///
+/// Pages themselves travel through a channel; this only holds counters and
+/// flags, so neither side takes a lock on the hot path.
+struct StreamingBufferShared {
+  /// Bytes in pages that were written but not yet taken by the consumer
+  queued_bytes: AtomicUsize,
   /// Total bytes written (for tracking)
-  total_written: u64,
+  total_written: AtomicU64,
   /// Total bytes read (for tracking)
-  total_read: u64,
+  total_read: AtomicU64,
   /// Whether the writer has finished
-  finished: bool,
+  finished: AtomicBool,
   /// Whether the buffer is closed
-  closed: bool,
+  closed: AtomicBool,
+  /// Whether the consumer has taken the end-of-stream marker
+  eof: AtomicBool,
+  /// Set while the producer waits for the consumer to free up space
+  producer_waiting: AtomicBool,
+  /// Only taken to park/wake a producer that ran out of space
+  space_lock: Mutex<()>,
+  space_available: Condvar,
 }
 
-/// Ring buffer for streaming output with backpressure support
+impl StreamingBufferShared {
+  /// Account for a page the consumer has taken and wake a waiting producer
+  fn release(&self, len: usize) {
+    self.queued_bytes.fetch_sub(len, Ordering::SeqCst);
+    self.total_read.fetch_add(len as u64, Ordering::Relaxed);
+    if self.producer_waiting.load(Ordering::SeqCst) {
+      let _guard = self.space_lock.lock().unwrap();
+      self.space_available.notify_one();
+    }
+  }
+}
+
+/// Segmented page queue for streaming output with backpressure support
 ///
 /// This buffer is designed for streaming muxer output:
-/// - Producer (muxer) writes encoded data
-/// - Consumer reads data via ReadableStream
-/// - Backpressure when buffer is full
-/// - Thread-safe via mutex + condvars
+/// - Producer (muxer) writes encoded data; every AVIO flush becomes one page
+///   of at most the AVIO buffer size
+/// - Consumer takes whole pages by ownership, so they can be handed to JS as
+///   external ArrayBuffers without another copy, or everything that is ready
+///   at once (joined only when more than one page is queued)
+/// - Backpressure when more than `capacity` bytes are queued
+/// - Producer and consumer only share atomics and a lock-free channel; the
+///   producer sleeps on a condvar only when it actually has to wait
+///
+/// An empty page marks the end of the stream.
 pub struct StreamingBuffer {
-  inner: Arc<Mutex<StreamingBufferState>>,
-  not_full: Arc<Condvar>,
-  not_empty: Arc<Condvar>,
+  pages: Sender<Vec<u8>>,
+  receiver: Receiver<Vec<u8>>,
+  shared: Arc<StreamingBufferShared>,
   capacity: usize,
 }
 
 impl StreamingBuffer {
   /// Create a new streaming buffer with specified capacity
   pub fn new(capacity: usize) -> Self {
+    let (pages, receiver) = channel::unbounded();
     Self {
-      inner: Arc::new(Mutex::new(StreamingBufferState {
-        buffer: vec![0; capacity],
-        write_pos: 0,
-        read_pos: 0,
-        total_written: 0,
-        total_read: 0,
-        finished: false,
-        closed: false,
-      })),
-      not_full: Arc::new(Condvar::new()),
-      not_empty: Arc::new(Condvar::new()),
+      pages,
+      receiver,
+      shared: Arc::new(StreamingBufferShared {
+        queued_bytes: AtomicUsize::new(0),
+        total_written: AtomicU64::new(0),
+        total_read: AtomicU64::new(0),
+        finished: AtomicBool::new(false),
+        closed: AtomicBool::new(false),
+        eof: AtomicBool::new(false),
+        producer_waiting: AtomicBool::new(false),
+        space_lock: Mutex::new(()),
+        space_available: Condvar::new(),
+      }),
       capacity,
     }
   }
@@ -361,14 +448,12 @@ impl StreamingBuffer {
   /// Clone for sharing between producer and consumer
   pub fn clone_handle(&self) -> StreamingBufferHandle {
     StreamingBufferHandle {
-      inner: Arc::clone(&self.inner),
-      not_full: Arc::clone(&self.not_full),
-      not_empty: Arc::clone(&self.not_empty),
-      capacity: self.capacity,
+      pages: self.receiver.clone(),
+      shared: Arc::clone(&self.shared),
     }
   }
 
-  /// Write data to the buffer, blocking if full
+  /// Write data to the buffer as one page, blocking if full
   ///
   /// Returns the number of bytes written, or an error if closed.
   pub fn write_blocking(&self, data: &[u8]) -> io::Result<usize> {
@@ -376,82 +461,83 @@ impl StreamingBuffer {
       return Ok(0);
     }
 
-    let mut written = 0;
+    self.wait_for_space(data.len())?;
+
+    self
+      .shared
+      .queued_bytes
+      .fetch_add(data.len(), Ordering::SeqCst);
+    self
+      .shared
+      .total_written
+      .fetch_add(data.len() as u64, Ordering::Relaxed);
+    self
+      .pages
+      .send(data.to_vec())
+      .map_err(|_| io::Error::new(io::ErrorKind::BrokenPipe, "Buffer closed"))?;
+
+    Ok(data.len())
+  }
 
-    while written < data.len() {
-      let mut state = self.inner.lock().unwrap();
+  /// Block until a page of `len` bytes fits into the buffer
+  ///
+  /// A page larger than the capacity is accepted once the buffer is empty.
+  fn wait_for_space(&self, len: usize) -> io::Result<()> {
+    let shared = &*self.shared;
+    let fits = |queued: usize| queued == 0 || queued + len <= self.capacity;
 
-      // Check if closed
-      if state.closed {
-        return Err(io::Error::new(io::ErrorKind::BrokenPipe, "Buffer closed"));
-      }
+    if shared.closed.load(Ordering::SeqCst) {
+      return Err(io::Error::new(io::ErrorKind::BrokenPipe, "Buffer closed"));
+    }
+    if fits(shared.queued_bytes.load(Ordering::SeqCst)) {
+      return Ok(());
+    }
 
-      // Calculate available space
-      let used = if state.write_pos >= state.read_pos {
-        state.write_pos - state.read_pos
-      } else {
-        self.capacity - state.read_pos + state.write_pos
-      };
-      let available = self.capacity - used - 1; // -1 to distinguish full from empty
+    let mut guard = shared.space_lock.lock().unwrap();
+    loop {
+      // Publish the wait before re-checking, so a consumer that frees space
+      // after this point is guaranteed to see it and notify
+      shared.producer_waiting.store(true, Ordering::SeqCst);
 
-      if available == 0 {
-        // Buffer full, wait for consumer
-        state = self.not_full.wait(state).unwrap();
-        continue;
+      if shared.closed.load(Ordering::SeqCst) {
+        shared.producer_waiting.store(false, Ordering::SeqCst);
+        return Err(io::Error::new(io::ErrorKind::BrokenPipe, "Buffer closed"));
       }
-
-      // Write as much as possible
-      let to_write = available.min(data.len() - written);
-
-      // Handle wrap-around - extract positions first to avoid borrow issues
-      let write_pos = state.write_pos;
-      let first_part = (self.capacity - write_pos).min(to_write);
-      state.buffer[write_pos..write_pos + first_part]
-        .copy_from_slice(&data[written..written + first_part]);
-
-      if first_part < to_write {
-        let second_part = to_write - first_part;
-        state.buffer[..second_part]
-          .copy_from_slice(&data[written + first_part..written + to_write]);
+      if fits(shared.queued_bytes.load(Ordering::SeqCst)) {
+        shared.producer_waiting.store(false, Ordering::SeqCst);
+        return Ok(());
       }
 
-      state.write_pos = (write_pos + to_write) % self.capacity;
-      state.total_written += to_write as u64;
-      written += to_write;
-
-      // Notify consumer
-      self.not_empty.notify_one();
+      // Buffer full, wait for consumer
+      guard = shared.space_available.wait(guard).unwrap();
     }
-
-    Ok(written)
   }
 
   /// Signal that writing is complete
   pub fn finish(&self) {
-    let mut state = self.inner.lock().unwrap();
-    state.finished = true;
-    self.not_empty.notify_all();
+    if !self.shared.finished.swap(true, Ordering::SeqCst) {
+      let _ = self.pages.send(Vec::new());
+    }
   }
 
   /// Close the buffer (cancels pending operations)
   pub fn close(&self) {
-    let mut state = self.inner.lock().unwrap();
-    state.closed = true;
-    state.finished = true;
-    self.not_full.notify_all();
-    self.not_empty.notify_all();
+    self.shared.closed.store(true, Ordering::SeqCst);
+    {
+      let _guard = self.shared.space_lock.lock().unwrap();
+      self.shared.space_available.notify_all();
+    }
+    self.finish();
   }
 
   /// Check if the buffer is finished (no more data will be written)
   pub fn is_finished(&self) -> bool {
-    let state = self.inner.lock().unwrap();
-    state.finished
+    self.shared.finished.load(Ordering::SeqCst)
   }
 
   /// Get total bytes written
   pub fn total_written(&self) -> u64 {
-    let state = self.inner.lock().unwrap();
-    state.total_written
+    self.shared.total_written.load(Ordering::Relaxed)
   }
 }
 
@@ -467,116 +553,301 @@ impl Write for StreamingBuffer {
 
 /// Handle for the consumer side of a streaming buffer
 pub struct StreamingBufferHandle {
-  inner: Arc<Mutex<StreamingBufferState>>,
-  not_full: Arc<Condvar>,
-  not_empty: Arc<Condvar>,
-  capacity: usize,
+  pages: Receiver<Vec<u8>>,
+  shared: Arc<StreamingBufferShared>,
 }
 
 impl StreamingBufferHandle {
-  /// Read available data without blocking
+  /// Take everything written so far without blocking
   ///
-  /// Returns None if buffer is empty but not finished (no data ready yet).
-  /// Returns Some(empty vec) if buffer is empty and finished (EOF).
-  /// Returns Some(data) if data is available.
+  /// Returns Some(empty vec) if no data is ready yet.
+  /// Returns None once the stream is finished and drained (EOF).
+  /// A single queued page is moved out without copying; several are joined.
   pub fn read_available(&self) -> Option<Vec<u8>> {
-    let mut state = self.inner.lock().unwrap();
+    let mut data = self.read_page()?;
+    if data.is_empty() {
+      return Some(data);
+    }
+    while let Some(page) = self.try_take_page() {
+      data.extend_from_slice(&page);
+    }
+    Some(data)
+  }
 
-    // Calculate used space
-    let used = if state.write_pos >= state.read_pos {
-      state.write_pos - state.read_pos
-    } else {
-      self.capacity - state.read_pos + state.write_pos
-    };
+  /// Take the next page without blocking or copying
+  ///
+  /// Returns Some(empty vec) if no data is ready yet.
+  /// Returns None once the stream is finished and drained (EOF).
+  /// Pages keep the boundaries of the producer's writes (at most the AVIO
+  /// buffer size for muxer output).
+  pub fn read_page(&self) -> Option<Vec<u8>> {
+    if self.shared.eof.load(Ordering::SeqCst) {
+      return None;
+    }
+    match self.try_take_page() {
+      Some(page) => Some(page),
+      None if self.shared.eof.load(Ordering::SeqCst) => None,
+      None => Some(Vec::new()),
+    }
+  }
 
-    if used == 0 {
-      if state.finished {
-        return Some(Vec::new()); // EOF - empty array signals finished
+  /// Take the next non-empty page if one is queued, noting EOF on the way
+  fn try_take_page(&self) -> Option<Vec<u8>> {
+    match self.pages.try_recv() {
+      Ok(page) => {
+        let page = self.take_page(page);
+        if page.is_empty() { None } else { Some(page) }
+      }
+      Err(TryRecvError::Empty) => None,
+      Err(TryRecvError::Disconnected) => {
+        // Producer went away without finishing; treat as EOF
+        self.shared.eof.store(true, Ordering::SeqCst);
+        None
       }
-      return None; // No data yet, but not finished
     }
+  }
 
-    // Read all available data
-    let mut data = Vec::with_capacity(used);
+  /// Take the next page, blocking until data is available or EOF
+  ///
+  /// Returns None on EOF, Some(page) otherwise.
+  pub fn read_blocking(&self) -> Option<Vec<u8>> {
+    if self.shared.eof.load(Ordering::SeqCst) {
+      return None;
+    }
 
-    if state.write_pos > state.read_pos {
-      data.extend_from_slice(&state.buffer[state.read_pos..state.write_pos]);
-    } else {
-      data.extend_from_slice(&state.buffer[state.read_pos..]);
-      data.extend_from_slice(&state.buffer[..state.write_pos]);
+    match self.pages.recv() {
+      Ok(page) => {
+        let page = self.take_page(page);
+        if page.is_empty() { None } else { Some(page) }
+      }
+      Err(_) => {
+        self.shared.eof.store(true, Ordering::SeqCst);
+        None
+      }
     }
+  }
 
-    state.read_pos = state.write_pos;
-    state.total_read += data.len() as u64;
+  fn take_page(&self, page: Vec<u8>) -> Vec<u8> {
+    if page.is_empty() {
+      // End-of-stream marker
+      self.shared.eof.store(true, Ordering::SeqCst);
+    } else {
+      self.shared.release(page.len());
+    }
+    page
+  }
 
-    // Notify producer
-    self.not_full.notify_one();
+  /// Check if the buffer is finished and empty
+  pub fn is_eof(&self) -> bool {
+    self.shared.eof.load(Ordering::SeqCst)
+      || (self.shared.finished.load(Ordering::SeqCst)
+        && self.shared.queued_bytes.load(Ordering::SeqCst) == 0)
+  }
 
-    Some(data)
+  /// Get total bytes read
+  pub fn total_read(&self) -> u64 {
+    self.shared.total_read.load(Ordering::Relaxed)
   }
+}
 
-  /// Read data, blocking until data is available or EOF
-  ///
-  /// Returns None on EOF, Some(data) otherwise.
-  pub fn read_blocking(&self) -> Option<Vec<u8>> {
-    loop {
-      let mut state = self.inner.lock().unwrap();
+/// Queue state of a streaming read buffer
+struct StreamingReadState {
+  /// Chunks handed over by the feeder, oldest first
+  chunks: VecDeque<Vec<u8>>,
+  /// Read position within the front chunk
+  offset: usize,
+  /// Unread bytes across all queued chunks
+  queued_bytes: usize,
+  /// Total bytes read by the demuxer
+  total_read: u64,
+  /// The source ended; reads return EOF once the queue drains
+  finished: bool,
+  /// The source failed or loading was cancelled; reads return an error
+  aborted: bool,
+  /// The demuxer side was dropped; the feeder stops pushing
+  closed: bool,
+}
 
-      // Calculate used space
-      let used = if state.write_pos >= state.read_pos {
-        state.write_pos - state.read_pos
-      } else {
-        self.capacity - state.read_pos + state.write_pos
-      };
+struct StreamingReadShared {
+  state: Mutex<StreamingReadState>,
+  data_available: Condvar,
+  space_available: Condvar,
+  capacity: usize,
+}
 
-      if used > 0 {
-        // Data available
-        let mut data = Vec::with_capacity(used);
+/// Bounded chunk queue for demuxing from a non-seekable source
+///
+/// This is the input counterpart of `StreamingBuffer`:
+/// - Feeder (e.g. a JS ReadableStream reader) pushes chunks by ownership
+/// - Consumer (the AVIO read callback) copies out of the queued chunks and
+///   blocks until more data arrives, the source ends, or it is aborted
+/// - Feeder blocks once more than `capacity` bytes are queued, so memory stays
+///   bounded no matter how large the source is
+///
+/// The buffer is forward-only; FFmpeg emulates short forward seeks by reading.
+pub struct StreamingReadBuffer {
+  shared: Arc<StreamingReadShared>,
+}
 
-        if state.write_pos > state.read_pos {
-          data.extend_from_slice(&state.buffer[state.read_pos..state.write_pos]);
-        } else {
-          data.extend_from_slice(&state.buffer[state.read_pos..]);
-          data.extend_from_slice(&state.buffer[..state.write_pos]);
-        }
+impl StreamingReadBuffer {
+  /// Create a new streaming read buffer with specified capacity
+  pub fn new(capacity: usize) -> Self {
+    Self {
+      shared: Arc::new(StreamingReadShared {
+        state: Mutex::new(StreamingReadState {
+          chunks: VecDeque::new(),
+          offset: 0,
+          queued_bytes: 0,
+          total_read: 0,
+          finished: false,
+          aborted: false,
+          closed: false,
+        }),
+        data_available: Condvar::new(),
+        space_available: Condvar::new(),
+        capacity,
+      }),
+    }
+  }
 
-        state.read_pos = state.write_pos;
-        state.total_read += data.len() as u64;
+  /// Get capacity of the buffer
+  pub fn capacity(&self) -> usize {
+    self.shared.capacity
+  }
 
-        // Notify producer
-        self.not_full.notify_one();
+  /// Create a feeder for the producer side
+  pub fn feeder(&self) -> StreamingReadFeeder {
+    StreamingReadFeeder {
+      shared: Arc::clone(&self.shared),
+    }
+  }
 
-        return Some(data);
-      }
+  /// Get total bytes read
+  pub fn total_read(&self) -> u64 {
+    self.shared.state.lock().unwrap().total_read
+  }
+}
 
+impl Read for StreamingReadBuffer {
+  fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+    if buf.is_empty() {
+      return Ok(0);
+    }
+
+    let shared = &*self.shared;
+    let mut state = shared.state.lock().unwrap();
+    loop {
+      if state.aborted {
+        return Err(io::Error::new(
+          io::ErrorKind::ConnectionAborted,
+          "Stream aborted",
+        ));
+      }
+      if state.queued_bytes > 0 {
+        break;
+      }
       if state.finished {
-        return None; // EOF
+        return Ok(0);
       }
+      state = shared.data_available.wait(state).unwrap();
+    }
 
-      // Wait for data
-      state = self.not_empty.wait(state).unwrap();
+    // Copy across as many queued chunks as fit
+    let mut copied = 0;
+    while copied < buf.len() {
+      let offset = state.offset;
+      let Some(front) = state.chunks.front() else {
+        break;
+      };
+      let n = (front.len() - offset).min(buf.len() - copied);
+      buf[copied..copied + n].copy_from_slice(&front[offset..offset + n]);
+      copied += n;
 
-      if state.closed {
-        return None;
+      if offset + n == front.len() {
+        state.chunks.pop_front();
+        state.offset = 0;
+      } else {
+        state.offset += n;
       }
     }
+
+    state.queued_bytes -= copied;
+    state.total_read += copied as u64;
+    shared.space_available.notify_one();
+    Ok(copied)
   }
+}
 
-  /// Check if the buffer is finished and empty
-  pub fn is_eof(&self) -> bool {
-    let state = self.inner.lock().unwrap();
-    let used = if state.write_pos >= state.read_pos {
-      state.write_pos - state.read_pos
-    } else {
-      self.capacity - state.read_pos + state.write_pos
-    };
-    state.finished && used == 0
+impl Drop for StreamingReadBuffer {
+  fn drop(&mut self) {
+    let mut state = self.shared.state.lock().unwrap();
+    state.closed = true;
+    state.chunks.clear();
+    state.queued_bytes = 0;
+    self.shared.space_available.notify_all();
   }
+}
 
-  /// Get total bytes read
-  pub fn total_read(&self) -> u64 {
-    let state = self.inner.lock().unwrap();
-    state.total_read
+impl std::fmt::Debug for StreamingReadBuffer {
+  fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+    f.debug_struct("StreamingReadBuffer")
+      .field("capacity", &self.shared.capacity)
+      .finish()
+  }
+}
+
+/// Handle for the producer side of a streaming read buffer
+#[derive(Clone)]
+pub struct StreamingReadFeeder {
+  shared: Arc<StreamingReadShared>,
+}
+
+impl StreamingReadFeeder {
+  /// Queue a chunk, blocking while the buffer is full
+  ///
+  /// A chunk larger than the capacity is accepted once the buffer is empty.
+  /// Returns an error once the consumer is gone or the buffer was aborted.
+  pub fn push_blocking(&self, chunk: Vec<u8>) -> io::Result<()> {
+    if chunk.is_empty() {
+      return Ok(());
+    }
+
+    let shared = &*self.shared;
+    let mut state = shared.state.lock().unwrap();
+    loop {
+      if state.closed || state.aborted {
+        return Err(io::Error::new(io::ErrorKind::BrokenPipe, "Buffer closed"));
+      }
+      if state.queued_bytes == 0 || state.queued_bytes + chunk.len() <= shared.capacity {
+        break;
+      }
+      state = shared.space_available.wait(state).unwrap();
+    }
+
+    state.queued_bytes += chunk.len();
+    state.chunks.push_back(chunk);
+    shared.data_available.notify_one();
+    Ok(())
+  }
+
+  /// Signal that the source has ended
+  pub fn finish(&self) {
+    let mut state = self.shared.state.lock().unwrap();
+    state.finished = true;
+    self.shared.data_available.notify_all();
+  }
+
+  /// Fail pending and future reads, and stop the feeder
+  pub fn abort(&self) {
+    let mut state = self.shared.state.lock().unwrap();
+    state.aborted = true;
+    self.shared.data_available.notify_all();
+    self.shared.space_available.notify_all();
+  }
+
+  /// Check if the consumer side has been dropped
+  pub fn is_closed(&self) -> bool {
+    self.shared.state.lock().unwrap().closed
   }
 }
 
@@ -584,6 +855,30 @@ impl StreamingBufferHandle {
 mod tests {
   use super::*;
 
+  #[test]
+  fn test_mapped_file_read_and_seek() {
+    let path = std::env::temp_dir().join(format!("webcodecs-mmap-{}.bin", std::process::id()));
+    std::fs::write(&path, b"mapped file contents").unwrap();
+
+    let mapped = MappedFile::open(&path).unwrap();
+    assert_eq!(mapped.len(), 20);
+
+    let mut buf = ReadOnlyBuffer::new(mapped);
+    buf.seek(SeekFrom::Start(7)).unwrap();
+    let mut out = [0u8; 4];
+    buf.read_exact(&mut out).unwrap();
+    assert_eq!(&out, b"file");
+    drop(buf);
+
+    // Empty files map to an empty source instead of failing
+    std::fs::write(&path, b"").unwrap();
+    let empty = MappedFile::open(&path).unwrap();
+    assert!(empty.is_empty());
+    assert_eq!(ReadOnlyBuffer::new(empty).len(), 0);
+
+    std::fs::remove_file(&path).unwrap();
+  }
+
   #[test]
   fn test_memory_buffer_write_read() {
     let mut buf = MemoryBuffer::new();
@@ -675,4 +970,142 @@ mod tests {
     let data = handle.read_available().unwrap();
     assert_eq!(&data, b"5678");
   }
+
+  #[test]
+  fn test_streaming_buffer_read_available_joins_pages() {
+    let buf = StreamingBuffer::new(8);
+    let handle = buf.clone_handle();
+
+    buf.write_blocking(b"1234").unwrap();
+    buf.write_blocking(b"5678").unwrap();
+    buf.finish();
+
+    assert_eq!(handle.read_available().unwrap(), b"12345678");
+    assert!(handle.read_available().is_none());
+    assert!(handle.is_eof());
+    assert_eq!(handle.total_read(), 8);
+  }
+
+  #[test]
+  fn test_streaming_buffer_pages_keep_write_boundaries() {
+    let buf = StreamingBuffer::new(8);
+    let handle = buf.clone_handle();
+
+    buf.write_blocking(b"1234").unwrap();
+    buf.write_blocking(b"5678").unwrap();
+
+    assert_eq!(handle.read_page().unwrap(), b"1234");
+    assert_eq!(handle.read_page().unwrap(), b"5678");
+    assert!(handle.read_page().unwrap().is_empty());
+
+    buf.finish();
+    assert!(handle.read_page().is_none());
+  }
+
+  #[test]
+  fn test_streaming_buffer_backpressure() {
+    let buf = Arc::new(StreamingBuffer::new(8));
+    let handle = buf.clone_handle();
+
+    buf.write_blocking(b"12345678").unwrap();
+
+    // The next page doesn't fit until the consumer takes the first one
+    let producer = {
+      let buf = Arc::clone(&buf);
+      std::thread::spawn(move || {
+        buf.write_blocking(b"abcd").unwrap();
+        buf.finish();
+      })
+    };
+
+    assert_eq!(handle.read_blocking().unwrap(), b"12345678");
+    assert_eq!(handle.read_blocking().unwrap(), b"abcd");
+    assert!(handle.read_blocking().is_none());
+    producer.join().unwrap();
+    assert_eq!(buf.total_written(), 12);
+  }
+
+  #[test]
+  fn test_streaming_buffer_close_unblocks_producer() {
+    let buf = Arc::new(StreamingBuffer::new(4));
+    let _handle = buf.clone_handle();
+    buf.write_blocking(b"full").unwrap();
+
+    let producer = {
+      let buf = Arc::clone(&buf);
+      std::thread::spawn(move || buf.write_blocking(b"more"))
+    };
+
+    std::thread::sleep(std::time::Duration::from_millis(20));
+    buf.close();
+    assert!(producer.join().unwrap().is_err());
+  }
+
+  #[test]
+  fn test_streaming_read_buffer_basic() {
+    let mut buf = StreamingReadBuffer::new(16);
+    let feeder = buf.feeder();
+
+    feeder.push_blocking(b"hello ".to_vec()).unwrap();
+    feeder.push_blocking(b"world".to_vec()).unwrap();
+    feeder.finish();
+
+    // Reads span chunk boundaries
+    let mut out = [0u8; 8];
+    assert_eq!(buf.read(&mut out).unwrap(), 8);
+    assert_eq!(&out, b"hello wo");
+    assert_eq!(buf.read(&mut out).unwrap(), 3);
+    assert_eq!(&out[..3], b"rld");
+    assert_eq!(buf.read(&mut out).unwrap(), 0);
+    assert_eq!(buf.total_read(), 11);
+  }
+
+  #[test]
+  fn test_streaming_read_buffer_backpressure() {
+    let mut buf = StreamingReadBuffer::new(8);
+    let feeder = buf.feeder();
+    feeder.push_blocking(b"12345678".to_vec()).unwrap();
+
+    // The next chunk doesn't fit until the consumer drains the first one
+    let producer = std::thread::spawn(move || {
+      feeder.push_blocking(b"abcd".to_vec()).unwrap();
+      feeder.finish();
+    });
+
+    let mut out = Vec::new();
+    buf.read_to_end(&mut out).unwrap();
+    assert_eq!(out, b"12345678abcd");
+    producer.join().unwrap();
+  }
+
+  #[test]
+  fn test_streaming_read_buffer_abort_and_close() {
+    let mut buf = StreamingReadBuffer::new(4);
+    let feeder = buf.feeder();
+
+    // Abort wakes a blocked reader with an error
+    let aborter = {
+      let feeder = feeder.clone();
+      std::thread::spawn(move || {
+        std::thread::sleep(std::time::Duration::from_millis(20));
+        feeder.abort();
+      })
+    };
+    let mut out = [0u8; 4];
+    assert!(buf.read(&mut out).is_err());
+    aborter.join().unwrap();
+
+    // Dropping the consumer unblocks and stops the feeder
+    let buf = StreamingReadBuffer::new(4);
+    let feeder = buf.feeder();
+    feeder.push_blocking(b"full".to_vec()).unwrap();
+    let producer = {
+      let feeder = feeder.clone();
+      std::thread::spawn(move || feeder.push_blocking(b"more".to_vec()))
+    };
+    std::thread::sleep(std::time::Duration::from_millis(20));
+    drop(buf);
+    assert!(producer.join().unwrap().is_err());
+    assert!(feeder.is_closed());
+  }
 }
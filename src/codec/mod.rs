@@ -5,26 +5,39 @@
 
 pub mod audio_buffer;
 pub mod avio_context;
+pub mod bitstream;
 pub mod context;
 pub mod demuxer;
+pub mod fast_convert;
 pub mod frame;
+pub mod frame_memory;
+pub mod frame_pool;
 pub mod hwdevice;
 pub mod hwframes;
 pub mod io_buffer;
 pub mod mp4_faststart;
 pub mod muxer;
 pub mod packet;
+pub mod probe;
 pub mod resampler;
 pub mod scaler;
+pub mod seek_index;
+pub mod segmenter;
+pub mod stats;
+pub mod thread_budget;
 
 pub use audio_buffer::AudioSampleBuffer;
 pub use context::{CodecContext, CodecType, DecoderCreationResult, EncoderCreationResult};
 pub use frame::Frame;
+pub use frame_pool::{FramePool, FramePoolStats};
 pub use hwdevice::HwDeviceContext;
-pub use hwframes::{HwFrameConfig, HwFrameContext, download_hw_frame};
+pub use hwframes::{
+  HwFrameConfig, HwFrameContext, SurfaceBudget, SurfaceLease, download_hw_frame, hw_frame_sw_format,
+};
 pub use packet::Packet;
 pub use resampler::Resampler;
 pub use scaler::{ScaleAlgorithm, Scaler};
+pub use stats::{CodecStats, Stage};
 
 use crate::ffi::{AVCodecID, AVPixelFormat, AVSampleFormat};
 
@@ -125,6 +138,18 @@ pub struct DecoderConfig {
   pub width: Option<u32>,
   /// Video coded height (for hardware decoding - may be required for some platforms)
   pub height: Option<u32>,
+  /// Reduced-resolution decode factor: frames come out at 1/2^lowres of the
+  /// coded size (0 = full size). Clamped to what the decoder supports.
+  pub lowres: u8,
+  /// Frames the decoder skips (`ffi::accessors::discard` level, DEFAULT = none)
+  pub skip_frame: i32,
+  /// Frames decoded without the in-loop deblocking filter (`discard` level)
+  pub skip_loop_filter: i32,
+  /// Allow non-spec-compliant speedups (AV_CODEC_FLAG2_FAST)
+  pub fast: bool,
+  /// Surfaces a hardware decoder allocates beyond its own needs, for frames
+  /// the application holds on to (AVCodecContext.extra_hw_frames)
+  pub extra_hw_frames: u32,
 }
 
 impl Default for DecoderConfig {
@@ -136,10 +161,32 @@ impl Default for DecoderConfig {
       low_latency: false,
       width: None,
       height: None,
+      lowres: 0,
+      skip_frame: 0,
+      skip_loop_filter: 0,
+      fast: false,
+      extra_hw_frames: 0,
     }
   }
 }
 
+impl DecoderConfig {
+  /// Largest lowres factor that still decodes `coded` to at least `target`
+  /// in both dimensions, so only a downscale is left for the scaler.
+  /// FFmpeg decoders support at most 3 (1/8 size).
+  pub fn lowres_for_size(coded: (u32, u32), target: (u32, u32)) -> u8 {
+    let mut lowres = 0;
+    while lowres < 3 {
+      let next = 1u32 << (lowres + 1);
+      if coded.0.div_ceil(next) < target.0 || coded.1.div_ceil(next) < target.1 {
+        break;
+      }
+      lowres += 1;
+    }
+    lowres
+  }
+}
+
 /// Audio encoder configuration
 #[derive(Debug, Clone)]
 pub struct AudioEncoderConfig {
@@ -226,6 +273,13 @@ pub enum CodecError {
 
   #[error("Hardware acceleration error: {0}")]
   HardwareError(String),
+
+  #[error("Frame memory budget exceeded: {requested} bytes requested, {live} of {limit} in use")]
+  MemoryBudgetExceeded {
+    requested: u64,
+    live: u64,
+    limit: u64,
+  },
 }
 
 pub type CodecResult<T> = Result<T, CodecError>;
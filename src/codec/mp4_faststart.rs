@@ -3,6 +3,10 @@
 //! This module provides functionality to move the moov atom to the beginning
 //! of an MP4 file for faster streaming playback. This is necessary because
 //! FFmpeg's faststart option doesn't work with custom I/O contexts.
+//!
+//! The rewrite happens in place: moov is the only box that gets copied, the
+//! media data is shifted inside the finalized buffer. Peak memory is therefore
+//! the file size plus the moov size rather than twice the file size.
 
 use std::io::{Cursor, Read, Seek, SeekFrom};
 
@@ -13,18 +17,18 @@ use std::io::{Cursor, Read, Seek, SeekFrom};
 ///
 /// Returns the modified MP4 data, or the original data if moov is already
 /// at the beginning or if parsing fails.
-pub fn apply_faststart(data: Vec<u8>) -> Vec<u8> {
-  match apply_faststart_inner(&data) {
-    Ok(result) => result,
-    Err(e) => {
-      tracing::warn!(target: "ffmpeg", "faststart post-processing failed: {}, returning original data", e);
-      data
-    }
+pub fn apply_faststart(mut data: Vec<u8>) -> Vec<u8> {
+  if let Err(e) = apply_faststart_in_place(&mut data) {
+    tracing::warn!(target: "ffmpeg", "faststart post-processing failed: {}, returning original data", e);
   }
+  data
 }
 
 /// Internal faststart implementation
-fn apply_faststart_inner(data: &[u8]) -> Result<Vec<u8>, FastStartError> {
+///
+/// Every fallible step runs before the first byte is moved, so `data` is left
+/// untouched on error.
+fn apply_faststart_in_place(data: &mut [u8]) -> Result<(), FastStartError> {
   let atoms = parse_atoms(data)?;
 
   // Find ftyp, moov, and mdat atoms
@@ -38,14 +42,21 @@ fn apply_faststart_inner(data: &[u8]) -> Result<Vec<u8>, FastStartError> {
   // Check if moov is already before mdat
   if moov.offset < mdat.offset {
     tracing::trace!(target: "ffmpeg", "moov already before mdat, no faststart needed");
-    return Ok(data.to_vec());
+    return Ok(());
   }
 
-  tracing::trace!(target: "ffmpeg", "applying faststart: moov at {}, mdat at {}", moov.offset, mdat.offset);
+  // Layout will be: ftyp | moov | atoms that preceded moov | atoms after moov
+  let ftyp_end = match ftyp {
+    Some(ftyp) if ftyp.offset == 0 => ftyp.size,
+    Some(_) => {
+      return Err(FastStartError::UnsupportedLayout(
+        "ftyp is not the first atom",
+      ));
+    }
+    None => 0,
+  };
 
-  // Calculate the new positions
-  // Layout will be: ftyp | moov | mdat | other atoms
-  let _ftyp_end = ftyp.map(|f| f.offset + f.size).unwrap_or(0);
+  tracing::trace!(target: "ffmpeg", "applying faststart: moov at {}, mdat at {}", moov.offset, mdat.offset);
 
   // The offset adjustment for chunk offsets:
   // Original: chunks point to data in mdat at its old position
@@ -57,26 +68,13 @@ fn apply_faststart_inner(data: &[u8]) -> Result<Vec<u8>, FastStartError> {
   let moov_data = &data[moov.offset..moov.offset + moov.size];
   let updated_moov = update_chunk_offsets(moov_data, offset_adjustment)?;
 
-  // Build the new file
-  let mut result = Vec::with_capacity(data.len());
-
-  // Write ftyp (if present)
-  if let Some(ftyp) = ftyp {
-    result.extend_from_slice(&data[ftyp.offset..ftyp.offset + ftyp.size]);
-  }
-
-  // Write updated moov
-  result.extend_from_slice(&updated_moov);
-
-  // Write all other atoms in their original order (except moov and ftyp)
-  for atom in &atoms {
-    if &atom.atom_type != b"moov" && &atom.atom_type != b"ftyp" {
-      result.extend_from_slice(&data[atom.offset..atom.offset + atom.size]);
-    }
-  }
+  // Shift everything between ftyp and moov forward over the old moov, then
+  // write the updated moov into the gap this opens up after ftyp
+  data.copy_within(ftyp_end..moov.offset, ftyp_end + moov.size);
+  data[ftyp_end..ftyp_end + moov.size].copy_from_slice(&updated_moov);
 
-  tracing::trace!(target: "ffmpeg", "faststart complete: {} -> {} bytes", data.len(), result.len());
-  Ok(result)
+  tracing::trace!(target: "ffmpeg", "faststart complete: {} bytes, moov {} bytes", data.len(), moov.size);
+  Ok(())
 }
 
 /// Parsed atom information
@@ -212,7 +210,9 @@ fn update_stco(data: &mut [u8], adjustment: i64) -> Result<(), FastStartError> {
   for i in 0..entry_count {
     let offset_pos = 16 + i * 4;
     let old_offset = u32::from_be_bytes(data[offset_pos..offset_pos + 4].try_into().unwrap());
-    let new_offset = (old_offset as i64 + adjustment) as u32;
+    // A shifted offset past 4 GiB would need co64; keep the original layout instead
+    let new_offset =
+      u32::try_from(old_offset as i64 + adjustment).map_err(|_| FastStartError::OffsetOverflow)?;
     data[offset_pos..offset_pos + 4].copy_from_slice(&new_offset.to_be_bytes());
   }
 
@@ -261,6 +261,12 @@ pub enum FastStartError {
   #[error("Invalid atom size")]
   InvalidAtomSize,
 
+  #[error("Chunk offset does not fit in stco after moving moov")]
+  OffsetOverflow,
+
+  #[error("Unsupported atom layout: {0}")]
+  UnsupportedLayout(&'static str),
+
   #[error("I/O error: {0}")]
   Io(#[from] std::io::Error),
 }
@@ -296,4 +302,72 @@ mod tests {
     assert_eq!(&atoms[1].atom_type, b"mdat");
     assert_eq!(&atoms[2].atom_type, b"moov");
   }
+
+  /// Wrap `children` in a box of type `atom_type`
+  fn make_atom(atom_type: &[u8; 4], children: &[u8]) -> Vec<u8> {
+    let mut atom = ((children.len() + 8) as u32).to_be_bytes().to_vec();
+    atom.extend_from_slice(atom_type);
+    atom.extend_from_slice(children);
+    atom
+  }
+
+  #[test]
+  fn test_faststart_moves_moov_in_place() {
+    let mut ftyp = Vec::new();
+    ftyp.extend_from_slice(b"isom");
+    ftyp.extend_from_slice(&0x200u32.to_be_bytes());
+    ftyp.extend_from_slice(b"isom");
+    let ftyp = make_atom(b"ftyp", &ftyp);
+    let mdat = make_atom(b"mdat", b"testdata");
+
+    // stco: version/flags, one entry pointing at the mdat payload
+    let mut stco = vec![0u8; 4];
+    stco.extend_from_slice(&1u32.to_be_bytes());
+    stco.extend_from_slice(&((ftyp.len() + 8) as u32).to_be_bytes());
+    let stco = make_atom(b"stco", &stco);
+    let moov = make_atom(
+      b"moov",
+      &make_atom(
+        b"trak",
+        &make_atom(b"mdia", &make_atom(b"minf", &make_atom(b"stbl", &stco))),
+      ),
+    );
+
+    let mut data = ftyp.clone();
+    data.extend_from_slice(&mdat);
+    data.extend_from_slice(&moov);
+    let original_len = data.len();
+
+    let result = apply_faststart(data);
+    assert_eq!(result.len(), original_len);
+
+    let atoms = parse_atoms(&result).unwrap();
+    let types: Vec<_> = atoms.iter().map(|a| a.atom_type).collect();
+    assert_eq!(types, vec![*b"ftyp", *b"moov", *b"mdat"]);
+
+    // The chunk offset was shifted by the moov size and still hits the payload
+    let stco_entry_pos = atoms[1].offset + atoms[1].size - 4;
+    let chunk_offset = u32::from_be_bytes(
+      result[stco_entry_pos..stco_entry_pos + 4]
+        .try_into()
+        .unwrap(),
+    ) as usize;
+    assert_eq!(chunk_offset, ftyp.len() + moov.len() + 8);
+    assert_eq!(&result[chunk_offset..chunk_offset + 8], b"testdata");
+  }
+
+  #[test]
+  fn test_faststart_overflow_keeps_original() {
+    let mdat = make_atom(b"mdat", b"testdata");
+    let mut stco = vec![0u8; 4];
+    stco.extend_from_slice(&1u32.to_be_bytes());
+    stco.extend_from_slice(&u32::MAX.to_be_bytes());
+    let moov = make_atom(b"moov", &make_atom(b"stco", &stco));
+
+    let mut data = mdat;
+    data.extend_from_slice(&moov);
+    let original = data.clone();
+
+    assert_eq!(apply_faststart(data), original);
+  }
 }
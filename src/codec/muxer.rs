@@ -13,7 +13,7 @@ use crate::ffi::accessors::{
   ffstream_get_codecpar, ffstream_get_index, ffstream_get_time_base, ffstream_set_time_base,
 };
 use crate::ffi::avformat::{
-  AVFormatContext, av_interleaved_write_frame, av_write_trailer, avfmt_flag,
+  AVFormatContext, av_interleaved_write_frame, av_write_frame, av_write_trailer, avfmt_flag,
   avformat_alloc_output_context2, avformat_free_context, avformat_new_stream,
   avformat_write_header, media_type,
 };
@@ -111,6 +111,10 @@ pub struct MuxerOptions {
   /// Enable live streaming mode for WebM/MKV
   /// When enabled, clusters are output as soon as complete (cluster-at-a-time)
   pub live: bool,
+  /// Segmenting mode: fragments (MP4) are only cut by `flush_fragment`, and
+  /// WebM/MKV clusters only at `flush_fragment` or a video keyframe, so the
+  /// output between two cuts can be handed out as a media segment
+  pub segmented: bool,
 }
 
 /// Muxer context wrapper
@@ -340,7 +344,13 @@ impl MuxerContext {
         // negative_cts_offsets: Use CTTS version 1 with signed composition offsets.
         // This allows proper B-frame timing without destroying PTS/DTS relationship.
         // Chromium and modern players support signed CTS offsets (int32).
-        let movflags = if opts.fragmented {
+        //
+        // Segmented output is CMAF: one fragment per segment, cut by
+        // flush_fragment (frag_custom), and no mfra index at the end since
+        // segments are addressed by the playlist instead.
+        let movflags = if opts.segmented {
+          "frag_custom+empty_moov+default_base_moof+cmaf+skip_trailer+negative_cts_offsets"
+        } else if opts.fragmented {
           "frag_keyframe+empty_moov+default_base_moof+negative_cts_offsets"
         } else if opts.fast_start {
           "faststart+negative_cts_offsets"
@@ -354,13 +364,25 @@ impl MuxerContext {
           crate::ffi::avutil::av_dict_set(&mut dict_ptr, key.as_ptr(), value.as_ptr(), 0);
         }
       } else if (self.format == ContainerFormat::WebM || self.format == ContainerFormat::Mkv)
-        && opts.live
+        && (opts.live || opts.segmented)
       {
         // For WebM/Matroska, enable live mode for cluster-at-a-time output
-        let key = CString::new("live").unwrap();
-        let value = CString::new("1").unwrap();
-        unsafe {
-          crate::ffi::avutil::av_dict_set(&mut dict_ptr, key.as_ptr(), value.as_ptr(), 0);
+        let mut entries = vec![("live", "1")];
+        if opts.segmented {
+          // Lift the size/time limits (32KB/1s on non-seekable output) so
+          // clusters only end at flush_fragment or at a video keyframe (which
+          // matroskaenc always starts a new cluster on once the open one
+          // passes 4KB). A segment is then one or more whole clusters, each
+          // starting with a keyframe.
+          entries.push(("cluster_size_limit", "2147483647"));
+          entries.push(("cluster_time_limit", "86400000"));
+        }
+        for (key, value) in entries {
+          let key = CString::new(key).unwrap();
+          let value = CString::new(value).unwrap();
+          unsafe {
+            crate::ffi::avutil::av_dict_set(&mut dict_ptr, key.as_ptr(), value.as_ptr(), 0);
+          }
         }
       }
     }
@@ -422,6 +444,34 @@ impl MuxerContext {
     Ok(())
   }
 
+  /// End the current fragment (MP4) or cluster (WebM/MKV)
+  ///
+  /// Drains the interleaving queue, asks the muxer to write out what it
+  /// buffered for the open fragment, and flushes the I/O context, so every
+  /// packet written so far has reached the output.
+  pub fn flush_fragment(&mut self) -> Result<(), CodecError> {
+    self.flush()?;
+    if !self.header_written || self.finalized {
+      return Ok(());
+    }
+
+    // A NULL packet is a flush request for muxers with AVFMT_ALLOW_FLUSH
+    let ret = unsafe { av_write_frame(self.ptr.as_ptr(), ptr::null_mut()) };
+    if ret < 0 {
+      return Err(CodecError::Ffmpeg(crate::ffi::FFmpegError::from_code(ret)));
+    }
+
+    self.flush_io();
+    Ok(())
+  }
+
+  /// Flush the I/O context so buffered bytes reach the output
+  pub fn flush_io(&self) {
+    if let Some(ref io) = self.io_ctx {
+      io.flush();
+    }
+  }
+
   /// Finalize the muxer (write trailer)
   ///
   /// Must be called after all packets have been written.
@@ -510,6 +560,25 @@ impl MuxerContext {
     }
   }
 
+  /// Get audio stream time_base (after header is written)
+  /// Returns None if no audio stream or header not written yet
+  pub fn audio_time_base(&self) -> Option<AVRational> {
+    if !self.header_written {
+      return None;
+    }
+    let stream_idx = self.audio_stream_index?;
+    unsafe {
+      let stream = fffmt_get_stream(self.ptr.as_ptr(), stream_idx as u32);
+      if stream.is_null() {
+        return None;
+      }
+      let mut num: i32 = 0;
+      let mut den: i32 = 0;
+      ffstream_get_time_base(stream, &mut num, &mut den);
+      Some(AVRational::new(num, den))
+    }
+  }
+
   /// Check if header has been written
   pub fn is_header_written(&self) -> bool {
     self.header_written
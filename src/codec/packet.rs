@@ -11,7 +11,7 @@ use crate::ffi::{
   },
   avcodec::{
     av_new_packet, av_packet_alloc, av_packet_free, av_packet_get_side_data,
-    av_packet_new_side_data, av_packet_ref, av_packet_unref,
+    av_packet_make_writable, av_packet_new_side_data, av_packet_ref, av_packet_unref,
   },
   pkt_flag, pkt_side_data_type,
 };
@@ -81,6 +81,22 @@ impl Packet {
     }
   }
 
+  /// Get packet data as a mutable slice
+  ///
+  /// Copies the data first if the buffer is shared with another packet
+  /// (e.g. after `shallow_clone`), so other references never see the change.
+  pub fn as_mut_slice(&mut self) -> Result<&mut [u8], CodecError> {
+    let ret = unsafe { av_packet_make_writable(self.as_mut_ptr()) };
+    ffi::check_error(ret)?;
+    let ptr = self.data() as *mut u8;
+    let size = self.size();
+    if ptr.is_null() || size == 0 {
+      Ok(&mut [])
+    } else {
+      Ok(unsafe { std::slice::from_raw_parts_mut(ptr, size as usize) })
+    }
+  }
+
   /// Get packet size in bytes
   #[inline]
   pub fn size(&self) -> i32 {
@@ -0,0 +1,96 @@
+//! Memoized codec availability probes
+//!
+//! `isConfigSupported()` answers "can this codec be opened" by allocating a
+//! codec context. The answer mostly depends on how FFmpeg was built, so a
+//! positive answer is kept for the lifetime of the process. A negative one
+//! may be transient (e.g. an allocation failure) and is only kept for
+//! `FAILED_PROBE_TTL`.
+
+use std::collections::HashMap;
+use std::sync::{Mutex, OnceLock};
+use std::time::{Duration, Instant};
+
+use crate::ffi::AVCodecID;
+
+use super::CodecContext;
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+enum Probe {
+  Encoder(AVCodecID),
+  EncoderByName(String),
+  Decoder(AVCodecID),
+}
+
+/// How long a failed probe (codec or hardware device) is remembered
+pub(crate) const FAILED_PROBE_TTL: Duration = Duration::from_secs(30);
+
+/// Probe results and when they were computed
+fn probes() -> &'static Mutex<HashMap<Probe, (bool, Instant)>> {
+  static PROBES: OnceLock<Mutex<HashMap<Probe, (bool, Instant)>>> = OnceLock::new();
+  PROBES.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+fn memoized(probe: Probe, check: impl FnOnce() -> bool) -> bool {
+  if let Some(&(available, _)) = probes()
+    .lock()
+    .unwrap_or_else(|poisoned| poisoned.into_inner())
+    .get(&probe)
+    .filter(|(available, at)| *available || at.elapsed() < FAILED_PROBE_TTL)
+  {
+    return available;
+  }
+
+  // Probe outside the lock; a concurrent probe of the same codec gets the
+  // same answer
+  let available = check();
+  probes()
+    .lock()
+    .unwrap_or_else(|poisoned| poisoned.into_inner())
+    .insert(probe, (available, Instant::now()));
+  available
+}
+
+/// Whether an encoder for `codec_id` can be created
+pub fn encoder_available(codec_id: AVCodecID) -> bool {
+  memoized(Probe::Encoder(codec_id), || {
+    CodecContext::new_encoder(codec_id).is_ok()
+  })
+}
+
+/// Whether the encoder named `name` (e.g. "libopus") can be created
+pub fn encoder_available_by_name(name: &str) -> bool {
+  memoized(Probe::EncoderByName(name.to_string()), || {
+    CodecContext::new_encoder_by_name(name).is_ok()
+  })
+}
+
+/// Whether a decoder for `codec_id` can be created
+pub fn decoder_available(codec_id: AVCodecID) -> bool {
+  memoized(Probe::Decoder(codec_id), || {
+    CodecContext::new_decoder(codec_id).is_ok()
+  })
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[test]
+  fn test_probe_is_memoized() {
+    let probe = Probe::EncoderByName("test-only-probe".to_string());
+    assert!(memoized(probe.clone(), || true));
+    // Second probe is answered from the memo
+    assert!(memoized(probe, || unreachable!()));
+  }
+
+  #[test]
+  fn test_failed_probe_expires() {
+    let probe = Probe::EncoderByName("test-only-failed-probe".to_string());
+    assert!(!memoized(probe.clone(), || false));
+    assert!(!memoized(probe.clone(), || unreachable!()));
+
+    // Once the failure is older than the TTL the codec is probed again
+    probes().lock().unwrap().get_mut(&probe).unwrap().1 -= FAILED_PROBE_TTL;
+    assert!(memoized(probe, || true));
+  }
+}
@@ -1,14 +1,34 @@
 //! Safe wrapper around FFmpeg SwsContext
 //!
 //! Provides pixel format conversion and image scaling functionality.
+//!
+//! Large conversions can be split across threads: with a thread count other
+//! than 1, swscale's slice threading divides the destination into horizontal
+//! bands and scales them in parallel. The count comes from
+//! `Scaler::with_threads`, or from the process-wide default
+//! (`set_default_threads`) for `Scaler::new`.
+//!
+//! swscale runs the bands on a slice-thread pool private to each context and
+//! can't share one between contexts, so every threaded scaler owns its
+//! threads. An automatic count (0) is therefore leased from the codec thread
+//! budget (see `thread_budget`) instead of taking one thread per core, and
+//! returned when the scaler is dropped; explicit counts are used as given.
 
 use crate::ffi::{
   AVPixelFormat, SwsContext,
-  swscale::{sws_freeContext, sws_getContext, sws_scale},
+  avutil::av_opt_set_int,
+  swscale::{
+    sws_alloc_context, sws_freeContext, sws_getContext, sws_init_context, sws_scale,
+    sws_scale_frame,
+  },
 };
+use std::ffi::CStr;
 use std::ptr::NonNull;
+use std::sync::atomic::{AtomicU32, Ordering};
 
-use super::{CodecError, CodecResult, Frame};
+use super::fast_convert::FastConversion;
+use super::thread_budget::{self, ThreadLease, ThreadWorkload};
+use super::{CodecError, CodecResult, Frame, FramePool};
 
 /// Scaling algorithm
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
@@ -39,6 +59,22 @@ impl ScaleAlgorithm {
   }
 }
 
+/// Process-wide scaler thread count used by `Scaler::new` (1 = single-threaded)
+static DEFAULT_THREADS: AtomicU32 = AtomicU32::new(1);
+
+/// Set the thread count used by scalers created with `Scaler::new`
+///
+/// 0 leases a thread count from the codec thread budget for each scaler.
+/// Existing scalers keep the count they were created with.
+pub fn set_default_threads(threads: u32) {
+  DEFAULT_THREADS.store(threads, Ordering::Relaxed);
+}
+
+/// Get the thread count used by scalers created with `Scaler::new`
+pub fn default_threads() -> u32 {
+  DEFAULT_THREADS.load(Ordering::Relaxed)
+}
+
 /// Safe wrapper around SwsContext for pixel format conversion and scaling
 pub struct Scaler {
   ptr: NonNull<SwsContext>,
@@ -48,10 +84,20 @@ pub struct Scaler {
   dst_width: u32,
   dst_height: u32,
   dst_format: AVPixelFormat,
+  /// Dedicated kernel for same-size RGBA/BGRA ↔ I420/NV12 (swscale otherwise)
+  fast_path: Option<FastConversion>,
+  /// Requested slice threads (1 = single-threaded, 0 = from the budget)
+  threads: u32,
+  /// Slice threads the context actually runs
+  slice_threads: u32,
+  /// Budget threads held by an automatic thread count
+  thread_lease: Option<ThreadLease>,
 }
 
 impl Scaler {
   /// Create a new scaler for the given conversion
+  ///
+  /// Uses the process-wide default thread count (see `set_default_threads`).
   pub fn new(
     src_width: u32,
     src_height: u32,
@@ -61,19 +107,80 @@ impl Scaler {
     dst_format: AVPixelFormat,
     algorithm: ScaleAlgorithm,
   ) -> CodecResult<Self> {
-    let ptr = unsafe {
-      sws_getContext(
-        src_width as i32,
-        src_height as i32,
-        src_format.as_raw(),
-        dst_width as i32,
-        dst_height as i32,
-        dst_format.as_raw(),
-        algorithm.to_sws_flags(),
-        std::ptr::null_mut(),
-        std::ptr::null_mut(),
-        std::ptr::null(),
-      )
+    Self::with_threads(
+      src_width,
+      src_height,
+      src_format,
+      dst_width,
+      dst_height,
+      dst_format,
+      algorithm,
+      default_threads(),
+    )
+  }
+
+  /// Create a new scaler that splits each conversion across `threads` slice threads
+  ///
+  /// 1 keeps the conversion on the calling thread; 0 leases a share of the
+  /// codec thread budget (one thread per core when the budget is disabled).
+  #[allow(clippy::too_many_arguments)]
+  pub fn with_threads(
+    src_width: u32,
+    src_height: u32,
+    src_format: AVPixelFormat,
+    dst_width: u32,
+    dst_height: u32,
+    dst_format: AVPixelFormat,
+    algorithm: ScaleAlgorithm,
+    threads: u32,
+  ) -> CodecResult<Self> {
+    let thread_lease = if threads == 0 {
+      thread_budget::lease(ThreadWorkload::scaler(dst_width, dst_height))
+    } else {
+      None
+    };
+    let slice_threads = match (&thread_lease, threads) {
+      (Some(lease), _) => lease.thread_count() as u32,
+      (None, 0) => std::thread::available_parallelism().map_or(1, |n| n.get() as u32),
+      (None, threads) => threads,
+    };
+    // A single slice thread runs on the caller, so it costs the budget nothing
+    let thread_lease = thread_lease.filter(|_| slice_threads > 1);
+
+    let ptr = if slice_threads == 1 {
+      unsafe {
+        sws_getContext(
+          src_width as i32,
+          src_height as i32,
+          src_format.as_raw(),
+          dst_width as i32,
+          dst_height as i32,
+          dst_format.as_raw(),
+          algorithm.to_sws_flags(),
+          std::ptr::null_mut(),
+          std::ptr::null_mut(),
+          std::ptr::null(),
+        )
+      }
+    } else {
+      unsafe {
+        alloc_threaded_context(
+          src_width,
+          src_height,
+          src_format,
+          dst_width,
+          dst_height,
+          dst_format,
+          algorithm,
+          slice_threads,
+        )
+      }
+    };
+
+    let fast_path = if src_width == dst_width && src_height == dst_height {
+      FastConversion::for_formats(src_format, dst_format)
+    } else {
+      None
     };
 
     NonNull::new(ptr)
@@ -85,6 +192,10 @@ impl Scaler {
         dst_width,
         dst_height,
         dst_format,
+        fast_path,
+        threads,
+        slice_threads,
+        thread_lease,
       })
       .ok_or(CodecError::InvalidConfig(format!(
         "Cannot create scaler from {:?} {}x{} to {:?} {}x{}",
@@ -112,7 +223,8 @@ impl Scaler {
 
   /// Scale/convert a frame
   ///
-  /// The destination frame must already have buffers allocated with the correct format/dimensions
+  /// The destination frame must already have buffers allocated with the correct format/dimensions.
+  /// Same-size RGBA/BGRA ↔ I420/NV12 conversions use the `fast_convert` kernels.
   pub fn scale(&self, src: &Frame, dst: &mut Frame) -> CodecResult<()> {
     // Verify dimensions match
     if src.width() != self.src_width
@@ -125,6 +237,34 @@ impl Scaler {
       ));
     }
 
+    if !self.fast_path.is_some_and(|fast| fast.convert(src, dst)) {
+      self.scale_with_swscale(src, dst)?;
+    }
+
+    // Copy metadata from source
+    dst.set_pts(src.pts());
+    dst.set_duration(src.duration());
+    dst.set_color_primaries(src.color_primaries());
+    dst.set_color_trc(src.color_trc());
+    dst.set_colorspace(src.colorspace());
+    dst.set_color_range(src.color_range());
+
+    Ok(())
+  }
+
+  /// Run swscale over the whole frame
+  fn scale_with_swscale(&self, src: &Frame, dst: &mut Frame) -> CodecResult<()> {
+    // Slice threading only runs through the AVFrame API, which references
+    // both frames (copying an unrefcounted source, reallocating an
+    // unrefcounted destination); otherwise scale on this thread
+    if self.slice_threads > 1 && src.is_refcounted() && dst.is_refcounted() {
+      let ret = unsafe { sws_scale_frame(self.ptr.as_ptr(), dst.as_mut_ptr(), src.as_ptr()) };
+      if ret < 0 {
+        return Err(CodecError::Ffmpeg(crate::ffi::FFmpegError::from_code(ret)));
+      }
+      return Ok(());
+    }
+
     // Prepare source data pointers and strides
     let src_data: [*const u8; 4] = [src.data(0), src.data(1), src.data(2), src.data(3)];
     let src_linesize: [i32; 4] = [
@@ -167,14 +307,6 @@ impl Scaler {
       )));
     }
 
-    // Copy metadata from source
-    dst.set_pts(src.pts());
-    dst.set_duration(src.duration());
-    dst.set_color_primaries(src.color_primaries());
-    dst.set_color_trc(src.color_trc());
-    dst.set_colorspace(src.colorspace());
-    dst.set_color_range(src.color_range());
-
     Ok(())
   }
 
@@ -185,6 +317,16 @@ impl Scaler {
     Ok(dst)
   }
 
+  /// Scale/convert a frame into a destination recycled from `pool`
+  ///
+  /// Hand the returned frame back with `FramePool::release` once it is no
+  /// longer needed so its buffers can be reused for the next conversion.
+  pub fn scale_pooled(&self, src: &Frame, pool: &mut FramePool) -> CodecResult<Frame> {
+    let mut dst = pool.acquire(self.dst_width, self.dst_height, self.dst_format)?;
+    self.scale(src, &mut dst)?;
+    Ok(dst)
+  }
+
   // ========================================================================
   // Accessors
   // ========================================================================
@@ -223,6 +365,65 @@ impl Scaler {
   pub fn is_converter_only(&self) -> bool {
     self.src_width == self.dst_width && self.src_height == self.dst_height
   }
+
+  /// Check if conversions bypass swscale via a `fast_convert` kernel
+  pub fn uses_fast_path(&self) -> bool {
+    self.fast_path.is_some()
+  }
+
+  /// Get the requested number of slice threads (0 = from the budget)
+  pub fn threads(&self) -> u32 {
+    self.threads
+  }
+
+  /// Get the number of slice threads conversions are split across
+  pub fn slice_threads(&self) -> u32 {
+    self.slice_threads
+  }
+}
+
+/// Allocate and initialize an SwsContext with slice threading enabled
+///
+/// Returns null if any option is rejected or initialization fails.
+#[allow(clippy::too_many_arguments)]
+unsafe fn alloc_threaded_context(
+  src_width: u32,
+  src_height: u32,
+  src_format: AVPixelFormat,
+  dst_width: u32,
+  dst_height: u32,
+  dst_format: AVPixelFormat,
+  algorithm: ScaleAlgorithm,
+  threads: u32,
+) -> *mut SwsContext {
+  let ctx = unsafe { sws_alloc_context() };
+  if ctx.is_null() {
+    return ctx;
+  }
+
+  let options: [(&CStr, i64); 8] = [
+    (c"srcw", src_width as i64),
+    (c"srch", src_height as i64),
+    (c"src_format", src_format.as_raw() as i64),
+    (c"dstw", dst_width as i64),
+    (c"dsth", dst_height as i64),
+    (c"dst_format", dst_format.as_raw() as i64),
+    (c"sws_flags", algorithm.to_sws_flags() as i64),
+    (c"threads", threads as i64),
+  ];
+
+  let configured = options.iter().all(|(name, value)| unsafe {
+    av_opt_set_int(ctx as *mut std::ffi::c_void, name.as_ptr(), *value, 0) >= 0
+  });
+
+  let initialized =
+    configured && unsafe { sws_init_context(ctx, std::ptr::null_mut(), std::ptr::null_mut()) } >= 0;
+  if !initialized {
+    unsafe { sws_freeContext(ctx) };
+    return std::ptr::null_mut();
+  }
+
+  ctx
 }
 
 impl Drop for Scaler {
@@ -251,6 +452,7 @@ impl std::fmt::Debug for Scaler {
           self.dst_width, self.dst_height, self.dst_format
         ),
       )
+      .field("slice_threads", &self.slice_threads)
       .finish()
   }
 }
@@ -279,4 +481,131 @@ mod tests {
     assert!(converter.is_ok());
     assert!(converter.unwrap().is_converter_only());
   }
+
+  #[test]
+  fn test_fast_path_selection() {
+    let converter =
+      Scaler::new_converter(64, 48, AVPixelFormat::Rgba, AVPixelFormat::Nv12).unwrap();
+    assert!(converter.uses_fast_path());
+
+    let resizer = Scaler::new(
+      64,
+      48,
+      AVPixelFormat::Rgba,
+      32,
+      24,
+      AVPixelFormat::Yuv420p,
+      ScaleAlgorithm::Bilinear,
+    )
+    .unwrap();
+    assert!(!resizer.uses_fast_path());
+  }
+
+  #[test]
+  fn test_fast_path_matches_swscale() {
+    let mut src = Frame::new_video(64, 48, AVPixelFormat::Rgba).unwrap();
+    let stride = src.linesize(0) as usize;
+    let data = src.data_mut(0);
+    for y in 0..48 {
+      for x in 0..64 {
+        let px = [(x * 4) as u8, (y * 5) as u8, ((x + y) * 2) as u8, 255];
+        unsafe { std::ptr::copy_nonoverlapping(px.as_ptr(), data.add(y * stride + x * 4), 4) };
+      }
+    }
+
+    let converter =
+      Scaler::new_converter(64, 48, AVPixelFormat::Rgba, AVPixelFormat::Yuv420p).unwrap();
+    let fast = converter.scale_alloc(&src).unwrap();
+    let mut reference = Frame::new_video(64, 48, AVPixelFormat::Yuv420p).unwrap();
+    converter.scale_with_swscale(&src, &mut reference).unwrap();
+
+    // Luma plane: fixed-point kernels stay within rounding of swscale
+    for y in 0..48 {
+      for x in 0..64 {
+        let a = unsafe { *fast.data(0).add(y * fast.linesize(0) as usize + x) } as i32;
+        let b = unsafe {
+          *reference
+            .data(0)
+            .add(y * reference.linesize(0) as usize + x)
+        } as i32;
+        assert!((a - b).abs() <= 2, "luma ({x},{y}): {a} vs {b}");
+      }
+    }
+  }
+
+  #[test]
+  fn test_threaded_scale_matches_single_threaded() {
+    let mut src = Frame::new_video(320, 240, AVPixelFormat::Yuv420p).unwrap();
+    for plane in 0..3 {
+      let rows = if plane == 0 { 240 } else { 120 };
+      let stride = src.linesize(plane) as usize;
+      let data = src.data_mut(plane);
+      for y in 0..rows {
+        for x in 0..stride {
+          unsafe { *data.add(y * stride + x) = ((x * 3 + y * 7 + plane) % 256) as u8 };
+        }
+      }
+    }
+
+    let scale = |threads| {
+      let scaler = Scaler::with_threads(
+        320,
+        240,
+        AVPixelFormat::Yuv420p,
+        160,
+        120,
+        AVPixelFormat::Yuv420p,
+        ScaleAlgorithm::Bilinear,
+        threads,
+      )
+      .unwrap();
+      assert_eq!(scaler.slice_threads(), threads);
+      scaler.scale_alloc(&src).unwrap()
+    };
+    let single = scale(1);
+    let threaded = scale(4);
+
+    for plane in 0..3 {
+      let rows = if plane == 0 { 120 } else { 60 };
+      let width = if plane == 0 { 160 } else { 80 };
+      for y in 0..rows {
+        let a = unsafe {
+          std::slice::from_raw_parts(
+            single.data(plane).add(y * single.linesize(plane) as usize),
+            width,
+          )
+        };
+        let b = unsafe {
+          std::slice::from_raw_parts(
+            threaded
+              .data(plane)
+              .add(y * threaded.linesize(plane) as usize),
+            width,
+          )
+        };
+        assert_eq!(a, b, "plane {plane} row {y}");
+      }
+    }
+  }
+
+  #[test]
+  fn test_automatic_threads_come_from_budget() {
+    let scaler = Scaler::with_threads(
+      1920,
+      1080,
+      AVPixelFormat::Rgba,
+      1920,
+      1080,
+      AVPixelFormat::Yuv420p,
+      ScaleAlgorithm::Bilinear,
+      0,
+    )
+    .unwrap();
+    assert_eq!(scaler.threads(), 0);
+    match &scaler.thread_lease {
+      Some(lease) => assert_eq!(scaler.slice_threads(), lease.thread_count() as u32),
+      None => assert_eq!(scaler.slice_threads(), 1),
+    }
+    assert!(scaler.slice_threads() <= thread_budget::total_threads().max(1));
+  }
 }
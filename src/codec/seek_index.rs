@@ -0,0 +1,298 @@
+//! Persistent keyframe index for demuxers
+//!
+//! FFmpeg keeps a per-stream index of keyframe timestamps and byte offsets
+//! that `av_seek_frame` binary-searches. Containers with a complete index
+//! (MP4 moov, MKV/WebM with cues) fill it when opened. For MKV/WebM without
+//! cues it only grows as clusters are read, so every seek past the indexed
+//! region scans the file linearly, and the work is lost on the next load.
+//!
+//! `SeekIndex` snapshots the keyframe entries into a compact blob that can be
+//! cached next to the asset and fed back into a later demuxer.
+//!
+//! The blob records the size, duration and stream count of the file it was
+//! built from, and importing it into a different file is rejected: offsets
+//! from another encode of the same asset would send seeks to the wrong place.
+//!
+//! Blob layout (integers are LEB128 varints, signed ones zigzag-encoded):
+//! - magic `WCSI`, version byte
+//! - file size (-1 = unknown), duration in microseconds (0 = unknown),
+//!   container stream count
+//! - indexed stream count
+//! - per stream: stream index, codec id, time base num/den, entry count,
+//!   then `(timestamp, pos)` pairs as deltas from the previous entry
+
+use super::CodecError;
+
+const MAGIC: &[u8; 4] = b"WCSI";
+const VERSION: u8 = 2;
+
+/// One keyframe: timestamp in stream time base and byte offset to seek to
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct SeekIndexEntry {
+  pub timestamp: i64,
+  pub pos: i64,
+}
+
+/// Keyframes of one stream, sorted by timestamp
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct StreamSeekIndex {
+  pub stream_index: i32,
+  /// Raw codec id, used to reject an index built for a different file
+  pub codec_id: i32,
+  /// Stream time base (num, den) the timestamps are expressed in
+  pub time_base: (i32, i32),
+  pub entries: Vec<SeekIndexEntry>,
+}
+
+/// Identifies the file an index was built from
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct SeekIndexFingerprint {
+  /// Input size in bytes; -1 when unknown
+  pub file_size: i64,
+  /// Container duration in microseconds; 0 when unknown
+  pub duration: i64,
+  /// Number of streams in the container
+  pub stream_count: u32,
+}
+
+/// Keyframe index for all indexed streams of a container
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct SeekIndex {
+  pub fingerprint: SeekIndexFingerprint,
+  pub streams: Vec<StreamSeekIndex>,
+}
+
+impl SeekIndex {
+  /// Total number of keyframe entries across all streams
+  pub fn len(&self) -> usize {
+    self.streams.iter().map(|s| s.entries.len()).sum()
+  }
+
+  /// Check if the index has no entries
+  pub fn is_empty(&self) -> bool {
+    self.len() == 0
+  }
+
+  /// Encode the index into its binary form
+  pub fn to_bytes(&self) -> Vec<u8> {
+    let mut out = Vec::with_capacity(8 + self.len() * 4);
+    out.extend_from_slice(MAGIC);
+    out.push(VERSION);
+    write_signed(&mut out, self.fingerprint.file_size);
+    write_signed(&mut out, self.fingerprint.duration);
+    write_varint(&mut out, self.fingerprint.stream_count as u64);
+    write_varint(&mut out, self.streams.len() as u64);
+
+    for stream in &self.streams {
+      write_signed(&mut out, stream.stream_index as i64);
+      write_signed(&mut out, stream.codec_id as i64);
+      write_signed(&mut out, stream.time_base.0 as i64);
+      write_signed(&mut out, stream.time_base.1 as i64);
+      write_varint(&mut out, stream.entries.len() as u64);
+
+      let mut prev = SeekIndexEntry {
+        timestamp: 0,
+        pos: 0,
+      };
+      for entry in &stream.entries {
+        write_signed(&mut out, entry.timestamp.wrapping_sub(prev.timestamp));
+        write_signed(&mut out, entry.pos.wrapping_sub(prev.pos));
+        prev = *entry;
+      }
+    }
+
+    out
+  }
+
+  /// Decode an index produced by `to_bytes`
+  pub fn from_bytes(data: &[u8]) -> Result<Self, CodecError> {
+    let invalid = |what: &str| CodecError::InvalidConfig(format!("Invalid seek index: {}", what));
+
+    if data.len() < 5 || &data[..4] != MAGIC {
+      return Err(invalid("bad magic"));
+    }
+    if data[4] != VERSION {
+      return Err(invalid("unsupported version"));
+    }
+
+    let mut reader = VarintReader { data, pos: 5 };
+    let fingerprint = SeekIndexFingerprint {
+      file_size: reader.signed().ok_or_else(|| invalid("truncated"))?,
+      duration: reader.signed().ok_or_else(|| invalid("truncated"))?,
+      stream_count: reader.varint().ok_or_else(|| invalid("truncated"))? as u32,
+    };
+    let stream_count = reader.varint().ok_or_else(|| invalid("truncated"))?;
+    let mut streams = Vec::new();
+
+    for _ in 0..stream_count {
+      let mut field = || reader.signed().ok_or_else(|| invalid("truncated"));
+      let stream_index = field()? as i32;
+      let codec_id = field()? as i32;
+      let time_base = (field()? as i32, field()? as i32);
+      let entry_count = reader.varint().ok_or_else(|| invalid("truncated"))?;
+
+      // Every entry takes at least two bytes; don't trust the count blindly
+      if entry_count > (data.len() - reader.pos) as u64 / 2 {
+        return Err(invalid("truncated"));
+      }
+
+      let mut entries = Vec::with_capacity(entry_count as usize);
+      let mut prev = SeekIndexEntry {
+        timestamp: 0,
+        pos: 0,
+      };
+      for _ in 0..entry_count {
+        let timestamp = reader.signed().ok_or_else(|| invalid("truncated"))?;
+        let pos = reader.signed().ok_or_else(|| invalid("truncated"))?;
+        let entry = SeekIndexEntry {
+          timestamp: prev.timestamp.wrapping_add(timestamp),
+          pos: prev.pos.wrapping_add(pos),
+        };
+        entries.push(entry);
+        prev = entry;
+      }
+
+      streams.push(StreamSeekIndex {
+        stream_index,
+        codec_id,
+        time_base,
+        entries,
+      });
+    }
+
+    if reader.pos != data.len() {
+      return Err(invalid("trailing data"));
+    }
+
+    Ok(Self {
+      fingerprint,
+      streams,
+    })
+  }
+}
+
+fn write_varint(out: &mut Vec<u8>, mut value: u64) {
+  while value >= 0x80 {
+    out.push((value as u8) | 0x80);
+    value >>= 7;
+  }
+  out.push(value as u8);
+}
+
+fn write_signed(out: &mut Vec<u8>, value: i64) {
+  write_varint(out, ((value << 1) ^ (value >> 63)) as u64);
+}
+
+struct VarintReader<'a> {
+  data: &'a [u8],
+  pos: usize,
+}
+
+impl VarintReader<'_> {
+  fn varint(&mut self) -> Option<u64> {
+    let mut value = 0u64;
+    for shift in (0..64).step_by(7) {
+      let byte = *self.data.get(self.pos)?;
+      self.pos += 1;
+      value |= u64::from(byte & 0x7f) << shift;
+      if byte & 0x80 == 0 {
+        return Some(value);
+      }
+    }
+    None
+  }
+
+  fn signed(&mut self) -> Option<i64> {
+    let value = self.varint()?;
+    Some(((value >> 1) as i64) ^ -((value & 1) as i64))
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn sample_index() -> SeekIndex {
+    SeekIndex {
+      fingerprint: SeekIndexFingerprint {
+        file_size: 5_250_000_000,
+        duration: 4_033_000,
+        stream_count: 2,
+      },
+      streams: vec![
+        StreamSeekIndex {
+          stream_index: 0,
+          codec_id: 167,
+          time_base: (1, 1000),
+          entries: vec![
+            SeekIndexEntry {
+              timestamp: -33,
+              pos: 4_012,
+            },
+            SeekIndexEntry {
+              timestamp: 2_000,
+              pos: 1_048_576,
+            },
+            SeekIndexEntry {
+              timestamp: 4_000,
+              pos: 5_000_000_000,
+            },
+          ],
+        },
+        StreamSeekIndex {
+          stream_index: 1,
+          codec_id: 86076,
+          time_base: (1, 48000),
+          entries: Vec::new(),
+        },
+      ],
+    }
+  }
+
+  #[test]
+  fn test_roundtrip() {
+    let index = sample_index();
+    let bytes = index.to_bytes();
+    assert_eq!(&bytes[..4], MAGIC);
+    assert_eq!(SeekIndex::from_bytes(&bytes).unwrap(), index);
+    assert_eq!(index.len(), 3);
+  }
+
+  #[test]
+  fn test_compact_encoding() {
+    // Regular keyframe spacing should cost a handful of bytes per entry
+    let entries = (0..1000)
+      .map(|i| SeekIndexEntry {
+        timestamp: i * 2_000,
+        pos: i * 250_000,
+      })
+      .collect();
+    let index = SeekIndex {
+      fingerprint: SeekIndexFingerprint::default(),
+      streams: vec![StreamSeekIndex {
+        stream_index: 0,
+        codec_id: 27,
+        time_base: (1, 1000),
+        entries,
+      }],
+    };
+    let bytes = index.to_bytes();
+    assert!(bytes.len() < 1000 * 6, "{} bytes", bytes.len());
+    assert_eq!(SeekIndex::from_bytes(&bytes).unwrap(), index);
+  }
+
+  #[test]
+  fn test_rejects_invalid_input() {
+    let bytes = sample_index().to_bytes();
+    assert!(SeekIndex::from_bytes(b"nope").is_err());
+    assert!(SeekIndex::from_bytes(&bytes[..bytes.len() - 1]).is_err());
+
+    let mut extra = bytes.clone();
+    extra.push(0);
+    assert!(SeekIndex::from_bytes(&extra).is_err());
+
+    let mut version = bytes;
+    version[4] = VERSION + 1;
+    assert!(SeekIndex::from_bytes(&version).is_err());
+  }
+}
@@ -0,0 +1,239 @@
+//! Segment boundaries and playlists for segmenting muxers
+//!
+//! `Segmenter` decides where a muxer cuts its output into CMAF (fragmented
+//! MP4) or WebM media segments and remembers the segments produced so far,
+//! so an HLS media playlist can be rendered without a second pass over the
+//! output. It only tracks timing; the muxer owns the bytes.
+//!
+//! Segments are cut before a packet that drives cuts (a video keyframe, or
+//! any audio packet when there's no video track) once the open segment has
+//! reached the target duration, within 1%: microsecond frame timestamps
+//! rarely add up exactly (30 x 33333us is 999990us, not one second). All
+//! timestamps are in microseconds.
+
+use std::collections::VecDeque;
+
+/// Placeholder replaced by the sequence number in segment URIs (as in DASH
+/// `SegmentTemplate`)
+pub const SEGMENT_NUMBER_PLACEHOLDER: &str = "$Number$";
+
+/// Default target segment duration (2 seconds)
+pub const DEFAULT_TARGET_DURATION_US: i64 = 2_000_000;
+
+/// A media segment that has been cut
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct SegmentEntry {
+  /// Sequence number, starting at 1
+  pub sequence: u32,
+  /// Timestamp of the first packet in the segment
+  pub timestamp: i64,
+  /// Segment duration
+  pub duration: i64,
+  /// URI built from the segment URI template
+  pub uri: String,
+}
+
+/// Segment cutting state for one muxer
+#[derive(Debug)]
+pub struct Segmenter {
+  target_duration: i64,
+  init_uri: String,
+  segment_uri_template: String,
+  /// Number of segments kept for the playlist (0 = all)
+  playlist_size: usize,
+  /// Timestamp of the first packet of the open segment
+  segment_start: Option<i64>,
+  /// Largest packet end time (timestamp + duration) in the open segment
+  segment_end: i64,
+  next_sequence: u32,
+  /// Longest segment cut so far, for EXT-X-TARGETDURATION
+  max_duration: i64,
+  segments: VecDeque<SegmentEntry>,
+}
+
+impl Segmenter {
+  pub fn new(
+    target_duration: i64,
+    init_uri: String,
+    segment_uri_template: String,
+    playlist_size: usize,
+  ) -> Self {
+    Self {
+      target_duration: if target_duration > 0 {
+        target_duration
+      } else {
+        DEFAULT_TARGET_DURATION_US
+      },
+      init_uri,
+      segment_uri_template,
+      playlist_size,
+      segment_start: None,
+      segment_end: 0,
+      next_sequence: 1,
+      max_duration: 0,
+      segments: VecDeque::new(),
+    }
+  }
+
+  /// URI of the init segment
+  pub fn init_uri(&self) -> &str {
+    &self.init_uri
+  }
+
+  /// Whether the open segment must be closed before writing a packet
+  ///
+  /// `drives_cuts` is true for video packets, and for audio packets when
+  /// there's no video track.
+  pub fn should_cut(&self, drives_cuts: bool, keyframe: bool, timestamp: i64) -> bool {
+    drives_cuts
+      && keyframe
+      && self
+        .segment_start
+        .is_some_and(|start| timestamp - start >= self.target_duration - self.target_duration / 100)
+  }
+
+  /// Record a packet written to the open segment
+  pub fn observe(&mut self, timestamp: i64, duration: i64) {
+    let start = *self.segment_start.get_or_insert(timestamp);
+    if timestamp < start {
+      // Audio interleaved slightly ahead of the cutting keyframe
+      self.segment_start = Some(timestamp);
+    }
+    self.segment_end = self.segment_end.max(timestamp + duration.max(0));
+  }
+
+  /// Whether any packet was written since the last cut
+  pub fn has_open_segment(&self) -> bool {
+    self.segment_start.is_some()
+  }
+
+  /// Close the open segment
+  ///
+  /// `end` is the start of the next segment, or None at the end of the
+  /// stream (the segment then ends with its last packet).
+  pub fn close_segment(&mut self, end: Option<i64>) -> Option<SegmentEntry> {
+    let start = self.segment_start.take()?;
+    let end = end.unwrap_or(self.segment_end).max(start);
+    self.segment_end = 0;
+
+    let sequence = self.next_sequence;
+    self.next_sequence += 1;
+    let entry = SegmentEntry {
+      sequence,
+      timestamp: start,
+      duration: end - start,
+      uri: self.segment_uri(sequence),
+    };
+    self.max_duration = self.max_duration.max(entry.duration);
+
+    self.segments.push_back(entry.clone());
+    if self.playlist_size > 0 && self.segments.len() > self.playlist_size {
+      self.segments.pop_front();
+    }
+    Some(entry)
+  }
+
+  /// Build the URI of a media segment from the template
+  pub fn segment_uri(&self, sequence: u32) -> String {
+    self
+      .segment_uri_template
+      .replace(SEGMENT_NUMBER_PLACEHOLDER, &sequence.to_string())
+  }
+
+  /// Render an HLS media playlist for the segments cut so far
+  ///
+  /// `ended` appends EXT-X-ENDLIST. Without a playlist size limit the
+  /// playlist is an EVENT playlist that only grows.
+  pub fn hls_playlist(&self, ended: bool) -> String {
+    let target = self.max_duration.max(self.target_duration);
+    let target_secs = (target + 999_999) / 1_000_000;
+    let media_sequence = self
+      .segments
+      .front()
+      .map_or(self.next_sequence, |s| s.sequence);
+
+    let mut out = String::from("#EXTM3U\n#EXT-X-VERSION:7\n");
+    out.push_str(&format!("#EXT-X-TARGETDURATION:{}\n", target_secs));
+    out.push_str(&format!("#EXT-X-MEDIA-SEQUENCE:{}\n", media_sequence));
+    if self.playlist_size == 0 {
+      out.push_str("#EXT-X-PLAYLIST-TYPE:EVENT\n");
+    }
+    out.push_str("#EXT-X-INDEPENDENT-SEGMENTS\n");
+    out.push_str(&format!("#EXT-X-MAP:URI=\"{}\"\n", self.init_uri));
+    for segment in &self.segments {
+      out.push_str(&format!(
+        "#EXTINF:{:.6},\n{}\n",
+        segment.duration as f64 / 1_000_000.0,
+        segment.uri
+      ));
+    }
+    if ended {
+      out.push_str("#EXT-X-ENDLIST\n");
+    }
+    out
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn segmenter(playlist_size: usize) -> Segmenter {
+    Segmenter::new(
+      2_000_000,
+      "init.mp4".to_string(),
+      "segment-$Number$.m4s".to_string(),
+      playlist_size,
+    )
+  }
+
+  #[test]
+  fn test_cuts_on_keyframe_after_target() {
+    let mut s = segmenter(0);
+    assert!(!s.should_cut(true, true, 0));
+    s.observe(0, 33_333);
+
+    // Target reached, but only keyframes of the driving track cut
+    assert!(!s.should_cut(true, false, 2_000_000));
+    assert!(!s.should_cut(false, true, 2_000_000));
+    assert!(!s.should_cut(true, true, 1_966_667));
+    assert!(s.should_cut(true, true, 1_999_980));
+
+    let entry = s.close_segment(Some(2_000_000)).unwrap();
+    assert_eq!(entry.sequence, 1);
+    assert_eq!(entry.timestamp, 0);
+    assert_eq!(entry.duration, 2_000_000);
+    assert_eq!(entry.uri, "segment-1.m4s");
+    assert!(!s.has_open_segment());
+  }
+
+  #[test]
+  fn test_final_segment_ends_with_last_packet() {
+    let mut s = segmenter(0);
+    s.observe(4_000_000, 33_333);
+    s.observe(4_966_667, 33_333);
+    let entry = s.close_segment(None).unwrap();
+    assert_eq!(entry.duration, 1_000_000);
+    assert!(s.close_segment(None).is_none());
+  }
+
+  #[test]
+  fn test_hls_playlist() {
+    let mut s = segmenter(2);
+    for i in 0..3 {
+      s.observe(i * 2_000_000, 2_000_000);
+      s.close_segment(Some((i + 1) * 2_000_000));
+    }
+
+    let playlist = s.hls_playlist(true);
+    assert!(playlist.starts_with("#EXTM3U\n"));
+    assert!(playlist.contains("#EXT-X-TARGETDURATION:2\n"));
+    // Sliding window keeps the last two segments
+    assert!(playlist.contains("#EXT-X-MEDIA-SEQUENCE:2\n"));
+    assert!(!playlist.contains("segment-1.m4s"));
+    assert!(playlist.contains("#EXTINF:2.000000,\nsegment-3.m4s\n"));
+    assert!(playlist.contains("#EXT-X-MAP:URI=\"init.mp4\"\n"));
+    assert!(!playlist.contains("PLAYLIST-TYPE"));
+    assert!(playlist.ends_with("#EXT-X-ENDLIST\n"));
+  }
+}
@@ -0,0 +1,217 @@
+//! Per-codec performance counters
+//!
+//! Each WebCodecs codec owns one `CodecStats`, shared by its JS object, its
+//! worker and its `CodecContext`. Stages are timed on the worker (the
+//! send/receive calls inside `CodecContext` itself) and read by `getStats()`
+//! without taking the codec lock: every counter is a relaxed atomic.
+//!
+//! Timed stages also open a `trace` level span on the "webcodecs::stats"
+//! target, so a tracing subscriber can attribute worker time per stage
+//! without polling `getStats()`. Spans are no-ops unless that level is
+//! enabled.
+
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+/// Pipeline stage timed by `CodecStats`
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Stage {
+  /// Command waiting in the worker channel before being processed
+  QueueWait,
+  /// Pixel format conversion/scaling (video) or resampling (audio)
+  Convert,
+  /// `avcodec_send_frame` / `avcodec_send_packet`
+  Send,
+  /// `avcodec_receive_packet` / `avcodec_receive_frame`
+  Receive,
+  /// Copying a CPU frame into a hardware frame
+  HwUpload,
+  /// Copying a hardware frame back to CPU memory
+  HwDownload,
+  /// Output queued by the worker until the JS output callback returned
+  Callback,
+}
+
+const STAGE_COUNT: usize = 7;
+
+impl Stage {
+  fn index(self) -> usize {
+    self as usize
+  }
+
+  /// Name used in tracing spans
+  pub fn name(self) -> &'static str {
+    match self {
+      Stage::QueueWait => "queue_wait",
+      Stage::Convert => "convert",
+      Stage::Send => "send",
+      Stage::Receive => "receive",
+      Stage::HwUpload => "hw_upload",
+      Stage::HwDownload => "hw_download",
+      Stage::Callback => "callback",
+    }
+  }
+}
+
+#[derive(Default)]
+struct StageCounter {
+  count: AtomicU64,
+  total_ns: AtomicU64,
+  max_ns: AtomicU64,
+}
+
+/// Snapshot of one stage's timings
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct StageStats {
+  /// Number of timed operations
+  pub count: u64,
+  pub total: Duration,
+  pub max: Duration,
+}
+
+impl StageStats {
+  /// Mean duration, zero when nothing was timed
+  pub fn mean(&self) -> Duration {
+    if self.count == 0 {
+      Duration::ZERO
+    } else {
+      Duration::from_nanos((self.total.as_nanos() / self.count as u128) as u64)
+    }
+  }
+}
+
+/// Performance counters for one codec instance
+pub struct CodecStats {
+  /// Codec kind in tracing spans (e.g. "VideoEncoder")
+  kind: &'static str,
+  stages: [StageCounter; STAGE_COUNT],
+  /// Frames/chunks/audio buffers taken off the queue for processing
+  inputs: AtomicU64,
+  /// Chunks/frames/audio buffers handed to the output path
+  outputs: AtomicU64,
+  /// Inputs discarded by a queue policy or by the decoder
+  dropped: AtomicU64,
+  /// Switches from a hardware to a software codec
+  hw_fallbacks: AtomicU64,
+}
+
+impl CodecStats {
+  pub fn new(kind: &'static str) -> Self {
+    Self {
+      kind,
+      stages: Default::default(),
+      inputs: AtomicU64::new(0),
+      outputs: AtomicU64::new(0),
+      dropped: AtomicU64::new(0),
+      hw_fallbacks: AtomicU64::new(0),
+    }
+  }
+
+  /// Record one operation of `stage` taking `elapsed`
+  pub fn record(&self, stage: Stage, elapsed: Duration) {
+    let counter = &self.stages[stage.index()];
+    let ns = elapsed.as_nanos().min(u64::MAX as u128) as u64;
+    counter.count.fetch_add(1, Ordering::Relaxed);
+    counter.total_ns.fetch_add(ns, Ordering::Relaxed);
+    counter.max_ns.fetch_max(ns, Ordering::Relaxed);
+  }
+
+  /// Record one operation of `stage` that started at `start`
+  pub fn record_since(&self, stage: Stage, start: Instant) {
+    self.record(stage, start.elapsed());
+  }
+
+  /// Run `f` as one operation of `stage`, inside a tracing span
+  pub fn time<R>(&self, stage: Stage, f: impl FnOnce() -> R) -> R {
+    let _span = tracing::trace_span!(
+      target: "webcodecs::stats",
+      "codec_stage",
+      codec = self.kind,
+      stage = stage.name()
+    )
+    .entered();
+    let start = Instant::now();
+    let result = f();
+    self.record_since(stage, start);
+    result
+  }
+
+  pub fn add_input(&self) {
+    self.inputs.fetch_add(1, Ordering::Relaxed);
+  }
+
+  pub fn add_output(&self) {
+    self.outputs.fetch_add(1, Ordering::Relaxed);
+  }
+
+  pub fn add_dropped(&self) {
+    self.dropped.fetch_add(1, Ordering::Relaxed);
+  }
+
+  pub fn add_hw_fallback(&self) {
+    self.hw_fallbacks.fetch_add(1, Ordering::Relaxed);
+  }
+
+  pub fn stage(&self, stage: Stage) -> StageStats {
+    let counter = &self.stages[stage.index()];
+    StageStats {
+      count: counter.count.load(Ordering::Relaxed),
+      total: Duration::from_nanos(counter.total_ns.load(Ordering::Relaxed)),
+      max: Duration::from_nanos(counter.max_ns.load(Ordering::Relaxed)),
+    }
+  }
+
+  pub fn inputs(&self) -> u64 {
+    self.inputs.load(Ordering::Relaxed)
+  }
+
+  pub fn outputs(&self) -> u64 {
+    self.outputs.load(Ordering::Relaxed)
+  }
+
+  pub fn dropped(&self) -> u64 {
+    self.dropped.load(Ordering::Relaxed)
+  }
+
+  pub fn hw_fallbacks(&self) -> u64 {
+    self.hw_fallbacks.load(Ordering::Relaxed)
+  }
+}
+
+impl std::fmt::Debug for CodecStats {
+  fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+    f.debug_struct("CodecStats")
+      .field("kind", &self.kind)
+      .field("inputs", &self.inputs())
+      .field("outputs", &self.outputs())
+      .field("dropped", &self.dropped())
+      .field("hw_fallbacks", &self.hw_fallbacks())
+      .finish()
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[test]
+  fn test_stage_accumulates() {
+    let stats = CodecStats::new("test");
+    stats.record(Stage::Send, Duration::from_micros(10));
+    stats.record(Stage::Send, Duration::from_micros(30));
+
+    let send = stats.stage(Stage::Send);
+    assert_eq!(send.count, 2);
+    assert_eq!(send.total, Duration::from_micros(40));
+    assert_eq!(send.max, Duration::from_micros(30));
+    assert_eq!(send.mean(), Duration::from_micros(20));
+    assert_eq!(stats.stage(Stage::Receive), StageStats::default());
+  }
+
+  #[test]
+  fn test_time_returns_result() {
+    let stats = CodecStats::new("test");
+    assert_eq!(stats.time(Stage::Convert, || 42), 42);
+    assert_eq!(stats.stage(Stage::Convert).count, 1);
+  }
+}
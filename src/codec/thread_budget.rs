@@ -0,0 +1,369 @@
+//! Process-wide budget for codec-internal threads
+//!
+//! libavcodec gives every context opened with `thread_count = 0` one
+//! frame/slice thread per core, so N software codecs on an N-core host run
+//! about N² threads that mostly fight each other. Instead, contexts configured
+//! with `thread_count = 0` lease their thread count from a shared budget
+//! (one thread per core by default):
+//!
+//! - A session is weighted by codec cost and resolution. It gets its weighted
+//!   share of the budget against all active sessions, limited to what is
+//!   still unallocated (but at least one thread), to what its frame height
+//!   can keep busy and to half the budget. Leases can't grow later, so the
+//!   cap keeps the first session from taking everything: a second one of
+//!   the same weight configured afterwards gets as many threads.
+//! - Realtime encoders and low-latency decoders use slice threading only,
+//!   which adds no frame delay; other sessions keep frame threading.
+//! - Scalers with an automatic thread count lease their swscale slice threads
+//!   the same way, weighted like the cheapest codecs.
+//! - The lease is returned when its context is dropped (close, reset,
+//!   reconfigure), so sessions configured later see the freed budget. FFmpeg
+//!   can't change the thread count of an open context, so running sessions
+//!   keep theirs.
+
+use std::ffi::c_int;
+use std::sync::atomic::{AtomicU32, Ordering};
+
+use parking_lot::Mutex;
+
+use crate::ffi::AVCodecID;
+use crate::ffi::accessors::{FF_THREAD_FRAME, FF_THREAD_SLICE};
+
+/// `TOTAL_THREADS` value meaning "one per CPU core"
+const UNSET: u32 = u32::MAX;
+
+/// Budget shared by all leases; 0 disables it (libavcodec auto threading)
+static TOTAL_THREADS: AtomicU32 = AtomicU32::new(UNSET);
+
+/// libavcodec's own cap for automatic thread counts
+const MAX_THREADS_PER_SESSION: u32 = 16;
+
+/// Rows of a frame worth one more thread (slice/row threading granularity)
+const ROWS_PER_THREAD: u32 = 64;
+
+/// Frame size that has weight 1.0 for an H.264-cost codec
+const REFERENCE_PIXELS: f64 = 1280.0 * 720.0;
+
+static GLOBAL_BUDGET: ThreadBudget = ThreadBudget::new();
+
+/// Set the total number of codec threads shared by new sessions
+///
+/// 0 disables the budget; sessions configured afterwards let libavcodec pick.
+pub fn set_total_threads(threads: u32) {
+  TOTAL_THREADS.store(threads, Ordering::Relaxed);
+}
+
+/// Get the total number of codec threads shared by new sessions
+pub fn total_threads() -> u32 {
+  match TOTAL_THREADS.load(Ordering::Relaxed) {
+    UNSET => std::thread::available_parallelism().map_or(1, |n| n.get() as u32),
+    threads => threads,
+  }
+}
+
+/// Lease threads for a new codec session from the global budget
+///
+/// Returns `None` when the budget is disabled.
+pub fn lease(workload: ThreadWorkload) -> Option<ThreadLease> {
+  GLOBAL_BUDGET.lease(total_threads(), workload)
+}
+
+/// What a codec session is expected to cost
+#[derive(Debug, Clone, Copy)]
+pub struct ThreadWorkload {
+  pub codec_id: AVCodecID,
+  /// Frame size, 0 when not known yet
+  pub width: u32,
+  pub height: u32,
+  /// Realtime encode or low-latency decode: slice threading only
+  pub low_latency: bool,
+}
+
+impl ThreadWorkload {
+  /// Slice-threaded scaling/conversion to `width`x`height` (see `Scaler`)
+  ///
+  /// Weighted like the cheapest codecs.
+  pub fn scaler(width: u32, height: u32) -> Self {
+    Self {
+      codec_id: AVCodecID::None,
+      width,
+      height,
+      low_latency: true,
+    }
+  }
+
+  /// Relative cost versus 720p H.264
+  fn weight(&self) -> f64 {
+    let cost = match self.codec_id {
+      AVCodecID::Av1 => 2.0,
+      AVCodecID::Hevc => 1.75,
+      AVCodecID::Vp9 => 1.5,
+      AVCodecID::H264 => 1.0,
+      AVCodecID::Vp8 => 0.75,
+      _ => 0.5,
+    };
+    let pixels = if self.width == 0 || self.height == 0 {
+      REFERENCE_PIXELS
+    } else {
+      self.width as f64 * self.height as f64
+    };
+    (cost * pixels / REFERENCE_PIXELS).max(0.1)
+  }
+
+  /// Most threads this frame size can keep busy
+  fn max_threads(&self) -> u32 {
+    if self.height == 0 {
+      return MAX_THREADS_PER_SESSION;
+    }
+    (self.height / ROWS_PER_THREAD).clamp(1, MAX_THREADS_PER_SESSION)
+  }
+}
+
+#[derive(Debug, Default)]
+struct Allocation {
+  sessions: u32,
+  weight: f64,
+  threads: u32,
+}
+
+/// Thread accounting for a set of codec sessions
+struct ThreadBudget {
+  allocation: Mutex<Allocation>,
+}
+
+impl ThreadBudget {
+  const fn new() -> Self {
+    Self {
+      allocation: Mutex::new(Allocation {
+        sessions: 0,
+        weight: 0.0,
+        threads: 0,
+      }),
+    }
+  }
+
+  fn lease(&'static self, total: u32, workload: ThreadWorkload) -> Option<ThreadLease> {
+    if total == 0 {
+      return None;
+    }
+
+    let weight = workload.weight();
+    let mut allocation = self.allocation.lock();
+    let share = (total as f64 * weight / (allocation.weight + weight)).round() as u32;
+    let remaining = total.saturating_sub(allocation.threads);
+    let threads = share
+      .min(remaining)
+      .min(workload.max_threads())
+      .min(total.div_ceil(2))
+      .max(1);
+
+    allocation.sessions += 1;
+    allocation.weight += weight;
+    allocation.threads += threads;
+    tracing::debug!(
+      target: "webcodecs",
+      "Leased {} codec threads for {:?} {}x{} ({}/{} threads, {} sessions)",
+      threads,
+      workload.codec_id,
+      workload.width,
+      workload.height,
+      allocation.threads,
+      total,
+      allocation.sessions
+    );
+
+    Some(ThreadLease {
+      budget: self,
+      threads,
+      weight,
+      low_latency: workload.low_latency,
+    })
+  }
+
+  fn release(&self, lease: &ThreadLease) {
+    let mut allocation = self.allocation.lock();
+    allocation.sessions = allocation.sessions.saturating_sub(1);
+    allocation.threads = allocation.threads.saturating_sub(lease.threads);
+    // Avoid accumulating float error once everything is released
+    allocation.weight = if allocation.sessions == 0 {
+      0.0
+    } else {
+      (allocation.weight - lease.weight).max(0.0)
+    };
+  }
+}
+
+/// Threads held by one codec session, returned on drop
+pub struct ThreadLease {
+  budget: &'static ThreadBudget,
+  threads: u32,
+  weight: f64,
+  low_latency: bool,
+}
+
+impl ThreadLease {
+  /// Value for `AVCodecContext.thread_count`
+  pub fn thread_count(&self) -> c_int {
+    self.threads as c_int
+  }
+
+  /// Value for `AVCodecContext.thread_type`
+  pub fn thread_type(&self) -> c_int {
+    if self.low_latency {
+      FF_THREAD_SLICE
+    } else {
+      FF_THREAD_FRAME | FF_THREAD_SLICE
+    }
+  }
+
+  /// Switch to slice threading (encoders learn their latency mode late)
+  pub fn set_low_latency(&mut self, low_latency: bool) {
+    self.low_latency = low_latency;
+  }
+}
+
+impl Drop for ThreadLease {
+  fn drop(&mut self) {
+    self.budget.release(self);
+  }
+}
+
+impl std::fmt::Debug for ThreadLease {
+  fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+    f.debug_struct("ThreadLease")
+      .field("threads", &self.threads)
+      .field("low_latency", &self.low_latency)
+      .finish()
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn budget() -> &'static ThreadBudget {
+    Box::leak(Box::new(ThreadBudget::new()))
+  }
+
+  fn workload(codec_id: AVCodecID, width: u32, height: u32) -> ThreadWorkload {
+    ThreadWorkload {
+      codec_id,
+      width,
+      height,
+      low_latency: false,
+    }
+  }
+
+  #[test]
+  fn test_single_session_gets_what_it_can_use() {
+    let budget = budget();
+    let hd = budget
+      .lease(32, workload(AVCodecID::H264, 1920, 1080))
+      .unwrap();
+    assert_eq!(hd.threads, MAX_THREADS_PER_SESSION);
+    drop(hd);
+
+    let small = budget
+      .lease(32, workload(AVCodecID::H264, 320, 240))
+      .unwrap();
+    assert_eq!(small.threads, 240 / ROWS_PER_THREAD);
+  }
+
+  #[test]
+  fn test_many_sessions_stay_near_budget() {
+    let budget = budget();
+    let leases: Vec<_> = (0..32)
+      .map(|_| {
+        budget
+          .lease(32, workload(AVCodecID::H264, 1920, 1080))
+          .unwrap()
+      })
+      .collect();
+    let total: u32 = leases.iter().map(|l| l.threads).sum();
+    // Every session gets at least one thread; beyond that the budget holds
+    assert!(total <= 32 + leases.len() as u32, "{} threads", total);
+    assert!(leases.iter().all(|l| l.threads >= 1));
+
+    drop(leases);
+    let allocation = budget.allocation.lock();
+    assert_eq!(allocation.sessions, 0);
+    assert_eq!(allocation.threads, 0);
+  }
+
+  #[test]
+  fn test_sessions_split_the_budget() {
+    let budget = budget();
+    let first = budget
+      .lease(8, workload(AVCodecID::H264, 1920, 1080))
+      .unwrap();
+    let second = budget
+      .lease(8, workload(AVCodecID::H264, 1920, 1080))
+      .unwrap();
+    // The first session leaves an equal share for the second
+    assert_eq!(first.threads, 4);
+    assert_eq!(second.threads, 4);
+  }
+
+  #[test]
+  fn test_released_threads_are_reused() {
+    let budget = budget();
+    let first = budget
+      .lease(8, workload(AVCodecID::H264, 1920, 1080))
+      .unwrap();
+    let _second = budget
+      .lease(8, workload(AVCodecID::H264, 1920, 1080))
+      .unwrap();
+    assert_eq!(
+      budget
+        .lease(8, workload(AVCodecID::H264, 1920, 1080))
+        .unwrap()
+        .threads,
+      1
+    );
+
+    drop(first);
+    let third = budget
+      .lease(8, workload(AVCodecID::H264, 1920, 1080))
+      .unwrap();
+    assert_eq!(third.threads, 4);
+  }
+
+  #[test]
+  fn test_costlier_codecs_get_larger_share() {
+    // A wide but short competing session: heavy weight, only two threads
+    let competing = workload(AVCodecID::Hevc, 3840, 128);
+
+    let budget = budget();
+    let _other = budget.lease(16, competing).unwrap();
+    let av1 = budget
+      .lease(16, workload(AVCodecID::Av1, 1280, 720))
+      .unwrap();
+
+    let budget = self::budget();
+    let _other = budget.lease(16, competing).unwrap();
+    let vp8 = budget
+      .lease(16, workload(AVCodecID::Vp8, 1280, 720))
+      .unwrap();
+
+    assert!(
+      av1.threads > vp8.threads,
+      "{} vs {}",
+      av1.threads,
+      vp8.threads
+    );
+  }
+
+  #[test]
+  fn test_thread_type() {
+    let budget = budget();
+    let mut lease = budget.lease(4, workload(AVCodecID::Vp9, 640, 480)).unwrap();
+    assert_eq!(lease.thread_type(), FF_THREAD_FRAME | FF_THREAD_SLICE);
+    lease.set_low_latency(true);
+    assert_eq!(lease.thread_type(), FF_THREAD_SLICE);
+    assert!(
+      budget
+        .lease(0, workload(AVCodecID::Vp9, 640, 480))
+        .is_none()
+    );
+  }
+}
@@ -100,6 +100,18 @@ void ffctx_set_thread_type(AVCodecContext* ctx, int thread_type) {
     ctx->thread_type = thread_type;
 }
 
+void ffctx_set_lowres(AVCodecContext* ctx, int lowres) {
+    ctx->lowres = lowres;
+}
+
+void ffctx_set_skip_frame(AVCodecContext* ctx, int discard) {
+    ctx->skip_frame = (enum AVDiscard)discard;
+}
+
+void ffctx_set_skip_loop_filter(AVCodecContext* ctx, int discard) {
+    ctx->skip_loop_filter = (enum AVDiscard)discard;
+}
+
 void ffctx_set_color_primaries(AVCodecContext* ctx, int color_primaries) {
     ctx->color_primaries = color_primaries;
 }
@@ -341,6 +353,10 @@ int ffframe_get_format(const AVFrame* frame) {
     return frame->format;
 }
 
+int ffframe_has_buf(const AVFrame* frame) {
+    return frame->buf[0] != NULL;
+}
+
 int64_t ffframe_get_pts(const AVFrame* frame) {
     return frame->pts;
 }
@@ -432,6 +448,13 @@ void ffframe_set_linesize(AVFrame* frame, int plane, int linesize) {
     }
 }
 
+void ffframe_set_buf(AVFrame* frame, int index, AVBufferRef* buf) {
+    if (index >= 0 && index < AV_NUM_DATA_POINTERS) {
+        av_buffer_unref(&frame->buf[index]);
+        frame->buf[index] = buf;
+    }
+}
+
 /* ============================================================================
  * AVPacket Getters
  * ============================================================================ */
@@ -549,6 +572,12 @@ int ffhwframes_get_height(AVBufferRef* ref) {
     return ctx->height;
 }
 
+int ffhwframes_same_device(AVBufferRef* a, AVBufferRef* b) {
+    AVHWFramesContext* ctx_a = (AVHWFramesContext*)a->data;
+    AVHWFramesContext* ctx_b = (AVHWFramesContext*)b->data;
+    return ctx_a->device_ctx == ctx_b->device_ctx;
+}
+
 /* ============================================================================
  * Audio-specific AVCodecContext Setters
  * ============================================================================ */
@@ -883,6 +912,26 @@ int64_t ffstream_get_start_time(const AVStream* stream) {
     return stream->start_time;
 }
 
+int ffstream_get_index_entries_count(const AVStream* stream) {
+    return avformat_index_get_entries_count(stream);
+}
+
+/* AVIndexEntry packs flags and size into bitfields, so copy out the fields we need */
+int ffstream_get_index_entry(AVStream* stream, int idx, int64_t* pos, int64_t* timestamp, int* flags) {
+    const AVIndexEntry* entry = avformat_index_get_entry(stream, idx);
+    if (!entry) {
+        return AVERROR(EINVAL);
+    }
+    *pos = entry->pos;
+    *timestamp = entry->timestamp;
+    *flags = entry->flags;
+    return 0;
+}
+
+int ffstream_add_index_entry(AVStream* stream, int64_t pos, int64_t timestamp, int flags) {
+    return av_add_index_entry(stream, pos, timestamp, 0, 0, flags);
+}
+
 /* ============================================================================
  * AVCodecParameters Accessors
  * ============================================================================ */
@@ -1170,3 +1219,18 @@ int ff_codec_get_hw_pix_fmt(const AVCodec* codec, int device_type) {
 
     return AV_PIX_FMT_NONE;
 }
+
+/**
+ * Get the highest reduced-resolution decode factor a decoder supports.
+ * Frames decoded with lowres = n are 1/2^n of the coded size.
+ */
+int ff_codec_get_max_lowres(const AVCodec* codec) {
+    return codec ? codec->max_lowres : 0;
+}
+
+/**
+ * Get the codec ID an encoder or decoder implements.
+ */
+int ff_codec_get_id(const AVCodec* codec) {
+    return codec ? (int)codec->id : AV_CODEC_ID_NONE;
+}
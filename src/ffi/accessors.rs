@@ -33,6 +33,9 @@ unsafe extern "C" {
   pub fn ffctx_set_sample_aspect_ratio(ctx: *mut AVCodecContext, num: c_int, den: c_int);
   pub fn ffctx_set_thread_count(ctx: *mut AVCodecContext, thread_count: c_int);
   pub fn ffctx_set_thread_type(ctx: *mut AVCodecContext, thread_type: c_int);
+  pub fn ffctx_set_lowres(ctx: *mut AVCodecContext, lowres: c_int);
+  pub fn ffctx_set_skip_frame(ctx: *mut AVCodecContext, discard: c_int);
+  pub fn ffctx_set_skip_loop_filter(ctx: *mut AVCodecContext, discard: c_int);
   pub fn ffctx_set_color_primaries(ctx: *mut AVCodecContext, color_primaries: c_int);
   pub fn ffctx_set_color_trc(ctx: *mut AVCodecContext, color_trc: c_int);
   pub fn ffctx_set_colorspace(ctx: *mut AVCodecContext, colorspace: c_int);
@@ -65,6 +68,12 @@ unsafe extern "C" {
   /// Returns the pixel format if supported, or AV_PIX_FMT_NONE if not.
   pub fn ff_codec_get_hw_pix_fmt(codec: *const AVCodec, device_type: c_int) -> c_int;
 
+  /// Get the highest reduced-resolution decode factor (lowres) a decoder supports.
+  pub fn ff_codec_get_max_lowres(codec: *const AVCodec) -> c_int;
+
+  /// Get the codec ID an encoder or decoder implements.
+  pub fn ff_codec_get_id(codec: *const AVCodec) -> c_int;
+
   // ========================================================================
   // AVCodecContext Getters
   // ========================================================================
@@ -127,6 +136,8 @@ unsafe extern "C" {
   pub fn ffframe_set_quality(frame: *mut AVFrame, quality: c_int);
   pub fn ffframe_set_data(frame: *mut AVFrame, plane: c_int, data: *mut u8);
   pub fn ffframe_set_linesize(frame: *mut AVFrame, plane: c_int, linesize: c_int);
+  /// Install `buf` as `frame->buf[index]`, taking ownership of the reference
+  pub fn ffframe_set_buf(frame: *mut AVFrame, index: c_int, buf: *mut AVBufferRef);
 
   // ========================================================================
   // AVFrame Getters
@@ -135,6 +146,8 @@ unsafe extern "C" {
   pub fn ffframe_get_width(frame: *const AVFrame) -> c_int;
   pub fn ffframe_get_height(frame: *const AVFrame) -> c_int;
   pub fn ffframe_get_format(frame: *const AVFrame) -> c_int;
+  /// Whether the frame data is reference counted (`frame->buf[0]` is set)
+  pub fn ffframe_has_buf(frame: *const AVFrame) -> c_int;
   pub fn ffframe_get_pts(frame: *const AVFrame) -> i64;
   pub fn ffframe_get_duration(frame: *const AVFrame) -> i64;
   pub fn ffframe_get_pkt_dts(frame: *const AVFrame) -> i64;
@@ -224,6 +237,8 @@ unsafe extern "C" {
   pub fn ffhwframes_get_sw_format(ref_: *mut AVBufferRef) -> c_int;
   pub fn ffhwframes_get_width(ref_: *mut AVBufferRef) -> c_int;
   pub fn ffhwframes_get_height(ref_: *mut AVBufferRef) -> c_int;
+  /// Whether two frames contexts were created on the same device
+  pub fn ffhwframes_same_device(a: *mut AVBufferRef, b: *mut AVBufferRef) -> c_int;
 
   // ========================================================================
   // Utility Functions
@@ -297,6 +312,20 @@ unsafe extern "C" {
   pub fn ffstream_get_duration(stream: *const AVStream) -> i64;
   pub fn ffstream_get_nb_frames(stream: *const AVStream) -> i64;
   pub fn ffstream_get_start_time(stream: *const AVStream) -> i64;
+  pub fn ffstream_get_index_entries_count(stream: *const AVStream) -> c_int;
+  pub fn ffstream_get_index_entry(
+    stream: *mut AVStream,
+    idx: c_int,
+    pos: *mut i64,
+    timestamp: *mut i64,
+    flags: *mut c_int,
+  ) -> c_int;
+  pub fn ffstream_add_index_entry(
+    stream: *mut AVStream,
+    pos: i64,
+    timestamp: i64,
+    flags: c_int,
+  ) -> c_int;
 
   // ========================================================================
   // AVCodecParameters Accessors
@@ -410,3 +439,26 @@ pub mod codec_flag2 {
   /// Export motion vectors into frame side data
   pub const EXPORT_MVS: c_int = 1 << 28;
 }
+
+/// AVDiscard levels for `skip_frame` / `skip_loop_filter` (decoder)
+pub mod discard {
+  use std::os::raw::c_int;
+
+  /// Discard useless packets like 0 size packets in avi
+  pub const DEFAULT: c_int = 0;
+
+  /// Discard all non-reference frames
+  pub const NONREF: c_int = 8;
+
+  /// Discard all bidirectional frames
+  pub const BIDIR: c_int = 16;
+
+  /// Discard all non-intra frames
+  pub const NONINTRA: c_int = 24;
+
+  /// Discard all frames except keyframes
+  pub const NONKEY: c_int = 32;
+
+  /// Discard all
+  pub const ALL: c_int = 48;
+}
@@ -129,6 +129,9 @@ unsafe extern "C" {
   /// Create a new packet that references the same data as src
   pub fn av_packet_ref(dst: *mut AVPacket, src: *const AVPacket) -> c_int;
 
+  /// Ensure the packet data is writable (copies it if it is shared)
+  pub fn av_packet_make_writable(pkt: *mut AVPacket) -> c_int;
+
   /// Allocate new buffer for the packet with size bytes
   pub fn av_new_packet(pkt: *mut AVPacket, size: c_int) -> c_int;
 
@@ -352,6 +352,13 @@ unsafe extern "C" {
   /// Force flushing of buffered data to the output
   pub fn avio_flush(s: *mut AVIOContext);
 
+  /// Get the size of the resource accessed by the context
+  ///
+  /// # Returns
+  /// * Size in bytes
+  /// * Negative AVERROR if unknown
+  pub fn avio_size(s: *mut AVIOContext) -> i64;
+
   /// Open a file for I/O
   ///
   /// # Arguments
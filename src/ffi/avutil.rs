@@ -77,9 +77,24 @@ unsafe extern "C" {
   /// Check if the buffer is writable (only one reference)
   pub fn av_buffer_is_writable(buf: *const AVBufferRef) -> c_int;
 
+  /// Get the number of references to the underlying buffer
+  pub fn av_buffer_get_ref_count(buf: *const AVBufferRef) -> c_int;
+
   /// Get the data pointer from the buffer ref
   pub fn av_buffer_get_opaque(buf: *const AVBufferRef) -> *mut c_void;
 
+  /// Create an AVBuffer from an existing array
+  ///
+  /// `free` is invoked with `opaque` and `data` when the last reference is
+  /// dropped, on whichever thread drops it.
+  pub fn av_buffer_create(
+    data: *mut u8,
+    size: usize,
+    free: Option<unsafe extern "C" fn(opaque: *mut c_void, data: *mut u8)>,
+    opaque: *mut c_void,
+    flags: c_int,
+  ) -> *mut AVBufferRef;
+
   // ========================================================================
   // Image Utilities
   // ========================================================================
@@ -308,6 +323,17 @@ pub mod dict_flag {
   pub const MULTIKEY: c_int = 64;
 }
 
+// ============================================================================
+// Buffer Flags
+// ============================================================================
+
+pub mod buffer_flag {
+  use std::os::raw::c_int;
+
+  /// Always treat the buffer as read-only, even with a single reference
+  pub const READONLY: c_int = 1;
+}
+
 // ============================================================================
 // Rounding Modes
 // ============================================================================
@@ -36,6 +36,22 @@ unsafe extern "C" {
     param: *const f64,
   ) -> *mut SwsContext;
 
+  /// Allocate an empty SwsContext
+  ///
+  /// Configure it with `av_opt_set_*` (e.g. "srcw", "dst_format", "threads")
+  /// and then call `sws_init_context`. Free with `sws_freeContext`.
+  pub fn sws_alloc_context() -> *mut SwsContext;
+
+  /// Initialize a context allocated with `sws_alloc_context`
+  ///
+  /// # Returns
+  /// 0 on success, negative error code on failure
+  pub fn sws_init_context(
+    c: *mut SwsContext,
+    srcFilter: *mut SwsFilter,
+    dstFilter: *mut SwsFilter,
+  ) -> c_int;
+
   /// Get a cached context, reusing the existing one if parameters match
   ///
   /// If context is NULL, acts like sws_getContext.
@@ -141,6 +141,8 @@ pub use webcodecs::{
   CodecState,
   // Demuxer types
   DemuxerAudioDecoderConfig,
+  DemuxerLoadOptions,
+  DemuxerLoadStreamOptions,
   DemuxerTrackInfo,
   DemuxerVideoDecoderConfig,
   EncodedAudioChunk,
@@ -151,7 +153,15 @@ pub use webcodecs::{
   EncodedVideoChunkInit,
   EncodedVideoChunkMetadata,
   EncodedVideoChunkType,
+  // Frame memory accounting
+  FrameMemoryBudget,
+  FrameMemoryPressure,
+  FrameMemoryPressureEvent,
+  FrameMemoryStats,
   HardwareAccelerator,
+  HardwareSessionCounters,
+  HardwareSessionLimits,
+  HardwareSessionStats,
   // Muxer types
   MkvAudioTrackConfig,
   MkvDemuxer,
@@ -175,6 +185,7 @@ pub use webcodecs::{
   VideoEncoder,
   VideoEncoderConfig,
   VideoEncoderEncodeOptions,
+  VideoEncoderFramePoolStats,
   VideoEncoderSupport,
   VideoFrame,
   VideoFrameCopyToOptions,
@@ -189,10 +200,23 @@ pub use webcodecs::{
   WebMMuxer,
   WebMMuxerOptions,
   WebMVideoTrackConfig,
-  // Hardware acceleration utilities
+  // Hardware acceleration and threading utilities
   get_available_hardware_accelerators,
+  get_codec_thread_budget,
+  get_codec_worker_threads,
+  get_frame_memory_stats,
   get_hardware_accelerators,
+  get_hardware_session_stats,
   get_preferred_hardware_accelerator,
+  get_scaler_threads,
   is_hardware_accelerator_available,
+  release_unused_hardware_devices,
   reset_hardware_fallback_state,
+  set_codec_thread_budget,
+  set_codec_worker_threads,
+  set_frame_memory_budget,
+  set_frame_memory_pressure_listener,
+  set_hardware_session_limits,
+  set_scaler_threads,
+  warm_up_hardware,
 };
@@ -8,6 +8,7 @@ use crate::ffi::AVSampleFormat;
 use crate::webcodecs::error::{
   enforce_range_long_long, invalid_state_error, throw_invalid_state_error,
 };
+use crate::webcodecs::frame_memory::sync_external_memory;
 use napi::bindgen_prelude::*;
 use napi_derive::napi;
 use parking_lot::RwLock as ParkingLotRwLock;
@@ -259,6 +260,8 @@ impl AudioData {
   /// Per spec, the constructor takes a single init object containing all parameters including data
   #[napi(constructor)]
   pub fn new(env: Env, init: AudioDataInit) -> Result<Self> {
+    sync_external_memory(&env)?;
+
     // Validate zero values
     if init.sample_rate == 0.0 {
       env.throw_type_error("sampleRate must be greater than 0", None)?;
@@ -796,14 +799,15 @@ impl AudioData {
 
   /// Close and release resources
   #[napi]
-  pub fn close(&self) -> Result<()> {
+  pub fn close(&self, env: Env) -> Result<()> {
     let mut inner = self
       .inner
       .lock()
       .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
 
     *inner = None;
-    Ok(())
+    drop(inner);
+    sync_external_memory(&env)
   }
 
   // ========================================================================
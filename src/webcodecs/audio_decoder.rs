@@ -3,13 +3,20 @@
 //! Provides audio decoding functionality using FFmpeg.
 //! See: https://w3c.github.io/webcodecs/#audiodecoder-interface
 
-use crate::codec::{AudioDecoderConfig as InternalAudioDecoderConfig, CodecContext, Frame, Packet};
+use crate::codec::{
+  AudioDecoderConfig as InternalAudioDecoderConfig, CodecContext, CodecStats, Frame, Packet, Stage,
+  frame_memory, probe,
+};
 use crate::ffi::AVCodecID;
+use crate::webcodecs::codec_stats::CodecPerformanceStats;
+use crate::webcodecs::codec_worker::{self, CodecWorker, CommandSender, Handled};
+use crate::webcodecs::decode_pipeline::PipelineSlot;
 use crate::webcodecs::encoded_audio_chunk::EncodedAudioChunkInner;
 use crate::webcodecs::error::{DOMExceptionName, throw_invalid_state_error, throw_type_error_unit};
+use crate::webcodecs::frame_memory::sync_external_memory;
 use crate::webcodecs::promise_reject::{reject_with_dom_exception_async, reject_with_type_error};
 use crate::webcodecs::{AudioData, AudioDecoderConfig, AudioDecoderSupport, EncodedAudioChunk};
-use crossbeam::channel::{self, Receiver, Sender};
+use crossbeam::channel::{self, Sender};
 use napi::bindgen_prelude::*;
 use napi::threadsafe_function::{
   ThreadsafeFunction, ThreadsafeFunctionCallMode, UnknownReturnValue,
@@ -18,8 +25,8 @@ use napi_derive::napi;
 use std::collections::HashMap;
 use std::rc::Rc;
 use std::sync::atomic::{AtomicBool, Ordering};
-use std::sync::{Arc, Mutex, RwLock};
-use std::thread::JoinHandle;
+use std::sync::{Arc, Mutex, RwLock, Weak};
+use std::time::Instant;
 
 use super::video_encoder::CodecState;
 
@@ -100,6 +107,16 @@ enum DecoderCommand {
   Decode {
     chunk: Arc<RwLock<Option<EncodedAudioChunkInner>>>,
     timestamp: i64,
+    /// When the command was queued (for queue wait stats)
+    queued_at: Instant,
+  },
+  /// Decode a chunk queued by a demuxer `decodeTo()` pipeline; the slot is
+  /// returned to the pipeline once the chunk has been processed
+  PipelineDecode {
+    chunk: Arc<RwLock<Option<EncodedAudioChunkInner>>>,
+    timestamp: i64,
+    slot: PipelineSlot,
+    queued_at: Instant,
   },
   /// Flush the decoder and send result back via response channel
   Flush(Sender<Result<()>>),
@@ -207,6 +224,10 @@ struct AudioDecoderInner {
   /// Queue of timestamps from input chunks (to preserve original timestamps)
   /// FFmpeg may return AV_NOPTS_VALUE for frame.pts(), so we track input timestamps
   timestamp_queue: std::collections::VecDeque<i64>,
+  /// Performance counters, shared with the JS object and the codec context
+  stats: Arc<CodecStats>,
+  /// How long the next chunk has been held back for frame memory headroom
+  headroom_wait: frame_memory::HeadroomWait,
 }
 
 /// AudioDecoder - WebCodecs-compliant audio decoder
@@ -246,11 +267,13 @@ pub struct AudioDecoder {
   #[allow(dead_code)]
   error_callback_ref: Rc<FunctionRef<Error, UnknownReturnValue>>,
   /// Channel sender for worker commands (wrapped in Arc for Weak references in microtasks)
-  command_sender: Option<Arc<Sender<DecoderCommand>>>,
-  /// Worker thread handle
-  worker_handle: Option<JoinHandle<()>>,
+  command_sender: Option<Arc<CommandSender<DecoderCommand>>>,
+  /// Command worker (dedicated thread or shared pool)
+  worker_handle: Option<CodecWorker>,
   /// Reset abort flag - set by reset() to signal worker to skip pending decodes
   reset_flag: Arc<AtomicBool>,
+  /// Performance counters (read by getStats() without the inner lock)
+  stats: Arc<CodecStats>,
 }
 
 impl Drop for AudioDecoder {
@@ -259,8 +282,8 @@ impl Drop for AudioDecoder {
     self.command_sender = None;
 
     // Wait for worker to finish (brief block, necessary for safety)
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     // Drain decoder to ensure codec threads finish before context drops.
@@ -275,6 +298,74 @@ impl Drop for AudioDecoder {
   }
 }
 
+/// Worker input used by the demuxers' native `decodeTo()` pipeline
+///
+/// Queues demuxed chunks directly on the worker channel, applying the same
+/// state checks as `decode()` but reporting failures as errors for the
+/// pipeline instead of throwing.
+pub(crate) struct AudioDecoderInput {
+  inner: Arc<Mutex<AudioDecoderInner>>,
+  /// Weak so a pipeline never keeps a closed/reset worker channel alive
+  sender: Weak<CommandSender<DecoderCommand>>,
+  reset_flag: Arc<AtomicBool>,
+}
+
+impl AudioDecoderInput {
+  /// Queue a chunk for decoding; `slot` is released once the worker is done with it
+  pub(crate) fn submit(&self, chunk: EncodedAudioChunk, slot: PipelineSlot) -> Result<()> {
+    let Some(sender) = self.sender.upgrade() else {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "InvalidStateError: Decoder was reset or closed",
+      ));
+    };
+    if self.reset_flag.load(Ordering::SeqCst) {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "AbortError: The operation was aborted",
+      ));
+    }
+
+    let timestamp = chunk.get_timestamp()?;
+    {
+      let mut inner = self
+        .inner
+        .lock()
+        .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+      if inner.state != CodecState::Configured {
+        return Err(Error::new(
+          Status::GenericFailure,
+          "InvalidStateError: Cannot decode with an unconfigured codec",
+        ));
+      }
+      inner.decode_queue_size += 1;
+    }
+
+    let _ = sender.send(DecoderCommand::PipelineDecode {
+      chunk: chunk.inner,
+      timestamp,
+      slot,
+      queued_at: Instant::now(),
+    });
+    Ok(())
+  }
+}
+
+impl AudioDecoder {
+  /// Get a worker input for a demuxer `decodeTo()` pipeline
+  pub(crate) fn pipeline_input(&self) -> Result<AudioDecoderInput> {
+    let sender = self
+      .command_sender
+      .as_ref()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Decoder has been closed"))?;
+    Ok(AudioDecoderInput {
+      inner: self.inner.clone(),
+      sender: Arc::downgrade(sender),
+      reset_flag: self.reset_flag.clone(),
+    })
+  }
+}
+
 #[napi]
 impl AudioDecoder {
   /// Create a new AudioDecoder with init dictionary (per WebCodecs spec)
@@ -285,6 +376,7 @@ impl AudioDecoder {
     #[napi(ts_arg_type = "{ output: (data: AudioData) => void, error: (error: Error) => void }")]
     init: AudioDecoderInit,
   ) -> Result<Self> {
+    let stats = Arc::new(CodecStats::new("AudioDecoder"));
     let inner = AudioDecoderInner {
       state: CodecState::Unconfigured,
       config: None,
@@ -300,29 +392,18 @@ impl AudioDecoder {
       pending_data: Vec::new(),
       inside_flush: false,
       timestamp_queue: std::collections::VecDeque::new(),
+      stats: stats.clone(),
+      headroom_wait: Default::default(),
     };
 
     let inner = Arc::new(Mutex::new(inner));
     let event_state = Arc::new(RwLock::new(EventListenerState::default()));
 
-    // Create channel for worker commands
-    let (sender, receiver) = channel::unbounded();
-
     // Create reset abort flag
     let reset_flag = Arc::new(AtomicBool::new(false));
 
-    // Spawn worker thread
-    let worker_inner = inner.clone();
-    let worker_event_state = event_state.clone();
-    let worker_reset_flag = reset_flag.clone();
-    let worker_handle = std::thread::spawn(move || {
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    });
+    // Start the command worker
+    let (sender, worker_handle) = Self::spawn_worker(&inner, &event_state, &reset_flag);
 
     Ok(Self {
       inner,
@@ -333,52 +414,99 @@ impl AudioDecoder {
       command_sender: Some(Arc::new(sender)),
       worker_handle: Some(worker_handle),
       reset_flag,
+      stats,
     })
   }
 
-  /// Worker loop that processes commands from the channel
-  fn worker_loop(
-    inner: Arc<Mutex<AudioDecoderInner>>,
-    event_state: Arc<RwLock<EventListenerState>>,
-    receiver: Receiver<DecoderCommand>,
-    reset_flag: Arc<AtomicBool>,
-  ) {
-    while let Ok(command) = receiver.recv() {
-      // Check reset flag before processing each command
-      // If reset() was called, skip remaining decode commands
-      if reset_flag.load(Ordering::SeqCst) {
-        // Still process flush commands to send responses, but skip decodes
-        if let DecoderCommand::Flush(response_sender) = command {
-          let _ = response_sender.send(Err(Error::new(
-            Status::GenericFailure,
-            "AbortError: The operation was aborted",
-          )));
-        } else {
-          // For decode commands, just decrement queue and fire dequeue
-          if let Ok(mut guard) = inner.lock() {
-            let old_size = guard.decode_queue_size;
-            guard.decode_queue_size = old_size.saturating_sub(1);
-            if old_size > 0 {
-              let _ = Self::fire_dequeue_event(&event_state);
-            }
+  /// Start a worker that processes commands in order
+  fn spawn_worker(
+    inner: &Arc<Mutex<AudioDecoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &Arc<AtomicBool>,
+  ) -> (CommandSender<DecoderCommand>, CodecWorker) {
+    let inner = inner.clone();
+    let event_state = event_state.clone();
+    let reset_flag = reset_flag.clone();
+    codec_worker::spawn_deferrable(move |command| {
+      Self::handle_command(&inner, &event_state, &reset_flag, command)
+    })
+  }
+
+  /// Whether a decode must wait for frame memory to be released
+  ///
+  /// Above the soft budget each chunk is held back for a bounded time so the
+  /// decoder doesn't run ahead of a consumer that isn't closing frames.
+  fn must_wait_for_headroom(inner: &Mutex<AudioDecoderInner>) -> bool {
+    inner.lock().is_ok_and(|mut guard| {
+      guard.state == CodecState::Configured && guard.headroom_wait.should_defer()
+    })
+  }
+
+  /// Process one command on the worker
+  fn handle_command(
+    inner: &Arc<Mutex<AudioDecoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &AtomicBool,
+    command: DecoderCommand,
+  ) -> Handled<DecoderCommand> {
+    // Check reset flag before processing each command
+    // If reset() was called, skip remaining decode commands
+    if reset_flag.load(Ordering::SeqCst) {
+      // Still process flush commands to send responses, but skip decodes
+      if let DecoderCommand::Flush(response_sender) = command {
+        let _ = response_sender.send(Err(Error::new(
+          Status::GenericFailure,
+          "AbortError: The operation was aborted",
+        )));
+      } else {
+        // For decode commands, just decrement queue and fire dequeue
+        if let Ok(mut guard) = inner.lock() {
+          if !matches!(command, DecoderCommand::Reconfigure(_)) {
+            guard.stats.add_dropped();
+          }
+          let old_size = guard.decode_queue_size;
+          guard.decode_queue_size = old_size.saturating_sub(1);
+          if old_size > 0 {
+            let _ = Self::fire_dequeue_event(event_state);
           }
         }
-        continue;
       }
+      return Handled::Done;
+    }
 
-      match command {
-        DecoderCommand::Decode { chunk, timestamp } => {
-          Self::process_decode(&inner, &event_state, chunk, timestamp);
-        }
-        DecoderCommand::Flush(response_sender) => {
-          let result = Self::process_flush(&inner, &event_state);
-          let _ = response_sender.send(result);
-        }
-        DecoderCommand::Reconfigure(config) => {
-          Self::process_reconfigure(&inner, &config);
-        }
+    if matches!(
+      command,
+      DecoderCommand::Decode { .. } | DecoderCommand::PipelineDecode { .. }
+    ) && Self::must_wait_for_headroom(inner)
+    {
+      return Handled::Deferred(command);
+    }
+
+    match command {
+      DecoderCommand::Decode {
+        chunk,
+        timestamp,
+        queued_at,
+      } => {
+        Self::process_decode(inner, event_state, chunk, timestamp, queued_at);
+      }
+      DecoderCommand::PipelineDecode {
+        chunk,
+        timestamp,
+        slot: _slot,
+        queued_at,
+      } => {
+        Self::process_decode(inner, event_state, chunk, timestamp, queued_at);
+      }
+      DecoderCommand::Flush(response_sender) => {
+        let result = Self::process_flush(inner, event_state);
+        let _ = response_sender.send(result);
+      }
+      DecoderCommand::Reconfigure(config) => {
+        Self::process_reconfigure(inner, &config);
       }
     }
+    Handled::Done
   }
 
   /// Process a decode command on the worker thread
@@ -387,14 +515,17 @@ impl AudioDecoder {
     event_state: &Arc<RwLock<EventListenerState>>,
     chunk: Arc<RwLock<Option<EncodedAudioChunkInner>>>,
     timestamp: i64,
+    queued_at: Instant,
   ) {
     let mut guard = match inner.lock() {
       Ok(g) => g,
       Err(_) => return, // Lock poisoned
     };
+    guard.stats.record_since(Stage::QueueWait, queued_at);
 
     // Check if decoder is still configured
     if guard.state != CodecState::Configured {
+      guard.stats.add_dropped();
       let old_size = guard.decode_queue_size;
       guard.decode_queue_size = old_size.saturating_sub(1);
       if old_size > 0 {
@@ -405,6 +536,7 @@ impl AudioDecoder {
       // Don't call report_error() - that would set state to Closed and invoke error callback
       return;
     }
+    guard.stats.add_input();
 
     let inner_lock = match chunk.read() {
       Ok(lock) => lock,
@@ -520,12 +652,23 @@ impl AudioDecoder {
 
       // During flush, queue data for synchronous delivery in resolver
       // Otherwise, use NonBlocking callback for immediate delivery
+      guard.stats.add_output();
       if guard.inside_flush {
         guard.pending_data.push(audio_data);
       } else {
-        guard
-          .output_callback
-          .call(audio_data, ThreadsafeFunctionCallMode::Blocking);
+        let stats = guard.stats.clone();
+        let queued_at = Instant::now();
+        guard.output_callback.call_with_return_value(
+          audio_data,
+          ThreadsafeFunctionCallMode::Blocking,
+          move |ret: Result<UnknownReturnValue>, env: Env| {
+            stats.record_since(Stage::Callback, queued_at);
+            // Decoded frames count as V8 external memory
+            sync_external_memory(&env)?;
+            // Rethrow what the output callback threw
+            ret.map(|_| ())
+          },
+        );
       }
     }
   }
@@ -578,6 +721,7 @@ impl AudioDecoder {
       let pts = frame.pts();
       let audio_data = AudioData::from_internal(frame, pts);
       // Always queue during flush for synchronous delivery in resolver
+      guard.stats.add_output();
       guard.pending_data.push(audio_data);
     }
 
@@ -686,6 +830,7 @@ impl AudioDecoder {
     }
 
     // Update state
+    context.set_stats(guard.stats.clone());
     guard.context = Some(context);
     guard.config = Some(decoder_config);
     guard.codec_string = codec;
@@ -784,6 +929,15 @@ impl AudioDecoder {
     Ok(inner.decode_queue_size)
   }
 
+  /// Get per-stage performance counters (non-standard extension)
+  ///
+  /// Reads atomic counters without waiting for the worker, so it is cheap
+  /// enough to poll for metrics export.
+  #[napi]
+  pub fn get_stats(&self) -> CodecPerformanceStats {
+    CodecPerformanceStats::from(&*self.stats)
+  }
+
   /// Set the dequeue event handler (per WebCodecs spec)
   ///
   /// The dequeue event fires when decodeQueueSize decreases,
@@ -951,6 +1105,7 @@ impl AudioDecoder {
       return Ok(());
     }
 
+    context.set_stats(self.stats.clone());
     inner.context = Some(context);
     inner.config = Some(decoder_config);
     inner.codec_string = codec;
@@ -961,20 +1116,10 @@ impl AudioDecoder {
 
     // Create new channel and worker for decode operations
     if self.command_sender.is_none() {
-      let (sender, receiver) = channel::unbounded();
-      self.command_sender = Some(Arc::new(sender));
-      let worker_inner = self.inner.clone();
-      let worker_event_state = self.event_state.clone();
-      let worker_reset_flag = self.reset_flag.clone();
       drop(inner);
-      self.worker_handle = Some(std::thread::spawn(move || {
-        Self::worker_loop(
-          worker_inner,
-          worker_event_state,
-          receiver,
-          worker_reset_flag,
-        );
-      }));
+      let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
+      self.command_sender = Some(Arc::new(sender));
+      self.worker_handle = Some(worker);
     }
 
     Ok(())
@@ -1024,7 +1169,11 @@ impl AudioDecoder {
         if !reset_flag.load(Ordering::SeqCst) {
           // Only send if decoder hasn't been closed (weak reference can still upgrade)
           if let Some(sender) = weak_sender.upgrade() {
-            let _ = sender.send(DecoderCommand::Decode { chunk, timestamp });
+            let _ = sender.send(DecoderCommand::Decode {
+              chunk,
+              timestamp,
+              queued_at: Instant::now(),
+            });
           }
         }
         Ok(())
@@ -1255,30 +1404,12 @@ impl AudioDecoder {
     // Reset the abort flag for new worker
     self.reset_flag.store(false, Ordering::SeqCst);
 
-    // Create new channel and worker for future decode operations
-    let (sender, receiver) = channel::unbounded();
+    // Create new channel and worker for future decode operations. Commands
+    // queue on the channel until the worker picks them up.
+    drop(inner); // Release lock before starting the worker
+    let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
     self.command_sender = Some(Arc::new(sender));
-    let worker_inner = self.inner.clone();
-    let worker_event_state = self.event_state.clone();
-    let worker_reset_flag = self.reset_flag.clone();
-
-    // Create synchronization channel to wait for worker to be ready
-    let (ready_sender, ready_receiver) = channel::bounded::<()>(1);
-
-    drop(inner); // Release lock before spawning thread
-    self.worker_handle = Some(std::thread::spawn(move || {
-      // Signal that worker is ready before entering the loop
-      let _ = ready_sender.send(());
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    }));
-
-    // Wait for worker to be ready (prevents race condition)
-    let _ = ready_receiver.recv();
+    self.worker_handle = Some(worker);
 
     Ok(())
   }
@@ -1305,8 +1436,8 @@ impl AudioDecoder {
 
     // Now safe to join - worker will see channel disconnect and exit
     // (Previously caused deadlock when microtasks held strong sender clones)
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     let mut inner = self
@@ -1369,11 +1500,9 @@ impl AudioDecoder {
         }
       };
 
-      // Try to create decoder
-      let result = CodecContext::new_decoder(codec_id);
-
+      // Decoder availability is probed once per codec
       Ok(AudioDecoderSupport {
-        supported: result.is_ok(),
+        supported: probe::decoder_available(codec_id),
         config,
       })
     })
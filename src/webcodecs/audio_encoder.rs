@@ -4,16 +4,18 @@
 //! See: https://w3c.github.io/webcodecs/#audioencoder-interface
 
 use crate::codec::{
-  AudioEncoderConfig as InternalAudioEncoderConfig, AudioSampleBuffer, CodecContext, Frame,
-  Resampler, context::get_audio_encoder_name,
+  AudioEncoderConfig as InternalAudioEncoderConfig, AudioSampleBuffer, CodecContext, CodecStats,
+  Frame, Resampler, Stage, context::get_audio_encoder_name, probe,
 };
 use crate::ffi::{AVCodecID, AVSampleFormat};
+use crate::webcodecs::codec_stats::CodecPerformanceStats;
+use crate::webcodecs::codec_worker::{self, CodecWorker, CommandSender};
 use crate::webcodecs::error::{DOMExceptionName, throw_invalid_state_error, throw_type_error_unit};
 use crate::webcodecs::promise_reject::{reject_with_dom_exception_async, reject_with_type_error};
 use crate::webcodecs::{
   AacBitstreamFormat, AudioData, AudioEncoderConfig, AudioEncoderSupport, EncodedAudioChunk,
 };
-use crossbeam::channel::{self, Receiver, Sender};
+use crossbeam::channel::{self, Sender};
 use napi::bindgen_prelude::*;
 use napi::threadsafe_function::{
   ThreadsafeFunction, ThreadsafeFunctionCallMode, UnknownReturnValue,
@@ -23,7 +25,7 @@ use std::collections::HashMap;
 use std::rc::Rc;
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, Mutex, RwLock};
-use std::thread::JoinHandle;
+use std::time::Instant;
 
 use super::video_encoder::CodecState;
 
@@ -207,8 +209,12 @@ pub struct AudioEncoderEncodeOptions {
 
 /// Commands sent to the worker thread
 enum EncoderCommand {
-  /// Encode an audio frame
-  Encode { frame: Frame, timestamp: i64 },
+  /// Encode an audio frame (queued at `queued_at`, for queue wait stats)
+  Encode {
+    frame: Frame,
+    timestamp: i64,
+    queued_at: Instant,
+  },
   /// Flush the encoder and send result back via response channel
   Flush(Sender<Result<()>>),
   /// Reconfigure the encoder with a new configuration
@@ -265,6 +271,8 @@ struct AudioEncoderInner {
   /// See: https://w3c.github.io/webcodecs/flac_codec_registration.html
   /// Stores (codec, sample_rate, number_of_channels, description_bytes)
   cached_flac_decoder_config: Option<(String, f64, u32, Option<Vec<u8>>)>,
+  /// Performance counters, shared with the JS object and the codec context
+  stats: Arc<CodecStats>,
 }
 
 /// AudioEncoder - WebCodecs-compliant audio encoder
@@ -306,11 +314,13 @@ pub struct AudioEncoder {
   #[allow(dead_code)]
   error_callback_ref: Rc<FunctionRef<Error, UnknownReturnValue>>,
   /// Channel sender for worker commands (wrapped in Arc for Weak references in microtasks)
-  command_sender: Option<Arc<Sender<EncoderCommand>>>,
-  /// Worker thread handle
-  worker_handle: Option<JoinHandle<()>>,
+  command_sender: Option<Arc<CommandSender<EncoderCommand>>>,
+  /// Command worker (dedicated thread or shared pool)
+  worker_handle: Option<CodecWorker>,
   /// Reset flag - checked by microtasks to skip sending if reset() was called
   reset_flag: Arc<AtomicBool>,
+  /// Performance counters (read by getStats() without the inner lock)
+  stats: Arc<CodecStats>,
 }
 
 impl Drop for AudioEncoder {
@@ -319,8 +329,8 @@ impl Drop for AudioEncoder {
     self.command_sender = None;
 
     // Wait for worker to finish (brief block, necessary for safety)
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     // Drain encoder to ensure codec threads finish before context drops.
@@ -347,6 +357,7 @@ impl AudioEncoder {
     )]
     init: AudioEncoderInit,
   ) -> Result<Self> {
+    let stats = Arc::new(CodecStats::new("AudioEncoder"));
     let inner = AudioEncoderInner {
       state: CodecState::Unconfigured,
       config: None,
@@ -371,6 +382,7 @@ impl AudioEncoder {
       use_adts: false,
       adts_params: None,
       cached_flac_decoder_config: None,
+      stats: stats.clone(),
     };
 
     let inner = Arc::new(Mutex::new(inner));
@@ -378,24 +390,11 @@ impl AudioEncoder {
     // Create separate lock for event listener state (avoids contention with encode operations)
     let event_state = Arc::new(RwLock::new(EventListenerState::default()));
 
-    // Create channel for worker commands
-    let (sender, receiver) = channel::unbounded();
-
     // Create reset flag for microtask synchronization
     let reset_flag = Arc::new(AtomicBool::new(false));
 
-    // Spawn worker thread
-    let worker_inner = inner.clone();
-    let worker_event_state = event_state.clone();
-    let worker_reset_flag = reset_flag.clone();
-    let worker_handle = std::thread::spawn(move || {
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    });
+    // Start the command worker
+    let (sender, worker_handle) = Self::spawn_worker(&inner, &event_state, &reset_flag);
 
     Ok(Self {
       inner,
@@ -406,52 +405,70 @@ impl AudioEncoder {
       command_sender: Some(Arc::new(sender)),
       worker_handle: Some(worker_handle),
       reset_flag,
+      stats,
+    })
+  }
+
+  /// Start a worker that processes commands in order
+  fn spawn_worker(
+    inner: &Arc<Mutex<AudioEncoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &Arc<AtomicBool>,
+  ) -> (CommandSender<EncoderCommand>, CodecWorker) {
+    let inner = inner.clone();
+    let event_state = event_state.clone();
+    let reset_flag = reset_flag.clone();
+    codec_worker::spawn(move |command| {
+      Self::handle_command(&inner, &event_state, &reset_flag, command)
     })
   }
 
-  /// Worker loop that processes commands from the channel
-  fn worker_loop(
-    inner: Arc<Mutex<AudioEncoderInner>>,
-    event_state: Arc<RwLock<EventListenerState>>,
-    receiver: Receiver<EncoderCommand>,
-    reset_flag: Arc<AtomicBool>,
+  /// Process one command on the worker
+  fn handle_command(
+    inner: &Arc<Mutex<AudioEncoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &AtomicBool,
+    command: EncoderCommand,
   ) {
-    // Simple blocking recv - channel disconnects when all senders dropped
-    // (including microtask cloned senders after they check reset_flag and skip sending)
-    while let Ok(command) = receiver.recv() {
-      // Check reset flag before processing each command
-      // If reset() was called, skip remaining encode commands
-      if reset_flag.load(Ordering::SeqCst) {
-        // Still process flush commands to send responses, but skip encodes
-        if let EncoderCommand::Flush(response_sender) = command {
-          let _ = response_sender.send(Err(Error::new(
-            Status::GenericFailure,
-            "AbortError: The operation was aborted",
-          )));
-        } else {
-          // For encode commands, just decrement queue and fire dequeue
-          if let Ok(mut guard) = inner.lock() {
-            let old_size = guard.encode_queue_size;
-            guard.encode_queue_size = old_size.saturating_sub(1);
-            if old_size > 0 {
-              let _ = Self::fire_dequeue_event(&event_state);
-            }
+    // Check reset flag before processing each command
+    // If reset() was called, skip remaining encode commands
+    if reset_flag.load(Ordering::SeqCst) {
+      // Still process flush commands to send responses, but skip encodes
+      if let EncoderCommand::Flush(response_sender) = command {
+        let _ = response_sender.send(Err(Error::new(
+          Status::GenericFailure,
+          "AbortError: The operation was aborted",
+        )));
+      } else {
+        // For encode commands, just decrement queue and fire dequeue
+        if let Ok(mut guard) = inner.lock() {
+          if matches!(command, EncoderCommand::Encode { .. }) {
+            guard.stats.add_dropped();
+          }
+          let old_size = guard.encode_queue_size;
+          guard.encode_queue_size = old_size.saturating_sub(1);
+          if old_size > 0 {
+            let _ = Self::fire_dequeue_event(event_state);
           }
         }
-        continue;
       }
+      return;
+    }
 
-      match command {
-        EncoderCommand::Encode { frame, timestamp } => {
-          Self::process_encode(&inner, &event_state, frame, timestamp);
-        }
-        EncoderCommand::Flush(response_sender) => {
-          let result = Self::process_flush(&inner, &event_state);
-          let _ = response_sender.send(result);
-        }
-        EncoderCommand::Reconfigure(config) => {
-          Self::process_reconfigure(&inner, &config);
-        }
+    match command {
+      EncoderCommand::Encode {
+        frame,
+        timestamp,
+        queued_at,
+      } => {
+        Self::process_encode(inner, event_state, frame, timestamp, queued_at);
+      }
+      EncoderCommand::Flush(response_sender) => {
+        let result = Self::process_flush(inner, event_state);
+        let _ = response_sender.send(result);
+      }
+      EncoderCommand::Reconfigure(config) => {
+        Self::process_reconfigure(inner, &config);
       }
     }
   }
@@ -462,14 +479,17 @@ impl AudioEncoder {
     event_state: &Arc<RwLock<EventListenerState>>,
     frame: Frame,
     timestamp: i64,
+    queued_at: Instant,
   ) {
     let mut guard = match inner.lock() {
       Ok(g) => g,
       Err(_) => return, // Lock poisoned
     };
+    guard.stats.record_since(Stage::QueueWait, queued_at);
 
     // Check if encoder is still configured
     if guard.state != CodecState::Configured {
+      guard.stats.add_dropped();
       let old_size = guard.encode_queue_size;
       guard.encode_queue_size = old_size.saturating_sub(1);
       if old_size > 0 {
@@ -481,6 +501,8 @@ impl AudioEncoder {
       return;
     }
 
+    guard.stats.add_input();
+
     // Track base timestamp from first input for output timestamp calculation
     if guard.base_timestamp.is_none() {
       guard.base_timestamp = Some(timestamp);
@@ -515,7 +537,7 @@ impl AudioEncoder {
         }
       };
 
-      if let Err(e) = sample_buffer.add_frame(&frame) {
+      if let Err(e) = sample_buffer.add_frame(frame) {
         let old_size = guard.encode_queue_size;
         guard.encode_queue_size = old_size.saturating_sub(1);
         if old_size > 0 {
@@ -652,6 +674,9 @@ impl AudioEncoder {
       };
 
       guard.frame_count += 1;
+      if let Some(sample_buffer) = guard.sample_buffer.as_mut() {
+        sample_buffer.recycle(frame_to_encode);
+      }
 
       // Calculate duration per frame in microseconds
       let duration_us = (frame_size * 1_000_000) / sample_rate;
@@ -727,12 +752,20 @@ impl AudioEncoder {
 
         // During flush, queue chunks for synchronous delivery in resolver
         // Otherwise, use NonBlocking callback for immediate delivery
+        guard.stats.add_output();
         if guard.inside_flush {
           guard.pending_chunks.push((chunk, metadata));
         } else {
-          guard.output_callback.call(
+          let stats = guard.stats.clone();
+          let queued_at = Instant::now();
+          guard.output_callback.call_with_return_value(
             (chunk, metadata).into(),
             ThreadsafeFunctionCallMode::NonBlocking,
+            move |ret: Result<UnknownReturnValue>, _env: Env| {
+              stats.record_since(Stage::Callback, queued_at);
+              // Rethrow what the output callback threw
+              ret.map(|_| ())
+            },
           );
         }
       }
@@ -872,6 +905,7 @@ impl AudioEncoder {
             };
             let metadata = EncodedAudioChunkMetadata { decoder_config };
             // Always queue during flush for synchronous delivery
+            guard.stats.add_output();
             guard.pending_chunks.push((chunk, metadata));
           }
         }
@@ -938,6 +972,7 @@ impl AudioEncoder {
         };
         let metadata = EncodedAudioChunkMetadata { decoder_config };
         // Always queue during flush for synchronous delivery
+        guard.stats.add_output();
         guard.pending_chunks.push((chunk, metadata));
       }
     } // mutex released here
@@ -1090,6 +1125,7 @@ impl AudioEncoder {
     };
 
     // Update state
+    context.set_stats(guard.stats.clone());
     guard.context = Some(context);
     guard.sample_buffer = Some(sample_buffer);
     guard.target_format = target_format;
@@ -1191,6 +1227,16 @@ impl AudioEncoder {
     Ok(inner.encode_queue_size)
   }
 
+  /// Get per-stage performance counters (non-standard extension)
+  ///
+  /// Reads atomic counters without waiting for the worker, so it is cheap
+  /// enough to poll for metrics export. Resampling happens when `encode()`
+  /// is called, so `convert` is measured on the JS thread.
+  #[napi]
+  pub fn get_stats(&self) -> CodecPerformanceStats {
+    CodecPerformanceStats::from(&*self.stats)
+  }
+
   /// Set the dequeue event handler (per WebCodecs spec)
   ///
   /// The dequeue event fires when encodeQueueSize decreases,
@@ -1383,6 +1429,7 @@ impl AudioEncoder {
       target_format,
     );
 
+    context.set_stats(self.stats.clone());
     inner.context = Some(context);
     inner.sample_buffer = Some(sample_buffer);
     inner.target_format = target_format;
@@ -1415,20 +1462,10 @@ impl AudioEncoder {
 
     // Create new channel and worker if needed (after reconfiguration)
     if self.command_sender.is_none() {
-      let (sender, receiver) = channel::unbounded();
+      drop(inner); // Release lock before starting the worker
+      let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
       self.command_sender = Some(Arc::new(sender));
-      let worker_inner = self.inner.clone();
-      let worker_event_state = self.event_state.clone();
-      let worker_reset_flag = self.reset_flag.clone();
-      drop(inner); // Release lock before spawning thread
-      self.worker_handle = Some(std::thread::spawn(move || {
-        Self::worker_loop(
-          worker_inner,
-          worker_event_state,
-          receiver,
-          worker_reset_flag,
-        );
-      }));
+      self.worker_handle = Some(worker);
     }
 
     Ok(())
@@ -1544,7 +1581,10 @@ impl AudioEncoder {
 
       // Resample if needed (creates new frame) or pass through (shared via refcount)
       let frame_to_send = if let Some(ref mut resampler) = inner.resampler {
-        match resampler.convert_alloc(&frame) {
+        match self
+          .stats
+          .time(Stage::Convert, || resampler.convert_alloc(&frame))
+        {
           Ok(f) => f,
           Err(e) => {
             Self::report_error(&mut inner, &format!("Resampling failed: {}", e));
@@ -1575,6 +1615,7 @@ impl AudioEncoder {
           let _ = sender.send(EncoderCommand::Encode {
             frame: frame_to_send,
             timestamp,
+            queued_at: Instant::now(),
           });
         }
         Ok(())
@@ -1807,20 +1848,10 @@ impl AudioEncoder {
     self.reset_flag.store(false, Ordering::SeqCst);
 
     // Create new channel and worker for future encode operations
-    let (sender, receiver) = channel::unbounded();
+    drop(inner); // Release lock before starting the worker
+    let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
     self.command_sender = Some(Arc::new(sender));
-    let worker_inner = self.inner.clone();
-    let worker_event_state = self.event_state.clone();
-    let worker_reset_flag = self.reset_flag.clone();
-    drop(inner); // Release lock before spawning thread
-    self.worker_handle = Some(std::thread::spawn(move || {
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    }));
+    self.worker_handle = Some(worker);
 
     Ok(())
   }
@@ -1848,8 +1879,8 @@ impl AudioEncoder {
     // Now safe to join worker - channel is closed, worker will see recv() Err and exit.
     // This prevents resource contention where old worker is still holding FFmpeg resources
     // while new encoder is being created.
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     let mut inner = self
@@ -1920,18 +1951,12 @@ impl AudioEncoder {
         }
       };
 
-      // Try to find encoder
-      let encoder_name = get_audio_encoder_name(codec_id);
-      let result = if let Some(name) = encoder_name {
-        CodecContext::new_encoder_by_name(name).or_else(|_| CodecContext::new_encoder(codec_id))
-      } else {
-        CodecContext::new_encoder(codec_id)
-      };
+      // Encoder availability is probed once per codec
+      let supported = get_audio_encoder_name(codec_id)
+        .is_some_and(probe::encoder_available_by_name)
+        || probe::encoder_available(codec_id);
 
-      Ok(AudioEncoderSupport {
-        supported: result.is_ok(),
-        config,
-      })
+      Ok(AudioEncoderSupport { supported, config })
     })
   }
 
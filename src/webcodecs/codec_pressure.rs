@@ -1,59 +1,66 @@
-//! Codec Pressure Gauge - Global resource tracking for hardware encoders
+//! Codec Pressure Gauge - Global resource tracking for hardware codecs
 //!
-//! Tracks the number of active hardware encoder sessions to prevent resource
-//! exhaustion. VideoToolbox on macOS has strict (undocumented) limits on
-//! concurrent encoder sessions, causing failures when exceeded.
+//! Tracks the number of active hardware encoder and decoder sessions to prevent
+//! resource exhaustion. VideoToolbox on macOS has strict (undocumented) limits
+//! on concurrent encoder sessions, causing failures when exceeded.
 //!
 //! This module provides automatic graceful degradation to software encoding
 //! when hardware slots are exhausted, allowing tests to run in parallel safely.
+//!
+//! The platform defaults are conservative; hosts with more capable hardware
+//! (e.g. NVENC cards with many sessions) can raise them at runtime with
+//! `setHardwareSessionLimits()`. `getHardwareSessionStats()` reports current
+//! usage together with denied acquisitions and software fallbacks.
 
 use std::sync::OnceLock;
-use std::sync::atomic::{AtomicU32, Ordering};
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
 
-/// Global gauge for tracking codec resource pressure
-pub struct CodecPressureGauge {
-  /// Number of active hardware video encoder sessions
-  hw_video_encoders: AtomicU32,
-  /// Maximum allowed concurrent hardware encoders
-  max_hw_encoders: u32,
-}
+use napi_derive::napi;
 
-impl CodecPressureGauge {
-  /// Create a new pressure gauge with platform-specific limits
-  const fn new() -> Self {
-    // VideoToolbox on macOS is particularly restrictive (1-8 concurrent sessions)
-    // Other platforms (NVENC, VAAPI, QSV) are generally more permissive
-    #[cfg(target_os = "macos")]
-    let max_hw_encoders = 2;
-    #[cfg(not(target_os = "macos"))]
-    let max_hw_encoders = 4;
+/// Slot accounting for one kind of hardware session (encoder or decoder)
+struct SessionCounter {
+  /// Label used in log messages
+  kind: &'static str,
+  /// Number of active hardware sessions
+  active: AtomicU32,
+  /// Maximum allowed concurrent hardware sessions
+  max: AtomicU32,
+  /// Acquisitions refused because all slots were in use
+  denied: AtomicU64,
+  /// Sessions that wanted hardware but ended up on a software codec
+  software_fallbacks: AtomicU64,
+}
 
+impl SessionCounter {
+  const fn new(kind: &'static str, max: u32) -> Self {
     Self {
-      hw_video_encoders: AtomicU32::new(0),
-      max_hw_encoders,
+      kind,
+      active: AtomicU32::new(0),
+      max: AtomicU32::new(max),
+      denied: AtomicU64::new(0),
+      software_fallbacks: AtomicU64::new(0),
     }
   }
 
-  /// Try to acquire a hardware encoder slot
-  ///
-  /// Returns `true` if a slot was acquired, `false` if at capacity.
-  /// The caller must call `release_hw_encoder()` when done if this returns `true`.
-  pub fn try_acquire_hw_encoder(&self) -> bool {
+  fn try_acquire(&self) -> bool {
     loop {
-      let current = self.hw_video_encoders.load(Ordering::SeqCst);
-      if current >= self.max_hw_encoders {
+      let current = self.active.load(Ordering::SeqCst);
+      let max = self.max.load(Ordering::SeqCst);
+      if current >= max {
+        self.denied.fetch_add(1, Ordering::Relaxed);
         return false;
       }
       if self
-        .hw_video_encoders
+        .active
         .compare_exchange(current, current + 1, Ordering::SeqCst, Ordering::SeqCst)
         .is_ok()
       {
         tracing::debug!(
           target: "webcodecs",
-          "Acquired hardware encoder slot ({}/{})",
+          "Acquired hardware {} slot ({}/{})",
+          self.kind,
           current + 1,
-          self.max_hw_encoders
+          max
         );
         return true;
       }
@@ -61,30 +68,125 @@ impl CodecPressureGauge {
     }
   }
 
-  /// Release a hardware encoder slot
-  ///
-  /// Must be called exactly once for each successful `try_acquire_hw_encoder()` call.
-  pub fn release_hw_encoder(&self) {
-    let prev = self.hw_video_encoders.fetch_sub(1, Ordering::SeqCst);
+  fn release(&self) {
+    let prev = self.active.fetch_sub(1, Ordering::SeqCst);
     tracing::debug!(
       target: "webcodecs",
-      "Released hardware encoder slot ({}/{})",
+      "Released hardware {} slot ({}/{})",
+      self.kind,
       prev - 1,
-      self.max_hw_encoders
+      self.max.load(Ordering::SeqCst)
     );
   }
+
+  fn record_fallback(&self) {
+    self.software_fallbacks.fetch_add(1, Ordering::Relaxed);
+  }
+
+  fn stats(&self) -> HardwareSessionCounters {
+    HardwareSessionCounters {
+      active: self.active.load(Ordering::SeqCst),
+      max: self.max.load(Ordering::SeqCst),
+      denied: self.denied.load(Ordering::Relaxed) as i64,
+      software_fallbacks: self.software_fallbacks.load(Ordering::Relaxed) as i64,
+    }
+  }
+}
+
+/// Global gauge for tracking codec resource pressure
+pub struct CodecPressureGauge {
+  /// Hardware video encoder sessions
+  hw_video_encoders: SessionCounter,
+  /// Hardware video decoder sessions
+  hw_video_decoders: SessionCounter,
+}
+
+impl CodecPressureGauge {
+  /// Create a new pressure gauge with platform-specific limits
+  const fn new() -> Self {
+    // VideoToolbox on macOS is particularly restrictive (1-8 concurrent sessions)
+    // Other platforms (NVENC, VAAPI, QSV) are generally more permissive.
+    // Decode sessions are much cheaper than encode sessions on all of them.
+    #[cfg(target_os = "macos")]
+    let (max_hw_encoders, max_hw_decoders) = (2, 8);
+    #[cfg(not(target_os = "macos"))]
+    let (max_hw_encoders, max_hw_decoders) = (4, 16);
+
+    Self {
+      hw_video_encoders: SessionCounter::new("encoder", max_hw_encoders),
+      hw_video_decoders: SessionCounter::new("decoder", max_hw_decoders),
+    }
+  }
+
+  /// Try to acquire a hardware encoder slot
+  ///
+  /// Returns `true` if a slot was acquired, `false` if at capacity.
+  /// The caller must call `release_hw_encoder()` when done if this returns `true`.
+  pub fn try_acquire_hw_encoder(&self) -> bool {
+    self.hw_video_encoders.try_acquire()
+  }
+
+  /// Release a hardware encoder slot
+  ///
+  /// Must be called exactly once for each successful `try_acquire_hw_encoder()` call.
+  pub fn release_hw_encoder(&self) {
+    self.hw_video_encoders.release();
+  }
+
+  /// Record an encoder that wanted hardware but is running in software
+  pub fn record_encoder_fallback(&self) {
+    self.hw_video_encoders.record_fallback();
+  }
+
+  /// Try to acquire a hardware decoder slot
+  ///
+  /// Returns `true` if a slot was acquired, `false` if at capacity.
+  /// The caller must call `release_hw_decoder()` when done if this returns `true`.
+  pub fn try_acquire_hw_decoder(&self) -> bool {
+    self.hw_video_decoders.try_acquire()
+  }
+
+  /// Release a hardware decoder slot
+  ///
+  /// Must be called exactly once for each successful `try_acquire_hw_decoder()` call.
+  pub fn release_hw_decoder(&self) {
+    self.hw_video_decoders.release();
+  }
+
+  /// Record a decoder that wanted hardware but is running in software
+  pub fn record_decoder_fallback(&self) {
+    self.hw_video_decoders.record_fallback();
+  }
+
+  /// Change the encoder slot limit; sessions already holding a slot keep it
+  pub fn set_max_hw_encoders(&self, max: u32) {
+    self.hw_video_encoders.max.store(max, Ordering::SeqCst);
+  }
+
+  /// Change the decoder slot limit; sessions already holding a slot keep it
+  pub fn set_max_hw_decoders(&self, max: u32) {
+    self.hw_video_decoders.max.store(max, Ordering::SeqCst);
+  }
+
+  /// Snapshot of all session counters
+  pub fn stats(&self) -> HardwareSessionStats {
+    HardwareSessionStats {
+      encoders: self.hw_video_encoders.stats(),
+      decoders: self.hw_video_decoders.stats(),
+    }
+  }
 }
 
 #[cfg(test)]
 impl CodecPressureGauge {
   /// Get the current number of active hardware encoders (test-only)
   fn active_hw_encoders(&self) -> u32 {
-    self.hw_video_encoders.load(Ordering::SeqCst)
+    self.hw_video_encoders.active.load(Ordering::SeqCst)
   }
 
   /// Get the maximum number of hardware encoders allowed (test-only)
   fn max_hw_encoders(&self) -> u32 {
-    self.max_hw_encoders
+    self.hw_video_encoders.max.load(Ordering::SeqCst)
   }
 }
 
@@ -96,6 +198,64 @@ pub fn gauge() -> &'static CodecPressureGauge {
   GAUGE.get_or_init(CodecPressureGauge::new)
 }
 
+/// Usage counters for one kind of hardware session (non-standard)
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct HardwareSessionCounters {
+  /// Sessions currently holding a hardware slot
+  pub active: u32,
+  /// Maximum concurrent hardware sessions
+  pub max: u32,
+  /// Slot acquisitions refused because all slots were in use
+  pub denied: i64,
+  /// Sessions that wanted hardware but ended up on a software codec
+  pub software_fallbacks: i64,
+}
+
+/// Hardware session usage reported by `getHardwareSessionStats()` (non-standard)
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct HardwareSessionStats {
+  /// VideoEncoder hardware sessions
+  pub encoders: HardwareSessionCounters,
+  /// VideoDecoder hardware sessions
+  pub decoders: HardwareSessionCounters,
+}
+
+/// Limits accepted by `setHardwareSessionLimits()` (non-standard)
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct HardwareSessionLimits {
+  /// Maximum concurrent hardware VideoEncoder sessions
+  pub max_encoders: Option<u32>,
+  /// Maximum concurrent hardware VideoDecoder sessions
+  pub max_decoders: Option<u32>,
+}
+
+/// Set the maximum number of concurrent hardware encoder/decoder sessions.
+///
+/// Omitted members keep their current value. Once the limit is reached,
+/// `no-preference` encoders use a software codec and `prefer-hardware`
+/// codecs try hardware anyway. Lowering a limit doesn't affect sessions
+/// that already hold a slot.
+#[napi]
+pub fn set_hardware_session_limits(limits: HardwareSessionLimits) {
+  let gauge = gauge();
+  if let Some(max) = limits.max_encoders {
+    gauge.set_max_hw_encoders(max);
+  }
+  if let Some(max) = limits.max_decoders {
+    gauge.set_max_hw_decoders(max);
+  }
+}
+
+/// Get current hardware session usage, limits, denied acquisitions and
+/// software fallbacks since process start.
+#[napi]
+pub fn get_hardware_session_stats() -> HardwareSessionStats {
+  gauge().stats()
+}
+
 #[cfg(test)]
 mod tests {
   use super::*;
@@ -129,4 +289,32 @@ mod tests {
     }
     assert_eq!(gauge.active_hw_encoders(), 0);
   }
+
+  #[test]
+  fn test_limits_and_stats() {
+    let gauge = CodecPressureGauge::new();
+    gauge.set_max_hw_decoders(1);
+
+    assert!(gauge.try_acquire_hw_decoder());
+    assert!(!gauge.try_acquire_hw_decoder());
+    gauge.record_decoder_fallback();
+
+    let stats = gauge.stats();
+    assert_eq!(stats.decoders.active, 1);
+    assert_eq!(stats.decoders.max, 1);
+    assert_eq!(stats.decoders.denied, 1);
+    assert_eq!(stats.decoders.software_fallbacks, 1);
+    // Encoder counters are independent
+    assert_eq!(stats.encoders.active, 0);
+    assert_eq!(stats.encoders.denied, 0);
+
+    // Raising the limit frees up room without touching held slots
+    gauge.set_max_hw_decoders(2);
+    assert!(gauge.try_acquire_hw_decoder());
+    assert_eq!(gauge.stats().decoders.active, 2);
+
+    gauge.release_hw_decoder();
+    gauge.release_hw_decoder();
+    assert_eq!(gauge.stats().decoders.active, 0);
+  }
 }
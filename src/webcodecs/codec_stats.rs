@@ -0,0 +1,88 @@
+//! `getStats()` results for VideoEncoder/VideoDecoder/AudioEncoder/AudioDecoder
+//!
+//! The counters themselves live in `crate::codec::CodecStats`; this module
+//! only converts a snapshot into the JS object.
+
+use std::time::Duration;
+
+use napi_derive::napi;
+
+use crate::codec::{CodecStats, Stage};
+
+/// Timings of one codec pipeline stage (non-standard extension)
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct CodecStageStats {
+  /// Number of timed operations
+  pub count: i64,
+  /// Total time spent in the stage
+  pub total_ms: f64,
+  /// Mean time per operation (0 when count is 0)
+  pub mean_ms: f64,
+  /// Longest single operation
+  pub max_ms: f64,
+}
+
+/// Per-instance performance counters (non-standard extension)
+///
+/// Counters accumulate from construction and are read without taking the
+/// codec lock, so polling `getStats()` does not slow the codec down.
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct CodecPerformanceStats {
+  /// Time inputs waited in the queue before the worker picked them up
+  pub queue_wait: CodecStageStats,
+  /// Pixel format conversion/scaling (video) or resampling (audio)
+  pub convert: CodecStageStats,
+  /// `avcodec_send_frame` / `avcodec_send_packet` calls
+  pub send: CodecStageStats,
+  /// `avcodec_receive_packet` / `avcodec_receive_frame` calls
+  pub receive: CodecStageStats,
+  /// CPU → GPU frame uploads (hardware encoders)
+  pub hardware_upload: CodecStageStats,
+  /// GPU → CPU frame downloads (hardware decoders)
+  pub hardware_download: CodecStageStats,
+  /// From an output being queued by the worker until the JS output
+  /// callback returned (includes the time spent in the callback)
+  pub callback: CodecStageStats,
+  /// Inputs taken off the queue for processing
+  pub inputs: i64,
+  /// Outputs produced
+  pub outputs: i64,
+  /// Inputs discarded without being processed (queue policy or reset)
+  pub dropped: i64,
+  /// Switches from a hardware to a software codec
+  pub hardware_fallbacks: i64,
+}
+
+fn millis(duration: Duration) -> f64 {
+  duration.as_secs_f64() * 1000.0
+}
+
+fn stage_stats(stats: &CodecStats, stage: Stage) -> CodecStageStats {
+  let stage = stats.stage(stage);
+  CodecStageStats {
+    count: stage.count as i64,
+    total_ms: millis(stage.total),
+    mean_ms: millis(stage.mean()),
+    max_ms: millis(stage.max),
+  }
+}
+
+impl From<&CodecStats> for CodecPerformanceStats {
+  fn from(stats: &CodecStats) -> Self {
+    Self {
+      queue_wait: stage_stats(stats, Stage::QueueWait),
+      convert: stage_stats(stats, Stage::Convert),
+      send: stage_stats(stats, Stage::Send),
+      receive: stage_stats(stats, Stage::Receive),
+      hardware_upload: stage_stats(stats, Stage::HwUpload),
+      hardware_download: stage_stats(stats, Stage::HwDownload),
+      callback: stage_stats(stats, Stage::Callback),
+      inputs: stats.inputs() as i64,
+      outputs: stats.outputs() as i64,
+      dropped: stats.dropped() as i64,
+      hardware_fallbacks: stats.hw_fallbacks() as i64,
+    }
+  }
+}
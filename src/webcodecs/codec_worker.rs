@@ -0,0 +1,727 @@
+//! Codec command workers
+//!
+//! Every codec processes its commands (decode, encode, flush, reconfigure) in
+//! order on a worker fed through a channel. By default each codec gets its own
+//! OS thread blocked in `recv()`, so an application holding hundreds of mostly
+//! idle codecs holds hundreds of threads.
+//!
+//! With `setCodecWorkerThreads(n)` codecs started afterwards share a fixed pool
+//! of `n` threads instead. Each codec becomes a task that is scheduled when a
+//! command is sent, drains its queue (at most `COMMANDS_PER_TURN` commands per
+//! turn so a busy codec can't starve the others) and goes idle again. A task is
+//! only ever run by one thread at a time, so per-codec FIFO ordering holds.
+//! Tasks scheduled from a pool thread (e.g. a decoder feeding piped encoders)
+//! go to that thread's local deque; idle threads steal from the others.
+//!
+//! Dropping the last `CommandSender` disconnects the channel exactly like
+//! dropping a crossbeam `Sender`: the worker drains what is queued, releases
+//! its state and `CodecWorker::join()` returns. Dropping a `CodecWorker`
+//! without joining detaches it.
+//!
+//! A handler that can't make progress yet (e.g. a decoder whose piped encoders
+//! are full) returns `Handled::Deferred` instead of waiting. The command stays
+//! at the head of its codec's queue and is retried once the worker is woken
+//! through its `WorkerWaker`, or after `RETRY_INTERVAL`. A dedicated thread
+//! parks meanwhile; a pooled codec gives its thread back to the other codecs.
+//!
+//! Handlers must never block. Pool threads are shared, so a handler waiting
+//! on something only another codec or the JS thread can provide (queue room,
+//! freed memory, a condvar) can hold every pool thread and deadlock the
+//! process. Anything that has to wait returns `Handled::Deferred`.
+
+use std::cell::RefCell;
+use std::panic::{AssertUnwindSafe, catch_unwind};
+use std::sync::atomic::{AtomicU8, AtomicU32, Ordering};
+use std::sync::{Arc, OnceLock, Weak};
+use std::thread::{JoinHandle, Thread};
+use std::time::{Duration, Instant};
+
+use crossbeam::channel::{self, Receiver, SendError, Sender, TryRecvError};
+use crossbeam::deque::{Injector, Steal, Stealer, Worker};
+use parking_lot::{Condvar, Mutex};
+
+/// Commands a pooled codec handles per turn before yielding its thread
+const COMMANDS_PER_TURN: usize = 32;
+
+/// Longest a deferred command waits for a wakeup before it is retried
+pub(crate) const RETRY_INTERVAL: Duration = Duration::from_millis(5);
+
+/// Pool size for newly started workers; 0 = one dedicated thread per codec
+static POOL_THREADS: AtomicU32 = AtomicU32::new(0);
+
+/// Shared pool, started on first use with the size in effect at that time
+static EXECUTOR: OnceLock<Arc<Executor>> = OnceLock::new();
+
+/// Set the shared pool size used by workers started afterwards
+///
+/// The pool can't be resized once started: asking for a different non-zero
+/// size then fails with the running size. 0 always succeeds.
+pub(crate) fn set_pool_threads(threads: u32) -> Result<(), u32> {
+  if let Some(executor) = EXECUTOR.get()
+    && threads != 0
+    && threads != executor.threads
+  {
+    return Err(executor.threads);
+  }
+  POOL_THREADS.store(threads, Ordering::Relaxed);
+  Ok(())
+}
+
+/// Get the shared pool size used by workers started afterwards
+pub(crate) fn pool_threads() -> u32 {
+  POOL_THREADS.load(Ordering::Relaxed)
+}
+
+/// What a handler did with a command
+///
+/// Handlers never wait (see the module docs); `Deferred` is how they wait.
+pub(crate) enum Handled<T> {
+  /// The command was processed (or dropped)
+  Done,
+  /// The command can't make progress yet; retry it before any later command
+  Deferred(T),
+}
+
+/// Start a worker that calls `handler` for every command, in order
+///
+/// Runs on the shared pool when one is enabled, otherwise on a new thread.
+pub(crate) fn spawn<T, H>(mut handler: H) -> (CommandSender<T>, CodecWorker)
+where
+  T: Send + 'static,
+  H: FnMut(T) + Send + 'static,
+{
+  spawn_deferrable(move |command| {
+    handler(command);
+    Handled::Done
+  })
+}
+
+/// Like `spawn`, for handlers that may defer a command (see `Handled`)
+pub(crate) fn spawn_deferrable<T, H>(mut handler: H) -> (CommandSender<T>, CodecWorker)
+where
+  T: Send + 'static,
+  H: FnMut(T) -> Handled<T> + Send + 'static,
+{
+  let threads = pool_threads();
+  if threads == 0 {
+    return spawn_thread(move |receiver| {
+      while let Ok(mut command) = receiver.recv() {
+        while let Handled::Deferred(deferred) = handler(command) {
+          wait_to_retry();
+          command = deferred;
+        }
+      }
+    });
+  }
+
+  let (sender, receiver) = channel::unbounded();
+  let task = Arc::new(PooledTask {
+    state: AtomicU8::new(IDLE),
+    body: Mutex::new(Some(TaskBody {
+      receiver,
+      deferred: None,
+      handler: Box::new(handler),
+    })),
+    finished: Mutex::new(false),
+    finished_cond: Condvar::new(),
+    executor: executor(threads).clone(),
+  });
+
+  (
+    CommandSender {
+      sender: Some(sender),
+      task: Some(task.clone()),
+      thread: None,
+    },
+    CodecWorker::Pooled(task),
+  )
+}
+
+/// Start a worker on a dedicated thread that owns the receiving end
+///
+/// For codecs that need blocking receives with deadlines (batched output).
+/// A loop that defers a command calls `wait_to_retry()` before retrying it.
+pub(crate) fn spawn_thread<T, L>(run_loop: L) -> (CommandSender<T>, CodecWorker)
+where
+  T: Send + 'static,
+  L: FnOnce(Receiver<T>) + Send + 'static,
+{
+  let (sender, receiver) = channel::unbounded();
+  let handle = std::thread::spawn(move || run_loop(receiver));
+  (
+    CommandSender {
+      sender: Some(sender),
+      task: None,
+      thread: Some(handle.thread().clone()),
+    },
+    CodecWorker::Thread(handle),
+  )
+}
+
+/// Wait on a dedicated worker thread until woken or `RETRY_INTERVAL` elapses
+pub(crate) fn wait_to_retry() {
+  std::thread::park_timeout(RETRY_INTERVAL);
+}
+
+/// Wakes a worker so it retries its deferred command
+///
+/// Doesn't keep the worker alive: waking a finished worker does nothing.
+#[derive(Clone)]
+pub(crate) enum WorkerWaker {
+  Thread(Thread),
+  Pooled(Weak<dyn PoolTask>),
+}
+
+impl WorkerWaker {
+  pub(crate) fn wake(&self) {
+    match self {
+      WorkerWaker::Thread(thread) => thread.unpark(),
+      WorkerWaker::Pooled(task) => {
+        if let Some(task) = task.upgrade() {
+          task.wake();
+        }
+      }
+    }
+  }
+
+  /// Whether both wake the same worker
+  pub(crate) fn same_worker(&self, other: &WorkerWaker) -> bool {
+    match (self, other) {
+      (WorkerWaker::Thread(a), WorkerWaker::Thread(b)) => a.id() == b.id(),
+      (WorkerWaker::Pooled(a), WorkerWaker::Pooled(b)) => Weak::ptr_eq(a, b),
+      _ => false,
+    }
+  }
+}
+
+/// Sending half of a codec command queue
+pub(crate) struct CommandSender<T: Send + 'static> {
+  /// Always `Some` until dropped; taken in `Drop` to disconnect first
+  sender: Option<Sender<T>>,
+  task: Option<Arc<PooledTask<T>>>,
+  /// Dedicated worker thread, for `waker()`
+  thread: Option<Thread>,
+}
+
+impl<T: Send + 'static> CommandSender<T> {
+  /// Queue a command; fails once the worker is gone
+  pub(crate) fn send(&self, command: T) -> Result<(), SendError<T>> {
+    match &self.sender {
+      Some(sender) => sender.send(command)?,
+      None => return Err(SendError(command)),
+    }
+    if let Some(task) = &self.task {
+      task.schedule();
+    }
+    Ok(())
+  }
+
+  /// Commands queued but not yet picked up by the worker
+  pub(crate) fn len(&self) -> usize {
+    self.sender.as_ref().map_or(0, Sender::len)
+  }
+
+  /// Handle that wakes this worker to retry a deferred command
+  pub(crate) fn waker(&self) -> Option<WorkerWaker> {
+    if let Some(task) = &self.task {
+      let task: Arc<dyn PoolTask> = task.clone();
+      return Some(WorkerWaker::Pooled(Arc::downgrade(&task)));
+    }
+    self.thread.clone().map(WorkerWaker::Thread)
+  }
+}
+
+impl<T: Send + 'static> Drop for CommandSender<T> {
+  fn drop(&mut self) {
+    // Disconnect before the final run so the task observes it and finishes
+    drop(self.sender.take());
+    if let Some(task) = self.task.take() {
+      task.schedule();
+    }
+  }
+}
+
+/// Handle to a codec worker, on its own thread or on the shared pool
+pub(crate) enum CodecWorker {
+  Thread(JoinHandle<()>),
+  Pooled(Arc<dyn PoolTask>),
+}
+
+impl CodecWorker {
+  /// Wait for the worker to drain its queue after the sender was dropped
+  pub(crate) fn join(self) {
+    match self {
+      CodecWorker::Thread(handle) => {
+        let _ = handle.join();
+      }
+      CodecWorker::Pooled(task) => task.wait_finished(),
+    }
+  }
+}
+
+/// Type-erased pooled task as seen by the executor
+pub(crate) trait PoolTask: Send + Sync {
+  fn run(self: Arc<Self>);
+  fn wake(self: Arc<Self>);
+  fn wait_finished(&self);
+}
+
+/// Not queued and not running
+const IDLE: u8 = 0;
+/// Queued on the executor
+const SCHEDULED: u8 = 1;
+/// Being run by a pool thread
+const RUNNING: u8 = 2;
+/// Commands arrived while running; run again when done
+const NOTIFIED: u8 = 3;
+
+struct TaskBody<T> {
+  receiver: Receiver<T>,
+  /// Command the handler deferred; runs before anything in `receiver`
+  deferred: Option<T>,
+  handler: Box<dyn FnMut(T) -> Handled<T> + Send>,
+}
+
+/// How a turn of a pooled task ended
+enum Drained {
+  /// Queue empty or turn used up
+  Yielded,
+  /// Waiting to retry a deferred command
+  Deferred,
+  /// Channel disconnected and drained
+  Closed,
+}
+
+struct PooledTask<T> {
+  state: AtomicU8,
+  /// Cleared once the channel disconnects, dropping the codec state
+  body: Mutex<Option<TaskBody<T>>>,
+  finished: Mutex<bool>,
+  finished_cond: Condvar,
+  executor: Arc<Executor>,
+}
+
+impl<T: Send + 'static> PooledTask<T> {
+  /// Make sure the task runs (again) after the caller's send
+  fn schedule(self: &Arc<Self>) {
+    let mut state = self.state.load(Ordering::Acquire);
+    loop {
+      let next = match state {
+        IDLE => SCHEDULED,
+        RUNNING => NOTIFIED,
+        // Already queued or will re-run; it will see the new command
+        _ => return,
+      };
+      match self
+        .state
+        .compare_exchange(state, next, Ordering::AcqRel, Ordering::Acquire)
+      {
+        Ok(_) => break,
+        Err(actual) => state = actual,
+      }
+    }
+    if state == IDLE {
+      self.executor.push(self.clone());
+    }
+  }
+
+  /// Handle queued commands, starting with a deferred one
+  fn drain(&self) -> Drained {
+    let mut body = self.body.lock();
+    let Some(task) = body.as_mut() else {
+      return Drained::Closed;
+    };
+    for _ in 0..COMMANDS_PER_TURN {
+      let command = match task.deferred.take() {
+        Some(command) => command,
+        None => match task.receiver.try_recv() {
+          Ok(command) => command,
+          Err(TryRecvError::Empty) => return Drained::Yielded,
+          Err(TryRecvError::Disconnected) => {
+            *body = None;
+            return Drained::Closed;
+          }
+        },
+      };
+      if let Handled::Deferred(command) = (task.handler)(command) {
+        task.deferred = Some(command);
+        return Drained::Deferred;
+      }
+    }
+    Drained::Yielded
+  }
+
+  fn finish(&self) {
+    *self.body.lock() = None;
+    *self.finished.lock() = true;
+    self.finished_cond.notify_all();
+  }
+}
+
+impl<T: Send + 'static> PoolTask for PooledTask<T> {
+  fn run(self: Arc<Self>) {
+    self.state.store(RUNNING, Ordering::Release);
+
+    // A panicking codec ends its worker, like a panicking worker thread would
+    let drained = catch_unwind(AssertUnwindSafe(|| self.drain())).unwrap_or(Drained::Closed);
+    match drained {
+      Drained::Closed => {
+        self.finish();
+        return;
+      }
+      Drained::Deferred => {
+        if self
+          .state
+          .compare_exchange(RUNNING, IDLE, Ordering::AcqRel, Ordering::Acquire)
+          .is_ok()
+        {
+          // Idle until woken; a wake() from here on reschedules us
+          let executor = self.executor.clone();
+          executor.retry_later(self);
+          return;
+        }
+        // Woken (or sent a command) while running: retry behind the others
+        self.state.store(SCHEDULED, Ordering::Release);
+        let executor = self.executor.clone();
+        executor.push(self);
+        return;
+      }
+      Drained::Yielded => {}
+    }
+
+    if self
+      .state
+      .compare_exchange(RUNNING, IDLE, Ordering::AcqRel, Ordering::Acquire)
+      .is_ok()
+    {
+      // Commands sent before the state change are picked up: they either
+      // were drained above or their schedule() saw RUNNING and notified us
+      if self
+        .body
+        .lock()
+        .as_ref()
+        .is_some_and(|t| t.receiver.is_empty())
+      {
+        return;
+      }
+      if self
+        .state
+        .compare_exchange(IDLE, SCHEDULED, Ordering::AcqRel, Ordering::Acquire)
+        .is_err()
+      {
+        // A concurrent send already rescheduled us
+        return;
+      }
+    } else {
+      // NOTIFIED: run again behind the other queued codecs
+      self.state.store(SCHEDULED, Ordering::Release);
+    }
+    let executor = self.executor.clone();
+    executor.push(self);
+  }
+
+  fn wake(self: Arc<Self>) {
+    self.schedule();
+  }
+
+  fn wait_finished(&self) {
+    let mut finished = self.finished.lock();
+    while !*finished {
+      self.finished_cond.wait(&mut finished);
+    }
+  }
+}
+
+type TaskRef = Arc<dyn PoolTask>;
+
+thread_local! {
+  /// Local deque of the current pool thread, `None` on other threads
+  static LOCAL_QUEUE: RefCell<Option<Worker<TaskRef>>> = const { RefCell::new(None) };
+}
+
+/// Fixed-size work-stealing pool running pooled codec tasks
+struct Executor {
+  threads: u32,
+  injector: Injector<TaskRef>,
+  stealers: Vec<Stealer<TaskRef>>,
+  /// Deferred tasks and when to retry them if nothing wakes them first
+  retries: Mutex<Vec<(Instant, TaskRef)>>,
+  sleep_lock: Mutex<()>,
+  wake: Condvar,
+}
+
+fn executor(threads: u32) -> &'static Arc<Executor> {
+  EXECUTOR.get_or_init(|| Executor::start(threads))
+}
+
+impl Executor {
+  fn start(threads: u32) -> Arc<Self> {
+    let workers: Vec<Worker<TaskRef>> = (0..threads).map(|_| Worker::new_fifo()).collect();
+    let executor = Arc::new(Executor {
+      threads,
+      injector: Injector::new(),
+      stealers: workers.iter().map(Worker::stealer).collect(),
+      retries: Mutex::new(Vec::new()),
+      sleep_lock: Mutex::new(()),
+      wake: Condvar::new(),
+    });
+
+    for (index, worker) in workers.into_iter().enumerate() {
+      let executor = executor.clone();
+      std::thread::Builder::new()
+        .name(format!("webcodecs-worker-{}", index))
+        .spawn(move || {
+          LOCAL_QUEUE.with(|local| *local.borrow_mut() = Some(worker));
+          executor.worker_loop();
+        })
+        .expect("failed to spawn codec worker thread");
+    }
+
+    tracing::debug!(target: "webcodecs", "Started shared codec worker pool with {} threads", threads);
+    executor
+  }
+
+  fn push(&self, task: TaskRef) {
+    let task = LOCAL_QUEUE.with(|local| match local.borrow().as_ref() {
+      Some(queue) => {
+        queue.push(task);
+        None
+      }
+      None => Some(task),
+    });
+    if let Some(task) = task {
+      self.injector.push(task);
+    }
+
+    // Take the lock so a thread between its emptiness check and wait() can't
+    // miss the wakeup
+    let _guard = self.sleep_lock.lock();
+    self.wake.notify_one();
+  }
+
+  /// Retry a deferred task after `RETRY_INTERVAL` unless it is woken first
+  fn retry_later(&self, task: TaskRef) {
+    self
+      .retries
+      .lock()
+      .push((Instant::now() + RETRY_INTERVAL, task));
+  }
+
+  /// Wake deferred tasks whose retry time has come; returns the next retry time
+  fn wake_due_retries(&self) -> Option<Instant> {
+    let now = Instant::now();
+    let due: Vec<TaskRef> = {
+      let mut retries = self.retries.lock();
+      if retries.is_empty() {
+        return None;
+      }
+      let (due, pending) = retries.drain(..).partition(|(at, _)| *at <= now);
+      *retries = pending;
+      due.into_iter().map(|(_, task)| task).collect()
+    };
+    // A task woken meanwhile just finds nothing new to do
+    for task in due {
+      task.wake();
+    }
+    self.retries.lock().iter().map(|(at, _)| *at).min()
+  }
+
+  fn worker_loop(&self) {
+    loop {
+      let next_retry = self.wake_due_retries();
+      if let Some(task) = self.find_task() {
+        task.run();
+        continue;
+      }
+
+      let mut guard = self.sleep_lock.lock();
+      if self.has_queued_tasks() {
+        continue;
+      }
+      match next_retry {
+        Some(deadline) => {
+          self.wake.wait_until(&mut guard, deadline);
+        }
+        None => self.wake.wait(&mut guard),
+      }
+    }
+  }
+
+  /// Next task: own deque first, then the global queue, then other threads
+  fn find_task(&self) -> Option<TaskRef> {
+    LOCAL_QUEUE.with(|local| {
+      let local = local.borrow();
+      let queue = local.as_ref()?;
+      if let Some(task) = queue.pop() {
+        return Some(task);
+      }
+      loop {
+        let mut retry = false;
+        match self.injector.steal_batch_and_pop(queue) {
+          Steal::Success(task) => return Some(task),
+          Steal::Retry => retry = true,
+          Steal::Empty => {}
+        }
+        for stealer in &self.stealers {
+          match stealer.steal() {
+            Steal::Success(task) => return Some(task),
+            Steal::Retry => retry = true,
+            Steal::Empty => {}
+          }
+        }
+        if !retry {
+          return None;
+        }
+      }
+    })
+  }
+
+  fn has_queued_tasks(&self) -> bool {
+    !self.injector.is_empty() || self.stealers.iter().any(|s| !s.is_empty())
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+  use std::time::Duration;
+
+  fn pooled_sender<T: Send + 'static>(
+    threads: usize,
+    mut handler: impl FnMut(T) + Send + 'static,
+  ) -> (CommandSender<T>, CodecWorker) {
+    // Tests use a private executor so they don't depend on the global knob
+    pooled_deferrable(Executor::start(threads), move |command| {
+      handler(command);
+      Handled::Done
+    })
+  }
+
+  fn pooled_deferrable<T: Send + 'static>(
+    executor: Arc<Executor>,
+    handler: impl FnMut(T) -> Handled<T> + Send + 'static,
+  ) -> (CommandSender<T>, CodecWorker) {
+    let (sender, receiver) = channel::unbounded();
+    let task = Arc::new(PooledTask {
+      state: AtomicU8::new(IDLE),
+      body: Mutex::new(Some(TaskBody {
+        receiver,
+        deferred: None,
+        handler: Box::new(handler),
+      })),
+      finished: Mutex::new(false),
+      finished_cond: Condvar::new(),
+      executor,
+    });
+    (
+      CommandSender {
+        sender: Some(sender),
+        task: Some(task.clone()),
+        thread: None,
+      },
+      CodecWorker::Pooled(task),
+    )
+  }
+
+  #[test]
+  fn test_pooled_commands_keep_order() {
+    let seen = Arc::new(Mutex::new(Vec::new()));
+    let seen_clone = seen.clone();
+    let (sender, worker) = pooled_sender(4, move |n: u32| seen_clone.lock().push(n));
+
+    for n in 0..1000 {
+      sender.send(n).unwrap();
+    }
+    drop(sender);
+    worker.join();
+
+    assert_eq!(*seen.lock(), (0..1000).collect::<Vec<_>>());
+  }
+
+  #[test]
+  fn test_pooled_task_never_runs_concurrently() {
+    let running = Arc::new(AtomicU32::new(0));
+    let running_clone = running.clone();
+    let (sender, worker) = pooled_sender(4, move |_: ()| {
+      assert_eq!(running_clone.fetch_add(1, Ordering::SeqCst), 0);
+      std::thread::sleep(Duration::from_micros(50));
+      running_clone.fetch_sub(1, Ordering::SeqCst);
+    });
+
+    let sender = Arc::new(sender);
+    let threads: Vec<_> = (0..4)
+      .map(|_| {
+        let sender = sender.clone();
+        std::thread::spawn(move || {
+          for _ in 0..50 {
+            sender.send(()).unwrap();
+          }
+        })
+      })
+      .collect();
+    for thread in threads {
+      thread.join().unwrap();
+    }
+    drop(sender);
+    worker.join();
+  }
+
+  #[test]
+  fn test_dropping_sender_releases_state() {
+    struct DropFlag(Arc<Mutex<bool>>);
+    impl Drop for DropFlag {
+      fn drop(&mut self) {
+        *self.0.lock() = true;
+      }
+    }
+
+    let dropped = Arc::new(Mutex::new(false));
+    let flag = DropFlag(dropped.clone());
+    let (sender, worker) = pooled_sender(1, move |_: ()| {
+      let _ = &flag;
+    });
+    sender.send(()).unwrap();
+    drop(sender);
+    worker.join();
+
+    assert!(*dropped.lock());
+  }
+
+  #[test]
+  fn test_deferred_command_doesnt_hold_the_only_thread() {
+    // A consumer and a producer on a one-thread pool: the producer defers
+    // while the consumer's queue is full, which only works if deferring
+    // gives the thread back to the consumer.
+    let executor = Executor::start(1);
+    let consumed = Arc::new(AtomicU32::new(0));
+    let consumed_clone = consumed.clone();
+    let (consumer, consumer_worker) = pooled_deferrable(executor.clone(), move |_: u32| {
+      consumed_clone.fetch_add(1, Ordering::SeqCst);
+      Handled::Done
+    });
+    let consumer = Arc::new(consumer);
+
+    let produced = Arc::new(Mutex::new(Vec::new()));
+    let produced_clone = produced.clone();
+    let target = consumer.clone();
+    let (producer, producer_worker) = pooled_deferrable(executor, move |n: u32| {
+      if target.len() >= 2 {
+        return Handled::Deferred(n);
+      }
+      target.send(n).unwrap();
+      produced_clone.lock().push(n);
+      Handled::Done
+    });
+
+    for n in 0..100 {
+      producer.send(n).unwrap();
+    }
+    drop(producer);
+    producer_worker.join();
+    drop(consumer);
+    consumer_worker.join();
+
+    assert_eq!(*produced.lock(), (0..100).collect::<Vec<_>>());
+    assert_eq!(consumed.load(Ordering::SeqCst), 100);
+  }
+}
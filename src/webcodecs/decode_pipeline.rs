@@ -0,0 +1,183 @@
+//! Native demux-to-decode pipeline
+//!
+//! `demuxer.decodeTo({ videoDecoder, audioDecoder })` reads packets on a
+//! blocking thread and hands them straight to the decoders' worker threads.
+//! Encoded chunks never cross into JS; only the decoders' output callbacks
+//! (decoded frames / audio data) run on the JS thread.
+//!
+//! Each decoder gets a bounded `PipelineQueue`: the demux thread takes a slot
+//! before queueing a chunk and the decoder worker returns it once the chunk has
+//! been decoded (or discarded by reset/close). Demux therefore runs at most
+//! `maxQueueSize` chunks ahead of each decoder instead of buffering the whole
+//! file in the unbounded worker channel.
+//!
+//! The demuxer lock is only held while a packet is read, never while waiting
+//! for a slot, and `close()` aborts the wait through `PipelineAbort`. A
+//! decoder that is slow to free slots (deferring under memory pressure, or
+//! waiting on its output callback) therefore never blocks the JS thread.
+
+use std::sync::Arc;
+
+use crossbeam::channel::{self, Receiver, Sender};
+use napi::bindgen_prelude::*;
+
+use crate::webcodecs::audio_decoder::{AudioDecoder, AudioDecoderInput};
+use crate::webcodecs::video_decoder::{VideoDecoder, VideoDecoderInput};
+
+/// Default number of chunks demux may run ahead of each decoder
+pub(crate) const DEFAULT_PIPELINE_QUEUE_SIZE: u32 = 32;
+
+/// Abort signal for the `decodeTo()` runs of one demuxer
+///
+/// Lives outside the demuxer lock so `close()` can wake a run waiting for a
+/// slot before taking that lock.
+#[derive(Clone)]
+pub(crate) struct PipelineAbort {
+  /// Dropped by `abort()`, which disconnects `aborted`
+  signal: Arc<parking_lot::Mutex<Option<Sender<()>>>>,
+  aborted: Receiver<()>,
+}
+
+impl Default for PipelineAbort {
+  fn default() -> Self {
+    let (signal, aborted) = channel::bounded(0);
+    Self {
+      signal: Arc::new(parking_lot::Mutex::new(Some(signal))),
+      aborted,
+    }
+  }
+}
+
+impl PipelineAbort {
+  /// Wake every run waiting for a slot; a closed demuxer stays aborted
+  pub(crate) fn abort(&self) {
+    self.signal.lock().take();
+  }
+}
+
+/// Bounded set of in-flight slots between the demux thread and one decoder
+pub(crate) struct PipelineQueue {
+  acquire: Sender<()>,
+  release: Receiver<()>,
+  aborted: Receiver<()>,
+}
+
+impl PipelineQueue {
+  pub(crate) fn new(capacity: usize, abort: &PipelineAbort) -> Self {
+    let (acquire, release) = channel::bounded(capacity);
+    Self {
+      acquire,
+      release,
+      aborted: abort.aborted.clone(),
+    }
+  }
+
+  /// Take a slot, blocking while `capacity` chunks are still in flight
+  ///
+  /// Returns `None` once the pipeline was aborted.
+  pub(crate) fn acquire(&self) -> Option<PipelineSlot> {
+    channel::select! {
+      // Both ends are owned by self, so the channel can't disconnect here
+      send(self.acquire, ()) -> _ => Some(PipelineSlot {
+        release: self.release.clone(),
+      }),
+      // Nothing is ever sent, so this only fires once abort() disconnects it
+      recv(self.aborted) -> _ => None,
+    }
+  }
+}
+
+/// One in-flight chunk; the slot is returned to its queue on drop
+pub(crate) struct PipelineSlot {
+  release: Receiver<()>,
+}
+
+impl Drop for PipelineSlot {
+  fn drop(&mut self) {
+    let _ = self.release.try_recv();
+  }
+}
+
+/// Options for `decodeTo()`
+///
+/// The decoders are resolved to their worker inputs while parsing, so the
+/// pipeline thread never touches the JS objects.
+pub struct DecodeToOptions {
+  pub(crate) video: Option<VideoDecoderInput>,
+  pub(crate) audio: Option<AudioDecoderInput>,
+  pub(crate) max_queue_size: usize,
+}
+
+impl FromNapiValue for DecodeToOptions {
+  unsafe fn from_napi_value(
+    env: napi::sys::napi_env,
+    value: napi::sys::napi_value,
+  ) -> Result<Self> {
+    let env_wrapper = Env::from_raw(env);
+    let obj = unsafe { Object::from_napi_value(env, value)? };
+
+    let video = match obj.get::<ClassInstance<VideoDecoder>>("videoDecoder")? {
+      Some(decoder) => Some(decoder.pipeline_input()?),
+      None => None,
+    };
+    let audio = match obj.get::<ClassInstance<AudioDecoder>>("audioDecoder")? {
+      Some(decoder) => Some(decoder.pipeline_input()?),
+      None => None,
+    };
+
+    if video.is_none() && audio.is_none() {
+      env_wrapper.throw_type_error("videoDecoder or audioDecoder is required", None)?;
+      return Err(Error::new(
+        Status::InvalidArg,
+        "videoDecoder or audioDecoder is required",
+      ));
+    }
+
+    let max_queue_size = obj
+      .get::<u32>("maxQueueSize")?
+      .unwrap_or(DEFAULT_PIPELINE_QUEUE_SIZE);
+    if max_queue_size == 0 {
+      env_wrapper.throw_type_error("maxQueueSize must be greater than 0", None)?;
+      return Err(Error::new(
+        Status::InvalidArg,
+        "maxQueueSize must be greater than 0",
+      ));
+    }
+
+    Ok(Self {
+      video,
+      audio,
+      max_queue_size: max_queue_size as usize,
+    })
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  #[test]
+  fn test_queue_bounds_in_flight_slots() {
+    let queue = PipelineQueue::new(2, &PipelineAbort::default());
+    let first = queue.acquire().unwrap();
+    let _second = queue.acquire().unwrap();
+    assert!(queue.acquire.is_full());
+
+    drop(first);
+    assert!(!queue.acquire.is_full());
+    let _third = queue.acquire().unwrap();
+    assert!(queue.acquire.is_full());
+  }
+
+  #[test]
+  fn test_abort_wakes_waiting_acquire() {
+    let abort = PipelineAbort::default();
+    let queue = PipelineQueue::new(1, &abort);
+    let _slot = queue.acquire().unwrap();
+
+    let waiter = std::thread::spawn(move || queue.acquire().is_none());
+    std::thread::sleep(std::time::Duration::from_millis(20));
+    abort.abort();
+    assert!(waiter.join().unwrap());
+  }
+}
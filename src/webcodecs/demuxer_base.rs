@@ -3,21 +3,29 @@
 //! This module provides common functionality for Mp4Demuxer, WebMDemuxer, and MkvDemuxer
 //! to eliminate code duplication across the three implementations.
 
+use crate::codec::Packet;
 use crate::codec::demuxer::{DemuxerContext, MediaType, StreamInfo};
-use crate::codec::io_buffer::BufferSource;
-use crate::ffi::AVCodecID;
+use crate::codec::io_buffer::{BufferSource, MappedFile, StreamingReadBuffer, StreamingReadFeeder};
+use crate::codec::seek_index::SeekIndex;
+use crate::ffi::{AVCodecID, AVRational};
+use crate::webcodecs::decode_pipeline::{DecodeToOptions, PipelineAbort, PipelineQueue};
 use crate::webcodecs::encoded_audio_chunk::{
   EncodedAudioChunk, EncodedAudioChunkInit, EncodedAudioChunkType,
 };
 use crate::webcodecs::encoded_video_chunk::{
   EncodedVideoChunk, EncodedVideoChunkInit, EncodedVideoChunkType,
 };
+use crate::webcodecs::error::{invalid_state_error, not_supported_error};
+use crate::webcodecs::muxer_base::{GenericAudioTrackConfig, GenericVideoTrackConfig};
+use crate::webcodecs::remux_pipeline::RemuxTarget;
+use futures::stream::StreamExt;
 use napi::bindgen_prelude::*;
 use napi::threadsafe_function::{
   ThreadsafeFunction, ThreadsafeFunctionCallMode, UnknownReturnValue,
 };
 use napi_derive::napi;
 use std::marker::PhantomData;
+use std::sync::{Arc, Mutex, MutexGuard, TryLockError};
 
 // ============================================================================
 // BufferSource implementation for Uint8Array (zero-copy support)
@@ -40,23 +48,21 @@ impl BufferSource for Uint8Array {
 
 /// Helper macro to acquire mutable lock, returning error on failure.
 /// Use in methods that modify demuxer state.
+///
+/// Throws InvalidStateError instead of waiting while a read of a stream
+/// source is in flight (see `lock_demuxer_inner`).
 macro_rules! with_demuxer_inner_mut {
   ($self:expr) => {
-    $self
-      .inner
-      .lock()
-      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?
+    $crate::webcodecs::demuxer_base::lock_demuxer_inner(&$self.inner, &$self.stream_source)?
   };
 }
 
 /// Helper macro to acquire immutable lock, returning error on failure.
-/// Use in methods that only read demuxer state.
+/// Use in methods that only read demuxer state; the metadata getters read
+/// `DemuxerView` instead.
 macro_rules! with_demuxer_inner {
   ($self:expr) => {
-    $self
-      .inner
-      .lock()
-      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?
+    $crate::webcodecs::demuxer_base::lock_demuxer_inner(&$self.inner, &$self.stream_source)?
   };
 }
 
@@ -136,6 +142,23 @@ pub struct DemuxerTrackInfo {
   pub number_of_channels: Option<u32>,
 }
 
+/// Options for Mp4Demuxer/WebMDemuxer/MkvDemuxer load()
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct DemuxerLoadOptions {
+  /// Memory-map the file and demux it as a buffer instead of using file I/O
+  /// (default: false)
+  pub mmap: Option<bool>,
+}
+
+/// Options for Mp4Demuxer/WebMDemuxer/MkvDemuxer loadStream()
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct DemuxerLoadStreamOptions {
+  /// Maximum bytes buffered ahead of the demuxer (default: 1 MiB)
+  pub buffer_size: Option<u32>,
+}
+
 /// Video decoder configuration exposed to JavaScript
 #[napi(object)]
 pub struct DemuxerVideoDecoderConfig {
@@ -227,6 +250,85 @@ pub trait DemuxerFormat: Send + Sync + 'static {
   fn codec_id_to_audio_string(codec_id: AVCodecID, extradata: Option<&[u8]>) -> String;
 }
 
+// ============================================================================
+// DemuxerView - Metadata readable without the inner lock
+// ============================================================================
+
+/// Metadata copied out of `DemuxerInner` whenever it changes
+#[derive(Clone)]
+struct DemuxerMetadata {
+  state: DemuxerState,
+  tracks: Vec<DemuxerTrackInfo>,
+  duration: Option<i64>,
+  video_stream: Option<StreamInfo>,
+  audio_stream: Option<StreamInfo>,
+}
+
+impl Default for DemuxerMetadata {
+  fn default() -> Self {
+    Self {
+      state: DemuxerState::Unloaded,
+      tracks: Vec::new(),
+      duration: None,
+      video_stream: None,
+      audio_stream: None,
+    }
+  }
+}
+
+/// Read-only view of a demuxer's metadata for the JS getters
+///
+/// Reads hold the inner lock, and on a stream source a read can wait for data
+/// that only the JS thread can push. The getters read this copy instead, so
+/// they never wait on a read.
+pub struct DemuxerView<F: DemuxerFormat> {
+  metadata: Arc<parking_lot::Mutex<DemuxerMetadata>>,
+  _format: PhantomData<F>,
+}
+
+impl<F: DemuxerFormat> DemuxerView<F> {
+  /// Get all tracks
+  pub fn tracks(&self) -> Vec<DemuxerTrackInfo> {
+    self.metadata.lock().tracks.clone()
+  }
+
+  /// Get container duration in microseconds
+  pub fn duration(&self) -> Option<i64> {
+    self.metadata.lock().duration
+  }
+
+  /// Get video decoder configuration for the selected video track
+  pub fn video_decoder_config(&self) -> Option<DemuxerVideoDecoderConfig> {
+    let s = self.metadata.lock().video_stream.clone()?;
+    let codec = F::codec_id_to_video_string(s.codec_id, s.extradata.as_deref());
+
+    Some(DemuxerVideoDecoderConfig {
+      codec,
+      coded_width: s.width.unwrap_or(0),
+      coded_height: s.height.unwrap_or(0),
+      description: s.extradata.map(Uint8Array::new),
+    })
+  }
+
+  /// Get audio decoder configuration for the selected audio track
+  pub fn audio_decoder_config(&self) -> Option<DemuxerAudioDecoderConfig> {
+    let s = self.metadata.lock().audio_stream.clone()?;
+    let codec = F::codec_id_to_audio_string(s.codec_id, s.extradata.as_deref());
+
+    Some(DemuxerAudioDecoderConfig {
+      codec,
+      sample_rate: s.sample_rate.unwrap_or(0),
+      number_of_channels: s.channels.unwrap_or(0),
+      description: s.extradata.map(Uint8Array::new),
+    })
+  }
+
+  /// Get current state as string
+  pub fn state_string(&self) -> &'static str {
+    self.metadata.lock().state.as_str()
+  }
+}
+
 // ============================================================================
 // DemuxerInner - Generic demuxer implementation
 // ============================================================================
@@ -249,6 +351,10 @@ pub struct DemuxerInner<F: DemuxerFormat> {
   pub audio_callback: Option<AudioOutputCallback>,
   /// Error callback
   pub error_callback: Option<ErrorCallback>,
+  /// Loaded from a ReadableStream, which can only be read forward
+  stream_loaded: bool,
+  /// Copy of the metadata for `DemuxerView`, updated whenever it changes
+  metadata: Arc<parking_lot::Mutex<DemuxerMetadata>>,
   /// Phantom data for format type
   _format: PhantomData<F>,
 }
@@ -269,10 +375,40 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
       video_callback,
       audio_callback,
       error_callback: Some(error_callback),
+      stream_loaded: false,
+      metadata: Arc::default(),
       _format: PhantomData,
     }
   }
 
+  /// Lock-free view of the metadata for the JS getters
+  pub fn view(&self) -> DemuxerView<F> {
+    DemuxerView {
+      metadata: self.metadata.clone(),
+      _format: PhantomData,
+    }
+  }
+
+  fn set_state(&mut self, state: DemuxerState) {
+    self.state = state;
+    self.metadata.lock().state = state;
+  }
+
+  /// Refresh the metadata copy after loading, track selection or close
+  fn publish_metadata(&self) {
+    let stream = |index: Option<i32>| {
+      let demuxer = self.demuxer.as_ref()?;
+      demuxer.get_stream(index?).cloned()
+    };
+    *self.metadata.lock() = DemuxerMetadata {
+      state: self.state,
+      tracks: self.tracks.clone(),
+      duration: self.demuxer.as_ref().and_then(|d| d.duration_us()),
+      video_stream: stream(self.selected_video_track),
+      audio_stream: stream(self.selected_audio_track),
+    };
+  }
+
   /// Load from a file path
   pub fn load_file(&mut self, path: &str) -> Result<()> {
     if self.state != DemuxerState::Unloaded {
@@ -293,6 +429,21 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     Ok(())
   }
 
+  /// Load from a file path, honoring `DemuxerLoadOptions`
+  pub fn load_file_with_options(
+    &mut self,
+    path: &str,
+    options: Option<DemuxerLoadOptions>,
+  ) -> Result<()> {
+    if !options.and_then(|o| o.mmap).unwrap_or(false) {
+      return self.load_file(path);
+    }
+
+    let mapped = MappedFile::open(path)
+      .map_err(|e| Error::new(Status::GenericFailure, format!("Failed to map file: {}", e)))?;
+    self.load_buffer(mapped)
+  }
+
   /// Load from a buffer
   ///
   /// This method accepts any type implementing `BufferSource`, enabling
@@ -316,7 +467,24 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     Ok(())
   }
 
-  /// Complete the load process (shared between file and buffer loading)
+  /// Finish loading from a streaming source
+  ///
+  /// The stream is opened without holding the inner lock (see `load_demuxer_stream`),
+  /// so the state is only checked once the headers have been read.
+  pub fn load_opened_stream(&mut self, demuxer: DemuxerContext) -> Result<()> {
+    if self.state != DemuxerState::Unloaded {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "Demuxer already loaded. Call close() first.",
+      ));
+    }
+
+    self.stream_loaded = true;
+    self.finish_load(demuxer);
+    Ok(())
+  }
+
+  /// Complete the load process (shared between file, buffer and stream loading)
   fn finish_load(&mut self, demuxer: DemuxerContext) {
     // Parse track info using format-specific codec string conversion
     let tracks = parse_tracks::<F>(demuxer.streams());
@@ -336,52 +504,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     self.selected_video_track = selected_video_track;
     self.selected_audio_track = selected_audio_track;
     self.state = DemuxerState::Ready;
-  }
-
-  /// Get all tracks
-  pub fn get_tracks(&self) -> Vec<DemuxerTrackInfo> {
-    self.tracks.clone()
-  }
-
-  /// Get container duration in microseconds
-  pub fn get_duration(&self) -> Option<i64> {
-    self.demuxer.as_ref().and_then(|d| d.duration_us())
-  }
-
-  /// Get video decoder configuration for the selected video track
-  pub fn get_video_decoder_config(&self) -> Option<DemuxerVideoDecoderConfig> {
-    let demuxer = self.demuxer.as_ref()?;
-    let video_index = self.selected_video_track?;
-
-    demuxer.get_stream(video_index).map(|s| {
-      let codec = F::codec_id_to_video_string(s.codec_id, s.extradata.as_deref());
-      let description = s.extradata.as_ref().map(|d| Uint8Array::new(d.clone()));
-
-      DemuxerVideoDecoderConfig {
-        codec,
-        coded_width: s.width.unwrap_or(0),
-        coded_height: s.height.unwrap_or(0),
-        description,
-      }
-    })
-  }
-
-  /// Get audio decoder configuration for the selected audio track
-  pub fn get_audio_decoder_config(&self) -> Option<DemuxerAudioDecoderConfig> {
-    let demuxer = self.demuxer.as_ref()?;
-    let audio_index = self.selected_audio_track?;
-
-    demuxer.get_stream(audio_index).map(|s| {
-      let codec = F::codec_id_to_audio_string(s.codec_id, s.extradata.as_deref());
-      let description = s.extradata.as_ref().map(|d| Uint8Array::new(d.clone()));
-
-      DemuxerAudioDecoderConfig {
-        codec,
-        sample_rate: s.sample_rate.unwrap_or(0),
-        number_of_channels: s.channels.unwrap_or(0),
-        description,
-      }
-    })
+    self.publish_metadata();
   }
 
   /// Select a video track by index
@@ -390,6 +513,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     match track {
       Some(t) if t.track_type == "video" => {
         self.selected_video_track = Some(track_index);
+        self.publish_metadata();
         Ok(())
       }
       Some(_) => Err(Error::new(
@@ -409,6 +533,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     match track {
       Some(t) if t.track_type == "audio" => {
         self.selected_audio_track = Some(track_index);
+        self.publish_metadata();
         Ok(())
       }
       Some(_) => Err(Error::new(
@@ -440,7 +565,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
       return;
     }
 
-    self.state = DemuxerState::Demuxing;
+    self.set_state(DemuxerState::Demuxing);
 
     let video_index = self.selected_video_track;
     let audio_index = self.selected_audio_track;
@@ -469,28 +594,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
       match demuxer.read_packet() {
         Ok(Some((packet, stream_index))) => {
           if Some(stream_index) == video_index {
-            // Process video packet
-            let timestamp = convert_timestamp(packet.pts(), video_time_base);
-            let duration = if packet.duration() > 0 {
-              Some(convert_timestamp(packet.duration(), video_time_base))
-            } else {
-              None
-            };
-
-            let chunk_type = if packet.is_key() {
-              EncodedVideoChunkType::Key
-            } else {
-              EncodedVideoChunkType::Delta
-            };
-
-            let init = EncodedVideoChunkInit {
-              chunk_type,
-              timestamp,
-              duration,
-              data: Either::B(packet),
-            };
-
-            match EncodedVideoChunk::new(init) {
+            match video_chunk_from_packet(packet, video_time_base) {
               Ok(chunk) => {
                 if let Some(ref cb) = self.video_callback {
                   let _ = cb.call(chunk, ThreadsafeFunctionCallMode::NonBlocking);
@@ -498,33 +602,12 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
               }
               Err(e) => {
                 if let Some(ref err_cb) = self.error_callback {
-                  let _ = err_cb.call(
-                    Error::new(
-                      Status::GenericFailure,
-                      format!("Failed to create video chunk: {}", e),
-                    ),
-                    ThreadsafeFunctionCallMode::NonBlocking,
-                  );
+                  let _ = err_cb.call(e, ThreadsafeFunctionCallMode::NonBlocking);
                 }
               }
             }
           } else if Some(stream_index) == audio_index {
-            // Process audio packet
-            let timestamp = convert_timestamp(packet.pts(), audio_time_base);
-            let duration = if packet.duration() > 0 {
-              Some(convert_timestamp(packet.duration(), audio_time_base))
-            } else {
-              None
-            };
-
-            let init = EncodedAudioChunkInit {
-              chunk_type: EncodedAudioChunkType::Key, // Audio packets are typically keyframes
-              timestamp,
-              duration,
-              data: Either::B(packet),
-            };
-
-            match EncodedAudioChunk::new(init) {
+            match audio_chunk_from_packet(packet, audio_time_base) {
               Ok(chunk) => {
                 if let Some(ref cb) = self.audio_callback {
                   let _ = cb.call(chunk, ThreadsafeFunctionCallMode::NonBlocking);
@@ -532,13 +615,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
               }
               Err(e) => {
                 if let Some(ref err_cb) = self.error_callback {
-                  let _ = err_cb.call(
-                    Error::new(
-                      Status::GenericFailure,
-                      format!("Failed to create audio chunk: {}", e),
-                    ),
-                    ThreadsafeFunctionCallMode::NonBlocking,
-                  );
+                  let _ = err_cb.call(e, ThreadsafeFunctionCallMode::NonBlocking);
                 }
               }
             }
@@ -549,7 +626,7 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
         }
         Ok(None) => {
           // End of stream
-          self.state = DemuxerState::EndOfStream;
+          self.set_state(DemuxerState::EndOfStream);
           break;
         }
         Err(e) => {
@@ -567,6 +644,11 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
 
   /// Seek to a timestamp in microseconds
   pub fn seek(&mut self, timestamp_us: i64) -> Result<()> {
+    if self.stream_loaded {
+      return Err(not_supported_error(
+        "seek() is not supported on a demuxer loaded from a stream",
+      ));
+    }
     let stream_index = self.selected_video_track.unwrap_or(-1);
 
     let demuxer = self
@@ -603,12 +685,60 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
 
     // Reset state to ready for more demuxing
     if self.state == DemuxerState::EndOfStream {
-      self.state = DemuxerState::Ready;
+      self.set_state(DemuxerState::Ready);
     }
 
     Ok(())
   }
 
+  /// Index every keyframe by reading the whole container once
+  ///
+  /// Leaves the demuxer positioned at the start, ready to demux.
+  pub fn build_index(&mut self) -> Result<()> {
+    if self.stream_loaded {
+      return Err(not_supported_error(
+        "buildIndex() is not supported on a demuxer loaded from a stream",
+      ));
+    }
+    let demuxer = self
+      .demuxer
+      .as_mut()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Demuxer not loaded"))?;
+
+    demuxer
+      .build_index()
+      .map_err(|e| Error::new(Status::GenericFailure, format!("Build index failed: {}", e)))?;
+
+    if self.state == DemuxerState::EndOfStream {
+      self.set_state(DemuxerState::Ready);
+    }
+    Ok(())
+  }
+
+  /// Export the keyframe index as a binary blob
+  pub fn export_index(&self) -> Result<Vec<u8>> {
+    let demuxer = self
+      .demuxer
+      .as_ref()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Demuxer not loaded"))?;
+    Ok(demuxer.seek_index().to_bytes())
+  }
+
+  /// Import a keyframe index exported from the same file
+  pub fn import_index(&mut self, data: &[u8]) -> Result<()> {
+    let demuxer = self
+      .demuxer
+      .as_mut()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Demuxer not loaded"))?;
+
+    let index =
+      SeekIndex::from_bytes(data).map_err(|e| Error::new(Status::InvalidArg, e.to_string()))?;
+    demuxer
+      .import_seek_index(&index)
+      .map_err(|e| Error::new(Status::InvalidArg, e.to_string()))?;
+    Ok(())
+  }
+
   /// Read the next chunk from the demuxer for async iteration
   ///
   /// Returns `Ok(Some(chunk))` for video/audio packets, `Ok(None)` for EOF,
@@ -649,13 +779,13 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
         .and_then(|d| d.get_stream(idx).map(|s| s.time_base))
     });
 
-    self.state = DemuxerState::Demuxing;
+    self.set_state(DemuxerState::Demuxing);
 
     loop {
       let demuxer = match self.demuxer.as_mut() {
         Some(d) => d,
         None => {
-          self.state = DemuxerState::EndOfStream;
+          self.set_state(DemuxerState::EndOfStream);
           return Ok(None);
         }
       };
@@ -663,79 +793,23 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
       match demuxer.read_packet() {
         Ok(Some((packet, stream_index))) => {
           if Some(stream_index) == video_index {
-            // Process video packet
-            let timestamp = convert_timestamp(packet.pts(), video_time_base);
-            let duration = if packet.duration() > 0 {
-              Some(convert_timestamp(packet.duration(), video_time_base))
-            } else {
-              None
-            };
-
-            let chunk_type = if packet.is_key() {
-              EncodedVideoChunkType::Key
-            } else {
-              EncodedVideoChunkType::Delta
-            };
-
-            let init = EncodedVideoChunkInit {
-              chunk_type,
-              timestamp,
-              duration,
-              data: Either::B(packet),
-            };
-
-            match EncodedVideoChunk::new(init) {
-              Ok(chunk) => {
-                return Ok(Some(DemuxerChunk {
-                  chunk_type: "video".to_string(),
-                  video_chunk: Some(chunk),
-                  audio_chunk: None,
-                }));
-              }
-              Err(e) => {
-                return Err(Error::new(
-                  Status::GenericFailure,
-                  format!("Failed to create video chunk: {}", e),
-                ));
-              }
-            }
+            return Ok(Some(DemuxerChunk {
+              chunk_type: "video".to_string(),
+              video_chunk: Some(video_chunk_from_packet(packet, video_time_base)?),
+              audio_chunk: None,
+            }));
           } else if Some(stream_index) == audio_index {
-            // Process audio packet
-            let timestamp = convert_timestamp(packet.pts(), audio_time_base);
-            let duration = if packet.duration() > 0 {
-              Some(convert_timestamp(packet.duration(), audio_time_base))
-            } else {
-              None
-            };
-
-            let init = EncodedAudioChunkInit {
-              chunk_type: EncodedAudioChunkType::Key,
-              timestamp,
-              duration,
-              data: Either::B(packet),
-            };
-
-            match EncodedAudioChunk::new(init) {
-              Ok(chunk) => {
-                return Ok(Some(DemuxerChunk {
-                  chunk_type: "audio".to_string(),
-                  video_chunk: None,
-                  audio_chunk: Some(chunk),
-                }));
-              }
-              Err(e) => {
-                return Err(Error::new(
-                  Status::GenericFailure,
-                  format!("Failed to create audio chunk: {}", e),
-                ));
-              }
-            }
+            return Ok(Some(DemuxerChunk {
+              chunk_type: "audio".to_string(),
+              video_chunk: None,
+              audio_chunk: Some(audio_chunk_from_packet(packet, audio_time_base)?),
+            }));
           }
           // Continue loop to skip packets from unselected tracks
         }
         Ok(None) => {
           // End of stream
-          self.state = DemuxerState::EndOfStream;
+          self.set_state(DemuxerState::EndOfStream);
           return Ok(None);
         }
         Err(e) => {
@@ -748,6 +822,204 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     }
   }
 
+  /// Start feeding the selected tracks to the decoders of a `decodeTo()`
+  ///
+  /// Tracks without a decoder in `options` are skipped; `decode_next_packet`
+  /// then reads the packets one at a time (see `decode_demuxer`). Returns
+  /// `None` if there is nothing left to decode.
+  pub(crate) fn start_decode(
+    &mut self,
+    options: &DecodeToOptions,
+  ) -> Result<Option<DecodeStreams>> {
+    if self.state != DemuxerState::Ready
+      && self.state != DemuxerState::Demuxing
+      && self.state != DemuxerState::EndOfStream
+    {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "Demuxer is not ready. Call load() first.",
+      ));
+    }
+
+    if self.state == DemuxerState::EndOfStream {
+      return Ok(None);
+    }
+
+    // Stream index and time base for timestamp conversion
+    let stream = |index: i32| {
+      let time_base = self
+        .demuxer
+        .as_ref()
+        .and_then(|d| d.get_stream(index).map(|s| s.time_base));
+      (index, time_base)
+    };
+    let streams = DecodeStreams {
+      video: options
+        .video
+        .as_ref()
+        .and(self.selected_video_track)
+        .map(stream),
+      audio: options
+        .audio
+        .as_ref()
+        .and(self.selected_audio_track)
+        .map(stream),
+    };
+    self.set_state(DemuxerState::Demuxing);
+    Ok(Some(streams))
+  }
+
+  /// Read the next packet of a decode started by `start_decode`
+  ///
+  /// Returns `None` at the end of the stream, or once the demuxer was closed.
+  pub(crate) fn decode_next_packet(
+    &mut self,
+    streams: &DecodeStreams,
+  ) -> Result<Option<DecodePacket>> {
+    let Some(demuxer) = self.demuxer.as_mut() else {
+      return Ok(None);
+    };
+
+    match demuxer.read_packet() {
+      Ok(Some((packet, stream_index))) => {
+        if let Some((index, tb)) = streams.video
+          && index == stream_index
+        {
+          let chunk = video_chunk_from_packet(packet, tb)?;
+          Ok(Some(DecodePacket::Video(chunk)))
+        } else if let Some((index, tb)) = streams.audio
+          && index == stream_index
+        {
+          let chunk = audio_chunk_from_packet(packet, tb)?;
+          Ok(Some(DecodePacket::Audio(chunk)))
+        } else {
+          Ok(Some(DecodePacket::Skipped))
+        }
+      }
+      Ok(None) => {
+        self.set_state(DemuxerState::EndOfStream);
+        Ok(None)
+      }
+      Err(e) => Err(Error::new(
+        Status::GenericFailure,
+        format!("Demuxer error: {}", e),
+      )),
+    }
+  }
+
+  /// Start copying the remaining packets of the selected tracks into a muxer
+  ///
+  /// Adds one muxer track per selected track, using the stream's own time base
+  /// and codec parameters; `remux_next_packet` then writes the packets
+  /// unchanged (see `remux_pipeline`). Returns `None` if there is nothing
+  /// left to copy.
+  pub(crate) fn start_remux(&mut self, target: &RemuxTarget) -> Result<Option<RemuxStreams>> {
+    if self.state != DemuxerState::Ready
+      && self.state != DemuxerState::Demuxing
+      && self.state != DemuxerState::EndOfStream
+    {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "Demuxer is not ready. Call load() first.",
+      ));
+    }
+
+    let demuxer = self
+      .demuxer
+      .as_ref()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Demuxer is closed"))?;
+    let track_codec = |index: i32| {
+      self
+        .tracks
+        .iter()
+        .find(|t| t.index == index)
+        .map(|t| t.codec.clone())
+        .unwrap_or_default()
+    };
+    let time_base = |stream: &StreamInfo| AVRational::new(stream.time_base.0, stream.time_base.1);
+
+    let video_stream = self
+      .selected_video_track
+      .and_then(|i| demuxer.get_stream(i));
+    let audio_stream = self
+      .selected_audio_track
+      .and_then(|i| demuxer.get_stream(i));
+    if video_stream.is_none() && audio_stream.is_none() {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "No tracks selected to remux",
+      ));
+    }
+
+    let video_config = video_stream.map(|s| GenericVideoTrackConfig {
+      codec: track_codec(s.index),
+      codec_id: s.codec_id,
+      width: s.width.unwrap_or(0),
+      height: s.height.unwrap_or(0),
+      framerate: 0.0,
+      extradata: s.extradata.clone(),
+      has_alpha: false,
+      time_base: Some(time_base(s)),
+    });
+    let audio_config = audio_stream.map(|s| GenericAudioTrackConfig {
+      codec: track_codec(s.index),
+      codec_id: s.codec_id,
+      sample_rate: s.sample_rate.unwrap_or(48000),
+      channels: s.channels.unwrap_or(2),
+      frame_size: None,
+      extradata: s.extradata.clone(),
+    });
+    target.0.add_remux_tracks(video_config, audio_config)?;
+
+    if self.state == DemuxerState::EndOfStream {
+      return Ok(None);
+    }
+
+    let streams = RemuxStreams {
+      video: video_stream.map(|s| (s.index, time_base(s))),
+      audio: audio_stream.map(|s| (s.index, time_base(s))),
+    };
+    self.set_state(DemuxerState::Demuxing);
+    Ok(Some(streams))
+  }
+
+  /// Copy the next packet of a remux started by `start_remux`
+  ///
+  /// Returns false at the end of the stream, or once the demuxer was closed.
+  pub(crate) fn remux_next_packet(
+    &mut self,
+    target: &RemuxTarget,
+    streams: &RemuxStreams,
+  ) -> Result<bool> {
+    let Some(demuxer) = self.demuxer.as_mut() else {
+      return Ok(false);
+    };
+
+    match demuxer.read_packet() {
+      Ok(Some((packet, stream_index))) => {
+        if let Some((index, tb)) = streams.video
+          && index == stream_index
+        {
+          target.0.write_remux_packet(packet, MediaType::Video, tb)?;
+        } else if let Some((index, tb)) = streams.audio
+          && index == stream_index
+        {
+          target.0.write_remux_packet(packet, MediaType::Audio, tb)?;
+        }
+        // Packets from other tracks are skipped
+        Ok(true)
+      }
+      Ok(None) => {
+        self.set_state(DemuxerState::EndOfStream);
+        Ok(false)
+      }
+      Err(e) => Err(Error::new(
+        Status::GenericFailure,
+        format!("Demuxer error: {}", e),
+      )),
+    }
+  }
+
   /// Close the demuxer and release resources
   pub fn close(&mut self) {
     self.demuxer = None;
@@ -755,14 +1027,246 @@ impl<F: DemuxerFormat> DemuxerInner<F> {
     self.selected_video_track = None;
     self.selected_audio_track = None;
     self.state = DemuxerState::Closed;
+    self.publish_metadata();
   }
+}
 
-  /// Get current state as string
-  pub fn state_string(&self) -> &'static str {
-    self.state.as_str()
+/// Streams a remux copies, as (stream index, time base)
+pub(crate) struct RemuxStreams {
+  video: Option<(i32, AVRational)>,
+  audio: Option<(i32, AVRational)>,
+}
+
+/// Streams a decode feeds, as (stream index, time base)
+pub(crate) struct DecodeStreams {
+  video: Option<(i32, Option<(i32, i32)>)>,
+  audio: Option<(i32, Option<(i32, i32)>)>,
+}
+
+/// Packet read by `decode_next_packet`
+pub(crate) enum DecodePacket {
+  Video(EncodedVideoChunk),
+  Audio(EncodedAudioChunk),
+  /// Packet of a track that isn't decoded
+  Skipped,
+}
+
+/// Feed the remaining packets of the selected tracks to native decoders
+///
+/// Packets go straight to the decoders' worker threads (see
+/// `decode_pipeline`). Blocks until end of stream, the first error or
+/// `close()`. As in `remux_demuxer`, the lock is taken once per packet read
+/// and released before waiting for a decoder to free a queue slot.
+pub(crate) fn decode_demuxer<F: DemuxerFormat>(
+  inner: &Mutex<DemuxerInner<F>>,
+  options: &DecodeToOptions,
+  abort: &PipelineAbort,
+) -> Result<()> {
+  let lock = || {
+    inner
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))
+  };
+  let Some(streams) = lock()?.start_decode(options)? else {
+    return Ok(());
+  };
+
+  // One bound per decoder so a slow video decoder doesn't stall audio
+  let video_queue = PipelineQueue::new(options.max_queue_size, abort);
+  let audio_queue = PipelineQueue::new(options.max_queue_size, abort);
+
+  loop {
+    // The guard is a temporary of this statement, so it is dropped here
+    let packet = lock()?.decode_next_packet(&streams)?;
+    match packet {
+      None => return Ok(()),
+      Some(DecodePacket::Video(chunk)) => {
+        if let Some(input) = options.video.as_ref() {
+          let Some(slot) = video_queue.acquire() else {
+            return Ok(());
+          };
+          input.submit(chunk, slot)?;
+        }
+      }
+      Some(DecodePacket::Audio(chunk)) => {
+        if let Some(input) = options.audio.as_ref() {
+          let Some(slot) = audio_queue.acquire() else {
+            return Ok(());
+          };
+          input.submit(chunk, slot)?;
+        }
+      }
+      Some(DecodePacket::Skipped) => {}
+    }
   }
 }
 
+/// Copy the remaining packets of the selected tracks into a muxer
+///
+/// Blocks until end of stream or the first error. The demuxer lock is taken
+/// once per packet rather than for the whole remux, so `close()` and the
+/// other methods get a turn in between.
+pub(crate) fn remux_demuxer<F: DemuxerFormat>(
+  inner: &Mutex<DemuxerInner<F>>,
+  target: &RemuxTarget,
+) -> Result<()> {
+  let lock = || {
+    inner
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))
+  };
+  let Some(streams) = lock()?.start_remux(target)? else {
+    return Ok(());
+  };
+  while lock()?.remux_next_packet(target, &streams)? {}
+  Ok(())
+}
+
+// ============================================================================
+// Streaming Load
+// ============================================================================
+
+/// Default number of bytes buffered ahead of the demuxer by `loadStream()`
+const DEFAULT_STREAM_BUFFER_SIZE: u32 = 1024 * 1024;
+
+/// Feeder of the stream passed to `loadStream()`
+///
+/// Lives outside the inner lock: a read waiting for stream data holds that
+/// lock while the data can only arrive through the JS thread, so `close()`
+/// aborts the stream before locking and other calls don't wait for the lock
+/// while a stream is attached (see `lock_demuxer_inner`).
+#[derive(Clone, Default)]
+pub struct DemuxerStreamSource(Arc<parking_lot::Mutex<Option<StreamingReadFeeder>>>);
+
+impl DemuxerStreamSource {
+  /// Attach a new feeder; fails if a stream is still attached to the demuxer
+  fn attach(&self, feeder: StreamingReadFeeder) -> bool {
+    let mut current = self.0.lock();
+    if current.as_ref().is_some_and(|f| !f.is_closed()) {
+      return false;
+    }
+    *current = Some(feeder);
+    true
+  }
+
+  /// Whether a stream is attached and the demuxer may still read from it
+  fn is_attached(&self) -> bool {
+    self.0.lock().as_ref().is_some_and(|f| !f.is_closed())
+  }
+
+  /// Abort the attached stream, failing any read that waits for data
+  pub fn abort(&self) {
+    if let Some(feeder) = self.0.lock().take() {
+      feeder.abort();
+    }
+  }
+}
+
+/// Lock the demuxer inner state from the JS thread
+///
+/// While a stream is attached, a read holding the lock may be waiting for
+/// stream data that only the JS thread can push, so waiting here could hang
+/// the event loop. Fail with InvalidStateError instead; the call can be
+/// retried once the pending read, `demuxAsync()`, `decodeTo()` or
+/// `remuxTo()` settles.
+///
+/// File and buffer sources simply wait. Nothing holding the lock on them
+/// waits on the JS thread: `demuxAsync()` and `buildIndex()` only read the
+/// source, and `decodeTo()` and `remuxTo()` lock once per packet, so a
+/// `decodeTo()` waiting for its decoders to catch up doesn't hold the lock.
+pub(crate) fn lock_demuxer_inner<'a, F: DemuxerFormat>(
+  inner: &'a Mutex<DemuxerInner<F>>,
+  source: &DemuxerStreamSource,
+) -> Result<MutexGuard<'a, DemuxerInner<F>>> {
+  let poisoned = || Error::new(Status::GenericFailure, "Lock poisoned");
+  if !source.is_attached() {
+    return inner.lock().map_err(|_| poisoned());
+  }
+  match inner.try_lock() {
+    Ok(guard) => Ok(guard),
+    Err(TryLockError::WouldBlock) => Err(invalid_state_error(
+      "A read from the source stream is in progress",
+    )),
+    Err(TryLockError::Poisoned(_)) => Err(poisoned()),
+  }
+}
+
+/// Load a demuxer from a ReadableStream
+///
+/// The stream is pumped on the async runtime into a bounded buffer while the
+/// headers are parsed on a blocking thread. The returned promise resolves
+/// once the demuxer is ready; pumping carries on as packets are read and
+/// stops when the stream ends or fails, or the demuxer is closed.
+pub(crate) fn load_demuxer_stream<'env, F: DemuxerFormat>(
+  env: &'env Env,
+  inner: Arc<Mutex<DemuxerInner<F>>>,
+  source: &DemuxerStreamSource,
+  stream: ReadableStream<'env, Uint8Array>,
+  options: Option<DemuxerLoadStreamOptions>,
+) -> Result<PromiseRaw<'env, ()>> {
+  let buffer_size = options
+    .and_then(|o| o.buffer_size)
+    .unwrap_or(DEFAULT_STREAM_BUFFER_SIZE);
+  if buffer_size == 0 {
+    env.throw_type_error("bufferSize must be greater than 0", None)?;
+    return Err(Error::new(
+      Status::InvalidArg,
+      "bufferSize must be greater than 0",
+    ));
+  }
+
+  let buffer = StreamingReadBuffer::new(buffer_size as usize);
+  let feeder = buffer.feeder();
+  if !source.attach(feeder.clone()) {
+    return Err(Error::new(
+      Status::GenericFailure,
+      "Demuxer already loaded. Call close() first.",
+    ));
+  }
+
+  let mut reader = stream.read()?;
+  env.spawn_future(async move {
+    while let Some(chunk) = reader.next().await {
+      let chunk = match chunk {
+        Ok(chunk) => chunk.to_vec(),
+        Err(e) => {
+          tracing::warn!(target: "webcodecs", "Demuxer source stream failed: {}", e);
+          feeder.abort();
+          return Ok(());
+        }
+      };
+
+      // A full buffer parks a blocking worker instead of the runtime
+      let feeder = feeder.clone();
+      match spawn_blocking(move || feeder.push_blocking(chunk)).await {
+        Ok(Ok(())) => {}
+        // Demuxer closed or aborted
+        _ => return Ok(()),
+      }
+    }
+    feeder.finish();
+    Ok(())
+  })?;
+
+  env.spawn_future(async move {
+    spawn_blocking(move || {
+      // Open without the inner lock so sync getters don't wait on the network
+      let demuxer = DemuxerContext::open_stream(buffer).map_err(|e| {
+        Error::new(
+          Status::GenericFailure,
+          format!("Failed to open stream: {}", e),
+        )
+      })?;
+      let mut guard = inner
+        .lock()
+        .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+      guard.load_opened_stream(demuxer)
+    })
+    .await
+    .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
+  })
+}
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
@@ -813,6 +1317,49 @@ fn parse_tracks<F: DemuxerFormat>(streams: &[StreamInfo]) -> Vec<DemuxerTrackInf
     .collect()
 }
 
+/// Wrap a demuxed video packet in an EncodedVideoChunk (no copy)
+fn video_chunk_from_packet(
+  packet: Packet,
+  time_base: Option<(i32, i32)>,
+) -> Result<EncodedVideoChunk> {
+  let chunk_type = if packet.is_key() {
+    EncodedVideoChunkType::Key
+  } else {
+    EncodedVideoChunkType::Delta
+  };
+  let init = EncodedVideoChunkInit {
+    chunk_type,
+    timestamp: convert_timestamp(packet.pts(), time_base),
+    duration: (packet.duration() > 0).then(|| convert_timestamp(packet.duration(), time_base)),
+    data: Either::B(packet),
+  };
+  EncodedVideoChunk::new(init).map_err(|e| {
+    Error::new(
+      Status::GenericFailure,
+      format!("Failed to create video chunk: {}", e),
+    )
+  })
+}
+
+/// Wrap a demuxed audio packet in an EncodedAudioChunk (no copy)
+fn audio_chunk_from_packet(
+  packet: Packet,
+  time_base: Option<(i32, i32)>,
+) -> Result<EncodedAudioChunk> {
+  let init = EncodedAudioChunkInit {
+    chunk_type: EncodedAudioChunkType::Key, // Audio packets are typically keyframes
+    timestamp: convert_timestamp(packet.pts(), time_base),
+    duration: (packet.duration() > 0).then(|| convert_timestamp(packet.duration(), time_base)),
+    data: Either::B(packet),
+  };
+  EncodedAudioChunk::new(init).map_err(|e| {
+    Error::new(
+      Status::GenericFailure,
+      format!("Failed to create audio chunk: {}", e),
+    )
+  })
+}
+
 /// Convert timestamp from stream time base to microseconds
 ///
 /// Uses checked arithmetic to prevent overflow for large timestamps.
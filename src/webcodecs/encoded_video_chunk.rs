@@ -4,6 +4,9 @@
 //! See: https://developer.mozilla.org/en-US/docs/Web/API/EncodedVideoChunk
 
 use crate::codec::Packet;
+use crate::codec::bitstream::{
+  AvccNals, annexb_to_avcc_in_place, append_annexb_as_avcc, avcc_to_annexb_in_place,
+};
 use crate::ffi::{AVRational, avutil::av_rescale_q};
 use crate::webcodecs::error::{enforce_range_long_long, enforce_range_long_long_optional};
 use napi::bindgen_prelude::*;
@@ -51,6 +54,41 @@ pub enum LatencyMode {
   Realtime,
 }
 
+/// What a VideoEncoder does when `maxQueueSize` frames are already pending (non-standard)
+#[napi(string_enum)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum EncodeQueueOverflow {
+  /// Skip the oldest pending frames so only the newest `maxQueueSize` are encoded (default)
+  #[default]
+  #[napi(value = "drop-oldest")]
+  DropOldest,
+  /// Refuse new frames unless they request a keyframe
+  #[napi(value = "drop-newest-delta")]
+  DropNewestDelta,
+  /// Refuse new frames with QuotaExceededError; piped decoders wait for room
+  #[napi(value = "throw")]
+  Throw,
+}
+
+/// Which frames a VideoDecoder decodes (non-standard)
+#[napi(string_enum)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum VideoDecodeMode {
+  /// Decode every frame (default)
+  #[default]
+  #[napi(value = "all")]
+  All,
+  /// Skip frames no other frame predicts from (typically B-frames)
+  #[napi(value = "non-reference")]
+  NonReference,
+  /// Decode keyframes only; delta chunks are dropped without being decoded
+  #[napi(value = "keyframes")]
+  Keyframes,
+  /// Decode every frame, trading quality for speed (no deblocking filter)
+  #[napi(value = "fast")]
+  Fast,
+}
+
 /// Bitrate mode for video encoding (W3C WebCodecs spec)
 #[napi(string_enum)]
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
@@ -274,7 +312,7 @@ impl EncodedVideoChunk {
   /// Packet timestamps (pts, dts, duration) are in encoder time_base units and must be
   /// converted to microseconds for the WebCodecs API.
   pub fn from_packet_with_format(
-    packet: Packet,
+    mut packet: Packet,
     explicit_timestamp: Option<i64>,
     use_avcc: bool,
     encoder_time_base: AVRational,
@@ -321,7 +359,9 @@ impl EncodedVideoChunk {
       None
     };
 
-    let data = if use_avcc {
+    // Rewrite the start codes inside the encoder's packet when the framing
+    // allows it, so the chunk stays packet-backed; otherwise convert into a copy
+    let data = if use_avcc && !packet.as_mut_slice().is_ok_and(annexb_to_avcc_in_place) {
       Either::A(convert_annexb_to_avcc(packet.as_slice()))
     } else {
       Either::B(packet)
@@ -521,66 +561,11 @@ impl EncodedVideoChunk {
 /// Annex B uses start codes (0x00000001 or 0x000001) to delimit NAL units.
 /// AVCC/HVCC uses 4-byte big-endian length prefixes instead.
 ///
-/// This function scans for start codes and replaces them with the NAL unit length.
+/// Bytes before the first start code are dropped; data without start codes
+/// is returned as-is.
 fn convert_annexb_to_avcc(data: &[u8]) -> Vec<u8> {
-  if data.is_empty() {
-    return Vec::new();
-  }
-
-  // Find all NAL unit boundaries (positions after start codes)
-  let mut nal_starts: Vec<usize> = Vec::new();
-  let mut i = 0;
-
-  while i < data.len() {
-    // Look for 3-byte or 4-byte start code
-    if i + 3 <= data.len() && data[i] == 0 && data[i + 1] == 0 {
-      if data[i + 2] == 1 {
-        // 3-byte start code: 0x000001
-        nal_starts.push(i + 3);
-        i += 3;
-        continue;
-      } else if i + 4 <= data.len() && data[i + 2] == 0 && data[i + 3] == 1 {
-        // 4-byte start code: 0x00000001
-        nal_starts.push(i + 4);
-        i += 4;
-        continue;
-      }
-    }
-    i += 1;
-  }
-
-  if nal_starts.is_empty() {
-    // No start codes found - might already be in AVCC format or invalid data
-    return data.to_vec();
-  }
-
-  // Build AVCC output
-  let mut result = Vec::with_capacity(data.len());
-
-  for (idx, &start) in nal_starts.iter().enumerate() {
-    // Find the end of this NAL unit (start of next, or end of data)
-    let end = if idx + 1 < nal_starts.len() {
-      // Find where the next start code begins (scan backwards from next NAL start)
-      let next_nal_start = nal_starts[idx + 1];
-      // The start code is either 3 or 4 bytes before next_nal_start
-      if next_nal_start >= 4 && data[next_nal_start - 4] == 0 && data[next_nal_start - 3] == 0 {
-        next_nal_start - 4 // 4-byte start code
-      } else {
-        next_nal_start - 3 // 3-byte start code
-      }
-    } else {
-      data.len()
-    };
-
-    let nal_data = &data[start..end];
-    let nal_len = nal_data.len() as u32;
-
-    // Write 4-byte big-endian length prefix
-    result.extend_from_slice(&nal_len.to_be_bytes());
-    // Write NAL unit data
-    result.extend_from_slice(nal_data);
-  }
-
+  let mut result = Vec::new();
+  append_annexb_as_avcc(data, &mut result);
   result
 }
 
@@ -589,42 +574,13 @@ fn convert_annexb_to_avcc(data: &[u8]) -> Vec<u8> {
 /// AVCC uses 4-byte big-endian length prefixes to delimit NAL units.
 /// Annex B uses start codes (0x00000001) instead.
 ///
-/// This function parses length-prefixed NALUs and converts to start code format.
+/// Both prefixes are 4 bytes, so the copy is rewritten in place; data that
+/// isn't valid AVCC is returned as-is.
 pub fn convert_avcc_to_annexb(data: &[u8]) -> Vec<u8> {
-  if data.len() < 4 {
-    return data.to_vec();
+  let mut result = data.to_vec();
+  if let Some(len) = avcc_to_annexb_in_place(&mut result) {
+    result.truncate(len);
   }
-
-  // Check if this looks like AVCC format by trying to parse it
-  // AVCC format has 4-byte BE length prefixes
-  let mut result = Vec::with_capacity(data.len() + 16); // Some extra for start codes
-  let mut i = 0;
-
-  while i + 4 <= data.len() {
-    // Read 4-byte big-endian length
-    let nal_len = u32::from_be_bytes([data[i], data[i + 1], data[i + 2], data[i + 3]]) as usize;
-
-    // Sanity check: length should be reasonable
-    if nal_len == 0 || nal_len > data.len() - i - 4 {
-      // Not valid AVCC format, might already be Annex B - return as-is
-      return data.to_vec();
-    }
-
-    i += 4; // Skip length prefix
-
-    // Write 4-byte start code
-    result.extend_from_slice(&[0, 0, 0, 1]);
-    // Write NAL unit data
-    result.extend_from_slice(&data[i..i + nal_len]);
-
-    i += nal_len;
-  }
-
-  // If we didn't consume all data or didn't produce any output, return original
-  if result.is_empty() || (i != data.len() && i < 4) {
-    return data.to_vec();
-  }
-
   result
 }
 
@@ -869,31 +825,15 @@ pub fn extract_avcc_from_avcc_packet(data: &[u8]) -> Option<Vec<u8>> {
   }
 
   // Parse AVCC-formatted NAL units (4-byte length prefix)
-  let mut sps_list: Vec<Vec<u8>> = Vec::new();
-  let mut pps_list: Vec<Vec<u8>> = Vec::new();
-  let mut offset = 0;
-
-  while offset + 4 <= data.len() {
-    let nal_length = ((data[offset] as usize) << 24)
-      | ((data[offset + 1] as usize) << 16)
-      | ((data[offset + 2] as usize) << 8)
-      | (data[offset + 3] as usize);
-
-    if nal_length == 0 || offset + 4 + nal_length > data.len() {
-      break;
-    }
+  let mut sps_list: Vec<&[u8]> = Vec::new();
+  let mut pps_list: Vec<&[u8]> = Vec::new();
 
-    let nal_data = &data[offset + 4..offset + 4 + nal_length];
-    if !nal_data.is_empty() {
-      let nal_type = nal_data[0] & 0x1F;
-      match nal_type {
-        7 => sps_list.push(nal_data.to_vec()), // SPS
-        8 => pps_list.push(nal_data.to_vec()), // PPS
-        _ => {}                                // Skip other NAL types (SEI, IDR, etc.)
-      }
+  for nal_data in AvccNals::new(data) {
+    match nal_data[0] & 0x1F {
+      7 => sps_list.push(nal_data), // SPS
+      8 => pps_list.push(nal_data), // PPS
+      _ => {}                       // Skip other NAL types (SEI, IDR, etc.)
     }
-
-    offset += 4 + nal_length;
   }
 
   // Need at least one SPS and one PPS
@@ -959,34 +899,18 @@ pub fn extract_hvcc_from_hvcc_packet(data: &[u8]) -> Option<Vec<u8>> {
   }
 
   // Parse HVCC-formatted NAL units (4-byte length prefix)
-  let mut vps_list: Vec<Vec<u8>> = Vec::new();
-  let mut sps_list: Vec<Vec<u8>> = Vec::new();
-  let mut pps_list: Vec<Vec<u8>> = Vec::new();
-  let mut offset = 0;
-
-  while offset + 4 <= data.len() {
-    let nal_length = ((data[offset] as usize) << 24)
-      | ((data[offset + 1] as usize) << 16)
-      | ((data[offset + 2] as usize) << 8)
-      | (data[offset + 3] as usize);
-
-    if nal_length == 0 || offset + 4 + nal_length > data.len() {
-      break;
-    }
+  let mut vps_list: Vec<&[u8]> = Vec::new();
+  let mut sps_list: Vec<&[u8]> = Vec::new();
+  let mut pps_list: Vec<&[u8]> = Vec::new();
 
-    let nal_data = &data[offset + 4..offset + 4 + nal_length];
-    if !nal_data.is_empty() {
-      // HEVC NAL type is (byte[0] >> 1) & 0x3F
-      let nal_type = (nal_data[0] >> 1) & 0x3F;
-      match nal_type {
-        32 => vps_list.push(nal_data.to_vec()), // VPS
-        33 => sps_list.push(nal_data.to_vec()), // SPS
-        34 => pps_list.push(nal_data.to_vec()), // PPS
-        _ => {}                                 // Skip other NAL types
-      }
+  for nal_data in AvccNals::new(data) {
+    // HEVC NAL type is (byte[0] >> 1) & 0x3F
+    match (nal_data[0] >> 1) & 0x3F {
+      32 => vps_list.push(nal_data), // VPS
+      33 => sps_list.push(nal_data), // SPS
+      34 => pps_list.push(nal_data), // PPS
+      _ => {}                        // Skip other NAL types
     }
-
-    offset += 4 + nal_length;
   }
 
   // Need at least one SPS and one PPS
@@ -1670,7 +1594,7 @@ pub enum AvcBitstreamFormat {
 
 /// AVC (H.264) encoder configuration (W3C WebCodecs AVC Registration)
 #[napi(object)]
-#[derive(Debug, Clone, Default)]
+#[derive(Debug, Clone, Default, PartialEq)]
 pub struct AvcEncoderConfig {
   /// Bitstream format (default: "avc")
   pub format: Option<AvcBitstreamFormat>,
@@ -1691,7 +1615,7 @@ pub enum HevcBitstreamFormat {
 
 /// HEVC (H.265) encoder configuration (W3C WebCodecs HEVC Registration)
 #[napi(object)]
-#[derive(Debug, Clone, Default)]
+#[derive(Debug, Clone, Default, PartialEq)]
 pub struct HevcEncoderConfig {
   /// Bitstream format (default: "hevc")
   pub format: Option<HevcBitstreamFormat>,
@@ -1704,7 +1628,7 @@ pub struct HevcEncoderConfig {
 /// Note: codec, width, and height are Option to support the W3C spec requirement that
 /// isConfigSupported() rejects with TypeError (returns rejected Promise) for missing fields,
 /// rather than throwing synchronously.
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, PartialEq)]
 pub struct VideoEncoderConfig {
   /// Codec string (e.g., "avc1.42001E", "vp8", "vp09.00.10.08", "av01.0.04M.08")
   /// W3C spec: required, but stored as Option for proper error handling
@@ -1739,6 +1663,29 @@ pub struct VideoEncoderConfig {
   pub avc: Option<AvcEncoderConfig>,
   /// HEVC (H.265) codec-specific configuration
   pub hevc: Option<HevcEncoderConfig>,
+  /// Threads used to convert/scale input frames (non-standard; 0 = from the budget)
+  /// Defaults to the process-wide `setScalerThreads()` value
+  pub scaler_threads: Option<u32>,
+  /// Most frames allowed to wait for encoding (non-standard; unbounded when omitted)
+  pub max_queue_size: Option<u32>,
+  /// What to do with frames beyond `max_queue_size` (non-standard)
+  pub queue_overflow: Option<EncodeQueueOverflow>,
+}
+
+impl VideoEncoderConfig {
+  /// Whether moving from `previous` to this config only retargets the bitrate
+  ///
+  /// Queue policy members are applied per frame and don't touch the codec
+  /// context either, so they may change as well.
+  pub(crate) fn is_bitrate_update_of(&self, previous: &Self) -> bool {
+    let context_settings = |config: &Self| Self {
+      bitrate: None,
+      max_queue_size: None,
+      queue_overflow: None,
+      ..config.clone()
+    };
+    context_settings(self) == context_settings(previous)
+  }
 }
 
 impl FromNapiValue for VideoEncoderConfig {
@@ -1764,6 +1711,9 @@ impl FromNapiValue for VideoEncoderConfig {
     let content_hint: Option<String> = obj.get("contentHint")?;
     let avc: Option<AvcEncoderConfig> = obj.get("avc")?;
     let hevc: Option<HevcEncoderConfig> = obj.get("hevc")?;
+    let scaler_threads: Option<u32> = obj.get("scalerThreads")?;
+    let max_queue_size: Option<u32> = obj.get("maxQueueSize")?;
+    let queue_overflow: Option<EncodeQueueOverflow> = obj.get("queueOverflow")?;
 
     Ok(VideoEncoderConfig {
       codec,
@@ -1781,6 +1731,9 @@ impl FromNapiValue for VideoEncoderConfig {
       content_hint,
       avc,
       hevc,
+      scaler_threads,
+      max_queue_size,
+      queue_overflow,
     })
   }
 }
@@ -1814,6 +1767,22 @@ pub struct VideoDecoderConfig {
   pub rotation: Option<f64>,
   /// Horizontal flip per W3C spec
   pub flip: Option<bool>,
+  /// Keep hardware-decoded frames in GPU memory (non-standard)
+  /// Pixels are downloaded only when copyTo() is called; encoders on the same
+  /// device consume the surfaces directly. At most 8 frames are GPU-resident
+  /// at a time, so close them promptly; past that frames are downloaded.
+  pub keep_hardware_frames: Option<bool>,
+  /// Output width to scale decoded frames to (non-standard, paired with desired_height)
+  /// Decoders that support reduced-resolution decoding (e.g. MJPEG) decode
+  /// directly at a smaller size first
+  pub desired_width: Option<u32>,
+  /// Output height to scale decoded frames to (non-standard, paired with desired_width)
+  pub desired_height: Option<u32>,
+  /// Frames to decode (non-standard, default "all")
+  pub decode_mode: Option<VideoDecodeMode>,
+  /// Threads used to scale to desired_width/desired_height (non-standard; 0 = from the budget)
+  /// Defaults to the process-wide `setScalerThreads()` value
+  pub scaler_threads: Option<u32>,
 }
 
 impl FromNapiValue for VideoDecoderConfig {
@@ -1852,6 +1821,11 @@ impl FromNapiValue for VideoDecoderConfig {
     // Rotation and flip for VideoFrame orientation (W3C WebCodecs spec)
     let rotation: Option<f64> = obj.get("rotation")?;
     let flip: Option<bool> = obj.get("flip")?;
+    let keep_hardware_frames: Option<bool> = obj.get("keepHardwareFrames")?;
+    let desired_width: Option<u32> = obj.get("desiredWidth")?;
+    let desired_height: Option<u32> = obj.get("desiredHeight")?;
+    let decode_mode: Option<VideoDecodeMode> = obj.get("decodeMode")?;
+    let scaler_threads: Option<u32> = obj.get("scalerThreads")?;
 
     Ok(VideoDecoderConfig {
       codec,
@@ -1865,6 +1839,11 @@ impl FromNapiValue for VideoDecoderConfig {
       description,
       rotation,
       flip,
+      keep_hardware_frames,
+      desired_width,
+      desired_height,
+      decode_mode,
+      scaler_threads,
     })
   }
 }
@@ -1919,6 +1898,15 @@ impl ToNapiValue for VideoEncoderConfig {
     if let Some(hevc) = val.hevc {
       obj.set("hevc", hevc)?;
     }
+    if let Some(scaler_threads) = val.scaler_threads {
+      obj.set("scalerThreads", scaler_threads)?;
+    }
+    if let Some(max_queue_size) = val.max_queue_size {
+      obj.set("maxQueueSize", max_queue_size)?;
+    }
+    if let Some(queue_overflow) = val.queue_overflow {
+      obj.set("queueOverflow", queue_overflow)?;
+    }
 
     unsafe { Object::to_napi_value(env, obj) }
   }
@@ -1962,6 +1950,21 @@ impl ToNapiValue for VideoDecoderConfig {
     if let Some(flip) = val.flip {
       obj.set("flip", flip)?;
     }
+    if let Some(keep_hardware_frames) = val.keep_hardware_frames {
+      obj.set("keepHardwareFrames", keep_hardware_frames)?;
+    }
+    if let Some(desired_width) = val.desired_width {
+      obj.set("desiredWidth", desired_width)?;
+    }
+    if let Some(desired_height) = val.desired_height {
+      obj.set("desiredHeight", desired_height)?;
+    }
+    if let Some(decode_mode) = val.decode_mode {
+      obj.set("decodeMode", decode_mode)?;
+    }
+    if let Some(scaler_threads) = val.scaler_threads {
+      obj.set("scalerThreads", scaler_threads)?;
+    }
 
     unsafe { Object::to_napi_value(env, obj) }
   }
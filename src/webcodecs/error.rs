@@ -41,6 +41,8 @@ pub enum DOMExceptionName {
   TypeError,
   /// Constraint not satisfied
   ConstraintError,
+  /// A queue or storage limit was reached
+  QuotaExceededError,
 }
 
 impl DOMExceptionName {
@@ -53,6 +55,7 @@ impl DOMExceptionName {
       DOMExceptionName::AbortError => "AbortError",
       DOMExceptionName::TypeError => "TypeError",
       DOMExceptionName::ConstraintError => "ConstraintError",
+      DOMExceptionName::QuotaExceededError => "QuotaExceededError",
     }
   }
 }
@@ -150,6 +153,13 @@ pub fn throw_constraint_error<T>(env: &Env, message: &str) -> Result<T> {
   throw_dom_exception(env, DOMExceptionName::ConstraintError, message)
 }
 
+/// Throw a native QuotaExceededError DOMException
+///
+/// Use when a bounded queue is full and the caller has to wait.
+pub fn throw_quota_exceeded_error<T>(env: &Env, message: &str) -> Result<T> {
+  throw_dom_exception(env, DOMExceptionName::QuotaExceededError, message)
+}
+
 /// Helper to create NotSupportedError for unsupported codecs/configs
 ///
 /// Use when a codec, configuration, or feature is not supported.
@@ -199,6 +209,13 @@ pub fn constraint_error(message: &str) -> Error {
   dom_exception(DOMExceptionName::ConstraintError, message)
 }
 
+/// Helper to create QuotaExceededError for full queues
+///
+/// Use when a bounded queue is full and the caller has to wait.
+pub fn quota_exceeded_error(message: &str) -> Error {
+  dom_exception(DOMExceptionName::QuotaExceededError, message)
+}
+
 /// Convert an Error with DOMException-style message to native DOMException and throw it
 ///
 /// Parses error messages like "EncodingError: Decode failed" and throws the corresponding
@@ -228,6 +245,9 @@ pub fn throw_error_as_dom_exception<T>(env: &Env, error: &Error) -> Result<T> {
   if let Some(rest) = message.strip_prefix("ConstraintError:") {
     return throw_constraint_error(env, rest.trim());
   }
+  if let Some(rest) = message.strip_prefix("QuotaExceededError:") {
+    return throw_quota_exceeded_error(env, rest.trim());
+  }
 
   // Not a DOMException-style message, propagate original error
   Err(Error::new(error.status, &error.reason))
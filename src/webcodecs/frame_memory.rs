@@ -0,0 +1,196 @@
+//! Frame memory budget and pressure events (non-standard)
+//!
+//! Exposes the process-wide frame memory accounting from
+//! `codec::frame_memory` to JavaScript and reports it to V8 as external
+//! memory, so frames that were never closed count towards GC heuristics.
+//!
+//! `napi_adjust_external_memory` is per isolate and needs an `Env`, while
+//! frames are allocated and freed on codec worker threads. Each JS thread
+//! therefore keeps the total it last reported and reconciles it with the
+//! live total whenever it creates or closes a frame or receives decoder
+//! output. Every isolate (main thread and workers) sees the process-wide
+//! total: frames handed between threads are hard to attribute, and a GC
+//! anywhere may be what releases them.
+
+use std::cell::Cell;
+use std::sync::Arc;
+
+use napi::bindgen_prelude::*;
+use napi::threadsafe_function::{ThreadsafeFunction, ThreadsafeFunctionCallMode};
+use napi::{check_status, sys};
+use napi_derive::napi;
+
+use crate::codec::frame_memory::{self, PressureLevel};
+
+/// Smallest change worth reporting to V8
+const REPORT_THRESHOLD: i64 = 1 << 20;
+
+thread_local! {
+  /// Bytes this thread's isolate was last told about
+  static REPORTED_BYTES: Cell<i64> = const { Cell::new(0) };
+}
+
+/// Report the change in live frame memory to this thread's isolate
+pub(crate) fn sync_external_memory(env: &Env) -> Result<()> {
+  let live = frame_memory::live_bytes() as i64;
+  let delta = live - REPORTED_BYTES.get();
+  if delta.abs() < REPORT_THRESHOLD {
+    return Ok(());
+  }
+  let mut adjusted = 0;
+  check_status!(
+    unsafe { sys::napi_adjust_external_memory(env.raw(), delta, &mut adjusted) },
+    "Failed to adjust external memory"
+  )?;
+  REPORTED_BYTES.set(live);
+  Ok(())
+}
+
+/// Frame memory pressure level (non-standard)
+#[napi(string_enum)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum FrameMemoryPressure {
+  /// Below the soft budget
+  #[napi(value = "normal")]
+  Normal,
+  /// Above the soft budget: decoders slow down and caches shrink
+  #[napi(value = "soft")]
+  Soft,
+  /// An allocation was refused by the hard budget
+  #[napi(value = "hard")]
+  Hard,
+}
+
+impl From<PressureLevel> for FrameMemoryPressure {
+  fn from(level: PressureLevel) -> Self {
+    match level {
+      PressureLevel::Normal => Self::Normal,
+      PressureLevel::Soft => Self::Soft,
+      PressureLevel::Hard => Self::Hard,
+    }
+  }
+}
+
+/// Budgets accepted by `setFrameMemoryBudget()` (non-standard)
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct FrameMemoryBudget {
+  /// Bytes above which decoders apply backpressure and a pressure event fires (0 = none)
+  pub soft_limit: Option<f64>,
+  /// Bytes above which frame allocations fail (0 = none)
+  pub hard_limit: Option<f64>,
+}
+
+/// Frame memory usage reported by `getFrameMemoryStats()` (non-standard)
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct FrameMemoryStats {
+  /// Bytes held by live VideoFrame/AudioData buffers and internal frames
+  pub live_bytes: i64,
+  /// Highest `liveBytes` since process start
+  pub peak_bytes: i64,
+  /// Soft budget in bytes (0 = none)
+  pub soft_limit: i64,
+  /// Hard budget in bytes (0 = none)
+  pub hard_limit: i64,
+  /// Allocations refused by the hard budget
+  pub refused_allocations: i64,
+  /// Current pressure level
+  pub pressure: FrameMemoryPressure,
+}
+
+/// Event passed to the `setFrameMemoryPressureListener()` callback (non-standard)
+#[napi(object)]
+#[derive(Debug, Clone)]
+pub struct FrameMemoryPressureEvent {
+  /// New pressure level
+  pub level: FrameMemoryPressure,
+  /// Live frame bytes when the level changed
+  pub live_bytes: i64,
+}
+
+type PressureCallback = ThreadsafeFunction<
+  FrameMemoryPressureEvent,
+  UnknownReturnValue,
+  FrameMemoryPressureEvent,
+  Status,
+  false,
+  true,
+>;
+
+fn validate_limit(limit: Option<f64>, name: &str) -> Result<Option<u64>> {
+  match limit {
+    Some(bytes) if !bytes.is_finite() || bytes < 0.0 => Err(Error::new(
+      Status::InvalidArg,
+      format!("{} must be a non-negative number", name),
+    )),
+    Some(bytes) => Ok(Some(bytes as u64)),
+    None => Ok(None),
+  }
+}
+
+/// Set the process-wide frame memory budgets.
+///
+/// Omitted members keep their current value; 0 removes a budget. Above the
+/// soft budget decoders pause briefly before each chunk until frames are
+/// closed, ImageDecoder keeps only its newest decoded frame, copyTo() stops
+/// caching conversions, and the pressure listener is notified. Cached
+/// conversions count against both budgets. Frame allocations that would
+/// exceed the hard budget fail; decoded frames are always delivered.
+#[napi]
+pub fn set_frame_memory_budget(budget: FrameMemoryBudget) -> Result<()> {
+  let soft = validate_limit(budget.soft_limit, "softLimit")?;
+  let hard = validate_limit(budget.hard_limit, "hardLimit")?;
+  let current = frame_memory::stats();
+  frame_memory::set_budget(
+    soft.unwrap_or(current.soft_limit),
+    hard.unwrap_or(current.hard_limit),
+  );
+  Ok(())
+}
+
+/// Get live and peak frame memory, the budgets and the current pressure level.
+#[napi]
+pub fn get_frame_memory_stats(env: Env) -> Result<FrameMemoryStats> {
+  sync_external_memory(&env)?;
+  let stats = frame_memory::stats();
+  Ok(FrameMemoryStats {
+    live_bytes: stats.live_bytes as i64,
+    peak_bytes: stats.peak_bytes as i64,
+    soft_limit: stats.soft_limit as i64,
+    hard_limit: stats.hard_limit as i64,
+    refused_allocations: stats.refused as i64,
+    pressure: frame_memory::pressure_level().into(),
+  })
+}
+
+/// Call `callback` whenever the frame memory pressure level changes.
+///
+/// It fires when live frame memory crosses the soft budget, when an
+/// allocation is refused by the hard budget, and when memory is back under
+/// the soft budget. Pass null to remove it. The listener doesn't keep the
+/// process alive.
+#[napi]
+pub fn set_frame_memory_pressure_listener(
+  callback: Option<Function<FrameMemoryPressureEvent, UnknownReturnValue>>,
+) -> Result<()> {
+  let Some(callback) = callback else {
+    frame_memory::set_pressure_listener(None);
+    return Ok(());
+  };
+  let tsfn: PressureCallback = callback
+    .build_threadsafe_function()
+    .callee_handled::<false>()
+    .weak::<true>() // Weak to allow Node.js process to exit
+    .build()?;
+  frame_memory::set_pressure_listener(Some(Arc::new(move |level, live_bytes| {
+    tsfn.call(
+      FrameMemoryPressureEvent {
+        level: level.into(),
+        live_bytes: live_bytes as i64,
+      },
+      ThreadsafeFunctionCallMode::NonBlocking,
+    );
+  })));
+  Ok(())
+}
@@ -2,8 +2,9 @@
 //!
 //! Provides JavaScript-accessible functions for querying hardware acceleration support.
 
-use crate::codec::HwDeviceContext;
-use crate::ffi::AVHWDeviceType;
+use crate::codec::{HwDeviceContext, probe};
+use crate::ffi::{AVCodecID, AVHWDeviceType};
+use napi::bindgen_prelude::*;
 use napi_derive::napi;
 
 /// Hardware accelerator information
@@ -67,10 +68,9 @@ pub fn get_available_hardware_accelerators() -> Vec<String> {
     .collect()
 }
 
-/// Check if a specific hardware accelerator is available
-#[napi]
-pub fn is_hardware_accelerator_available(name: String) -> bool {
-  let hw_type = match name.as_str() {
+/// Map an accelerator name to its device type
+fn hw_type_from_name(name: &str) -> Option<AVHWDeviceType> {
+  match name {
     "videotoolbox" => Some(AVHWDeviceType::Videotoolbox),
     "cuda" | "nvenc" => Some(AVHWDeviceType::Cuda),
     "vaapi" => Some(AVHWDeviceType::Vaapi),
@@ -80,9 +80,77 @@ pub fn is_hardware_accelerator_available(name: String) -> bool {
     "vdpau" => Some(AVHWDeviceType::Vdpau),
     "vulkan" => Some(AVHWDeviceType::Vulkan),
     _ => None,
-  };
+  }
+}
+
+/// Check if a specific hardware accelerator is available
+#[napi]
+pub fn is_hardware_accelerator_available(name: String) -> bool {
+  hw_type_from_name(&name)
+    .map(HwDeviceContext::is_available)
+    .unwrap_or(false)
+}
+
+/// Background task behind `warmUpHardware()`
+pub struct WarmUpHardware {
+  /// None = the preferred accelerator
+  accelerators: Option<Vec<String>>,
+}
 
-  hw_type.map(HwDeviceContext::is_available).unwrap_or(false)
+impl Task for WarmUpHardware {
+  type Output = Vec<String>;
+  type JsValue = Vec<String>;
+
+  fn compute(&mut self) -> Result<Self::Output> {
+    for codec_id in [
+      AVCodecID::H264,
+      AVCodecID::Hevc,
+      AVCodecID::Vp8,
+      AVCodecID::Vp9,
+      AVCodecID::Av1,
+      AVCodecID::Opus,
+      AVCodecID::Aac,
+    ] {
+      probe::decoder_available(codec_id);
+      probe::encoder_available(codec_id);
+    }
+
+    Ok(
+      self
+        .accelerators
+        .take()
+        .unwrap_or_else(|| get_preferred_hardware_accelerator().into_iter().collect())
+        .into_iter()
+        .filter(|name| {
+          hw_type_from_name(name).is_some_and(|hw| HwDeviceContext::shared(hw).is_ok())
+        })
+        .collect(),
+    )
+  }
+
+  fn resolve(&mut self, _env: Env, output: Self::Output) -> Result<Self::JsValue> {
+    Ok(output)
+  }
+}
+
+/// Open hardware devices and probe codec support ahead of the first configure() (non-standard)
+///
+/// Creates the shared device for each named accelerator (default: the
+/// preferred one) and caches `isConfigSupported()` answers for the common
+/// codecs, so later configure() calls skip driver initialization. Driver
+/// initialization runs on a background thread. Resolves with the
+/// accelerators whose device is ready.
+#[napi]
+pub fn warm_up_hardware(accelerators: Option<Vec<String>>) -> AsyncTask<WarmUpHardware> {
+  AsyncTask::new(WarmUpHardware { accelerators })
+}
+
+/// Release cached hardware devices that no codec is using (non-standard)
+///
+/// Returns the number of devices released. They are reopened on demand.
+#[napi]
+pub fn release_unused_hardware_devices() -> u32 {
+  HwDeviceContext::release_unused_shared() as u32
 }
 
 /// Get the preferred hardware accelerator for the current platform
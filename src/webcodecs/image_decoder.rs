@@ -3,15 +3,22 @@
 //! Provides image decoding functionality using FFmpeg.
 //! See: <https://developer.mozilla.org/en-US/docs/Web/API/ImageDecoder>
 
-use crate::codec::{CodecContext, DecoderConfig, Frame, Packet, ScaleAlgorithm, Scaler};
-use crate::ffi::AVCodecID;
+use crate::codec::demuxer::DemuxerContext;
+use crate::codec::io_buffer::BufferSource;
+use crate::codec::{
+  CodecContext, DecoderConfig, Frame, Packet, ScaleAlgorithm, Scaler, frame_memory,
+};
+use crate::ffi::avutil::image_buffer_size;
+use crate::ffi::{AV_NOPTS_VALUE, AVCodecID};
 use crate::webcodecs::VideoFrame;
+use crate::webcodecs::demuxer_base::convert_timestamp;
 use crate::webcodecs::error::{invalid_state_error, throw_invalid_state_error};
 use futures::stream::{StreamExt, TryStreamExt};
 use napi::bindgen_prelude::*;
 use napi::tokio::sync::Notify;
 use napi_derive::napi;
 use parking_lot::RwLock as ParkingLotRwLock;
+use std::collections::{HashMap, VecDeque};
 use std::sync::{
   Arc, Mutex,
   atomic::{AtomicBool, Ordering},
@@ -20,6 +27,12 @@ use std::sync::{
 const COMPLETED_PROMISE: &str = "[[completed]]";
 const READY_PROMISE: &str = "[[ready]]";
 
+/// Default byte budget for decoded frames kept by an ImageDecoder
+const DEFAULT_FRAME_CACHE_BYTES: usize = 64 * 1024 * 1024;
+
+/// Frames decoded ahead in the background after each `decode()` call
+const PREFETCH_FRAMES: usize = 2;
+
 /// ColorSpaceConversion for ImageDecoder (W3C WebCodecs spec)
 #[napi(string_enum)]
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
@@ -43,6 +56,17 @@ pub enum ImageDecoderData {
   Empty,
 }
 
+impl ImageDecoderData {
+  /// Get the encoded bytes
+  fn as_slice(&self) -> &[u8] {
+    match self {
+      ImageDecoderData::Buffer(buf) => buf.as_ref(),
+      ImageDecoderData::Vec(vec) => vec,
+      ImageDecoderData::Empty => &[],
+    }
+  }
+}
+
 /// ImageDecoder init options
 /// Per W3C spec, `data` can be either a BufferSource or a ReadableStream
 pub struct ImageDecoderInit<'env> {
@@ -58,6 +82,8 @@ pub struct ImageDecoderInit<'env> {
   pub desired_height: Option<u32>,
   /// Whether to prefer animation (for animated formats)
   pub prefer_animation: Option<bool>,
+  /// Byte budget for cached decoded frames (non-standard)
+  pub frame_cache_bytes: Option<f64>,
 }
 
 impl<'env> FromNapiValue for ImageDecoderInit<'env> {
@@ -106,6 +132,17 @@ impl<'env> FromNapiValue for ImageDecoderInit<'env> {
     let desired_width: Option<u32> = obj.get("desiredWidth").ok().flatten();
     let desired_height: Option<u32> = obj.get("desiredHeight").ok().flatten();
     let prefer_animation: Option<bool> = obj.get("preferAnimation").ok().flatten();
+    let frame_cache_bytes: Option<f64> = obj.get("frameCacheBytes").ok().flatten();
+
+    if let Some(bytes) = frame_cache_bytes
+      && !(bytes.is_finite() && bytes >= 0.0)
+    {
+      env_wrapper.throw_type_error("frameCacheBytes must be a non-negative number", None)?;
+      return Err(Error::new(
+        Status::InvalidArg,
+        "frameCacheBytes must be a non-negative number",
+      ));
+    }
 
     // W3C spec validation: desiredWidth and desiredHeight must both exist or both be omitted
     if desired_width.is_some() != desired_height.is_some() {
@@ -140,6 +177,7 @@ impl<'env> FromNapiValue for ImageDecoderInit<'env> {
       desired_width,
       desired_height,
       prefer_animation,
+      frame_cache_bytes,
     })
   }
 }
@@ -399,17 +437,16 @@ struct ImageDecoderInner {
   mime_type: String,
   /// Codec ID for decoding (None if MIME type is unsupported)
   codec_id: Option<AVCodecID>,
-  /// Decoder context (created on first decode)
-  context: Option<CodecContext>,
+  /// Encoded frames and decoded frame cache (set up once metadata is parsed)
+  frames: Option<FrameStore>,
+  /// Byte budget for the decoded frame cache
+  frame_cache_bytes: usize,
   /// Whether data is fully buffered (true for Buffer, becomes true for Stream when finished)
   complete: Arc<AtomicBool>,
   /// Track list
   tracks: ImageTrackList,
   /// Whether decoder is closed
   closed: bool,
-  /// Cached decoded frames (for animated images, populated on first decode)
-  /// Cached decoded frames wrapped in Arc for efficient sharing
-  cached_frames: Option<Vec<Arc<ParkingLotRwLock<Frame>>>>,
   /// Color space conversion mode (W3C spec)
   color_space_conversion: ColorSpaceConversion,
   /// Desired width for scaling (W3C spec - must be paired with desired_height)
@@ -479,11 +516,14 @@ impl ImageDecoder {
       data: ImageDecoderData::Empty,
       mime_type: init.mime_type.clone(),
       codec_id,
-      context: None,
+      frames: None,
+      frame_cache_bytes: init
+        .frame_cache_bytes
+        .map(|bytes| bytes as usize)
+        .unwrap_or(DEFAULT_FRAME_CACHE_BYTES),
       complete: complete.clone(),
       tracks: tracks.clone(),
       closed: false,
-      cached_frames: None,
       color_space_conversion: init.color_space_conversion,
       desired_width: init.desired_width,
       desired_height: init.desired_height,
@@ -506,7 +546,7 @@ impl ImageDecoder {
       // Spawn pre-parse task for ready promise
       let inner_clone = inner.clone();
       let ready_promise = env.spawn_future(async move {
-        let result = spawn_blocking(move || pre_parse_and_cache_frames(&inner_clone)).await;
+        let result = spawn_blocking(move || pre_parse_frames(&inner_clone)).await;
 
         match result {
           Ok(Ok(())) | Ok(Err(_)) | Err(_) => {
@@ -550,11 +590,11 @@ impl ImageDecoder {
             }
 
             // Pre-parse metadata and cache frames
-            let result = spawn_blocking(move || pre_parse_and_cache_frames(&inner_clone)).await;
+            let result = spawn_blocking(move || pre_parse_frames(&inner_clone)).await;
 
             match result {
               Ok(Ok(())) | Ok(Err(_)) | Err(_) => {
-                // Always signal ready (done in pre_parse_and_cache_frames)
+                // Always signal ready (done in pre_parse_frames)
               }
             }
           }
@@ -652,6 +692,7 @@ impl ImageDecoder {
     };
 
     let inner = self.inner.clone();
+    let frame_index = options.as_ref().and_then(|o| o.frame_index).unwrap_or(0) as usize;
 
     // Spawn async task that first waits for ready, then decodes
     env.spawn_future(async move {
@@ -669,7 +710,8 @@ impl ImageDecoder {
       ready_promise.await?;
 
       // Now do the actual decode in a blocking task
-      spawn_blocking(move || {
+      let prefetch_inner = inner.clone();
+      let result = spawn_blocking(move || {
         let mut inner = inner
           .lock()
           .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
@@ -678,156 +720,59 @@ impl ImageDecoder {
           return Err(invalid_state_error("ImageDecoder is closed"));
         }
 
-        let frame_index = options.as_ref().and_then(|o| o.frame_index).unwrap_or(0) as usize;
-
-        // If frames were cleared (e.g., by reset), re-decode them
-        if inner.cached_frames.is_none() {
-          // Get the data bytes
-          let data_bytes: Vec<u8> = match &inner.data {
-            ImageDecoderData::Buffer(buf) => buf.as_ref().to_vec(),
-            ImageDecoderData::Vec(vec) => vec.clone(),
-            ImageDecoderData::Empty => {
-              return Err(Error::new(Status::GenericFailure, "No data available"));
-            }
-          };
-
-          // Check if codec_id is valid (invalid MIME type at construction is deferred to here)
-          let codec_id = match inner.codec_id {
-            Some(id) => id,
-            None => {
-              return Err(Error::new(
-                Status::GenericFailure,
-                format!("Unsupported image type: {}", inner.mime_type),
-              ));
-            }
-          };
-
-          // Create decoder context if needed
-          if inner.context.is_none() {
-            let mut context = CodecContext::new_decoder(codec_id).map_err(|e| {
-              Error::new(
-                Status::GenericFailure,
-                format!("Failed to create decoder: {}", e),
-              )
-            })?;
-
-            let decoder_config = DecoderConfig {
-              codec_id,
-              thread_count: 0,
-              extradata: None,
-              low_latency: false,
-              width: None,
-              height: None,
-            };
-
-            context.configure_decoder(&decoder_config).map_err(|e| {
-              Error::new(
-                Status::GenericFailure,
-                format!("Failed to configure decoder: {}", e),
-              )
-            })?;
-
-            context.open().map_err(|e| {
-              Error::new(
-                Status::GenericFailure,
-                format!("Failed to open decoder: {}", e),
-              )
-            })?;
-
-            inner.context = Some(context);
-          }
-
-          // Decode all frames
-          let context = inner.context.as_mut().unwrap();
-          let mut frames = decode_image_data(context, &data_bytes)?;
-
-          // Apply preferAnimation: if false and format supports animation, only keep first frame
-          if inner.prefer_animation == Some(false) && !frames.is_empty() {
-            frames.truncate(1);
-            // Mark track as non-animated since user explicitly prefers static
-            if let Ok(mut track_inner) = inner.tracks.inner.lock()
-              && let Some(track) = track_inner.tracks.get_mut(0)
-            {
-              track.animated = false;
-            }
-          }
-
-          // Apply desiredWidth/desiredHeight scaling if both are specified
-          let frames = if let (Some(dw), Some(dh)) = (inner.desired_width, inner.desired_height) {
-            let mut scaled_frames = Vec::with_capacity(frames.len());
-            for frame in frames {
-              let scaler = Scaler::new(
-                frame.width(),
-                frame.height(),
-                frame.format(),
-                dw,
-                dh,
-                frame.format(),
-                ScaleAlgorithm::Lanczos,
-              )
-              .map_err(|e| {
-                Error::new(
-                  Status::GenericFailure,
-                  format!("Failed to create scaler: {}", e),
-                )
-              })?;
-
-              let scaled = scaler.scale_alloc(&frame).map_err(|e| {
-                Error::new(
-                  Status::GenericFailure,
-                  format!("Failed to scale frame: {}", e),
-                )
-              })?;
-              scaled_frames.push(scaled);
-            }
-            scaled_frames
-          } else {
-            frames
-          };
-
-          // Update frame_count
-          if !frames.is_empty()
-            && let Ok(mut track_inner) = inner.tracks.inner.lock()
-            && let Some(track) = track_inner.tracks.get_mut(0)
-          {
-            track.frame_count = frames.len() as u32;
-          }
+        // Borrow fields separately rather than through the guard
+        let inner = &mut *inner;
+        let Some(frames) = inner.frames.as_mut() else {
+          // Metadata parsing bailed out (invalid MIME type is deferred to here)
+          return Err(match inner.codec_id {
+            Some(_) => Error::new(Status::GenericFailure, "No data available"),
+            None => Error::new(
+              Status::GenericFailure,
+              format!("Unsupported image type: {}", inner.mime_type),
+            ),
+          });
+        };
 
-          // Wrap frames in Arc for efficient sharing from cache
-          let shared_frames: Vec<Arc<ParkingLotRwLock<Frame>>> =
-            frames.into_iter().map(|f| f.into_shared()).collect();
-          inner.cached_frames = Some(shared_frames);
+        if frame_index >= frames.frame_count() && frames.frame_count() > 0 {
+          return Err(Error::new(
+            Status::InvalidArg,
+            format!(
+              "RangeError: Frame index {} out of bounds (image has {} frames)",
+              frame_index,
+              frames.frame_count()
+            ),
+          ));
         }
 
-        // Get reference to cached frames
-        let frames = inner.cached_frames.as_ref().ok_or_else(|| {
-          Error::new(
-            Status::GenericFailure,
-            "No frames available - decoding may have failed",
-          )
-        })?;
+        let decoded = frames.frame(frame_index)?;
+        let frame_count = frames.frame_count();
 
-        // Validate frame_index
-        if frames.is_empty() {
-          return Err(Error::new(
-            Status::GenericFailure,
-            "No frames decoded from image",
-          ));
+        // Repopulate frame_count after reset(), or correct it if the decoder
+        // produced fewer frames than the container listed
+        if frame_count > 0
+          && let Ok(mut track_inner) = inner.tracks.inner.lock()
+          && let Some(track) = track_inner.tracks.get_mut(0)
+        {
+          track.frame_count = frame_count as u32;
         }
 
-        if frame_index >= frames.len() {
+        let Some(frame_arc) = decoded else {
+          if frame_count == 0 {
+            return Err(Error::new(
+              Status::GenericFailure,
+              "No frames decoded from image",
+            ));
+          }
           return Err(Error::new(
             Status::InvalidArg,
             format!(
               "RangeError: Frame index {} out of bounds (image has {} frames)",
-              frame_index,
-              frames.len()
+              frame_index, frame_count
             ),
           ));
-        }
+        };
 
-        // Clone the Arc to share the frame data (no pixel copy needed)
-        let frame_arc = frames[frame_index].clone();
+        // The Arc shares the frame data (no pixel copy needed)
         let pts = frame_arc.read().pts();
 
         // Per Chromium behavior: "default" extracts color space, "none" ignores it
@@ -846,7 +791,12 @@ impl ImageDecoder {
           Status::GenericFailure,
           format!("Decode task failed: {}", join_error),
         )
-      })?
+      })??;
+
+      // Decode the next frames while the caller handles this one
+      spawn_blocking(move || prefetch_frames(&prefetch_inner, frame_index));
+
+      Ok(result)
     })
   }
 
@@ -863,8 +813,10 @@ impl ImageDecoder {
       return throw_invalid_state_error(&env, "ImageDecoder is closed");
     }
 
-    inner.context = None;
-    inner.cached_frames = None;
+    // Keep the parsed frames, drop decoded pixels and decoder state
+    if let Some(frames) = inner.frames.as_mut() {
+      frames.reset();
+    }
 
     // Reset frame_count for animated formats (will be re-detected on next decode)
     if let Ok(mut track_inner) = inner.tracks.inner.lock()
@@ -885,8 +837,8 @@ impl ImageDecoder {
       .lock()
       .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
 
-    inner.context = None;
-    inner.cached_frames = None;
+    inner.frames = None;
+    inner.data = ImageDecoderData::Empty;
     inner.closed = true;
 
     // Wake any waiters so they can check closed state
@@ -912,155 +864,123 @@ impl ImageDecoder {
   }
 }
 
-/// Pre-parse image and cache decoded frames
-fn pre_parse_and_cache_frames(inner: &Arc<Mutex<ImageDecoderInner>>) -> Result<()> {
+/// Parse frame metadata and signal ready
+///
+/// Only the container is parsed here: the encoded bytes of each frame are
+/// collected so `decode()` can decode frames on demand.
+fn pre_parse_frames(inner: &Arc<Mutex<ImageDecoderInner>>) -> Result<()> {
   let mut inner_guard = inner
     .lock()
     .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
 
-  // Check if already closed
-  if inner_guard.closed {
-    inner_guard.tracks.ready.store(true, Ordering::Release);
-    inner_guard.tracks.ready_notify.notify_waiters();
-    return Err(invalid_state_error("ImageDecoder is closed"));
-  }
+  let result = parse_frames(&mut inner_guard);
 
-  // Get the data bytes
-  let data_bytes: Vec<u8> = match &inner_guard.data {
-    ImageDecoderData::Buffer(buf) => buf.as_ref().to_vec(),
-    ImageDecoderData::Vec(vec) => vec.clone(),
-    ImageDecoderData::Empty => {
-      inner_guard.tracks.ready.store(true, Ordering::Release);
-      inner_guard.tracks.ready_notify.notify_waiters();
-      return Err(Error::new(Status::GenericFailure, "No data available"));
+  // Always signal ready, even on error (per W3C spec behavior)
+  inner_guard.tracks.ready.store(true, Ordering::Release);
+  inner_guard.tracks.ready_notify.notify_waiters();
+
+  result
+}
+
+/// Decode the frames following `frame_index` ahead of time
+///
+/// The lock is taken once per frame, so `decode()`, `reset()` and `close()`
+/// wait for at most one frame. Stops if a `decode()` call holds the decoder;
+/// that call decodes in order anyway.
+fn prefetch_frames(inner: &Arc<Mutex<ImageDecoderInner>>, frame_index: usize) {
+  for next in frame_index + 1..=frame_index + PREFETCH_FRAMES {
+    let Ok(mut inner) = inner.try_lock() else {
+      return;
+    };
+    if inner.closed {
+      return;
     }
-  };
+    let Some(frames) = inner.frames.as_mut() else {
+      return;
+    };
+    match frames.prefetch(next) {
+      Ok(true) => {}
+      Ok(false) => return,
+      Err(e) => {
+        tracing::debug!(target: "webcodecs", "ImageDecoder prefetch failed: {}", e);
+        return;
+      }
+    }
+  }
+}
+
+/// Split the encoded data into frames and set up the frame store
+fn parse_frames(inner: &mut ImageDecoderInner) -> Result<()> {
+  if inner.closed {
+    return Err(invalid_state_error("ImageDecoder is closed"));
+  }
 
-  // Check if codec_id is valid (invalid MIME type at construction is deferred to here)
-  let codec_id = match inner_guard.codec_id {
+  // Check if codec_id is valid (invalid MIME type at construction is deferred to decode)
+  let codec_id = match inner.codec_id {
     Some(id) => id,
     None => {
-      inner_guard.tracks.ready.store(true, Ordering::Release);
-      inner_guard.tracks.ready_notify.notify_waiters();
       return Err(Error::new(
         Status::GenericFailure,
-        format!("Unsupported image type: {}", inner_guard.mime_type),
+        format!("Unsupported image type: {}", inner.mime_type),
       ));
     }
   };
 
-  // Create decoder context
-  let mut context = CodecContext::new_decoder(codec_id).map_err(|e| {
-    inner_guard.tracks.ready.store(true, Ordering::Release);
-    inner_guard.tracks.ready_notify.notify_waiters();
-    Error::new(
-      Status::GenericFailure,
-      format!("Failed to create decoder: {}", e),
-    )
-  })?;
-
-  let decoder_config = DecoderConfig {
-    codec_id,
-    thread_count: 0,
-    extradata: None,
-    low_latency: false,
-    width: None,
-    height: None,
-  };
-
-  context.configure_decoder(&decoder_config).map_err(|e| {
-    inner_guard.tracks.ready.store(true, Ordering::Release);
-    inner_guard.tracks.ready_notify.notify_waiters();
-    Error::new(
-      Status::GenericFailure,
-      format!("Failed to configure decoder: {}", e),
-    )
-  })?;
-
-  context.open().map_err(|e| {
-    inner_guard.tracks.ready.store(true, Ordering::Release);
-    inner_guard.tracks.ready_notify.notify_waiters();
-    Error::new(
-      Status::GenericFailure,
-      format!("Failed to open decoder: {}", e),
-    )
-  })?;
-
-  // Decode all frames
-  let mut frames = decode_image_data(&mut context, &data_bytes).inspect_err(|_e| {
-    inner_guard.tracks.ready.store(true, Ordering::Release);
-    inner_guard.tracks.ready_notify.notify_waiters();
-  })?;
-
-  // Apply preferAnimation: if false and format supports animation, only keep first frame
-  let prefer_animation = inner_guard.prefer_animation;
-  if prefer_animation == Some(false) && !frames.is_empty() {
-    frames.truncate(1);
-    // Mark track as non-animated since user explicitly prefers static
-    if let Ok(mut track_inner) = inner_guard.tracks.inner.lock()
-      && let Some(track) = track_inner.tracks.get_mut(0)
-    {
-      track.animated = false;
-    }
+  let data = Arc::new(std::mem::replace(&mut inner.data, ImageDecoderData::Empty));
+  if matches!(*data, ImageDecoderData::Empty) {
+    return Err(Error::new(Status::GenericFailure, "No data available"));
   }
 
-  // Apply desiredWidth/desiredHeight scaling if both are specified
-  let desired_width = inner_guard.desired_width;
-  let desired_height = inner_guard.desired_height;
-  let frames = if let (Some(dw), Some(dh)) = (desired_width, desired_height) {
-    let mut scaled_frames = Vec::with_capacity(frames.len());
-    for frame in frames {
-      // Create scaler for this frame's dimensions and format
-      let scaler = Scaler::new(
-        frame.width(),
-        frame.height(),
-        frame.format(),
-        dw,
-        dh,
-        frame.format(),
-        ScaleAlgorithm::Lanczos, // High quality for images
-      )
-      .map_err(|e| {
-        inner_guard.tracks.ready.store(true, Ordering::Release);
-        inner_guard.tracks.ready_notify.notify_waiters();
-        Error::new(
-          Status::GenericFailure,
-          format!("Failed to create scaler: {}", e),
-        )
-      })?;
+  let ImageFrames {
+    mut packets,
+    extradata,
+    coded_size,
+  } = split_image_frames(&data)?;
 
-      let scaled = scaler.scale_alloc(&frame).map_err(|e| {
-        inner_guard.tracks.ready.store(true, Ordering::Release);
-        inner_guard.tracks.ready_notify.notify_waiters();
-        Error::new(
-          Status::GenericFailure,
-          format!("Failed to scale frame: {}", e),
-        )
-      })?;
-      scaled_frames.push(scaled);
-    }
-    scaled_frames
-  } else {
-    frames
-  };
+  // Stream data is owned by the packets now; JS buffers stay referenced
+  if let Ok(ImageDecoderData::Buffer(buf)) = Arc::try_unwrap(data) {
+    inner.data = ImageDecoderData::Buffer(buf);
+  }
 
-  // Update frame_count in track info
-  if !frames.is_empty()
-    && let Ok(mut track_inner) = inner_guard.tracks.inner.lock()
+  if let Ok(mut track_inner) = inner.tracks.inner.lock()
     && let Some(track) = track_inner.tracks.get_mut(0)
   {
-    track.frame_count = frames.len() as u32;
+    // Apply preferAnimation: if false and format supports animation, only keep first frame
+    if inner.prefer_animation == Some(false) {
+      // Mark track as non-animated since user explicitly prefers static
+      track.animated = false;
+    }
+    if !track.animated {
+      packets.truncate(1);
+    }
+    if !packets.is_empty() {
+      track.frame_count = packets.len() as u32;
+    }
   }
 
-  // Wrap frames in Arc for efficient sharing from cache
-  let shared_frames: Vec<Arc<ParkingLotRwLock<Frame>>> =
-    frames.into_iter().map(|f| f.into_shared()).collect();
-  inner_guard.cached_frames = Some(shared_frames);
-  inner_guard.context = Some(context);
+  // Let the decoder produce a reduced-size image where it can (JPEG DCT
+  // downscaling), so the scaler only has to cover what's left
+  let target_size = inner.desired_width.zip(inner.desired_height);
+  let lowres = target_size
+    .zip(coded_size)
+    .map(|(target, coded)| DecoderConfig::lowres_for_size(coded, target))
+    .unwrap_or(0);
 
-  // Signal ready
-  inner_guard.tracks.ready.store(true, Ordering::Release);
-  inner_guard.tracks.ready_notify.notify_waiters();
+  inner.frames = Some(FrameStore::new(
+    DecoderConfig {
+      codec_id,
+      thread_count: 0,
+      extradata,
+      low_latency: false,
+      width: None,
+      height: None,
+      lowres,
+      ..Default::default()
+    },
+    packets,
+    target_size,
+    inner.frame_cache_bytes,
+  ));
 
   Ok(())
 }
@@ -1095,9 +1015,62 @@ fn parse_mime_type(mime_type: &str) -> Result<AVCodecID> {
   ))
 }
 
-/// Decode image data using FFmpeg
-fn decode_image_data(context: &mut CodecContext, data: &[u8]) -> Result<Vec<crate::codec::Frame>> {
-  // Create a packet with the image data
+/// Encoded image bytes shared with the demuxer without copying them
+struct SharedImageData(Arc<ImageDecoderData>);
+
+impl BufferSource for SharedImageData {
+  fn buffer_data(&self) -> (*const u8, usize) {
+    match self.0.as_ref() {
+      ImageDecoderData::Buffer(buf) => buf.buffer_data(),
+      ImageDecoderData::Vec(vec) => vec.buffer_data(),
+      ImageDecoderData::Empty => (std::ptr::null(), 0),
+    }
+  }
+}
+
+/// Encoded frames of an image and the stream parameters to decode them with
+struct ImageFrames {
+  packets: Vec<Packet>,
+  extradata: Option<Vec<u8>>,
+  /// Full-resolution size, when the container reports it
+  coded_size: Option<(u32, u32)>,
+}
+
+/// Split image data into one packet per frame
+///
+/// Animated formats (GIF, APNG, AVIF sequences) are demuxed so each frame can
+/// be decoded on its own. Inputs the demuxer can't handle are decoded as a
+/// single packet holding all the data.
+fn split_image_frames(data: &Arc<ImageDecoderData>) -> Result<ImageFrames> {
+  let demuxed = DemuxerContext::open_buffer(SharedImageData(data.clone()))
+    .ok()
+    .and_then(|mut demuxer| {
+      let stream = demuxer.video_stream()?.clone();
+      let mut packets = Vec::new();
+      while let Ok(Some((mut packet, stream_index))) = demuxer.read_packet() {
+        if stream_index != stream.index {
+          continue;
+        }
+        // Frame timestamps end up in VideoFrame.timestamp (microseconds)
+        if packet.pts() != AV_NOPTS_VALUE {
+          packet.set_pts(convert_timestamp(packet.pts(), Some(stream.time_base)));
+        }
+        if packet.dts() != AV_NOPTS_VALUE {
+          packet.set_dts(convert_timestamp(packet.dts(), Some(stream.time_base)));
+        }
+        packets.push(packet);
+      }
+      (!packets.is_empty()).then(|| ImageFrames {
+        packets,
+        coded_size: stream.width.zip(stream.height),
+        extradata: stream.extradata,
+      })
+    });
+
+  if let Some(demuxed) = demuxed {
+    return Ok(demuxed);
+  }
+
   let mut packet = Packet::new().map_err(|e| {
     Error::new(
       Status::GenericFailure,
@@ -1106,23 +1079,280 @@ fn decode_image_data(context: &mut CodecContext, data: &[u8]) -> Result<Vec<crat
   })?;
 
   // Allocate and copy data to packet using safe wrapper
-  packet.copy_data_from(data).map_err(|e| {
+  packet.copy_data_from(data.as_slice()).map_err(|e| {
     Error::new(
       Status::GenericFailure,
       format!("Failed to copy packet data: {}", e),
     )
   })?;
 
-  // Decode
-  let frames = context
-    .decode(Some(&packet))
-    .map_err(|e| Error::new(Status::GenericFailure, format!("Decode failed: {}", e)))?;
+  Ok(ImageFrames {
+    packets: vec![packet],
+    extradata: None,
+    coded_size: None,
+  })
+}
+
+/// Decoded frames kept within a byte budget, least recently used evicted first
+struct FrameCache {
+  budget: usize,
+  bytes: usize,
+  frames: HashMap<usize, (Arc<ParkingLotRwLock<Frame>>, usize)>,
+  /// Cached frame indices, least recently used first
+  order: VecDeque<usize>,
+}
+
+impl FrameCache {
+  fn new(budget: usize) -> Self {
+    Self {
+      budget,
+      bytes: 0,
+      frames: HashMap::new(),
+      order: VecDeque::new(),
+    }
+  }
+
+  fn get(&mut self, index: usize) -> Option<Arc<ParkingLotRwLock<Frame>>> {
+    let frame = self.frames.get(&index)?.0.clone();
+    if let Some(pos) = self.order.iter().position(|&i| i == index) {
+      self.order.remove(pos);
+    }
+    self.order.push_back(index);
+    Some(frame)
+  }
+
+  /// Insert a frame, evicting older ones until the cache fits the budget.
+  /// The newest frame is always kept, even if it alone exceeds the budget.
+  /// Under frame memory pressure only the newest frame is kept.
+  fn insert(&mut self, index: usize, frame: Arc<ParkingLotRwLock<Frame>>, size: usize) {
+    if self.frames.contains_key(&index) {
+      return;
+    }
+    self.frames.insert(index, (frame, size));
+    self.order.push_back(index);
+    self.bytes += size;
+
+    let budget = if frame_memory::under_pressure() {
+      0
+    } else {
+      self.budget
+    };
+    while self.bytes > budget && self.order.len() > 1 {
+      let Some(evicted) = self.order.pop_front() else {
+        break;
+      };
+      if let Some((_, size)) = self.frames.remove(&evicted) {
+        self.bytes -= size;
+      }
+    }
+  }
+
+  fn clear(&mut self) {
+    self.frames.clear();
+    self.order.clear();
+    self.bytes = 0;
+  }
+}
+
+/// Encoded frames of an image and the decoder that turns them into pixels
+///
+/// Frames are decoded in order on demand. Animated formats can't start in the
+/// middle (GIF frames build on the header in the first packet and on the
+/// previous frame's pixels), so going back to a frame that has been evicted
+/// restarts decoding from the first frame.
+struct FrameStore {
+  config: DecoderConfig,
+  packets: Vec<Packet>,
+  /// desiredWidth/desiredHeight to scale decoded frames to
+  target_size: Option<(u32, u32)>,
+  /// Decoder context (created on first decode)
+  context: Option<CodecContext>,
+  /// Next packet to send to the decoder
+  next_packet: usize,
+  /// Whether the decoder has been drained after the last packet
+  flushed: bool,
+  /// Number of frames the current decoder produced so far
+  decoded: usize,
+  cache: FrameCache,
+}
+
+impl FrameStore {
+  fn new(
+    config: DecoderConfig,
+    packets: Vec<Packet>,
+    target_size: Option<(u32, u32)>,
+    cache_bytes: usize,
+  ) -> Self {
+    Self {
+      config,
+      packets,
+      target_size,
+      context: None,
+      next_packet: 0,
+      flushed: false,
+      decoded: 0,
+      cache: FrameCache::new(cache_bytes),
+    }
+  }
+
+  /// Number of frames in the image
+  ///
+  /// One per packet until all packets went through the decoder, then the
+  /// number it actually produced.
+  fn frame_count(&self) -> usize {
+    if self.flushed {
+      self.decoded
+    } else {
+      self.packets.len()
+    }
+  }
+
+  /// Get a decoded frame, decoding up to it if it isn't cached.
+  /// Returns `None` if the image has fewer frames.
+  fn frame(&mut self, index: usize) -> Result<Option<Arc<ParkingLotRwLock<Frame>>>> {
+    if let Some(frame) = self.cache.get(index) {
+      return Ok(Some(frame));
+    }
+
+    if index < self.decoded {
+      self.rewind();
+    }
+
+    let mut target = None;
+    while target.is_none() {
+      let Some(frames) = self.decode_next()? else {
+        break;
+      };
+      for frame in frames {
+        let frame = self.scale(frame)?;
+        let size = image_buffer_size(frame.format(), frame.width() as i32, frame.height() as i32)
+          .max(0) as usize;
+        let shared = frame.into_shared();
+        if self.decoded == index {
+          target = Some(shared.clone());
+        }
+        self.cache.insert(self.decoded, shared, size);
+        self.decoded += 1;
+      }
+    }
+
+    Ok(target)
+  }
+
+  /// Decode frame `index` ahead of time if it hasn't been decoded yet.
+  /// Returns false past the last frame.
+  fn prefetch(&mut self, index: usize) -> Result<bool> {
+    if index >= self.frame_count() {
+      return Ok(false);
+    }
+    // Already decoded once: cached, or evicted and not worth a restart
+    if index >= self.decoded {
+      self.frame(index)?;
+    }
+    Ok(true)
+  }
+
+  /// Drop decoded frames and decoder state, keeping the encoded frames
+  fn reset(&mut self) {
+    self.rewind();
+    self.cache.clear();
+  }
+
+  /// Restart decoding from the first frame
+  fn rewind(&mut self) {
+    self.context = None;
+    self.next_packet = 0;
+    self.flushed = false;
+    self.decoded = 0;
+  }
+
+  /// Feed the next packet (or the drain signal) to the decoder.
+  /// Returns `None` once the decoder is drained.
+  fn decode_next(&mut self) -> Result<Option<Vec<Frame>>> {
+    if self.flushed {
+      return Ok(None);
+    }
+
+    if self.context.is_none() {
+      self.context = Some(open_image_decoder(&self.config)?);
+    }
+    let context = self.context.as_mut().unwrap();
+
+    let mut frames = Vec::new();
+    if let Some(packet) = self.packets.get(self.next_packet) {
+      self.next_packet += 1;
+      frames = context
+        .decode(Some(packet))
+        .map_err(|e| Error::new(Status::GenericFailure, format!("Decode failed: {}", e)))?;
+    }
+
+    // After the last packet, flush to get any remaining frames and drop the
+    // decoder so its threads go back to the codec thread budget
+    if self.next_packet >= self.packets.len() {
+      frames.extend(context.flush_decoder().unwrap_or_default());
+      self.flushed = true;
+      self.context = None;
+    }
+    Ok(Some(frames))
+  }
+
+  /// Apply desiredWidth/desiredHeight scaling if both are specified
+  fn scale(&self, frame: Frame) -> Result<Frame> {
+    let Some((dw, dh)) = self.target_size else {
+      return Ok(frame);
+    };
+    // Reduced-resolution decoding may already have hit the target
+    if (frame.width(), frame.height()) == (dw, dh) {
+      return Ok(frame);
+    }
+
+    let scaler = Scaler::new(
+      frame.width(),
+      frame.height(),
+      frame.format(),
+      dw,
+      dh,
+      frame.format(),
+      ScaleAlgorithm::Lanczos, // High quality for images
+    )
+    .map_err(|e| {
+      Error::new(
+        Status::GenericFailure,
+        format!("Failed to create scaler: {}", e),
+      )
+    })?;
 
-  // Flush to get any remaining frames
-  let mut all_frames = frames;
-  if let Ok(flushed) = context.flush_decoder() {
-    all_frames.extend(flushed);
+    scaler.scale_alloc(&frame).map_err(|e| {
+      Error::new(
+        Status::GenericFailure,
+        format!("Failed to scale frame: {}", e),
+      )
+    })
   }
+}
+
+/// Create and open a decoder for image frames
+fn open_image_decoder(config: &DecoderConfig) -> Result<CodecContext> {
+  let mut context = CodecContext::new_decoder(config.codec_id).map_err(|e| {
+    Error::new(
+      Status::GenericFailure,
+      format!("Failed to create decoder: {}", e),
+    )
+  })?;
+
+  context.configure_decoder(config).map_err(|e| {
+    Error::new(
+      Status::GenericFailure,
+      format!("Failed to configure decoder: {}", e),
+    )
+  })?;
+
+  context.open().map_err(|e| {
+    Error::new(
+      Status::GenericFailure,
+      format!("Failed to open decoder: {}", e),
+    )
+  })?;
 
-  Ok(all_frames)
+  Ok(context)
 }
@@ -10,12 +10,12 @@ use crate::webcodecs::encoded_audio_chunk::EncodedAudioChunk;
 use crate::webcodecs::encoded_video_chunk::EncodedVideoChunk;
 use crate::webcodecs::muxer_base::{
   EncodedAudioChunkMetadataJs, EncodedVideoChunkMetadataJs, GenericAudioTrackConfig,
-  GenericVideoTrackConfig, MuxerFormat, MuxerInner, StreamingMuxerOptions, lock_muxer_inner,
-  lock_muxer_inner_mut,
+  GenericVideoTrackConfig, MuxerFormat, MuxerInner, RemuxSink, StreamingMuxerOptions,
+  lock_muxer_inner, lock_muxer_inner_mut,
 };
 use napi::bindgen_prelude::*;
 use napi_derive::napi;
-use std::sync::Mutex;
+use std::sync::{Arc, Mutex};
 
 // ============================================================================
 // MKV Format Implementation
@@ -153,7 +153,14 @@ pub struct MkvAudioTrackConfig {
 /// ```
 #[napi]
 pub struct MkvMuxer {
-  inner: Mutex<Option<MuxerInner<MkvFormat>>>,
+  inner: Arc<Mutex<Option<MuxerInner<MkvFormat>>>>,
+}
+
+impl MkvMuxer {
+  /// Shared handle for the native remux path (`demuxer.remuxTo`)
+  pub(crate) fn remux_sink(&self) -> Arc<dyn RemuxSink> {
+    self.inner.clone()
+  }
 }
 
 #[napi]
@@ -178,7 +185,7 @@ impl MkvMuxer {
     };
 
     Ok(Self {
-      inner: Mutex::new(Some(inner)),
+      inner: Arc::new(Mutex::new(Some(inner))),
     })
   }
 
@@ -200,6 +207,7 @@ impl MkvMuxer {
       framerate: config.framerate.unwrap_or(30.0),
       extradata: config.description.as_ref().map(|d| d.to_vec()),
       has_alpha: false, // TODO: Add alpha support for MKV if needed
+      time_base: None,
     };
 
     inner.add_video_track(generic_config)
@@ -266,7 +274,7 @@ impl MkvMuxer {
 
   /// Read available data from streaming buffer (streaming mode only)
   ///
-  /// Returns available data, or null if no data is ready yet.
+  /// Returns all available data, or null if no data is ready yet.
   /// Returns empty Uint8Array when streaming is finished.
   #[napi]
   pub fn read(&self) -> Result<Option<Uint8Array>> {
@@ -278,6 +286,21 @@ impl MkvMuxer {
     }
   }
 
+  /// Read the next page of output (streaming mode only, non-standard)
+  ///
+  /// Like read(), but returns at most one page (up to 32 KiB) and hands it
+  /// over without copying. Call it until it returns null to drain
+  /// everything that is ready.
+  #[napi]
+  pub fn read_page(&self) -> Result<Option<Uint8Array>> {
+    lock_muxer_inner!(self => _guard, inner);
+    match inner.read_streaming_page() {
+      Ok(Some(data)) => Ok(Some(Uint8Array::new(data))),
+      Ok(None) => Ok(None),
+      Err(e) => Err(e),
+    }
+  }
+
   /// Check if muxer is in streaming mode
   #[napi(getter)]
   pub fn is_streaming(&self) -> Result<bool> {
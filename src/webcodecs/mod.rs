@@ -7,11 +7,15 @@ mod audio_data;
 mod audio_decoder;
 mod audio_encoder;
 pub(crate) mod codec_pressure;
+mod codec_stats;
 pub mod codec_string;
+mod codec_worker;
+mod decode_pipeline;
 pub mod demuxer_base;
 mod encoded_audio_chunk;
 mod encoded_video_chunk;
 pub mod error;
+mod frame_memory;
 mod hardware;
 pub(crate) mod hw_fallback;
 mod image_decoder;
@@ -20,7 +24,11 @@ mod mkv_muxer;
 mod mp4_demuxer;
 mod mp4_muxer;
 pub mod muxer_base;
+mod output_batch;
+mod pinned_buffer;
 mod promise_reject;
+mod remux_pipeline;
+mod threading;
 mod video_decoder;
 mod video_encoder;
 mod video_frame;
@@ -32,6 +40,11 @@ pub use audio_decoder::AudioDecoder;
 pub use audio_encoder::{
   AudioDecoderConfigOutput, AudioEncoder, AudioEncoderEncodeOptions, EncodedAudioChunkMetadata,
 };
+pub use codec_pressure::{
+  HardwareSessionCounters, HardwareSessionLimits, HardwareSessionStats, get_hardware_session_stats,
+  set_hardware_session_limits,
+};
+pub use codec_stats::{CodecPerformanceStats, CodecStageStats};
 pub use encoded_audio_chunk::{
   AacBitstreamFormat, AacEncoderConfig, AudioDecoderConfig, AudioDecoderSupport,
   AudioEncoderConfig, AudioEncoderSupport, BitrateMode, EncodedAudioChunk, EncodedAudioChunkInit,
@@ -40,9 +53,10 @@ pub use encoded_audio_chunk::{
 };
 pub(crate) use encoded_video_chunk::EncodedVideoChunkInner;
 pub use encoded_video_chunk::{
-  AlphaOption, AvcBitstreamFormat, AvcEncoderConfig, EncodedVideoChunk, EncodedVideoChunkInit,
-  EncodedVideoChunkType, HardwareAcceleration, HevcBitstreamFormat, HevcEncoderConfig, LatencyMode,
-  VideoDecoderConfig, VideoEncoderBitrateMode, VideoEncoderConfig,
+  AlphaOption, AvcBitstreamFormat, AvcEncoderConfig, EncodeQueueOverflow, EncodedVideoChunk,
+  EncodedVideoChunkInit, EncodedVideoChunkType, HardwareAcceleration, HevcBitstreamFormat,
+  HevcEncoderConfig, LatencyMode, VideoDecodeMode, VideoDecoderConfig, VideoEncoderBitrateMode,
+  VideoEncoderConfig,
 };
 pub(crate) use encoded_video_chunk::{
   convert_annexb_extradata_to_avcc, convert_annexb_extradata_to_hvcc,
@@ -50,9 +64,14 @@ pub(crate) use encoded_video_chunk::{
   convert_obu_extradata_to_av1c, extract_avcc_from_avcc_packet, extract_hvcc_from_hvcc_packet,
   is_av1c_extradata, is_avcc_extradata, is_avcc_format, is_hvcc_extradata,
 };
+pub use frame_memory::{
+  FrameMemoryBudget, FrameMemoryPressure, FrameMemoryPressureEvent, FrameMemoryStats,
+  get_frame_memory_stats, set_frame_memory_budget, set_frame_memory_pressure_listener,
+};
 pub use hardware::{
   HardwareAccelerator, get_available_hardware_accelerators, get_hardware_accelerators,
   get_preferred_hardware_accelerator, is_hardware_accelerator_available,
+  release_unused_hardware_devices, warm_up_hardware,
 };
 pub use hw_fallback::reset_hardware_fallback_state;
 pub use image_decoder::{
@@ -60,11 +79,16 @@ pub use image_decoder::{
 };
 pub use mkv_muxer::{MkvAudioTrackConfig, MkvMuxer, MkvMuxerOptions, MkvVideoTrackConfig};
 pub use mp4_muxer::{Mp4AudioTrackConfig, Mp4Muxer, Mp4MuxerOptions, Mp4VideoTrackConfig};
+pub use threading::{
+  get_codec_thread_budget, get_codec_worker_threads, get_scaler_threads, set_codec_thread_budget,
+  set_codec_worker_threads, set_scaler_threads,
+};
 pub use video_decoder::{VideoDecoder, VideoDecoderSupport};
 pub use video_encoder::{
   CodecState, EncodedVideoChunkMetadata, SvcOutputMetadata, VideoDecoderConfigOutput, VideoEncoder,
   VideoEncoderEncodeOptions, VideoEncoderEncodeOptionsForAv1, VideoEncoderEncodeOptionsForAvc,
-  VideoEncoderEncodeOptionsForHevc, VideoEncoderEncodeOptionsForVp9, VideoEncoderSupport,
+  VideoEncoderEncodeOptionsForHevc, VideoEncoderEncodeOptionsForVp9, VideoEncoderFramePoolStats,
+  VideoEncoderSupport,
 };
 pub use video_frame::{
   DOMRectReadOnly, VideoColorPrimaries, VideoColorSpace, VideoColorSpaceInit, VideoFrame,
@@ -74,7 +98,8 @@ pub use video_frame::{
 pub use webm_muxer::{WebMAudioTrackConfig, WebMMuxer, WebMMuxerOptions, WebMVideoTrackConfig};
 // Demuxer types
 pub use demuxer_base::{
-  DemuxerAudioDecoderConfig, DemuxerChunk, DemuxerTrackInfo, DemuxerVideoDecoderConfig,
+  DemuxerAudioDecoderConfig, DemuxerChunk, DemuxerLoadOptions, DemuxerLoadStreamOptions,
+  DemuxerTrackInfo, DemuxerVideoDecoderConfig,
 };
 pub use mkv_demuxer::{MkvDemuxer, MkvDemuxerInit};
 pub use mp4_demuxer::{Mp4Demuxer, Mp4DemuxerInit};
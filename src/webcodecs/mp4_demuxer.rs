@@ -4,14 +4,17 @@
 //! into encoded video and audio chunks.
 
 use crate::ffi::AVCodecID;
+use crate::webcodecs::decode_pipeline::{DecodeToOptions, PipelineAbort};
 use crate::webcodecs::demuxer_base::{
   AudioOutputCallback, DemuxerAudioDecoderConfig, DemuxerChunk, DemuxerFormat, DemuxerInner,
-  DemuxerTrackInfo, DemuxerVideoDecoderConfig, ErrorCallback, VideoOutputCallback,
-  parse_aac_codec_string, parse_h264_codec_string, parse_hevc_codec_string, parse_vp9_codec_string,
-  with_demuxer_inner, with_demuxer_inner_mut,
+  DemuxerLoadOptions, DemuxerLoadStreamOptions, DemuxerStreamSource, DemuxerTrackInfo,
+  DemuxerVideoDecoderConfig, DemuxerView, ErrorCallback, VideoOutputCallback, decode_demuxer,
+  load_demuxer_stream, parse_aac_codec_string, parse_h264_codec_string, parse_hevc_codec_string,
+  parse_vp9_codec_string, remux_demuxer, with_demuxer_inner, with_demuxer_inner_mut,
 };
 use crate::webcodecs::encoded_audio_chunk::EncodedAudioChunk;
 use crate::webcodecs::encoded_video_chunk::EncodedVideoChunk;
+use crate::webcodecs::remux_pipeline::RemuxTarget;
 use napi::bindgen_prelude::*;
 use napi::threadsafe_function::UnknownReturnValue;
 use napi_derive::napi;
@@ -153,6 +156,9 @@ impl FromNapiValue for Mp4DemuxerInit {
 #[napi(async_iterator)]
 pub struct Mp4Demuxer {
   inner: Arc<Mutex<DemuxerInner<Mp4Format>>>,
+  view: DemuxerView<Mp4Format>,
+  stream_source: DemuxerStreamSource,
+  pipeline_abort: PipelineAbort,
 }
 
 impl AsyncGenerator for Mp4Demuxer {
@@ -185,25 +191,29 @@ impl Mp4Demuxer {
   /// Create a new MP4 demuxer
   #[napi(constructor)]
   pub fn new(init: Mp4DemuxerInit) -> Result<Self> {
+    let inner = DemuxerInner::new(init.video_output, init.audio_output, init.error);
     Ok(Self {
-      inner: Arc::new(Mutex::new(DemuxerInner::new(
-        init.video_output,
-        init.audio_output,
-        init.error,
-      ))),
+      view: inner.view(),
+      inner: Arc::new(Mutex::new(inner)),
+      stream_source: DemuxerStreamSource::default(),
+      pipeline_abort: PipelineAbort::default(),
     })
   }
 
   /// Load an MP4 file from a path
+  ///
+  /// With `{ mmap: true }` the file is memory-mapped and demuxed like a
+  /// buffer: pages load on demand and are shared through the OS page cache
+  /// with every other demuxer mapping the same file.
   #[napi]
-  pub async fn load(&self, path: String) -> Result<()> {
+  pub async fn load(&self, path: String, options: Option<DemuxerLoadOptions>) -> Result<()> {
     let inner = self.inner.clone();
 
     tokio::task::spawn_blocking(move || {
       let mut guard = inner
         .lock()
         .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
-      guard.load_file(&path)
+      guard.load_file_with_options(&path, options)
     })
     .await
     .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
@@ -228,32 +238,59 @@ impl Mp4Demuxer {
     .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
   }
 
+  /// Load an MP4 from a ReadableStream
+  ///
+  /// Resolves once the container headers have arrived; packets can then be
+  /// demuxed while the rest of the stream is still being received. At most
+  /// `bufferSize` bytes (default 1 MiB) are buffered ahead of the demuxer.
+  ///
+  /// The stream is read forward only, so `seek()` is not supported and the
+  /// MP4 must be fragmented or faststart (moov before mdat).
+  ///
+  /// While a read is waiting for stream data, `selectVideoTrack()`,
+  /// `selectAudioTrack()`, `exportIndex()` and `importIndex()` throw
+  /// InvalidStateError rather than block; the getters always answer.
+  #[napi(
+    ts_args_type = "stream: ReadableStream<Uint8Array>, options?: DemuxerLoadStreamOptions",
+    ts_return_type = "Promise<void>"
+  )]
+  pub fn load_stream<'env>(
+    &self,
+    env: &'env Env,
+    stream: ReadableStream<'env, Uint8Array>,
+    options: Option<DemuxerLoadStreamOptions>,
+  ) -> Result<PromiseRaw<'env, ()>> {
+    load_demuxer_stream(
+      env,
+      self.inner.clone(),
+      &self.stream_source,
+      stream,
+      options,
+    )
+  }
+
   /// Get all tracks
   #[napi(getter)]
   pub fn tracks(&self) -> Result<Vec<DemuxerTrackInfo>> {
-    let guard = with_demuxer_inner!(self);
-    Ok(guard.get_tracks())
+    Ok(self.view.tracks())
   }
 
   /// Get container duration in microseconds
   #[napi(getter)]
   pub fn duration(&self) -> Result<Option<i64>> {
-    let guard = with_demuxer_inner!(self);
-    Ok(guard.get_duration())
+    Ok(self.view.duration())
   }
 
   /// Get video decoder configuration for the selected video track
   #[napi(getter)]
   pub fn video_decoder_config(&self) -> Result<Option<DemuxerVideoDecoderConfig>> {
-    let guard = with_demuxer_inner!(self);
-    Ok(guard.get_video_decoder_config())
+    Ok(self.view.video_decoder_config())
   }
 
   /// Get audio decoder configuration for the selected audio track
   #[napi(getter)]
   pub fn audio_decoder_config(&self) -> Result<Option<DemuxerAudioDecoderConfig>> {
-    let guard = with_demuxer_inner!(self);
-    Ok(guard.get_audio_decoder_config())
+    Ok(self.view.audio_decoder_config())
   }
 
   /// Select a video track by index
@@ -317,6 +354,42 @@ impl Mp4Demuxer {
     .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
   }
 
+  /// Decode the selected tracks natively
+  ///
+  /// Demuxes on a background thread and queues packets directly on the
+  /// decoders' worker threads, so encoded chunks never pass through JS; only
+  /// the decoders' output callbacks run. Demuxing stays at most `maxQueueSize`
+  /// packets (default 32) ahead of each decoder.
+  ///
+  /// Resolves once every packet has been queued, or early if the demuxer is
+  /// closed. Call `flush()` on the decoders to wait for the remaining output.
+  #[napi(ts_args_type = "options: DemuxerDecodeToOptions")]
+  pub async fn decode_to(&self, options: DecodeToOptions) -> Result<()> {
+    let inner = self.inner.clone();
+    let abort = self.pipeline_abort.clone();
+
+    tokio::task::spawn_blocking(move || decode_demuxer(&inner, &options, &abort))
+      .await
+      .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
+  }
+
+  /// Remux the selected tracks into a muxer natively
+  ///
+  /// Adds a track to `muxer` for each selected track and writes the remaining
+  /// packets without decoding or passing them through JS. Packet timestamps
+  /// are rescaled between time bases, so B-frame order is preserved.
+  ///
+  /// Resolves once every packet has been written. Call `finalize()` on the
+  /// muxer afterwards.
+  #[napi(ts_args_type = "muxer: Mp4Muxer | WebMMuxer | MkvMuxer")]
+  pub async fn remux_to(&self, muxer: RemuxTarget) -> Result<()> {
+    let inner = self.inner.clone();
+
+    tokio::task::spawn_blocking(move || remux_demuxer(&inner, &muxer))
+      .await
+      .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
+  }
+
   /// Seek to a timestamp in microseconds
   #[napi]
   pub fn seek(&self, timestamp_us: i64) -> Result<()> {
@@ -324,9 +397,55 @@ impl Mp4Demuxer {
     guard.seek(timestamp_us)
   }
 
+  /// Index every keyframe by reading the whole file once
+  ///
+  /// Containers without an up-front index (MKV/WebM without cues) otherwise
+  /// learn keyframe positions only as they are demuxed, so seeks past that
+  /// point scan the file. Resolves with the demuxer rewound to the start.
+  ///
+  /// Rejects with NotSupportedError on a demuxer loaded from a stream.
+  #[napi]
+  pub async fn build_index(&self) -> Result<()> {
+    let inner = self.inner.clone();
+
+    tokio::task::spawn_blocking(move || {
+      let mut guard = inner
+        .lock()
+        .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+      guard.build_index()
+    })
+    .await
+    .map_err(|e| Error::new(Status::GenericFailure, format!("Task error: {}", e)))?
+  }
+
+  /// Export the keyframe index as a compact binary blob
+  ///
+  /// Call after `buildIndex()` or a full demux pass, and cache the result
+  /// next to the file to pass to `importIndex()` on later loads.
+  #[napi]
+  pub fn export_index(&self) -> Result<Uint8Array> {
+    let guard = with_demuxer_inner!(self);
+    Ok(Uint8Array::from(guard.export_index()?))
+  }
+
+  /// Import a keyframe index previously returned by `exportIndex()`
+  ///
+  /// Seeks within the imported range jump straight to the indexed keyframe.
+  /// Throws if the index was built for a different file: one with other
+  /// tracks, or another size or duration.
+  #[napi]
+  pub fn import_index(&self, data: Uint8Array) -> Result<()> {
+    let mut guard = with_demuxer_inner_mut!(self);
+    guard.import_index(&data)
+  }
+
   /// Close the demuxer and release resources
   #[napi]
   pub fn close(&self) -> Result<()> {
+    // Unblock a read waiting for stream data and a decodeTo() waiting for
+    // its decoders before taking the lock
+    self.stream_source.abort();
+    self.pipeline_abort.abort();
     let mut guard = with_demuxer_inner_mut!(self);
     guard.close();
     Ok(())
@@ -335,8 +454,7 @@ impl Mp4Demuxer {
   /// Get the current state of the demuxer
   #[napi(getter)]
   pub fn state(&self) -> Result<String> {
-    let guard = with_demuxer_inner!(self);
-    Ok(guard.state_string().to_string())
+    Ok(self.view.state_string().to_string())
   }
 }
 
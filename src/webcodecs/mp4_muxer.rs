@@ -10,12 +10,13 @@ use crate::webcodecs::encoded_audio_chunk::EncodedAudioChunk;
 use crate::webcodecs::encoded_video_chunk::EncodedVideoChunk;
 use crate::webcodecs::muxer_base::{
   EncodedAudioChunkMetadataJs, EncodedVideoChunkMetadataJs, GenericAudioTrackConfig,
-  GenericVideoTrackConfig, MuxerFormat, MuxerInner, StreamingMuxerOptions, lock_muxer_inner,
-  lock_muxer_inner_mut,
+  GenericVideoTrackConfig, MuxerFormat, MuxerInner, MuxerSegment, RemuxSink, SegmentedMuxerOptions,
+  StreamingMuxerOptions, lock_muxer_inner, lock_muxer_inner_mut, segmenter_from_options,
 };
 use napi::bindgen_prelude::*;
+use napi::threadsafe_function::UnknownReturnValue;
 use napi_derive::napi;
-use std::sync::Mutex;
+use std::sync::{Arc, Mutex};
 
 // ============================================================================
 // MP4 Format Implementation
@@ -32,6 +33,7 @@ impl MuxerFormat for Mp4Format {
       fast_start: false,
       fragmented: false,
       live: false,
+      segmented: false,
     }
   }
 
@@ -111,13 +113,16 @@ impl MuxerFormat for Mp4Format {
 #[derive(Debug, Clone, Default)]
 pub struct Mp4MuxerOptions {
   /// Move moov atom to beginning for better streaming (default: false)
-  /// Note: Not compatible with streaming output mode
+  /// In streaming output mode this writes fragmented MP4 with a leading moov
   pub fast_start: Option<bool>,
   /// Use fragmented MP4 for streaming output
   /// When true, uses frag_keyframe+empty_moov+default_base_moof
   pub fragmented: Option<bool>,
   /// Enable streaming output mode
   pub streaming: Option<StreamingMuxerOptions>,
+  /// Enable segmenting output mode (segments go to `onsegment`)
+  /// Cannot be combined with `streaming`
+  pub segmented: Option<SegmentedMuxerOptions>,
 }
 
 // ============================================================================
@@ -174,7 +179,16 @@ pub struct Mp4AudioTrackConfig {
 /// ```
 #[napi]
 pub struct Mp4Muxer {
-  inner: Mutex<Option<MuxerInner<Mp4Format>>>,
+  inner: Arc<Mutex<Option<MuxerInner<Mp4Format>>>>,
+  /// Segment callback reference (for the onsegment getter)
+  segment_callback: Option<FunctionRef<MuxerSegment, UnknownReturnValue>>,
+}
+
+impl Mp4Muxer {
+  /// Shared handle for the native remux path (`demuxer.remuxTo`)
+  pub(crate) fn remux_sink(&self) -> Arc<dyn RemuxSink> {
+    self.inner.clone()
+  }
 }
 
 #[napi]
@@ -183,24 +197,33 @@ impl Mp4Muxer {
   #[napi(constructor)]
   pub fn new(options: Option<Mp4MuxerOptions>) -> Result<Self> {
     let opts = options.unwrap_or_default();
+    let fast_start = opts.fast_start.unwrap_or(false);
 
-    // Validate incompatible options
-    if opts.fast_start.unwrap_or(false) && opts.streaming.is_some() {
-      return Err(Error::new(
-        Status::GenericFailure,
-        "fastStart is not compatible with streaming mode. Use fragmented: true for streaming.",
-      ));
-    }
+    // Streaming output can't seek back to rewrite the file, so streaming fastStart
+    // writes fragmented MP4 instead: the moov leads the stream (empty_moov) and
+    // each fragment is handed to read() as soon as it is complete.
+    let fragmented = opts.fragmented.unwrap_or(false) || (fast_start && opts.streaming.is_some());
 
     // Create muxer options
     let muxer_options = MuxerOptions {
-      fast_start: opts.fast_start.unwrap_or(false),
-      fragmented: opts.fragmented.unwrap_or(false),
+      fast_start,
+      fragmented,
       live: false, // Not applicable for MP4
+      segmented: false,
     };
 
+    if opts.streaming.is_some() && opts.segmented.is_some() {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "streaming and segmented output cannot be combined",
+      ));
+    }
+
     // Create inner based on output mode
-    let inner = if let Some(streaming_opts) = opts.streaming {
+    let inner = if let Some(segmented_opts) = opts.segmented {
+      let segmenter = segmenter_from_options(segmented_opts, "mp4", "m4s");
+      MuxerInner::<Mp4Format>::new_segmented(muxer_options, segmenter)?
+    } else if let Some(streaming_opts) = opts.streaming {
       let capacity = streaming_opts.buffer_capacity.unwrap_or(256 * 1024) as usize;
       MuxerInner::<Mp4Format>::new_streaming(muxer_options, capacity)?
     } else {
@@ -208,7 +231,8 @@ impl Mp4Muxer {
     };
 
     Ok(Self {
-      inner: Mutex::new(Some(inner)),
+      inner: Arc::new(Mutex::new(Some(inner))),
+      segment_callback: None,
     })
   }
 
@@ -241,6 +265,7 @@ impl Mp4Muxer {
       framerate: config.framerate.unwrap_or(30.0),
       extradata: config.description.as_ref().map(|d| d.to_vec()),
       has_alpha: false, // TODO: Add alpha support for MKV if needed
+      time_base: None,
     };
 
     inner.add_video_track(generic_config)
@@ -330,7 +355,7 @@ impl Mp4Muxer {
 
   /// Read available data from streaming buffer (streaming mode only)
   ///
-  /// Returns available data, or null if no data is ready yet.
+  /// Returns all available data, or null if no data is ready yet.
   /// Returns empty Uint8Array when streaming is finished.
   #[napi]
   pub fn read(&self) -> Result<Option<Uint8Array>> {
@@ -342,6 +367,21 @@ impl Mp4Muxer {
     }
   }
 
+  /// Read the next page of output (streaming mode only, non-standard)
+  ///
+  /// Like read(), but returns at most one page (up to 32 KiB) and hands it
+  /// over without copying. Call it until it returns null to drain
+  /// everything that is ready.
+  #[napi]
+  pub fn read_page(&self) -> Result<Option<Uint8Array>> {
+    lock_muxer_inner!(self => _guard, inner);
+    match inner.read_streaming_page() {
+      Ok(Some(data)) => Ok(Some(Uint8Array::new(data))),
+      Ok(None) => Ok(None),
+      Err(e) => Err(e),
+    }
+  }
+
   /// Check if muxer is in streaming mode
   #[napi(getter)]
   pub fn is_streaming(&self) -> Result<bool> {
@@ -356,6 +396,59 @@ impl Mp4Muxer {
     Ok(inner.is_streaming_finished())
   }
 
+  /// Set the segment handler (segmenting mode only)
+  ///
+  /// Receives the init segment (ftyp+moov) and then one CMAF
+  /// fragment per media segment, in order. Segments cut before a
+  /// handler is set are delivered when it is set.
+  #[napi(setter)]
+  pub fn set_onsegment(
+    &mut self,
+    env: &Env,
+    callback: Option<FunctionRef<MuxerSegment, UnknownReturnValue>>,
+  ) -> Result<()> {
+    let tsfn = match callback {
+      Some(ref cb) => Some(
+        cb.borrow_back(env)?
+          .build_threadsafe_function()
+          .callee_handled::<false>()
+          .weak::<true>() // Weak to allow Node.js process to exit
+          .build()?,
+      ),
+      None => None,
+    };
+    {
+      lock_muxer_inner_mut!(self => _guard, inner);
+      inner.set_segment_callback(tsfn)?;
+    }
+
+    // Store FunctionRef for getter (main thread only)
+    self.segment_callback = callback;
+    Ok(())
+  }
+
+  /// Get the segment handler
+  #[napi(getter)]
+  pub fn get_onsegment<'env>(
+    &self,
+    env: &'env Env,
+  ) -> Result<Option<Function<'env, MuxerSegment, UnknownReturnValue>>> {
+    match self.segment_callback {
+      Some(ref callback) => Ok(Some(callback.borrow_back(env)?)),
+      None => Ok(None),
+    }
+  }
+
+  /// Get an HLS media playlist for the segments cut so far (segmenting mode only)
+  ///
+  /// Lists the init segment as EXT-X-MAP and each media segment by its URI;
+  /// EXT-X-ENDLIST is added once the muxer is finalized.
+  #[napi]
+  pub fn get_hls_playlist(&self) -> Result<String> {
+    lock_muxer_inner!(self => _guard, inner);
+    inner.hls_playlist()
+  }
+
   /// Close the muxer and release resources
   ///
   /// This is called automatically when the muxer is garbage collected,
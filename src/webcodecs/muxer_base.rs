@@ -3,16 +3,25 @@
 //! This module provides common functionality for Mp4Muxer, WebMMuxer, and MkvMuxer
 //! to eliminate code duplication across the three implementations.
 
+use crate::codec::Packet;
+use crate::codec::demuxer::MediaType;
 use crate::codec::io_buffer::StreamingBufferHandle;
 use crate::codec::muxer::{
   AudioStreamConfig, ContainerFormat, MuxerContext, MuxerOptions, MuxerOutput, VideoStreamConfig,
 };
-use crate::ffi::{AVCodecID, AVPixelFormat, AVRational, AVSampleFormat};
+use crate::codec::segmenter::{DEFAULT_TARGET_DURATION_US, SegmentEntry, Segmenter};
+use crate::ffi::avutil::av_rescale_q;
+use crate::ffi::{AV_NOPTS_VALUE, AVCodecID, AVPixelFormat, AVRational, AVSampleFormat};
 use crate::webcodecs::encoded_audio_chunk::EncodedAudioChunk;
 use crate::webcodecs::encoded_video_chunk::{EncodedVideoChunk, EncodedVideoChunkType};
 use napi::bindgen_prelude::*;
+use napi::threadsafe_function::{
+  ThreadsafeFunction, ThreadsafeFunctionCallMode, UnknownReturnValue,
+};
 use napi_derive::napi;
+use std::collections::VecDeque;
 use std::marker::PhantomData;
+use std::sync::Mutex;
 
 // ============================================================================
 // Lock Helper Macros
@@ -173,6 +182,128 @@ pub struct StreamingMuxerOptions {
   pub buffer_capacity: Option<u32>,
 }
 
+// ============================================================================
+// Segmenting Options
+// ============================================================================
+
+/// Segmenting mode options for muxers (non-standard extension)
+///
+/// Output is cut into an init segment plus media segments (CMAF for MP4,
+/// one or more whole clusters per segment for WebM) that are handed to
+/// `onsegment` as they complete, so encoding and packaging for HLS/DASH
+/// happen in one pass.
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct SegmentedMuxerOptions {
+  /// Target segment duration in microseconds (default: 2 seconds)
+  ///
+  /// A segment is cut at the first video keyframe (any audio chunk for
+  /// audio-only output) at or after the target, so segments can run longer
+  /// when keyframes are sparse.
+  pub target_duration: Option<i64>,
+  /// Init segment URI used in playlists (default: "init.mp4" / "init.webm")
+  pub init_uri: Option<String>,
+  /// Media segment URI template; "$Number$" is replaced by the segment's
+  /// sequence number (default: "segment-$Number$.m4s" / "segment-$Number$.webm")
+  pub segment_uri: Option<String>,
+  /// Number of most recent segments listed in the playlist
+  /// (default: 0 = all segments, an EVENT playlist)
+  pub playlist_size: Option<u32>,
+}
+
+/// Kind of segment produced in segmenting mode
+#[napi(string_enum)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum MuxerSegmentType {
+  /// Container header (ftyp+moov / EBML header+Tracks); needed to play any
+  /// media segment
+  #[napi(value = "init")]
+  Init,
+  /// Media segment starting with a keyframe
+  #[napi(value = "media")]
+  Media,
+}
+
+/// Segment handed to `onsegment` in segmenting mode
+#[napi(object)]
+pub struct MuxerSegment {
+  /// Init or media segment
+  pub segment_type: MuxerSegmentType,
+  /// Segment bytes
+  pub data: Uint8Array,
+  /// Media segment sequence number, starting at 1 (0 for the init segment)
+  pub sequence: u32,
+  /// Timestamp of the first chunk in the segment in microseconds
+  pub timestamp: i64,
+  /// Segment duration in microseconds (0 for the init segment)
+  pub duration: i64,
+  /// Segment URI (the init URI, or the segment URI template filled in)
+  pub uri: String,
+}
+
+/// Callback receiving segments in segmenting mode
+pub type SegmentCallback =
+  ThreadsafeFunction<MuxerSegment, UnknownReturnValue, MuxerSegment, Status, false, true>;
+
+/// A cut segment, kept as plain bytes until it is handed to JS
+struct PendingSegment {
+  segment_type: MuxerSegmentType,
+  data: Vec<u8>,
+  entry: SegmentEntry,
+}
+
+impl PendingSegment {
+  fn into_js(self) -> MuxerSegment {
+    MuxerSegment {
+      segment_type: self.segment_type,
+      data: Uint8Array::new(self.data),
+      sequence: self.entry.sequence,
+      timestamp: self.entry.timestamp,
+      duration: self.entry.duration,
+      uri: self.entry.uri,
+    }
+  }
+}
+
+/// Segmenting mode state of a muxer
+struct SegmentOutput {
+  segmenter: Segmenter,
+  callback: Option<SegmentCallback>,
+  /// Segments cut before a callback was set, delivered once it is
+  pending: VecDeque<PendingSegment>,
+}
+
+impl SegmentOutput {
+  fn deliver(&mut self, segment: PendingSegment) {
+    match self.callback {
+      Some(ref callback) => {
+        callback.call(segment.into_js(), ThreadsafeFunctionCallMode::NonBlocking);
+      }
+      None => self.pending.push_back(segment),
+    }
+  }
+}
+
+/// Build a `Segmenter` from JS options, with container-specific default URIs
+pub fn segmenter_from_options(
+  options: SegmentedMuxerOptions,
+  init_extension: &str,
+  segment_extension: &str,
+) -> Segmenter {
+  Segmenter::new(
+    options
+      .target_duration
+      .unwrap_or(DEFAULT_TARGET_DURATION_US),
+    options
+      .init_uri
+      .unwrap_or_else(|| format!("init.{}", init_extension)),
+    options
+      .segment_uri
+      .unwrap_or_else(|| format!("segment-$Number$.{}", segment_extension)),
+    options.playlist_size.unwrap_or(0) as usize,
+  )
+}
+
 // ============================================================================
 // Generic Track Config (used by base implementation)
 // ============================================================================
@@ -187,6 +318,8 @@ pub struct GenericVideoTrackConfig {
   pub extradata: Option<Vec<u8>>,
   /// Whether this track has alpha channel (VP9 alpha support)
   pub has_alpha: bool,
+  /// Stream time base; derived from `framerate` when None
+  pub time_base: Option<AVRational>,
 }
 
 /// Generic audio track configuration passed to base implementation
@@ -268,6 +401,8 @@ pub struct MuxerInner<F: MuxerFormat> {
   video_dts_shift: i64,
   /// Last written video DTS (to ensure monotonically increasing after shift)
   last_video_dts: i64,
+  /// Segmenting mode state (None for buffer and streaming modes)
+  segments: Option<SegmentOutput>,
   /// Phantom data for format type
   _format: PhantomData<F>,
 }
@@ -307,6 +442,7 @@ impl<F: MuxerFormat> MuxerInner<F> {
       video_ticks_per_frame: None,
       video_dts_shift: 0,
       last_video_dts: i64::MIN,
+      segments: None,
       _format: PhantomData,
     })
   }
@@ -324,8 +460,9 @@ impl<F: MuxerFormat> MuxerInner<F> {
     // Get the streaming handle
     let streaming_handle = muxer.get_streaming_handle();
 
-    // Note: fastStart is not supported in streaming mode - it requires the complete
-    // file to rearrange atoms. Use fragmented MP4 for streaming instead.
+    // Note: fastStart post-processing is not supported in streaming mode - it requires
+    // the complete file to rearrange atoms. Mp4Muxer maps streaming fastStart to
+    // fragmented MP4, which already puts the moov first.
     let ffmpeg_options = MuxerOptions {
       fast_start: false, // Not supported in streaming mode
       ..options
@@ -346,10 +483,32 @@ impl<F: MuxerFormat> MuxerInner<F> {
       video_ticks_per_frame: None,
       video_dts_shift: 0,
       last_video_dts: i64::MIN,
+      segments: None,
       _format: PhantomData,
     })
   }
 
+  /// Create a new muxer with segmenting output mode
+  ///
+  /// The muxer writes to a streaming buffer that is drained at every cut, so
+  /// the buffer only ever holds the open segment and needs no backpressure.
+  pub fn new_segmented(options: MuxerOptions, segmenter: Segmenter) -> Result<Self> {
+    let options = MuxerOptions {
+      fragmented: false,
+      live: false,
+      segmented: true,
+      ..options
+    };
+    let mut inner = Self::new_streaming(options, usize::MAX / 2)?;
+    inner.is_streaming = false; // Output goes to onsegment, not read()
+    inner.segments = Some(SegmentOutput {
+      segmenter,
+      callback: None,
+      pending: VecDeque::new(),
+    });
+    Ok(inner)
+  }
+
   /// Add a video track to the muxer
   pub fn add_video_track(&mut self, config: GenericVideoTrackConfig) -> Result<()> {
     if self.state != MuxerState::ConfiguringTracks {
@@ -377,7 +536,9 @@ impl<F: MuxerFormat> MuxerInner<F> {
     // Start with fps as timescale, then double until >= 10000
     // This ensures millisecond-level precision while keeping timescale reasonable
     // For 30fps: 30 -> 60 -> 120 -> 240 -> 480 -> 960 -> 1920 -> 3840 -> 7680 -> 15360
-    let time_base = if config.framerate > 0.0 && config.framerate.is_finite() {
+    let time_base = if let Some(time_base) = config.time_base {
+      time_base
+    } else if config.framerate > 0.0 && config.framerate.is_finite() {
       let fps = config.framerate;
       const MIN_FPS: f64 = 1.0;
       if fps >= MIN_FPS {
@@ -495,10 +656,118 @@ impl<F: MuxerFormat> MuxerInner<F> {
           self.video_ticks_per_frame = Some((tb.den as f64 / fps).round() as u64);
         }
       }
+
+      if self.segments.is_some() {
+        self.muxer.flush_io();
+        let data = self.take_segment_output();
+        if let Some(output) = self.segments.as_mut() {
+          let entry = SegmentEntry {
+            sequence: 0,
+            timestamp: 0,
+            duration: 0,
+            uri: output.segmenter.init_uri().to_string(),
+          };
+          output.deliver(PendingSegment {
+            segment_type: MuxerSegmentType::Init,
+            data,
+            entry,
+          });
+        }
+      }
     }
     Ok(())
   }
 
+  /// Take everything written to the output since the last cut
+  fn take_segment_output(&self) -> Vec<u8> {
+    self
+      .streaming_handle
+      .as_ref()
+      .and_then(|handle| handle.read_available())
+      .unwrap_or_default()
+  }
+
+  /// Cut a segment before a packet if it closes the open one (segmenting mode)
+  ///
+  /// `timestamp` is the packet's presentation time in microseconds.
+  fn segment_before_packet(
+    &mut self,
+    media_type: MediaType,
+    keyframe: bool,
+    timestamp: i64,
+  ) -> Result<()> {
+    // With a video track, segments start at video keyframes
+    let drives_cuts = media_type == MediaType::Video || self.video_track_info.is_none();
+    let Some(output) = self.segments.as_ref() else {
+      return Ok(());
+    };
+    if output
+      .segmenter
+      .should_cut(drives_cuts, keyframe, timestamp)
+    {
+      self.muxer.flush_fragment().map_err(|e| {
+        Error::new(
+          Status::GenericFailure,
+          format!("Failed to cut segment: {}", e),
+        )
+      })?;
+      self.close_segment(Some(timestamp));
+    }
+    Ok(())
+  }
+
+  /// Record a written packet in the open segment (segmenting mode)
+  fn segment_after_packet(&mut self, timestamp: i64, duration: i64) {
+    if let Some(output) = self.segments.as_mut() {
+      output.segmenter.observe(timestamp, duration);
+    }
+  }
+
+  /// Close the open segment with whatever was written since the last cut
+  fn close_segment(&mut self, end: Option<i64>) {
+    let data = self.take_segment_output();
+    if let Some(output) = self.segments.as_mut()
+      && let Some(entry) = output.segmenter.close_segment(end)
+    {
+      output.deliver(PendingSegment {
+        segment_type: MuxerSegmentType::Media,
+        data,
+        entry,
+      });
+    }
+  }
+
+  /// Set the callback receiving segments (segmenting mode only)
+  ///
+  /// Segments cut while no callback was set are delivered to the new one.
+  pub fn set_segment_callback(&mut self, callback: Option<SegmentCallback>) -> Result<()> {
+    let output = self
+      .segments
+      .as_mut()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Not in segmenting mode"))?;
+    output.callback = callback;
+    if output.callback.is_some() {
+      while let Some(segment) = output.pending.pop_front() {
+        output.deliver(segment);
+      }
+    }
+    Ok(())
+  }
+
+  /// Render an HLS media playlist for the segments cut so far
+  /// (segmenting mode only)
+  pub fn hls_playlist(&self) -> Result<String> {
+    let output = self
+      .segments
+      .as_ref()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Not in segmenting mode"))?;
+    Ok(
+      output
+        .segmenter
+        .hls_playlist(self.state == MuxerState::Finalized),
+    )
+  }
+
   /// Add an encoded video chunk to the muxer
   pub fn add_video_chunk(
     &mut self,
@@ -511,6 +780,23 @@ impl<F: MuxerFormat> MuxerInner<F> {
       .video_stream_index()
       .ok_or_else(|| Error::new(Status::GenericFailure, "No video track added"))?;
 
+    // Handle metadata - extract description if present
+    // Applied before the header is written so headers written up front
+    // (fragmented MP4, WebM) carry the first chunk's decoder configuration
+    if let Some(description) = metadata
+      .as_ref()
+      .and_then(|m| m.decoder_config.as_ref())
+      .and_then(|c| c.description.as_ref())
+    {
+      let desc_data: &[u8] = description;
+      if !desc_data.is_empty() {
+        // Update extradata dynamically if available
+        if let Err(e) = self.muxer.update_video_extradata(desc_data) {
+          tracing::warn!(target: "webcodecs", "Failed to update video extradata: {}", e);
+        }
+      }
+    }
+
     // Write header if needed
     self.ensure_header_written()?;
 
@@ -696,21 +982,6 @@ impl<F: MuxerFormat> MuxerInner<F> {
       packet.set_flags(crate::ffi::pkt_flag::KEY);
     }
 
-    // Handle metadata - extract description if present
-    if let Some(description) = metadata
-      .as_ref()
-      .and_then(|m| m.decoder_config.as_ref())
-      .and_then(|c| c.description.as_ref())
-    {
-      let desc_data: &[u8] = description;
-      if !desc_data.is_empty() {
-        // Update extradata dynamically if available
-        if let Err(e) = self.muxer.update_video_extradata(desc_data) {
-          tracing::warn!(target: "webcodecs", "Failed to update video extradata: {}", e);
-        }
-      }
-    }
-
     // Handle alpha side data for VP9 alpha support
     // This adds the alpha channel data as BlockAdditional side data
     if let Some(alpha_data) = metadata.as_ref().and_then(|m| m.alpha_side_data.as_ref()) {
@@ -722,6 +993,12 @@ impl<F: MuxerFormat> MuxerInner<F> {
       }
     }
 
+    self.segment_before_packet(
+      MediaType::Video,
+      chunk_type == EncodedVideoChunkType::Key,
+      timestamp,
+    )?;
+
     // Write packet
     self.muxer.write_packet(&mut packet).map_err(|e| {
       Error::new(
@@ -730,6 +1007,7 @@ impl<F: MuxerFormat> MuxerInner<F> {
       )
     })?;
 
+    self.segment_after_packet(timestamp, duration.unwrap_or(0));
     Ok(())
   }
 
@@ -745,6 +1023,21 @@ impl<F: MuxerFormat> MuxerInner<F> {
       .audio_stream_index()
       .ok_or_else(|| Error::new(Status::GenericFailure, "No audio track added"))?;
 
+    // Handle metadata - extract description if present (before the header,
+    // see add_video_chunk)
+    if let Some(description) = metadata
+      .and_then(|m| m.decoder_config.as_ref())
+      .and_then(|c| c.description.as_ref())
+    {
+      let desc_data = description.to_vec();
+      if !desc_data.is_empty() {
+        // Update extradata dynamically if available
+        if let Err(e) = self.muxer.update_audio_extradata(&desc_data) {
+          tracing::warn!(target: "webcodecs", "Failed to update audio extradata: {}", e);
+        }
+      }
+    }
+
     // Write header if needed
     self.ensure_header_written()?;
 
@@ -791,23 +1084,11 @@ impl<F: MuxerFormat> MuxerInner<F> {
       packet.set_duration(duration_in_samples);
     }
 
-    // Handle metadata - extract description if present
-    if let Some(description) = metadata
-      .and_then(|m| m.decoder_config.as_ref())
-      .and_then(|c| c.description.as_ref())
-    {
-      let desc_data = description.to_vec();
-      if !desc_data.is_empty() {
-        // Update extradata dynamically if available
-        if let Err(e) = self.muxer.update_audio_extradata(&desc_data) {
-          tracing::warn!(target: "webcodecs", "Failed to update audio extradata: {}", e);
-        }
-      }
-    }
-
     // Audio packets are typically all keyframes
     packet.set_flags(crate::ffi::pkt_flag::KEY);
 
+    self.segment_before_packet(MediaType::Audio, true, timestamp)?;
+
     // Write packet
     self.muxer.write_packet(&mut packet).map_err(|e| {
       Error::new(
@@ -816,6 +1097,86 @@ impl<F: MuxerFormat> MuxerInner<F> {
       )
     })?;
 
+    self.segment_after_packet(timestamp, duration.unwrap_or(0));
+    Ok(())
+  }
+
+  /// Write a demuxed packet as-is (remux path)
+  ///
+  /// The packet keeps its data, flags and side data; only the stream index is
+  /// set and PTS/DTS/duration are rescaled from `src_tb` to the stream time
+  /// base, so B-frame timing survives unchanged.
+  pub fn write_remux_packet(
+    &mut self,
+    mut packet: Packet,
+    media_type: MediaType,
+    src_tb: AVRational,
+  ) -> Result<()> {
+    let (stream_index, dst_tb) = match media_type {
+      MediaType::Video => {
+        let index = self
+          .muxer
+          .video_stream_index()
+          .ok_or_else(|| Error::new(Status::GenericFailure, "No video track added"))?;
+        self.ensure_header_written()?;
+        (index, self.muxer.video_time_base())
+      }
+      MediaType::Audio => {
+        let index = self
+          .muxer
+          .audio_stream_index()
+          .ok_or_else(|| Error::new(Status::GenericFailure, "No audio track added"))?;
+        self.ensure_header_written()?;
+        (index, self.muxer.audio_time_base())
+      }
+      _ => return Ok(()),
+    };
+
+    if self.state != MuxerState::Muxing {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "Muxer is not in muxing state",
+      ));
+    }
+
+    // Segment bookkeeping works in microseconds, like the chunk paths
+    let segment_timing = self.segments.is_some().then(|| {
+      let ts = if packet.pts() != AV_NOPTS_VALUE {
+        packet.pts()
+      } else {
+        packet.dts()
+      };
+      let to_us = |v: i64| unsafe { av_rescale_q(v, src_tb, AVRational::MICROSECONDS) };
+      (to_us(ts), to_us(packet.duration()), packet.is_key())
+    });
+    if let Some((timestamp, _, keyframe)) = segment_timing {
+      self.segment_before_packet(media_type, keyframe, timestamp)?;
+    }
+
+    packet.set_stream_index(stream_index);
+    if let Some(dst_tb) = dst_tb {
+      let rescale = |ts: i64| {
+        if ts == AV_NOPTS_VALUE {
+          ts
+        } else {
+          unsafe { av_rescale_q(ts, src_tb, dst_tb) }
+        }
+      };
+      packet.set_pts(rescale(packet.pts()));
+      packet.set_dts(rescale(packet.dts()));
+      packet.set_duration(unsafe { av_rescale_q(packet.duration(), src_tb, dst_tb) });
+    }
+
+    self.muxer.write_packet(&mut packet).map_err(|e| {
+      Error::new(
+        Status::GenericFailure,
+        format!("Failed to write packet: {}", e),
+      )
+    })?;
+
+    if let Some((timestamp, duration, _)) = segment_timing {
+      self.segment_after_packet(timestamp, duration);
+    }
     Ok(())
   }
 
@@ -861,6 +1222,14 @@ impl<F: MuxerFormat> MuxerInner<F> {
 
     self.state = MuxerState::Finalized;
 
+    // In segmenting mode the trailer flushed the last fragment/cluster; hand
+    // it out as the final segment. Everything else already went to onsegment
+    if self.segments.is_some() {
+      self.close_segment(None);
+      self.muxer.finish_streaming();
+      return Ok(Vec::new());
+    }
+
     // In streaming mode, signal EOF and return empty vec
     // Remaining data should be read via read()
     if self.is_streaming {
@@ -885,13 +1254,34 @@ impl<F: MuxerFormat> MuxerInner<F> {
   }
 
   /// Read available data from streaming buffer (for streaming mode)
+  ///
+  /// Returns None if no data is ready yet and an empty Vec once streaming
+  /// is finished, matching what `read()` returns to JavaScript.
   pub fn read_streaming(&self) -> Result<Option<Vec<u8>>> {
+    self.read_streaming_with(StreamingBufferHandle::read_available)
+  }
+
+  /// Read the next page from streaming buffer (for streaming mode)
+  ///
+  /// Same conventions as `read_streaming`, but only one page is taken.
+  pub fn read_streaming_page(&self) -> Result<Option<Vec<u8>>> {
+    self.read_streaming_with(StreamingBufferHandle::read_page)
+  }
+
+  fn read_streaming_with(
+    &self,
+    read: impl FnOnce(&StreamingBufferHandle) -> Option<Vec<u8>>,
+  ) -> Result<Option<Vec<u8>>> {
     if !self.is_streaming {
       return Err(Error::new(Status::GenericFailure, "Not in streaming mode"));
     }
 
     if let Some(ref handle) = self.streaming_handle {
-      Ok(handle.read_available())
+      Ok(match read(handle) {
+        Some(data) if data.is_empty() => None, // No data ready yet
+        Some(data) => Some(data),
+        None => Some(Vec::new()), // EOF
+      })
     } else {
       Err(Error::new(
         Status::GenericFailure,
@@ -914,3 +1304,72 @@ impl<F: MuxerFormat> MuxerInner<F> {
     self.state.as_str()
   }
 }
+
+// ============================================================================
+// RemuxSink - Type-erased muxer for the native remux path
+// ============================================================================
+
+/// A muxer that demuxed packets can be written to without wrapping them in
+/// chunks (see `remux_pipeline`)
+pub trait RemuxSink: Send + Sync {
+  /// Add tracks for the streams about to be remuxed
+  ///
+  /// Codec strings are parsed (and validated for the container) like the
+  /// JS `addVideoTrack`/`addAudioTrack` calls.
+  fn add_remux_tracks(
+    &self,
+    video: Option<GenericVideoTrackConfig>,
+    audio: Option<GenericAudioTrackConfig>,
+  ) -> Result<()>;
+
+  /// Write one demuxed packet, see `MuxerInner::write_remux_packet`
+  fn write_remux_packet(
+    &self,
+    packet: Packet,
+    media_type: MediaType,
+    src_tb: AVRational,
+  ) -> Result<()>;
+}
+
+impl<F: MuxerFormat> RemuxSink for Mutex<Option<MuxerInner<F>>> {
+  fn add_remux_tracks(
+    &self,
+    video: Option<GenericVideoTrackConfig>,
+    audio: Option<GenericAudioTrackConfig>,
+  ) -> Result<()> {
+    let mut guard = self
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+    let inner = guard
+      .as_mut()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Muxer is closed"))?;
+
+    if let Some(mut config) = video {
+      config.codec_id = F::parse_video_codec(&config.codec)?;
+      inner.add_video_track(config)?;
+    }
+    if let Some(mut config) = audio {
+      config.codec_id = F::parse_audio_codec(&config.codec)?;
+      if config.frame_size.is_none() {
+        config.frame_size = F::get_audio_frame_size(config.codec_id);
+      }
+      inner.add_audio_track(config)?;
+    }
+    Ok(())
+  }
+
+  fn write_remux_packet(
+    &self,
+    packet: Packet,
+    media_type: MediaType,
+    src_tb: AVRational,
+  ) -> Result<()> {
+    let mut guard = self
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+    let inner = guard
+      .as_mut()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Muxer is closed"))?;
+    inner.write_remux_packet(packet, media_type, src_tb)
+  }
+}
@@ -0,0 +1,169 @@
+//! Batched output delivery for codec worker threads
+//!
+//! By default every decoded frame / encoded chunk is handed to JS with its own
+//! ThreadsafeFunction call, i.e. one libuv wakeup and one callback per output.
+//! For small, high-rate workloads (e.g. 240p thumbnailing) that crossing costs
+//! more than the codec work itself.
+//!
+//! When the init dictionary provides `outputBatch`, the worker instead collects
+//! outputs into an `OutputBatch` and delivers them as a single array once
+//! `maxBatchSize` outputs are pending or the oldest one has waited
+//! `maxBatchLatency` milliseconds.
+
+use std::time::{Duration, Instant};
+
+use napi::bindgen_prelude::*;
+
+/// Default number of outputs per batch
+pub(crate) const DEFAULT_MAX_BATCH_SIZE: u32 = 16;
+
+/// Default upper bound (ms) an output waits in an open batch
+pub(crate) const DEFAULT_MAX_BATCH_LATENCY_MS: f64 = 10.0;
+
+/// Limits for an output batch, parsed from the codec init dictionary
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub(crate) struct OutputBatchConfig {
+  /// Deliver as soon as this many outputs are pending
+  pub max_size: usize,
+  /// Deliver once the oldest pending output has waited this long
+  pub max_latency: Duration,
+}
+
+impl Default for OutputBatchConfig {
+  fn default() -> Self {
+    Self {
+      max_size: DEFAULT_MAX_BATCH_SIZE as usize,
+      max_latency: Duration::from_secs_f64(DEFAULT_MAX_BATCH_LATENCY_MS / 1000.0),
+    }
+  }
+}
+
+impl OutputBatchConfig {
+  /// Read `maxBatchSize` / `maxBatchLatency` from an init dictionary
+  ///
+  /// Throws a TypeError for a zero batch size or a negative/non-finite latency.
+  pub(crate) fn from_init(env: &Env, obj: &Object) -> Result<Self> {
+    let mut config = Self::default();
+
+    if let Some(max_size) = obj.get::<u32>("maxBatchSize")? {
+      if max_size == 0 {
+        env.throw_type_error("maxBatchSize must be greater than 0", None)?;
+        return Err(Error::new(
+          Status::InvalidArg,
+          "maxBatchSize must be greater than 0",
+        ));
+      }
+      config.max_size = max_size as usize;
+    }
+
+    if let Some(latency_ms) = obj.get::<f64>("maxBatchLatency")? {
+      if !latency_ms.is_finite() || latency_ms < 0.0 {
+        env.throw_type_error("maxBatchLatency must be a non-negative number", None)?;
+        return Err(Error::new(
+          Status::InvalidArg,
+          "maxBatchLatency must be a non-negative number",
+        ));
+      }
+      config.max_latency = Duration::from_secs_f64(latency_ms / 1000.0);
+    }
+
+    Ok(config)
+  }
+}
+
+/// Outputs collected on the worker thread, awaiting delivery as one array
+pub(crate) struct OutputBatch<T> {
+  items: Vec<T>,
+  /// Delivery deadline of the open batch (set when the first item arrives)
+  deadline: Option<Instant>,
+  config: OutputBatchConfig,
+}
+
+impl<T> OutputBatch<T> {
+  pub(crate) fn new(config: OutputBatchConfig) -> Self {
+    Self {
+      items: Vec::with_capacity(config.max_size),
+      deadline: None,
+      config,
+    }
+  }
+
+  /// Add an output; returns `true` when the batch is full and should be delivered
+  pub(crate) fn push(&mut self, item: T) -> bool {
+    if self.items.is_empty() {
+      self.deadline = Some(Instant::now() + self.config.max_latency);
+    }
+    self.items.push(item);
+    self.items.len() >= self.config.max_size
+  }
+
+  /// Deadline by which the open batch must be delivered (None when empty)
+  pub(crate) fn deadline(&self) -> Option<Instant> {
+    self.deadline
+  }
+
+  pub(crate) fn is_empty(&self) -> bool {
+    self.items.is_empty()
+  }
+
+  /// Take all pending outputs, closing the batch
+  pub(crate) fn take(&mut self) -> Vec<T> {
+    self.deadline = None;
+    std::mem::replace(&mut self.items, Vec::with_capacity(self.config.max_size))
+  }
+
+  /// Discard all pending outputs (reset/close)
+  pub(crate) fn clear(&mut self) {
+    self.deadline = None;
+    self.items.clear();
+  }
+}
+
+#[cfg(test)]
+mod tests {
+  use super::*;
+
+  fn config(max_size: usize, max_latency_ms: u64) -> OutputBatchConfig {
+    OutputBatchConfig {
+      max_size,
+      max_latency: Duration::from_millis(max_latency_ms),
+    }
+  }
+
+  #[test]
+  fn test_batch_reports_full() {
+    let mut batch = OutputBatch::new(config(3, 100));
+    assert!(!batch.push(1));
+    assert!(!batch.push(2));
+    assert!(batch.push(3));
+    assert_eq!(batch.take(), vec![1, 2, 3]);
+    assert!(batch.is_empty());
+  }
+
+  #[test]
+  fn test_batch_deadline_tracks_first_item() {
+    let mut batch = OutputBatch::new(config(8, 50));
+    assert!(batch.deadline().is_none());
+
+    let before = Instant::now();
+    batch.push(1);
+    let deadline = batch.deadline().unwrap();
+    assert!(deadline >= before + Duration::from_millis(50));
+
+    // Later items don't extend the deadline
+    batch.push(2);
+    assert_eq!(batch.deadline(), Some(deadline));
+
+    batch.take();
+    assert!(batch.deadline().is_none());
+  }
+
+  #[test]
+  fn test_batch_clear() {
+    let mut batch = OutputBatch::new(config(8, 50));
+    batch.push(1);
+    batch.clear();
+    assert!(batch.is_empty());
+    assert!(batch.deadline().is_none());
+  }
+}
@@ -0,0 +1,291 @@
+//! Pinned JavaScript buffers for zero-copy frame construction
+//!
+//! `new VideoFrame(data, { transfer: [data.buffer] })` detaches the caller's
+//! ArrayBuffer, as the spec requires, by moving its backing store into a new
+//! ArrayBuffer that only the frame can reach (`transfer_array_buffer`). The
+//! frame then wraps that memory directly in an FFmpeg buffer instead of
+//! copying it. The FFmpeg buffer owns a `PinnedJsBuffer`, a strong N-API
+//! reference that keeps the JS memory alive until the last frame reference is
+//! released.
+//!
+//! FFmpeg may drop that last reference on any thread (encoder workers hold
+//! frames for lookahead), but N-API references can only be deleted on the JS
+//! thread that created them. Releases from other threads are therefore queued
+//! and a threadsafe function wakes that JS thread to delete them, so the
+//! memory goes back as soon as the last frame reference is gone. The queue is
+//! also drained whenever the JS thread creates, closes or garbage collects a
+//! VideoFrame, and when its environment is torn down.
+
+use std::cell::Cell;
+use std::ffi::c_void;
+use std::ptr;
+use std::sync::Mutex;
+use std::thread::{self, ThreadId};
+
+use napi::{
+  bindgen_prelude::{Env, Result},
+  check_status, sys,
+};
+
+/// Strong reference to a JS value, safe to drop from any thread
+pub(crate) struct PinnedJsBuffer {
+  env: sys::napi_env,
+  reference: sys::napi_ref,
+  js_thread: ThreadId,
+}
+
+// SAFETY: the raw env/ref are only ever passed to N-API on `js_thread`;
+// drops on other threads just move them into `PENDING_RELEASES`.
+unsafe impl Send for PinnedJsBuffer {}
+
+/// References released off their JS thread, waiting to be deleted
+static PENDING_RELEASES: Mutex<Vec<PinnedJsBuffer>> = Mutex::new(Vec::new());
+
+/// Threadsafe function of a JS thread that drains `PENDING_RELEASES` there
+struct ReleaseNotifier {
+  js_thread: ThreadId,
+  tsfn: sys::napi_threadsafe_function,
+  /// A drain is queued and hasn't started yet
+  scheduled: bool,
+}
+
+// SAFETY: a threadsafe function may be called from any thread; the entry is
+// removed under the lock before Node frees it (`notifier_finalized`).
+unsafe impl Send for ReleaseNotifier {}
+
+/// One notifier per JS thread that pinned a buffer
+static RELEASE_NOTIFIERS: Mutex<Vec<ReleaseNotifier>> = Mutex::new(Vec::new());
+
+thread_local! {
+  /// Whether this JS thread registered `drain_on_cleanup` and its notifier
+  static CLEANUP_HOOK_ADDED: Cell<bool> = const { Cell::new(false) };
+}
+
+/// Env cleanup hook: delete queued references before the environment goes away
+unsafe extern "C" fn drain_on_cleanup(_arg: *mut c_void) {
+  release_pending_pins();
+}
+
+/// Threadsafe function callback, run on the JS thread owning the notifier
+unsafe extern "C" fn drain_on_notify(
+  env: sys::napi_env,
+  _js_callback: sys::napi_value,
+  _context: *mut c_void,
+  _data: *mut c_void,
+) {
+  // Null while the environment is being torn down; drain_on_cleanup covers it
+  if env.is_null() {
+    return;
+  }
+  // Clear the flag first so releases queued during the drain notify again
+  let current = thread::current().id();
+  if let Ok(mut notifiers) = RELEASE_NOTIFIERS.lock()
+    && let Some(notifier) = notifiers.iter_mut().find(|n| n.js_thread == current)
+  {
+    notifier.scheduled = false;
+  }
+  release_pending_pins();
+}
+
+/// Threadsafe function finalizer: forget the notifier before Node frees it
+unsafe extern "C" fn notifier_finalized(
+  _env: sys::napi_env,
+  _finalize_data: *mut c_void,
+  _finalize_hint: *mut c_void,
+) {
+  let current = thread::current().id();
+  if let Ok(mut notifiers) = RELEASE_NOTIFIERS.lock() {
+    notifiers.retain(|n| n.js_thread != current);
+  }
+}
+
+/// Create the notifier for the current JS thread
+///
+/// Unreferenced, so it never keeps the event loop alive.
+fn add_release_notifier(env: &Env) -> Result<()> {
+  let name = c"webcodecs.releasePinnedBuffers";
+  let mut resource_name = ptr::null_mut();
+  check_status!(
+    unsafe {
+      sys::napi_create_string_utf8(
+        env.raw(),
+        name.as_ptr(),
+        name.to_bytes().len() as _,
+        &mut resource_name,
+      )
+    },
+    "Failed to name pinned buffer notifier"
+  )?;
+
+  let mut tsfn = ptr::null_mut();
+  check_status!(
+    unsafe {
+      sys::napi_create_threadsafe_function(
+        env.raw(),
+        ptr::null_mut(),
+        ptr::null_mut(),
+        resource_name,
+        0,
+        1,
+        ptr::null_mut(),
+        Some(notifier_finalized),
+        ptr::null_mut(),
+        Some(drain_on_notify),
+        &mut tsfn,
+      )
+    },
+    "Failed to create pinned buffer notifier"
+  )?;
+  check_status!(
+    unsafe { sys::napi_unref_threadsafe_function(env.raw(), tsfn) },
+    "Failed to unref pinned buffer notifier"
+  )?;
+
+  if let Ok(mut notifiers) = RELEASE_NOTIFIERS.lock() {
+    notifiers.push(ReleaseNotifier {
+      js_thread: thread::current().id(),
+      tsfn,
+      scheduled: false,
+    });
+  }
+  Ok(())
+}
+
+/// Wake `js_thread` to delete its queued references, unless a drain is pending
+fn notify_js_thread(js_thread: ThreadId) {
+  let Ok(mut notifiers) = RELEASE_NOTIFIERS.lock() else {
+    return;
+  };
+  if let Some(notifier) = notifiers.iter_mut().find(|n| n.js_thread == js_thread)
+    && !notifier.scheduled
+  {
+    // Fails only while the environment closes; its cleanup hook drains then
+    let status = unsafe {
+      sys::napi_call_threadsafe_function(
+        notifier.tsfn,
+        ptr::null_mut(),
+        sys::ThreadsafeFunctionCallMode::nonblocking,
+      )
+    };
+    notifier.scheduled = status == sys::Status::napi_ok;
+  }
+}
+
+impl PinnedJsBuffer {
+  /// Pin `value` (a TypedArray/ArrayBuffer) so its backing store stays alive
+  pub(crate) fn new(env: &Env, value: sys::napi_value) -> Result<Self> {
+    let mut reference = ptr::null_mut();
+    check_status!(
+      unsafe { sys::napi_create_reference(env.raw(), value, 1, &mut reference) },
+      "Failed to pin transferred buffer"
+    )?;
+    if !CLEANUP_HOOK_ADDED.get() {
+      check_status!(
+        unsafe {
+          sys::napi_add_env_cleanup_hook(env.raw(), Some(drain_on_cleanup), ptr::null_mut())
+        },
+        "Failed to add pinned buffer cleanup hook"
+      )?;
+      // Set before the notifier: Node rejects a duplicate cleanup hook
+      CLEANUP_HOOK_ADDED.set(true);
+      add_release_notifier(env)?;
+    }
+    Ok(Self {
+      env: env.raw(),
+      reference,
+      js_thread: thread::current().id(),
+    })
+  }
+}
+
+impl Drop for PinnedJsBuffer {
+  fn drop(&mut self) {
+    if self.reference.is_null() {
+      return;
+    }
+    if thread::current().id() == self.js_thread {
+      unsafe { sys::napi_delete_reference(self.env, self.reference) };
+      return;
+    }
+    // Hand the reference to the JS thread; leave a null ref behind so the
+    // queued copy is the only one that deletes it.
+    let deferred = PinnedJsBuffer {
+      env: self.env,
+      reference: std::mem::replace(&mut self.reference, ptr::null_mut()),
+      js_thread: self.js_thread,
+    };
+    let js_thread = deferred.js_thread;
+    if let Ok(mut pending) = PENDING_RELEASES.lock() {
+      pending.push(deferred);
+    } else {
+      // Poisoned queue: leak the reference rather than delete it off-thread
+      std::mem::forget(deferred);
+      return;
+    }
+    notify_js_thread(js_thread);
+  }
+}
+
+/// Delete references that were released on other threads for the current JS thread
+pub(crate) fn release_pending_pins() {
+  let current = thread::current().id();
+  let ready: Vec<PinnedJsBuffer> = match PENDING_RELEASES.lock() {
+    Ok(mut pending) => {
+      if pending.is_empty() {
+        return;
+      }
+      let (ready, rest): (Vec<_>, Vec<_>) =
+        pending.drain(..).partition(|pin| pin.js_thread == current);
+      *pending = rest;
+      ready
+    }
+    Err(_) => return,
+  };
+  // Dropped here, outside the lock, on the owning JS thread
+  drop(ready);
+}
+
+/// Detach `buffer` by moving its backing store into a new ArrayBuffer
+///
+/// Node-API can only detach an ArrayBuffer by freeing its memory, so this
+/// calls `ArrayBuffer.prototype.transfer()`, which V8 implements by handing
+/// the backing store over without copying. Returns the new buffer and its data
+/// pointer, or None (with `buffer` left untouched) when the buffer can't be
+/// detached, e.g. WebAssembly memory or a pooled Node.js Buffer.
+///
+/// # Safety
+/// `env` and `buffer` must be valid handles in the current scope.
+pub(crate) unsafe fn transfer_array_buffer(
+  env: sys::napi_env,
+  buffer: sys::napi_value,
+) -> Result<Option<(sys::napi_value, *mut u8)>> {
+  let mut transfer = ptr::null_mut();
+  check_status!(
+    unsafe { sys::napi_get_named_property(env, buffer, c"transfer".as_ptr(), &mut transfer) },
+    "Failed to look up ArrayBuffer.prototype.transfer"
+  )?;
+  let mut kind = sys::ValueType::napi_undefined;
+  unsafe { sys::napi_typeof(env, transfer, &mut kind) };
+  if kind != sys::ValueType::napi_function {
+    return Ok(None);
+  }
+
+  let mut owned = ptr::null_mut();
+  let status =
+    unsafe { sys::napi_call_function(env, buffer, transfer, 0, ptr::null(), &mut owned) };
+  if status == sys::Status::napi_pending_exception {
+    // Not detachable: clear the TypeError and let the caller copy instead
+    let mut exception = ptr::null_mut();
+    unsafe { sys::napi_get_and_clear_last_exception(env, &mut exception) };
+    return Ok(None);
+  }
+  check_status!(status, "Failed to transfer ArrayBuffer")?;
+
+  let mut data = ptr::null_mut();
+  let mut len = 0usize;
+  check_status!(
+    unsafe { sys::napi_get_arraybuffer_info(env, owned, &mut data, &mut len) },
+    "Failed to read transferred ArrayBuffer"
+  )?;
+  Ok(Some((owned, data as *mut u8)))
+}
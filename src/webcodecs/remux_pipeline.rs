@@ -0,0 +1,46 @@
+//! Native demux-to-mux (remux) pipeline
+//!
+//! `demuxer.remuxTo(muxer)` moves demuxed packets straight into a muxer on a
+//! blocking thread. The packets keep their reference-counted buffers, flags
+//! and side data, and their PTS/DTS are rescaled between the stream time
+//! bases instead of being rebuilt from microsecond chunk timestamps, so
+//! B-frame ordering survives and nothing crosses into JS.
+
+use std::sync::Arc;
+
+use napi::bindgen_prelude::*;
+
+use crate::webcodecs::mkv_muxer::MkvMuxer;
+use crate::webcodecs::mp4_muxer::Mp4Muxer;
+use crate::webcodecs::muxer_base::RemuxSink;
+use crate::webcodecs::webm_muxer::WebMMuxer;
+
+/// Muxer argument of `remuxTo()`
+///
+/// Resolved to the muxer's shared state while parsing, so the pipeline thread
+/// never touches the JS object.
+pub struct RemuxTarget(pub(crate) Arc<dyn RemuxSink>);
+
+impl FromNapiValue for RemuxTarget {
+  unsafe fn from_napi_value(
+    env: napi::sys::napi_env,
+    value: napi::sys::napi_value,
+  ) -> Result<Self> {
+    type Muxers<'env> = Either3<
+      ClassInstance<'env, Mp4Muxer>,
+      ClassInstance<'env, WebMMuxer>,
+      ClassInstance<'env, MkvMuxer>,
+    >;
+
+    match unsafe { Muxers::from_napi_value(env, value) } {
+      Ok(Either3::A(muxer)) => Ok(Self(muxer.remux_sink())),
+      Ok(Either3::B(muxer)) => Ok(Self(muxer.remux_sink())),
+      Ok(Either3::C(muxer)) => Ok(Self(muxer.remux_sink())),
+      Err(_) => {
+        let message = "muxer must be an Mp4Muxer, WebMMuxer or MkvMuxer";
+        Env::from_raw(env).throw_type_error(message, None)?;
+        Err(Error::new(Status::InvalidArg, message))
+      }
+    }
+  }
+}
@@ -0,0 +1,89 @@
+//! Process-wide threading knobs
+//!
+//! Pixel format conversion and scaling (VideoEncoder input conversion,
+//! VideoDecoder desiredWidth/desiredHeight output, VideoFrame.copyTo format
+//! conversion, ImageDecoder output) run through swscale. `setScalerThreads()`
+//! sets how many slice threads each newly created scaler splits a frame
+//! across; VideoEncoder and VideoDecoder can override it with their
+//! `scalerThreads` config member. swscale can't share a thread pool between
+//! scalers, so every threaded scaler starts its own slice threads; with an
+//! automatic count (0) their number is leased from the codec thread budget
+//! below rather than one per core per scaler.
+//!
+//! Software codecs split their work across libavcodec frame/slice threads
+//! leased from a process-wide budget (`setCodecThreadBudget()`, see
+//! `codec::thread_budget`) so many concurrent codecs don't oversubscribe
+//! the CPU.
+//!
+//! `setCodecWorkerThreads()` moves codec command processing from one thread
+//! per codec onto a shared pool (see `codec_worker`).
+
+use napi::Result;
+use napi_derive::napi;
+
+use crate::codec::{scaler, thread_budget};
+
+use super::codec_worker;
+use super::error::invalid_state_error;
+
+/// Set the number of threads each new scaler splits a conversion across.
+///
+/// 1 (the default) converts on the codec's own worker thread. Each scaler
+/// with more than one thread starts its own slice threads; 0 takes their
+/// count from the codec thread budget (`setCodecThreadBudget()`), so many
+/// concurrent scalers share the cores instead of each starting one thread
+/// per core. Scalers that already exist keep their thread count.
+#[napi]
+pub fn set_scaler_threads(threads: u32) {
+  scaler::set_default_threads(threads);
+}
+
+/// Get the number of threads new scalers split a conversion across.
+#[napi]
+pub fn get_scaler_threads() -> u32 {
+  scaler::default_threads()
+}
+
+/// Run codec commands on a shared pool of `threads` worker threads.
+///
+/// 0 (the default) gives every VideoDecoder, VideoEncoder, AudioDecoder and
+/// AudioEncoder its own worker thread. Applies to codecs constructed,
+/// configured or reset afterwards. The pool is started with the size in
+/// effect when the first pooled codec starts and keeps it for the life of the
+/// process: once it runs, asking for a different non-zero size throws
+/// InvalidStateError. Codecs with `outputBatch` keep a dedicated thread.
+#[napi]
+pub fn set_codec_worker_threads(threads: u32) -> Result<()> {
+  codec_worker::set_pool_threads(threads).map_err(|running| {
+    invalid_state_error(&format!(
+      "The codec worker pool already runs {} threads and can't be resized",
+      running
+    ))
+  })
+}
+
+/// Get the shared codec worker pool size (0 = one thread per codec).
+#[napi]
+pub fn get_codec_worker_threads() -> u32 {
+  codec_worker::pool_threads()
+}
+
+/// Set the total number of libavcodec threads shared by software codecs.
+///
+/// Each VideoDecoder, VideoEncoder and ImageDecoder configured afterwards, and
+/// each scaler created with `setScalerThreads(0)` or `scalerThreads: 0`, gets
+/// a share weighted by codec cost and resolution, and at most half the budget;
+/// realtime encoders use slice threads. Threads return to the budget when a
+/// codec is closed, reset or reconfigured, and when an ImageDecoder has
+/// decoded its last frame. Defaults to one thread per CPU core; 0 lets libavcodec pick
+/// a thread count per codec.
+#[napi]
+pub fn set_codec_thread_budget(threads: u32) {
+  thread_budget::set_total_threads(threads);
+}
+
+/// Get the total number of libavcodec threads shared by software codecs.
+#[napi]
+pub fn get_codec_thread_budget() -> u32 {
+  thread_budget::total_threads()
+}
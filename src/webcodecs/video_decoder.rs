@@ -3,20 +3,31 @@
 //! Provides video decoding functionality using FFmpeg.
 //! See: https://w3c.github.io/webcodecs/#videodecoder-interface
 
-use crate::codec::{CodecContext, DecoderConfig, Frame, Packet, download_hw_frame};
+use crate::codec::bitstream::append_avcc_as_annexb;
+use crate::codec::{
+  CodecContext, CodecStats, DecoderConfig, Frame, Packet, ScaleAlgorithm, Scaler, Stage,
+  SurfaceBudget, download_hw_frame, frame_memory, probe,
+};
 use crate::ffi::{AVCodecID, AVHWDeviceType, accessors::ffctx_set_hw_get_format};
+use crate::webcodecs::codec_pressure;
+use crate::webcodecs::codec_stats::CodecPerformanceStats;
+use crate::webcodecs::codec_worker::{self, CodecWorker, CommandSender, Handled, WorkerWaker};
+use crate::webcodecs::decode_pipeline::PipelineSlot;
 use crate::webcodecs::encoded_video_chunk::InternalSlice;
 use crate::webcodecs::error::{
   DOMExceptionName, throw_data_error, throw_invalid_state_error, throw_type_error_unit,
 };
+use crate::webcodecs::frame_memory::sync_external_memory;
+use crate::webcodecs::output_batch::{OutputBatch, OutputBatchConfig};
 use crate::webcodecs::promise_reject::{reject_with_dom_exception_async, reject_with_type_error};
+use crate::webcodecs::video_encoder::{VideoEncoder, VideoEncoderInput};
 use crate::webcodecs::video_frame::VideoColorSpaceInit;
 use crate::webcodecs::{
-  CodecState, EncodedVideoChunk, EncodedVideoChunkInner, HardwareAcceleration, VideoDecoderConfig,
-  VideoFrame, convert_avcc_extradata_to_annexb, convert_avcc_to_annexb,
+  CodecState, EncodedVideoChunk, EncodedVideoChunkInner, HardwareAcceleration, VideoDecodeMode,
+  VideoDecoderConfig, VideoFrame, convert_avcc_extradata_to_annexb, convert_avcc_to_annexb,
   convert_hvcc_extradata_to_annexb, is_avcc_extradata, is_avcc_format, is_hvcc_extradata,
 };
-use crossbeam::channel::{self, Receiver, Sender};
+use crossbeam::channel::{self, Receiver, RecvTimeoutError, Sender};
 use napi::bindgen_prelude::*;
 use napi::threadsafe_function::{
   ThreadsafeFunction, ThreadsafeFunctionCallMode, UnknownReturnValue,
@@ -26,14 +37,18 @@ use std::borrow::Cow;
 use std::collections::HashMap;
 use std::rc::Rc;
 use std::sync::atomic::{AtomicBool, Ordering};
-use std::sync::{Arc, Mutex, RwLock};
-use std::thread::JoinHandle;
+use std::sync::{Arc, Mutex, RwLock, Weak};
+use std::time::Instant;
 
 /// Type alias for output callback (takes VideoFrame)
 /// Using CalleeHandled: false for direct callbacks without error-first convention
 type OutputCallback =
   ThreadsafeFunction<VideoFrame, UnknownReturnValue, VideoFrame, Status, false, true>;
 
+/// Type alias for batched output callback (takes an array of VideoFrames)
+type BatchOutputCallback =
+  ThreadsafeFunction<Vec<VideoFrame>, UnknownReturnValue, Vec<VideoFrame>, Status, false, true>;
+
 /// Type alias for error callback (takes Error object)
 /// Using CalleeHandled: false because WebCodecs error callback receives Error directly,
 /// not error-first (err, result) style
@@ -105,8 +120,15 @@ pub struct VideoDecoderEventListenerOptions {
 
 /// Commands sent to the worker thread
 enum WorkerCommand {
-  /// Decode a video chunk
-  Decode(Arc<RwLock<Option<EncodedVideoChunkInner>>>),
+  /// Decode a video chunk (queued at the given time, for queue wait stats)
+  Decode(Arc<RwLock<Option<EncodedVideoChunkInner>>>, Instant),
+  /// Decode a chunk queued by a demuxer `decodeTo()` pipeline; the slot is
+  /// returned to the pipeline once the chunk has been processed
+  PipelineDecode(
+    Arc<RwLock<Option<EncodedVideoChunkInner>>>,
+    PipelineSlot,
+    Instant,
+  ),
   /// Flush the decoder and send result back via response channel
   Flush(Sender<Result<()>>),
   /// Reconfigure the decoder with new config (W3C spec: control message)
@@ -123,6 +145,12 @@ pub struct VideoDecoderInit {
   pub error: ErrorCallback,
   /// Error callback reference - prevents GC from collecting the error callback
   pub error_ref: FunctionRef<Error, UnknownReturnValue>,
+  /// Optional batched output callback (non-standard, opt-in)
+  pub output_batch: Option<BatchOutputCallback>,
+  /// Batched output callback reference - for synchronous delivery in the flush resolver
+  pub output_batch_ref: Option<FunctionRef<Vec<VideoFrame>, UnknownReturnValue>>,
+  /// Batch size / latency limits (only used with `output_batch`)
+  pub batch_config: OutputBatchConfig,
 }
 
 impl FromNapiValue for VideoDecoderInit {
@@ -176,11 +204,31 @@ impl FromNapiValue for VideoDecoderInit {
       .weak::<true>()
       .build()?;
 
+    // Optional batched output: one callback with an array of frames instead of one per frame
+    let output_batch_func: Option<Function<Vec<VideoFrame>, UnknownReturnValue>> =
+      obj.get("outputBatch")?;
+    let (output_batch, output_batch_ref) = match output_batch_func {
+      Some(func) => {
+        let func_ref = func.create_ref()?;
+        let tsfn: BatchOutputCallback = func
+          .build_threadsafe_function()
+          .callee_handled::<false>()
+          .weak::<true>()
+          .build()?;
+        (Some(tsfn), Some(func_ref))
+      }
+      None => (None, None),
+    };
+    let batch_config = OutputBatchConfig::from_init(&env_wrapper, &obj)?;
+
     Ok(VideoDecoderInit {
       output,
       output_ref,
       error,
       error_ref,
+      output_batch,
+      output_batch_ref,
+      batch_config,
     })
   }
 }
@@ -199,6 +247,13 @@ pub struct VideoDecoderSupport {
 /// while still detecting genuinely failing decoders within ~333ms at 30fps.
 const SILENT_FAILURE_THRESHOLD: u32 = 10;
 
+/// Most GPU-resident frames a decoder hands out with keepHardwareFrames
+///
+/// The decoder's surface pool is grown by this much; once the application
+/// holds this many unclosed frames, further frames are downloaded to CPU
+/// memory instead of starving the decoder of surfaces.
+const MAX_KEPT_HW_FRAMES: u32 = 8;
+
 /// Internal decoder state
 struct VideoDecoderInner {
   state: CodecState,
@@ -229,6 +284,21 @@ struct VideoDecoderInner {
   /// Flag indicating whether a flush operation is in progress
   /// When true, worker queues frames to pending_frames instead of calling NonBlocking callback
   inside_flush: bool,
+  /// Batched output callback (set when init provided `outputBatch`)
+  batch_output_callback: Option<BatchOutputCallback>,
+  /// Frames collected by the worker for the next batched delivery
+  output_batch: Option<OutputBatch<VideoFrame>>,
+  /// Encoders fed directly by the worker (set by `pipeTo()`); while non-empty,
+  /// decoded frames bypass the output callback
+  ///
+  /// Lock order: the worker submits to these while holding this decoder's
+  /// lock, so it takes each encoder's lock after its own. Encoders never lock
+  /// a decoder; they only wake `worker_waker` when they have room again.
+  encoder_outputs: Vec<VideoEncoderInput>,
+  /// Wakes this decoder's worker to retry a chunk deferred for a full encoder
+  worker_waker: Option<WorkerWaker>,
+  /// How long the next chunk has been held back for frame memory headroom
+  headroom_wait: frame_memory::HeadroomWait,
 
   // ========================================================================
   // Hardware acceleration tracking (for Chromium-aligned fallback behavior)
@@ -237,6 +307,8 @@ struct VideoDecoderInner {
   is_hardware: bool,
   /// Hardware acceleration preference from config
   hw_preference: HardwareAcceleration,
+  /// Whether this decoder holds a hardware decoder slot from the pressure gauge
+  acquired_hw_slot: bool,
   /// Count of consecutive decodes with no output (for silent failure detection)
   silent_decode_count: u32,
   /// Whether first output has been produced (disables silent failure detection after)
@@ -257,6 +329,76 @@ struct VideoDecoderInner {
   // ========================================================================
   /// Color space from decoder config - applied to decoded frames
   config_color_space: Option<VideoColorSpaceInit>,
+  /// Deliver hardware frames without downloading them (config.keepHardwareFrames)
+  keep_hw_frames: bool,
+  /// GPU-resident frames currently handed out, at most `MAX_KEPT_HW_FRAMES`
+  kept_hw_frames: SurfaceBudget,
+  /// Output size from config.desiredWidth/desiredHeight
+  desired_size: Option<(u32, u32)>,
+  /// Frames to decode (config.decodeMode)
+  decode_mode: VideoDecodeMode,
+  /// Slice threads for `output_scaler`: config.scalerThreads or the
+  /// process-wide default
+  scaler_threads: u32,
+  /// Scaler for the remaining resize to `desired_size`, reused while the
+  /// decoded size and format stay the same
+  output_scaler: Option<Scaler>,
+  /// Reused buffer for AVCC → Annex B rewriting on the software decode path
+  bitstream_scratch: Vec<u8>,
+  /// Performance counters, shared with the JS object and the codec context
+  stats: Arc<CodecStats>,
+}
+
+/// Check config.desiredWidth/desiredHeight, returning the TypeError message
+fn validate_desired_size(config: &VideoDecoderConfig) -> Option<&'static str> {
+  match (config.desired_width, config.desired_height) {
+    (Some(0), _) => Some("desiredWidth must be greater than 0"),
+    (_, Some(0)) => Some("desiredHeight must be greater than 0"),
+    (Some(_), None) | (None, Some(_)) => {
+      Some("Both desiredWidth and desiredHeight must be specified, or neither")
+    }
+    _ => None,
+  }
+}
+
+/// Reduced-resolution decode factor for config.desiredWidth/desiredHeight
+///
+/// Needs the coded size up front; hardware decoders always decode at full size.
+fn desired_lowres(config: &VideoDecoderConfig, is_hardware: bool) -> u8 {
+  if is_hardware {
+    return 0;
+  }
+  let coded = config.coded_width.zip(config.coded_height);
+  let desired = config.desired_width.zip(config.desired_height);
+  coded
+    .zip(desired)
+    .map(|(coded, desired)| DecoderConfig::lowres_for_size(coded, desired))
+    .unwrap_or(0)
+}
+
+/// Decoder discard settings for config.decodeMode
+fn apply_decode_mode(decoder_config: &mut DecoderConfig, mode: VideoDecodeMode) {
+  use crate::ffi::accessors::discard;
+  match mode {
+    VideoDecodeMode::All => {}
+    VideoDecodeMode::NonReference => decoder_config.skip_frame = discard::NONREF,
+    VideoDecodeMode::Keyframes => decoder_config.skip_frame = discard::NONKEY,
+    VideoDecodeMode::Fast => {
+      decoder_config.skip_loop_filter = discard::ALL;
+      decoder_config.fast = true;
+    }
+  }
+}
+
+/// Whether a decode mode lets the decoder skip chunks without output
+///
+/// Output timestamps are then taken from the decoded frame's PTS instead of
+/// being matched to inputs in order.
+fn skips_outputs(mode: VideoDecodeMode) -> bool {
+  matches!(
+    mode,
+    VideoDecodeMode::NonReference | VideoDecodeMode::Keyframes
+  )
 }
 
 /// Get the preferred hardware device type for the current platform
@@ -310,16 +452,20 @@ pub struct VideoDecoder {
   /// Wrapped in Rc to allow sharing with spawn_future_with_callback closure
   /// (Rc is !Send but that's OK - the callback runs on the main thread)
   output_callback_ref: Rc<FunctionRef<VideoFrame, UnknownReturnValue>>,
+  /// Batched output callback reference - used instead of output_callback_ref in batched mode
+  output_batch_ref: Option<Rc<FunctionRef<Vec<VideoFrame>, UnknownReturnValue>>>,
   /// Error callback reference - prevents GC from collecting the error callback
   /// (weak ThreadsafeFunction alone can be collected on slow platforms like armv7 QEMU)
   #[allow(dead_code)]
   error_callback_ref: Rc<FunctionRef<Error, UnknownReturnValue>>,
   /// Channel sender for worker commands (wrapped in Arc for Weak references in microtasks)
-  command_sender: Option<Arc<Sender<WorkerCommand>>>,
-  /// Worker thread handle
-  worker_handle: Option<JoinHandle<()>>,
+  command_sender: Option<Arc<CommandSender<WorkerCommand>>>,
+  /// Command worker (dedicated thread or shared pool)
+  worker_handle: Option<CodecWorker>,
   /// Reset abort flag - set by reset() to signal worker to skip pending decodes
   reset_flag: Arc<AtomicBool>,
+  /// Performance counters (read by getStats() without the inner lock)
+  stats: Arc<CodecStats>,
 }
 
 impl Drop for VideoDecoder {
@@ -328,8 +474,8 @@ impl Drop for VideoDecoder {
     self.command_sender = None;
 
     // Wait for worker to finish (brief block, necessary for safety)
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     // Drain decoder to ensure libaom/AV1 threads finish before context drops.
@@ -343,6 +489,86 @@ impl Drop for VideoDecoder {
       let _ = ctx.send_packet(None);
       while ctx.receive_frame().ok().flatten().is_some() {}
     }
+
+    // Release the hardware decoder slot if we acquired one
+    if let Ok(mut inner) = self.inner.lock() {
+      Self::release_hw_slot(&mut inner);
+    }
+  }
+}
+
+/// Worker input used by the demuxers' native `decodeTo()` pipeline
+///
+/// Queues demuxed chunks directly on the worker channel, applying the same
+/// state and keyframe checks as `decode()` but reporting failures as errors
+/// for the pipeline instead of throwing.
+pub(crate) struct VideoDecoderInput {
+  inner: Arc<Mutex<VideoDecoderInner>>,
+  /// Weak so a pipeline never keeps a closed/reset worker channel alive
+  sender: Weak<CommandSender<WorkerCommand>>,
+  reset_flag: Arc<AtomicBool>,
+}
+
+impl VideoDecoderInput {
+  /// Queue a chunk for decoding; `slot` is released once the worker is done with it
+  pub(crate) fn submit(&self, chunk: EncodedVideoChunk, slot: PipelineSlot) -> Result<()> {
+    let Some(sender) = self.sender.upgrade() else {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "InvalidStateError: Decoder was reset or closed",
+      ));
+    };
+    if self.reset_flag.load(Ordering::SeqCst) {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "AbortError: The operation was aborted",
+      ));
+    }
+
+    {
+      let mut inner = self
+        .inner
+        .lock()
+        .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+      if inner.state != CodecState::Configured {
+        return Err(Error::new(
+          Status::GenericFailure,
+          "InvalidStateError: Cannot decode with an unconfigured codec",
+        ));
+      }
+      if !inner.keyframe_received {
+        if !chunk.is_key() {
+          return Err(Error::new(
+            Status::GenericFailure,
+            "DataError: First chunk must be a keyframe",
+          ));
+        }
+        inner.keyframe_received = true;
+      }
+      inner.decode_queue_size += 1;
+    }
+
+    let _ = sender.send(WorkerCommand::PipelineDecode(
+      chunk.inner,
+      slot,
+      Instant::now(),
+    ));
+    Ok(())
+  }
+}
+
+impl VideoDecoder {
+  /// Get a worker input for a demuxer `decodeTo()` pipeline
+  pub(crate) fn pipeline_input(&self) -> Result<VideoDecoderInput> {
+    let sender = self
+      .command_sender
+      .as_ref()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Decoder has been closed"))?;
+    Ok(VideoDecoderInput {
+      inner: self.inner.clone(),
+      sender: Arc::downgrade(sender),
+      reset_flag: self.reset_flag.clone(),
+    })
   }
 }
 
@@ -353,9 +579,16 @@ impl VideoDecoder {
   /// @param init - Init dictionary containing output and error callbacks
   #[napi(constructor)]
   pub fn new(
-    #[napi(ts_arg_type = "{ output: (frame: VideoFrame) => void, error: (error: Error) => void }")]
+    #[napi(
+      ts_arg_type = "{ output: (frame: VideoFrame) => void, error: (error: Error) => void, outputBatch?: (frames: VideoFrame[]) => void, maxBatchSize?: number, maxBatchLatency?: number }"
+    )]
     init: VideoDecoderInit,
   ) -> Result<Self> {
+    let output_batch = init
+      .output_batch
+      .is_some()
+      .then(|| OutputBatch::new(init.batch_config));
+    let stats = Arc::new(CodecStats::new("VideoDecoder"));
     let inner = VideoDecoderInner {
       state: CodecState::Unconfigured,
       config: None,
@@ -372,9 +605,15 @@ impl VideoDecoder {
       flush_abort_flag: None,
       pending_frames: Vec::new(),
       inside_flush: false,
+      batch_output_callback: init.output_batch,
+      output_batch,
+      encoder_outputs: Vec::new(),
+      worker_waker: None,
+      headroom_wait: Default::default(),
       // Hardware acceleration tracking (Chromium-aligned)
       is_hardware: false,
       hw_preference: HardwareAcceleration::NoPreference,
+      acquired_hw_slot: false,
       silent_decode_count: 0,
       first_output_produced: false,
       pending_chunks: Vec::new(),
@@ -383,6 +622,14 @@ impl VideoDecoder {
       config_flip: false,
       // Color space from config (None = extract from FFmpeg frame)
       config_color_space: None,
+      keep_hw_frames: false,
+      kept_hw_frames: SurfaceBudget::default(),
+      desired_size: None,
+      decode_mode: VideoDecodeMode::All,
+      scaler_threads: 1,
+      output_scaler: None,
+      bitstream_scratch: Vec::new(),
+      stats: stats.clone(),
     };
 
     let inner = Arc::new(Mutex::new(inner));
@@ -390,37 +637,55 @@ impl VideoDecoder {
     // Create separate lock for event listener state (avoids contention with decode operations)
     let event_state = Arc::new(RwLock::new(EventListenerState::default()));
 
-    // Create channel for worker commands
-    let (sender, receiver) = channel::unbounded();
-
     // Create reset abort flag
     let reset_flag = Arc::new(AtomicBool::new(false));
 
-    // Spawn worker thread
-    let worker_inner = inner.clone();
-    let worker_event_state = event_state.clone();
-    let worker_reset_flag = reset_flag.clone();
-    let worker_handle = std::thread::spawn(move || {
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    });
+    // Start the command worker
+    let (sender, worker_handle) = Self::spawn_worker(&inner, &event_state, &reset_flag);
 
     Ok(Self {
       inner,
       event_state,
       dequeue_callback: None,
       output_callback_ref: Rc::new(init.output_ref),
+      output_batch_ref: init.output_batch_ref.map(Rc::new),
       error_callback_ref: Rc::new(init.error_ref),
       command_sender: Some(Arc::new(sender)),
       worker_handle: Some(worker_handle),
       reset_flag,
+      stats,
     })
   }
 
+  /// Start a worker that processes commands in order
+  ///
+  /// Batched output needs the worker to wake up when a batch's latency bound
+  /// expires, so batched codecs keep a dedicated thread; the others may run
+  /// on the shared pool.
+  fn spawn_worker(
+    inner: &Arc<Mutex<VideoDecoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &Arc<AtomicBool>,
+  ) -> (CommandSender<WorkerCommand>, CodecWorker) {
+    let batched = inner.lock().is_ok_and(|guard| guard.output_batch.is_some());
+    let worker_inner = inner.clone();
+    let event_state = event_state.clone();
+    let reset_flag = reset_flag.clone();
+    let (sender, worker) = if batched {
+      codec_worker::spawn_thread(move |receiver| {
+        Self::worker_loop(worker_inner, event_state, receiver, reset_flag)
+      })
+    } else {
+      codec_worker::spawn_deferrable(move |command| {
+        Self::handle_command(&worker_inner, &event_state, &reset_flag, command)
+      })
+    };
+    if let Ok(mut guard) = inner.lock() {
+      guard.worker_waker = sender.waker();
+    }
+    (sender, worker)
+  }
+
   /// Worker loop that processes commands from the channel
   fn worker_loop(
     inner: Arc<Mutex<VideoDecoderInner>>,
@@ -428,41 +693,202 @@ impl VideoDecoder {
     receiver: Receiver<WorkerCommand>,
     reset_flag: Arc<AtomicBool>,
   ) {
-    while let Ok(command) = receiver.recv() {
-      // Check reset flag before processing each command
-      // If reset() was called, skip remaining decode commands
-      if reset_flag.load(Ordering::SeqCst) {
-        // Still process flush commands to send responses, but skip decodes
-        if let WorkerCommand::Flush(response_sender) = command {
-          let _ = response_sender.send(Err(Error::new(
-            Status::GenericFailure,
-            "AbortError: The operation was aborted",
-          )));
-        } else {
-          // For decode commands, just decrement queue and fire dequeue
-          if let Ok(mut guard) = inner.lock() {
-            let old_size = guard.decode_queue_size;
-            guard.decode_queue_size = old_size.saturating_sub(1);
-            if old_size > 0 {
-              let _ = Self::fire_dequeue_event(&event_state);
-            }
+    while let Some(mut command) = Self::next_command(&inner, &receiver) {
+      while let Handled::Deferred(deferred) =
+        Self::handle_command(&inner, &event_state, &reset_flag, command)
+      {
+        codec_worker::wait_to_retry();
+        command = deferred;
+      }
+    }
+  }
+
+  /// Whether a decode must wait for room in a piped encoder
+  ///
+  /// A decoded chunk can't be put back, so room is checked before decoding;
+  /// a chunk that decodes to several frames may overshoot the limit slightly.
+  /// A full encoder wakes this worker once it has taken a frame.
+  fn must_defer_decode(inner: &Mutex<VideoDecoderInner>) -> bool {
+    let Ok(guard) = inner.lock() else {
+      return false;
+    };
+    if guard.state != CodecState::Configured {
+      return false;
+    }
+    let waker = guard.worker_waker.as_ref();
+    guard
+      .encoder_outputs
+      .iter()
+      .any(|encoder| !encoder.has_room(waker))
+  }
+
+  /// Whether a decode must wait for frame memory to be released
+  ///
+  /// Above the soft budget each chunk is held back for a bounded time so the
+  /// decoder doesn't run ahead of a consumer that isn't closing frames.
+  fn must_wait_for_headroom(inner: &Mutex<VideoDecoderInner>) -> bool {
+    inner.lock().is_ok_and(|mut guard| {
+      guard.state == CodecState::Configured && guard.headroom_wait.should_defer()
+    })
+  }
+
+  /// Process one command on the worker
+  fn handle_command(
+    inner: &Arc<Mutex<VideoDecoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &AtomicBool,
+    command: WorkerCommand,
+  ) -> Handled<WorkerCommand> {
+    // Check reset flag before processing each command
+    // If reset() was called, skip remaining decode commands
+    if reset_flag.load(Ordering::SeqCst) {
+      // Still process flush commands to send responses, but skip decodes
+      if let WorkerCommand::Flush(response_sender) = command {
+        let _ = response_sender.send(Err(Error::new(
+          Status::GenericFailure,
+          "AbortError: The operation was aborted",
+        )));
+      } else {
+        // For decode commands, just decrement queue and fire dequeue
+        if let Ok(mut guard) = inner.lock() {
+          if !matches!(command, WorkerCommand::Reconfigure(_)) {
+            guard.stats.add_dropped();
+          }
+          let old_size = guard.decode_queue_size;
+          guard.decode_queue_size = old_size.saturating_sub(1);
+          if old_size > 0 {
+            let _ = Self::fire_dequeue_event(event_state);
           }
         }
-        continue;
       }
+      return Handled::Done;
+    }
+
+    if matches!(
+      command,
+      WorkerCommand::Decode(..) | WorkerCommand::PipelineDecode(..)
+    ) && (Self::must_defer_decode(inner) || Self::must_wait_for_headroom(inner))
+    {
+      return Handled::Deferred(command);
+    }
+
+    match command {
+      WorkerCommand::Decode(chunk, queued_at) => {
+        Self::process_decode(inner, event_state, chunk, queued_at);
+      }
+      WorkerCommand::PipelineDecode(chunk, _slot, queued_at) => {
+        Self::process_decode(inner, event_state, chunk, queued_at);
+      }
+      WorkerCommand::Flush(response_sender) => {
+        let result = Self::process_flush(inner, event_state);
+        let _ = response_sender.send(result);
+      }
+      WorkerCommand::Reconfigure(config) => {
+        Self::process_reconfigure(inner, config);
+      }
+    }
+    Handled::Done
+  }
 
-      match command {
-        WorkerCommand::Decode(chunk) => {
-          Self::process_decode(&inner, &event_state, chunk);
-        }
-        WorkerCommand::Flush(response_sender) => {
-          let result = Self::process_flush(&inner, &event_state);
-          let _ = response_sender.send(result);
-        }
-        WorkerCommand::Reconfigure(config) => {
-          Self::process_reconfigure(&inner, config);
+  /// Wait for the next worker command
+  ///
+  /// In batched mode the open output batch is delivered once its latency bound
+  /// expires, whether or not further commands arrive in the meantime.
+  fn next_command(
+    inner: &Arc<Mutex<VideoDecoderInner>>,
+    receiver: &Receiver<WorkerCommand>,
+  ) -> Option<WorkerCommand> {
+    loop {
+      let deadline = match inner.lock() {
+        Ok(mut guard) => {
+          let deadline = guard.output_batch.as_ref().and_then(|b| b.deadline());
+          if deadline.is_some_and(|d| d <= Instant::now()) {
+            Self::deliver_output_batch(&mut guard);
+            None
+          } else {
+            deadline
+          }
         }
+        Err(_) => None,
+      };
+
+      let Some(deadline) = deadline else {
+        return receiver.recv().ok();
+      };
+      match receiver.recv_deadline(deadline) {
+        Ok(command) => return Some(command),
+        Err(RecvTimeoutError::Timeout) => continue,
+        Err(RecvTimeoutError::Disconnected) => return None,
+      }
+    }
+  }
+
+  /// Deliver a decoded frame produced on the worker thread
+  ///
+  /// When piped to encoders (`pipeTo()`), frames go straight to their workers.
+  /// During flush, frames are queued for synchronous delivery in the resolver.
+  /// In batched mode they join the open batch; otherwise they are sent with a
+  /// NonBlocking callback.
+  fn deliver_output(inner: &mut VideoDecoderInner, video_frame: VideoFrame) {
+    inner.stats.add_output();
+    if !inner.encoder_outputs.is_empty() {
+      // Transcode graph: every encoder shares the decoded frame; encoders that
+      // were reset or closed stop being fed
+      inner
+        .encoder_outputs
+        .retain(|encoder| encoder.submit(&video_frame).is_ok());
+      return;
+    }
+    if inner.inside_flush {
+      // Keep frames batched before the flush ahead of frames produced by it
+      Self::deliver_output_batch(inner);
+      inner.pending_frames.push(video_frame);
+    } else if let Some(batch) = inner.output_batch.as_mut() {
+      if batch.push(video_frame) {
+        Self::deliver_output_batch(inner);
       }
+    } else {
+      let stats = inner.stats.clone();
+      let queued_at = Instant::now();
+      inner.output_callback.call_with_return_value(
+        video_frame,
+        ThreadsafeFunctionCallMode::NonBlocking,
+        move |ret: Result<UnknownReturnValue>, env: Env| {
+          stats.record_since(Stage::Callback, queued_at);
+          // Decoded frames count as V8 external memory
+          sync_external_memory(&env)?;
+          // Rethrow what the output callback threw
+          ret.map(|_| ())
+        },
+      );
+    }
+  }
+
+  /// Deliver the open output batch (if any) as a single callback
+  fn deliver_output_batch(inner: &mut VideoDecoderInner) {
+    let Some(batch) = inner.output_batch.as_mut() else {
+      return;
+    };
+    if batch.is_empty() {
+      return;
+    }
+    let frames = batch.take();
+    if inner.inside_flush {
+      inner.pending_frames.extend(frames);
+    } else if let Some(callback) = inner.batch_output_callback.as_ref() {
+      let stats = inner.stats.clone();
+      let queued_at = Instant::now();
+      callback.call_with_return_value(
+        frames,
+        ThreadsafeFunctionCallMode::NonBlocking,
+        move |ret: Result<UnknownReturnValue>, env: Env| {
+          stats.record_since(Stage::Callback, queued_at);
+          // Decoded frames count as V8 external memory
+          sync_external_memory(&env)?;
+          // Rethrow what the output callback threw
+          ret.map(|_| ())
+        },
+      );
     }
   }
 
@@ -475,14 +901,17 @@ impl VideoDecoder {
     inner: &Arc<Mutex<VideoDecoderInner>>,
     event_state: &Arc<RwLock<EventListenerState>>,
     chunk: Arc<RwLock<Option<EncodedVideoChunkInner>>>,
+    queued_at: Instant,
   ) {
     let mut guard = match inner.lock() {
       Ok(g) => g,
       Err(_) => return, // Lock poisoned
     };
+    guard.stats.record_since(Stage::QueueWait, queued_at);
 
     // Check if decoder is still configured
     if guard.state != CodecState::Configured {
+      guard.stats.add_dropped();
       let old_size = guard.decode_queue_size;
       guard.decode_queue_size = old_size.saturating_sub(1);
       if old_size > 0 {
@@ -519,10 +948,24 @@ impl VideoDecoder {
     let duration = encoded_chunk.duration_us;
     let is_keyframe = encoded_chunk.chunk_type == crate::webcodecs::EncodedVideoChunkType::Key;
 
+    // Keyframe-only decode: delta chunks never reach the decoder
+    if guard.decode_mode == VideoDecodeMode::Keyframes && !is_keyframe {
+      guard.stats.add_dropped();
+      let old_size = guard.decode_queue_size;
+      guard.decode_queue_size = old_size.saturating_sub(1);
+      if old_size > 0 {
+        let _ = Self::fire_dequeue_event(event_state);
+      }
+      return;
+    }
+    guard.stats.add_input();
+
     // Handle packet data format based on decoder type:
     // - Hardware decoders (VideoToolbox, etc.) expect AVCC/HVCC format (length-prefixed NALUs)
-    // - Software decoders expect Annex B format (start code prefixed NALUs)
-    let data = {
+    // - Software decoders expect Annex B format (start code prefixed NALUs), rewritten
+    //   into a scratch buffer that is reused across chunks
+    let mut scratch = std::mem::take(&mut guard.bitstream_scratch);
+    let data: &[u8] = {
       let codec = &guard.codec_string;
       let is_avc_codec = codec.starts_with("avc1")
         || codec.starts_with("avc3")
@@ -532,10 +975,9 @@ impl VideoDecoder {
       // For hardware decoding, keep data in original AVCC/HVCC format
       // VideoToolbox expects length-prefixed NALUs directly
       if guard.is_hardware {
-        Cow::Borrowed(encoded_chunk.data.as_slice())
+        encoded_chunk.data.as_slice()
       } else if is_avc_codec && is_avcc_format(encoded_chunk.data.as_slice()) {
-        // For software decoding, convert to Annex B format
-        let mut converted = convert_avcc_to_annexb(encoded_chunk.data.as_slice());
+        scratch.clear();
 
         // Prepend SPS/PPS/VPS from extradata to keyframes
         // This is needed because FFmpeg may not properly use extradata for H.264/H.265
@@ -544,20 +986,23 @@ impl VideoDecoder {
           && let Some(extradata) = &config.extradata
         {
           // Extradata should already be in Annex B format (converted in configure)
-          // Prepend it to the keyframe data
-          let mut with_extradata = extradata.clone();
-          with_extradata.append(&mut converted);
-          converted = with_extradata;
+          scratch.extend_from_slice(extradata);
         }
-        Cow::Owned(converted)
+
+        // For software decoding, convert to Annex B format
+        append_avcc_as_annexb(encoded_chunk.data.as_slice(), &mut scratch);
+        &scratch
       } else {
-        Cow::Borrowed(encoded_chunk.data.as_slice())
+        encoded_chunk.data.as_slice()
       }
     };
 
     // Push timestamp to queue for correlation with output frames
-    // (FFmpeg may buffer frames internally and modify PTS)
-    guard.timestamp_queue.push_back((timestamp, duration));
+    // (FFmpeg may buffer frames internally and modify PTS). Decode modes that
+    // skip frames use the frame PTS instead, as inputs and outputs don't pair up.
+    if !skips_outputs(guard.decode_mode) {
+      guard.timestamp_queue.push_back((timestamp, duration));
+    }
 
     // Buffer chunk during silent failure detection period (for re-decoding on fallback)
     if guard.is_hardware && !guard.first_output_produced {
@@ -579,7 +1024,9 @@ impl VideoDecoder {
     };
 
     // Decode
-    let frames = match decode_chunk_data(context, &data, timestamp, duration) {
+    let result = decode_chunk_data(context, data, timestamp, duration);
+    guard.bitstream_scratch = scratch;
+    let frames = match result {
       Ok(f) => f,
       Err(e) => {
         // Handle decode error - may trigger fallback for hardware decoder
@@ -684,25 +1131,26 @@ impl VideoDecoder {
     for frame in frames {
       // Pop timestamp from queue to preserve original input timestamp
       // (FFmpeg may modify PTS internally during decoding)
-      let (output_timestamp, output_duration) = guard
-        .timestamp_queue
-        .pop_front()
-        .unwrap_or((timestamp, duration));
-
-      // Download hardware frames to CPU memory if needed
-      let output_frame = if frame.format().is_hardware() {
-        match download_hw_frame(&frame) {
-          Ok(sw_frame) => sw_frame,
-          Err(e) => {
-            Self::report_error(
-              &mut guard,
-              &format!("OperationError: Failed to download hardware frame: {}", e),
-            );
-            return;
-          }
-        }
+      let (output_timestamp, output_duration) = if skips_outputs(guard.decode_mode) {
+        let dur = (frame.duration() > 0).then(|| frame.duration());
+        (frame.pts(), dur)
       } else {
-        frame
+        guard
+          .timestamp_queue
+          .pop_front()
+          .unwrap_or((timestamp, duration))
+      };
+
+      // Download hardware frames to CPU memory and scale to desiredWidth/Height if needed
+      let output_frame = match Self::output_frame(&mut guard, frame) {
+        Ok(frame) => frame,
+        Err(e) => {
+          Self::report_error(
+            &mut guard,
+            &format!("OperationError: Failed to prepare decoded frame: {}", e),
+          );
+          return;
+        }
       };
 
       let video_frame = VideoFrame::from_internal_with_orientation(
@@ -714,15 +1162,38 @@ impl VideoDecoder {
         guard.config_color_space.as_ref(),
       );
 
-      // During flush, queue frames for synchronous delivery in resolver
-      // Otherwise, use NonBlocking callback for immediate delivery
-      if guard.inside_flush {
-        guard.pending_frames.push(video_frame);
-      } else {
-        guard
-          .output_callback
-          .call(video_frame, ThreadsafeFunctionCallMode::NonBlocking);
+      Self::deliver_output(&mut guard, video_frame);
+    }
+  }
+
+  /// Update the pressure gauge for a newly configured decoder context
+  ///
+  /// Releases the slot held by the previous context and takes one for the new
+  /// context if it is hardware-backed. Hardware decoding is only used for
+  /// prefer-hardware, which keeps using hardware when the slots are exhausted,
+  /// so a denied slot only shows up in the session stats.
+  fn track_hw_session(inner: &mut VideoDecoderInner, hw_requested: bool, is_hardware: bool) {
+    Self::release_hw_slot(inner);
+    if is_hardware {
+      inner.acquired_hw_slot = codec_pressure::gauge().try_acquire_hw_decoder();
+      if !inner.acquired_hw_slot {
+        tracing::warn!(
+          target: "webcodecs",
+          "Hardware decoder slots exhausted, using hardware anyway (prefer-hardware)"
+        );
       }
+    } else if hw_requested {
+      // Hardware was requested but FFmpeg handed back a software decoder
+      codec_pressure::gauge().record_decoder_fallback();
+      inner.stats.add_hw_fallback();
+    }
+  }
+
+  /// Release the hardware decoder slot held by this decoder, if any
+  fn release_hw_slot(inner: &mut VideoDecoderInner) {
+    if inner.acquired_hw_slot {
+      codec_pressure::gauge().release_hw_decoder();
+      inner.acquired_hw_slot = false;
     }
   }
 
@@ -766,7 +1237,13 @@ impl VideoDecoder {
       )
     })?;
 
+    // Release the hardware decoder slot since we're falling back to software
+    Self::release_hw_slot(inner);
+    codec_pressure::gauge().record_decoder_fallback();
+    inner.stats.add_hw_fallback();
+
     // Replace context and update state
+    context.set_stats(inner.stats.clone());
     inner.context = Some(context);
     inner.is_hardware = false;
     inner.silent_decode_count = 0;
@@ -839,15 +1316,11 @@ impl VideoDecoder {
 
       // Deliver frames (queue during flush, NonBlocking otherwise)
       for frame in frames {
-        // Download hardware frames to CPU memory if needed
+        // Download hardware frames to CPU memory and scale to desiredWidth/Height if needed
         // (shouldn't happen in fallback path but handle for safety)
-        let output_frame = if frame.format().is_hardware() {
-          match download_hw_frame(&frame) {
-            Ok(sw_frame) => sw_frame,
-            Err(_) => continue, // Skip failed frame downloads during re-decode
-          }
-        } else {
-          frame
+        let output_frame = match Self::output_frame(&mut guard, frame) {
+          Ok(frame) => frame,
+          Err(_) => continue, // Skip failed frame downloads during re-decode
         };
 
         let video_frame = VideoFrame::from_internal_with_orientation(
@@ -858,13 +1331,7 @@ impl VideoDecoder {
           guard.config_flip,
           guard.config_color_space.as_ref(),
         );
-        if guard.inside_flush {
-          guard.pending_frames.push(video_frame);
-        } else {
-          guard
-            .output_callback
-            .call(video_frame, ThreadsafeFunctionCallMode::NonBlocking);
-        }
+        Self::deliver_output(&mut guard, video_frame);
       }
     }
   }
@@ -878,6 +1345,9 @@ impl VideoDecoder {
       .lock()
       .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
 
+    // Frames still waiting in an open batch precede anything the flush produces
+    Self::deliver_output_batch(&mut guard);
+
     // W3C spec: If an error occurred during decoding, flush should reject with EncodingError.
     // This must be checked first to return the correct error type.
     if guard.had_error {
@@ -933,21 +1403,17 @@ impl VideoDecoder {
           (pts, dur)
         });
 
-      // Download hardware frames to CPU memory if needed
-      let output_frame = if frame.format().is_hardware() {
-        match download_hw_frame(&frame) {
-          Ok(sw_frame) => sw_frame,
-          Err(e) => {
-            let msg = format!("Failed to download hardware frame: {}", e);
-            Self::report_error(&mut guard, &msg);
-            return Err(Error::new(
-              Status::GenericFailure,
-              format!("EncodingError: {}", msg),
-            ));
-          }
+      // Download hardware frames to CPU memory and scale to desiredWidth/Height if needed
+      let output_frame = match Self::output_frame(&mut guard, frame) {
+        Ok(frame) => frame,
+        Err(e) => {
+          let msg = format!("Failed to prepare decoded frame: {}", e);
+          Self::report_error(&mut guard, &msg);
+          return Err(Error::new(
+            Status::GenericFailure,
+            format!("EncodingError: {}", msg),
+          ));
         }
-      } else {
-        frame
       };
 
       let video_frame = VideoFrame::from_internal_with_orientation(
@@ -1085,17 +1551,25 @@ impl VideoDecoder {
     // Configure decoder
     // For hardware decoders, use single-threaded mode (thread_count=1) to avoid
     // race conditions during flush that can cause crashes with VideoToolbox and other
-    // hardware accelerators. For software decoders, use auto-detect (thread_count=0)
-    // for optimal performance.
+    // hardware accelerators. Software decoders (thread_count=0) take their share
+    // of the process-wide codec thread budget.
     let thread_count = if is_hardware { 1 } else { 0 };
-    let decoder_config = DecoderConfig {
+    let mut decoder_config = DecoderConfig {
       codec_id,
       thread_count,
       extradata,
       low_latency: config.optimize_for_latency.unwrap_or(false),
       width: config.coded_width,
       height: config.coded_height,
+      lowres: desired_lowres(&config, is_hardware),
+      extra_hw_frames: if is_hardware && config.keep_hardware_frames.unwrap_or(false) {
+        MAX_KEPT_HW_FRAMES
+      } else {
+        0
+      },
+      ..Default::default()
     };
+    apply_decode_mode(&mut decoder_config, config.decode_mode.unwrap_or_default());
 
     if let Err(e) = context.configure_decoder(&decoder_config) {
       Self::report_error(
@@ -1133,11 +1607,13 @@ impl VideoDecoder {
     }
 
     // Update inner state
+    context.set_stats(guard.stats.clone());
     guard.context = Some(context);
     guard.config = Some(decoder_config);
     guard.codec_string = codec;
     guard.is_hardware = is_hardware;
     guard.hw_preference = hw_preference;
+    Self::track_hw_session(&mut guard, hw_type.is_some(), is_hardware);
 
     // Store orientation from config
     guard.config_rotation = config.rotation.unwrap_or(0.0);
@@ -1145,6 +1621,75 @@ impl VideoDecoder {
 
     // Store colorSpace from config
     guard.config_color_space = config.color_space;
+    guard.keep_hw_frames = config.keep_hardware_frames.unwrap_or(false);
+    guard.desired_size = config.desired_width.zip(config.desired_height);
+    guard.decode_mode = config.decode_mode.unwrap_or_default();
+    guard.scaler_threads = config
+      .scaler_threads
+      .unwrap_or_else(crate::codec::scaler::default_threads);
+    guard.output_scaler = None;
+  }
+
+  /// Prepare a decoded frame for output as a VideoFrame
+  ///
+  /// Hardware frames are downloaded to CPU memory unless the config asked to
+  /// keep them GPU-resident (VideoFrame then downloads lazily in copyTo()).
+  /// At most `MAX_KEPT_HW_FRAMES` stay on the GPU at once; past that frames
+  /// are downloaded until the application closes some.
+  /// With desiredWidth/desiredHeight the frame is then scaled to that size;
+  /// scaling needs CPU pixels, so it takes precedence over keepHardwareFrames.
+  fn output_frame(
+    inner: &mut VideoDecoderInner,
+    mut frame: Frame,
+  ) -> crate::codec::CodecResult<Frame> {
+    let keep = frame.format().is_hardware() && inner.keep_hw_frames && inner.desired_size.is_none();
+    let lease = if keep {
+      inner.kept_hw_frames.try_lease(MAX_KEPT_HW_FRAMES)
+    } else {
+      None
+    };
+    let frame = if let Some(lease) = lease {
+      frame.hold_surface(lease);
+      frame
+    } else if frame.format().is_hardware() {
+      inner
+        .stats
+        .time(Stage::HwDownload, || download_hw_frame(&frame))?
+    } else {
+      frame
+    };
+
+    let Some((width, height)) = inner.desired_size else {
+      return Ok(frame);
+    };
+    if (frame.width(), frame.height()) == (width, height) {
+      return Ok(frame);
+    }
+
+    let reusable = inner.output_scaler.as_ref().is_some_and(|scaler| {
+      scaler.src_width() == frame.width()
+        && scaler.src_height() == frame.height()
+        && scaler.src_format() == frame.format()
+    });
+    if !reusable {
+      inner.output_scaler = Some(Scaler::with_threads(
+        frame.width(),
+        frame.height(),
+        frame.format(),
+        width,
+        height,
+        frame.format(),
+        ScaleAlgorithm::Bilinear,
+        inner.scaler_threads,
+      )?);
+    }
+
+    let scaler = inner.output_scaler.as_ref().unwrap();
+    let mut scaled = inner
+      .stats
+      .time(Stage::Convert, || scaler.scale_alloc(&frame))?;
+    scaled.copy_props_from(&frame)?;
+    Ok(scaled)
   }
 
   /// Report an error via callback and close the decoder
@@ -1237,6 +1782,15 @@ impl VideoDecoder {
     Ok(inner.decode_queue_size)
   }
 
+  /// Get per-stage performance counters (non-standard extension)
+  ///
+  /// Reads atomic counters without waiting for the worker, so it is cheap
+  /// enough to poll for metrics export.
+  #[napi]
+  pub fn get_stats(&self) -> CodecPerformanceStats {
+    CodecPerformanceStats::from(&*self.stats)
+  }
+
   /// Set the dequeue event handler (per WebCodecs spec)
   ///
   /// The dequeue event fires when decodeQueueSize decreases,
@@ -1325,6 +1879,11 @@ impl VideoDecoder {
       return throw_type_error_unit(&env, "displayAspectHeight must be greater than 0");
     }
 
+    // Non-standard output size: both or neither, like ImageDecoder
+    if let Some(message) = validate_desired_size(&config) {
+      return throw_type_error_unit(&env, message);
+    }
+
     let mut inner = self
       .inner
       .lock()
@@ -1452,17 +2011,25 @@ impl VideoDecoder {
     // Configure decoder
     // For hardware decoders, use single-threaded mode (thread_count=1) to avoid
     // race conditions during flush that can cause crashes with VideoToolbox and other
-    // hardware accelerators. For software decoders, use auto-detect (thread_count=0)
-    // for optimal performance.
+    // hardware accelerators. Software decoders (thread_count=0) take their share
+    // of the process-wide codec thread budget.
     let thread_count = if is_hardware { 1 } else { 0 };
-    let decoder_config = DecoderConfig {
+    let mut decoder_config = DecoderConfig {
       codec_id,
       thread_count,
       extradata,
       low_latency: config.optimize_for_latency.unwrap_or(false),
       width: config.coded_width,
       height: config.coded_height,
+      lowres: desired_lowres(&config, is_hardware),
+      extra_hw_frames: if is_hardware && config.keep_hardware_frames.unwrap_or(false) {
+        MAX_KEPT_HW_FRAMES
+      } else {
+        0
+      },
+      ..Default::default()
     };
+    apply_decode_mode(&mut decoder_config, config.decode_mode.unwrap_or_default());
 
     if let Err(e) = context.configure_decoder(&decoder_config) {
       Self::report_error(&mut inner, &format!("Failed to configure decoder: {}", e));
@@ -1504,6 +2071,7 @@ impl VideoDecoder {
       );
     }
 
+    context.set_stats(inner.stats.clone());
     inner.context = Some(context);
     inner.config = Some(decoder_config);
     inner.codec_string = codec;
@@ -1515,6 +2083,7 @@ impl VideoDecoder {
     // Store hardware acceleration tracking state
     inner.is_hardware = is_hardware;
     inner.hw_preference = hw_preference;
+    Self::track_hw_session(&mut inner, hw_type.is_some(), is_hardware);
     inner.silent_decode_count = 0;
     inner.first_output_produced = false;
     inner.pending_chunks.clear();
@@ -1526,23 +2095,20 @@ impl VideoDecoder {
     // Store colorSpace from config (W3C WebCodecs spec)
     // If provided, this colorSpace will be applied to all decoded frames
     inner.config_color_space = config.color_space;
+    inner.keep_hw_frames = config.keep_hardware_frames.unwrap_or(false);
+    inner.desired_size = config.desired_width.zip(config.desired_height);
+    inner.decode_mode = config.decode_mode.unwrap_or_default();
+    inner.scaler_threads = config
+      .scaler_threads
+      .unwrap_or_else(crate::codec::scaler::default_threads);
+    inner.output_scaler = None;
 
     // Create new channel and worker if needed (after reconfiguration)
     if self.command_sender.is_none() {
-      let (sender, receiver) = channel::unbounded();
+      drop(inner); // Release lock before starting the worker
+      let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
       self.command_sender = Some(Arc::new(sender));
-      let worker_inner = self.inner.clone();
-      let worker_event_state = self.event_state.clone();
-      let worker_reset_flag = self.reset_flag.clone();
-      drop(inner); // Release lock before spawning thread
-      self.worker_handle = Some(std::thread::spawn(move || {
-        Self::worker_loop(
-          worker_inner,
-          worker_event_state,
-          receiver,
-          worker_reset_flag,
-        );
-      }));
+      self.worker_handle = Some(worker);
     }
 
     Ok(())
@@ -1592,7 +2158,7 @@ impl VideoDecoder {
         if !reset_flag.load(Ordering::SeqCst)
           && let Some(sender) = weak_sender.upgrade()
         {
-          let _ = sender.send(WorkerCommand::Decode(chunk_inner));
+          let _ = sender.send(WorkerCommand::Decode(chunk_inner, Instant::now()));
         }
         Ok(())
       })?;
@@ -1688,6 +2254,7 @@ impl VideoDecoder {
     // Clone references for the callback closure
     let inner_clone = self.inner.clone();
     let output_callback_ref = self.output_callback_ref.clone();
+    let output_batch_ref = self.output_batch_ref.clone();
 
     env.spawn_future_with_callback(
       async move {
@@ -1718,15 +2285,22 @@ impl VideoDecoder {
           std::mem::take(&mut guard.pending_frames)
         };
 
-        // Call output callback for each frame synchronously
-        // If callback calls reset(), abort_flag will be set before next iteration
-        let callback = output_callback_ref.borrow_back(env)?;
-        for frame in frames {
-          // Check abort flag before each callback - exit early if reset() was called
-          if abort_flag.load(Ordering::SeqCst) {
-            break;
+        if let Some(batch_ref) = output_batch_ref {
+          // Batched mode: deliver everything drained by the flush in one call
+          if !frames.is_empty() && !abort_flag.load(Ordering::SeqCst) {
+            batch_ref.borrow_back(env)?.call(frames)?;
+          }
+        } else {
+          // Call output callback for each frame synchronously
+          // If callback calls reset(), abort_flag will be set before next iteration
+          let callback = output_callback_ref.borrow_back(env)?;
+          for frame in frames {
+            // Check abort flag before each callback - exit early if reset() was called
+            if abort_flag.load(Ordering::SeqCst) {
+              break;
+            }
+            callback.call(frame)?;
           }
-          callback.call(frame)?;
         }
 
         // Clean up flags
@@ -1822,6 +2396,7 @@ impl VideoDecoder {
     inner.had_error = false;
 
     // Reset hardware tracking state
+    Self::release_hw_slot(&mut inner);
     inner.is_hardware = false;
     inner.hw_preference = HardwareAcceleration::NoPreference;
     inner.silent_decode_count = 0;
@@ -1832,35 +2407,68 @@ impl VideoDecoder {
     // Clear flush-related state
     inner.inside_flush = false;
     inner.pending_frames.clear();
+    if let Some(batch) = inner.output_batch.as_mut() {
+      batch.clear();
+    }
 
     // Reset the abort flag for new worker
     self.reset_flag.store(false, Ordering::SeqCst);
 
     // Create new channel and worker for future decode operations
-    let (sender, receiver) = channel::unbounded();
+    drop(inner); // Release lock before starting the worker
+    let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
     self.command_sender = Some(Arc::new(sender));
-    let worker_inner = self.inner.clone();
-    let worker_event_state = self.event_state.clone();
-    let worker_reset_flag = self.reset_flag.clone();
-
-    // Create synchronization channel to wait for worker to be ready
-    let (ready_sender, ready_receiver) = channel::bounded::<()>(1);
-
-    drop(inner); // Release lock before spawning thread
-    self.worker_handle = Some(std::thread::spawn(move || {
-      // Signal that worker is ready before entering the loop
-      let _ = ready_sender.send(());
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    }));
+    self.worker_handle = Some(worker);
+
+    Ok(())
+  }
+
+  /// Feed decoded frames directly to encoders (native transcode graph)
+  ///
+  /// Every decoded frame is shared with all `encoders` without passing through
+  /// JS; each encoder scales it to its own configured size, so one decoder can
+  /// drive a whole rendition ladder. While piped, the output callback is not
+  /// called. Replaces any previous pipe; an encoder that is later reset or
+  /// closed silently drops out.
+  ///
+  /// The decoder holds back while an encoder's queue is full: `maxQueueSize`
+  /// frames with `queueOverflow: 'throw'`, otherwise 8 (the drop policies drop
+  /// frames instead), so a slow rendition paces the whole graph.
+  ///
+  /// Flush the decoder first, then the encoders, to drain the graph.
+  #[napi]
+  pub fn pipe_to<'env>(
+    &self,
+    env: &'env Env,
+    encoders: Vec<ClassInstance<'env, VideoEncoder>>,
+  ) -> Result<()> {
+    let mut outputs = Vec::with_capacity(encoders.len());
+    for encoder in encoders.iter() {
+      if !encoder.is_configured() {
+        return throw_invalid_state_error(env, "Cannot pipe to an unconfigured encoder");
+      }
+      outputs.push(encoder.pipeline_input()?);
+    }
 
-    // Wait for worker to be ready (prevents race condition)
-    let _ = ready_receiver.recv();
+    let mut inner = self
+      .inner
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+    if inner.state == CodecState::Closed {
+      return throw_invalid_state_error(env, "Cannot pipe a closed codec");
+    }
+    inner.encoder_outputs = outputs;
+    Ok(())
+  }
 
+  /// Stop feeding encoders; decoded frames go to the output callback again
+  #[napi]
+  pub fn unpipe(&self) -> Result<()> {
+    let mut inner = self
+      .inner
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+    inner.encoder_outputs.clear();
     Ok(())
   }
 
@@ -1887,8 +2495,8 @@ impl VideoDecoder {
     // Now safe to join worker - channel is closed, worker will see recv() Err and exit.
     // This prevents resource contention where old worker is still holding FFmpeg resources
     // while new decoder is being created.
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     let mut inner = self
@@ -1909,8 +2517,13 @@ impl VideoDecoder {
     inner.codec_string.clear();
     inner.state = CodecState::Closed;
     inner.decode_queue_size = 0;
+    if let Some(batch) = inner.output_batch.as_mut() {
+      batch.clear();
+    }
+    inner.encoder_outputs.clear();
 
     // Reset hardware tracking state
+    Self::release_hw_slot(&mut inner);
     inner.is_hardware = false;
     inner.silent_decode_count = 0;
     inner.first_output_produced = false;
@@ -1963,6 +2576,10 @@ impl VideoDecoder {
       return reject_with_type_error(env, "displayAspectHeight must be greater than 0");
     }
 
+    if let Some(message) = validate_desired_size(&config) {
+      return reject_with_type_error(env, message);
+    }
+
     // Validate dimensions if specified
     let width = config.coded_width.unwrap_or(0);
     let height = config.coded_height.unwrap_or(0);
@@ -1987,11 +2604,9 @@ impl VideoDecoder {
         }
       };
 
-      // Try to create decoder
-      let result = CodecContext::new_decoder(codec_id);
-
+      // Decoder availability is probed once per codec
       Ok(VideoDecoderSupport {
-        supported: result.is_ok(),
+        supported: probe::decoder_available(codec_id),
         config,
       })
     })
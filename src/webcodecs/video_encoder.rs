@@ -4,27 +4,34 @@
 //! See: https://w3c.github.io/webcodecs/#videoencoder-interface
 
 use crate::codec::{
-  BitrateMode as CodecBitrateMode, CodecContext, EncoderConfig, EncoderCreationResult, Frame,
-  HwDeviceContext, HwFrameConfig, HwFrameContext, Packet, Scaler,
+  BitrateMode as CodecBitrateMode, CodecContext, CodecStats, EncoderConfig, EncoderCreationResult,
+  Frame, FramePool, HwDeviceContext, HwFrameConfig, HwFrameContext, Packet, Scaler, Stage,
+  download_hw_frame, probe,
 };
 use crate::ffi::{
   AVCodecID, AVHWDeviceType, AVPictureType, AVPixelFormat, AVRational, avutil::av_rescale_q,
 };
 use crate::webcodecs::codec_pressure;
+use crate::webcodecs::codec_stats::CodecPerformanceStats;
+use crate::webcodecs::codec_worker::{self, CodecWorker, CommandSender, WorkerWaker};
 use crate::webcodecs::error::DOMExceptionName;
-use crate::webcodecs::error::{throw_invalid_state_error, throw_type_error_unit};
+use crate::webcodecs::error::{
+  quota_exceeded_error, throw_error_as_dom_exception, throw_invalid_state_error,
+  throw_type_error_unit,
+};
 use crate::webcodecs::hw_fallback::{
   is_hw_encoding_disabled, record_hw_encoding_failure, record_hw_encoding_success,
 };
+use crate::webcodecs::output_batch::{OutputBatch, OutputBatchConfig};
 use crate::webcodecs::promise_reject::{reject_with_dom_exception_async, reject_with_type_error};
 use crate::webcodecs::{
-  AlphaOption, AvcBitstreamFormat, EncodedVideoChunk, HardwareAcceleration, HevcBitstreamFormat,
-  LatencyMode, VideoColorSpaceInit, VideoEncoderBitrateMode, VideoEncoderConfig, VideoFrame,
-  convert_annexb_extradata_to_avcc, convert_annexb_extradata_to_hvcc,
-  convert_obu_extradata_to_av1c, extract_avcc_from_avcc_packet, extract_hvcc_from_hvcc_packet,
-  is_av1c_extradata,
+  AlphaOption, AvcBitstreamFormat, EncodeQueueOverflow, EncodedVideoChunk, HardwareAcceleration,
+  HevcBitstreamFormat, LatencyMode, VideoColorSpaceInit, VideoEncoderBitrateMode,
+  VideoEncoderConfig, VideoFrame, convert_annexb_extradata_to_avcc,
+  convert_annexb_extradata_to_hvcc, convert_obu_extradata_to_av1c, extract_avcc_from_avcc_packet,
+  extract_hvcc_from_hvcc_packet, is_av1c_extradata,
 };
-use crossbeam::channel::{self, Receiver, Sender};
+use crossbeam::channel::{self, Receiver, RecvTimeoutError, Sender};
 use napi::bindgen_prelude::*;
 use napi::threadsafe_function::{
   ThreadsafeFunction, ThreadsafeFunctionCallMode, UnknownReturnValue,
@@ -34,8 +41,8 @@ use parking_lot::RwLock as ParkingLotRwLock;
 use std::collections::HashMap;
 use std::rc::Rc;
 use std::sync::atomic::{AtomicBool, Ordering};
-use std::sync::{Arc, Mutex, RwLock};
-use std::thread::JoinHandle;
+use std::sync::{Arc, Mutex, MutexGuard, RwLock, Weak};
+use std::time::Instant;
 
 /// Encoder state per WebCodecs spec
 #[napi(string_enum)]
@@ -147,6 +154,24 @@ pub struct VideoEncoderEncodeOptions {
   pub av1: Option<VideoEncoderEncodeOptionsForAv1>,
 }
 
+/// Conversion frame pool statistics (non-standard extension)
+#[napi(object)]
+#[derive(Debug, Clone, Default)]
+pub struct VideoEncoderFramePoolStats {
+  /// Number of converted frames currently retained for reuse
+  pub size: u32,
+  /// Maximum number of frames the pool retains
+  pub capacity: u32,
+  /// Conversions that reused a pooled frame
+  pub hits: i64,
+  /// Conversions that had to allocate a new frame
+  pub misses: i64,
+  /// hits / (hits + misses), 0 when no conversion has happened yet
+  pub hit_rate: f64,
+  /// Slice threads the input conversion runs on, 0 before the first conversion
+  pub scaler_threads: u32,
+}
+
 /// Result of isConfigSupported per WebCodecs spec
 #[napi(object)]
 #[derive(Debug, Clone)]
@@ -168,6 +193,20 @@ type OutputCallback = ThreadsafeFunction<
   true,
 >;
 
+/// Batched output callback type - receives parallel arrays of chunks and their metadata
+type BatchOutputCallback = ThreadsafeFunction<
+  FnArgs<(Vec<EncodedVideoChunk>, Vec<EncodedVideoChunkMetadata>)>,
+  UnknownReturnValue,
+  FnArgs<(Vec<EncodedVideoChunk>, Vec<EncodedVideoChunkMetadata>)>,
+  Status,
+  false,
+  true,
+>;
+
+/// FunctionRef for the batched output callback (synchronous delivery in flush resolver)
+type BatchOutputCallbackRef =
+  FunctionRef<FnArgs<(Vec<EncodedVideoChunk>, Vec<EncodedVideoChunkMetadata>)>, UnknownReturnValue>;
+
 /// Type alias for error callback (takes Error object)
 /// Using CalleeHandled: false because WebCodecs error callback receives Error directly,
 /// not error-first (err, result) style
@@ -188,11 +227,16 @@ enum EncoderCommand {
     rotation: f64,
     /// Flip from input VideoFrame (for metadata output)
     flip: bool,
+    /// When the command was queued (for queue wait stats)
+    queued_at: Instant,
   },
   /// Flush the encoder and send result back via response channel
   Flush(Sender<Result<()>>),
   /// Reconfigure the encoder with new config (W3C spec: control message)
   Reconfigure(VideoEncoderConfig),
+  /// Reconfigure that only changes the bitrate: retarget the open encoder
+  /// when it supports that, otherwise fall back to a full reconfigure
+  UpdateBitrate(VideoEncoderConfig),
 }
 
 /// VideoEncoder init dictionary per WebCodecs spec
@@ -206,6 +250,12 @@ pub struct VideoEncoderInit {
   pub error: ErrorCallback,
   /// Error callback reference - prevents GC from collecting the error callback
   pub error_ref: FunctionRef<Error, UnknownReturnValue>,
+  /// Optional batched output callback (non-standard, opt-in)
+  pub output_batch: Option<BatchOutputCallback>,
+  /// Batched output callback reference - for synchronous delivery in the flush resolver
+  pub output_batch_ref: Option<BatchOutputCallbackRef>,
+  /// Batch size / latency limits (only used with `output_batch`)
+  pub batch_config: OutputBatchConfig,
 }
 
 impl FromNapiValue for VideoEncoderInit {
@@ -261,11 +311,35 @@ impl FromNapiValue for VideoEncoderInit {
       .weak::<true>()
       .build()?;
 
+    // Optional batched output: one callback per batch instead of one per chunk
+    let output_batch_func: Option<
+      Function<
+        FnArgs<(Vec<EncodedVideoChunk>, Vec<EncodedVideoChunkMetadata>)>,
+        UnknownReturnValue,
+      >,
+    > = obj.get("outputBatch")?;
+    let (output_batch, output_batch_ref) = match output_batch_func {
+      Some(func) => {
+        let func_ref = func.create_ref()?;
+        let tsfn: BatchOutputCallback = func
+          .build_threadsafe_function()
+          .callee_handled::<false>()
+          .weak::<true>()
+          .build()?;
+        (Some(tsfn), Some(func_ref))
+      }
+      None => (None, None),
+    };
+    let batch_config = OutputBatchConfig::from_init(&env_wrapper, &obj)?;
+
     Ok(VideoEncoderInit {
       output,
       output_ref,
       error,
       error_ref,
+      output_batch,
+      output_batch_ref,
+      batch_config,
     })
   }
 }
@@ -277,6 +351,9 @@ impl FromNapiValue for VideoEncoderInit {
 /// Using 5 to be safe across different encoders and configurations.
 const SILENT_FAILURE_THRESHOLD: u32 = 5;
 
+/// Frames a `pipeTo()` decoder may queue on an encoder without `maxQueueSize`
+const PIPE_QUEUE_LIMIT: u32 = 8;
+
 /// Type alias for weak event listener callback (allows Node.js process to exit)
 type WeakEventListenerCallback =
   ThreadsafeFunction<(), UnknownReturnValue, (), Status, false, true>;
@@ -342,6 +419,9 @@ struct VideoEncoderInner {
   config: Option<VideoEncoderConfig>,
   context: Option<CodecContext>,
   scaler: Option<Scaler>,
+  /// Recycled destination frames for scaler/NV12 conversions
+  /// (avoids a full-frame allocation per converted frame)
+  frame_pool: FramePool,
   frame_count: u64,
   extradata_sent: bool,
   /// Number of pending encode operations (for encodeQueueSize)
@@ -380,6 +460,10 @@ struct VideoEncoderInner {
   /// Flag indicating whether a flush operation is in progress
   /// When true, worker queues chunks to pending_chunks instead of calling NonBlocking callback
   inside_flush: bool,
+  /// Batched output callback (set when init provided `outputBatch`)
+  batch_output_callback: Option<BatchOutputCallback>,
+  /// Chunks collected by the worker for the next batched delivery
+  output_batch: Option<OutputBatch<(EncodedVideoChunk, EncodedVideoChunkMetadata)>>,
 
   // ========================================================================
   // Hardware frame context for zero-copy GPU encoding
@@ -440,6 +524,52 @@ struct VideoEncoderInner {
   /// Whether we acquired a hardware encoder slot from the pressure gauge
   /// Must be released on close/drop/fallback to avoid resource leaks
   acquired_hw_slot: bool,
+
+  // ========================================================================
+  // Realtime queue policy (maxQueueSize / queueOverflow)
+  // ========================================================================
+  /// Frames dropped by the queue policy since construction
+  dropped_frames: u64,
+  /// A dropped frame had requested a keyframe; force it on the next frame
+  pending_key_frame: bool,
+  /// Piped decoders waiting for room in the queue (see `VideoEncoderInput::has_room`)
+  producer_wakers: Vec<WorkerWaker>,
+  /// Performance counters, shared with the JS object and the codec context
+  stats: Arc<CodecStats>,
+}
+
+impl VideoEncoderInner {
+  /// Slice threads for input conversion: `scalerThreads` or the process-wide default
+  fn scaler_threads(&self) -> u32 {
+    self
+      .config
+      .as_ref()
+      .and_then(|config| config.scaler_threads)
+      .unwrap_or_else(crate::codec::scaler::default_threads)
+  }
+
+  /// `maxQueueSize` and its overflow policy, if the queue is bounded
+  fn queue_limit(&self) -> Option<(u32, EncodeQueueOverflow)> {
+    let config = self.config.as_ref()?;
+    let max = config.max_queue_size?;
+    Some((max, config.queue_overflow.unwrap_or_default()))
+  }
+
+  /// Whether a GPU-resident input frame can be encoded without leaving the GPU
+  ///
+  /// Requires a hardware encoder using GPU frames on the frame's device, with
+  /// matching size and software format. Until the hardware encoder has
+  /// produced output, frames take the CPU path so they can be re-encoded in
+  /// software if the hardware encoder turns out not to work.
+  fn accepts_hw_frame(&self, frame: &Frame) -> bool {
+    self.is_hardware
+      && self.first_output_produced
+      && self.use_hw_frames
+      && self
+        .hw_frame_ctx
+        .as_ref()
+        .is_some_and(|frames| frames.accepts(frame))
+  }
 }
 
 /// Get default GOP settings based on latency mode.
@@ -529,16 +659,20 @@ pub struct VideoEncoder {
   /// (Rc is !Send but that's OK - the callback runs on the main thread)
   output_callback_ref:
     Rc<FunctionRef<FnArgs<(EncodedVideoChunk, EncodedVideoChunkMetadata)>, UnknownReturnValue>>,
+  /// Batched output callback reference - used instead of output_callback_ref in batched mode
+  output_batch_ref: Option<Rc<BatchOutputCallbackRef>>,
   /// Error callback reference - prevents GC from collecting the error callback
   /// (weak ThreadsafeFunction alone can be collected on slow platforms like armv7 QEMU)
   #[allow(dead_code)]
   error_callback_ref: Rc<FunctionRef<Error, UnknownReturnValue>>,
   /// Channel sender for worker commands (wrapped in Arc for Weak references in microtasks)
-  command_sender: Option<Arc<Sender<EncoderCommand>>>,
-  /// Worker thread handle
-  worker_handle: Option<JoinHandle<()>>,
+  command_sender: Option<Arc<CommandSender<EncoderCommand>>>,
+  /// Command worker (dedicated thread or shared pool)
+  worker_handle: Option<CodecWorker>,
   /// Reset abort flag - set by reset() to signal worker to skip pending encodes
   reset_flag: Arc<AtomicBool>,
+  /// Performance counters (read by getStats() without the inner lock)
+  stats: Arc<CodecStats>,
 }
 
 impl Drop for VideoEncoder {
@@ -547,8 +681,8 @@ impl Drop for VideoEncoder {
     self.command_sender = None;
 
     // Wait for worker to finish (brief block, necessary for safety)
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     // Drain encoder to ensure libaom/AV1 threads finish before context drops.
@@ -571,6 +705,171 @@ impl Drop for VideoEncoder {
   }
 }
 
+/// Encoder input used by a VideoDecoder `pipeTo()` transcode graph
+///
+/// Queues decoded frames directly on the worker channel, sharing the frame's
+/// `Arc<RwLock<Frame>>` with every other piped encoder. Each encoder scales to
+/// its own configured resolution in `process_encode`.
+///
+/// The decoder worker calls in while holding its own lock, so this takes the
+/// encoder lock second; nothing on the encoder side may lock a decoder.
+pub(crate) struct VideoEncoderInput {
+  inner: Arc<Mutex<VideoEncoderInner>>,
+  event_state: Arc<RwLock<EventListenerState>>,
+  /// Weak so a decoder never keeps a closed/reset worker channel alive
+  sender: Weak<CommandSender<EncoderCommand>>,
+  reset_flag: Arc<AtomicBool>,
+}
+
+impl VideoEncoderInput {
+  /// Whether the queue has room for another piped frame
+  ///
+  /// The limit is `maxQueueSize` under the `throw` policy and
+  /// `PIPE_QUEUE_LIMIT` when the queue is unbounded; the drop policies always
+  /// accept and drop frames themselves. When full, `waker` is woken once the
+  /// worker has taken a frame. An encoder that stopped accepting frames has
+  /// room: `submit()` fails and the decoder stops feeding it.
+  pub(crate) fn has_room(&self, waker: Option<&WorkerWaker>) -> bool {
+    let Ok(mut inner) = self.inner.lock() else {
+      return true;
+    };
+    if inner.state != CodecState::Configured {
+      return true;
+    }
+    let limit = match inner.queue_limit() {
+      Some((max, EncodeQueueOverflow::Throw)) => max,
+      Some(_) => return true,
+      None => PIPE_QUEUE_LIMIT,
+    };
+    if inner.encode_queue_size < limit {
+      return true;
+    }
+    if let Some(waker) = waker
+      && !inner.producer_wakers.iter().any(|w| w.same_worker(waker))
+    {
+      inner.producer_wakers.push(waker.clone());
+    }
+    false
+  }
+
+  /// Queue a frame for encoding
+  ///
+  /// Fails once the encoder has been reset, reconfigured away or closed; the
+  /// caller is expected to stop feeding it.
+  pub(crate) fn submit(&self, frame: &VideoFrame) -> Result<()> {
+    let Some(sender) = self.sender.upgrade() else {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "InvalidStateError: Encoder was reset or closed",
+      ));
+    };
+    if self.reset_flag.load(Ordering::SeqCst) {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "AbortError: The operation was aborted",
+      ));
+    }
+
+    let frame_arc = frame.frame_arc()?;
+    let timestamp = frame.timestamp()?;
+    let rotation = frame.rotation().unwrap_or(0.0);
+    let flip = frame.flip().unwrap_or(false);
+
+    {
+      let inner = self
+        .inner
+        .lock()
+        .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+      if inner.state != CodecState::Configured {
+        return Err(Error::new(
+          Status::GenericFailure,
+          "InvalidStateError: Cannot encode with an unconfigured codec",
+        ));
+      }
+      // A dropped frame is not an error
+      let Some(mut inner) = VideoEncoder::admit_frame(inner, &self.event_state, false, true)?
+      else {
+        return Ok(());
+      };
+      if inner.input_color_space.is_none()
+        && let Ok(color_space) = frame.color_space()
+      {
+        inner.input_color_space = Some(color_space.to_init());
+      }
+      inner.encode_queue_size += 1;
+    }
+
+    let _ = sender.send(EncoderCommand::Encode {
+      frame: frame_arc,
+      timestamp,
+      options: None,
+      rotation,
+      flip,
+      queued_at: Instant::now(),
+    });
+    Ok(())
+  }
+}
+
+impl VideoEncoder {
+  /// Get an input for a VideoDecoder `pipeTo()` transcode graph
+  pub(crate) fn pipeline_input(&self) -> Result<VideoEncoderInput> {
+    let sender = self
+      .command_sender
+      .as_ref()
+      .ok_or_else(|| Error::new(Status::GenericFailure, "Encoder has been closed"))?;
+    Ok(VideoEncoderInput {
+      inner: self.inner.clone(),
+      event_state: self.event_state.clone(),
+      sender: Arc::downgrade(sender),
+      reset_flag: self.reset_flag.clone(),
+    })
+  }
+
+  /// Whether the encoder is configured (accepts frames)
+  pub(crate) fn is_configured(&self) -> bool {
+    self
+      .inner
+      .lock()
+      .is_ok_and(|inner| inner.state == CodecState::Configured)
+  }
+
+  /// Apply the `queueOverflow` policy to a frame about to be queued
+  ///
+  /// Returns the guard, or `None` if the frame must not be queued.
+  /// `drop-newest-delta` drops the frame here unless it requests a keyframe.
+  /// `throw` fails with QuotaExceededError while `maxQueueSize` frames are
+  /// queued; nothing waits here, since encode() runs on the JS thread and
+  /// piped frames on a shared codec worker. Piped frames are admitted because
+  /// the decoder already deferred until `has_room()`. `drop-oldest` is
+  /// applied by the worker (`process_encode`).
+  fn admit_frame<'a>(
+    mut guard: MutexGuard<'a, VideoEncoderInner>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    key_frame: bool,
+    piped: bool,
+  ) -> Result<Option<MutexGuard<'a, VideoEncoderInner>>> {
+    match guard.queue_limit() {
+      Some((max, EncodeQueueOverflow::DropNewestDelta))
+        if guard.encode_queue_size >= max && !key_frame =>
+      {
+        guard.dropped_frames += 1;
+        guard.stats.add_dropped();
+        drop(guard);
+        let _ = Self::fire_frame_drop_event(event_state);
+        Ok(None)
+      }
+      Some((max, EncodeQueueOverflow::Throw)) if guard.encode_queue_size >= max && !piped => {
+        Err(quota_exceeded_error(&format!(
+          "{} frames are already queued; wait for a dequeue event",
+          max
+        )))
+      }
+      _ => Ok(Some(guard)),
+    }
+  }
+}
+
 #[napi]
 impl VideoEncoder {
   /// Create a new VideoEncoder with init dictionary (per WebCodecs spec)
@@ -579,15 +878,21 @@ impl VideoEncoder {
   #[napi(constructor)]
   pub fn new(
     #[napi(
-      ts_arg_type = "{ output: (chunk: EncodedVideoChunk, metadata?: EncodedVideoChunkMetadata) => void, error: (error: Error) => void }"
+      ts_arg_type = "{ output: (chunk: EncodedVideoChunk, metadata?: EncodedVideoChunkMetadata) => void, error: (error: Error) => void, outputBatch?: (chunks: EncodedVideoChunk[], metadata: EncodedVideoChunkMetadata[]) => void, maxBatchSize?: number, maxBatchLatency?: number }"
     )]
     init: VideoEncoderInit,
   ) -> Result<Self> {
+    let output_batch = init
+      .output_batch
+      .is_some()
+      .then(|| OutputBatch::new(init.batch_config));
+    let stats = Arc::new(CodecStats::new("VideoEncoder"));
     let inner = VideoEncoderInner {
       state: CodecState::Unconfigured,
       config: None,
       context: None,
       scaler: None,
+      frame_pool: FramePool::default(),
       frame_count: 0,
       extradata_sent: false,
       encode_queue_size: 0,
@@ -605,6 +910,8 @@ impl VideoEncoder {
       flush_abort_flag: None,
       pending_chunks: Vec::new(),
       inside_flush: false,
+      batch_output_callback: init.output_batch,
+      output_batch,
       // Hardware frame context fields
       hw_device_ctx: None,
       hw_frame_ctx: None,
@@ -624,6 +931,11 @@ impl VideoEncoder {
       codec_id: None,
       // Hardware encoder pressure tracking (managed by codec_pressure gauge)
       acquired_hw_slot: false,
+      // Realtime queue policy
+      dropped_frames: 0,
+      pending_key_frame: false,
+      producer_wakers: Vec::new(),
+      stats: stats.clone(),
     };
 
     let inner = Arc::new(Mutex::new(inner));
@@ -631,37 +943,51 @@ impl VideoEncoder {
     // Create separate lock for event listener state (avoids contention with encode operations)
     let event_state = Arc::new(RwLock::new(EventListenerState::default()));
 
-    // Create channel for worker commands
-    let (sender, receiver) = channel::unbounded();
-
     // Create reset abort flag
     let reset_flag = Arc::new(AtomicBool::new(false));
 
-    // Spawn worker thread
-    let worker_inner = inner.clone();
-    let worker_event_state = event_state.clone();
-    let worker_reset_flag = reset_flag.clone();
-    let worker_handle = std::thread::spawn(move || {
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    });
+    // Start the command worker
+    let (sender, worker_handle) = Self::spawn_worker(&inner, &event_state, &reset_flag);
 
     Ok(Self {
       inner,
       event_state,
       dequeue_callback: None,
       output_callback_ref: Rc::new(init.output_ref),
+      output_batch_ref: init.output_batch_ref.map(Rc::new),
       error_callback_ref: Rc::new(init.error_ref),
       command_sender: Some(Arc::new(sender)),
       worker_handle: Some(worker_handle),
       reset_flag,
+      stats,
     })
   }
 
+  /// Start a worker that processes commands in order
+  ///
+  /// Batched output needs the worker to wake up when a batch's latency bound
+  /// expires, so batched codecs keep a dedicated thread; the others may run
+  /// on the shared pool.
+  fn spawn_worker(
+    inner: &Arc<Mutex<VideoEncoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &Arc<AtomicBool>,
+  ) -> (CommandSender<EncoderCommand>, CodecWorker) {
+    let batched = inner.lock().is_ok_and(|guard| guard.output_batch.is_some());
+    let inner = inner.clone();
+    let event_state = event_state.clone();
+    let reset_flag = reset_flag.clone();
+    if batched {
+      codec_worker::spawn_thread(move |receiver| {
+        Self::worker_loop(inner, event_state, receiver, reset_flag)
+      })
+    } else {
+      codec_worker::spawn(move |command| {
+        Self::handle_command(&inner, &event_state, &reset_flag, command)
+      })
+    }
+  }
+
   /// Worker loop that processes commands from the channel
   fn worker_loop(
     inner: Arc<Mutex<VideoEncoderInner>>,
@@ -669,75 +995,218 @@ impl VideoEncoder {
     receiver: Receiver<EncoderCommand>,
     reset_flag: Arc<AtomicBool>,
   ) {
-    while let Ok(command) = receiver.recv() {
-      // Check reset flag before processing each command
-      // If reset() was called, skip remaining encode commands
-      if reset_flag.load(Ordering::SeqCst) {
-        // Still process flush commands to send responses, but skip encodes
-        if let EncoderCommand::Flush(response_sender) = command {
-          let _ = response_sender.send(Err(Error::new(
-            Status::GenericFailure,
-            "AbortError: The operation was aborted",
-          )));
-        } else {
-          // For encode commands, just decrement queue and fire dequeue
-          if let Ok(mut guard) = inner.lock() {
-            let old_size = guard.encode_queue_size;
-            guard.encode_queue_size = old_size.saturating_sub(1);
-            if old_size > 0 {
-              let _ = Self::fire_dequeue_event(&event_state);
-            }
+    while let Some(command) = Self::next_command(&inner, &receiver) {
+      Self::handle_command(&inner, &event_state, &reset_flag, command);
+    }
+  }
+
+  /// Process one command on the worker, then wake piped decoders if it freed room
+  fn handle_command(
+    inner: &Arc<Mutex<VideoEncoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &AtomicBool,
+    command: EncoderCommand,
+  ) {
+    let dequeued = matches!(command, EncoderCommand::Encode { .. });
+    Self::run_command(inner, event_state, reset_flag, command);
+    if dequeued {
+      Self::wake_producers(inner);
+    }
+  }
+
+  /// Wake piped decoders waiting for room in the queue
+  ///
+  /// Called without the inner lock held across the wakeups, after the queue
+  /// size went down (or the encoder stopped accepting frames).
+  fn wake_producers(inner: &Mutex<VideoEncoderInner>) {
+    let wakers = match inner.lock() {
+      Ok(mut guard) => std::mem::take(&mut guard.producer_wakers),
+      Err(_) => return,
+    };
+    for waker in wakers {
+      waker.wake();
+    }
+  }
+
+  /// Process one command on the worker (see `handle_command`)
+  fn run_command(
+    inner: &Arc<Mutex<VideoEncoderInner>>,
+    event_state: &Arc<RwLock<EventListenerState>>,
+    reset_flag: &AtomicBool,
+    command: EncoderCommand,
+  ) {
+    // Check reset flag before processing each command
+    // If reset() was called, skip remaining encode commands
+    if reset_flag.load(Ordering::SeqCst) {
+      // Still process flush commands to send responses, but skip encodes
+      if let EncoderCommand::Flush(response_sender) = command {
+        let _ = response_sender.send(Err(Error::new(
+          Status::GenericFailure,
+          "AbortError: The operation was aborted",
+        )));
+      } else {
+        // For encode commands, just decrement queue and fire dequeue
+        if let Ok(mut guard) = inner.lock() {
+          if matches!(command, EncoderCommand::Encode { .. }) {
+            guard.stats.add_dropped();
+          }
+          let old_size = guard.encode_queue_size;
+          guard.encode_queue_size = old_size.saturating_sub(1);
+          if old_size > 0 {
+            let _ = Self::fire_dequeue_event(event_state);
           }
         }
-        continue;
       }
+      return;
+    }
 
-      match command {
-        EncoderCommand::Encode {
+    match command {
+      EncoderCommand::Encode {
+        frame,
+        timestamp,
+        options,
+        rotation,
+        flip,
+        queued_at,
+      } => {
+        Self::process_encode(
+          inner,
+          event_state,
           frame,
           timestamp,
           options,
           rotation,
           flip,
-        } => {
-          Self::process_encode(
-            &inner,
-            &event_state,
-            frame,
-            timestamp,
-            options,
-            rotation,
-            flip,
-          );
-        }
-        EncoderCommand::Flush(response_sender) => {
-          let result = Self::process_flush(&inner, &event_state);
-          let _ = response_sender.send(result);
-        }
-        EncoderCommand::Reconfigure(config) => {
-          Self::process_reconfigure(&inner, config);
+          queued_at,
+        );
+      }
+      EncoderCommand::Flush(response_sender) => {
+        let result = Self::process_flush(inner, event_state);
+        let _ = response_sender.send(result);
+      }
+      EncoderCommand::Reconfigure(config) => {
+        Self::process_reconfigure(inner, config);
+      }
+      EncoderCommand::UpdateBitrate(config) => {
+        Self::process_update_bitrate(inner, config);
+      }
+    }
+  }
+
+  /// Wait for the next worker command
+  ///
+  /// In batched mode the open output batch is delivered once its latency bound
+  /// expires, whether or not further commands arrive in the meantime.
+  fn next_command(
+    inner: &Arc<Mutex<VideoEncoderInner>>,
+    receiver: &Receiver<EncoderCommand>,
+  ) -> Option<EncoderCommand> {
+    loop {
+      let deadline = match inner.lock() {
+        Ok(mut guard) => {
+          let deadline = guard.output_batch.as_ref().and_then(|b| b.deadline());
+          if deadline.is_some_and(|d| d <= Instant::now()) {
+            Self::deliver_output_batch(&mut guard);
+            None
+          } else {
+            deadline
+          }
         }
+        Err(_) => None,
+      };
+
+      let Some(deadline) = deadline else {
+        return receiver.recv().ok();
+      };
+      match receiver.recv_deadline(deadline) {
+        Ok(command) => return Some(command),
+        Err(RecvTimeoutError::Timeout) => continue,
+        Err(RecvTimeoutError::Disconnected) => return None,
       }
     }
   }
 
+  /// Deliver an encoded chunk produced on the worker thread
+  ///
+  /// During flush, chunks are queued for synchronous delivery in the resolver.
+  /// In batched mode they join the open batch; otherwise they are sent with a
+  /// NonBlocking callback.
+  fn deliver_output(
+    inner: &mut VideoEncoderInner,
+    chunk: EncodedVideoChunk,
+    metadata: EncodedVideoChunkMetadata,
+  ) {
+    inner.stats.add_output();
+    if inner.inside_flush {
+      // Keep chunks batched before the flush ahead of chunks produced by it
+      Self::deliver_output_batch(inner);
+      inner.pending_chunks.push((chunk, metadata));
+    } else if let Some(batch) = inner.output_batch.as_mut() {
+      if batch.push((chunk, metadata)) {
+        Self::deliver_output_batch(inner);
+      }
+    } else {
+      let stats = inner.stats.clone();
+      let queued_at = Instant::now();
+      inner.output_callback.call_with_return_value(
+        (chunk, metadata).into(),
+        ThreadsafeFunctionCallMode::NonBlocking,
+        move |ret: Result<UnknownReturnValue>, _env: Env| {
+          stats.record_since(Stage::Callback, queued_at);
+          // Rethrow what the output callback threw
+          ret.map(|_| ())
+        },
+      );
+    }
+  }
+
+  /// Deliver the open output batch (if any) as a single callback
+  fn deliver_output_batch(inner: &mut VideoEncoderInner) {
+    let Some(batch) = inner.output_batch.as_mut() else {
+      return;
+    };
+    if batch.is_empty() {
+      return;
+    }
+    let items = batch.take();
+    if inner.inside_flush {
+      inner.pending_chunks.extend(items);
+    } else if let Some(callback) = inner.batch_output_callback.as_ref() {
+      let (chunks, metadata): (Vec<_>, Vec<_>) = items.into_iter().unzip();
+      let stats = inner.stats.clone();
+      let queued_at = Instant::now();
+      callback.call_with_return_value(
+        (chunks, metadata).into(),
+        ThreadsafeFunctionCallMode::NonBlocking,
+        move |ret: Result<UnknownReturnValue>, _env: Env| {
+          stats.record_since(Stage::Callback, queued_at);
+          // Rethrow what the output callback threw
+          ret.map(|_| ())
+        },
+      );
+    }
+  }
+
   /// Process an encode command on the worker thread
   fn process_encode(
     inner: &Arc<Mutex<VideoEncoderInner>>,
     event_state: &Arc<RwLock<EventListenerState>>,
     frame_arc: Arc<ParkingLotRwLock<Frame>>,
     timestamp: i64,
-    options: Option<VideoEncoderEncodeOptions>,
+    mut options: Option<VideoEncoderEncodeOptions>,
     rotation: f64,
     flip: bool,
+    queued_at: Instant,
   ) {
     let mut guard = match inner.lock() {
       Ok(g) => g,
       Err(_) => return, // Lock poisoned
     };
+    guard.stats.record_since(Stage::QueueWait, queued_at);
 
     // Check if encoder is still configured
     if guard.state != CodecState::Configured {
+      guard.stats.add_dropped();
       let old_size = guard.encode_queue_size;
       guard.encode_queue_size = old_size.saturating_sub(1);
       if old_size > 0 {
@@ -749,6 +1218,26 @@ impl VideoEncoder {
       return;
     }
 
+    // drop-oldest: while more frames are queued than allowed, skip the oldest.
+    // A keyframe request moves on to the next frame that is encoded.
+    let requested_key_frame = options.as_ref().is_some_and(|o| o.key_frame == Some(true));
+    if let Some((max, EncodeQueueOverflow::DropOldest)) = guard.queue_limit()
+      && guard.encode_queue_size > max
+    {
+      guard.encode_queue_size -= 1;
+      guard.pending_key_frame |= requested_key_frame;
+      guard.dropped_frames += 1;
+      guard.stats.add_dropped();
+      drop(guard);
+      let _ = Self::fire_dequeue_event(event_state);
+      let _ = Self::fire_frame_drop_event(event_state);
+      return;
+    }
+    if std::mem::take(&mut guard.pending_key_frame) && !requested_key_frame {
+      options.get_or_insert_with(Default::default).key_frame = Some(true);
+    }
+    guard.stats.add_input();
+
     // Get config info (unwrap validated config values)
     let (width, height, codec_string, display_width, display_height) = match guard.config.as_ref() {
       Some(config) => (
@@ -775,24 +1264,51 @@ impl VideoEncoder {
     // Acquire read lock on the shared frame
     let frame_guard = frame_arc.read();
 
+    // GPU-resident input (decoder with keepHardwareFrames) is encoded as-is when
+    // it lives on this encoder's device; otherwise it is downloaded first
+    let hw_passthrough = frame_guard.format().is_hardware() && guard.accepts_hw_frame(&frame_guard);
+    let downloaded = if frame_guard.format().is_hardware() && !hw_passthrough {
+      match download_hw_frame(&frame_guard) {
+        Ok(sw_frame) => Some(sw_frame),
+        Err(e) => {
+          drop(frame_guard);
+          let old_size = guard.encode_queue_size;
+          guard.encode_queue_size = old_size.saturating_sub(1);
+          if old_size > 0 {
+            let _ = Self::fire_dequeue_event(event_state);
+          }
+          Self::report_error(
+            &mut guard,
+            &format!("Failed to download hardware frame: {}", e),
+          );
+          return;
+        }
+      }
+    } else {
+      None
+    };
+    let source_frame: &Frame = downloaded.as_ref().unwrap_or(&frame_guard);
+
     // Check if frame needs conversion
-    let frame_format = frame_guard.format();
-    let needs_conversion = frame_format != target_format
-      || frame_guard.width() != width
-      || frame_guard.height() != height;
+    let frame_format = source_frame.format();
+    let needs_conversion = !hw_passthrough
+      && (frame_format != target_format
+        || source_frame.width() != width
+        || source_frame.height() != height);
 
     // Convert frame if needed, or deep copy if we need to mutate it
     let mut frame_to_encode = if needs_conversion {
       // Create scaler if needed
       if guard.scaler.is_none() {
-        match Scaler::new(
-          frame_guard.width(),
-          frame_guard.height(),
+        match Scaler::with_threads(
+          source_frame.width(),
+          source_frame.height(),
           frame_format,
           width,
           height,
           target_format,
           crate::codec::scaler::ScaleAlgorithm::Bilinear,
+          guard.scaler_threads(),
         ) {
           Ok(scaler) => guard.scaler = Some(scaler),
           Err(e) => {
@@ -808,8 +1324,13 @@ impl VideoEncoder {
         }
       }
 
-      let scaler = guard.scaler.as_ref().unwrap();
-      match scaler.scale_alloc(&frame_guard) {
+      // Reuse a pooled destination frame instead of allocating one per conversion
+      let inner_ref = &mut *guard;
+      let scaler = inner_ref.scaler.as_ref().unwrap();
+      let frame_pool = &mut inner_ref.frame_pool;
+      match inner_ref.stats.time(Stage::Convert, || {
+        scaler.scale_pooled(source_frame, frame_pool)
+      }) {
         Ok(scaled) => scaled,
         Err(e) => {
           drop(frame_guard);
@@ -827,7 +1348,7 @@ impl VideoEncoder {
       // atomic reference counting. This avoids copying 3-12 MB per frame.
       // We get an owned AVFrame struct for mutation (set_pts, set_pict_type) while
       // the underlying pixel data is shared read-only.
-      match frame_guard.shallow_clone() {
+      match source_frame.shallow_clone() {
         Ok(shallow) => shallow,
         Err(e) => {
           drop(frame_guard);
@@ -845,6 +1366,9 @@ impl VideoEncoder {
     // Release the read lock now that we have an owned frame
     drop(frame_guard);
 
+    // Converted frames come from the frame pool and are returned to it after encoding
+    let mut frame_is_pooled = needs_conversion;
+
     // Set frame PTS - convert from microseconds to encoder time_base units
     // FFmpeg expects frame->pts in time_base units, not microseconds
     let encoder_time_base = guard.context.as_ref().map(|ctx| ctx.time_base());
@@ -889,18 +1413,23 @@ impl VideoEncoder {
     // Before GPU upload, save original CPU frame for potential fallback.
     // When hardware encoding fails, we need the CPU frame (with valid linesize)
     // for software fallback. GPU frames have linesize=0 and can't be encoded by software.
-    let cpu_frame_for_fallback = if guard.use_hw_frames && guard.hw_frame_ctx.is_some() {
-      frame_to_encode.shallow_clone().ok()
-    } else {
-      None
-    };
+    let cpu_frame_for_fallback =
+      if !hw_passthrough && guard.use_hw_frames && guard.hw_frame_ctx.is_some() {
+        frame_to_encode.shallow_clone().ok()
+      } else {
+        None
+      };
 
     // Upload frame to GPU if hardware frame context is available
     // This provides zero-copy encoding for hardware encoders
-    if guard.use_hw_frames && guard.hw_frame_ctx.is_some() {
+    if !hw_passthrough && guard.use_hw_frames && guard.hw_frame_ctx.is_some() {
       let hw_upload_result = Self::try_upload_to_gpu(&mut guard, &frame_to_encode);
       if let Some(hw_frame) = hw_upload_result {
-        frame_to_encode = hw_frame;
+        let cpu_frame = std::mem::replace(&mut frame_to_encode, hw_frame);
+        if frame_is_pooled {
+          guard.frame_pool.release(cpu_frame);
+          frame_is_pooled = false;
+        }
       }
       // If upload failed, use_hw_frames is set to false and we continue with CPU frame
     }
@@ -1260,6 +1789,12 @@ impl VideoEncoder {
       }
     }
 
+    // Hand the converted frame back to the pool. The encoder holds its own
+    // reference while it needs the pixels, so the pool won't recycle it early.
+    if frame_is_pooled {
+      guard.frame_pool.release(frame_to_encode);
+    }
+
     // Decrement queue size and fire dequeue event (only if queue was not empty)
     let old_size = guard.encode_queue_size;
     guard.encode_queue_size = old_size.saturating_sub(1);
@@ -1416,16 +1951,7 @@ impl VideoEncoder {
         }
       };
 
-      // During flush, queue chunks for synchronous delivery in resolver
-      // Otherwise, use Blocking callback for immediate delivery
-      if guard.inside_flush {
-        guard.pending_chunks.push((chunk, metadata));
-      } else {
-        guard.output_callback.call(
-          (chunk, metadata).into(),
-          ThreadsafeFunctionCallMode::NonBlocking,
-        );
-      }
+      Self::deliver_output(&mut guard, chunk, metadata);
     }
   }
 
@@ -1438,6 +1964,9 @@ impl VideoEncoder {
       .lock()
       .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
 
+    // Chunks still waiting in an open batch precede anything the flush produces
+    Self::deliver_output_batch(&mut guard);
+
     // Per W3C spec: state check happens on main thread (in flush() method).
     // If state changed after that check (e.g., reconfigure failed), silently succeed.
     // The error callback has already been invoked by the failing operation.
@@ -1726,6 +2255,7 @@ impl VideoEncoder {
             }
             if new_context.open().is_ok() {
               // Drop old context and replace with new one
+              new_context.set_stats(guard.stats.clone());
               guard.context = Some(new_context);
               guard.extradata_sent = false;
               guard.frame_count = 0;
@@ -1738,6 +2268,51 @@ impl VideoEncoder {
     Ok(())
   }
 
+  /// Process a bitrate-only reconfigure on the worker thread
+  ///
+  /// Keeps the open context, and with it the GOP and any frames the encoder
+  /// still buffers, when the encoder can retarget its rate control live.
+  fn process_update_bitrate(inner: &Arc<Mutex<VideoEncoderInner>>, config: VideoEncoderConfig) {
+    let mut guard = match inner.lock() {
+      Ok(g) => g,
+      Err(_) => return, // Lock poisoned
+    };
+
+    // Don't reconfigure if encoder is closed
+    if guard.state == CodecState::Closed {
+      return;
+    }
+
+    let bitrate_mode = match config.bitrate_mode {
+      Some(VideoEncoderBitrateMode::Constant) => CodecBitrateMode::Constant,
+      Some(VideoEncoderBitrateMode::Variable) => CodecBitrateMode::Variable,
+      Some(VideoEncoderBitrateMode::Quantizer) => CodecBitrateMode::Quantizer,
+      None => CodecBitrateMode::Constant,
+    };
+    let bitrate = config.bitrate.unwrap_or(5_000_000.0) as u64;
+
+    let VideoEncoderInner {
+      context,
+      encoder_name,
+      ..
+    } = &mut *guard;
+    let updated = context
+      .as_mut()
+      .is_some_and(|ctx| ctx.update_bitrate(encoder_name, bitrate_mode, bitrate));
+
+    if updated {
+      tracing::debug!(
+        target: "webcodecs",
+        "Updated {} bitrate to {} without reopening the encoder",
+        guard.encoder_name,
+        bitrate
+      );
+    } else {
+      drop(guard);
+      Self::process_reconfigure(inner, config);
+    }
+  }
+
   /// Process a reconfigure command on the worker thread
   /// Drains old context and creates new one with updated config
   fn process_reconfigure(inner: &Arc<Mutex<VideoEncoderInner>>, config: VideoEncoderConfig) {
@@ -1819,6 +2394,8 @@ impl VideoEncoder {
             target: "webcodecs",
             "Hardware encoder slots exhausted, using software encoder"
           );
+          codec_pressure::gauge().record_encoder_fallback();
+          guard.stats.add_hw_fallback();
           (None, false)
         } else {
           (Some(get_platform_hw_type()), true)
@@ -2038,6 +2615,12 @@ impl VideoEncoder {
       return;
     }
 
+    // Hardware was requested but creation/configure/open fell back to software
+    if hw_type.is_some() && !is_hardware {
+      codec_pressure::gauge().record_encoder_fallback();
+      guard.stats.add_hw_fallback();
+    }
+
     // Update use_alpha, pixel_format, and codec_id AFTER all validation checks pass
     // This prevents state corruption if reconfigure fails partway through
     guard.use_alpha = use_alpha;
@@ -2045,6 +2628,7 @@ impl VideoEncoder {
     guard.codec_id = Some(codec_id);
 
     // Update inner state
+    context.set_stats(guard.stats.clone());
     guard.context = Some(context);
     guard.config = Some(config.clone());
     guard.is_hardware = is_hardware;
@@ -2096,9 +2680,26 @@ impl VideoEncoder {
     }
 
     // 2. Fire EventTarget listeners
+    Self::fire_event_listeners(&mut state, "dequeue");
+
+    Ok(())
+  }
+
+  /// Fire "framedrop" event listeners (a frame was dropped by `queueOverflow`)
+  fn fire_frame_drop_event(event_state: &Arc<RwLock<EventListenerState>>) -> Result<()> {
+    let mut state = match event_state.write() {
+      Ok(s) => s,
+      Err(_) => return Err(Error::new(Status::GenericFailure, "Lock poisoned")),
+    };
+    Self::fire_event_listeners(&mut state, "framedrop");
+    Ok(())
+  }
+
+  /// Dispatch an event to the EventTarget listeners registered for it
+  fn fire_event_listeners(state: &mut EventListenerState, event_type: &str) {
     // For "once" listeners (Strong TSF): use call_with_return_value to drop TSF after callback
     // For regular listeners (Weak TSF): use simple call()
-    if let Some(listeners) = state.event_listeners.get_mut("dequeue") {
+    if let Some(listeners) = state.event_listeners.get_mut(event_type) {
       // Partition into once and regular listeners
       let (once_listeners, regular_listeners): (Vec<_>, Vec<_>) =
         std::mem::take(listeners).into_iter().partition(|e| e.once);
@@ -2131,11 +2732,9 @@ impl VideoEncoder {
       // Put back regular listeners (once listeners are already consumed/removed)
       *listeners = regular_listeners;
       if listeners.is_empty() {
-        state.event_listeners.remove("dequeue");
+        state.event_listeners.remove(event_type);
       }
     }
-
-    Ok(())
   }
 
   /// Attempt to fall back to software encoder (for no-preference mode)
@@ -2206,9 +2805,12 @@ impl VideoEncoder {
       codec_pressure::gauge().release_hw_encoder();
       inner.acquired_hw_slot = false;
     }
+    codec_pressure::gauge().record_encoder_fallback();
 
     // Replace the hardware context with software
+    context.set_stats(inner.stats.clone());
     inner.context = Some(context);
+    inner.stats.add_hw_fallback();
     inner.is_hardware = false;
     inner.encoder_name = result.encoder_name;
     inner.silent_encode_count = 0;
@@ -2277,8 +2879,9 @@ impl VideoEncoder {
     width: u32,
     height: u32,
   ) -> Result<(HwDeviceContext, HwFrameContext)> {
-    // Create hardware device context
-    let device = HwDeviceContext::new(hw_type).map_err(|e| {
+    // Use the shared device context, so decoders on the same device can pass
+    // GPU frames straight through (see VideoEncoderInner::accepts_hw_frame)
+    let device = HwDeviceContext::shared(hw_type).map_err(|e| {
       Error::new(
         Status::GenericFailure,
         format!("Failed to create hardware device context: {}", e),
@@ -2317,7 +2920,7 @@ impl VideoEncoder {
     let nv12_frame = if frame.format() != AVPixelFormat::Nv12 {
       // Create NV12 scaler if needed
       if guard.nv12_scaler.is_none() {
-        match Scaler::new(
+        match Scaler::with_threads(
           frame.width(),
           frame.height(),
           frame.format(),
@@ -2325,6 +2928,7 @@ impl VideoEncoder {
           frame.height(),
           AVPixelFormat::Nv12,
           crate::codec::scaler::ScaleAlgorithm::Bilinear,
+          guard.scaler_threads(),
         ) {
           Ok(scaler) => {
             guard.nv12_scaler = Some(scaler);
@@ -2340,9 +2944,14 @@ impl VideoEncoder {
         }
       }
 
-      // Scale to NV12
-      let scaler = guard.nv12_scaler.as_ref()?;
-      match scaler.scale_alloc(frame) {
+      // Scale to NV12 into a pooled frame (returned to the pool after upload)
+      let inner_ref = &mut *guard;
+      let scaler = inner_ref.nv12_scaler.as_ref()?;
+      let frame_pool = &mut inner_ref.frame_pool;
+      match inner_ref
+        .stats
+        .time(Stage::Convert, || scaler.scale_pooled(frame, frame_pool))
+      {
         Ok(nv12) => nv12,
         Err(e) => {
           guard.use_hw_frames = false;
@@ -2369,9 +2978,15 @@ impl VideoEncoder {
       }
     };
 
-    // Upload to GPU
+    // Upload to GPU (av_hwframe_transfer_data copies, so the NV12 frame can be recycled)
     let hw_frame_ctx = guard.hw_frame_ctx.as_ref()?;
-    match hw_frame_ctx.upload_frame(&nv12_frame) {
+    let upload_result = guard
+      .stats
+      .time(Stage::HwUpload, || hw_frame_ctx.upload_frame(&nv12_frame));
+    if frame.format() != AVPixelFormat::Nv12 {
+      guard.frame_pool.release(nv12_frame);
+    }
+    match upload_result {
       Ok(hw_frame) => Some(hw_frame),
       Err(e) => {
         guard.use_hw_frames = false;
@@ -2404,6 +3019,49 @@ impl VideoEncoder {
     Ok(inner.encode_queue_size)
   }
 
+  /// Frames dropped by the `queueOverflow` policy (non-standard extension)
+  ///
+  /// Each drop also fires a "framedrop" event.
+  #[napi(getter)]
+  pub fn dropped_frames(&self) -> Result<i64> {
+    let inner = self
+      .inner
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+    Ok(inner.dropped_frames as i64)
+  }
+
+  /// Get statistics for the conversion frame pool (non-standard extension)
+  ///
+  /// Frames converted to the encoder's size/format (e.g. RGBA→I420) are
+  /// recycled through a per-encoder pool; a hit rate near 1.0 means the
+  /// conversion path is not allocating per frame.
+  #[napi]
+  pub fn get_frame_pool_stats(&self) -> Result<VideoEncoderFramePoolStats> {
+    let inner = self
+      .inner
+      .lock()
+      .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
+    let stats = inner.frame_pool.stats();
+    Ok(VideoEncoderFramePoolStats {
+      size: stats.pooled as u32,
+      capacity: stats.capacity as u32,
+      hits: stats.hits as i64,
+      misses: stats.misses as i64,
+      hit_rate: stats.hit_rate(),
+      scaler_threads: inner.scaler.as_ref().map_or(0, |s| s.slice_threads()),
+    })
+  }
+
+  /// Get per-stage performance counters (non-standard extension)
+  ///
+  /// Reads atomic counters without waiting for the worker, so it is cheap
+  /// enough to poll for metrics export.
+  #[napi]
+  pub fn get_stats(&self) -> CodecPerformanceStats {
+    CodecPerformanceStats::from(&*self.stats)
+  }
+
   /// Set the dequeue event handler (per WebCodecs spec)
   ///
   /// The dequeue event fires when encodeQueueSize decreases,
@@ -2503,6 +3161,11 @@ impl VideoEncoder {
       return throw_type_error_unit(&env, "framerate must be greater than 0");
     }
 
+    // Validate maxQueueSize if specified (non-standard)
+    if config.max_queue_size == Some(0) {
+      return throw_type_error_unit(&env, "maxQueueSize must be greater than 0");
+    }
+
     let mut inner = self
       .inner
       .lock()
@@ -2539,6 +3202,13 @@ impl VideoEncoder {
         return Ok(());
       }
 
+      // Commands run in order, so the previous config is the one the worker's
+      // context will have when this reconfigure reaches it
+      let bitrate_only = inner
+        .config
+        .as_ref()
+        .is_some_and(|previous| config.is_bitrate_update_of(previous));
+
       // Store config for immediate property reads and new encode validation
       inner.config = Some(config.clone());
 
@@ -2550,7 +3220,11 @@ impl VideoEncoder {
         PromiseRaw::resolve(&env, ())?.then(move |_| {
           // Only send if encoder hasn't been closed (weak reference can still upgrade)
           if let Some(sender) = weak_sender.upgrade() {
-            let _ = sender.send(EncoderCommand::Reconfigure(config));
+            let _ = sender.send(if bitrate_only {
+              EncoderCommand::UpdateBitrate(config)
+            } else {
+              EncoderCommand::Reconfigure(config)
+            });
           }
           Ok(())
         })?;
@@ -2653,6 +3327,8 @@ impl VideoEncoder {
             target: "webcodecs",
             "Hardware encoder slots exhausted, using software encoder"
           );
+          codec_pressure::gauge().record_encoder_fallback();
+          self.stats.add_hw_fallback();
           (None, false) // Fall back to software
         } else {
           (Some(get_platform_hw_type()), true)
@@ -2910,6 +3586,13 @@ impl VideoEncoder {
       return Ok(());
     }
 
+    // Hardware was requested but creation/configure/open fell back to software
+    if hw_type.is_some() && !is_hardware {
+      codec_pressure::gauge().record_encoder_fallback();
+      self.stats.add_hw_fallback();
+    }
+
+    context.set_stats(self.stats.clone());
     inner.context = Some(context);
     inner.config = Some(config);
     inner.state = CodecState::Configured;
@@ -2977,20 +3660,10 @@ impl VideoEncoder {
 
     // Create new channel and worker if needed (after reconfiguration)
     if self.command_sender.is_none() {
-      let (sender, receiver) = channel::unbounded();
+      drop(inner); // Release lock before starting the worker
+      let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
       self.command_sender = Some(Arc::new(sender));
-      let worker_inner = self.inner.clone();
-      let worker_event_state = self.event_state.clone();
-      let worker_reset_flag = self.reset_flag.clone();
-      drop(inner); // Release lock before spawning thread
-      self.worker_handle = Some(std::thread::spawn(move || {
-        Self::worker_loop(
-          worker_inner,
-          worker_event_state,
-          receiver,
-          worker_reset_flag,
-        );
-      }));
+      self.worker_handle = Some(worker);
     }
 
     Ok(())
@@ -3053,6 +3726,14 @@ impl VideoEncoder {
         inner.input_color_space = Some(color_space.to_init());
       }
 
+      // Apply the queue policy (non-standard maxQueueSize / queueOverflow)
+      let key_frame = options.as_ref().is_some_and(|o| o.key_frame == Some(true));
+      let mut inner = match Self::admit_frame(inner, &self.event_state, key_frame, false) {
+        Ok(Some(inner)) => inner,
+        Ok(None) => return Ok(()),
+        Err(e) => return throw_error_as_dom_exception(&env, &e),
+      };
+
       // Increment queue size (pending operation)
       inner.encode_queue_size += 1;
 
@@ -3076,6 +3757,7 @@ impl VideoEncoder {
             options,
             rotation,
             flip,
+            queued_at: Instant::now(),
           });
         }
         Ok(())
@@ -3167,6 +3849,7 @@ impl VideoEncoder {
     // Clone references for the callback closure
     let inner_clone = self.inner.clone();
     let output_callback_ref = self.output_callback_ref.clone();
+    let output_batch_ref = self.output_batch_ref.clone();
 
     env.spawn_future_with_callback(
       async move {
@@ -3197,15 +3880,25 @@ impl VideoEncoder {
           std::mem::take(&mut guard.pending_chunks)
         };
 
-        // Call output callback for each chunk synchronously
-        // If callback calls reset(), abort_flag will be set before next iteration
-        let callback = output_callback_ref.borrow_back(env)?;
-        for (chunk, metadata) in chunks {
-          // Check abort flag before each callback - exit early if reset() was called
-          if abort_flag.load(Ordering::SeqCst) {
-            break;
+        if let Some(batch_ref) = output_batch_ref {
+          // Batched mode: deliver everything drained by the flush in one call
+          if !chunks.is_empty() && !abort_flag.load(Ordering::SeqCst) {
+            let (chunks, metadata): (Vec<_>, Vec<_>) = chunks.into_iter().unzip();
+            batch_ref
+              .borrow_back(env)?
+              .call((chunks, metadata).into())?;
+          }
+        } else {
+          // Call output callback for each chunk synchronously
+          // If callback calls reset(), abort_flag will be set before next iteration
+          let callback = output_callback_ref.borrow_back(env)?;
+          for (chunk, metadata) in chunks {
+            // Check abort flag before each callback - exit early if reset() was called
+            if abort_flag.load(Ordering::SeqCst) {
+              break;
+            }
+            callback.call((chunk, metadata).into())?;
           }
-          callback.call((chunk, metadata).into())?;
         }
 
         // Clean up flags
@@ -3293,6 +3986,7 @@ impl VideoEncoder {
     // Drop existing context
     inner.context = None;
     inner.scaler = None;
+    inner.frame_pool.clear();
     inner.config = None;
     inner.state = CodecState::Unconfigured;
     inner.frame_count = 0;
@@ -3324,25 +4018,18 @@ impl VideoEncoder {
     // Clear flush-related state
     inner.inside_flush = false;
     inner.pending_chunks.clear();
+    if let Some(batch) = inner.output_batch.as_mut() {
+      batch.clear();
+    }
 
     // Reset the abort flag for new worker
     self.reset_flag.store(false, Ordering::SeqCst);
 
     // Create new channel and worker for future encode operations
-    let (sender, receiver) = channel::unbounded();
+    drop(inner); // Release lock before starting the worker
+    let (sender, worker) = Self::spawn_worker(&self.inner, &self.event_state, &self.reset_flag);
     self.command_sender = Some(Arc::new(sender));
-    let worker_inner = self.inner.clone();
-    let worker_event_state = self.event_state.clone();
-    let worker_reset_flag = self.reset_flag.clone();
-    drop(inner); // Release lock before spawning thread
-    self.worker_handle = Some(std::thread::spawn(move || {
-      Self::worker_loop(
-        worker_inner,
-        worker_event_state,
-        receiver,
-        worker_reset_flag,
-      );
-    }));
+    self.worker_handle = Some(worker);
 
     Ok(())
   }
@@ -3370,8 +4057,8 @@ impl VideoEncoder {
     // Now safe to join worker - channel is closed, worker will see recv() Err and exit.
     // This prevents resource contention where old worker is still holding FFmpeg resources
     // while new encoder is being created.
-    if let Some(handle) = self.worker_handle.take() {
-      let _ = handle.join();
+    if let Some(worker) = self.worker_handle.take() {
+      worker.join();
     }
 
     let mut inner = self
@@ -3398,9 +4085,13 @@ impl VideoEncoder {
 
     inner.context = None;
     inner.scaler = None;
+    inner.frame_pool.clear();
     inner.config = None;
     inner.state = CodecState::Closed;
     inner.encode_queue_size = 0;
+    if let Some(batch) = inner.output_batch.as_mut() {
+      batch.clear();
+    }
 
     Ok(())
   }
@@ -3601,6 +4292,10 @@ impl VideoEncoder {
       return reject_with_type_error(env, "bitrate must be positive");
     }
 
+    if config.max_queue_size == Some(0) {
+      return reject_with_type_error(env, "maxQueueSize must be positive");
+    }
+
     env.spawn_future(async move {
       // Validate framerate if specified (return { supported: false } not TypeError)
       if let Some(framerate) = config.framerate
@@ -3643,11 +4338,9 @@ impl VideoEncoder {
         }
       };
 
-      // Try to create encoder
-      let result = CodecContext::new_encoder(codec_id);
-
+      // Encoder availability is probed once per codec
       Ok(VideoEncoderSupport {
-        supported: result.is_ok(),
+        supported: probe::encoder_available(codec_id),
         config,
       })
     })
@@ -3,17 +3,23 @@
 //! Represents a frame of video data that can be displayed or encoded.
 //! See: https://developer.mozilla.org/en-US/docs/Web/API/VideoFrame
 
-use crate::codec::{Frame, Scaler};
+use crate::codec::{Frame, Scaler, download_hw_frame, frame_memory, hw_frame_sw_format};
 use crate::ffi::{
   AVColorPrimaries, AVColorRange, AVColorSpace, AVColorTransferCharacteristic, AVPixelFormat,
+  avutil::image_buffer_size,
 };
 use crate::webcodecs::error::{
   enforce_range_long_long, enforce_range_long_long_optional, invalid_state_error,
   not_supported_error, throw_invalid_state_error, throw_not_supported_error, type_error,
 };
+use crate::webcodecs::frame_memory::sync_external_memory;
+use crate::webcodecs::pinned_buffer::{
+  PinnedJsBuffer, release_pending_pins, transfer_array_buffer,
+};
 use napi::bindgen_prelude::*;
 use napi_derive::napi;
 use parking_lot::RwLock;
+use std::ptr::NonNull;
 use std::sync::{Arc, Mutex};
 
 /// Video pixel format (WebCodecs spec)
@@ -608,6 +614,18 @@ impl VideoColorSpace {
   }
 }
 
+/// Get the WebCodecs pixel format of an FFmpeg Frame
+///
+/// GPU-resident frames report the format they download to (e.g. NV12).
+fn pixel_format_of(frame: &Frame) -> VideoPixelFormat {
+  let format = if frame.format().is_hardware() {
+    hw_frame_sw_format(frame).unwrap_or(AVPixelFormat::None)
+  } else {
+    frame.format()
+  };
+  VideoPixelFormat::from_av_format(format).unwrap_or(VideoPixelFormat::I420)
+}
+
 /// Extract color space metadata from an FFmpeg Frame
 ///
 /// Converts FFmpeg color metadata (primaries, transfer, colorspace, range)
@@ -768,8 +786,125 @@ pub struct VideoFrameBufferInit {
   pub color_space: Option<VideoColorSpaceInit>,
   /// Metadata associated with the frame
   pub metadata: Option<VideoFrameMetadata>,
-  /// ArrayBuffers to transfer (W3C spec - ignored in Node.js, we always copy)
-  pub transfer: Option<Vec<Uint8Array>>,
+  /// ArrayBuffers to transfer (W3C spec)
+  ///
+  /// Listed buffers are detached once the frame is constructed. When the
+  /// frame data itself is listed and uses the default packed layout (8-bit
+  /// formats), the frame takes over that memory without copying. Buffers that
+  /// can't be detached (e.g. pooled Node.js Buffers) are copied and left
+  /// untouched.
+  pub transfer: Option<Vec<TransferRange>>,
+}
+
+/// An ArrayBuffer listed in `transfer` and the memory range it covered
+#[derive(Debug, Clone, Copy)]
+pub struct TransferRange {
+  buffer: napi::sys::napi_value,
+  start: usize,
+  len: usize,
+}
+
+impl TransferRange {
+  /// Whether `data` lies entirely inside this buffer
+  fn contains(&self, data: &[u8]) -> bool {
+    let start = data.as_ptr() as usize;
+    self.start <= start && start + data.len() <= self.start + self.len
+  }
+}
+
+/// Parse `init.transfer` into the memory ranges of the listed ArrayBuffers
+///
+/// Accepts ArrayBuffers as well as views (TypedArray/DataView), which resolve
+/// to their underlying ArrayBuffer.
+unsafe fn parse_transfer_list(
+  env: napi::sys::napi_env,
+  init: napi::sys::napi_value,
+) -> Result<Option<Vec<TransferRange>>> {
+  use napi::sys;
+
+  let list = unsafe { get_raw_property(env, init, "transfer") };
+  if list.is_null() || is_null_or_undefined(env, list) {
+    return Ok(None);
+  }
+
+  let mut is_array = false;
+  unsafe { sys::napi_is_array(env, list, &mut is_array) };
+  if !is_array {
+    return Err(throw_type_error(
+      env,
+      "transfer must be a sequence of ArrayBuffers",
+    ));
+  }
+
+  let mut length = 0u32;
+  unsafe { sys::napi_get_array_length(env, list, &mut length) };
+  let mut ranges = Vec::with_capacity(length as usize);
+  for index in 0..length {
+    let mut element = std::ptr::null_mut();
+    unsafe { sys::napi_get_element(env, list, index, &mut element) };
+
+    let mut buffer = element;
+    let mut is_typedarray = false;
+    let mut is_dataview = false;
+    unsafe {
+      sys::napi_is_typedarray(env, element, &mut is_typedarray);
+      sys::napi_is_dataview(env, element, &mut is_dataview);
+    }
+    if is_typedarray {
+      unsafe {
+        sys::napi_get_typedarray_info(
+          env,
+          element,
+          std::ptr::null_mut(),
+          std::ptr::null_mut(),
+          std::ptr::null_mut(),
+          &mut buffer,
+          std::ptr::null_mut(),
+        )
+      };
+    } else if is_dataview {
+      unsafe {
+        sys::napi_get_dataview_info(
+          env,
+          element,
+          std::ptr::null_mut(),
+          std::ptr::null_mut(),
+          &mut buffer,
+          std::ptr::null_mut(),
+        )
+      };
+    }
+
+    let mut is_arraybuffer = false;
+    unsafe { sys::napi_is_arraybuffer(env, buffer, &mut is_arraybuffer) };
+    if !is_arraybuffer {
+      return Err(throw_type_error(
+        env,
+        "transfer must be a sequence of ArrayBuffers",
+      ));
+    }
+
+    // A buffer listed twice (directly or through views) is transferred once
+    let listed = ranges.iter().any(|range: &TransferRange| {
+      let mut same = false;
+      unsafe { sys::napi_strict_equals(env, range.buffer, buffer, &mut same) };
+      same
+    });
+    if listed {
+      continue;
+    }
+
+    let mut data = std::ptr::null_mut();
+    let mut len = 0usize;
+    unsafe { sys::napi_get_arraybuffer_info(env, buffer, &mut data, &mut len) };
+    ranges.push(TransferRange {
+      buffer,
+      start: data as usize,
+      len,
+    });
+  }
+
+  Ok(Some(ranges))
 }
 
 /// Helper to throw TypeError and return an error
@@ -848,7 +983,7 @@ impl FromNapiValue for VideoFrameBufferInit {
     let display_height: Option<u32> = obj.get("displayHeight")?;
     let color_space: Option<VideoColorSpaceInit> = obj.get("colorSpace")?;
     let metadata: Option<VideoFrameMetadata> = obj.get("metadata")?;
-    let transfer: Option<Vec<Uint8Array>> = obj.get("transfer")?;
+    let transfer = unsafe { parse_transfer_list(env, value)? };
 
     Ok(VideoFrameBufferInit {
       format,
@@ -911,7 +1046,7 @@ pub struct VideoFrameConstructorInit {
   pub display_height: Option<u32>,
   pub color_space: Option<VideoColorSpaceInit>,
   pub metadata: Option<VideoFrameMetadata>,
-  pub transfer: Option<Vec<Uint8Array>>,
+  pub transfer: Option<Vec<TransferRange>>,
   // Only for frame clone (VideoFrameInit)
   pub alpha: Option<String>,
 }
@@ -975,7 +1110,7 @@ impl FromNapiValue for VideoFrameConstructorInit {
       display_height: obj.get("displayHeight")?,
       color_space: obj.get("colorSpace")?,
       metadata: obj.get("metadata")?,
-      transfer: obj.get("transfer")?,
+      transfer: unsafe { parse_transfer_list(env, value)? },
       alpha: obj.get("alpha")?,
     })
   }
@@ -991,6 +1126,11 @@ pub struct VideoFrameCopyToOptions {
   pub rect: Option<DOMRectInit>,
   /// Layout for output planes
   pub layout: Option<Vec<PlaneLayout>>,
+  /// Keep a converted or downloaded copy for later copyTo() calls on this
+  /// frame and its clones (non-standard, default: true)
+  ///
+  /// Pass false for one-off copies so the conversion is freed right away.
+  pub cache_conversion: Option<bool>,
 }
 
 /// DOMRectInit for specifying regions
@@ -1023,6 +1163,179 @@ pub struct VideoFrameRect {
   pub height: u32,
 }
 
+/// The most recent copyTo() conversion of a frame's pixels to another format
+///
+/// Shared by a frame and its clones (they share the pixels too), so several
+/// consumers asking for the same format convert once. Hardware frames also
+/// keep their download here under their own format. The cached frame keeps
+/// its `frame_memory` charge, so it counts against the frame memory budget
+/// until the frame is closed; under memory pressure nothing is cached.
+type ConvertedFrame = Arc<parking_lot::Mutex<Option<(VideoPixelFormat, Arc<Frame>)>>>;
+
+/// Converters kept for reuse by copyTo()
+const CONVERTER_CACHE_CAPACITY: usize = 4;
+
+/// Idle format converters, reused by copyTo() across frames with the same geometry
+static CONVERTERS: Mutex<Vec<Scaler>> = Mutex::new(Vec::new());
+
+/// Take a cached converter for this geometry, or create one
+fn take_converter(
+  width: u32,
+  height: u32,
+  src_format: AVPixelFormat,
+  dst_format: AVPixelFormat,
+) -> crate::codec::CodecResult<Scaler> {
+  if let Ok(mut converters) = CONVERTERS.lock()
+    && let Some(index) = converters.iter().position(|scaler| {
+      scaler.src_width() == width
+        && scaler.src_height() == height
+        && scaler.src_format() == src_format
+        && scaler.dst_format() == dst_format
+        && scaler.threads() == crate::codec::scaler::default_threads()
+    })
+  {
+    return Ok(converters.swap_remove(index));
+  }
+  Scaler::new_converter(width, height, src_format, dst_format)
+}
+
+/// Return a converter for reuse, evicting the oldest one when full
+fn return_converter(scaler: Scaler) {
+  if let Ok(mut converters) = CONVERTERS.lock() {
+    if converters.len() >= CONVERTER_CACHE_CAPACITY {
+      converters.remove(0);
+    }
+    converters.push(scaler);
+  }
+}
+
+/// Planes at least this large are copied in several bands at once
+const PARALLEL_COPY_MIN_BYTES: usize = 4 * 1024 * 1024;
+
+/// Most bands one plane is split into
+///
+/// A single core can't saturate memory bandwidth; past a few threads the copy
+/// is bandwidth bound and more bands only add scheduling cost.
+const MAX_COPY_BANDS: usize = 4;
+
+/// Rows of one band, handed to a blocking pool thread
+///
+/// The pointers borrow the caller's buffers; `PendingBands` makes sure the
+/// band is finished before `copy_plane` returns.
+struct PlaneBand {
+  src: *const u8,
+  src_len: usize,
+  dest: *mut u8,
+  dest_len: usize,
+}
+
+// Safety: bands cover disjoint rows of the destination and are joined before
+// the borrowed buffers go away
+unsafe impl Send for PlaneBand {}
+
+/// Joins the bands copied on the blocking pool, also when unwinding
+struct PendingBands(Vec<tokio::task::JoinHandle<()>>);
+
+impl Drop for PendingBands {
+  fn drop(&mut self) {
+    let mut failed = false;
+    for band in self.0.drain(..) {
+      failed |= futures::executor::block_on(band).is_err();
+    }
+    if failed && !std::thread::panicking() {
+      panic!("Plane band copy failed");
+    }
+  }
+}
+
+/// Copy `rows` rows of `row_bytes` bytes between buffers with different strides
+///
+/// Large planes are split into horizontal bands. The calling thread copies
+/// the first one while the others run on the blocking pool copyTo() already
+/// uses, so no threads are spawned per copy.
+fn copy_plane(
+  src: &[u8],
+  src_stride: usize,
+  dest: &mut [u8],
+  dest_stride: usize,
+  row_bytes: usize,
+  rows: usize,
+) {
+  let bands = if row_bytes * rows >= PARALLEL_COPY_MIN_BYTES {
+    std::thread::available_parallelism()
+      .map_or(1, |n| n.get())
+      .min(MAX_COPY_BANDS)
+  } else {
+    1
+  };
+  let band_rows = rows.div_ceil(bands.max(1));
+  if bands <= 1 || band_rows >= rows {
+    copy_rows(src, src_stride, dest, dest_stride, row_bytes, rows);
+    return;
+  }
+
+  let (first_dest, mut dest_rest) = dest.split_at_mut(band_rows * dest_stride);
+  let mut pending = PendingBands(Vec::with_capacity(bands - 1));
+  let mut row = band_rows;
+  while row < rows {
+    let band = band_rows.min(rows - row);
+    let dest_len = if row + band == rows {
+      dest_rest.len()
+    } else {
+      band * dest_stride
+    };
+    let (band_dest, rest) = std::mem::take(&mut dest_rest).split_at_mut(dest_len);
+    dest_rest = rest;
+    let band_src = &src[row * src_stride..];
+    let plane_band = PlaneBand {
+      src: band_src.as_ptr(),
+      src_len: band_src.len(),
+      dest: band_dest.as_mut_ptr(),
+      dest_len: band_dest.len(),
+    };
+    pending.0.push(spawn_blocking(move || {
+      let plane_band = plane_band;
+      // Safety: see `PlaneBand`
+      let (src, dest) = unsafe {
+        (
+          std::slice::from_raw_parts(plane_band.src, plane_band.src_len),
+          std::slice::from_raw_parts_mut(plane_band.dest, plane_band.dest_len),
+        )
+      };
+      copy_rows(src, src_stride, dest, dest_stride, row_bytes, band)
+    }));
+    row += band;
+  }
+  copy_rows(
+    src,
+    src_stride,
+    first_dest,
+    dest_stride,
+    row_bytes,
+    band_rows,
+  );
+  drop(pending);
+}
+
+fn copy_rows(
+  src: &[u8],
+  src_stride: usize,
+  dest: &mut [u8],
+  dest_stride: usize,
+  row_bytes: usize,
+  rows: usize,
+) {
+  if src_stride == row_bytes && dest_stride == row_bytes {
+    let len = row_bytes * rows;
+    dest[..len].copy_from_slice(&src[..len]);
+    return;
+  }
+  for row in 0..rows {
+    dest[row * dest_stride..row * dest_stride + row_bytes]
+      .copy_from_slice(&src[row * src_stride..row * src_stride + row_bytes]);
+  }
+}
+
 /// Internal state for VideoFrame
 struct VideoFrameInner {
   /// The underlying FFmpeg frame, wrapped in Arc<RwLock> for shared access
@@ -1044,6 +1357,8 @@ struct VideoFrameInner {
   /// Horizontal flip
   flip: bool,
   color_space: VideoColorSpace,
+  /// Cached copyTo() conversion, shared with clones
+  converted: ConvertedFrame,
   closed: bool,
 }
 
@@ -1190,11 +1505,22 @@ fn parse_visible_rect(
 /// VideoFrame - represents a frame of video
 ///
 /// This is a WebCodecs-compliant VideoFrame implementation backed by FFmpeg.
-#[napi]
+#[napi(custom_finalize)]
 pub struct VideoFrame {
   inner: Arc<Mutex<Option<VideoFrameInner>>>,
 }
 
+impl ObjectFinalize for VideoFrame {
+  fn finalize(self, _env: Env) -> Result<()> {
+    // Frames garbage collected without close() may be the last users of
+    // pins released on codec threads; delete those now rather than waiting
+    // for the next VideoFrame to be created or closed
+    drop(self);
+    release_pending_pins();
+    Ok(())
+  }
+}
+
 /// Parse rotation value per W3C spec algorithm
 /// Rounds to nearest 90 degrees, normalizes to 0-359 range
 fn parse_rotation(rotation: f64) -> f64 {
@@ -1218,6 +1544,8 @@ impl VideoFrame {
     ts_args_type = "source: VideoFrame | Uint8Array | CanvasLike, init?: VideoFrameBufferInit | VideoFrameInit"
   )]
   pub fn new(env: Env, source: Unknown, init: Option<VideoFrameConstructorInit>) -> Result<Self> {
+    sync_external_memory(&env)?;
+
     // Try VideoFrame first (check for codedWidth property which only VideoFrame has)
     if let Ok(source_obj) = source.coerce_to_object()
       && source_obj.has_named_property("codedWidth").unwrap_or(false)
@@ -1281,11 +1609,18 @@ impl VideoFrame {
   }
 
   /// Internal: Create VideoFrame from buffer data (VideoFrameBufferInit constructor form)
+  ///
+  /// Buffers listed in `init.transfer` are detached. When `data` lies in one
+  /// of them the frame wraps that memory directly instead of copying it (see
+  /// `can_wrap_packed`).
   fn new_from_buffer(
     env: Env,
     data: &[u8],
     init: Option<VideoFrameConstructorInit>,
   ) -> Result<Self> {
+    // Delete pins whose frames were released on encoder/decoder threads
+    release_pending_pins();
+
     // init is required for buffer constructor
     let init = init.ok_or_else(|| {
       let _ = env.throw_type_error("init is required when creating from buffer", None);
@@ -1352,23 +1687,62 @@ impl VideoFrame {
 
     let av_format = format.to_av_format();
 
-    // Create internal frame
-    let mut frame = Frame::new_video(width, height, av_format).map_err(|e| {
-      Error::new(
-        Status::GenericFailure,
-        format!("Failed to create frame: {}", e),
-      )
-    })?;
+    // Detach the transferred buffers. Their backing stores move to ArrayBuffers
+    // only this function can reach, so `data` is re-pointed at the new home of
+    // its bytes and user code can no longer mutate or detach them.
+    let mut data = data;
+    let mut owner = None;
+    for range in init.transfer.as_deref().unwrap_or_default() {
+      let holds_data = range.contains(data);
+      let Some((owned, start)) = (unsafe { transfer_array_buffer(env.raw(), range.buffer)? })
+      else {
+        continue;
+      };
+      if holds_data {
+        let offset = data.as_ptr() as usize - range.start;
+        data = unsafe { std::slice::from_raw_parts(start.add(offset), data.len()) };
+        owner = Some(owned);
+      }
+    }
 
-    // Copy data into the frame (with optional custom layout)
-    Self::copy_data_to_frame(
-      &mut frame,
-      data,
-      format,
-      width,
-      height,
-      init.layout.as_deref(),
-    )?;
+    let mut frame = match owner {
+      Some(owner) if Self::can_wrap_packed(format, width, height, init.layout.as_deref()) => {
+        // Zero-copy: the frame points at the transferred backing store, which
+        // stays pinned until the last FFmpeg reference to it is released
+        let pin = PinnedJsBuffer::new(&env, owner)?;
+        let ptr = NonNull::new(data.as_ptr() as *mut u8)
+          .ok_or_else(|| Error::new(Status::InvalidArg, "Transferred buffer is empty"))?;
+        unsafe {
+          Frame::wrap_external_video(width, height, av_format, ptr, data.len(), Box::new(pin))
+        }
+        .map_err(|e| {
+          Error::new(
+            Status::GenericFailure,
+            format!("Failed to wrap transferred buffer: {}", e),
+          )
+        })?
+      }
+      _ => {
+        // Create internal frame
+        let mut frame = Frame::new_video(width, height, av_format).map_err(|e| {
+          Error::new(
+            Status::GenericFailure,
+            format!("Failed to create frame: {}", e),
+          )
+        })?;
+
+        // Copy data into the frame (with optional custom layout)
+        Self::copy_data_to_frame(
+          &mut frame,
+          data,
+          format,
+          width,
+          height,
+          init.layout.as_deref(),
+        )?;
+        frame
+      }
+    };
 
     // Set timestamps (convert from microseconds to time_base units)
     // We use microseconds as time_base internally
@@ -1442,6 +1816,7 @@ impl VideoFrame {
       rotation,
       flip,
       color_space,
+      converted: Default::default(),
       closed: false,
     };
 
@@ -1723,6 +2098,13 @@ impl VideoFrame {
           }
         });
 
+      // Same pixels, so the same cached conversion applies
+      let converted = if Arc::ptr_eq(&final_frame, &source_inner.frame) {
+        source_inner.converted.clone()
+      } else {
+        Default::default()
+      };
+
       let new_inner = VideoFrameInner {
         frame: final_frame,
         original_format: final_format,
@@ -1737,6 +2119,7 @@ impl VideoFrame {
         rotation: combined_rotation,
         flip: combined_flip,
         color_space: source_inner.color_space.clone(),
+        converted,
         closed: false,
       };
 
@@ -1750,8 +2133,7 @@ impl VideoFrame {
   pub fn from_internal(frame: Frame, timestamp_us: i64, duration_us: Option<i64>) -> Self {
     let width = frame.width();
     let height = frame.height();
-    let original_format =
-      VideoPixelFormat::from_av_format(frame.format()).unwrap_or(VideoPixelFormat::I420);
+    let original_format = pixel_format_of(&frame);
 
     let inner = VideoFrameInner {
       frame: frame.into_shared(),
@@ -1767,6 +2149,7 @@ impl VideoFrame {
       rotation: 0.0,
       flip: false,
       color_space: VideoColorSpace::default(),
+      converted: Default::default(),
       closed: false,
     };
 
@@ -1785,8 +2168,7 @@ impl VideoFrame {
       let guard = frame.read();
       let width = guard.width();
       let height = guard.height();
-      let format =
-        VideoPixelFormat::from_av_format(guard.format()).unwrap_or(VideoPixelFormat::I420);
+      let format = pixel_format_of(&guard);
       (width, height, format)
     };
 
@@ -1804,6 +2186,7 @@ impl VideoFrame {
       rotation: 0.0,
       flip: false,
       color_space: VideoColorSpace::default(),
+      converted: Default::default(),
       closed: false,
     };
 
@@ -1826,8 +2209,7 @@ impl VideoFrame {
     let width = frame.width();
     let height = frame.height();
     let parsed_rotation = parse_rotation(rotation);
-    let original_format =
-      VideoPixelFormat::from_av_format(frame.format()).unwrap_or(VideoPixelFormat::I420);
+    let original_format = pixel_format_of(&frame);
 
     // Display dimensions may be swapped based on rotation
     let (display_width, display_height) = if parsed_rotation == 90.0 || parsed_rotation == 270.0 {
@@ -1870,6 +2252,7 @@ impl VideoFrame {
       rotation: parsed_rotation,
       flip,
       color_space,
+      converted: Default::default(),
       closed: false,
     };
 
@@ -1891,8 +2274,7 @@ impl VideoFrame {
   ) -> Self {
     let width = frame.width();
     let height = frame.height();
-    let original_format =
-      VideoPixelFormat::from_av_format(frame.format()).unwrap_or(VideoPixelFormat::I420);
+    let original_format = pixel_format_of(&frame);
 
     let color_space = if extract_color_space {
       color_space_from_frame(&frame)
@@ -1914,6 +2296,7 @@ impl VideoFrame {
       rotation: 0.0,
       flip: false,
       color_space,
+      converted: Default::default(),
       closed: false,
     };
 
@@ -1935,8 +2318,7 @@ impl VideoFrame {
     let frame_guard = frame_arc.read();
     let width = frame_guard.width();
     let height = frame_guard.height();
-    let original_format =
-      VideoPixelFormat::from_av_format(frame_guard.format()).unwrap_or(VideoPixelFormat::I420);
+    let original_format = pixel_format_of(&frame_guard);
 
     let color_space = if extract_color_space {
       color_space_from_frame(&frame_guard)
@@ -1959,6 +2341,7 @@ impl VideoFrame {
       rotation: 0.0,
       flip: false,
       color_space,
+      converted: Default::default(),
       closed: false,
     };
 
@@ -2281,6 +2664,7 @@ impl VideoFrame {
       custom_layout,
       original_format,
       needs_conversion,
+      cache_conversion,
     ) = {
       let guard = self
         .inner
@@ -2369,6 +2753,10 @@ impl VideoFrame {
         custom_layout,
         original_format,
         needs_conversion,
+        options
+          .as_ref()
+          .and_then(|o| o.cache_conversion)
+          .unwrap_or(true),
       )
     };
 
@@ -2423,64 +2811,53 @@ impl VideoFrame {
       // Acquire read lock on the frame for the duration of the copy operation
       let frame_guard = inner.frame.read();
 
+      // GPU-resident frames (VideoDecoder keepHardwareFrames) are downloaded on
+      // demand; downloads and format conversions are cached for the next copy
+      // unless the caller opted out or frame memory is under pressure
+      let cached = if needs_conversion || frame_guard.format().is_hardware() {
+        let mut converted = inner.converted.lock();
+        if frame_memory::under_pressure() {
+          *converted = None;
+        }
+        let hit = converted
+          .as_ref()
+          .filter(|(cached_format, _)| *cached_format == format)
+          .map(|(_, frame)| frame.clone());
+        drop(converted);
+        match hit {
+          Some(frame) => Some(frame),
+          None => {
+            let frame = Arc::new(Self::cpu_frame_for_copy(
+              &frame_guard,
+              original_format,
+              format,
+            )?);
+            if cache_conversion && !frame_memory::under_pressure() {
+              *inner.converted.lock() = Some((format, frame.clone()));
+            }
+            Some(frame)
+          }
+        }
+      } else {
+        None
+      };
+      // No conversion needed - use the read-locked frame directly (zero-copy read)
+      let source_frame: &Frame = cached.as_deref().unwrap_or(&frame_guard);
+
       // Allocate buffer for cropped data
       let mut temp_buffer = vec![0u8; buffer_size];
 
-      // Perform format conversion and copy, or copy directly
-      if needs_conversion {
-        let src_av_format = original_format.to_av_format();
-        let dst_av_format = format.to_av_format();
-
-        // Use Scaler for format conversion (operates on full frame, then crop)
-        let scaler = Scaler::new_converter(
-          frame_guard.width(),
-          frame_guard.height(),
-          src_av_format,
-          dst_av_format,
-        )
-        .map_err(|e| {
-          Error::new(
-            Status::GenericFailure,
-            format!(
-              "NotSupportedError: Failed to create format converter: {}",
-              e
-            ),
-          )
-        })?;
-
-        // scale_alloc creates a new frame with converted data
-        let converted = scaler.scale_alloc(&frame_guard).map_err(|e| {
-          Error::new(
-            Status::GenericFailure,
-            format!("EncodingError: Format conversion failed: {}", e),
-          )
-        })?;
-        drop(frame_guard);
-
-        // Copy cropped region from converted frame
-        Self::copy_cropped_data(
-          &converted,
-          format,
-          rect_x,
-          rect_y,
-          rect_width,
-          rect_height,
-          &mut temp_buffer,
-          layout_for_thread.as_deref(),
-        )?;
-      } else {
-        // No conversion needed - use the read-locked frame directly (zero-copy read)
-        Self::copy_cropped_data(
-          &frame_guard,
-          format,
-          rect_x,
-          rect_y,
-          rect_width,
-          rect_height,
-          &mut temp_buffer,
-          layout_for_thread.as_deref(),
-        )?;
-      };
+      // Copy cropped region (conversions operate on the full frame)
+      Self::copy_cropped_data(
+        source_frame,
+        format,
+        rect_x,
+        rect_y,
+        rect_width,
+        rect_height,
+        &mut temp_buffer,
+        layout_for_thread.as_deref(),
+      )?;
 
       Ok(temp_buffer)
     })
@@ -2500,6 +2877,56 @@ impl VideoFrame {
     Ok(layouts)
   }
 
+  /// Download and/or convert a frame's pixels to `format` for copyTo()
+  fn cpu_frame_for_copy(
+    frame: &Frame,
+    original_format: VideoPixelFormat,
+    format: VideoPixelFormat,
+  ) -> Result<Frame> {
+    let downloaded = if frame.format().is_hardware() {
+      Some(download_hw_frame(frame).map_err(|e| {
+        Error::new(
+          Status::GenericFailure,
+          format!("EncodingError: Failed to download hardware frame: {}", e),
+        )
+      })?)
+    } else {
+      None
+    };
+    let source = match downloaded {
+      Some(downloaded) if format == original_format => return Ok(downloaded),
+      Some(ref downloaded) => downloaded,
+      None => frame,
+    };
+
+    // Converters are reused across frames of the same geometry
+    let scaler = take_converter(
+      source.width(),
+      source.height(),
+      original_format.to_av_format(),
+      format.to_av_format(),
+    )
+    .map_err(|e| {
+      Error::new(
+        Status::GenericFailure,
+        format!(
+          "NotSupportedError: Failed to create format converter: {}",
+          e
+        ),
+      )
+    })?;
+
+    // scale_alloc creates a new frame with converted data
+    let converted = scaler.scale_alloc(source).map_err(|e| {
+      Error::new(
+        Status::GenericFailure,
+        format!("EncodingError: Format conversion failed: {}", e),
+      )
+    });
+    return_converter(scaler);
+    converted
+  }
+
   /// Calculate minimum stride for a plane given format, width, and plane index
   fn get_min_plane_stride(format: VideoPixelFormat, width: u32, plane_idx: u32) -> u32 {
     let bps = format.bytes_per_sample() as u32;
@@ -2678,19 +3105,29 @@ impl VideoFrame {
         ));
       }
 
-      // Copy row by row
-      for row in 0..plane_height {
-        let src_row_offset = ((plane_src_y + row) as usize) * src_stride
+      // Copy the rows (always the actual data width, not the padded stride);
+      // large planes are split across threads
+      let rows = plane_height as usize;
+      let row_bytes = default_bytes_per_row as usize;
+      if rows > 0 && row_bytes > 0 {
+        let src_offset = (plane_src_y as usize) * src_stride
           + (plane_src_x as usize) * (plane_sample_bytes as usize);
-        let dest_row_offset = dest_plane_offset + (row as usize) * dest_stride;
-
-        unsafe {
-          std::ptr::copy_nonoverlapping(
-            src_data.add(src_row_offset),
-            dest.as_mut_ptr().add(dest_row_offset),
-            default_bytes_per_row as usize, // Always copy the actual data width, not the padded stride
-          );
-        }
+        let src_plane = unsafe {
+          std::slice::from_raw_parts(
+            src_data.add(src_offset),
+            (rows - 1) * src_stride + row_bytes,
+          )
+        };
+        let dest_plane =
+          &mut dest[dest_plane_offset..dest_plane_offset + (rows - 1) * dest_stride + row_bytes];
+        copy_plane(
+          src_plane,
+          src_stride,
+          dest_plane,
+          dest_stride,
+          row_bytes,
+          rows,
+        );
       }
 
       // Update default offset for next plane (only used when no custom layout)
@@ -2897,6 +3334,7 @@ impl VideoFrame {
       rotation: inner.rotation,
       flip: inner.flip,
       color_space: inner.color_space.clone(),
+      converted: inner.converted.clone(),
       closed: false,
     };
 
@@ -2911,17 +3349,35 @@ impl VideoFrame {
   /// 2. Assign true to frame's [[Detached]]
   /// Note: Metadata (timestamp, duration, etc.) remains accessible after close
   #[napi]
-  pub fn close(&self) -> Result<()> {
+  pub fn close(&self, env: Env) -> Result<()> {
     let mut guard = self
       .inner
       .lock()
       .map_err(|_| Error::new(Status::GenericFailure, "Lock poisoned"))?;
 
-    if let Some(inner) = guard.as_mut() {
+    if let Some(inner) = guard.as_mut()
+      && !inner.closed
+    {
       inner.closed = true;
-      // Note: We keep the inner struct to preserve metadata (timestamp, duration, etc.)
-      // per W3C spec. The FFmpeg Frame memory will be released when VideoFrame is dropped.
+      // Drop this frame's share of the cached conversion (clones keep theirs)
+      inner.converted = Default::default();
+      // Drop this frame's reference to the pixel buffers now rather than at
+      // GC, so they stop counting against the frame memory budget once the
+      // last clone is closed. We keep the inner struct to preserve metadata
+      // (timestamp, duration, etc.) per W3C spec.
+      inner.frame = Frame::new()
+        .map_err(|e| {
+          Error::new(
+            Status::GenericFailure,
+            format!("Failed to close frame: {}", e),
+          )
+        })?
+        .into_shared();
     }
+    drop(guard);
+
+    release_pending_pins();
+    sync_external_memory(&env)?;
 
     Ok(())
   }
@@ -3032,6 +3488,41 @@ impl VideoFrame {
     }
   }
 
+  /// Whether a frame can wrap transferred buffer data instead of copying it
+  ///
+  /// Requires that the planes use the default tightly-packed layout and that
+  /// the format is an 8-bit one whose packed layout matches FFmpeg's
+  /// `av_image_fill_arrays` with alignment 1.
+  fn can_wrap_packed(
+    format: VideoPixelFormat,
+    width: u32,
+    height: u32,
+    layout: Option<&[PlaneLayout]>,
+  ) -> bool {
+    if format.bytes_per_sample() == 2 {
+      return false;
+    }
+
+    let packed_size = Self::calculate_buffer_size(format, width, height) as usize;
+    let av_size = image_buffer_size(format.to_av_format(), width as i32, height as i32);
+    if av_size < 0 || av_size as usize != packed_size {
+      return false;
+    }
+
+    if let Some(layout) = layout {
+      let mut offset = 0u32;
+      for (plane, plane_layout) in layout.iter().enumerate() {
+        let row_bytes = Self::get_min_plane_stride(format, width, plane as u32);
+        if plane_layout.offset != offset || plane_layout.stride != row_bytes {
+          return false;
+        }
+        offset += row_bytes * Self::get_plane_height(format, height, plane as u32);
+      }
+    }
+
+    true
+  }
+
   fn copy_data_to_frame(
     frame: &mut Frame,
     data: &[u8],
@@ -10,12 +10,13 @@ use crate::webcodecs::encoded_audio_chunk::EncodedAudioChunk;
 use crate::webcodecs::encoded_video_chunk::EncodedVideoChunk;
 use crate::webcodecs::muxer_base::{
   EncodedAudioChunkMetadataJs, EncodedVideoChunkMetadataJs, GenericAudioTrackConfig,
-  GenericVideoTrackConfig, MuxerFormat, MuxerInner, StreamingMuxerOptions, lock_muxer_inner,
-  lock_muxer_inner_mut,
+  GenericVideoTrackConfig, MuxerFormat, MuxerInner, MuxerSegment, RemuxSink, SegmentedMuxerOptions,
+  StreamingMuxerOptions, lock_muxer_inner, lock_muxer_inner_mut, segmenter_from_options,
 };
 use napi::bindgen_prelude::*;
+use napi::threadsafe_function::UnknownReturnValue;
 use napi_derive::napi;
-use std::sync::Mutex;
+use std::sync::{Arc, Mutex};
 
 // ============================================================================
 // WebM Format Implementation
@@ -94,6 +95,9 @@ pub struct WebMMuxerOptions {
   pub live: Option<bool>,
   /// Enable streaming output mode
   pub streaming: Option<StreamingMuxerOptions>,
+  /// Enable segmenting output mode (segments go to `onsegment`)
+  /// Cannot be combined with `streaming`
+  pub segmented: Option<SegmentedMuxerOptions>,
 }
 
 // ============================================================================
@@ -154,7 +158,16 @@ pub struct WebMAudioTrackConfig {
 /// ```
 #[napi]
 pub struct WebMMuxer {
-  inner: Mutex<Option<MuxerInner<WebMFormat>>>,
+  inner: Arc<Mutex<Option<MuxerInner<WebMFormat>>>>,
+  /// Segment callback reference (for the onsegment getter)
+  segment_callback: Option<FunctionRef<MuxerSegment, UnknownReturnValue>>,
+}
+
+impl WebMMuxer {
+  /// Shared handle for the native remux path (`demuxer.remuxTo`)
+  pub(crate) fn remux_sink(&self) -> Arc<dyn RemuxSink> {
+    self.inner.clone()
+  }
 }
 
 #[napi]
@@ -170,8 +183,18 @@ impl WebMMuxer {
       ..Default::default()
     };
 
+    if opts.streaming.is_some() && opts.segmented.is_some() {
+      return Err(Error::new(
+        Status::GenericFailure,
+        "streaming and segmented output cannot be combined",
+      ));
+    }
+
     // Create inner based on output mode
-    let inner = if let Some(streaming_opts) = opts.streaming {
+    let inner = if let Some(segmented_opts) = opts.segmented {
+      let segmenter = segmenter_from_options(segmented_opts, "webm", "webm");
+      MuxerInner::<WebMFormat>::new_segmented(muxer_options, segmenter)?
+    } else if let Some(streaming_opts) = opts.streaming {
       let capacity = streaming_opts.buffer_capacity.unwrap_or(256 * 1024) as usize;
       MuxerInner::<WebMFormat>::new_streaming(muxer_options, capacity)?
     } else {
@@ -179,7 +202,8 @@ impl WebMMuxer {
     };
 
     Ok(Self {
-      inner: Mutex::new(Some(inner)),
+      inner: Arc::new(Mutex::new(Some(inner))),
+      segment_callback: None,
     })
   }
 
@@ -201,6 +225,7 @@ impl WebMMuxer {
       framerate: config.framerate.unwrap_or(30.0),
       extradata: config.description.as_ref().map(|d| d.to_vec()),
       has_alpha: config.alpha.unwrap_or(false),
+      time_base: None,
     };
 
     inner.add_video_track(generic_config)
@@ -267,7 +292,7 @@ impl WebMMuxer {
 
   /// Read available data from streaming buffer (streaming mode only)
   ///
-  /// Returns available data, or null if no data is ready yet.
+  /// Returns all available data, or null if no data is ready yet.
   /// Returns empty Uint8Array when streaming is finished.
   #[napi]
   pub fn read(&self) -> Result<Option<Uint8Array>> {
@@ -279,6 +304,21 @@ impl WebMMuxer {
     }
   }
 
+  /// Read the next page of output (streaming mode only, non-standard)
+  ///
+  /// Like read(), but returns at most one page (up to 32 KiB) and hands it
+  /// over without copying. Call it until it returns null to drain
+  /// everything that is ready.
+  #[napi]
+  pub fn read_page(&self) -> Result<Option<Uint8Array>> {
+    lock_muxer_inner!(self => _guard, inner);
+    match inner.read_streaming_page() {
+      Ok(Some(data)) => Ok(Some(Uint8Array::new(data))),
+      Ok(None) => Ok(None),
+      Err(e) => Err(e),
+    }
+  }
+
   /// Check if muxer is in streaming mode
   #[napi(getter)]
   pub fn is_streaming(&self) -> Result<bool> {
@@ -293,6 +333,50 @@ impl WebMMuxer {
     Ok(inner.is_streaming_finished())
   }
 
+  /// Set the segment handler (segmenting mode only)
+  ///
+  /// Receives the init segment (EBML header and Tracks) and then the media
+  /// segments in order. A media segment holds one or more whole clusters
+  /// and starts with a keyframe. Segments cut before a handler is set are
+  /// delivered when it is set.
+  #[napi(setter)]
+  pub fn set_onsegment(
+    &mut self,
+    env: &Env,
+    callback: Option<FunctionRef<MuxerSegment, UnknownReturnValue>>,
+  ) -> Result<()> {
+    let tsfn = match callback {
+      Some(ref cb) => Some(
+        cb.borrow_back(env)?
+          .build_threadsafe_function()
+          .callee_handled::<false>()
+          .weak::<true>() // Weak to allow Node.js process to exit
+          .build()?,
+      ),
+      None => None,
+    };
+    {
+      lock_muxer_inner_mut!(self => _guard, inner);
+      inner.set_segment_callback(tsfn)?;
+    }
+
+    // Store FunctionRef for getter (main thread only)
+    self.segment_callback = callback;
+    Ok(())
+  }
+
+  /// Get the segment handler
+  #[napi(getter)]
+  pub fn get_onsegment<'env>(
+    &self,
+    env: &'env Env,
+  ) -> Result<Option<Function<'env, MuxerSegment, UnknownReturnValue>>> {
+    match self.segment_callback {
+      Some(ref callback) => Ok(Some(callback.borrow_back(env)?)),
+      None => Ok(None),
+    }
+  }
+
   /// Close the muxer and release resources
   #[napi]
   pub fn close(&self) -> Result<()> {
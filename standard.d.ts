@@ -101,6 +101,27 @@ export type VideoEncoderBitrateMode = 'constant' | 'variable' | 'quantizer'
  */
 export type AlphaOption = 'discard' | 'keep'
 
+/**
+ * What a VideoEncoder does when `maxQueueSize` frames are already pending (non-standard)
+ * - 'drop-oldest': skip the oldest pending frames (a skipped keyframe request moves to the next frame)
+ * - 'drop-newest-delta': drop new frames unless they request a keyframe
+ * - 'throw': encode() throws QuotaExceededError while the queue is full; wait for a
+ *   "dequeue" event before encoding more. A piped decoder (pipeTo()) pauses until
+ *   the encoder has room
+ */
+export type EncodeQueueOverflow = 'drop-oldest' | 'drop-newest-delta' | 'throw'
+
+/**
+ * Which frames a VideoDecoder decodes (non-standard)
+ * - 'all': every frame (default)
+ * - 'non-reference': skip frames no other frame predicts from (typically B-frames)
+ * - 'keyframes': keyframes only; delta chunks are dropped without being decoded
+ *   (they still count towards `decodeQueueSize` until dropped)
+ * - 'fast': every frame, with speed-over-quality shortcuts such as skipping the
+ *   deblocking filter
+ */
+export type VideoDecodeMode = 'all' | 'non-reference' | 'keyframes' | 'fast'
+
 /**
  * VideoEncoder configuration
  * @see https://w3c.github.io/webcodecs/#dictdef-videoencoderconfig
@@ -134,6 +155,19 @@ export interface VideoEncoderConfig {
   avc?: AvcEncoderConfig
   /** HEVC-specific configuration */
   hevc?: HevcEncoderConfig
+  /**
+   * Threads used to convert/scale input frames to the encoder's format and size
+   * (non-standard; 0 = a share of the codec thread budget). Defaults to
+   * `setScalerThreads()`.
+   */
+  scalerThreads?: number
+  /**
+   * Most frames that may wait to be encoded (non-standard). Frames over the
+   * limit are handled by `queueOverflow`; each drop fires a "framedrop" event.
+   */
+  maxQueueSize?: number
+  /** What to do when `maxQueueSize` is reached (non-standard, default 'drop-oldest') */
+  queueOverflow?: EncodeQueueOverflow
 }
 
 /**
@@ -185,6 +219,35 @@ export interface VideoDecoderConfig {
   rotation?: number
   /** Horizontal flip - W3C WebCodecs spec */
   flip?: boolean
+  /**
+   * Keep hardware-decoded frames in GPU memory (non-standard).
+   * Pixels are downloaded only when `copyTo()` is called, and VideoEncoders on the
+   * same device encode the surfaces directly. Frames hold surfaces from the
+   * decoder's pool, so close them as soon as they are consumed: at most 8 stay
+   * GPU-resident at a time, and while that many are open further frames are
+   * downloaded to CPU memory.
+   */
+  keepHardwareFrames?: boolean
+  /**
+   * Scale decoded frames to this size (non-standard, requires `desiredHeight`).
+   * With `codedWidth`/`codedHeight` set, software decoders that support it (e.g. MJPEG)
+   * decode at a reduced resolution first so only the remaining resize is done by the
+   * scaler. Frames are downloaded to CPU memory even with `keepHardwareFrames`.
+   */
+  desiredWidth?: number
+  /** Scale decoded frames to this height (non-standard, requires `desiredWidth`) */
+  desiredHeight?: number
+  /**
+   * Frames to decode (non-standard, default 'all'). With 'keyframes', seek the
+   * demuxer and push just the keyframes you need to extract thumbnails without
+   * decoding whole GOPs. Frames skipped by the decoder produce no output.
+   */
+  decodeMode?: VideoDecodeMode
+  /**
+   * Threads used to scale to `desiredWidth`/`desiredHeight` (non-standard;
+   * 0 = a share of the codec thread budget). Defaults to `setScalerThreads()`.
+   */
+  scalerThreads?: number
 }
 
 // ============================================================================
@@ -343,6 +406,12 @@ export interface VideoFrameBufferInit {
   displayHeight?: number
   /** Color space */
   colorSpace?: VideoColorSpaceInit
+  /**
+   * ArrayBuffers to transfer. They are detached once the frame is
+   * constructed; listing the frame's own buffer lets 8-bit, tightly-packed
+   * frames take over its memory without copying.
+   */
+  transfer?: ArrayBuffer[]
 }
 
 // ============================================================================
@@ -428,12 +497,21 @@ export interface ImageDecoderInit {
   type: string
   /** Color space conversion */
   colorSpaceConversion?: 'none' | 'default'
-  /** Desired width */
+  /**
+   * Desired width. JPEG images are decoded at a reduced resolution
+   * (1/2, 1/4 or 1/8) when that still covers the desired size.
+   */
   desiredWidth?: number
   /** Desired height */
   desiredHeight?: number
   /** Prefer animation */
   preferAnimation?: boolean
+  /**
+   * Byte budget for decoded frames kept in memory (non-standard, default 64 MiB).
+   * Frames are decoded on demand and the least recently used ones are evicted;
+   * decoding an evicted frame of an animation again restarts from the first frame.
+   */
+  frameCacheBytes?: number
   /** ArrayBuffers to transfer */
   transfer?: ArrayBuffer[]
 }